@@ -20,6 +20,7 @@
 
 #include <controller/CHIPDeviceControllerFactory.h>
 #include <core/CHIPBuildConfig.h>
+#include <credentials/FileAttestationTrustStore.h>
 #include <lib/core/CHIPVendorIdentifiers.hpp>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/ScopedBuffer.h>
@@ -28,14 +29,53 @@
 #include "TraceHandlers.h"
 #endif // CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
 
+#if CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+#include "ChromeTraceExporter.h"
+#endif // CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+
 using DeviceControllerFactory = chip::Controller::DeviceControllerFactory;
 
 constexpr chip::FabricId kIdentityAlphaFabricId = 1;
 constexpr chip::FabricId kIdentityBetaFabricId  = 2;
 constexpr chip::FabricId kIdentityGammaFabricId = 3;
 
+PersistentStorage CHIPCommand::mDefaultStorage;
+PersistentStorage CHIPCommand::mCommissionerStorage;
+chip::SimpleFabricStorage CHIPCommand::mFabricStorage;
+std::map<std::string, std::unique_ptr<CHIPCommand::ChipDeviceCommissioner>> CHIPCommand::mCommissioners;
+bool CHIPCommand::sInteractiveSession = false;
+
+namespace {
+
+CHIP_ERROR GetAttestationTrustStore(const char * paaTrustStorePath, const chip::Credentials::AttestationTrustStore ** trustStore)
+{
+    if (paaTrustStorePath == nullptr)
+    {
+        *trustStore = chip::Credentials::GetTestAttestationTrustStore();
+        return CHIP_NO_ERROR;
+    }
+
+    // PAA certificates are parsed once, when loaded, and then shared by every commissioner.
+    static chip::Credentials::FileAttestationTrustStore attestationTrustStore;
+    if (attestationTrustStore.GetPaaCertCount() == 0)
+    {
+        ReturnErrorOnFailure(attestationTrustStore.LoadPaaCerts(paaTrustStorePath));
+        VerifyOrReturnError(attestationTrustStore.GetPaaCertCount() != 0, CHIP_ERROR_CA_CERT_NOT_FOUND);
+    }
+
+    *trustStore = &attestationTrustStore;
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
 CHIP_ERROR CHIPCommand::Run()
 {
+    if (sInteractiveSession)
+    {
+        return RunInInteractiveSession();
+    }
+
     StartTracing();
 
 #if CHIP_DEVICE_LAYER_TARGET_LINUX && CHIP_DEVICE_CONFIG_ENABLE_CHIPOBLE
@@ -51,10 +91,15 @@ CHIP_ERROR CHIPCommand::Run()
     factoryInitParams.listenPort    = static_cast<uint16_t>(mDefaultStorage.GetListenPort() + CurrentCommissionerIndex());
     ReturnLogErrorOnFailure(DeviceControllerFactory::GetInstance().Init(factoryInitParams));
 
+    ReturnLogErrorOnFailure(GetAttestationTrustStore(mPaaTrustStorePath.ValueOr(nullptr), &mAttestationTrustStore));
+
     ReturnLogErrorOnFailure(InitializeCommissioner(kIdentityAlpha, kIdentityAlphaFabricId));
     ReturnLogErrorOnFailure(InitializeCommissioner(kIdentityBeta, kIdentityBetaFabricId));
     ReturnLogErrorOnFailure(InitializeCommissioner(kIdentityGamma, kIdentityGammaFabricId));
 
+#if CONFIG_USE_SEPARATE_EVENTLOOP
+    StartRun();
+#endif // CONFIG_USE_SEPARATE_EVENTLOOP
     chip::DeviceLayer::PlatformMgr().ScheduleWork(RunQueuedCommand, reinterpret_cast<intptr_t>(this));
     ReturnLogErrorOnFailure(StartWaiting(GetWaitDuration()));
 
@@ -94,6 +139,17 @@ void CHIPCommand::StopTracing()
 #if CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
     chip::trace::DeInitTrace();
 #endif // CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
+
+#if CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+    if (mTraceJsonFile.HasValue())
+    {
+        CHIP_ERROR err = chip::trace::WriteChromeTrace(mTraceJsonFile.Value());
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(chipTool, "Failed to write the trace to %s: %" CHIP_ERROR_FORMAT, mTraceJsonFile.Value(), err.Format());
+        }
+    }
+#endif // CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
 }
 
 void CHIPCommand::SetIdentity(const char * identity)
@@ -165,7 +221,7 @@ CHIP_ERROR CHIPCommand::InitializeCommissioner(std::string key, chip::FabricId f
     std::unique_ptr<ChipDeviceCommissioner> commissioner = std::make_unique<ChipDeviceCommissioner>();
     chip::Controller::SetupParams commissionerParams;
 
-    ReturnLogErrorOnFailure(mCredIssuerCmds->SetupDeviceAttestation(commissionerParams));
+    ReturnLogErrorOnFailure(mCredIssuerCmds->SetupDeviceAttestation(commissionerParams, mAttestationTrustStore));
     chip::Credentials::SetDeviceAttestationVerifier(commissionerParams.deviceAttestationVerifier);
 
     VerifyOrReturnError(noc.Alloc(chip::Controller::kMaxCHIPDERCertLength), CHIP_ERROR_NO_MEMORY);
@@ -202,9 +258,38 @@ CHIP_ERROR CHIPCommand::InitializeCommissioner(std::string key, chip::FabricId f
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR CHIPCommand::RunInInteractiveSession()
+{
+#if CONFIG_USE_SEPARATE_EVENTLOOP
+    // The event loop of the session is already running on its own thread.
+    StartRun();
+    chip::DeviceLayer::PlatformMgr().ScheduleWork(RunQueuedCommand, reinterpret_cast<intptr_t>(this));
+    CHIP_ERROR err = WaitForResponse(GetWaitDuration());
+
+    chip::DeviceLayer::PlatformMgr().LockChipStack();
+    Shutdown();
+    chip::DeviceLayer::PlatformMgr().UnlockChipStack();
+
+    return err;
+#else
+    return CHIP_ERROR_NOT_IMPLEMENTED;
+#endif // CONFIG_USE_SEPARATE_EVENTLOOP
+}
+
 void CHIPCommand::RunQueuedCommand(intptr_t commandArg)
 {
     auto * command = reinterpret_cast<CHIPCommand *>(commandArg);
+
+#if CONFIG_USE_SEPARATE_EVENTLOOP
+    {
+        // The queued runs start in the order they were scheduled in, so this is the start of run mStartedRunGeneration.
+        // It is stale when the run has already timed out, or when a later run has been scheduled since.
+        std::lock_guard<std::mutex> lk(command->cvWaitingForResponseMutex);
+        command->mStartedRunGeneration++;
+        VerifyOrReturn(command->IsCurrentRun());
+    }
+#endif // CONFIG_USE_SEPARATE_EVENTLOOP
+
     CHIP_ERROR err = command->RunCommand();
     if (err != CHIP_NO_ERROR)
     {
@@ -224,14 +309,7 @@ CHIP_ERROR CHIPCommand::StartWaiting(chip::System::Clock::Timeout duration)
 #if CONFIG_USE_SEPARATE_EVENTLOOP
     // ServiceEvents() calls StartEventLoopTask(), which is paired with the StopEventLoopTask() below.
     ReturnLogErrorOnFailure(DeviceControllerFactory::GetInstance().ServiceEvents());
-    auto waitingUntil = std::chrono::system_clock::now() + std::chrono::duration_cast<std::chrono::seconds>(duration);
-    {
-        std::unique_lock<std::mutex> lk(cvWaitingForResponseMutex);
-        if (!cvWaitingForResponse.wait_until(lk, waitingUntil, [this]() { return !this->mWaitingForResponse; }))
-        {
-            mCommandExitStatus = CHIP_ERROR_TIMEOUT;
-        }
-    }
+    WaitForResponse(duration);
     LogErrorOnFailure(chip::DeviceLayer::PlatformMgr().StopEventLoopTask());
 #else
     ReturnLogErrorOnFailure(chip::DeviceLayer::SystemLayer().StartTimer(duration, OnResponseTimeout, this));
@@ -241,6 +319,49 @@ CHIP_ERROR CHIPCommand::StartWaiting(chip::System::Clock::Timeout duration)
     return mCommandExitStatus;
 }
 
+#if CONFIG_USE_SEPARATE_EVENTLOOP
+CHIP_ERROR CHIPCommand::WaitForResponse(chip::System::Clock::Timeout duration)
+{
+    auto waitingUntil = std::chrono::system_clock::now() + std::chrono::duration_cast<std::chrono::seconds>(duration);
+
+    std::unique_lock<std::mutex> lk(cvWaitingForResponseMutex);
+    if (!cvWaitingForResponse.wait_until(lk, waitingUntil, [this]() { return !this->mWaitingForResponse; }))
+    {
+        // End the run, so that the completions its command still delivers are ignored.
+        mWaitingForResponse = false;
+        mCommandExitStatus  = CHIP_ERROR_TIMEOUT;
+    }
+
+    return mCommandExitStatus;
+}
+
+void CHIPCommand::StartRun()
+{
+    std::lock_guard<std::mutex> lk(cvWaitingForResponseMutex);
+    mRunGeneration++;
+    mWaitingForResponse = true;
+    mCommandExitStatus  = CHIP_ERROR_INTERNAL;
+}
+#endif // CONFIG_USE_SEPARATE_EVENTLOOP
+
+void CHIPCommand::SetCommandExitStatus(CHIP_ERROR status)
+{
+#if CONFIG_USE_SEPARATE_EVENTLOOP
+    {
+        // A command that timed out in an interactive session may still complete later on. Only the current run, once its
+        // command has started, can be completed, so that such late completions do not end the next run.
+        std::lock_guard<std::mutex> lk(cvWaitingForResponseMutex);
+        VerifyOrReturn(IsCurrentRun());
+        mCommandExitStatus  = status;
+        mWaitingForResponse = false;
+    }
+    cvWaitingForResponse.notify_all();
+#else  // CONFIG_USE_SEPARATE_EVENTLOOP
+    mCommandExitStatus = status;
+    StopWaiting();
+#endif // CONFIG_USE_SEPARATE_EVENTLOOP
+}
+
 void CHIPCommand::StopWaiting()
 {
 #if CONFIG_USE_SEPARATE_EVENTLOOP
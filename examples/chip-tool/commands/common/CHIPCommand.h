@@ -44,11 +44,15 @@ public:
 
     CHIPCommand(const char * commandName) : Command(commandName)
     {
+        AddArgument("paa-trust-store-path", &mPaaTrustStorePath);
         AddArgument("commissioner-name", &mCommissionerName);
 #if CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
         AddArgument("trace_file", &mTraceFile);
         AddArgument("trace_log", 0, 1, &mTraceLog);
 #endif // CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
+#if CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+        AddArgument("trace_json", &mTraceJsonFile);
+#endif // CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
     }
 
     CHIPCommand(const char * commandName, CredentialIssuerCommands * credIssuerCmds) : CHIPCommand(commandName)
@@ -59,11 +63,7 @@ public:
     /////////// Command Interface /////////
     CHIP_ERROR Run() override;
 
-    void SetCommandExitStatus(CHIP_ERROR status)
-    {
-        mCommandExitStatus = status;
-        StopWaiting();
-    }
+    void SetCommandExitStatus(CHIP_ERROR status);
 
 protected:
     // Will be called in a setting in which it's safe to touch the CHIP
@@ -78,12 +78,15 @@ protected:
     virtual chip::System::Clock::Timeout GetWaitDuration() const = 0;
 
     // Shut down the command, in case any work needs to be done after the event
-    // loop has been stopped.
+    // loop has been stopped. In an interactive session the event loop keeps
+    // running, and this is called with the stack lock held instead.
     virtual void Shutdown() {}
 
-    PersistentStorage mDefaultStorage;
-    PersistentStorage mCommissionerStorage;
-    chip::SimpleFabricStorage mFabricStorage;
+    // The storage and the commissioners are shared by all the commands run by an
+    // interactive session.
+    static PersistentStorage mDefaultStorage;
+    static PersistentStorage mCommissionerStorage;
+    static chip::SimpleFabricStorage mFabricStorage;
     ExampleCredentialIssuerCommands mExampleCredentialIssuerCmds;
     CredentialIssuerCommands * mCredIssuerCmds = &mExampleCredentialIssuerCmds;
 
@@ -95,24 +98,42 @@ protected:
     // --identity "instance name" when running a command.
     ChipDeviceCommissioner & CurrentCommissioner();
 
+    // Set while an interactive session runs: the commands it runs reuse its stack,
+    // its commissioners and their CASE sessions instead of setting up their own.
+    static bool sInteractiveSession;
+
 private:
     CHIP_ERROR InitializeCommissioner(std::string key, chip::FabricId fabricId);
     CHIP_ERROR ShutdownCommissioner(std::string key);
     uint16_t CurrentCommissionerIndex();
-    std::map<std::string, std::unique_ptr<ChipDeviceCommissioner>> mCommissioners;
+    static std::map<std::string, std::unique_ptr<ChipDeviceCommissioner>> mCommissioners;
     chip::Optional<char *> mCommissionerName;
+    chip::Optional<char *> mPaaTrustStorePath;
+    const chip::Credentials::AttestationTrustStore * mAttestationTrustStore = nullptr;
 
     static void RunQueuedCommand(intptr_t commandArg);
 
+    CHIP_ERROR RunInInteractiveSession();
+
     CHIP_ERROR mCommandExitStatus = CHIP_ERROR_INTERNAL;
 
     CHIP_ERROR StartWaiting(chip::System::Clock::Timeout seconds);
     void StopWaiting();
 
 #if CONFIG_USE_SEPARATE_EVENTLOOP
+    CHIP_ERROR WaitForResponse(chip::System::Clock::Timeout duration);
+
+    // Start a new run of the command, to be waited for with WaitForResponse.
+    void StartRun();
+
+    // Whether the latest run is still waiting and its command has started. Called with cvWaitingForResponseMutex held.
+    bool IsCurrentRun() const { return mWaitingForResponse && mStartedRunGeneration == mRunGeneration; }
+
     std::condition_variable cvWaitingForResponse;
     std::mutex cvWaitingForResponseMutex;
     bool mWaitingForResponse{ true };
+    uint32_t mRunGeneration{ 0 };        // Number of runs scheduled
+    uint32_t mStartedRunGeneration{ 0 }; // Number of scheduled runs whose command has started
 #endif // CONFIG_USE_SEPARATE_EVENTLOOP
 
     void StartTracing();
@@ -122,4 +143,8 @@ private:
     chip::Optional<char *> mTraceFile;
     chip::Optional<bool> mTraceLog;
 #endif // CHIP_CONFIG_TRANSPORT_TRACE_ENABLED
+
+#if CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+    chip::Optional<char *> mTraceJsonFile;
+#endif // CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
 };
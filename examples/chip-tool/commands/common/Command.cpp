@@ -103,6 +103,80 @@ exit:
     return isValidCommand;
 }
 
+template <typename T>
+void ResetOptionalArgument(const Argument & arg)
+{
+    if (arg.isNullable())
+    {
+        reinterpret_cast<chip::Optional<chip::app::DataModel::Nullable<T>> *>(arg.value)->ClearValue();
+    }
+    else
+    {
+        reinterpret_cast<chip::Optional<T> *>(arg.value)->ClearValue();
+    }
+}
+
+void Command::ResetArguments()
+{
+    // Mandatory arguments are always set by InitArguments, only the optional ones keep the value of a previous run.
+    for (const Argument & arg : mArgs)
+    {
+        if (!arg.isOptional())
+        {
+            continue;
+        }
+
+        switch (arg.type)
+        {
+        case ArgumentType::Attribute:
+            break;
+        case ArgumentType::String:
+            ResetOptionalArgument<char *>(arg);
+            break;
+        case ArgumentType::CharString:
+            ResetOptionalArgument<chip::CharSpan>(arg);
+            break;
+        case ArgumentType::OctetString:
+            ResetOptionalArgument<chip::ByteSpan>(arg);
+            break;
+        case ArgumentType::Boolean:
+        case ArgumentType::Number_uint8:
+            ResetOptionalArgument<uint8_t>(arg);
+            break;
+        case ArgumentType::Number_uint16:
+            ResetOptionalArgument<uint16_t>(arg);
+            break;
+        case ArgumentType::Number_uint32:
+            ResetOptionalArgument<uint32_t>(arg);
+            break;
+        case ArgumentType::Number_uint64:
+            ResetOptionalArgument<uint64_t>(arg);
+            break;
+        case ArgumentType::Number_int8:
+            ResetOptionalArgument<int8_t>(arg);
+            break;
+        case ArgumentType::Number_int16:
+            ResetOptionalArgument<int16_t>(arg);
+            break;
+        case ArgumentType::Number_int32:
+            ResetOptionalArgument<int32_t>(arg);
+            break;
+        case ArgumentType::Number_int64:
+            ResetOptionalArgument<int64_t>(arg);
+            break;
+        case ArgumentType::Float:
+            ResetOptionalArgument<float>(arg);
+            break;
+        case ArgumentType::Double:
+            ResetOptionalArgument<double>(arg);
+            break;
+        case ArgumentType::Address:
+            ResetOptionalArgument<AddressWithInterface>(arg);
+            break;
+        }
+    }
+}
+
 static bool ParseAddressWithInterface(const char * addressString, Command::AddressWithInterface * address)
 {
     struct addrinfo hints;
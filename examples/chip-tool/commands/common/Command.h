@@ -110,6 +110,12 @@ public:
     size_t GetArgumentsCount(void) const { return mArgs.size(); }
 
     bool InitArguments(int argc, char ** argv);
+
+    /**
+     * Clear the optional arguments, so that a command run several times in the same process does not see the optional
+     * arguments of its previous run.
+     */
+    void ResetArguments();
     size_t AddArgument(const char * name, const char * value, uint8_t flags = 0);
     /**
      * @brief
@@ -21,6 +21,7 @@
 #include "Command.h"
 
 #include <algorithm>
+#include <ctype.h>
 #include <string>
 
 #include <lib/support/CHIPMem.h>
@@ -53,6 +54,69 @@ exit:
     return (err == CHIP_NO_ERROR) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
 
+CHIP_ERROR Commands::RunInteractive(char * commandLine)
+{
+    // The executable name, only used by the usage messages.
+    static char kInteractiveModeName[] = "";
+
+    char * argv[kMaxInteractiveArguments + 1] = { kInteractiveModeName };
+    int argc                                  = 1;
+    char * in                                 = commandLine;
+
+    for (;;)
+    {
+        while (isspace(static_cast<unsigned char>(*in)))
+        {
+            in++;
+        }
+        if (*in == '\0')
+        {
+            break;
+        }
+
+        if (argc > kMaxInteractiveArguments)
+        {
+            ChipLogError(chipTool, "Too many arguments, the limit is %d", kMaxInteractiveArguments);
+            return CHIP_ERROR_INVALID_ARGUMENT;
+        }
+
+        // Quotes are removed as the argument is copied over itself.
+        char * out   = in;
+        char quote   = '\0';
+        argv[argc++] = out;
+        for (; *in != '\0' && (quote != '\0' || !isspace(static_cast<unsigned char>(*in))); in++)
+        {
+            if (quote == '\0' && (*in == '"' || *in == '\''))
+            {
+                quote = *in;
+            }
+            else if (*in == quote)
+            {
+                quote = '\0';
+            }
+            else
+            {
+                *out++ = *in;
+            }
+        }
+
+        if (quote != '\0')
+        {
+            ChipLogError(chipTool, "Unterminated quote");
+            return CHIP_ERROR_INVALID_ARGUMENT;
+        }
+
+        bool hasMore = *in != '\0';
+        *out         = '\0';
+        if (hasMore)
+        {
+            in++;
+        }
+    }
+
+    return RunCommand(argc, argv);
+}
+
 CHIP_ERROR Commands::RunCommand(int argc, char ** argv)
 {
     std::map<std::string, CommandsVector>::iterator cluster;
@@ -108,6 +172,7 @@ CHIP_ERROR Commands::RunCommand(int argc, char ** argv)
         }
     }
 
+    command->ResetArguments();
     if (!command->InitArguments(argc - 3, &argv[3]))
     {
         ShowCommand(argv[0], argv[1], command);
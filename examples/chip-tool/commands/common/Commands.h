@@ -30,7 +30,15 @@ public:
     void Register(const char * clusterName, commands_list commandsList);
     int Run(int argc, char ** argv);
 
+    /**
+     * Run a command line read by an interactive session, e.g. "onoff toggle 1 1". The line is split in place into
+     * arguments, which may be grouped with quotes.
+     */
+    CHIP_ERROR RunInteractive(char * commandLine);
+
 private:
+    static constexpr int kMaxInteractiveArguments = 64;
+
     CHIP_ERROR RunCommand(int argc, char ** argv);
 
     std::map<std::string, CommandsVector>::iterator GetCluster(std::string clusterName);
@@ -0,0 +1,345 @@
+/*
+ *   Copyright (c) 2022 Project CHIP Authors
+ *   All rights reserved.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+#include "InteractiveCommands.h"
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemError.h>
+
+#include <ctype.h>
+#include <errno.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <mutex>
+
+namespace {
+
+constexpr const char kQuitCommand[]        = "quit";
+constexpr const char kInteractiveCluster[] = "interactive";
+constexpr const char kChipToolModuleName[] = "TOO";
+
+// The output of the command run for a socket client, collected from the chip-tool log lines, which include the decoded
+// responses. The commands log from the CHIP thread while the reader thread waits for them.
+std::mutex gCommandOutputMutex;
+std::string * gCommandOutput = nullptr;
+
+void LogAndCollectOutput(const char * module, uint8_t category, const char * msg, va_list args)
+{
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+    chip::Logging::Platform::LogV(module, category, msg, argsCopy);
+    va_end(argsCopy);
+
+    VerifyOrReturn(strcmp(module, kChipToolModuleName) == 0);
+
+    std::lock_guard<std::mutex> lock(gCommandOutputMutex);
+    VerifyOrReturn(gCommandOutput != nullptr);
+
+    char line[CHIP_CONFIG_LOG_MESSAGE_MAX_SIZE];
+    vsnprintf(line, sizeof(line), msg, args);
+    gCommandOutput->append(line).append("\n");
+}
+
+void SetCommandOutput(std::string * output)
+{
+    std::lock_guard<std::mutex> lock(gCommandOutputMutex);
+    gCommandOutput = output;
+}
+
+bool IsInteractiveCluster(const char * line)
+{
+    size_t length = strlen(kInteractiveCluster);
+    return strncmp(line, kInteractiveCluster, length) == 0 &&
+        (line[length] == '\0' || isspace(static_cast<unsigned char>(line[length])));
+}
+
+char * Trim(char * line)
+{
+    while (isspace(static_cast<unsigned char>(*line)))
+    {
+        line++;
+    }
+
+    size_t length = strlen(line);
+    while (length > 0 && isspace(static_cast<unsigned char>(line[length - 1])))
+    {
+        line[--length] = '\0';
+    }
+
+    return line;
+}
+
+} // namespace
+
+CHIP_ERROR InteractiveStartCommand::RunCommand()
+{
+#if CONFIG_USE_SEPARATE_EVENTLOOP
+    if (sInteractiveSession)
+    {
+        ChipLogError(chipTool, "An interactive session is already running");
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+
+    if (mSocketPath.HasValue())
+    {
+        const char * path = mSocketPath.Value();
+        struct sockaddr_un addr;
+
+        if (strlen(path) >= sizeof(addr.sun_path))
+        {
+            ChipLogError(chipTool, "Socket path too long: %s", path);
+            return CHIP_ERROR_INVALID_ARGUMENT;
+        }
+
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strcpy(addr.sun_path, path);
+
+        mListenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        VerifyOrReturnError(mListenFd >= 0, CHIP_ERROR_POSIX(errno));
+
+        // Remove the socket left behind by a previous session, but nothing else.
+        struct stat st;
+        if (lstat(path, &st) == 0)
+        {
+            if (!S_ISSOCK(st.st_mode))
+            {
+                ChipLogError(chipTool, "%s exists and is not a socket", path);
+                close(mListenFd);
+                mListenFd = -1;
+                return CHIP_ERROR_INVALID_ARGUMENT;
+            }
+            unlink(path);
+        }
+        if (bind(mListenFd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0 || listen(mListenFd, SOMAXCONN) != 0)
+        {
+            CHIP_ERROR err = CHIP_ERROR_POSIX(errno);
+            ChipLogError(chipTool, "Failed to listen on %s: %s", path, strerror(errno));
+            close(mListenFd);
+            mListenFd = -1;
+            return err;
+        }
+
+        ChipLogProgress(chipTool, "Waiting for commands on %s", path);
+    }
+    else
+    {
+        ChipLogProgress(chipTool, "Waiting for commands on stdin");
+    }
+
+    // The commands block until they complete, so they are read and run on their own thread while the CHIP thread
+    // keeps serving them.
+    sInteractiveSession = true;
+    mReader             = std::thread(&InteractiveStartCommand::ReaderMain, this);
+
+    return CHIP_NO_ERROR;
+#else
+    ChipLogError(chipTool, "Interactive mode needs the CHIP event loop to run on its own thread");
+    return CHIP_ERROR_NOT_IMPLEMENTED;
+#endif // CONFIG_USE_SEPARATE_EVENTLOOP
+}
+
+void InteractiveStartCommand::Shutdown()
+{
+    if (mReader.joinable())
+    {
+        mReader.join();
+    }
+    sInteractiveSession = false;
+
+    if (mListenFd >= 0)
+    {
+        close(mListenFd);
+        mListenFd = -1;
+        unlink(mSocketPath.Value());
+    }
+}
+
+void InteractiveStartCommand::ReaderMain()
+{
+    CHIP_ERROR err = (mListenFd >= 0) ? ServeSocket() : ServeStdin();
+    SetCommandExitStatus(err);
+}
+
+bool InteractiveStartCommand::RunLine(char * line, std::string & reply)
+{
+    line = Trim(line);
+    reply.clear();
+
+    // Skip empty lines and comments.
+    if (line[0] == '\0' || line[0] == '#')
+    {
+        return true;
+    }
+
+    if (strcmp(line, kQuitCommand) == 0)
+    {
+        return false;
+    }
+
+    // A session run from within a session would share, and wait for, the reader thread of this one.
+    if (IsInteractiveCluster(line))
+    {
+        ChipLogError(chipTool, "An interactive session is already running");
+        reply = std::string("ERROR ") + chip::ErrorStr(CHIP_ERROR_INCORRECT_STATE) + "\n";
+        return true;
+    }
+
+    // The clients of the socket do not see the log, so the output of the command comes before its status.
+    if (mListenFd >= 0)
+    {
+        SetCommandOutput(&reply);
+    }
+    CHIP_ERROR err = mHandler->RunInteractive(line);
+    SetCommandOutput(nullptr);
+
+    if (err == CHIP_NO_ERROR)
+    {
+        reply += "OK\n";
+    }
+    else
+    {
+        reply += std::string("ERROR ") + chip::ErrorStr(err) + "\n";
+    }
+
+    return true;
+}
+
+CHIP_ERROR InteractiveStartCommand::ServeStdin()
+{
+    char * line     = nullptr;
+    size_t capacity = 0;
+    std::string reply;
+
+    while (getline(&line, &capacity, stdin) != -1)
+    {
+        bool keepRunning = RunLine(line, reply);
+
+        fputs(reply.c_str(), stdout);
+        fflush(stdout);
+
+        if (!keepRunning)
+        {
+            break;
+        }
+    }
+
+    free(line);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR InteractiveStartCommand::ServeSocket()
+{
+    // The first entry is the listening socket, the others are the connected clients. A client can send many commands
+    // without waiting for their replies; the commands of all the clients run one at a time, since each command object
+    // holds the state of its current run and the output of concurrent commands could not be told apart.
+    struct pollfd fds[kMaxClients + 1];
+    std::string pending[kMaxClients + 1];
+    nfds_t count     = 1;
+    bool keepRunning = true;
+    CHIP_ERROR err   = CHIP_NO_ERROR;
+    std::string reply;
+
+    fds[0].fd     = mListenFd;
+    fds[0].events = POLLIN;
+
+    chip::Logging::SetLogRedirectCallback(LogAndCollectOutput);
+
+    while (keepRunning)
+    {
+        if (poll(fds, count, -1) < 0)
+        {
+            if (errno != EINTR)
+            {
+                err = CHIP_ERROR_POSIX(errno);
+                break;
+            }
+            continue;
+        }
+
+        // Walk the clients backwards, so that a client that left can be replaced by the last one.
+        for (nfds_t i = count - 1; i > 0 && keepRunning; i--)
+        {
+            if (fds[i].revents == 0)
+            {
+                continue;
+            }
+
+            char buffer[1024];
+            ssize_t received = recv(fds[i].fd, buffer, sizeof(buffer), 0);
+            if (received <= 0)
+            {
+                close(fds[i].fd);
+                count--;
+                fds[i]     = fds[count];
+                pending[i] = std::move(pending[count]);
+                pending[count].clear();
+                continue;
+            }
+
+            pending[i].append(buffer, static_cast<size_t>(received));
+
+            size_t end;
+            while (keepRunning && (end = pending[i].find('\n')) != std::string::npos)
+            {
+                std::string line = pending[i].substr(0, end);
+                pending[i].erase(0, end + 1);
+
+                keepRunning = RunLine(&line[0], reply);
+                if (!reply.empty() && send(fds[i].fd, reply.data(), reply.size(), MSG_NOSIGNAL) < 0)
+                {
+                    ChipLogError(chipTool, "Failed to reply to a client: %s", strerror(errno));
+                }
+            }
+        }
+
+        if (keepRunning && (fds[0].revents & POLLIN))
+        {
+            int fd = accept4(mListenFd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd >= 0 && count <= kMaxClients)
+            {
+                fds[count].fd     = fd;
+                fds[count].events = POLLIN;
+                count++;
+            }
+            else if (fd >= 0)
+            {
+                ChipLogError(chipTool, "Too many clients, closing the new connection");
+                close(fd);
+            }
+        }
+    }
+
+    chip::Logging::SetLogRedirectCallback(nullptr);
+
+    for (nfds_t i = 1; i < count; i++)
+    {
+        close(fds[i].fd);
+    }
+
+    return err;
+}
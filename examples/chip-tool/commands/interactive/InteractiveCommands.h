@@ -0,0 +1,62 @@
+/*
+ *   Copyright (c) 2022 Project CHIP Authors
+ *   All rights reserved.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include "../common/CHIPCommand.h"
+#include "../common/Commands.h"
+
+#include <string>
+#include <thread>
+
+/**
+ * Keeps the stack and the commissioners up and runs the commands read from stdin, or from up to kMaxClients clients
+ * of a Unix socket, one line per command. The commands reuse the CASE sessions and keep the subscriptions established
+ * by the previous ones, and run one at a time. Each command is answered with a line holding "OK" or "ERROR" and the
+ * error, preceded for socket clients by the chip-tool log lines of the command, such as its decoded responses.
+ */
+class InteractiveStartCommand : public CHIPCommand
+{
+public:
+    InteractiveStartCommand(Commands * commandsHandler, CredentialIssuerCommands * credsIssuerConfig) :
+        CHIPCommand("start", credsIssuerConfig), mHandler(commandsHandler)
+    {
+        AddArgument("socket-path", &mSocketPath);
+    }
+
+    /////////// CHIPCommand Interface /////////
+    CHIP_ERROR RunCommand() override;
+    // The session lasts until its input is closed or it reads "quit".
+    chip::System::Clock::Timeout GetWaitDuration() const override { return chip::System::Clock::Milliseconds32(UINT32_MAX); }
+    void Shutdown() override;
+
+private:
+    static constexpr size_t kMaxClients = 8;
+
+    void ReaderMain();
+    CHIP_ERROR ServeStdin();
+    CHIP_ERROR ServeSocket();
+
+    // Run a line of the session and fill in the reply to send back. Returns false when the line ends the session.
+    bool RunLine(char * line, std::string & reply);
+
+    Commands * mHandler;
+    chip::Optional<char *> mSocketPath;
+    int mListenFd = -1;
+    std::thread mReader;
+};
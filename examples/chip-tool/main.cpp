@@ -20,6 +20,7 @@
 #include "commands/example/ExampleCredentialIssuerCommands.h"
 
 #include "commands/discover/Commands.h"
+#include "commands/interactive/Commands.h"
 #include "commands/pairing/Commands.h"
 #include "commands/payload/Commands.h"
 
@@ -38,6 +39,7 @@ int main(int argc, char * argv[])
     registerCommandsPairing(commands, &credIssuerCommands);
     registerCommandsTests(commands);
     registerClusters(commands);
+    registerCommandsInteractive(commands, &credIssuerCommands);
 
     return commands.Run(argc, argv);
 }
@@ -0,0 +1,117 @@
+/*
+ *   Copyright (c) 2022 Project CHIP Authors
+ *   All rights reserved.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+#include "ChromeTraceExporter.h"
+
+#include <fstream>
+#include <inttypes.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <lib/support/CodeUtils.h>
+#include <system/SystemTrace.h>
+
+namespace chip {
+namespace trace {
+
+namespace {
+
+using System::Trace::Event;
+using System::Trace::EventType;
+
+struct ExportContext
+{
+    std::ofstream & mFile;
+    long mProcessId;
+    bool mFirstEvent;
+};
+
+const char * GetPhase(EventType type)
+{
+    switch (type)
+    {
+    case EventType::kBegin:
+        return "B";
+    case EventType::kEnd:
+        return "E";
+    case EventType::kAsyncBegin:
+        return "b";
+    case EventType::kAsyncEnd:
+        return "e";
+    case EventType::kCounter:
+        return "C";
+    case EventType::kInstant:
+        return "i";
+    }
+    return "i";
+}
+
+// Event names are string literals from the CHIP_TRACE_* macros, so they need no escaping.
+void WriteEvent(uint32_t threadId, const Event & event, void * context)
+{
+    ExportContext * exportContext = static_cast<ExportContext *>(context);
+    std::ofstream & file          = exportContext->mFile;
+
+    file << (exportContext->mFirstEvent ? "\n" : ",\n");
+    exportContext->mFirstEvent = false;
+
+    file << "{\"name\":\"" << event.mName << "\",\"cat\":\"" << System::Trace::GetCategoryName(event.mCategory)
+         << "\",\"ph\":\"" << GetPhase(event.mType) << "\",\"ts\":" << event.mTimestampUs
+         << ",\"pid\":" << exportContext->mProcessId << ",\"tid\":" << threadId;
+
+    switch (event.mType)
+    {
+    case EventType::kAsyncBegin:
+    case EventType::kAsyncEnd: {
+        char id[sizeof("0x") + 2 * sizeof(uint64_t)];
+        snprintf(id, sizeof(id), "0x%" PRIx64, static_cast<uint64_t>(event.mValue));
+        file << ",\"id\":\"" << id << "\"";
+        break;
+    }
+    case EventType::kCounter:
+        file << ",\"args\":{\"value\":" << event.mValue << "}";
+        break;
+    case EventType::kInstant:
+        file << ",\"s\":\"t\"";
+        break;
+    default:
+        break;
+    }
+
+    file << "}";
+}
+
+} // namespace
+
+CHIP_ERROR WriteChromeTrace(const char * fileName)
+{
+    std::ofstream file(fileName);
+    VerifyOrReturnError(file.is_open(), CHIP_ERROR_OPEN_FAILED);
+
+    ExportContext context{ file, static_cast<long>(getpid()), true };
+
+    file << "{\"traceEvents\":[";
+    System::Trace::DrainEvents(WriteEvent, &context);
+    file << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":" << System::Trace::GetDroppedEventCount() << "}}\n";
+
+    file.close();
+    VerifyOrReturnError(!file.fail(), CHIP_ERROR_WRITE_FAILED);
+    return CHIP_NO_ERROR;
+}
+
+} // namespace trace
+} // namespace chip
@@ -0,0 +1,33 @@
+/*
+ *   Copyright (c) 2022 Project CHIP Authors
+ *   All rights reserved.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ *
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+
+namespace chip {
+namespace trace {
+
+/**
+ * Drain the structured trace events (see system/SystemTrace.h) recorded so far and write them to a file in the Chrome
+ * trace event format, which chrome://tracing and https://ui.perfetto.dev can open.
+ */
+CHIP_ERROR WriteChromeTrace(const char * fileName);
+
+} // namespace trace
+} // namespace chip
@@ -17,6 +17,8 @@
  */
 
 #include <iostream>
+#include <stdio.h>
+#include <string>
 #include <thread>
 
 #include <platform/CHIPDeviceLayer.h>
@@ -37,6 +39,7 @@
 #include <lib/support/ScopedBuffer.h>
 #include <setup_payload/QRCodeSetupPayloadGenerator.h>
 #include <setup_payload/SetupPayload.h>
+#include <system/SystemMetrics.h>
 
 #if CHIP_DEVICE_CONFIG_ENABLE_BOTH_COMMISSIONER_AND_COMMISSIONEE
 #include <ControllerShellCommands.h>
@@ -394,6 +397,35 @@ DeviceCommissioner * GetDeviceCommissioner()
 
 #endif // CHIP_DEVICE_CONFIG_ENABLE_BOTH_COMMISSIONER_AND_COMMISSIONEE
 
+#if CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+static constexpr System::Clock::Seconds16 kMetricsFileUpdateInterval = System::Clock::Seconds16(10);
+
+static void WriteMetricsFile(System::Layer * systemLayer, void * appState)
+{
+    const char * path = LinuxDeviceOptions::GetInstance().metricsFile;
+
+    // Write to a temporary file and rename it, so that collectors never read a partially written file.
+    std::string tmpPath = std::string(path) + ".tmp";
+    FILE * file         = fopen(tmpPath.c_str(), "w");
+    if (file == nullptr)
+    {
+        ChipLogError(AppServer, "Failed to open metrics file %s", tmpPath.c_str());
+    }
+    else
+    {
+        System::Metrics::WritePrometheusText([](const char * text, void * context) { fputs(text, static_cast<FILE *>(context)); },
+                                             file);
+        fclose(file);
+        if (rename(tmpPath.c_str(), path) != 0)
+        {
+            ChipLogError(AppServer, "Failed to write metrics file %s", path);
+        }
+    }
+
+    systemLayer->StartTimer(kMetricsFileUpdateInterval, WriteMetricsFile, appState);
+}
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+
 void ChipLinuxAppMainLoop()
 {
 #if defined(ENABLE_CHIP_SHELL)
@@ -431,6 +463,13 @@ void ChipLinuxAppMainLoop()
 
     ApplicationInit();
 
+#if CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+    if (LinuxDeviceOptions::GetInstance().metricsFile != nullptr)
+    {
+        DeviceLayer::SystemLayer().StartTimer(System::Clock::kZero, WriteMetricsFile, nullptr);
+    }
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+
     chip::DeviceLayer::PlatformMgr().RunEventLoop();
 
 #if CHIP_DEVICE_CONFIG_ENABLE_BOTH_COMMISSIONER_AND_COMMISSIONEE
@@ -47,7 +47,8 @@ enum
     kDeviceOption_SecuredCommissionerPort   = 0x100b,
     kDeviceOption_UnsecuredCommissionerPort = 0x100c,
     kDeviceOption_Command                   = 0x100d,
-    kDeviceOption_PICS                      = 0x100e
+    kDeviceOption_PICS                      = 0x100e,
+    kDeviceOption_MetricsFile               = 0x100f
 };
 
 constexpr unsigned kAppUsageLength = 64;
@@ -74,6 +75,9 @@ OptionDef sDeviceOptionDefs[] = {
     { "unsecured-commissioner-port", kArgumentRequired, kDeviceOption_UnsecuredCommissionerPort },
     { "command", kArgumentRequired, kDeviceOption_Command },
     { "PICS", kArgumentRequired, kDeviceOption_PICS },
+#if CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+    { "metrics-file", kArgumentRequired, kDeviceOption_MetricsFile },
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
     {}
 };
 
@@ -129,7 +133,14 @@ const char * sDeviceOptionHelp =
     "\n"
     "  --PICS <filepath>\n"
     "       A file containing PICS items.\n"
-    "\n";
+    "\n"
+#if CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+    "  --metrics-file <filepath>\n"
+    "       A file to periodically write the runtime metrics to, in the Prometheus text format (e.g. for the node\n"
+    "       exporter textfile collector).\n"
+    "\n"
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+    ;
 
 bool HandleOption(const char * aProgram, OptionSet * aOptions, int aIdentifier, const char * aName, const char * aValue)
 {
@@ -213,6 +224,12 @@ bool HandleOption(const char * aProgram, OptionSet * aOptions, int aIdentifier,
         LinuxDeviceOptions::GetInstance().PICS = aValue;
         break;
 
+#if CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+    case kDeviceOption_MetricsFile:
+        LinuxDeviceOptions::GetInstance().metricsFile = aValue;
+        break;
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+
     default:
         PrintArgError("%s: INTERNAL ERROR: Unhandled option: %s\n", aProgram, aName);
         retval = false;
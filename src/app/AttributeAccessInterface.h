@@ -124,6 +124,11 @@ public:
         AttributeEncodeState() : mAllowPartialData(false), mCurrentEncodingListIndex(kInvalidListIndex) {}
         bool AllowPartialData() const { return mAllowPartialData; }
 
+        /**
+         * Whether nothing has been encoded for the attribute yet, as opposed to resuming the encoding of a chunked list.
+         */
+        bool IsInitial() const { return !mAllowPartialData && mCurrentEncodingListIndex == kInvalidListIndex; }
+
     private:
         friend class AttributeValueEncoder;
         /**
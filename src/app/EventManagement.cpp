@@ -63,6 +63,8 @@ struct ReclaimEventCtx
 {
     CircularEventBuffer * mpEventBuffer = nullptr;
     size_t mSpaceNeededForMovedEvent    = 0;
+    EventNumber mEventNumber            = 0;
+    ClusterId mClusterId                = 0;
 };
 
 /**
@@ -215,6 +217,7 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace)
     CHIP_ERROR err                    = CHIP_NO_ERROR;
     size_t requiredSpace              = aRequiredSpace;
     CircularEventBuffer * eventBuffer = mpEventBuffer;
+    const uint8_t * eventStart        = nullptr;
     ReclaimEventCtx ctx;
 
     // check whether we actually need to do anything, exit if we don't
@@ -233,6 +236,10 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace)
             eventBuffer->mProcessEvictedElement = EvictEvent;
             eventBuffer->mAppData               = &ctx;
             err                                 = eventBuffer->EvictHead();
+            if (err == CHIP_NO_ERROR)
+            {
+                eventBuffer->NoteEventEvicted(ctx.mEventNumber);
+            }
 
             // one of two things happened: either the element was evicted immediately if the head's priority is same as current
             // buffer(final one), or we figured out how much space we need to evict it into the next buffer, the check happens in
@@ -250,8 +257,10 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace)
                     // Since we're calling CopyElement and we've checked
                     // that there is space in the next buffer, we don't expect
                     // this to fail.
-                    err = CopyToNextBuffer(eventBuffer);
+                    eventStart = eventBuffer->GetNextCircularEventBuffer()->QueueTail();
+                    err        = CopyToNextBuffer(eventBuffer);
                     SuccessOrExit(err);
+                    eventBuffer->GetNextCircularEventBuffer()->NoteEvent(ctx.mEventNumber, ctx.mClusterId, eventStart);
                     // success; evict head unconditionally
                     eventBuffer->mProcessEvictedElement = nullptr;
                     err                                 = eventBuffer->EvictHead();
@@ -261,6 +270,7 @@ CHIP_ERROR EventManagement::EnsureSpaceInCircularBuffer(size_t aRequiredSpace)
                     // caller know that we could not honor the
                     // request
                     SuccessOrExit(err);
+                    eventBuffer->NoteEventEvicted(ctx.mEventNumber);
                     continue;
                 }
                 // we cannot copy event outright. We remember the
@@ -466,6 +476,7 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
     aEventNumber                 = 0;
     CircularTLVWriter checkpoint = writer;
     CircularEventBuffer * buffer = nullptr;
+    const uint8_t * eventStart   = nullptr;
     EventLoadOutContext ctxt     = EventLoadOutContext(writer, aEventOptions.mPriority, mLastEventNumber);
     EventOptions opts;
 #if CHIP_CONFIG_EVENT_LOGGING_UTC_TIMESTAMPS & CHIP_SYSTEM_CONFIG_PLATFORM_PROVIDES_TIME
@@ -500,7 +511,8 @@ CHIP_ERROR EventManagement::LogEventPrivate(EventLoggingDelegate * apDelegate, c
     err = EnsureSpaceInCircularBuffer(requestSize);
     SuccessOrExit(err);
 
-    err = ConstructEvent(&ctxt, apDelegate, &opts);
+    eventStart = mpEventBuffer->QueueTail();
+    err        = ConstructEvent(&ctxt, apDelegate, &opts);
     SuccessOrExit(err);
 
     // Check the number of bytes written.  If the event is too large
@@ -532,6 +544,7 @@ exit:
     else if (opts.mPriority >= CHIP_CONFIG_EVENT_GLOBAL_PRIORITY)
     {
         aEventNumber = mLastEventNumber;
+        mpEventBuffer->NoteEvent(aEventNumber, opts.mPath.mClusterId, eventStart);
         VendEventNumber();
         mLastEventTimestamp = timestamp;
 #if CHIP_CONFIG_EVENT_LOGGING_VERBOSE_DEBUG_LOGS
@@ -596,6 +609,20 @@ static bool IsInterestedEventPaths(EventLoadOutContext * eventLoadOutContext, co
     return false;
 }
 
+static CHIP_ERROR GetEventNumber(const TLVReader & aReader, EventNumber & aEventNumber)
+{
+    TLVReader reader(aReader);
+    CHIP_ERROR err;
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        if (reader.GetTag() == TLV::ContextTag(to_underlying(EventDataIB::Tag::kEventNumber)))
+        {
+            return reader.Get(aEventNumber);
+        }
+    }
+    return err;
+}
+
 CHIP_ERROR EventManagement::EventIterator(const TLVReader & aReader, size_t aDepth, EventLoadOutContext * apEventLoadOutContext)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -603,12 +630,21 @@ CHIP_ERROR EventManagement::EventIterator(const TLVReader & aReader, size_t aDep
     TLVType tlvType;
     TLVType tlvType1;
     EventEnvelopeContext event;
+    EventNumber eventNumber;
 
     innerReader.Init(aReader);
     ReturnErrorOnFailure(innerReader.EnterContainer(tlvType));
     ReturnErrorOnFailure(innerReader.Next());
 
     ReturnErrorOnFailure(innerReader.EnterContainer(tlvType1));
+
+    // The event number follows the path, so already fetched events are skipped without decoding the rest of the envelope
+    if (GetEventNumber(innerReader, eventNumber) == CHIP_NO_ERROR && eventNumber < apEventLoadOutContext->mStartingEventNumber)
+    {
+        apEventLoadOutContext->mCurrentEventNumber = eventNumber;
+        return CHIP_NO_ERROR;
+    }
+
     err = TLV::Utilities::Iterate(innerReader, FetchEventParameters, &event, false /*recurse*/);
 
     if (event.mFieldsToRead != kRequiredEventField)
@@ -668,6 +704,8 @@ CHIP_ERROR EventManagement::FetchEventsSince(TLVWriter & aWriter, ClusterInfo *
     const bool recurse = false;
     TLVReader reader;
     CircularEventBufferWrapper bufWrapper;
+    CircularEventBuffer * buffer = nullptr;
+    EventNumber startEventNumber = 0;
     EventLoadOutContext context(aWriter, PriorityLevel::Invalid, aEventMin);
 
 #if !CHIP_SYSTEM_CONFIG_NO_LOCKING
@@ -675,7 +713,27 @@ CHIP_ERROR EventManagement::FetchEventsSince(TLVWriter & aWriter, ClusterInfo *
 #endif // !CHIP_SYSTEM_CONFIG_NO_LOCKING
 
     context.mpInterestedEventPaths = apClusterInfolist;
-    err                            = GetEventReader(reader, PriorityLevel::Critical, &bufWrapper);
+
+    // Skip the oldest buffers as long as none of their events can be fetched, accounting their events as read
+    buffer = GetPriorityBuffer(PriorityLevel::Critical);
+    while (buffer != nullptr && !buffer->MayContainEvents(aEventMin, apClusterInfolist))
+    {
+        if (buffer->DataLength() != 0 && buffer->GetLastEventNumber() > context.mCurrentEventNumber)
+        {
+            context.mCurrentEventNumber = buffer->GetLastEventNumber();
+        }
+        buffer = buffer->GetPreviousCircularEventBuffer();
+    }
+    VerifyOrExit(buffer != nullptr, err = CHIP_NO_ERROR);
+
+    // Within the first buffer read, start at the newest indexed event that is not newer than aEventMin
+    bufWrapper.mpStart = buffer->FindEventStart(aEventMin, startEventNumber);
+    if (bufWrapper.mpStart != nullptr && startEventNumber > context.mCurrentEventNumber + 1)
+    {
+        context.mCurrentEventNumber = startEventNumber - 1;
+    }
+
+    err = GetEventReader(reader, buffer->GetPriority(), &bufWrapper);
     SuccessOrExit(err);
 
     err = TLV::Utilities::Iterate(reader, CopyEventsSince, &context, recurse);
@@ -776,6 +834,8 @@ CHIP_ERROR EventManagement::EvictEvent(CHIPCircularTLVBuffer & apBuffer, void *
 
     ReclaimEventCtx * const ctx             = static_cast<ReclaimEventCtx *>(apAppData);
     CircularEventBuffer * const eventBuffer = ctx->mpEventBuffer;
+    ctx->mEventNumber                       = context.mEventNumber;
+    ctx->mClusterId                         = context.mClusterId;
     if (eventBuffer->IsFinalDestinationForPriority(imp))
     {
         ChipLogProgress(EventLogging,
@@ -809,7 +869,113 @@ void CircularEventBuffer::Init(uint8_t * apBuffer, uint32_t aBufferLength, Circu
     mpPrev               = apPrev;
     mpNext               = apNext;
     mPriority            = aPriorityLevel;
-    mpEventNumberCounter = nullptr;
+    mpEventNumberCounter   = nullptr;
+    mLastEventNumber       = 0;
+    mClusterFilter         = 0;
+    mPreviousClusterFilter = 0;
+    mClusterFilterStart    = 0;
+#if CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE > 0
+    mOffsetIndexFirst = 0;
+    mOffsetIndexCount = 0;
+#endif // CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE > 0
+}
+
+static uint64_t ClusterFilterBit(ClusterId aClusterId)
+{
+    // Fold the vendor prefix into the cluster number so that vendor clusters spread over the filter too
+    return static_cast<uint64_t>(1) << ((aClusterId ^ (aClusterId >> 16)) % 64);
+}
+
+#if CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE > 0
+static_assert(CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE <= UINT8_MAX, "The event offset index is counted in a uint8_t");
+#endif // CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE > 0
+
+void CircularEventBuffer::NoteEvent(EventNumber aEventNumber, ClusterId aClusterId, const uint8_t * apEventStart)
+{
+    mLastEventNumber = aEventNumber;
+    mClusterFilter |= ClusterFilterBit(aClusterId);
+
+#if CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE > 0
+    // Space the checkpoints evenly over the storage, replacing the oldest one once the index is full
+    const uint32_t offset = static_cast<uint32_t>(apEventStart - GetQueue());
+    if (mOffsetIndexCount != 0)
+    {
+        const EventOffset & last = mOffsetIndex[(mOffsetIndexFirst + mOffsetIndexCount - 1) % CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE];
+        const uint32_t distance  = (offset + GetTotalDataLength() - last.mOffset) % GetTotalDataLength();
+        VerifyOrReturn(distance >= GetTotalDataLength() / CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE);
+    }
+    if (mOffsetIndexCount == CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE)
+    {
+        mOffsetIndexFirst = static_cast<uint8_t>((mOffsetIndexFirst + 1) % CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE);
+        mOffsetIndexCount--;
+    }
+    EventOffset & checkpoint = mOffsetIndex[(mOffsetIndexFirst + mOffsetIndexCount) % CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE];
+    checkpoint.mEventNumber  = aEventNumber;
+    checkpoint.mOffset       = offset;
+    mOffsetIndexCount++;
+#endif // CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE > 0
+}
+
+void CircularEventBuffer::NoteEventEvicted(EventNumber aEventNumber)
+{
+    // Events leave a buffer in the order they were appended, so once the evicted event is the last one of the previous
+    // generation, that generation's filter no longer describes anything in the buffer.
+    if (DataLength() == 0 || aEventNumber + 1 >= mClusterFilterStart)
+    {
+        mPreviousClusterFilter = (DataLength() == 0) ? 0 : mClusterFilter;
+        mClusterFilter         = 0;
+        mClusterFilterStart    = mLastEventNumber + 1;
+    }
+
+#if CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE > 0
+    // The storage of an evicted event gets reused, so drop the checkpoints up to it
+    while (mOffsetIndexCount != 0 && (DataLength() == 0 || mOffsetIndex[mOffsetIndexFirst].mEventNumber <= aEventNumber))
+    {
+        mOffsetIndexFirst = static_cast<uint8_t>((mOffsetIndexFirst + 1) % CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE);
+        mOffsetIndexCount--;
+    }
+#endif // CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE > 0
+}
+
+const uint8_t * CircularEventBuffer::FindEventStart(EventNumber aEventMin, EventNumber & aEventNumber) const
+{
+    const uint8_t * eventStart = nullptr;
+
+#if CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE > 0
+    const uint32_t headOffset = static_cast<uint32_t>(QueueHead() - GetQueue());
+    for (uint8_t i = 0; i < mOffsetIndexCount; i++)
+    {
+        const EventOffset & checkpoint = mOffsetIndex[(mOffsetIndexFirst + i) % CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE];
+        if (checkpoint.mEventNumber > aEventMin)
+        {
+            break;
+        }
+        // Only trust checkpoints that still lie between the head and the tail of the buffer
+        if ((checkpoint.mOffset + GetTotalDataLength() - headOffset) % GetTotalDataLength() < DataLength())
+        {
+            eventStart   = GetQueue() + checkpoint.mOffset;
+            aEventNumber = checkpoint.mEventNumber;
+        }
+    }
+#endif // CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE > 0
+
+    return eventStart;
+}
+
+bool CircularEventBuffer::MayContainEvents(EventNumber aEventMin, const ClusterInfo * apInterestedPaths) const
+{
+    // Events only leave a buffer from its head, so the newest event stays in the buffer for as long as it is not empty
+    VerifyOrReturnError(DataLength() != 0 && mLastEventNumber >= aEventMin, false);
+
+    for (const ClusterInfo * interestedPath = apInterestedPaths; interestedPath != nullptr; interestedPath = interestedPath->mpNext)
+    {
+        if (interestedPath->HasWildcardClusterId() ||
+            ((mClusterFilter | mPreviousClusterFilter) & ClusterFilterBit(interestedPath->mClusterId)) != 0)
+        {
+            return true;
+        }
+    }
+    return false;
 }
 
 bool CircularEventBuffer::IsFinalDestinationForPriority(PriorityLevel aPriority) const
@@ -838,6 +1004,17 @@ void CircularEventReader::Init(CircularEventBufferWrapper * apBufWrapper)
 CHIP_ERROR CircularEventBufferWrapper::GetNextBuffer(TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
+    if (aBufStart == nullptr && mpStart != nullptr)
+    {
+        // Read from mpStart up to the tail, or up to the end of the storage if the data wraps around
+        const uint8_t * tail = mpCurrent->QueueTail();
+        aBufStart            = mpStart;
+        aBufLen              = (tail > mpStart) ? static_cast<uint32_t>(tail - mpStart)
+                                                : mpCurrent->GetTotalDataLength() - static_cast<uint32_t>(mpStart - mpCurrent->GetQueue());
+        mpStart              = nullptr;
+        return err;
+    }
+
     mpCurrent->GetNextBuffer(aReader, aBufStart, aBufLen);
     SuccessOrExit(err);
 
@@ -96,6 +96,50 @@ public:
     void SetRequiredSpaceforEvicted(size_t aRequiredSpace) { mRequiredSpaceForEvicted = aRequiredSpace; }
     size_t GetRequiredSpaceforEvicted() { return mRequiredSpaceForEvicted; }
 
+    /**
+     * @brief
+     *   Record that an event was appended to this buffer.
+     *
+     * @param[in] aEventNumber  The number of the appended event.
+     * @param[in] aClusterId    The cluster of the appended event.
+     * @param[in] apEventStart  Where the appended event starts in this buffer.
+     */
+    void NoteEvent(EventNumber aEventNumber, ClusterId aClusterId, const uint8_t * apEventStart);
+
+    /**
+     * @brief
+     *   Record that the oldest event of this buffer was evicted, so that the clusters of evicted events eventually stop
+     *   matching MayContainEvents.
+     *
+     * @param[in] aEventNumber  The number of the evicted event.
+     */
+    void NoteEventEvicted(EventNumber aEventNumber);
+
+    /**
+     * @brief
+     *   A helper function that determines whether this buffer may hold events numbered at least aEventMin on one
+     *   of the interested paths. It may return true for a buffer without such events, but never false for a buffer
+     *   holding one, so that callers can skip the buffer without parsing it.
+     *
+     * @param[in] aEventMin          The smallest event number of interest.
+     * @param[in] apInterestedPaths  The interested event paths.
+     */
+    bool MayContainEvents(EventNumber aEventMin, const ClusterInfo * apInterestedPaths) const;
+
+    /**
+     * @brief
+     *   Look up where to start reading this buffer for the events numbered at least aEventMin.
+     *
+     * @param[in]  aEventMin     The smallest event number of interest.
+     * @param[out] aEventNumber  The number of the event starting at the returned position.
+     *
+     * @return The start of the newest indexed event numbered at most aEventMin, or nullptr if the buffer must be read
+     *         from its head.
+     */
+    const uint8_t * FindEventStart(EventNumber aEventMin, EventNumber & aEventNumber) const;
+
+    EventNumber GetLastEventNumber() const { return mLastEventNumber; }
+
     virtual ~CircularEventBuffer() = default;
 
 private:
@@ -112,6 +156,29 @@ private:
     MonotonicallyIncreasingCounter mNonPersistedCounter;
 
     size_t mRequiredSpaceForEvicted = 0; ///< Required space for previous buffer to evict event to new buffer
+
+    EventNumber mLastEventNumber = 0; ///< Number of the newest event appended to this buffer
+
+    // Bloom filters of the clusters of the buffered events. Bits cannot be removed from a bloom filter, so events are split
+    // in two generations: once every event older than mClusterFilterStart has been evicted, the older filter is dropped and
+    // a new generation starts after the newest event.
+    uint64_t mClusterFilter         = 0; ///< Clusters of the events numbered at least mClusterFilterStart
+    uint64_t mPreviousClusterFilter = 0; ///< Clusters of the buffered events numbered below mClusterFilterStart
+    EventNumber mClusterFilterStart = 0;
+
+#if CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE > 0
+    struct EventOffset
+    {
+        EventNumber mEventNumber;
+        uint32_t mOffset; ///< Offset of the event from the start of the buffer storage
+    };
+
+    // Checkpoints of the buffered events in increasing event number order, kept in a ring starting at mOffsetIndexFirst.
+    // Events keep their place in the storage until evicted, so a checkpoint stays valid until its event is evicted.
+    EventOffset mOffsetIndex[CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE];
+    uint8_t mOffsetIndexFirst = 0;
+    uint8_t mOffsetIndexCount = 0;
+#endif // CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE > 0
 };
 
 class CircularEventReader;
@@ -127,6 +194,7 @@ class CircularEventBufferWrapper : public TLV::CHIPCircularTLVBuffer
 public:
     CircularEventBufferWrapper() : CHIPCircularTLVBuffer(nullptr, 0), mpCurrent(nullptr){};
     CircularEventBuffer * mpCurrent;
+    const uint8_t * mpStart = nullptr; ///< Where to start reading mpCurrent instead of its head, if set
 
 private:
     CHIP_ERROR GetNextBuffer(chip::TLV::TLVReader & aReader, const uint8_t *& aBufStart, uint32_t & aBufLen) override;
@@ -315,6 +383,10 @@ public:
      * will terminate the event writing on event boundary. The function would filter out event based upon interested path
      * specified by read/subscribe request.
      *
+     * Events are read back in increasing event number order, so the buffers whose events are all older than
+     * aEventMin, or on clusters outside the interested paths, are skipped without being parsed. Within the first buffer
+     * read, reading starts at the newest event of its offset index that is not newer than aEventMin.
+     *
      * @param[in] aWriter     The writer to use for event storage
      * @param[in] apClusterInfolist the interested cluster info list with event path inside
      *
@@ -24,7 +24,9 @@
  */
 
 #include "InteractionModelEngine.h"
+#include <app/CASESessionManager.h>
 #include <cinttypes>
+#include <credentials/FabricTable.h>
 
 namespace chip {
 namespace app {
@@ -87,6 +89,9 @@ void InteractionModelEngine::Shutdown()
 
     mTimedHandlers.ReleaseAll();
 
+    // Keep the saved subscriptions, the subscribers expect them to be resumed after the restart.
+    mpSubscriptionResumptionStorage = nullptr;
+
     for (auto & readHandler : mReadHandlers)
     {
         if (!readHandler.IsFree())
@@ -448,6 +453,40 @@ uint16_t InteractionModelEngine::GetReadHandlerArrayIndex(const ReadHandler * co
     return static_cast<uint16_t>(apReadHandler - mReadHandlers);
 }
 
+void InteractionModelEngine::ResumeSubscriptions(CASESessionManager & aCASESessionManager, FabricTable & aFabricTable)
+{
+    VerifyOrReturn(mpSubscriptionResumptionStorage != nullptr);
+
+    // Subscriptions are saved at the index of their read handler, resume each of them in the same handler so that its record
+    // keeps being updated.
+    SubscriptionResumptionStorage::SubscriptionInfo info;
+    for (uint16_t index = 0; index < CHIP_IM_MAX_NUM_READ_HANDLER; index++)
+    {
+        CHIP_ERROR err = mpSubscriptionResumptionStorage->Load(index, info);
+        if (err == CHIP_ERROR_NOT_FOUND)
+        {
+            continue;
+        }
+
+        FabricInfo * fabricInfo = (err == CHIP_NO_ERROR) ? aFabricTable.FindFabricWithIndex(info.mFabricIndex) : nullptr;
+        if (fabricInfo == nullptr || !mReadHandlers[index].IsFree())
+        {
+            ChipLogError(InteractionModel, "Dropping saved subscription %u", index);
+            mpSubscriptionResumptionStorage->Delete(index);
+            continue;
+        }
+
+        ChipLogProgress(InteractionModel, "Resuming subscription 0x%" PRIx64, info.mSubscriptionId);
+        err = mReadHandlers[index].ResumeSubscription(mpExchangeMgr, mpDelegate, aCASESessionManager,
+                                                      fabricInfo->GetPeerIdForNode(info.mNodeId), info);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(InteractionModel, "Failed to resume subscription 0x%" PRIx64 ": %" CHIP_ERROR_FORMAT, info.mSubscriptionId,
+                         err.Format());
+        }
+    }
+}
+
 void InteractionModelEngine::AddReadClient(ReadClient * apReadClient)
 {
     apReadClient->SetNextClient(mpActiveReadClientList);
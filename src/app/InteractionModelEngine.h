@@ -50,6 +50,7 @@
 #include <app/ReadClient.h>
 #include <app/ReadHandler.h>
 #include <app/StatusResponse.h>
+#include <app/SubscriptionResumptionStorage.h>
 #include <app/TimedHandler.h>
 #include <app/WriteClient.h>
 #include <app/WriteHandler.h>
@@ -57,6 +58,10 @@
 #include <app/util/basic-types.h>
 
 namespace chip {
+
+class CASESessionManager;
+class FabricTable;
+
 namespace app {
 /**
  * @class InteractionModelEngine
@@ -111,6 +116,23 @@ public:
      */
     CHIP_ERROR ShutdownSubscriptions(FabricIndex aFabricIndex, NodeId aPeerNodeId);
 
+    /**
+     * Set the storage the subscriptions established over CASE are saved to, so that they can be resumed after a restart.
+     * The saved subscriptions are kept when the engine is shut down.
+     */
+    void SetSubscriptionResumptionStorage(SubscriptionResumptionStorage * apStorage)
+    {
+        mpSubscriptionResumptionStorage = apStorage;
+    }
+    SubscriptionResumptionStorage * GetSubscriptionResumptionStorage() const { return mpSubscriptionResumptionStorage; }
+
+    /**
+     * Resume the subscriptions saved to the subscription resumption storage before a restart, establishing a CASE session
+     * with each subscriber. Subscriptions whose fabric no longer exists are dropped. Must be called before any subscribe
+     * request is processed.
+     */
+    void ResumeSubscriptions(CASESessionManager & aCASESessionManager, FabricTable & aFabricTable);
+
     /**
      *  Retrieve a WriteClient that the SDK consumer can use to send a write.  If the call succeeds,
      *  see WriteClient documentation for lifetime handling.
@@ -272,6 +294,8 @@ private:
 
     ReadClient * mpActiveReadClientList = nullptr;
 
+    SubscriptionResumptionStorage * mpSubscriptionResumptionStorage = nullptr;
+
     // A magic number for tracking values between stack Shutdown()-s and Init()-s.
     // An ObjectHandle is valid iff. its magic equals to this one.
     uint32_t mMagic = 0;
@@ -316,6 +340,14 @@ CHIP_ERROR ReadSingleClusterData(const Access::SubjectDescriptor & aSubjectDescr
                                  AttributeReportIBs::Builder & aAttributeReports,
                                  AttributeValueEncoder::AttributeEncodeState * apEncoderState);
 
+/**
+ *  Check whether the data ReadSingleClusterData encodes for the given path may depend on the accessing fabric of the reader, e.g.
+ * because the attribute is a list of fabric-scoped structs. The reporting engine only shares encoded attribute data between readers
+ * on different fabrics if this returns false.
+ *  This function is implemented by CHIP as a part of cluster data storage & management; the default implementation returns true.
+ */
+bool IsAttributeDataFabricDependent(const ConcreteAttributePath & aPath);
+
 /**
  * TODO: Document.
  */
@@ -580,6 +580,12 @@ CHIP_ERROR ReadClient::RefreshLivenessCheckTimer()
     System::Clock::Timeout timeout = System::Clock::Seconds16(mMaxIntervalCeilingSeconds) + mpExchangeCtx->GetAckTimeout();
     // EFR32/MBED/INFINION/K32W's chrono count return long unsinged, but other platform returns unsigned
     ChipLogProgress(DataManagement, "Refresh LivenessCheckTime with %lu milliseconds", static_cast<long unsigned>(timeout.count()));
+    if (mpLivenessMonitor != nullptr)
+    {
+        mpLivenessMonitor->RefreshLiveness(*this, timeout);
+        return CHIP_NO_ERROR;
+    }
+
     err = InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->StartTimer(
         timeout, OnLivenessTimeoutCallback, this);
 
@@ -593,6 +599,12 @@ CHIP_ERROR ReadClient::RefreshLivenessCheckTimer()
 
 void ReadClient::CancelLivenessCheckTimer()
 {
+    if (mpLivenessMonitor != nullptr)
+    {
+        mpLivenessMonitor->CancelLiveness(*this);
+        return;
+    }
+
     InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->CancelTimer(
         OnLivenessTimeoutCallback, this);
 }
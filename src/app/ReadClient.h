@@ -163,6 +163,27 @@ public:
         virtual void OnDone(ReadClient * apReadClient) = 0;
     };
 
+    /**
+     * Takes over the liveness check of a subscription, so that the liveness of many subscriptions can be tracked with a
+     * single timer. A read client with a monitor arms no timer of its own and never times out by itself: the monitor
+     * destroys it when no report arrives in time.
+     */
+    class LivenessMonitor
+    {
+    public:
+        virtual ~LivenessMonitor() = default;
+
+        /**
+         * A report was received, the next one is due within aTimeout.
+         */
+        virtual void RefreshLiveness(ReadClient & aReadClient, System::Clock::Timeout aTimeout) = 0;
+
+        /**
+         * The liveness of the subscription no longer needs to be checked.
+         */
+        virtual void CancelLiveness(ReadClient & aReadClient) = 0;
+    };
+
     enum class InteractionType : uint8_t
     {
         Read,
@@ -234,6 +255,11 @@ public:
     bool IsReadType() { return mInteractionType == InteractionType::Read; }
     bool IsSubscriptionType() const { return mInteractionType == InteractionType::Subscribe; };
 
+    /**
+     * Hand the liveness check of the subscription over to the given monitor. Must be called before SendRequest.
+     */
+    void SetLivenessMonitor(LivenessMonitor * apMonitor) { mpLivenessMonitor = apMonitor; }
+
     ReadClient * GetNextClient() { return mpNext; }
     void SetNextClient(ReadClient * apClient) { mpNext = apClient; }
 
@@ -316,6 +342,7 @@ private:
 
     ReadClient * mpNext                 = nullptr;
     InteractionModelEngine * mpImEngine = nullptr;
+    LivenessMonitor * mpLivenessMonitor = nullptr;
 };
 
 }; // namespace app
@@ -23,6 +23,7 @@
  */
 
 #include <app/AppBuildConfig.h>
+#include <app/CASESessionManager.h>
 #include <app/InteractionModelEngine.h>
 #include <app/MessageDef/EventPathIB.h>
 #include <app/MessageDef/StatusResponseMessage.h>
@@ -50,6 +51,7 @@ CHIP_ERROR ReadHandler::Init(Messaging::ExchangeManager * apExchangeMgr, Interac
     mEventMin                  = 0;
     mLastScheduledEventNumber  = 0;
     mIsPrimingReports          = true;
+    mIsResumedReport           = false;
     MoveToState(HandlerState::Initialized);
     mpDelegate              = apDelegate;
     mSubscriptionId         = 0;
@@ -74,8 +76,14 @@ void ReadHandler::Shutdown(ShutdownOptions aOptions)
 {
     if (IsSubscriptionType())
     {
-        InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->CancelTimer(
-            OnRefreshSubscribeTimerSyncCallback, this);
+        InteractionModelEngine::GetInstance()->GetReportingEngine().CancelSubscriptionIntervals(*this);
+        SubscriptionResumptionStorage * storage = InteractionModelEngine::GetInstance()->GetSubscriptionResumptionStorage();
+        if (storage != nullptr && mSubjectDescriptor.authMode == Access::AuthMode::kCase)
+        {
+            storage->Delete(InteractionModelEngine::GetInstance()->GetReadHandlerArrayIndex(this));
+        }
+        mOnConnectedCallback.Cancel();
+        mOnConnectionFailureCallback.Cancel();
         if (mpDelegate != nullptr)
         {
             mpDelegate->SubscriptionTerminated(this);
@@ -109,6 +117,7 @@ void ReadHandler::Shutdown(ShutdownOptions aOptions)
     mEventMin                  = 0;
     mLastScheduledEventNumber  = 0;
     mIsPrimingReports          = false;
+    mIsResumedReport           = false;
     mpDelegate                 = nullptr;
     mHoldReport                = false;
     mDirty                     = false;
@@ -140,6 +149,62 @@ CHIP_ERROR ReadHandler::OnReadInitialRequest(System::PacketBufferHandle && aPayl
     return err;
 }
 
+CHIP_ERROR ReadHandler::ResumeSubscription(Messaging::ExchangeManager * apExchangeMgr, InteractionModelDelegate * apDelegate,
+                                           CASESessionManager & aCASESessionManager, const PeerId & aPeerId,
+                                           const SubscriptionResumptionStorage::SubscriptionInfo & aInfo)
+{
+    VerifyOrReturnError(IsFree(), CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(mpExchangeCtx == nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    CHIP_ERROR err = RestoreSubscription(apExchangeMgr, apDelegate, aInfo);
+    if (err == CHIP_NO_ERROR)
+    {
+        err = aCASESessionManager.FindOrEstablishSession(aPeerId, &mOnConnectedCallback, &mOnConnectionFailureCallback);
+    }
+    if (err != CHIP_NO_ERROR)
+    {
+        Shutdown();
+    }
+    return err;
+}
+
+CHIP_ERROR ReadHandler::RestoreSubscription(Messaging::ExchangeManager * apExchangeMgr, InteractionModelDelegate * apDelegate,
+                                            const SubscriptionResumptionStorage::SubscriptionInfo & aInfo)
+{
+    mpExchangeMgr                  = apExchangeMgr;
+    mpDelegate                     = apDelegate;
+    mInteractionType               = InteractionType::Subscribe;
+    mSubscriptionId                = aInfo.mSubscriptionId;
+    mMinIntervalFloorSeconds       = aInfo.mMinIntervalFloorSeconds;
+    mMaxIntervalCeilingSeconds     = aInfo.mMaxIntervalCeilingSeconds;
+    mIsFabricFiltered              = aInfo.mIsFabricFiltered;
+    mInitiatorNodeId               = aInfo.mNodeId;
+    mSubjectDescriptor             = SubjectDescriptor();
+    mSubjectDescriptor.fabricIndex = aInfo.mFabricIndex;
+    mSubjectDescriptor.authMode    = Access::AuthMode::kCase;
+    mSubjectDescriptor.subject     = aInfo.mNodeId;
+    MoveToState(HandlerState::Initialized);
+    // The subscriber has already received the priming reports before the restart, but data versions are not persisted:
+    // the first report after resuming carries every attribute so that changes made in between are not lost.
+    mIsPrimingReports = false;
+    mIsResumedReport  = true;
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    // PushFront reverses the order of the paths, restore them from the last one to keep the order they were saved in.
+    for (size_t i = aInfo.mAttributePathCount; i > 0 && err == CHIP_NO_ERROR; i--)
+    {
+        ClusterInfo path = aInfo.mAttributePaths[i - 1];
+        err              = InteractionModelEngine::GetInstance()->PushFront(mpAttributeClusterInfoList, path);
+    }
+    for (size_t i = aInfo.mEventPathCount; i > 0 && err == CHIP_NO_ERROR; i--)
+    {
+        ClusterInfo path = aInfo.mEventPaths[i - 1];
+        err              = InteractionModelEngine::GetInstance()->PushFront(mpEventClusterInfoList, path);
+    }
+    mAttributePathExpandIterator = AttributePathExpandIterator(mpAttributeClusterInfoList);
+    return err;
+}
+
 CHIP_ERROR ReadHandler::OnStatusResponse(Messaging::ExchangeContext * apExchangeContext, System::PacketBufferHandle && aPayload)
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
@@ -236,6 +301,7 @@ CHIP_ERROR ReadHandler::SendReportData(System::PacketBufferHandle && aPayload, b
     if (!aMoreChunks)
     {
         ClearDirty();
+        mIsResumedReport = false;
     }
     return err;
 }
@@ -565,7 +631,83 @@ CHIP_ERROR ReadHandler::SendSubscribeResponse()
     {
         mpDelegate->SubscriptionEstablished(this);
     }
-    return mpExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::SubscribeResponse, std::move(packet));
+    ReturnErrorOnFailure(mpExchangeCtx->SendMessage(Protocols::InteractionModel::MsgType::SubscribeResponse, std::move(packet)));
+    PersistSubscription();
+    return CHIP_NO_ERROR;
+}
+
+void ReadHandler::PersistSubscription()
+{
+    SubscriptionResumptionStorage * storage = InteractionModelEngine::GetInstance()->GetSubscriptionResumptionStorage();
+    // Only a subscriber reachable over CASE can be contacted again after a restart.
+    VerifyOrReturn(storage != nullptr && mSubjectDescriptor.authMode == Access::AuthMode::kCase);
+
+    SubscriptionResumptionStorage::SubscriptionInfo info;
+    info.mNodeId                    = mInitiatorNodeId;
+    info.mFabricIndex               = mSubjectDescriptor.fabricIndex;
+    info.mSubscriptionId            = mSubscriptionId;
+    info.mMinIntervalFloorSeconds   = mMinIntervalFloorSeconds;
+    info.mMaxIntervalCeilingSeconds = mMaxIntervalCeilingSeconds;
+    info.mIsFabricFiltered          = mIsFabricFiltered;
+    for (ClusterInfo * path = mpAttributeClusterInfoList; path != nullptr; path = path->mpNext)
+    {
+        VerifyOrReturn(info.mAttributePathCount < SubscriptionResumptionStorage::kMaxPaths);
+        info.mAttributePaths[info.mAttributePathCount++] = *path;
+    }
+    for (ClusterInfo * path = mpEventClusterInfoList; path != nullptr; path = path->mpNext)
+    {
+        VerifyOrReturn(info.mEventPathCount < SubscriptionResumptionStorage::kMaxPaths);
+        info.mEventPaths[info.mEventPathCount++] = *path;
+    }
+
+    CHIP_ERROR err = storage->Save(InteractionModelEngine::GetInstance()->GetReadHandlerArrayIndex(this), info);
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to persist subscription 0x%" PRIx64 ": %" CHIP_ERROR_FORMAT, mSubscriptionId,
+                     err.Format());
+    }
+}
+
+void ReadHandler::OnResumedSessionEstablished(void * context, OperationalDeviceProxy * apDevice)
+{
+    ReadHandler * const _this       = static_cast<ReadHandler *>(context);
+    Optional<SessionHandle> session = apDevice->GetSecureSession();
+    if (!session.HasValue())
+    {
+        OnResumedSessionFailure(context, apDevice->GetPeerId(), CHIP_ERROR_INCORRECT_STATE);
+        return;
+    }
+    _this->OnResumedSession(session.Value());
+}
+
+void ReadHandler::OnResumedSession(const SessionHandle & aSession)
+{
+    ChipLogProgress(DataManagement, "Resumed subscription 0x%" PRIx64 " with node 0x" ChipLogFormatX64, mSubscriptionId,
+                    ChipLogValueX64(mInitiatorNodeId));
+    mSessionHandle.SetValue(aSession);
+    mSubjectDescriptor  = aSession.GetSubjectDescriptor();
+    mActiveSubscription = true;
+    MoveToState(HandlerState::GeneratingReports);
+    if (mpDelegate != nullptr)
+    {
+        mpDelegate->SubscriptionEstablished(this);
+    }
+
+    // Report right away rather than at the end of the max interval, so that the subscriber learns about the new session
+    // before its liveness timeout expires, along with the current value of every attribute.
+    mHoldReport = false;
+    mHoldSync   = false;
+    SetDirty();
+    InteractionModelEngine::GetInstance()->GetReportingEngine().ScheduleRun();
+}
+
+void ReadHandler::OnResumedSessionFailure(void * context, PeerId aPeerId, CHIP_ERROR aError)
+{
+    ReadHandler * const _this = static_cast<ReadHandler *>(context);
+    ChipLogError(DataManagement,
+                 "Failed to resume subscription 0x%" PRIx64 " with node 0x" ChipLogFormatX64 ": %" CHIP_ERROR_FORMAT,
+                 _this->mSubscriptionId, ChipLogValueX64(aPeerId.GetNodeId()), aError.Format());
+    _this->Shutdown();
 }
 
 CHIP_ERROR ReadHandler::ProcessSubscribeRequest(System::PacketBufferHandle && aPayload)
@@ -632,45 +774,30 @@ CHIP_ERROR ReadHandler::ProcessSubscribeRequest(System::PacketBufferHandle && aP
     return CHIP_NO_ERROR;
 }
 
-void ReadHandler::OnUnblockHoldReportCallback(System::Layer * apSystemLayer, void * apAppState)
+void ReadHandler::OnMinIntervalElapsed()
 {
-    VerifyOrReturn(apAppState != nullptr);
-    ReadHandler * readHandler = static_cast<ReadHandler *>(apAppState);
-    ChipLogProgress(DataManagement, "Unblock report hold after min %d seconds", readHandler->mMinIntervalFloorSeconds);
-    readHandler->mHoldReport = false;
-    if (readHandler->mDirty)
+    ChipLogProgress(DataManagement, "Unblock report hold after min %d seconds", mMinIntervalFloorSeconds);
+    mHoldReport = false;
+    if (mDirty)
     {
         InteractionModelEngine::GetInstance()->GetReportingEngine().ScheduleRun();
     }
-    InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->StartTimer(
-        System::Clock::Seconds16(readHandler->mMaxIntervalCeilingSeconds - readHandler->mMinIntervalFloorSeconds),
-        OnRefreshSubscribeTimerSyncCallback, readHandler);
 }
 
-void ReadHandler::OnRefreshSubscribeTimerSyncCallback(System::Layer * apSystemLayer, void * apAppState)
+void ReadHandler::OnMaxIntervalElapsed()
 {
-    VerifyOrReturn(apAppState != nullptr);
-    ReadHandler * readHandler = static_cast<ReadHandler *>(apAppState);
-    readHandler->mHoldSync    = false;
+    mHoldSync = false;
     ChipLogProgress(DataManagement, "Refresh subscribe timer sync after %d seconds",
-                    readHandler->mMaxIntervalCeilingSeconds - readHandler->mMinIntervalFloorSeconds);
+                    mMaxIntervalCeilingSeconds - mMinIntervalFloorSeconds);
     InteractionModelEngine::GetInstance()->GetReportingEngine().ScheduleRun();
 }
 
 CHIP_ERROR ReadHandler::RefreshSubscribeSyncTimer()
 {
     ChipLogProgress(DataManagement, "Refresh Subscribe Sync Timer with max %d seconds", mMaxIntervalCeilingSeconds);
-    InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->CancelTimer(
-        OnUnblockHoldReportCallback, this);
-    InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->CancelTimer(
-        OnRefreshSubscribeTimerSyncCallback, this);
     mHoldReport = true;
     mHoldSync   = true;
-    ReturnErrorOnFailure(
-        InteractionModelEngine::GetInstance()->GetExchangeManager()->GetSessionManager()->SystemLayer()->StartTimer(
-            System::Clock::Seconds16(mMinIntervalFloorSeconds), OnUnblockHoldReportCallback, this));
-
-    return CHIP_NO_ERROR;
+    return InteractionModelEngine::GetInstance()->GetReportingEngine().ScheduleSubscriptionIntervals(*this);
 }
 } // namespace app
 } // namespace chip
@@ -30,8 +30,12 @@
 #include <app/ClusterInfo.h>
 #include <app/EventManagement.h>
 #include <app/InteractionModelDelegate.h>
+#include <app/SubscriptionResumptionStorage.h>
+#include <app/reporting/SubscriptionTimingWheel.h>
+#include <lib/core/CHIPCallback.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/CHIPTLVDebug.hpp>
+#include <lib/core/PeerId.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/DLLUtil.h>
 #include <lib/support/logging/CHIPLogging.h>
@@ -42,7 +46,15 @@
 #include <system/SystemPacketBuffer.h>
 
 namespace chip {
+
+class CASESessionManager;
+class OperationalDeviceProxy;
+
 namespace app {
+namespace reporting {
+class Engine;
+} // namespace reporting
+
 /**
  *  @class ReadHandler
  *
@@ -50,7 +62,7 @@ namespace app {
  *         for the relevant data, and sending a reply.
  *
  */
-class ReadHandler : public Messaging::ExchangeDelegate
+class ReadHandler : public Messaging::ExchangeDelegate, private reporting::SubscriptionTimingWheel::Entry
 {
 public:
     using SubjectDescriptor = Access::SubjectDescriptor;
@@ -67,6 +79,10 @@ public:
         Subscribe,
     };
 
+    ReadHandler() :
+        mOnConnectedCallback(OnResumedSessionEstablished, this), mOnConnectionFailureCallback(OnResumedSessionFailure, this)
+    {}
+
     /**
      *  Initialize the ReadHandler. Within the lifetime
      *  of this instance, this method is invoked once after object
@@ -98,6 +114,19 @@ public:
      */
     CHIP_ERROR OnReadInitialRequest(System::PacketBufferHandle && aPayload);
 
+    /**
+     *  Resume a subscription saved before a restart. The ReadHandler establishes a CASE session with the subscriber and
+     *  keeps reporting on the subscription id the subscriber already knows, without sending priming reports again. Like
+     *  OnReadInitialRequest, the ReadHandler calls Shutdown on itself if the subscription cannot be resumed.
+     *
+     *  @retval #Others If fails to start establishing the session
+     *  @retval #CHIP_NO_ERROR On success.
+     *
+     */
+    CHIP_ERROR ResumeSubscription(Messaging::ExchangeManager * apExchangeMgr, InteractionModelDelegate * apDelegate,
+                                  CASESessionManager & aCASESessionManager, const PeerId & aPeerId,
+                                  const SubscriptionResumptionStorage::SubscriptionInfo & aInfo);
+
     /**
      *  Send ReportData to initiator
      *
@@ -130,6 +159,8 @@ public:
     bool IsSubscriptionType() { return mInteractionType == InteractionType::Subscribe; }
     bool IsChunkedReport() { return mIsChunkedReport; }
     bool IsPriming() { return mIsPrimingReports; }
+    // Whether the report being generated carries every attribute path rather than only the dirty ones.
+    bool IsFullReport() { return mIsPrimingReports || mIsResumedReport; }
     bool IsActiveSubscription() const { return mActiveSubscription; }
     CHIP_ERROR OnSubscribeRequest(Messaging::ExchangeContext * apExchangeContext, System::PacketBufferHandle && aPayload);
     void GetSubscriptionId(uint64_t & aSubscriptionId) { aSubscriptionId = mSubscriptionId; }
@@ -161,6 +192,7 @@ public:
 
 private:
     friend class TestReadInteraction;
+    friend class reporting::Engine;
     enum class HandlerState
     {
         Uninitialized = 0,      ///< The handler has not been initialized
@@ -170,10 +202,27 @@ private:
         AwaitingReportResponse, ///< The handler has sent the report to the client and is awaiting a status response.
     };
 
-    static void OnUnblockHoldReportCallback(System::Layer * apSystemLayer, void * apAppState);
-    static void OnRefreshSubscribeTimerSyncCallback(System::Layer * apSystemLayer, void * apAppState);
+    /**
+     *  Called by the reporting engine once the min interval of the subscription has elapsed.
+     */
+    void OnMinIntervalElapsed();
+    /**
+     *  Called by the reporting engine once the max interval of the subscription has elapsed, or when the engine brings it
+     *  forward to send this report along with others.
+     */
+    void OnMaxIntervalElapsed();
     CHIP_ERROR RefreshSubscribeSyncTimer();
     CHIP_ERROR SendSubscribeResponse();
+    void PersistSubscription();
+    /**
+     *  Restore the state of a subscription saved before a restart into this free ReadHandler, before a session with the
+     *  subscriber is available.
+     */
+    CHIP_ERROR RestoreSubscription(Messaging::ExchangeManager * apExchangeMgr, InteractionModelDelegate * apDelegate,
+                                   const SubscriptionResumptionStorage::SubscriptionInfo & aInfo);
+    static void OnResumedSessionEstablished(void * context, OperationalDeviceProxy * apDevice);
+    void OnResumedSession(const SessionHandle & aSession);
+    static void OnResumedSessionFailure(void * context, PeerId aPeerId, CHIP_ERROR aError);
     CHIP_ERROR ProcessSubscribeRequest(System::PacketBufferHandle && aPayload);
     CHIP_ERROR ProcessReadRequest(System::PacketBufferHandle && aPayload);
     CHIP_ERROR ProcessAttributePathList(AttributePathIBs::Parser & aAttributePathListParser);
@@ -212,6 +261,9 @@ private:
     // reports, which is always true for reads and true for subscriptions
     // prior to receiving a subscribe response.
     bool mIsPrimingReports              = false;
+    // Tracks whether we're sending the first report of a subscription resumed after a restart, which
+    // carries every attribute like the priming reports do.
+    bool mIsResumedReport               = false;
     InteractionType mInteractionType    = InteractionType::Read;
     uint64_t mSubscriptionId            = 0;
     uint16_t mMinIntervalFloorSeconds   = 0;
@@ -231,6 +283,9 @@ private:
     SubjectDescriptor mSubjectDescriptor;
     // The detailed encoding state for a single attribute, used by list chunking feature.
     AttributeValueEncoder::AttributeEncodeState mAttributeEncoderState;
+    // Notified when the session with the subscriber of a resumed subscription is established.
+    Callback::Callback<void (*)(void *, OperationalDeviceProxy *)> mOnConnectedCallback;
+    Callback::Callback<void (*)(void *, PeerId, CHIP_ERROR)> mOnConnectionFailureCallback;
 };
 } // namespace app
 } // namespace chip
@@ -0,0 +1,616 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/SubscriptionManager.h>
+
+#include <app/InteractionModelEngine.h>
+#include <crypto/RandUtils.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+constexpr uint64_t kWheelTickMs = CHIP_IM_SUBSCRIPTION_WHEEL_TICK_MS;
+
+uint64_t GetMonotonicMilliseconds()
+{
+    return System::SystemClock().GetMonotonicMilliseconds64().count();
+}
+
+uint32_t GetWheelTick()
+{
+    return static_cast<uint32_t>(GetMonotonicMilliseconds() / kWheelTickMs);
+}
+
+} // namespace
+
+SubscriptionManager::Subscription::Subscription(SubscriptionManager & aManager, const SubscribeParams & aParams,
+                                                ReadClient::Callback & aCallback) :
+    mManager(aManager), mParams(aParams), mCallback(aCallback), mOnConnectedCallback(OnSessionEstablished, this),
+    mOnConnectionFailureCallback(OnSessionFailure, this)
+{}
+
+SubscriptionManager::Subscription::~Subscription()
+{
+    mOnConnectedCallback.Cancel();
+    mOnConnectionFailureCallback.Cancel();
+    if (mpReadClient != nullptr)
+    {
+        Platform::Delete(mpReadClient);
+        mpReadClient = nullptr;
+    }
+}
+
+void SubscriptionManager::Subscription::OnReportBegin(const ReadClient * apReadClient)
+{
+    VerifyOrReturn(!mRemoved);
+    mCallback.OnReportBegin(apReadClient);
+}
+
+void SubscriptionManager::Subscription::OnReportEnd(const ReadClient * apReadClient)
+{
+    VerifyOrReturn(!mRemoved);
+    mCallback.OnReportEnd(apReadClient);
+}
+
+void SubscriptionManager::Subscription::OnEventData(const ReadClient * apReadClient, const EventHeader & aEventHeader,
+                                                    TLV::TLVReader * apData, const StatusIB * apStatus)
+{
+    VerifyOrReturn(!mRemoved);
+
+    // Resubscribing from the next event avoids receiving the same events again.
+    if (apData != nullptr)
+    {
+        mNextEventNumber = std::max(mNextEventNumber, aEventHeader.mEventNumber + 1);
+    }
+    mCallback.OnEventData(apReadClient, aEventHeader, apData, apStatus);
+}
+
+void SubscriptionManager::Subscription::OnAttributeData(const ReadClient * apReadClient, const ConcreteDataAttributePath & aPath,
+                                                        TLV::TLVReader * apData, const StatusIB & aStatus)
+{
+    VerifyOrReturn(!mRemoved);
+    mCallback.OnAttributeData(apReadClient, aPath, apData, aStatus);
+}
+
+void SubscriptionManager::Subscription::OnSubscriptionEstablished(const ReadClient * apReadClient)
+{
+    VerifyOrReturn(mState == State::kSubscribing);
+
+    mManager.ReleaseAttempt(*this);
+    mState               = State::kActive;
+    mConsecutiveFailures = 0;
+    mLastReportTime      = System::SystemClock().GetMonotonicTimestamp();
+    if (!mRemoved)
+    {
+        mCallback.OnSubscriptionEstablished(apReadClient);
+    }
+    mManager.StartQueuedSubscriptions();
+}
+
+void SubscriptionManager::Subscription::OnError(const ReadClient * apReadClient, CHIP_ERROR aError)
+{
+    VerifyOrReturn(!mRemoved);
+    mCallback.OnError(apReadClient, aError);
+}
+
+void SubscriptionManager::Subscription::OnDone(ReadClient * apReadClient)
+{
+    // Destroying the read client cancels its liveness deadline.
+    mpReadClient = nullptr;
+    Platform::Delete(apReadClient);
+    VerifyOrReturn(!mRemoved);
+
+    if (mState == State::kSubscribing)
+    {
+        mManager.ReleaseAttempt(*this);
+    }
+    mManager.OnAttemptFailed(*this, CHIP_ERROR_INCORRECT_STATE);
+    mManager.StartQueuedSubscriptions();
+}
+
+void SubscriptionManager::Subscription::RefreshLiveness(ReadClient & aReadClient, System::Clock::Timeout aTimeout)
+{
+    mLastReportTime = System::SystemClock().GetMonotonicTimestamp();
+    VerifyOrReturn(!mRemoved);
+    mManager.ScheduleDeadline(*this, aTimeout);
+}
+
+void SubscriptionManager::Subscription::CancelLiveness(ReadClient & aReadClient)
+{
+    VerifyOrReturn(!mRemoved);
+    mManager.CancelDeadline(*this);
+}
+
+void SubscriptionManager::Subscription::OnSessionEstablished(void * context, OperationalDeviceProxy * apDevice)
+{
+    Subscription * const _this = static_cast<Subscription *>(context);
+    VerifyOrReturn(_this->mState == State::kEstablishingSession);
+
+    Optional<SessionHandle> session = apDevice->GetSecureSession();
+    if (!session.HasValue())
+    {
+        OnSessionFailure(context, apDevice->GetPeerId(), CHIP_ERROR_INCORRECT_STATE);
+        return;
+    }
+    _this->OnSessionReady(session.Value());
+}
+
+void SubscriptionManager::Subscription::OnSessionReady(const SessionHandle & aSession)
+{
+    VerifyOrReturn(mState == State::kEstablishingSession);
+    if (mRemoved)
+    {
+        OnSessionFailure(this, PeerId(), CHIP_ERROR_INCORRECT_STATE);
+        return;
+    }
+
+    mManager.mNumSessionSetups--;
+    mState = State::kSubscribing;
+    mManager.Subscribe(*this, aSession);
+    mManager.StartQueuedSubscriptions();
+}
+
+void SubscriptionManager::Subscription::OnSessionFailure(void * context, PeerId aPeerId, CHIP_ERROR aError)
+{
+    Subscription * const _this = static_cast<Subscription *>(context);
+    VerifyOrReturn(_this->mState == State::kEstablishingSession);
+
+    _this->mManager.mNumSessionSetups--;
+    _this->mManager.ReleaseAttempt(*_this);
+    if (_this->mRemoved)
+    {
+        // Nothing left for the release of the subscription to undo.
+        _this->mState = State::kWaitingToRetry;
+        return;
+    }
+
+    _this->mManager.OnAttemptFailed(*_this, aError);
+    _this->mManager.StartQueuedSubscriptions();
+}
+
+CHIP_ERROR SubscriptionManager::Init(Messaging::ExchangeManager * apExchangeMgr, CASESessionManager * apCASESessionManager,
+                                     FabricTable * apFabricTable)
+{
+    VerifyOrReturnError(apExchangeMgr != nullptr && apCASESessionManager != nullptr && apFabricTable != nullptr,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(mpExchangeMgr == nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    mpExchangeMgr        = apExchangeMgr;
+    mpCASESessionManager = apCASESessionManager;
+    mpFabricTable        = apFabricTable;
+    mWheel.Reset(GetWheelTick());
+    return CHIP_NO_ERROR;
+}
+
+void SubscriptionManager::Shutdown()
+{
+    VerifyOrReturn(mpExchangeMgr != nullptr);
+
+    System::Layer * systemLayer = GetSystemLayer();
+    if (systemLayer != nullptr)
+    {
+        systemLayer->CancelTimer(OnWheelTimer, this);
+        systemLayer->CancelTimer(OnRemovalWork, this);
+    }
+
+    // Mark every subscription as removed first, so that their read clients do not touch the wheel while being destroyed.
+    mWheel.Reset(0);
+    mSubscriptions.ForEachActiveObject([](Subscription * subscription) {
+        subscription->mRemoved = true;
+        return Loop::Continue;
+    });
+    mSubscriptions.ReleaseAll();
+
+    mpQueueHead          = nullptr;
+    mpQueueTail          = nullptr;
+    mNumAttempts         = 0;
+    mNumSessionSetups    = 0;
+    mWheelTimerArmed     = false;
+    mRemovalScheduled    = false;
+    mpExchangeMgr        = nullptr;
+    mpCASESessionManager = nullptr;
+    mpFabricTable        = nullptr;
+}
+
+CHIP_ERROR SubscriptionManager::AddSubscription(const SubscribeParams & aParams, ReadClient::Callback & aCallback,
+                                                Subscription ** apSubscription)
+{
+    VerifyOrReturnError(mpExchangeMgr != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(aParams.mNodeId != kUndefinedNodeId && aParams.mFabricIndex != kUndefinedFabricIndex,
+                        CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(aParams.mMinIntervalFloorSeconds <= aParams.mMaxIntervalCeilingSeconds, CHIP_ERROR_INVALID_ARGUMENT);
+
+    Subscription * subscription = mSubscriptions.CreateObject(*this, aParams, aCallback);
+    VerifyOrReturnError(subscription != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    Enqueue(*subscription);
+    StartQueuedSubscriptions();
+
+    if (apSubscription != nullptr)
+    {
+        *apSubscription = subscription;
+    }
+    return CHIP_NO_ERROR;
+}
+
+void SubscriptionManager::RemoveSubscription(Subscription * apSubscription)
+{
+    VerifyOrReturn(apSubscription != nullptr && !apSubscription->mRemoved);
+
+    // The subscription may be in the middle of a callback of its read client, or of the wheel, so it is only released once
+    // they have returned.
+    apSubscription->mRemoved = true;
+    if (!mRemovalScheduled)
+    {
+        System::Layer * systemLayer = GetSystemLayer();
+        if (systemLayer != nullptr && systemLayer->ScheduleWork(OnRemovalWork, this) == CHIP_NO_ERROR)
+        {
+            mRemovalScheduled = true;
+        }
+        else
+        {
+            ChipLogError(DataManagement, "Failed to schedule the release of a subscription");
+        }
+    }
+}
+
+CHIP_ERROR SubscriptionManager::GetNodeHealth(FabricIndex aFabricIndex, NodeId aNodeId, NodeHealth & aHealth) const
+{
+    NodeHealth health;
+    mSubscriptions.ForEachActiveObject([&](const Subscription * subscription) {
+        if (subscription->mRemoved || subscription->GetFabricIndex() != aFabricIndex || subscription->GetNodeId() != aNodeId)
+        {
+            return Loop::Continue;
+        }
+
+        health.mSubscriptionCount++;
+        if (subscription->IsActive())
+        {
+            health.mActiveSubscriptionCount++;
+        }
+        health.mMaxConsecutiveFailures = std::max(health.mMaxConsecutiveFailures, subscription->mConsecutiveFailures);
+        health.mLastReportTime         = std::max(health.mLastReportTime, subscription->mLastReportTime);
+        return Loop::Continue;
+    });
+
+    VerifyOrReturnError(health.mSubscriptionCount > 0, CHIP_ERROR_NOT_FOUND);
+    aHealth = health;
+    return CHIP_NO_ERROR;
+}
+
+void SubscriptionManager::OnMaxIntervalElapsed(reporting::SubscriptionTimingWheel::Entry & aEntry)
+{
+    Subscription & subscription = static_cast<Subscription &>(aEntry);
+    VerifyOrReturn(!subscription.mRemoved);
+
+    if (subscription.mState == Subscription::State::kWaitingToRetry)
+    {
+        // Started once the wheel is done, since starting may schedule other entries.
+        Enqueue(subscription);
+    }
+    else if (subscription.mState == Subscription::State::kActive)
+    {
+        OnLivenessTimeout(subscription);
+    }
+}
+
+System::Clock::Milliseconds32 SubscriptionManager::ComputeRetryDelay(uint8_t aNumFailures, uint32_t aRandom)
+{
+    uint32_t delayMs = kMinRetryDelayMs;
+    for (uint8_t i = 1; i < aNumFailures && delayMs < kMaxRetryDelayMs; i++)
+    {
+        delayMs = (delayMs > UINT32_MAX / 2) ? UINT32_MAX : delayMs * 2;
+    }
+    if (delayMs > kMaxRetryDelayMs)
+    {
+        delayMs = kMaxRetryDelayMs;
+    }
+
+    // Waiting at least half of the backoff keeps it exponential, while the other half spreads the attempts of subscriptions
+    // that failed at the same time.
+    uint32_t jitterRangeMs = delayMs / 2;
+    return System::Clock::Milliseconds32(delayMs - jitterRangeMs + aRandom % (jitterRangeMs + 1));
+}
+
+void SubscriptionManager::Enqueue(Subscription & aSubscription)
+{
+    aSubscription.mState       = Subscription::State::kQueued;
+    aSubscription.mpNextQueued = nullptr;
+    if (mpQueueTail != nullptr)
+    {
+        mpQueueTail->mpNextQueued = &aSubscription;
+    }
+    else
+    {
+        mpQueueHead = &aSubscription;
+    }
+    mpQueueTail = &aSubscription;
+}
+
+void SubscriptionManager::StartQueuedSubscriptions()
+{
+    // Attempts that fail right away schedule their retry on the wheel, which must not happen while it is advancing, and may
+    // also call back in here.
+    VerifyOrReturn(!mIsAdvancingWheel && !mIsStartingSubscriptions);
+
+    mIsStartingSubscriptions = true;
+    while (mpQueueHead != nullptr && mNumAttempts < kMaxConcurrentResubscribes && mNumSessionSetups < kMaxConcurrentSessionSetups)
+    {
+        Subscription * subscription = mpQueueHead;
+        mpQueueHead                 = subscription->mpNextQueued;
+        if (mpQueueHead == nullptr)
+        {
+            mpQueueTail = nullptr;
+        }
+        subscription->mpNextQueued = nullptr;
+
+        if (!subscription->mRemoved)
+        {
+            StartSubscription(*subscription);
+        }
+    }
+    mIsStartingSubscriptions = false;
+}
+
+void SubscriptionManager::StartSubscription(Subscription & aSubscription)
+{
+    aSubscription.mState = Subscription::State::kEstablishingSession;
+    mNumAttempts++;
+    mNumSessionSetups++;
+
+    CHIP_ERROR err = EstablishSession(aSubscription);
+
+    // Not every failure is reported through the callbacks.
+    if (err != CHIP_NO_ERROR && aSubscription.mState == Subscription::State::kEstablishingSession)
+    {
+        aSubscription.mOnConnectedCallback.Cancel();
+        aSubscription.mOnConnectionFailureCallback.Cancel();
+        Subscription::OnSessionFailure(&aSubscription, PeerId().SetNodeId(aSubscription.GetNodeId()), err);
+    }
+}
+
+CHIP_ERROR SubscriptionManager::EstablishSession(Subscription & aSubscription)
+{
+    FabricInfo * fabric = mpFabricTable->FindFabricWithIndex(aSubscription.GetFabricIndex());
+    VerifyOrReturnError(fabric != nullptr, CHIP_ERROR_INVALID_FABRIC_ID);
+
+    return mpCASESessionManager->FindOrEstablishSession(fabric->GetPeerIdForNode(aSubscription.GetNodeId()),
+                                                        &aSubscription.mOnConnectedCallback,
+                                                        &aSubscription.mOnConnectionFailureCallback);
+}
+
+void SubscriptionManager::Subscribe(Subscription & aSubscription, const SessionHandle & aSession)
+{
+    ReadClient::Callback & callback = aSubscription;
+    ReadClient * readClient         = Platform::New<ReadClient>(InteractionModelEngine::GetInstance(), mpExchangeMgr, callback,
+                                                                ReadClient::InteractionType::Subscribe);
+    if (readClient == nullptr)
+    {
+        ReleaseAttempt(aSubscription);
+        OnAttemptFailed(aSubscription, CHIP_ERROR_NO_MEMORY);
+        return;
+    }
+    readClient->SetLivenessMonitor(&aSubscription);
+
+    ReadPrepareParams params(aSession);
+    params.mpAttributePathParamsList    = aSubscription.mParams.mpAttributePathParamsList;
+    params.mAttributePathParamsListSize = aSubscription.mParams.mAttributePathParamsListSize;
+    params.mpEventPathParamsList        = aSubscription.mParams.mpEventPathParamsList;
+    params.mEventPathParamsListSize     = aSubscription.mParams.mEventPathParamsListSize;
+    params.mEventNumber                 = aSubscription.mNextEventNumber;
+    params.mMinIntervalFloorSeconds     = aSubscription.mParams.mMinIntervalFloorSeconds;
+    params.mMaxIntervalCeilingSeconds   = aSubscription.mParams.mMaxIntervalCeilingSeconds;
+
+    CHIP_ERROR err = readClient->SendRequest(params);
+    if (err != CHIP_NO_ERROR)
+    {
+        Platform::Delete(readClient);
+        ReleaseAttempt(aSubscription);
+        OnAttemptFailed(aSubscription, err);
+        return;
+    }
+    aSubscription.mpReadClient = readClient;
+}
+
+void SubscriptionManager::OnAttemptFailed(Subscription & aSubscription, CHIP_ERROR aError)
+{
+    if (aSubscription.mConsecutiveFailures < UINT8_MAX)
+    {
+        aSubscription.mConsecutiveFailures++;
+    }
+
+    System::Clock::Milliseconds32 delay = ComputeRetryDelay(aSubscription.mConsecutiveFailures, Crypto::GetRandU32());
+    ChipLogProgress(DataManagement,
+                    "Subscription to node 0x" ChipLogFormatX64 " failed %u times (%" CHIP_ERROR_FORMAT "), retrying in %" PRIu32
+                    " ms",
+                    ChipLogValueX64(aSubscription.GetNodeId()), aSubscription.mConsecutiveFailures, aError.Format(), delay.count());
+
+    aSubscription.mState = Subscription::State::kWaitingToRetry;
+    ScheduleDeadline(aSubscription, delay);
+}
+
+void SubscriptionManager::OnLivenessTimeout(Subscription & aSubscription)
+{
+    ChipLogError(DataManagement, "Subscription liveness timeout with node 0x" ChipLogFormatX64,
+                 ChipLogValueX64(aSubscription.GetNodeId()));
+
+    aSubscription.mCallback.OnError(aSubscription.mpReadClient, CHIP_ERROR_TIMEOUT);
+
+    // The read client is not in any of its own callbacks here, so it can be destroyed right away.
+    Platform::Delete(aSubscription.mpReadClient);
+    aSubscription.mpReadClient = nullptr;
+    if (!aSubscription.mRemoved)
+    {
+        OnAttemptFailed(aSubscription, CHIP_ERROR_TIMEOUT);
+    }
+}
+
+void SubscriptionManager::ReleaseAttempt(Subscription & aSubscription)
+{
+    VerifyOrDie(mNumAttempts > 0);
+    mNumAttempts--;
+}
+
+void SubscriptionManager::ScheduleDeadline(Subscription & aSubscription, System::Clock::Timeout aTimeout)
+{
+    uint64_t deadlineMs = GetMonotonicMilliseconds() + aTimeout.count();
+    uint32_t tick       = static_cast<uint32_t>((deadlineMs + kWheelTickMs - 1) / kWheelTickMs);
+
+    // A single deadline, which is never brought forward to coalesce with others.
+    mWheel.Schedule(aSubscription, tick, tick, aSubscription.GetFabricIndex(), aSubscription.GetNodeId());
+    if (!mIsAdvancingWheel)
+    {
+        CHIP_ERROR err = RefreshWheelTimer();
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(DataManagement, "Failed to arm the subscription manager timer: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    }
+}
+
+void SubscriptionManager::CancelDeadline(Subscription & aSubscription)
+{
+    mWheel.Cancel(aSubscription);
+    if (!mIsAdvancingWheel)
+    {
+        CHIP_ERROR err = RefreshWheelTimer();
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(DataManagement, "Failed to arm the subscription manager timer: %" CHIP_ERROR_FORMAT, err.Format());
+        }
+    }
+}
+
+void SubscriptionManager::OnWheelTimer(System::Layer * aSystemLayer, void * apAppState)
+{
+    SubscriptionManager * const manager = reinterpret_cast<SubscriptionManager *>(apAppState);
+    manager->mWheelTimerArmed           = false;
+    manager->mIsAdvancingWheel          = true;
+    manager->mWheel.Advance(GetWheelTick(), *manager);
+    manager->mIsAdvancingWheel = false;
+
+    manager->StartQueuedSubscriptions();
+    CHIP_ERROR err = manager->RefreshWheelTimer();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to arm the subscription manager timer: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
+CHIP_ERROR SubscriptionManager::RefreshWheelTimer()
+{
+    System::Layer * systemLayer = GetSystemLayer();
+    VerifyOrReturnError(systemLayer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    uint32_t nextTick;
+    if (!mWheel.GetNextDeadline(nextTick))
+    {
+        if (mWheelTimerArmed)
+        {
+            systemLayer->CancelTimer(OnWheelTimer, this);
+            mWheelTimerArmed = false;
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    if (mWheelTimerArmed && mWheelTimerTick == nextTick)
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    uint64_t nowMs      = GetMonotonicMilliseconds();
+    uint64_t deadlineMs = nextTick * kWheelTickMs;
+    uint64_t delayMs    = (deadlineMs > nowMs) ? std::min<uint64_t>(deadlineMs - nowMs, UINT32_MAX) : 0;
+    ReturnErrorOnFailure(
+        systemLayer->StartTimer(System::Clock::Milliseconds32(static_cast<uint32_t>(delayMs)), OnWheelTimer, this));
+    mWheelTimerTick  = nextTick;
+    mWheelTimerArmed = true;
+    return CHIP_NO_ERROR;
+}
+
+void SubscriptionManager::OnRemovalWork(System::Layer * aSystemLayer, void * apAppState)
+{
+    SubscriptionManager * const manager = reinterpret_cast<SubscriptionManager *>(apAppState);
+    manager->mRemovalScheduled          = false;
+    manager->ReleaseRemovedSubscriptions();
+    manager->StartQueuedSubscriptions();
+
+    CHIP_ERROR err = manager->RefreshWheelTimer();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "Failed to arm the subscription manager timer: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
+void SubscriptionManager::ReleaseRemovedSubscriptions()
+{
+    // Drop the removed subscriptions from the queue first, since releasing them would leave dangling links.
+    Subscription ** link = &mpQueueHead;
+    mpQueueTail          = nullptr;
+    while (*link != nullptr)
+    {
+        if ((*link)->mRemoved)
+        {
+            *link = (*link)->mpNextQueued;
+        }
+        else
+        {
+            mpQueueTail = *link;
+            link        = &(*link)->mpNextQueued;
+        }
+    }
+
+    mSubscriptions.ForEachActiveObject([this](Subscription * subscription) {
+        if (!subscription->mRemoved)
+        {
+            return Loop::Continue;
+        }
+
+        switch (subscription->mState)
+        {
+        case Subscription::State::kEstablishingSession:
+            mNumSessionSetups--;
+            ReleaseAttempt(*subscription);
+            break;
+        case Subscription::State::kSubscribing:
+            ReleaseAttempt(*subscription);
+            break;
+        default:
+            break;
+        }
+        mWheel.Cancel(*subscription);
+        mSubscriptions.ReleaseObject(subscription);
+        return Loop::Continue;
+    });
+}
+
+System::Layer * SubscriptionManager::GetSystemLayer() const
+{
+    VerifyOrReturnError(mpExchangeMgr != nullptr && mpExchangeMgr->GetSessionManager() != nullptr, nullptr);
+    return mpExchangeMgr->GetSessionManager()->SystemLayer();
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,240 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the subscription manager, which keeps the subscriptions
+ *      of a controller to many nodes alive.
+ *
+ */
+
+#pragma once
+
+#include <app/AttributePathParams.h>
+#include <app/CASESessionManager.h>
+#include <app/EventPathParams.h>
+#include <app/OperationalDeviceProxy.h>
+#include <app/ReadClient.h>
+#include <app/reporting/SubscriptionTimingWheel.h>
+#include <credentials/FabricTable.h>
+#include <lib/core/CHIPCallback.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/support/Pool.h>
+#include <messaging/ExchangeMgr.h>
+#include <system/SystemClock.h>
+#include <system/SystemLayer.h>
+
+namespace chip {
+namespace app {
+
+/*
+ *  @class SubscriptionManager
+ *
+ *  @brief Owns the read clients of the subscriptions of a controller and keeps them established: the liveness of all of
+ * them is checked with a single timer, and a subscription that fails or times out is established again after a jittered
+ * exponential backoff. The number of subscriptions and CASE sessions being established at the same time is capped, so
+ * that a controller coming back online does not flood the network with thousands of requests.
+ *
+ *         The application callback of a subscription receives the data and errors of every attempt, but never OnDone: a
+ * subscription lasts until it is removed with RemoveSubscription.
+ */
+class SubscriptionManager : private reporting::SubscriptionTimingWheel::Delegate
+{
+public:
+    struct SubscribeParams
+    {
+        FabricIndex mFabricIndex = kUndefinedFabricIndex;
+        NodeId mNodeId           = kUndefinedNodeId;
+
+        // The paths are not copied: they must outlive the subscription.
+        AttributePathParams * mpAttributePathParamsList = nullptr;
+        size_t mAttributePathParamsListSize             = 0;
+        EventPathParams * mpEventPathParamsList         = nullptr;
+        size_t mEventPathParamsListSize                 = 0;
+        uint16_t mMinIntervalFloorSeconds               = 0;
+        uint16_t mMaxIntervalCeilingSeconds             = 0;
+    };
+
+    struct NodeHealth
+    {
+        uint16_t mSubscriptionCount       = 0;
+        uint16_t mActiveSubscriptionCount = 0;
+
+        // The highest number of consecutive failures of the subscriptions to the node since their last success.
+        uint8_t mMaxConsecutiveFailures = 0;
+
+        // The monotonic time of the last report received from the node, or 0 if none was received.
+        System::Clock::Timestamp mLastReportTime = System::Clock::kZero;
+    };
+
+    class Subscription;
+
+    SubscriptionManager() = default;
+    ~SubscriptionManager() override { Shutdown(); }
+
+    CHIP_ERROR Init(Messaging::ExchangeManager * apExchangeMgr, CASESessionManager * apCASESessionManager,
+                    FabricTable * apFabricTable);
+
+    /**
+     * Drop all the subscriptions, without notifying their callbacks.
+     */
+    void Shutdown();
+
+    /**
+     * Add a subscription, which is established as soon as the caps on concurrent attempts allow it.
+     *
+     * @param[in]  aParams          The node to subscribe to and the paths and intervals of the subscription.
+     * @param[in]  aCallback        Receives the reports and errors of the subscription. Must outlive the subscription.
+     * @param[out] apSubscription   The new subscription, to be passed to RemoveSubscription.
+     */
+    CHIP_ERROR AddSubscription(const SubscribeParams & aParams, ReadClient::Callback & aCallback,
+                               Subscription ** apSubscription = nullptr);
+
+    /**
+     * Remove a subscription. Its callback is not called anymore once this returns. May be called from the callbacks of
+     * any subscription.
+     */
+    void RemoveSubscription(Subscription * apSubscription);
+
+    /**
+     * Get the health of the subscriptions to the given node.
+     *
+     * @retval CHIP_ERROR_NOT_FOUND if there is no subscription to the node.
+     */
+    CHIP_ERROR GetNodeHealth(FabricIndex aFabricIndex, NodeId aNodeId, NodeHealth & aHealth) const;
+
+    class Subscription : private reporting::SubscriptionTimingWheel::Entry,
+                         private ReadClient::Callback,
+                         private ReadClient::LivenessMonitor
+    {
+    public:
+        Subscription(SubscriptionManager & aManager, const SubscribeParams & aParams, ReadClient::Callback & aCallback);
+        ~Subscription() override;
+
+        FabricIndex GetFabricIndex() const { return mParams.mFabricIndex; }
+        NodeId GetNodeId() const { return mParams.mNodeId; }
+        bool IsActive() const { return mState == State::kActive; }
+
+    private:
+        friend class SubscriptionManager;
+        friend class TestSubscriptionManager;
+
+        enum class State : uint8_t
+        {
+            kWaitingToRetry,      ///< Waiting for the end of the backoff before trying again
+            kQueued,              ///< Waiting for an attempt to be allowed by the caps
+            kEstablishingSession, ///< Waiting for a CASE session with the node
+            kSubscribing,         ///< Waiting for the subscribe response
+            kActive,              ///< Established, waiting for the next report before the liveness timeout
+        };
+
+        // ReadClient::Callback
+        void OnReportBegin(const ReadClient * apReadClient) override;
+        void OnReportEnd(const ReadClient * apReadClient) override;
+        void OnEventData(const ReadClient * apReadClient, const EventHeader & aEventHeader, TLV::TLVReader * apData,
+                         const StatusIB * apStatus) override;
+        void OnAttributeData(const ReadClient * apReadClient, const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData,
+                             const StatusIB & aStatus) override;
+        void OnSubscriptionEstablished(const ReadClient * apReadClient) override;
+        void OnError(const ReadClient * apReadClient, CHIP_ERROR aError) override;
+        void OnDone(ReadClient * apReadClient) override;
+
+        // ReadClient::LivenessMonitor
+        void RefreshLiveness(ReadClient & aReadClient, System::Clock::Timeout aTimeout) override;
+        void CancelLiveness(ReadClient & aReadClient) override;
+
+        static void OnSessionEstablished(void * context, OperationalDeviceProxy * apDevice);
+        static void OnSessionFailure(void * context, PeerId aPeerId, CHIP_ERROR aError);
+        void OnSessionReady(const SessionHandle & aSession);
+
+        SubscriptionManager & mManager;
+        SubscribeParams mParams;
+        ReadClient::Callback & mCallback;
+        ReadClient * mpReadClient = nullptr;
+        chip::Callback::Callback<OnDeviceConnected> mOnConnectedCallback;
+        chip::Callback::Callback<OnDeviceConnectionFailure> mOnConnectionFailureCallback;
+        Subscription * mpNextQueued              = nullptr;
+        System::Clock::Timestamp mLastReportTime = System::Clock::kZero;
+        EventNumber mNextEventNumber             = 0;
+        uint8_t mConsecutiveFailures             = 0;
+        State mState                             = State::kQueued;
+        bool mRemoved                            = false;
+    };
+
+protected:
+    /**
+     * Start establishing a CASE session with the node of a subscription. The outcome is reported through the connection
+     * callbacks of the subscription, which may be called before this returns. Tests override this to provide sessions of
+     * their own.
+     */
+    virtual CHIP_ERROR EstablishSession(Subscription & aSubscription);
+
+private:
+    friend class TestSubscriptionManager;
+
+    static constexpr uint32_t kMaxConcurrentResubscribes  = CHIP_IM_SUBSCRIPTION_MANAGER_MAX_CONCURRENT_RESUBSCRIBES;
+    static constexpr uint32_t kMaxConcurrentSessionSetups = CHIP_IM_SUBSCRIPTION_MANAGER_MAX_CONCURRENT_SESSION_SETUPS;
+    static constexpr uint32_t kMinRetryDelayMs            = CHIP_IM_SUBSCRIPTION_MANAGER_MIN_RETRY_DELAY_MS;
+    static constexpr uint32_t kMaxRetryDelayMs            = CHIP_IM_SUBSCRIPTION_MANAGER_MAX_RETRY_DELAY_MS;
+
+    // SubscriptionTimingWheel::Delegate
+    void OnMinIntervalElapsed(reporting::SubscriptionTimingWheel::Entry & aEntry) override {}
+    void OnMaxIntervalElapsed(reporting::SubscriptionTimingWheel::Entry & aEntry) override;
+
+    /**
+     * Compute the delay before the next attempt of a subscription that failed aNumFailures times in a row, given a random
+     * number used to pick the delay in the upper half of the backoff window.
+     */
+    static System::Clock::Milliseconds32 ComputeRetryDelay(uint8_t aNumFailures, uint32_t aRandom);
+
+    void Enqueue(Subscription & aSubscription);
+    void StartQueuedSubscriptions();
+    void StartSubscription(Subscription & aSubscription);
+    void Subscribe(Subscription & aSubscription, const SessionHandle & aSession);
+    void OnAttemptFailed(Subscription & aSubscription, CHIP_ERROR aError);
+    void OnLivenessTimeout(Subscription & aSubscription);
+    void ReleaseAttempt(Subscription & aSubscription);
+    void ScheduleDeadline(Subscription & aSubscription, System::Clock::Timeout aTimeout);
+    void CancelDeadline(Subscription & aSubscription);
+
+    static void OnWheelTimer(System::Layer * aSystemLayer, void * apAppState);
+    CHIP_ERROR RefreshWheelTimer();
+
+    static void OnRemovalWork(System::Layer * aSystemLayer, void * apAppState);
+    void ReleaseRemovedSubscriptions();
+
+    System::Layer * GetSystemLayer() const;
+
+    Messaging::ExchangeManager * mpExchangeMgr = nullptr;
+    CASESessionManager * mpCASESessionManager  = nullptr;
+    FabricTable * mpFabricTable                = nullptr;
+    ObjectPool<Subscription, CHIP_IM_SUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS> mSubscriptions;
+    reporting::SubscriptionTimingWheel mWheel;
+    Subscription * mpQueueHead    = nullptr;
+    Subscription * mpQueueTail    = nullptr;
+    uint32_t mNumAttempts         = 0;
+    uint32_t mNumSessionSetups    = 0;
+    uint32_t mWheelTimerTick      = 0;
+    bool mWheelTimerArmed         = false;
+    bool mIsAdvancingWheel        = false;
+    bool mIsStartingSubscriptions = false;
+    bool mRemovalScheduled        = false;
+};
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,253 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/SubscriptionResumptionStorage.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+constexpr TLV::Tag TagNodeId()
+{
+    return TLV::ContextTag(1);
+}
+constexpr TLV::Tag TagFabricIndex()
+{
+    return TLV::ContextTag(2);
+}
+constexpr TLV::Tag TagSubscriptionId()
+{
+    return TLV::ContextTag(3);
+}
+constexpr TLV::Tag TagMinInterval()
+{
+    return TLV::ContextTag(4);
+}
+constexpr TLV::Tag TagMaxInterval()
+{
+    return TLV::ContextTag(5);
+}
+constexpr TLV::Tag TagFabricFiltered()
+{
+    return TLV::ContextTag(6);
+}
+constexpr TLV::Tag TagAttributePaths()
+{
+    return TLV::ContextTag(7);
+}
+constexpr TLV::Tag TagEventPaths()
+{
+    return TLV::ContextTag(8);
+}
+
+// Tags of the fields of a path, which are omitted when they hold a wildcard.
+constexpr TLV::Tag TagEndpointId()
+{
+    return TLV::ContextTag(1);
+}
+constexpr TLV::Tag TagClusterId()
+{
+    return TLV::ContextTag(2);
+}
+constexpr TLV::Tag TagFieldId()
+{
+    return TLV::ContextTag(3);
+}
+constexpr TLV::Tag TagListIndex()
+{
+    return TLV::ContextTag(4);
+}
+
+} // namespace
+
+CHIP_ERROR SubscriptionResumptionStorage::Init(PersistentStorageDelegate * apStorage)
+{
+    VerifyOrReturnError(apStorage != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    mpStorage = apStorage;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR SubscriptionResumptionStorage::Save(uint16_t aIndex, const SubscriptionInfo & aInfo)
+{
+    VerifyOrReturnError(mpStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(aIndex < kMaxSubscriptions, CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint8_t buffer[kMaxSerializedSize];
+    TLV::TLVWriter writer;
+    writer.Init(buffer);
+    ReturnErrorOnFailure(Serialize(writer, aInfo));
+    ReturnErrorOnFailure(writer.Finalize());
+
+    DefaultStorageKeyAllocator key;
+    return mpStorage->SyncSetKeyValue(key.SubscriptionResumption(aIndex), buffer, static_cast<uint16_t>(writer.GetLengthWritten()));
+}
+
+CHIP_ERROR SubscriptionResumptionStorage::Load(uint16_t aIndex, SubscriptionInfo & aInfo)
+{
+    VerifyOrReturnError(mpStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(aIndex < kMaxSubscriptions, CHIP_ERROR_INVALID_ARGUMENT);
+
+    uint8_t buffer[kMaxSerializedSize];
+    uint16_t size = static_cast<uint16_t>(sizeof(buffer));
+    DefaultStorageKeyAllocator key;
+    CHIP_ERROR err = mpStorage->SyncGetKeyValue(key.SubscriptionResumption(aIndex), buffer, size);
+    VerifyOrReturnError(err != CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND, CHIP_ERROR_NOT_FOUND);
+    ReturnErrorOnFailure(err);
+
+    TLV::TLVReader reader;
+    reader.Init(buffer, size);
+    aInfo = SubscriptionInfo();
+    return Deserialize(reader, aInfo);
+}
+
+CHIP_ERROR SubscriptionResumptionStorage::Delete(uint16_t aIndex)
+{
+    VerifyOrReturnError(mpStorage != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(aIndex < kMaxSubscriptions, CHIP_ERROR_INVALID_ARGUMENT);
+
+    DefaultStorageKeyAllocator key;
+    return mpStorage->SyncDeleteKeyValue(key.SubscriptionResumption(aIndex));
+}
+
+CHIP_ERROR SubscriptionResumptionStorage::Serialize(TLV::TLVWriter & aWriter, const SubscriptionInfo & aInfo)
+{
+    TLV::TLVType container;
+    ReturnErrorOnFailure(aWriter.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_Structure, container));
+
+    ReturnErrorOnFailure(aWriter.Put(TagNodeId(), aInfo.mNodeId));
+    ReturnErrorOnFailure(aWriter.Put(TagFabricIndex(), aInfo.mFabricIndex));
+    ReturnErrorOnFailure(aWriter.Put(TagSubscriptionId(), aInfo.mSubscriptionId));
+    ReturnErrorOnFailure(aWriter.Put(TagMinInterval(), aInfo.mMinIntervalFloorSeconds));
+    ReturnErrorOnFailure(aWriter.Put(TagMaxInterval(), aInfo.mMaxIntervalCeilingSeconds));
+    ReturnErrorOnFailure(aWriter.PutBoolean(TagFabricFiltered(), aInfo.mIsFabricFiltered));
+    ReturnErrorOnFailure(SerializePaths(aWriter, TagAttributePaths(), aInfo.mAttributePaths, aInfo.mAttributePathCount, false));
+    ReturnErrorOnFailure(SerializePaths(aWriter, TagEventPaths(), aInfo.mEventPaths, aInfo.mEventPathCount, true));
+
+    return aWriter.EndContainer(container);
+}
+
+CHIP_ERROR SubscriptionResumptionStorage::Deserialize(TLV::TLVReader & aReader, SubscriptionInfo & aInfo)
+{
+    ReturnErrorOnFailure(aReader.Next(TLV::kTLVType_Structure, TLV::AnonymousTag()));
+
+    TLV::TLVType container;
+    ReturnErrorOnFailure(aReader.EnterContainer(container));
+
+    ReturnErrorOnFailure(aReader.Next(TagNodeId()));
+    ReturnErrorOnFailure(aReader.Get(aInfo.mNodeId));
+    ReturnErrorOnFailure(aReader.Next(TagFabricIndex()));
+    ReturnErrorOnFailure(aReader.Get(aInfo.mFabricIndex));
+    ReturnErrorOnFailure(aReader.Next(TagSubscriptionId()));
+    ReturnErrorOnFailure(aReader.Get(aInfo.mSubscriptionId));
+    ReturnErrorOnFailure(aReader.Next(TagMinInterval()));
+    ReturnErrorOnFailure(aReader.Get(aInfo.mMinIntervalFloorSeconds));
+    ReturnErrorOnFailure(aReader.Next(TagMaxInterval()));
+    ReturnErrorOnFailure(aReader.Get(aInfo.mMaxIntervalCeilingSeconds));
+    ReturnErrorOnFailure(aReader.Next(TagFabricFiltered()));
+    ReturnErrorOnFailure(aReader.Get(aInfo.mIsFabricFiltered));
+
+    ReturnErrorOnFailure(aReader.Next(TLV::kTLVType_Array, TagAttributePaths()));
+    ReturnErrorOnFailure(DeserializePaths(aReader, aInfo.mAttributePaths, aInfo.mAttributePathCount, false));
+    ReturnErrorOnFailure(aReader.Next(TLV::kTLVType_Array, TagEventPaths()));
+    ReturnErrorOnFailure(DeserializePaths(aReader, aInfo.mEventPaths, aInfo.mEventPathCount, true));
+
+    return aReader.ExitContainer(container);
+}
+
+CHIP_ERROR SubscriptionResumptionStorage::SerializePaths(TLV::TLVWriter & aWriter, TLV::Tag aTag, const ClusterInfo * apPaths,
+                                                         size_t aCount, bool aIsEventPath)
+{
+    TLV::TLVType arrayContainer;
+    ReturnErrorOnFailure(aWriter.StartContainer(aTag, TLV::kTLVType_Array, arrayContainer));
+
+    for (size_t i = 0; i < aCount; i++)
+    {
+        const ClusterInfo & path = apPaths[i];
+        TLV::TLVType pathContainer;
+        ReturnErrorOnFailure(aWriter.StartContainer(TLV::AnonymousTag(), TLV::kTLVType_List, pathContainer));
+        if (!path.HasWildcardEndpointId())
+        {
+            ReturnErrorOnFailure(aWriter.Put(TagEndpointId(), path.mEndpointId));
+        }
+        if (!path.HasWildcardClusterId())
+        {
+            ReturnErrorOnFailure(aWriter.Put(TagClusterId(), path.mClusterId));
+        }
+        if (aIsEventPath ? !path.HasWildcardEventId() : !path.HasWildcardAttributeId())
+        {
+            ReturnErrorOnFailure(aWriter.Put(TagFieldId(), aIsEventPath ? path.mEventId : path.mAttributeId));
+        }
+        if (!aIsEventPath && !path.HasWildcardListIndex())
+        {
+            ReturnErrorOnFailure(aWriter.Put(TagListIndex(), path.mListIndex));
+        }
+        ReturnErrorOnFailure(aWriter.EndContainer(pathContainer));
+    }
+
+    return aWriter.EndContainer(arrayContainer);
+}
+
+CHIP_ERROR SubscriptionResumptionStorage::DeserializePaths(TLV::TLVReader & aReader, ClusterInfo * apPaths, size_t & aCount,
+                                                           bool aIsEventPath)
+{
+    TLV::TLVType arrayContainer;
+    ReturnErrorOnFailure(aReader.EnterContainer(arrayContainer));
+
+    CHIP_ERROR err;
+    aCount = 0;
+    while ((err = aReader.Next(TLV::kTLVType_List, TLV::AnonymousTag())) == CHIP_NO_ERROR)
+    {
+        VerifyOrReturnError(aCount < kMaxPaths, CHIP_ERROR_NO_MEMORY);
+        ClusterInfo & path = apPaths[aCount++];
+
+        TLV::TLVType pathContainer;
+        ReturnErrorOnFailure(aReader.EnterContainer(pathContainer));
+        while ((err = aReader.Next()) == CHIP_NO_ERROR)
+        {
+            TLV::Tag tag = aReader.GetTag();
+            if (tag == TagEndpointId())
+            {
+                ReturnErrorOnFailure(aReader.Get(path.mEndpointId));
+            }
+            else if (tag == TagClusterId())
+            {
+                ReturnErrorOnFailure(aReader.Get(path.mClusterId));
+            }
+            else if (tag == TagFieldId())
+            {
+                ReturnErrorOnFailure(aReader.Get(aIsEventPath ? path.mEventId : path.mAttributeId));
+            }
+            else if (tag == TagListIndex())
+            {
+                ReturnErrorOnFailure(aReader.Get(path.mListIndex));
+            }
+        }
+        VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+        ReturnErrorOnFailure(aReader.ExitContainer(pathContainer));
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+
+    return aReader.ExitContainer(arrayContainer);
+}
+
+} // namespace app
+} // namespace chip
@@ -0,0 +1,93 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the persistent storage of the subscriptions served by
+ *      the interaction model engine, used to resume them after a restart.
+ *
+ */
+
+#pragma once
+
+#include <app/ClusterInfo.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPPersistentStorageDelegate.h>
+#include <lib/core/CHIPTLV.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/NodeId.h>
+
+namespace chip {
+namespace app {
+
+/*
+ *  @class SubscriptionResumptionStorage
+ *
+ *  @brief Saves the parameters of established subscriptions, one record per read handler slot, so that the server can
+ * re-establish them with their subscribers after a restart instead of waiting for every subscriber to subscribe again.
+ */
+class SubscriptionResumptionStorage
+{
+public:
+    static constexpr uint16_t kMaxSubscriptions = CHIP_IM_MAX_NUM_READ_HANDLER;
+    static constexpr size_t kMaxPaths           = CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS;
+
+    struct SubscriptionInfo
+    {
+        NodeId mNodeId                      = kUndefinedNodeId;
+        FabricIndex mFabricIndex            = kUndefinedFabricIndex;
+        uint64_t mSubscriptionId            = 0;
+        uint16_t mMinIntervalFloorSeconds   = 0;
+        uint16_t mMaxIntervalCeilingSeconds = 0;
+        bool mIsFabricFiltered              = false;
+        ClusterInfo mAttributePaths[kMaxPaths];
+        size_t mAttributePathCount = 0;
+        ClusterInfo mEventPaths[kMaxPaths];
+        size_t mEventPathCount = 0;
+    };
+
+    CHIP_ERROR Init(PersistentStorageDelegate * apStorage);
+
+    /**
+     * Save the subscription served by the read handler at the given index, replacing the one previously saved there.
+     */
+    CHIP_ERROR Save(uint16_t aIndex, const SubscriptionInfo & aInfo);
+
+    /**
+     * Load the subscription saved at the given index.
+     *
+     * @retval CHIP_ERROR_NOT_FOUND if no subscription is saved at this index.
+     */
+    CHIP_ERROR Load(uint16_t aIndex, SubscriptionInfo & aInfo);
+
+    CHIP_ERROR Delete(uint16_t aIndex);
+
+private:
+    static constexpr size_t kMaxSerializedSize = 64 + 2 * kMaxPaths * 24;
+
+    static CHIP_ERROR Serialize(TLV::TLVWriter & aWriter, const SubscriptionInfo & aInfo);
+    static CHIP_ERROR Deserialize(TLV::TLVReader & aReader, SubscriptionInfo & aInfo);
+    static CHIP_ERROR SerializePaths(TLV::TLVWriter & aWriter, TLV::Tag aTag, const ClusterInfo * apPaths, size_t aCount,
+                                     bool aIsEventPath);
+    static CHIP_ERROR DeserializePaths(TLV::TLVReader & aReader, ClusterInfo * apPaths, size_t & aCount, bool aIsEventPath);
+
+    PersistentStorageDelegate * mpStorage = nullptr;
+};
+
+} // namespace app
+} // namespace chip
@@ -569,7 +569,7 @@ void ColorControlServer::startColorLoop(EndpointId endpoint, uint8_t startFromSt
 
     Attributes::RemainingTime::Set(endpoint, MAX_INT16U_VALUE);
 
-    emberEventControlSetDelayMS(configureHSVEventControl(endpoint), UPDATE_TIME_MS);
+    emberEventControlSetDelayOnTransitionTick(configureHSVEventControl(endpoint), UPDATE_TIME_MS);
 }
 
 /**
@@ -842,7 +842,7 @@ bool ColorControlServer::moveHueCommand(EndpointId endpoint, uint8_t moveMode, u
     colorSaturationTransitionState->stepsRemaining = 0;
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(configureHSVEventControl(endpoint), UPDATE_TIME_MS);
+    emberEventControlSetDelayOnTransitionTick(configureHSVEventControl(endpoint), UPDATE_TIME_MS);
 
 exit:
     emberAfSendImmediateDefaultResponse(status);
@@ -980,7 +980,7 @@ bool ColorControlServer::moveToHueCommand(EndpointId endpoint, uint16_t hue, uin
     Attributes::RemainingTime::Set(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(configureHSVEventControl(endpoint), UPDATE_TIME_MS);
+    emberEventControlSetDelayOnTransitionTick(configureHSVEventControl(endpoint), UPDATE_TIME_MS);
 
 exit:
     emberAfSendImmediateDefaultResponse(status);
@@ -1098,7 +1098,7 @@ bool ColorControlServer::moveToHueAndSaturationCommand(EndpointId endpoint, uint
     Attributes::RemainingTime::Set(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(configureHSVEventControl(endpoint), UPDATE_TIME_MS);
+    emberEventControlSetDelayOnTransitionTick(configureHSVEventControl(endpoint), UPDATE_TIME_MS);
 
 exit:
     emberAfSendImmediateDefaultResponse(status);
@@ -1199,7 +1199,7 @@ bool ColorControlServer::stepHueCommand(EndpointId endpoint, uint8_t stepMode, u
     Attributes::RemainingTime::Set(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(configureHSVEventControl(endpoint), UPDATE_TIME_MS);
+    emberEventControlSetDelayOnTransitionTick(configureHSVEventControl(endpoint), UPDATE_TIME_MS);
 
 exit:
     emberAfSendImmediateDefaultResponse(status);
@@ -1269,7 +1269,7 @@ bool ColorControlServer::moveSaturationCommand(const app::ConcreteCommandPath &
     Attributes::RemainingTime::Set(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(configureHSVEventControl(endpoint), UPDATE_TIME_MS);
+    emberEventControlSetDelayOnTransitionTick(configureHSVEventControl(endpoint), UPDATE_TIME_MS);
 
 exit:
     emberAfSendImmediateDefaultResponse(status);
@@ -1344,7 +1344,7 @@ bool ColorControlServer::moveToSaturationCommand(const app::ConcreteCommandPath
     Attributes::RemainingTime::Set(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(configureHSVEventControl(endpoint), UPDATE_TIME_MS);
+    emberEventControlSetDelayOnTransitionTick(configureHSVEventControl(endpoint), UPDATE_TIME_MS);
 
 exit:
     emberAfSendImmediateDefaultResponse(status);
@@ -1419,7 +1419,7 @@ bool ColorControlServer::stepSaturationCommand(const app::ConcreteCommandPath &
     Attributes::RemainingTime::Set(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(configureHSVEventControl(endpoint), UPDATE_TIME_MS);
+    emberEventControlSetDelayOnTransitionTick(configureHSVEventControl(endpoint), UPDATE_TIME_MS);
 
 exit:
     emberAfSendImmediateDefaultResponse(status);
@@ -1564,7 +1564,7 @@ void ColorControlServer::updateHueSatCommand(EndpointId endpoint)
     }
     else
     {
-        emberEventControlSetDelayMS(configureHSVEventControl(endpoint), UPDATE_TIME_MS);
+        emberEventControlSetDelayOnTransitionTick(configureHSVEventControl(endpoint), UPDATE_TIME_MS);
     }
 
     if (colorHueTransitionState->isEnhancedHue)
@@ -1729,7 +1729,7 @@ bool ColorControlServer::moveToColorCommand(const app::ConcreteCommandPath & com
     Attributes::RemainingTime::Set(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(configureXYEventControl(endpoint), UPDATE_TIME_MS);
+    emberEventControlSetDelayOnTransitionTick(configureXYEventControl(endpoint), UPDATE_TIME_MS);
 
 exit:
     emberAfSendImmediateDefaultResponse(status);
@@ -1822,7 +1822,7 @@ bool ColorControlServer::moveColorCommand(const app::ConcreteCommandPath & comma
     }
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(configureXYEventControl(endpoint), UPDATE_TIME_MS);
+    emberEventControlSetDelayOnTransitionTick(configureXYEventControl(endpoint), UPDATE_TIME_MS);
 
 exit:
     emberAfSendImmediateDefaultResponse(status);
@@ -1896,7 +1896,7 @@ bool ColorControlServer::stepColorCommand(const app::ConcreteCommandPath & comma
     Attributes::RemainingTime::Set(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(configureXYEventControl(endpoint), UPDATE_TIME_MS);
+    emberEventControlSetDelayOnTransitionTick(configureXYEventControl(endpoint), UPDATE_TIME_MS);
 
 exit:
     emberAfSendImmediateDefaultResponse(status);
@@ -1925,7 +1925,7 @@ void ColorControlServer::updateXYCommand(EndpointId endpoint)
     }
     else
     {
-        emberEventControlSetDelayMS(configureXYEventControl(endpoint), UPDATE_TIME_MS);
+        emberEventControlSetDelayOnTransitionTick(configureXYEventControl(endpoint), UPDATE_TIME_MS);
     }
 
     // update the attributes
@@ -2013,7 +2013,7 @@ EmberAfStatus ColorControlServer::moveToColorTemp(EndpointId aEndpoint, uint16_t
     colorTempTransitionState->highLimit      = temperatureMax;
 
     // kick off the state machine
-    emberEventControlSetDelayMS(configureTempEventControl(endpoint), UPDATE_TIME_MS);
+    emberEventControlSetDelayOnTransitionTick(configureTempEventControl(endpoint), UPDATE_TIME_MS);
     return EMBER_ZCL_STATUS_SUCCESS;
 }
 
@@ -2125,7 +2125,7 @@ void ColorControlServer::updateTempCommand(EndpointId endpoint)
     }
     else
     {
-        emberEventControlSetDelayMS(configureTempEventControl(endpoint), UPDATE_TIME_MS);
+        emberEventControlSetDelayOnTransitionTick(configureTempEventControl(endpoint), UPDATE_TIME_MS);
     }
 
     Attributes::ColorTemperature::Set(endpoint, colorTempTransitionState->currentValue);
@@ -2238,7 +2238,7 @@ bool ColorControlServer::moveColorTempCommand(const app::ConcreteCommandPath & c
     Attributes::RemainingTime::Set(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(configureTempEventControl(endpoint), UPDATE_TIME_MS);
+    emberEventControlSetDelayOnTransitionTick(configureTempEventControl(endpoint), UPDATE_TIME_MS);
 
 exit:
     emberAfSendImmediateDefaultResponse(status);
@@ -2358,7 +2358,7 @@ bool ColorControlServer::stepColorTempCommand(const app::ConcreteCommandPath & c
     Attributes::RemainingTime::Set(endpoint, transitionTime);
 
     // kick off the state machine:
-    emberEventControlSetDelayMS(configureTempEventControl(endpoint), UPDATE_TIME_MS);
+    emberEventControlSetDelayOnTransitionTick(configureTempEventControl(endpoint), UPDATE_TIME_MS);
 
 exit:
     emberAfSendImmediateDefaultResponse(status);
@@ -22,6 +22,7 @@
 #include <app/AttributeAccessInterface.h>
 #include <app/CommandHandler.h>
 #include <app/ConcreteCommandPath.h>
+#include <app/reporting/reporting.h>
 #include <app/util/af.h>
 #include <app/util/attribute-storage.h>
 #include <lib/core/Optional.h>
@@ -112,6 +113,21 @@ CHIP_ERROR EthernetDiagosticsAttrAccess::Read(const ConcreteReadAttributePath &
     }
     return CHIP_NO_ERROR;
 }
+
+class EthernetDiagnosticsDelegate : public DeviceLayer::EthernetDiagnosticsDelegate
+{
+    // Gets called when the platform detects that the value of an attribute has changed.
+    void OnAttributeChanged(AttributeId attributeId) override
+    {
+        for (auto endpoint : EnabledEndpointsWithServerCluster(EthernetNetworkDiagnostics::Id))
+        {
+            MatterReportingAttributeChangeCallback(endpoint, EthernetNetworkDiagnostics::Id, attributeId);
+        }
+    }
+};
+
+EthernetDiagnosticsDelegate gDiagnosticDelegate;
+
 } // anonymous namespace
 
 bool emberAfEthernetNetworkDiagnosticsClusterResetCountsCallback(app::CommandHandler * commandObj,
@@ -147,4 +163,5 @@ exit:
 void MatterEthernetNetworkDiagnosticsPluginServerInitCallback()
 {
     registerAttributeAccessOverride(&gAttrAccess);
+    DeviceLayer::GetDiagnosticDataProvider().SetEthernetDiagnosticsDelegate(&gDiagnosticDelegate);
 }
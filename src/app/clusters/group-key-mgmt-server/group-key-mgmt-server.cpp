@@ -24,9 +24,11 @@
 #include <app-common/zap-generated/command-id.h>
 #include <app/AttributeAccessInterface.h>
 #include <app/CommandHandler.h>
+#include <app/server/Server.h>
 #include <app/util/af.h>
 #include <app/util/attribute-storage.h>
 #include <credentials/GroupDataProvider.h>
+#include <lib/support/BufferWriter.h>
 #include <lib/support/CodeUtils.h>
 
 using namespace chip;
@@ -366,8 +368,19 @@ bool emberAfGroupKeyManagementClusterKeySetWriteCallback(
         keyset.num_keys_used++;
     }
 
+    // Operational group keys are derived from the epoch keys using the compressed fabric identifier
+    FabricInfo * fabricInfo = Server::GetInstance().GetFabricTable().FindFabricWithIndex(fabric);
+    if (nullptr == fabricInfo)
+    {
+        emberAfSendImmediateDefaultResponse(EMBER_ZCL_STATUS_FAILURE);
+        return true;
+    }
+    uint8_t compressed_fabric_id[sizeof(uint64_t)];
+    Encoding::BigEndian::BufferWriter(compressed_fabric_id, sizeof(compressed_fabric_id))
+        .Put64(fabricInfo->GetPeerId().GetCompressedFabricId());
+
     // Set KeySet
-    CHIP_ERROR err = provider->SetKeySet(fabric, keyset);
+    CHIP_ERROR err = provider->SetKeySet(fabric, ByteSpan(compressed_fabric_id), keyset);
     if (CHIP_NO_ERROR == err)
     {
         ChipLogDetail(Zcl, "GroupKeyManagementCluster: KeySetWrite OK");
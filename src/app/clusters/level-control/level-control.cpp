@@ -129,7 +129,7 @@ static void reallyUpdateCoupledColorTemp(EndpointId endpoint);
 
 static void schedule(EndpointId endpoint, uint32_t delayMs)
 {
-    emberAfScheduleServerTickExtended(endpoint, LevelControl::Id, delayMs, EMBER_AF_LONG_POLL, EMBER_AF_OK_TO_SLEEP);
+    emberAfScheduleServerTransitionTick(endpoint, LevelControl::Id, delayMs);
 }
 
 static void deactivate(EndpointId endpoint)
@@ -0,0 +1,195 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/CodeUtils.h>
+
+#include <cstdint>
+#include <cstring>
+
+namespace chip {
+namespace app {
+namespace Clusters {
+namespace Scenes {
+
+/**
+ * RAM index of the scene table entries in use, sorted by endpoint, group id and scene id, so that commands look up a
+ * scene, or the scenes of a group, without reading the whole table from storage.
+ *
+ * The index does not access the table itself: it is built from the table with Rebuild, and the owner keeps it in step
+ * with Add and Remove as it stores and clears entries.
+ */
+template <uint8_t kTableSize>
+class SceneTableIndex
+{
+public:
+    struct Entry
+    {
+        EndpointId endpoint;
+        GroupId groupId;
+        uint8_t sceneId;
+        uint8_t index; // Index of the entry in the scene table
+    };
+
+    /// Returned by Find when the scene is not in the index.
+    static constexpr uint8_t kNotFound = 0xFF;
+
+    static_assert(kTableSize < kNotFound, "Scene table too large to index");
+
+    bool IsValid() const { return mValid; }
+
+    /// Forget the index, so that the next Rebuild reads the table again.
+    void Invalidate() { mValid = false; }
+
+    /**
+     * Build the index from the table, unless it is already valid. readEntry(index, entry) fills the endpoint, group id
+     * and scene id of the table entry at the given index, and returns whether the entry is in use.
+     */
+    template <typename ReadEntry>
+    void Rebuild(ReadEntry && readEntry)
+    {
+        if (mValid)
+        {
+            return;
+        }
+
+        mCount = 0;
+        for (uint8_t i = 0; i < kTableSize; i++)
+        {
+            Entry entry;
+            if (readEntry(i, entry))
+            {
+                Add(entry.endpoint, entry.groupId, entry.sceneId, i);
+            }
+        }
+        mValid = true;
+    }
+
+    uint8_t Count() const { return mCount; }
+    const Entry & At(uint8_t position) const { return mEntries[position]; }
+
+    /// Position of the first entry not less than the given key.
+    uint8_t LowerBound(EndpointId endpoint, GroupId groupId, uint8_t sceneId) const
+    {
+        uint8_t low = 0, high = mCount;
+        while (low < high)
+        {
+            uint8_t middle = static_cast<uint8_t>(low + (high - low) / 2);
+            if (Less(mEntries[middle], endpoint, groupId, sceneId))
+            {
+                low = static_cast<uint8_t>(middle + 1);
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        return low;
+    }
+
+    /// Position of the given scene, or kNotFound.
+    uint8_t Find(EndpointId endpoint, GroupId groupId, uint8_t sceneId) const
+    {
+        uint8_t position = LowerBound(endpoint, groupId, sceneId);
+        if (position < mCount && mEntries[position].endpoint == endpoint && mEntries[position].groupId == groupId &&
+            mEntries[position].sceneId == sceneId)
+        {
+            return position;
+        }
+        return kNotFound;
+    }
+
+    /// Whether the entry at the given position belongs to the given group.
+    bool InGroup(uint8_t position, EndpointId endpoint, GroupId groupId) const
+    {
+        return position < mCount && mEntries[position].endpoint == endpoint && mEntries[position].groupId == groupId;
+    }
+
+    /// Number of entries used by the given endpoint.
+    uint8_t CountForEndpoint(EndpointId endpoint) const
+    {
+        uint8_t count = 0;
+        for (uint8_t position = LowerBound(endpoint, 0, 0); position < mCount && mEntries[position].endpoint == endpoint;
+             position++)
+        {
+            count++;
+        }
+        return count;
+    }
+
+    /// Index of a table entry not in use, or kNotFound when the table is full.
+    uint8_t FindUnusedIndex() const
+    {
+        bool used[kTableSize] = {};
+        for (uint8_t position = 0; position < mCount; position++)
+        {
+            used[mEntries[position].index] = true;
+        }
+        for (uint8_t i = 0; i < kTableSize; i++)
+        {
+            if (!used[i])
+            {
+                return i;
+            }
+        }
+        return kNotFound;
+    }
+
+    /// Index a table entry. Ignored if the index is full or the table index is out of range.
+    void Add(EndpointId endpoint, GroupId groupId, uint8_t sceneId, uint8_t index)
+    {
+        VerifyOrReturn(mCount < kTableSize && index < kTableSize);
+
+        uint8_t position = LowerBound(endpoint, groupId, sceneId);
+        memmove(&mEntries[position + 1], &mEntries[position], (mCount - position) * sizeof(Entry));
+        mEntries[position] = { endpoint, groupId, sceneId, index };
+        mCount++;
+    }
+
+    void Remove(uint8_t position)
+    {
+        VerifyOrReturn(position < mCount);
+
+        mCount--;
+        memmove(&mEntries[position], &mEntries[position + 1], (mCount - position) * sizeof(Entry));
+    }
+
+private:
+    static bool Less(const Entry & entry, EndpointId endpoint, GroupId groupId, uint8_t sceneId)
+    {
+        if (entry.endpoint != endpoint)
+        {
+            return entry.endpoint < endpoint;
+        }
+        if (entry.groupId != groupId)
+        {
+            return entry.groupId < groupId;
+        }
+        return entry.sceneId < sceneId;
+    }
+
+    Entry mEntries[kTableSize];
+    uint8_t mCount = 0;
+    bool mValid    = false;
+};
+
+} // namespace Scenes
+} // namespace Clusters
+} // namespace app
+} // namespace chip
@@ -39,6 +39,7 @@
  ******************************************************************************/
 
 #include "scenes.h"
+#include "SceneTableIndex.h"
 #include "app/util/common.h"
 #include <app-common/zap-generated/attribute-id.h>
 #include <app-common/zap-generated/attribute-type.h>
@@ -48,6 +49,8 @@
 #include <app/CommandHandler.h>
 #include <app/ConcreteCommandPath.h>
 #include <app/util/af.h>
+#include <lib/support/DefaultStorageKeyAllocator.h>
+#include <platform/KeyValueStoreManager.h>
 
 #ifdef EMBER_AF_PLUGIN_GROUPS_SERVER
 #include <app/clusters/groups-server/groups-server.h>
@@ -61,10 +64,142 @@ using namespace chip;
 using namespace chip::app::Clusters::Scenes;
 
 uint8_t emberAfPluginScenesServerEntriesInUse = 0;
-#if !defined(EMBER_AF_PLUGIN_SCENES_USE_TOKENS) || defined(EZSP_HOST)
+#if defined(EMBER_AF_PLUGIN_SCENES_USE_KVS)
+void emberAfPluginScenesServerLoadSceneEntry(EmberAfSceneTableEntry & entry, uint8_t i)
+{
+    DefaultStorageKeyAllocator key;
+    size_t size    = 0;
+    CHIP_ERROR err = DeviceLayer::PersistedStorage::KeyValueStoreMgr().Get(key.SceneTableEntry(i), &entry, sizeof(entry), &size);
+    if (err != CHIP_NO_ERROR || size != sizeof(entry))
+    {
+        // Only the entries in use are stored.
+        memset(&entry, 0, sizeof(entry));
+        entry.endpoint = EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID;
+    }
+}
+
+void emberAfPluginScenesServerStoreSceneEntry(const EmberAfSceneTableEntry & entry, uint8_t i)
+{
+    DefaultStorageKeyAllocator key;
+    CHIP_ERROR err;
+    if (entry.endpoint == EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID)
+    {
+        err = DeviceLayer::PersistedStorage::KeyValueStoreMgr().Delete(key.SceneTableEntry(i));
+        if (err == CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND)
+        {
+            err = CHIP_NO_ERROR;
+        }
+    }
+    else
+    {
+        err = DeviceLayer::PersistedStorage::KeyValueStoreMgr().Put(key.SceneTableEntry(i), &entry, sizeof(entry));
+    }
+
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Zcl, "Failed to store scene table entry %u: %" CHIP_ERROR_FORMAT, i, err.Format());
+    }
+}
+#elif !defined(EMBER_AF_PLUGIN_SCENES_USE_TOKENS) || defined(EZSP_HOST)
 EmberAfSceneTableEntry emberAfPluginScenesServerSceneTable[EMBER_AF_PLUGIN_SCENES_TABLE_SIZE];
 #endif
 
+#ifndef EMBER_AF_PLUGIN_SCENES_MAX_SCENES_PER_ENDPOINT
+// The maximum number of scene table entries used by a single endpoint, so that one endpoint of a
+// device with many endpoints, such as a bridge, can't use up the whole table.
+#if EMBER_AF_PLUGIN_SCENES_TABLE_SIZE < 16
+#define EMBER_AF_PLUGIN_SCENES_MAX_SCENES_PER_ENDPOINT EMBER_AF_PLUGIN_SCENES_TABLE_SIZE
+#else
+#define EMBER_AF_PLUGIN_SCENES_MAX_SCENES_PER_ENDPOINT 16
+#endif
+#endif
+
+namespace {
+
+// Index of the scene table entries in use, built from the table on first use and after the cluster init callback.
+using SceneIndex = app::Clusters::Scenes::SceneTableIndex<EMBER_AF_PLUGIN_SCENES_TABLE_SIZE>;
+SceneIndex sSceneIndex;
+
+static_assert(SceneIndex::kNotFound == EMBER_AF_SCENE_TABLE_NULL_INDEX, "Scene index and table disagree on the null index");
+
+void ensureSceneIndex()
+{
+    sSceneIndex.Rebuild([](uint8_t index, SceneIndex::Entry & indexEntry) {
+        EmberAfSceneTableEntry entry;
+        emberAfPluginScenesServerRetrieveSceneEntry(entry, index);
+        indexEntry.endpoint = entry.endpoint;
+        indexEntry.groupId  = entry.groupId;
+        indexEntry.sceneId  = entry.sceneId;
+        return entry.endpoint != EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID;
+    });
+}
+
+// Returns the position in the index of the given scene, or EMBER_AF_SCENE_TABLE_NULL_INDEX if it is not in the table.
+uint8_t findSceneIndexPosition(EndpointId endpoint, GroupId groupId, uint8_t sceneId)
+{
+    ensureSceneIndex();
+    return sSceneIndex.Find(endpoint, groupId, sceneId);
+}
+
+// Returns the scene table index of the given scene, or EMBER_AF_SCENE_TABLE_NULL_INDEX if it is not in the table.
+uint8_t findSceneEntry(EndpointId endpoint, GroupId groupId, uint8_t sceneId)
+{
+    uint8_t position = findSceneIndexPosition(endpoint, groupId, sceneId);
+    return (position == EMBER_AF_SCENE_TABLE_NULL_INDEX) ? EMBER_AF_SCENE_TABLE_NULL_INDEX : sSceneIndex.At(position).index;
+}
+
+// Returns the number of free scene table entries the given endpoint may still use.
+uint8_t sceneCapacityForEndpoint(EndpointId endpoint)
+{
+    ensureSceneIndex();
+    uint8_t endpointCount    = sSceneIndex.CountForEndpoint(endpoint);
+    uint8_t tableCapacity    = static_cast<uint8_t>(EMBER_AF_PLUGIN_SCENES_TABLE_SIZE - sSceneIndex.Count());
+    uint8_t endpointCapacity = (endpointCount < EMBER_AF_PLUGIN_SCENES_MAX_SCENES_PER_ENDPOINT)
+        ? static_cast<uint8_t>(EMBER_AF_PLUGIN_SCENES_MAX_SCENES_PER_ENDPOINT - endpointCount)
+        : 0;
+    return (tableCapacity < endpointCapacity) ? tableCapacity : endpointCapacity;
+}
+
+// Returns the scene table index of an unused entry the given endpoint may use, or EMBER_AF_SCENE_TABLE_NULL_INDEX if
+// there is none.
+uint8_t findUnusedSceneEntry(EndpointId endpoint)
+{
+    if (sceneCapacityForEndpoint(endpoint) == 0)
+    {
+        return EMBER_AF_SCENE_TABLE_NULL_INDEX;
+    }
+    return sSceneIndex.FindUnusedIndex();
+}
+
+// Marks the scene table entry at the given index position unused.
+void removeSceneEntry(uint8_t position)
+{
+    EmberAfSceneTableEntry entry;
+    uint8_t index = sSceneIndex.At(position).index;
+    emberAfPluginScenesServerRetrieveSceneEntry(entry, index);
+    entry.groupId  = ZCL_SCENES_GLOBAL_SCENE_GROUP_ID;
+    entry.endpoint = EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID;
+    emberAfPluginScenesServerSaveSceneEntry(entry, index);
+    emberAfPluginScenesServerDecrNumSceneEntriesInUse();
+    sSceneIndex.Remove(position);
+}
+
+// Marks all the scene table entries of the given group unused, returning how many there were.
+uint8_t removeSceneEntriesInGroup(EndpointId endpoint, GroupId groupId)
+{
+    ensureSceneIndex();
+    uint8_t position = sSceneIndex.LowerBound(endpoint, groupId, 0);
+    uint8_t removed  = 0;
+    while (sSceneIndex.InGroup(position, endpoint, groupId))
+    {
+        removeSceneEntry(position);
+        removed++;
+    }
+    return removed;
+}
+
+} // namespace
+
 static FabricIndex GetFabricIndex(app::CommandHandler * commandObj)
 {
     VerifyOrReturnError(nullptr != commandObj, 0);
@@ -122,6 +257,11 @@ void emberAfScenesClusterServerInitCallback(EndpointId endpoint)
                              (uint8_t *) &nameSupport, ZCL_BITMAP8_ATTRIBUTE_TYPE);
     }
 #endif
+#if defined(EMBER_AF_PLUGIN_SCENES_USE_KVS)
+    // The stored scenes are kept across restarts, and the index is kept in step with the storage.
+    ensureSceneIndex();
+    emberAfPluginScenesServerSetNumSceneEntriesInUse(sSceneIndex.Count());
+#else
 #if !defined(EMBER_AF_PLUGIN_SCENES_USE_TOKENS) || defined(EZSP_HOST)
     {
         uint8_t i;
@@ -134,6 +274,8 @@ void emberAfScenesClusterServerInitCallback(EndpointId endpoint)
         }
         emberAfPluginScenesServerSetNumSceneEntriesInUse(0);
     }
+#endif
+    sSceneIndex.Invalidate();
 #endif
     emberAfScenesSetSceneCountAttribute(endpoint, emberAfPluginScenesServerNumSceneEntriesInUse());
 }
@@ -267,20 +409,12 @@ bool emberAfScenesClusterRemoveSceneCallback(app::CommandHandler * commandObj, c
     }
     else
     {
-        uint8_t i;
-        for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+        uint8_t position = findSceneIndexPosition(emberAfCurrentEndpoint(), groupId, sceneId);
+        if (position != EMBER_AF_SCENE_TABLE_NULL_INDEX)
         {
-            EmberAfSceneTableEntry entry;
-            emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-            if (entry.endpoint == emberAfCurrentEndpoint() && entry.groupId == groupId && entry.sceneId == sceneId)
-            {
-                entry.endpoint = EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID;
-                emberAfPluginScenesServerSaveSceneEntry(entry, i);
-                emberAfPluginScenesServerDecrNumSceneEntriesInUse();
-                emberAfScenesSetSceneCountAttribute(emberAfCurrentEndpoint(), emberAfPluginScenesServerNumSceneEntriesInUse());
-                status = EMBER_ZCL_STATUS_SUCCESS;
-                break;
-            }
+            removeSceneEntry(position);
+            emberAfScenesSetSceneCountAttribute(emberAfCurrentEndpoint(), emberAfPluginScenesServerNumSceneEntriesInUse());
+            status = EMBER_ZCL_STATUS_SUCCESS;
         }
     }
 
@@ -321,19 +455,8 @@ bool emberAfScenesClusterRemoveAllScenesCallback(app::CommandHandler * commandOb
 
     if (isEndpointInGroup(fabricIndex, emberAfCurrentEndpoint(), groupId))
     {
-        uint8_t i;
         status = EMBER_ZCL_STATUS_SUCCESS;
-        for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
-        {
-            EmberAfSceneTableEntry entry;
-            emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-            if (entry.endpoint == emberAfCurrentEndpoint() && entry.groupId == groupId)
-            {
-                entry.endpoint = EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID;
-                emberAfPluginScenesServerSaveSceneEntry(entry, i);
-                emberAfPluginScenesServerDecrNumSceneEntriesInUse();
-            }
-        }
+        removeSceneEntriesInGroup(emberAfCurrentEndpoint(), groupId);
         emberAfScenesSetSceneCountAttribute(emberAfCurrentEndpoint(), emberAfPluginScenesServerNumSceneEntriesInUse());
     }
 
@@ -455,15 +578,12 @@ bool emberAfScenesClusterGetSceneMembershipCallback(app::CommandHandler * comman
     if (status == EMBER_ZCL_STATUS_SUCCESS)
     {
         uint8_t i;
-        for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+        ensureSceneIndex();
+        for (i = sSceneIndex.LowerBound(emberAfCurrentEndpoint(), groupId, 0);
+             sSceneIndex.InGroup(i, emberAfCurrentEndpoint(), groupId); i++)
         {
-            EmberAfSceneTableEntry entry;
-            emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-            if (entry.endpoint == emberAfCurrentEndpoint() && entry.groupId == groupId)
-            {
-                sceneList[sceneCount] = entry.sceneId;
-                sceneCount++;
-            }
+            sceneList[sceneCount] = sSceneIndex.At(i).sceneId;
+            sceneCount++;
         }
         emberAfPutInt8uInResp(sceneCount);
         for (i = 0; i < sceneCount; i++)
@@ -479,9 +599,7 @@ bool emberAfScenesClusterGetSceneMembershipCallback(app::CommandHandler * comman
         SuccessOrExit(err = commandObj->PrepareCommand(path));
         VerifyOrExit((writer = commandObj->GetCommandDataIBTLVWriter()) != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
         SuccessOrExit(err = writer->Put(TLV::ContextTag(0), status));
-        SuccessOrExit(err = writer->Put(TLV::ContextTag(1),
-                                        static_cast<uint8_t>(EMBER_AF_PLUGIN_SCENES_TABLE_SIZE -
-                                                             emberAfPluginScenesServerNumSceneEntriesInUse())));
+        SuccessOrExit(err = writer->Put(TLV::ContextTag(1), sceneCapacityForEndpoint(emberAfCurrentEndpoint())));
         SuccessOrExit(err = writer->Put(TLV::ContextTag(2), groupId));
         SuccessOrExit(err = writer->Put(TLV::ContextTag(3), sceneCount));
         SuccessOrExit(err = writer->Put(TLV::ContextTag(4), ByteSpan(sceneList, sceneCount)));
@@ -500,28 +618,22 @@ EmberAfStatus emberAfScenesClusterStoreCurrentSceneCallback(chip::FabricIndex fa
                                                             uint8_t sceneId)
 {
     EmberAfSceneTableEntry entry;
-    uint8_t i, index = EMBER_AF_SCENE_TABLE_NULL_INDEX;
+    uint8_t index;
+    bool isNew = false;
 
     if (!isEndpointInGroup(fabricIndex, endpoint, groupId))
     {
         return EMBER_ZCL_STATUS_INVALID_FIELD;
     }
 
-    for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+    index = findSceneEntry(endpoint, groupId, sceneId);
+    if (index == EMBER_AF_SCENE_TABLE_NULL_INDEX)
     {
-        emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-        if (entry.endpoint == endpoint && entry.groupId == groupId && entry.sceneId == sceneId)
-        {
-            index = i;
-            break;
-        }
-        else if (index == EMBER_AF_SCENE_TABLE_NULL_INDEX && entry.endpoint == EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID)
-        {
-            index = i;
-        }
+        index = findUnusedSceneEntry(endpoint);
+        isNew = true;
     }
 
-    // If the target index is still zero, the table is full.
+    // If the target index is still null, the table is full.
     if (index == EMBER_AF_SCENE_TABLE_NULL_INDEX)
     {
         return EMBER_ZCL_STATUS_INSUFFICIENT_SPACE;
@@ -601,7 +713,7 @@ EmberAfStatus emberAfScenesClusterStoreCurrentSceneCallback(chip::FabricIndex fa
     // length is set to zero) and the transition time is set to zero.  The scene
     // count must be increased and written to the attribute table when adding a
     // new scene.  Otherwise, these fields and the count are left alone.
-    if (i != index)
+    if (isNew)
     {
         entry.endpoint = endpoint;
         entry.groupId  = groupId;
@@ -613,6 +725,7 @@ EmberAfStatus emberAfScenesClusterStoreCurrentSceneCallback(chip::FabricIndex fa
         entry.transitionTime100ms = 0;
         emberAfPluginScenesServerIncrNumSceneEntriesInUse();
         emberAfScenesSetSceneCountAttribute(endpoint, emberAfPluginScenesServerNumSceneEntriesInUse());
+        sSceneIndex.Add(endpoint, groupId, sceneId, index);
     }
 
     // Save the scene entry and mark is as valid by storing its scene and group
@@ -631,128 +744,123 @@ EmberAfStatus emberAfScenesClusterRecallSavedSceneCallback(chip::FabricIndex fab
     }
     else
     {
-        uint8_t i;
-        for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+        uint8_t index = findSceneEntry(endpoint, groupId, sceneId);
+        if (index != EMBER_AF_SCENE_TABLE_NULL_INDEX)
         {
             EmberAfSceneTableEntry entry;
-            emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-            if (entry.endpoint == endpoint && entry.groupId == groupId && entry.sceneId == sceneId)
-            {
+            emberAfPluginScenesServerRetrieveSceneEntry(entry, index);
 #ifdef ZCL_USING_ON_OFF_CLUSTER_SERVER
-                if (entry.hasOnOffValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, "on/off",
-                                         (uint8_t *) &entry.onOffValue, ZCL_BOOLEAN_ATTRIBUTE_TYPE);
-                }
+            if (entry.hasOnOffValue)
+            {
+                writeServerAttribute(endpoint, ZCL_ON_OFF_CLUSTER_ID, ZCL_ON_OFF_ATTRIBUTE_ID, "on/off",
+                                     (uint8_t *) &entry.onOffValue, ZCL_BOOLEAN_ATTRIBUTE_TYPE);
+            }
 #endif
 #ifdef ZCL_USING_LEVEL_CONTROL_CLUSTER_SERVER
-                if (entry.hasCurrentLevelValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_CURRENT_LEVEL_ATTRIBUTE_ID, "current level",
-                                         (uint8_t *) &entry.currentLevelValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
+            if (entry.hasCurrentLevelValue)
+            {
+                writeServerAttribute(endpoint, ZCL_LEVEL_CONTROL_CLUSTER_ID, ZCL_CURRENT_LEVEL_ATTRIBUTE_ID, "current level",
+                                     (uint8_t *) &entry.currentLevelValue, ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
 #endif
 #ifdef ZCL_USING_THERMOSTAT_CLUSTER_SERVER
-                if (entry.hasOccupiedCoolingSetpointValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_THERMOSTAT_CLUSTER_ID, ZCL_OCCUPIED_COOLING_SETPOINT_ATTRIBUTE_ID,
-                                         "occupied cooling setpoint", (uint8_t *) &entry.occupiedCoolingSetpointValue,
-                                         ZCL_INT16S_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasOccupiedHeatingSetpointValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_THERMOSTAT_CLUSTER_ID, ZCL_OCCUPIED_HEATING_SETPOINT_ATTRIBUTE_ID,
-                                         "occupied heating setpoint", (uint8_t *) &entry.occupiedHeatingSetpointValue,
-                                         ZCL_INT16S_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasSystemModeValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_THERMOSTAT_CLUSTER_ID, ZCL_SYSTEM_MODE_ATTRIBUTE_ID, "system mode",
-                                         (uint8_t *) &entry.systemModeValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
+            if (entry.hasOccupiedCoolingSetpointValue)
+            {
+                writeServerAttribute(endpoint, ZCL_THERMOSTAT_CLUSTER_ID, ZCL_OCCUPIED_COOLING_SETPOINT_ATTRIBUTE_ID,
+                                     "occupied cooling setpoint", (uint8_t *) &entry.occupiedCoolingSetpointValue,
+                                     ZCL_INT16S_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasOccupiedHeatingSetpointValue)
+            {
+                writeServerAttribute(endpoint, ZCL_THERMOSTAT_CLUSTER_ID, ZCL_OCCUPIED_HEATING_SETPOINT_ATTRIBUTE_ID,
+                                     "occupied heating setpoint", (uint8_t *) &entry.occupiedHeatingSetpointValue,
+                                     ZCL_INT16S_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasSystemModeValue)
+            {
+                writeServerAttribute(endpoint, ZCL_THERMOSTAT_CLUSTER_ID, ZCL_SYSTEM_MODE_ATTRIBUTE_ID, "system mode",
+                                     (uint8_t *) &entry.systemModeValue, ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
 #endif
 #ifdef ZCL_USING_COLOR_CONTROL_CLUSTER_SERVER
-                if (entry.hasCurrentXValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_CURRENT_X_ATTRIBUTE_ID,
-                                         "current x", (uint8_t *) &entry.currentXValue, ZCL_INT16U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasCurrentYValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_CURRENT_Y_ATTRIBUTE_ID,
-                                         "current y", (uint8_t *) &entry.currentYValue, ZCL_INT16U_ATTRIBUTE_TYPE);
-                }
+            if (entry.hasCurrentXValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_CURRENT_X_ATTRIBUTE_ID, "current x",
+                                     (uint8_t *) &entry.currentXValue, ZCL_INT16U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasCurrentYValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_CURRENT_Y_ATTRIBUTE_ID, "current y",
+                                     (uint8_t *) &entry.currentYValue, ZCL_INT16U_ATTRIBUTE_TYPE);
+            }
 
-                if (entry.hasEnhancedCurrentHueValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID,
-                                         ZCL_COLOR_CONTROL_ENHANCED_CURRENT_HUE_ATTRIBUTE_ID, "enhanced current hue",
-                                         (uint8_t *) &entry.enhancedCurrentHueValue, ZCL_INT16U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasCurrentSaturationValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_CURRENT_SATURATION_ATTRIBUTE_ID,
-                                         "current saturation", (uint8_t *) &entry.currentSaturationValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasColorLoopActiveValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_LOOP_ACTIVE_ATTRIBUTE_ID,
-                                         "color loop active", (uint8_t *) &entry.colorLoopActiveValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasColorLoopDirectionValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID,
-                                         ZCL_COLOR_CONTROL_COLOR_LOOP_DIRECTION_ATTRIBUTE_ID, "color loop direction",
-                                         (uint8_t *) &entry.colorLoopDirectionValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasColorLoopTimeValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_LOOP_TIME_ATTRIBUTE_ID,
-                                         "color loop time", (uint8_t *) &entry.colorLoopTimeValue, ZCL_INT16U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasColorTemperatureMiredsValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_TEMPERATURE_ATTRIBUTE_ID,
-                                         "color temp mireds", (uint8_t *) &entry.colorTemperatureMiredsValue,
-                                         ZCL_INT16U_ATTRIBUTE_TYPE);
-                }
+            if (entry.hasEnhancedCurrentHueValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_ENHANCED_CURRENT_HUE_ATTRIBUTE_ID,
+                                     "enhanced current hue", (uint8_t *) &entry.enhancedCurrentHueValue, ZCL_INT16U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasCurrentSaturationValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_CURRENT_SATURATION_ATTRIBUTE_ID,
+                                     "current saturation", (uint8_t *) &entry.currentSaturationValue, ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasColorLoopActiveValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_LOOP_ACTIVE_ATTRIBUTE_ID,
+                                     "color loop active", (uint8_t *) &entry.colorLoopActiveValue, ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasColorLoopDirectionValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_LOOP_DIRECTION_ATTRIBUTE_ID,
+                                     "color loop direction", (uint8_t *) &entry.colorLoopDirectionValue, ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasColorLoopTimeValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_LOOP_TIME_ATTRIBUTE_ID,
+                                     "color loop time", (uint8_t *) &entry.colorLoopTimeValue, ZCL_INT16U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasColorTemperatureMiredsValue)
+            {
+                writeServerAttribute(endpoint, ZCL_COLOR_CONTROL_CLUSTER_ID, ZCL_COLOR_CONTROL_COLOR_TEMPERATURE_ATTRIBUTE_ID,
+                                     "color temp mireds", (uint8_t *) &entry.colorTemperatureMiredsValue,
+                                     ZCL_INT16U_ATTRIBUTE_TYPE);
+            }
 #endif // ZCL_USING_COLOR_CONTROL_CLUSTER_SERVER
 #ifdef ZCL_USING_DOOR_LOCK_CLUSTER_SERVER
-                if (entry.hasLockStateValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_LOCK_STATE_ATTRIBUTE_ID, "lock state",
-                                         (uint8_t *) &entry.lockStateValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
+            if (entry.hasLockStateValue)
+            {
+                writeServerAttribute(endpoint, ZCL_DOOR_LOCK_CLUSTER_ID, ZCL_LOCK_STATE_ATTRIBUTE_ID, "lock state",
+                                     (uint8_t *) &entry.lockStateValue, ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
 #endif
 #ifdef ZCL_USING_WINDOW_COVERING_CLUSTER_SERVER
-                if (entry.hasCurrentPositionLiftPercentageValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_WINDOW_COVERING_CLUSTER_ID,
-                                         ZCL_WC_CURRENT_POSITION_LIFT_PERCENTAGE_ATTRIBUTE_ID, "CurrentPositionLiftPercentage",
-                                         (uint8_t *) &entry.currentPositionLiftPercentageValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasCurrentPositionTiltPercentageValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_WINDOW_COVERING_CLUSTER_ID,
-                                         ZCL_WC_CURRENT_POSITION_TILT_PERCENTAGE_ATTRIBUTE_ID, "CurrentPositionTiltPercentage",
-                                         (uint8_t *) &entry.currentPositionTiltPercentageValue, ZCL_INT8U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasTargetPositionLiftPercent100thsValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_WINDOW_COVERING_CLUSTER_ID,
-                                         ZCL_WC_TARGET_POSITION_LIFT_PERCENT100_THS_ATTRIBUTE_ID, "TargetPositionLiftPercent100ths",
-                                         (uint8_t *) &entry.targetPositionLiftPercent100thsValue, ZCL_INT16U_ATTRIBUTE_TYPE);
-                }
-                if (entry.hasTargetPositionTiltPercent100thsValue)
-                {
-                    writeServerAttribute(endpoint, ZCL_WINDOW_COVERING_CLUSTER_ID,
-                                         ZCL_WC_TARGET_POSITION_TILT_PERCENT100_THS_ATTRIBUTE_ID, "TargetPositionTiltPercent100ths",
-                                         (uint8_t *) &entry.targetPositionTiltPercent100thsValue, ZCL_INT16U_ATTRIBUTE_TYPE);
-                }
-#endif
-                emberAfScenesMakeValid(endpoint, sceneId, groupId);
-                return EMBER_ZCL_STATUS_SUCCESS;
+            if (entry.hasCurrentPositionLiftPercentageValue)
+            {
+                writeServerAttribute(endpoint, ZCL_WINDOW_COVERING_CLUSTER_ID, ZCL_WC_CURRENT_POSITION_LIFT_PERCENTAGE_ATTRIBUTE_ID,
+                                     "CurrentPositionLiftPercentage", (uint8_t *) &entry.currentPositionLiftPercentageValue,
+                                     ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasCurrentPositionTiltPercentageValue)
+            {
+                writeServerAttribute(endpoint, ZCL_WINDOW_COVERING_CLUSTER_ID, ZCL_WC_CURRENT_POSITION_TILT_PERCENTAGE_ATTRIBUTE_ID,
+                                     "CurrentPositionTiltPercentage", (uint8_t *) &entry.currentPositionTiltPercentageValue,
+                                     ZCL_INT8U_ATTRIBUTE_TYPE);
+            }
+            if (entry.hasTargetPositionLiftPercent100thsValue)
+            {
+                writeServerAttribute(endpoint, ZCL_WINDOW_COVERING_CLUSTER_ID,
+                                     ZCL_WC_TARGET_POSITION_LIFT_PERCENT100_THS_ATTRIBUTE_ID, "TargetPositionLiftPercent100ths",
+                                     (uint8_t *) &entry.targetPositionLiftPercent100thsValue, ZCL_INT16U_ATTRIBUTE_TYPE);
             }
+            if (entry.hasTargetPositionTiltPercent100thsValue)
+            {
+                writeServerAttribute(endpoint, ZCL_WINDOW_COVERING_CLUSTER_ID,
+                                     ZCL_WC_TARGET_POSITION_TILT_PERCENT100_THS_ATTRIBUTE_ID, "TargetPositionTiltPercent100ths",
+                                     (uint8_t *) &entry.targetPositionTiltPercent100thsValue, ZCL_INT16U_ATTRIBUTE_TYPE);
+            }
+#endif
+            emberAfScenesMakeValid(endpoint, sceneId, groupId);
+            return EMBER_ZCL_STATUS_SUCCESS;
         }
     }
 
@@ -770,7 +878,8 @@ bool emberAfPluginScenesServerParseAddScene(
     bool enhanced       = (cmd->commandId == ZCL_ENHANCED_ADD_SCENE_COMMAND_ID);
     auto fabricIndex    = GetFabricIndex(commandObj);
     EndpointId endpoint = cmd->apsFrame->destinationEndpoint;
-    uint8_t i, index = EMBER_AF_SCENE_TABLE_NULL_INDEX;
+    uint8_t index       = EMBER_AF_SCENE_TABLE_NULL_INDEX;
+    bool isNew          = false;
 
     emberAfScenesClusterPrintln("RX: %pAddScene 0x%2x, 0x%x, 0x%2x, \"%.*s\"", (enhanced ? "Enhanced" : ""), groupId, sceneId,
                                 transitionTime, static_cast<int>(sceneName.size()), sceneName.data());
@@ -784,21 +893,14 @@ bool emberAfPluginScenesServerParseAddScene(
         goto kickout;
     }
 
-    for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+    index = findSceneEntry(endpoint, groupId, sceneId);
+    if (index == EMBER_AF_SCENE_TABLE_NULL_INDEX)
     {
-        emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-        if (entry.endpoint == endpoint && entry.groupId == groupId && entry.sceneId == sceneId)
-        {
-            index = i;
-            break;
-        }
-        else if (index == EMBER_AF_SCENE_TABLE_NULL_INDEX && entry.endpoint == EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID)
-        {
-            index = i;
-        }
+        index = findUnusedSceneEntry(endpoint);
+        isNew = true;
     }
 
-    // If the target index is still zero, the table is full.
+    // If the target index is still null, the table is full.
     if (index == EMBER_AF_SCENE_TABLE_NULL_INDEX)
     {
         status = EMBER_ZCL_STATUS_INSUFFICIENT_SPACE;
@@ -826,7 +928,7 @@ bool emberAfPluginScenesServerParseAddScene(
 
     // When adding a new scene, wipe out all of the extensions before parsing the
     // extension field sets data.
-    if (i != index)
+    if (isNew)
     {
 #ifdef ZCL_USING_ON_OFF_CLUSTER_SERVER
         entry.hasOnOffValue = false;
@@ -1057,13 +1159,14 @@ bool emberAfPluginScenesServerParseAddScene(
     // If we got this far, we either added a new entry or updated an existing one.
     // If we added, store the basic data and increment the scene count.  In either
     // case, save the entry.
-    if (i != index)
+    if (isNew)
     {
         entry.endpoint = endpoint;
         entry.groupId  = groupId;
         entry.sceneId  = sceneId;
         emberAfPluginScenesServerIncrNumSceneEntriesInUse();
         emberAfScenesSetSceneCountAttribute(endpoint, emberAfPluginScenesServerNumSceneEntriesInUse());
+        sSceneIndex.Add(endpoint, groupId, sceneId, index);
     }
     emberAfPluginScenesServerSaveSceneEntry(entry, index);
     status = EMBER_ZCL_STATUS_SUCCESS;
@@ -1117,15 +1220,11 @@ bool emberAfPluginScenesServerParseViewScene(app::CommandHandler * commandObj, c
     }
     else
     {
-        uint8_t i;
-        for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+        uint8_t index = findSceneEntry(endpoint, groupId, sceneId);
+        if (index != EMBER_AF_SCENE_TABLE_NULL_INDEX)
         {
-            emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-            if (entry.endpoint == endpoint && entry.groupId == groupId && entry.sceneId == sceneId)
-            {
-                status = EMBER_ZCL_STATUS_SUCCESS;
-                break;
-            }
+            emberAfPluginScenesServerRetrieveSceneEntry(entry, index);
+            status = EMBER_ZCL_STATUS_SUCCESS;
         }
     }
 
@@ -1312,19 +1411,9 @@ exit:
 
 void emberAfScenesClusterRemoveScenesInGroupCallback(EndpointId endpoint, GroupId groupId)
 {
-    uint8_t i;
-    for (i = 0; i < EMBER_AF_PLUGIN_SCENES_TABLE_SIZE; i++)
+    if (removeSceneEntriesInGroup(endpoint, groupId) != 0)
     {
-        EmberAfSceneTableEntry entry;
-        emberAfPluginScenesServerRetrieveSceneEntry(entry, i);
-        if (entry.endpoint == endpoint && entry.groupId == groupId)
-        {
-            entry.groupId  = ZCL_SCENES_GLOBAL_SCENE_GROUP_ID;
-            entry.endpoint = EMBER_AF_SCENE_TABLE_UNUSED_ENDPOINT_ID;
-            emberAfPluginScenesServerSaveSceneEntry(entry, i);
-            emberAfPluginScenesServerDecrNumSceneEntriesInUse();
-            emberAfScenesSetSceneCountAttribute(emberAfCurrentEndpoint(), emberAfPluginScenesServerNumSceneEntriesInUse());
-        }
+        emberAfScenesSetSceneCountAttribute(emberAfCurrentEndpoint(), emberAfPluginScenesServerNumSceneEntriesInUse());
     }
 }
 
@@ -44,6 +44,7 @@
 #include <app/data-model/DecodableList.h>
 #include <app/util/af-types.h>
 #include <lib/support/Span.h>
+#include <platform/CHIPDeviceBuildConfig.h>
 #include <stdint.h>
 
 EmberAfStatus emberAfScenesSetSceneCountAttribute(chip::EndpointId endpoint, uint8_t newCount);
@@ -54,8 +55,25 @@ EmberAfStatus emberAfScenesMakeValid(chip::EndpointId endpoint, uint8_t sceneId,
 
 void emAfPluginScenesServerPrintInfo(void);
 
+#if !defined(EMBER_AF_PLUGIN_SCENES_USE_TOKENS) && !defined(EMBER_AF_PLUGIN_SCENES_USE_KVS) && CHIP_DEVICE_LAYER_TARGET_LINUX
+// Keep the scene table across restarts on Linux.
+#define EMBER_AF_PLUGIN_SCENES_USE_KVS
+#endif
+
 extern uint8_t emberAfPluginScenesServerEntriesInUse;
-#if defined(EMBER_AF_PLUGIN_SCENES_USE_TOKENS) && !defined(EZSP_HOST)
+#if defined(EMBER_AF_PLUGIN_SCENES_USE_KVS)
+// In this case, we use the key value store. Only the entries in use are stored, so the storage used grows and
+// shrinks with the scenes, and the table itself takes no RAM.
+void emberAfPluginScenesServerLoadSceneEntry(EmberAfSceneTableEntry & entry, uint8_t i);
+void emberAfPluginScenesServerStoreSceneEntry(const EmberAfSceneTableEntry & entry, uint8_t i);
+#define emberAfPluginScenesServerRetrieveSceneEntry(entry, i) emberAfPluginScenesServerLoadSceneEntry(entry, i)
+#define emberAfPluginScenesServerSaveSceneEntry(entry, i) emberAfPluginScenesServerStoreSceneEntry(entry, i)
+// The number of entries in use is counted from the index when the cluster is initialized.
+#define emberAfPluginScenesServerNumSceneEntriesInUse() (emberAfPluginScenesServerEntriesInUse)
+#define emberAfPluginScenesServerSetNumSceneEntriesInUse(x) (emberAfPluginScenesServerEntriesInUse = (x))
+#define emberAfPluginScenesServerIncrNumSceneEntriesInUse() (++emberAfPluginScenesServerEntriesInUse)
+#define emberAfPluginScenesServerDecrNumSceneEntriesInUse() (--emberAfPluginScenesServerEntriesInUse)
+#elif defined(EMBER_AF_PLUGIN_SCENES_USE_TOKENS) && !defined(EZSP_HOST)
 // In this case, we use token storage
 #define emberAfPluginScenesServerRetrieveSceneEntry(entry, i) halCommonGetIndexedToken(&entry, TOKEN_SCENES_TABLE, i)
 #define emberAfPluginScenesServerSaveSceneEntry(entry, i) halCommonSetIndexedToken(TOKEN_SCENES_TABLE, i, &entry)
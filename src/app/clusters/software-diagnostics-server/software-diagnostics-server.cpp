@@ -23,6 +23,7 @@
 #include <app/CommandHandler.h>
 #include <app/ConcreteCommandPath.h>
 #include <app/EventLogging.h>
+#include <app/reporting/reporting.h>
 #include <app/util/af.h>
 #include <app/util/attribute-storage.h>
 #include <lib/core/Optional.h>
@@ -144,6 +145,15 @@ class SoftwareDiagnosticsDelegate : public DeviceLayer::SoftwareDiagnosticsDeleg
             }
         }
     }
+
+    // Gets called when the platform detects that the value of an attribute has changed.
+    void OnAttributeChanged(AttributeId attributeId) override
+    {
+        for (auto endpoint : EnabledEndpointsWithServerCluster(SoftwareDiagnostics::Id))
+        {
+            MatterReportingAttributeChangeCallback(endpoint, SoftwareDiagnostics::Id, attributeId);
+        }
+    }
 };
 
 SoftwareDiagnosticsDelegate gDiagnosticDelegate;
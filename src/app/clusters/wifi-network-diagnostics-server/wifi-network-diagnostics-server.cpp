@@ -23,6 +23,7 @@
 #include <app/CommandHandler.h>
 #include <app/ConcreteCommandPath.h>
 #include <app/EventLogging.h>
+#include <app/reporting/reporting.h>
 #include <app/util/af.h>
 #include <app/util/attribute-storage.h>
 #include <lib/core/Optional.h>
@@ -203,6 +204,15 @@ class WiFiDiagnosticsDelegate : public DeviceLayer::WiFiDiagnosticsDelegate
             }
         }
     }
+
+    // Gets called when the platform detects that the value of an attribute has changed.
+    void OnAttributeChanged(AttributeId attributeId) override
+    {
+        for (auto endpoint : EnabledEndpointsWithServerCluster(WiFiNetworkDiagnostics::Id))
+        {
+            MatterReportingAttributeChangeCallback(endpoint, WiFiNetworkDiagnostics::Id, attributeId);
+        }
+    }
 };
 
 WiFiDiagnosticsDelegate gDiagnosticDelegate;
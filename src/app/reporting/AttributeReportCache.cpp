@@ -0,0 +1,82 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/AttributeReportCache.h>
+
+#include <lib/support/CodeUtils.h>
+
+#if CHIP_IM_REPORT_CACHE_SIZE > 0
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+static_assert(CHIP_IM_REPORT_CACHE_SIZE <= UINT16_MAX, "CHIP_IM_REPORT_CACHE_SIZE is too large");
+
+void AttributeReportCache::Reset(bool aEnabled)
+{
+    mEntryCount = 0;
+    mBufferUsed = 0;
+    mEnabled    = aEnabled;
+    mFull       = false;
+}
+
+bool AttributeReportCache::Find(const ConcreteAttributePath & aPath, FabricIndex aFabricIndex, ByteSpan & aEncodedReports) const
+{
+    for (uint16_t i = 0; i < mEntryCount; i++)
+    {
+        const Entry & entry = mEntries[i];
+        if (entry.mPath == aPath && entry.mFabricIndex == aFabricIndex)
+        {
+            aEncodedReports = ByteSpan(&mBuffer[entry.mOffset], entry.mLength);
+            return true;
+        }
+    }
+    return false;
+}
+
+MutableByteSpan AttributeReportCache::GetAvailableBuffer()
+{
+    if (!mEnabled || mFull || mEntryCount >= ArraySize(mEntries))
+    {
+        return MutableByteSpan();
+    }
+    return MutableByteSpan(&mBuffer[mBufferUsed], sizeof(mBuffer) - mBufferUsed);
+}
+
+CHIP_ERROR AttributeReportCache::Add(const ConcreteAttributePath & aPath, FabricIndex aFabricIndex, ByteSpan aEncodedReports)
+{
+    MutableByteSpan available = GetAvailableBuffer();
+    VerifyOrReturnError(!available.empty() && aEncodedReports.data() >= available.data() &&
+                            aEncodedReports.data() + aEncodedReports.size() <= available.data() + available.size(),
+                        CHIP_ERROR_INVALID_ARGUMENT);
+
+    Entry & entry      = mEntries[mEntryCount++];
+    entry.mPath        = aPath;
+    entry.mFabricIndex = aFabricIndex;
+    entry.mOffset      = static_cast<uint16_t>(aEncodedReports.data() - mBuffer);
+    entry.mLength      = static_cast<uint16_t>(aEncodedReports.size());
+    mBufferUsed        = static_cast<uint16_t>(entry.mOffset + entry.mLength);
+    return CHIP_NO_ERROR;
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
+
+#endif // CHIP_IM_REPORT_CACHE_SIZE > 0
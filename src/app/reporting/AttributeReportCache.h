@@ -0,0 +1,110 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the cache of encoded attribute reports shared by the
+ *      readers served during one run of the reporting engine.
+ *
+ */
+
+#pragma once
+
+#include <app/ConcreteAttributePath.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/support/Span.h>
+
+#if CHIP_IM_REPORT_CACHE_SIZE > 0
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/*
+ *  @class AttributeReportCache
+ *
+ *  @brief Holds the AttributeReportIBs encoded for an attribute path, so that the reporting engine can copy them into the
+ * reports of every reader interested in that path instead of reading and encoding the attribute again for each of them.
+ *
+ *         The cache is only valid while attribute values cannot change, i.e. within one run of the reporting engine, which
+ * clears it at the start of every run. Entries are appended to a fixed buffer; once it is full, nothing more is cached until
+ * the next run.
+ */
+class AttributeReportCache
+{
+public:
+    /**
+     * Drop all the entries and set whether the cache should be used until the next call.
+     */
+    void Reset(bool aEnabled);
+
+    bool IsEnabled() const { return mEnabled; }
+
+    /**
+     * Look up the reports encoded for a path.
+     *
+     * @param[in]  aPath            The concrete path of the attribute.
+     * @param[in]  aFabricIndex     The fabric the reports were encoded for, or kUndefinedFabricIndex if they do not depend
+     *                              on the accessing fabric.
+     * @param[out] aEncodedReports  The AttributeReportIB elements, each with an anonymous tag.
+     *
+     * @retval true if the reports were found.
+     */
+    bool Find(const ConcreteAttributePath & aPath, FabricIndex aFabricIndex, ByteSpan & aEncodedReports) const;
+
+    /**
+     * Get the free space of the cache, in which the reports for a new entry should be encoded before calling Add(). The
+     * span is empty if nothing more can be cached.
+     */
+    MutableByteSpan GetAvailableBuffer();
+
+    /**
+     * Add an entry for reports encoded in the buffer returned by GetAvailableBuffer().
+     *
+     * @retval CHIP_ERROR_INVALID_ARGUMENT if the reports are not in the available buffer.
+     */
+    CHIP_ERROR Add(const ConcreteAttributePath & aPath, FabricIndex aFabricIndex, ByteSpan aEncodedReports);
+
+    /**
+     * Stop caching anything new until the next Reset(), e.g. because an attribute did not fit in the available buffer.
+     */
+    void MarkFull() { mFull = true; }
+
+private:
+    struct Entry
+    {
+        ConcreteAttributePath mPath;
+        FabricIndex mFabricIndex;
+        uint16_t mOffset;
+        uint16_t mLength;
+    };
+
+    Entry mEntries[CHIP_IM_REPORT_CACHE_MAX_ENTRIES];
+    uint8_t mBuffer[CHIP_IM_REPORT_CACHE_SIZE];
+    uint16_t mEntryCount = 0;
+    uint16_t mBufferUsed = 0;
+    bool mEnabled        = false;
+    bool mFull           = false;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
+
+#endif // CHIP_IM_REPORT_CACHE_SIZE > 0
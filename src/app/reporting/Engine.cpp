@@ -23,20 +23,51 @@
  *
  */
 
+#include <access/AccessControl.h>
 #include <app/AppBuildConfig.h>
 #include <app/InteractionModelEngine.h>
 #include <app/reporting/Engine.h>
 #include <app/util/MatterCallbacks.h>
+#include <system/SystemClock.h>
+#include <system/SystemMetrics.h>
+#include <system/SystemTrace.h>
+
+#include <algorithm>
 
 using namespace chip::Access;
 
 namespace chip {
 namespace app {
 namespace reporting {
+
+SYSTEM_METRICS_HISTOGRAM(sReportBuildTime, "chip_im_report_build_time_microseconds",
+                         "Time taken to build and send a report data message");
+SYSTEM_METRICS_HISTOGRAM(sReportSize, "chip_im_report_size_bytes", "Payload size of the report data messages sent");
+
+namespace {
+
+constexpr uint64_t kSubscriptionWheelTickMs = CHIP_IM_SUBSCRIPTION_WHEEL_TICK_MS;
+
+static_assert(kSubscriptionWheelTickMs > 0, "CHIP_IM_SUBSCRIPTION_WHEEL_TICK_MS must not be 0");
+
+uint64_t GetMonotonicMilliseconds()
+{
+    return System::SystemClock().GetMonotonicMilliseconds64().count();
+}
+
+uint32_t GetSubscriptionWheelTick()
+{
+    return static_cast<uint32_t>(GetMonotonicMilliseconds() / kSubscriptionWheelTickMs);
+}
+
+} // namespace
+
 CHIP_ERROR Engine::Init()
 {
     mNumReportsInFlight = 0;
     mCurReadHandlerIdx  = 0;
+    mSubscriptionWheel.Reset(GetSubscriptionWheelTick());
+    mSubscriptionWheelTimerArmed = false;
     return CHIP_NO_ERROR;
 }
 
@@ -44,6 +75,8 @@ void Engine::Shutdown()
 {
     mNumReportsInFlight = 0;
     mCurReadHandlerIdx  = 0;
+    mSubscriptionWheel.Reset(GetSubscriptionWheelTick());
+    RefreshSubscriptionWheelTimer();
     InteractionModelEngine::GetInstance()->ReleaseClusterInfoList(mpGlobalDirtySet);
     mpGlobalDirtySet = nullptr;
 }
@@ -52,6 +85,15 @@ CHIP_ERROR
 Engine::RetrieveClusterData(const SubjectDescriptor & aSubjectDescriptor, AttributeReportIBs::Builder & aAttributeReportIBs,
                             const ConcreteReadAttributePath & aPath, AttributeValueEncoder::AttributeEncodeState * aEncoderState)
 {
+#if CHIP_IM_REPORT_CACHE_SIZE > 0
+    // Only whole attributes are cached: the rest of a chunked list depends on how much this reader has received already.
+    if (mReportCache.IsEnabled() && (aEncoderState == nullptr || aEncoderState->IsInitial()) &&
+        RetrieveCachedClusterData(aSubjectDescriptor, aAttributeReportIBs, aPath))
+    {
+        return CHIP_NO_ERROR;
+    }
+#endif
+
     ChipLogDetail(DataManagement, "<RE:Run> Cluster %" PRIx32 ", Attribute %" PRIx32 " is dirty", aPath.mClusterId,
                   aPath.mAttributeId);
     MatterPreAttributeReadCallback(aPath);
@@ -60,6 +102,80 @@ Engine::RetrieveClusterData(const SubjectDescriptor & aSubjectDescriptor, Attrib
     return CHIP_NO_ERROR;
 }
 
+#if CHIP_IM_REPORT_CACHE_SIZE > 0
+bool Engine::RetrieveCachedClusterData(const SubjectDescriptor & aSubjectDescriptor, AttributeReportIBs::Builder & aAttributeReportIBs,
+                                       const ConcreteReadAttributePath & aPath)
+{
+    // The cached data may have been encoded for another reader, so check the access of this one. Denied reads are left to
+    // ReadSingleClusterData, which knows how to report them, and are never cached.
+    RequestPath requestPath{ .cluster = aPath.mClusterId, .endpoint = aPath.mEndpointId };
+    if (GetAccessControl().Check(aSubjectDescriptor, requestPath, Privilege::kView) != CHIP_NO_ERROR)
+    {
+        return false;
+    }
+
+    FabricIndex fabricIndex = IsAttributeDataFabricDependent(aPath) ? aSubjectDescriptor.fabricIndex : kUndefinedFabricIndex;
+    ByteSpan encodedReports;
+
+    if (!mReportCache.Find(aPath, fabricIndex, encodedReports))
+    {
+        MutableByteSpan buffer = mReportCache.GetAvailableBuffer();
+        if (buffer.empty())
+        {
+            return false;
+        }
+
+        TLV::TLVWriter writer;
+        AttributeReportIBs::Builder cachedReportIBs;
+        AttributeValueEncoder::AttributeEncodeState encodeState;
+
+        writer.Init(buffer);
+        if (cachedReportIBs.Init(&writer) != CHIP_NO_ERROR)
+        {
+            mReportCache.MarkFull();
+            return false;
+        }
+
+        uint32_t start = writer.GetLengthWritten();
+        ChipLogDetail(DataManagement, "<RE:Run> Cluster %" PRIx32 ", Attribute %" PRIx32 " is dirty", aPath.mClusterId,
+                      aPath.mAttributeId);
+        MatterPreAttributeReadCallback(aPath);
+        CHIP_ERROR err = ReadSingleClusterData(aSubjectDescriptor, aPath, cachedReportIBs, &encodeState);
+        MatterPostAttributeReadCallback(aPath);
+
+        if (err != CHIP_NO_ERROR)
+        {
+            // Most likely the attribute does not fit in what is left of the cache. Either way, it is read again without it.
+            mReportCache.MarkFull();
+            return false;
+        }
+
+        encodedReports = ByteSpan(buffer.data() + start, writer.GetLengthWritten() - start);
+        VerifyOrReturnError(mReportCache.Add(aPath, fabricIndex, encodedReports) == CHIP_NO_ERROR, false);
+    }
+
+    TLV::TLVWriter backup;
+    TLV::TLVReader reader;
+    CHIP_ERROR err;
+
+    aAttributeReportIBs.Checkpoint(backup);
+    reader.Init(encodedReports);
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        SuccessOrExit(err = aAttributeReportIBs.GetWriter()->CopyElement(reader));
+    }
+
+exit:
+    if (err != CHIP_END_OF_TLV)
+    {
+        // The reports do not fit in this message. Let RetrieveClusterData chunk them.
+        aAttributeReportIBs.Rollback(backup);
+        return false;
+    }
+    return true;
+}
+#endif // CHIP_IM_REPORT_CACHE_SIZE > 0
+
 CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Builder & aReportDataBuilder,
                                                            ReadHandler * apReadHandler, bool * apHasMoreChunks,
                                                            bool * apHasEncodedData)
@@ -92,7 +208,7 @@ CHIP_ERROR Engine::BuildSingleReportDataAttributeReportIBs(ReportDataMessage::Bu
         for (; apReadHandler->GetAttributePathExpandIterator()->Get(readPath);
              apReadHandler->GetAttributePathExpandIterator()->Next())
         {
-            if (!apReadHandler->IsPriming())
+            if (!apReadHandler->IsFullReport())
             {
                 bool concretePathDirty = false;
                 // TODO: Optimize this implementation by making the iterator only emit intersected paths.
@@ -309,6 +425,11 @@ exit:
 
 CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
 {
+    CHIP_TRACE_SCOPE(InteractionModel, "BuildAndSendReport");
+#if CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+    System::Clock::Microseconds64 buildStartTime = System::SystemClock().GetMonotonicMicroseconds64();
+#endif
+
     CHIP_ERROR err = CHIP_NO_ERROR;
     chip::System::PacketBufferTLVWriter reportDataWriter;
     ReportDataMessage::Builder reportDataBuilder;
@@ -398,11 +519,15 @@ CHIP_ERROR Engine::BuildAndSendSingleReportData(ReadHandler * apReadHandler)
 
     err = reportDataWriter.Finalize(&bufHandle);
     SuccessOrExit(err);
+    SYSTEM_METRICS_RECORD(sReportSize, reportDataWriter.GetLengthWritten());
 
     ChipLogDetail(DataManagement, "<RE> Sending report (payload has %" PRIu32 " bytes)...", reportDataWriter.GetLengthWritten());
     err = SendReport(apReadHandler, std::move(bufHandle), hasMoreChunks);
     VerifyOrExit(err == CHIP_NO_ERROR,
                  ChipLogError(DataManagement, "<RE> Error sending out report data with %" CHIP_ERROR_FORMAT "!", err.Format()));
+#if CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+    SYSTEM_METRICS_RECORD(sReportBuildTime, (System::SystemClock().GetMonotonicMicroseconds64() - buildStartTime).count());
+#endif
 
     ChipLogDetail(DataManagement, "<RE> ReportsInFlight = %" PRIu32 " with readHandler %" PRIu32 ", RE has %s", mNumReportsInFlight,
                   mCurReadHandlerIdx, hasMoreChunks ? "more messages" : "no more messages");
@@ -425,24 +550,29 @@ void Engine::Run(System::Layer * aSystemLayer, void * apAppState)
     pEngine->Run();
 }
 
-CHIP_ERROR Engine::ScheduleRun()
+System::Layer * Engine::GetSystemLayer()
 {
-    if (mRunScheduled)
-    {
-        return CHIP_NO_ERROR;
-    }
-
     Messaging::ExchangeManager * exchangeManager = InteractionModelEngine::GetInstance()->GetExchangeManager();
     if (exchangeManager == nullptr)
     {
-        return CHIP_ERROR_INCORRECT_STATE;
+        return nullptr;
     }
     SessionManager * sessionManager = exchangeManager->GetSessionManager();
     if (sessionManager == nullptr)
     {
-        return CHIP_ERROR_INCORRECT_STATE;
+        return nullptr;
     }
-    System::Layer * systemLayer = sessionManager->SystemLayer();
+    return sessionManager->SystemLayer();
+}
+
+CHIP_ERROR Engine::ScheduleRun()
+{
+    if (mRunScheduled)
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    System::Layer * systemLayer = GetSystemLayer();
     if (systemLayer == nullptr)
     {
         return CHIP_ERROR_INCORRECT_STATE;
@@ -452,6 +582,90 @@ CHIP_ERROR Engine::ScheduleRun()
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR Engine::ScheduleSubscriptionIntervals(ReadHandler & aReadHandler)
+{
+    uint64_t nowMs         = GetMonotonicMilliseconds();
+    uint64_t minIntervalMs = nowMs + aReadHandler.mMinIntervalFloorSeconds * 1000ull;
+    uint64_t maxIntervalMs = nowMs + aReadHandler.mMaxIntervalCeilingSeconds * 1000ull;
+
+    if (aReadHandler.mMinIntervalFloorSeconds == 0)
+    {
+        // There is nothing to hold, so release the report now rather than at the next tick.
+        mSubscriptionWheel.ScheduleMaxInterval(aReadHandler, static_cast<uint32_t>(maxIntervalMs / kSubscriptionWheelTickMs),
+                                               aReadHandler.GetSubjectDescriptor().fabricIndex,
+                                               aReadHandler.GetSubjectDescriptor().subject);
+        aReadHandler.OnMinIntervalElapsed();
+        return RefreshSubscriptionWheelTimer();
+    }
+
+    // Round the min interval up and the max interval down, so that the report is sent within the negotiated window.
+    mSubscriptionWheel.Schedule(aReadHandler,
+                                static_cast<uint32_t>((minIntervalMs + kSubscriptionWheelTickMs - 1) / kSubscriptionWheelTickMs),
+                                static_cast<uint32_t>(maxIntervalMs / kSubscriptionWheelTickMs),
+                                aReadHandler.GetSubjectDescriptor().fabricIndex, aReadHandler.GetSubjectDescriptor().subject);
+    return RefreshSubscriptionWheelTimer();
+}
+
+void Engine::CancelSubscriptionIntervals(ReadHandler & aReadHandler)
+{
+    mSubscriptionWheel.Cancel(aReadHandler);
+    RefreshSubscriptionWheelTimer();
+}
+
+void Engine::OnMinIntervalElapsed(SubscriptionTimingWheel::Entry & aEntry)
+{
+    static_cast<ReadHandler &>(aEntry).OnMinIntervalElapsed();
+}
+
+void Engine::OnMaxIntervalElapsed(SubscriptionTimingWheel::Entry & aEntry)
+{
+    static_cast<ReadHandler &>(aEntry).OnMaxIntervalElapsed();
+}
+
+void Engine::OnSubscriptionWheelTimer(System::Layer * aSystemLayer, void * apAppState)
+{
+    Engine * const pEngine                = reinterpret_cast<Engine *>(apAppState);
+    pEngine->mSubscriptionWheelTimerArmed = false;
+    pEngine->mSubscriptionWheel.Advance(GetSubscriptionWheelTick(), *pEngine);
+
+    CHIP_ERROR err = pEngine->RefreshSubscriptionWheelTimer();
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(DataManagement, "<RE> Failed to arm the subscription timer: %" CHIP_ERROR_FORMAT, err.Format());
+    }
+}
+
+CHIP_ERROR Engine::RefreshSubscriptionWheelTimer()
+{
+    System::Layer * systemLayer = GetSystemLayer();
+    VerifyOrReturnError(systemLayer != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    uint32_t nextTick;
+    if (!mSubscriptionWheel.GetNextDeadline(nextTick))
+    {
+        if (mSubscriptionWheelTimerArmed)
+        {
+            systemLayer->CancelTimer(OnSubscriptionWheelTimer, this);
+            mSubscriptionWheelTimerArmed = false;
+        }
+        return CHIP_NO_ERROR;
+    }
+
+    if (mSubscriptionWheelTimerArmed && mSubscriptionWheelTimerTick == nextTick)
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    uint64_t nowMs      = GetMonotonicMilliseconds();
+    uint64_t deadlineMs = nextTick * kSubscriptionWheelTickMs;
+    uint64_t delayMs    = (deadlineMs > nowMs) ? std::min<uint64_t>(deadlineMs - nowMs, UINT32_MAX) : 0;
+    ReturnErrorOnFailure(
+        systemLayer->StartTimer(System::Clock::Milliseconds32(static_cast<uint32_t>(delayMs)), OnSubscriptionWheelTimer, this));
+    mSubscriptionWheelTimerTick  = nextTick;
+    mSubscriptionWheelTimerArmed = true;
+    return CHIP_NO_ERROR;
+}
+
 void Engine::Run()
 {
     uint32_t numReadHandled = 0;
@@ -461,21 +675,45 @@ void Engine::Run()
 
     mRunScheduled = false;
 
-    while ((mNumReportsInFlight < CHIP_IM_MAX_REPORTS_IN_FLIGHT) && (numReadHandled < CHIP_IM_MAX_NUM_READ_HANDLER))
+#if CHIP_IM_REPORT_CACHE_SIZE > 0
+    // Encoded attribute data is only worth keeping if more than one read handler may use it.
+    uint32_t numReportable = 0;
+    for (auto & handler : imEngine->mReadHandlers)
     {
-        if (readHandler->IsReportable())
+        numReportable += handler.IsReportable() ? 1 : 0;
+    }
+    mReportCache.Reset(numReportable > 1);
+#endif
+
+    {
+        // Reports built for different subscribers in this run are handed to the transport as one batch.
+        Messaging::ExchangeManager * exchangeManager = imEngine->GetExchangeManager();
+        ScopedSendBatch sendBatch((exchangeManager != nullptr) ? exchangeManager->GetSessionManager() : nullptr);
+
+        while ((mNumReportsInFlight < CHIP_IM_MAX_REPORTS_IN_FLIGHT) && (numReadHandled < CHIP_IM_MAX_NUM_READ_HANDLER))
         {
-            CHIP_ERROR err = BuildAndSendSingleReportData(readHandler);
-            if (err != CHIP_NO_ERROR)
+            if (readHandler->IsReportable())
             {
-                return;
+                CHIP_ERROR err = BuildAndSendSingleReportData(readHandler);
+                if (err != CHIP_NO_ERROR)
+                {
+#if CHIP_IM_REPORT_CACHE_SIZE > 0
+                    mReportCache.Reset(false);
+#endif
+                    return;
+                }
             }
+            numReadHandled++;
+            mCurReadHandlerIdx = (mCurReadHandlerIdx + 1) % CHIP_IM_MAX_NUM_READ_HANDLER;
+            readHandler        = imEngine->mReadHandlers + mCurReadHandlerIdx;
         }
-        numReadHandled++;
-        mCurReadHandlerIdx = (mCurReadHandlerIdx + 1) % CHIP_IM_MAX_NUM_READ_HANDLER;
-        readHandler        = imEngine->mReadHandlers + mCurReadHandlerIdx;
     }
 
+#if CHIP_IM_REPORT_CACHE_SIZE > 0
+    // Attribute values may change before the next run.
+    mReportCache.Reset(false);
+#endif
+
     bool allReadClean = true;
     for (auto & handler : InteractionModelEngine::GetInstance()->mReadHandlers)
     {
@@ -556,6 +794,7 @@ CHIP_ERROR Engine::SendReport(ReadHandler * apReadHandler, System::PacketBufferH
 
     // We can only have 1 report in flight for any given read - increment and break out.
     mNumReportsInFlight++;
+    CHIP_TRACE_COUNTER(InteractionModel, "ReportsInFlight", mNumReportsInFlight);
     err = apReadHandler->SendReportData(std::move(aPayload), aHasMoreChunks);
     return err;
 }
@@ -565,6 +804,7 @@ void Engine::OnReportConfirm()
     VerifyOrDie(mNumReportsInFlight > 0);
 
     mNumReportsInFlight--;
+    CHIP_TRACE_COUNTER(InteractionModel, "ReportsInFlight", mNumReportsInFlight);
     ChipLogDetail(DataManagement, "<RE> OnReportConfirm: NumReports = %" PRIu32, mNumReportsInFlight);
 }
 
@@ -635,6 +875,12 @@ CHIP_ERROR Engine::ScheduleEventDelivery(ConcreteEventPath & aPath, EventOptions
 }
 
 }; // namespace reporting
+
+bool __attribute__((weak)) IsAttributeDataFabricDependent(const ConcreteAttributePath & aPath)
+{
+    return true;
+}
+
 } // namespace app
 } // namespace chip
 
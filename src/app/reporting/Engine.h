@@ -27,6 +27,8 @@
 #include <access/AccessControl.h>
 #include <app/MessageDef/ReportDataMessage.h>
 #include <app/ReadHandler.h>
+#include <app/reporting/AttributeReportCache.h>
+#include <app/reporting/SubscriptionTimingWheel.h>
 #include <app/util/basic-types.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
@@ -49,8 +51,11 @@ namespace reporting {
  *
  *         At its core, it  tries to gather and pack as much relevant attributes changes and/or events as possible into a report
  * message before sending that to the reader. It continues to do so until it has no more work to do.
+ *
+ *         The min and max intervals of all subscriptions are tracked by a single timing wheel, so that subscriptions whose
+ * reports are due around the same time are served by the same run.
  */
-class Engine
+class Engine : private SubscriptionTimingWheel::Delegate
 {
 public:
     /**
@@ -96,6 +101,16 @@ public:
      */
     CHIP_ERROR ScheduleEventDelivery(ConcreteEventPath & aPath, EventOptions::Type aUrgent, uint32_t aBytesWritten);
 
+    /**
+     * Start the min and max intervals of a subscription from now, replacing the ones it had.
+     */
+    CHIP_ERROR ScheduleSubscriptionIntervals(ReadHandler & aReadHandler);
+
+    /**
+     * Stop tracking the intervals of a subscription.
+     */
+    void CancelSubscriptionIntervals(ReadHandler & aReadHandler);
+
 private:
     friend class TestReportingEngine;
     /**
@@ -112,6 +127,15 @@ private:
                                    AttributeReportIBs::Builder & aAttributeReportIBs,
                                    const ConcreteReadAttributePath & aClusterInfo,
                                    AttributeValueEncoder::AttributeEncodeState * apEncoderState);
+#if CHIP_IM_REPORT_CACHE_SIZE > 0
+    /**
+     * Copy the reports of an attribute from mReportCache, encoding and caching them first if needed.
+     *
+     * @retval true if the reports were written, false if they need to be encoded by RetrieveClusterData instead.
+     */
+    bool RetrieveCachedClusterData(const Access::SubjectDescriptor & aSubjectDescriptor,
+                                   AttributeReportIBs::Builder & aAttributeReportIBs, const ConcreteReadAttributePath & aPath);
+#endif
 
     /**
      * Check all active subscription, if the subscription has no paths that intersect with global dirty set,
@@ -131,6 +155,21 @@ private:
      */
     static void Run(System::Layer * aSystemLayer, void * apAppState);
 
+    void OnMinIntervalElapsed(SubscriptionTimingWheel::Entry & aEntry) override;
+    void OnMaxIntervalElapsed(SubscriptionTimingWheel::Entry & aEntry) override;
+
+    /**
+     * Advance the subscription timing wheel when its next deadline is reached.
+     */
+    static void OnSubscriptionWheelTimer(System::Layer * aSystemLayer, void * apAppState);
+
+    /**
+     * Arm the timer of the subscription timing wheel for its next deadline, or cancel it if no subscription is scheduled.
+     */
+    CHIP_ERROR RefreshSubscriptionWheelTimer();
+
+    System::Layer * GetSystemLayer();
+
     CHIP_ERROR ScheduleUrgentEventDelivery(ConcreteEventPath & aPath);
     CHIP_ERROR ScheduleBufferPressureEventDelivery(uint32_t aBytesWritten);
     void GetMinEventLogPosition(uint32_t & aMinLogPosition);
@@ -163,6 +202,22 @@ private:
      */
     ClusterInfo * mpGlobalDirtySet = nullptr;
 
+    /**
+     *  The deadlines of all the subscriptions, and the tick for which its timer is armed.
+     *
+     */
+    SubscriptionTimingWheel mSubscriptionWheel;
+    uint32_t mSubscriptionWheelTimerTick = 0;
+    bool mSubscriptionWheelTimerArmed    = false;
+
+#if CHIP_IM_REPORT_CACHE_SIZE > 0
+    /**
+     *  The attribute data encoded during the current run, shared by all the read handlers served in the run.
+     *
+     */
+    AttributeReportCache mReportCache;
+#endif
+
 #if CONFIG_IM_BUILD_FOR_UNIT_TEST
     uint32_t mReservedSize = 0;
 #endif
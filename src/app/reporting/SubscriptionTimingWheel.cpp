@@ -0,0 +1,245 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/reporting/SubscriptionTimingWheel.h>
+
+#include <algorithm>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+static_assert(CHIP_IM_SUBSCRIPTION_WHEEL_SLOTS > 0, "The subscription timing wheel needs at least one slot");
+
+void SubscriptionTimingWheel::Reset(uint32_t aNowTick)
+{
+    for (auto & slot : mSlots)
+    {
+        while (slot != nullptr)
+        {
+            Entry * entry = slot;
+            slot          = entry->mpNext;
+            entry->mpNext = nullptr;
+            entry->mPhase = Entry::Phase::kIdle;
+        }
+    }
+    mCurrentTick         = aNowTick;
+    mNumEntries          = 0;
+    mIsNextDeadlineKnown = false;
+}
+
+void SubscriptionTimingWheel::Schedule(Entry & aEntry, uint32_t aMinIntervalTick, uint32_t aMaxIntervalTick,
+                                       FabricIndex aPeerFabricIndex, NodeId aPeerNodeId)
+{
+    Cancel(aEntry);
+
+    aEntry.mMaxIntervalTick = std::max(aMinIntervalTick, aMaxIntervalTick);
+    aEntry.mPeerFabricIndex = aPeerFabricIndex;
+    aEntry.mPeerNodeId      = aPeerNodeId;
+    aEntry.mPhase           = Entry::Phase::kWaitingForMinInterval;
+    Insert(aEntry, aMinIntervalTick);
+}
+
+void SubscriptionTimingWheel::ScheduleMaxInterval(Entry & aEntry, uint32_t aMaxIntervalTick, FabricIndex aPeerFabricIndex,
+                                                  NodeId aPeerNodeId)
+{
+    Cancel(aEntry);
+
+    aEntry.mMaxIntervalTick = aMaxIntervalTick;
+    aEntry.mPeerFabricIndex = aPeerFabricIndex;
+    aEntry.mPeerNodeId      = aPeerNodeId;
+    aEntry.mPhase           = Entry::Phase::kWaitingForMaxInterval;
+    Insert(aEntry, ChooseMaxIntervalTick(aEntry));
+}
+
+void SubscriptionTimingWheel::Cancel(Entry & aEntry)
+{
+    if (!aEntry.IsScheduled())
+    {
+        return;
+    }
+
+    for (Entry ** link = &mSlots[aEntry.mDeadline % kNumSlots]; *link != nullptr; link = &(*link)->mpNext)
+    {
+        if (*link == &aEntry)
+        {
+            *link = aEntry.mpNext;
+            OnUnlinked(aEntry);
+            break;
+        }
+    }
+    aEntry.mpNext = nullptr;
+    aEntry.mPhase = Entry::Phase::kIdle;
+}
+
+void SubscriptionTimingWheel::Advance(uint32_t aNowTick, Delegate & aDelegate)
+{
+    if (aNowTick < mCurrentTick)
+    {
+        return;
+    }
+
+    // Unlink everything that is due before notifying the delegate, since an entry may be scheduled again by its callback.
+    // Visiting each slot once is enough, however far the wheel moves.
+    Entry * expired   = nullptr;
+    uint32_t numTicks = std::min(aNowTick - mCurrentTick, kNumSlots - 1);
+    for (uint32_t i = 0; i <= numTicks; i++)
+    {
+        Entry ** link = &mSlots[(mCurrentTick + i) % kNumSlots];
+        while (*link != nullptr)
+        {
+            Entry * entry = *link;
+            if (entry->mDeadline <= aNowTick)
+            {
+                *link         = entry->mpNext;
+                entry->mpNext = expired;
+                expired       = entry;
+                OnUnlinked(*entry);
+            }
+            else
+            {
+                link = &entry->mpNext;
+            }
+        }
+    }
+    mCurrentTick = aNowTick;
+
+    while (expired != nullptr)
+    {
+        Entry * entry = expired;
+        expired       = entry->mpNext;
+        entry->mpNext = nullptr;
+
+        if (entry->mPhase == Entry::Phase::kWaitingForMinInterval)
+        {
+            uint32_t maxIntervalTick = ChooseMaxIntervalTick(*entry);
+            entry->mPhase            = Entry::Phase::kWaitingForMaxInterval;
+            if (maxIntervalTick > mCurrentTick)
+            {
+                Insert(*entry, maxIntervalTick);
+                aDelegate.OnMinIntervalElapsed(*entry);
+                continue;
+            }
+            aDelegate.OnMinIntervalElapsed(*entry);
+        }
+
+        entry->mPhase = Entry::Phase::kIdle;
+        aDelegate.OnMaxIntervalElapsed(*entry);
+    }
+}
+
+bool SubscriptionTimingWheel::GetNextDeadline(uint32_t & aTick) const
+{
+    if (mNumEntries == 0)
+    {
+        return false;
+    }
+
+    if (!mIsNextDeadlineKnown)
+    {
+        // No deadline is behind the current tick, so the first slot holding a deadline of this turn of the wheel holds the
+        // earliest one. Deadlines of later turns seen on the way only matter if no such slot is found.
+        uint32_t nextDeadline = UINT32_MAX;
+        for (uint32_t i = 0; i < kNumSlots; i++)
+        {
+            uint32_t tick = mCurrentTick + i;
+            for (Entry * entry = mSlots[tick % kNumSlots]; entry != nullptr; entry = entry->mpNext)
+            {
+                nextDeadline = std::min(nextDeadline, entry->mDeadline);
+            }
+            if (nextDeadline == tick)
+            {
+                break;
+            }
+        }
+        mNextDeadline        = nextDeadline;
+        mIsNextDeadlineKnown = true;
+    }
+
+    aTick = mNextDeadline;
+    return true;
+}
+
+void SubscriptionTimingWheel::Insert(Entry & aEntry, uint32_t aTick)
+{
+    aEntry.mDeadline = std::max(aTick, mCurrentTick);
+
+    Entry *& slot = mSlots[aEntry.mDeadline % kNumSlots];
+    aEntry.mpNext = slot;
+    slot          = &aEntry;
+
+    if (mNumEntries++ == 0)
+    {
+        mNextDeadline        = aEntry.mDeadline;
+        mIsNextDeadlineKnown = true;
+    }
+    else if (mIsNextDeadlineKnown && aEntry.mDeadline < mNextDeadline)
+    {
+        mNextDeadline = aEntry.mDeadline;
+    }
+}
+
+void SubscriptionTimingWheel::OnUnlinked(const Entry & aEntry)
+{
+    mNumEntries--;
+    if (aEntry.mDeadline == mNextDeadline)
+    {
+        mIsNextDeadlineKnown = false;
+    }
+}
+
+uint32_t SubscriptionTimingWheel::ChooseMaxIntervalTick(const Entry & aEntry) const
+{
+    if (aEntry.mMaxIntervalTick <= mCurrentTick)
+    {
+        return aEntry.mMaxIntervalTick;
+    }
+
+    // Look for the latest tick at which the engine already has to run, preferring one at which a report is due for the same
+    // peer. Only the second half of the remaining window is searched, so that coalescing at most doubles the rate of reports,
+    // and no more than one turn of the wheel.
+    uint32_t numTicks  = std::min((aEntry.mMaxIntervalTick - mCurrentTick) / 2, kNumSlots - 1);
+    uint32_t busyTick  = aEntry.mMaxIntervalTick;
+    bool foundBusyTick = false;
+    for (uint32_t i = 0; i <= numTicks; i++)
+    {
+        uint32_t tick = aEntry.mMaxIntervalTick - i;
+        for (Entry * entry = mSlots[tick % kNumSlots]; entry != nullptr; entry = entry->mpNext)
+        {
+            if (entry->mDeadline != tick)
+            {
+                continue;
+            }
+            if (entry->mPhase == Entry::Phase::kWaitingForMaxInterval && entry->mPeerFabricIndex == aEntry.mPeerFabricIndex &&
+                entry->mPeerNodeId == aEntry.mPeerNodeId)
+            {
+                return tick;
+            }
+            if (!foundBusyTick)
+            {
+                busyTick      = tick;
+                foundBusyTick = true;
+            }
+        }
+    }
+    return busyTick;
+}
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
@@ -0,0 +1,149 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the timing wheel the reporting engine uses to track the
+ *      min and max intervals of all subscriptions with a single timer.
+ *
+ */
+
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/NodeId.h>
+
+#include <stdint.h>
+
+namespace chip {
+namespace app {
+namespace reporting {
+
+/*
+ *  @class SubscriptionTimingWheel
+ *
+ *  @brief Buckets subscriptions by the next tick at which they need attention: the end of their min interval, after which
+ * dirty data may be reported, and the end of their max interval, by which a report must be sent.
+ *
+ *         Ticks are absolute and supplied by the caller, which keeps one timer armed for GetNextDeadline(). When the min
+ * interval of a subscription ends, its max interval deadline is moved to the latest tick in the second half of its window at
+ * which a report is already due for the same peer, or failing that at which any other deadline falls, so that reports are
+ * coalesced into as few engine runs as possible.
+ */
+class SubscriptionTimingWheel
+{
+public:
+    class Entry
+    {
+    public:
+        bool IsScheduled() const { return mPhase != Phase::kIdle; }
+
+    private:
+        friend class SubscriptionTimingWheel;
+
+        enum class Phase : uint8_t
+        {
+            kIdle,
+            kWaitingForMinInterval,
+            kWaitingForMaxInterval,
+        };
+
+        Entry * mpNext               = nullptr;
+        uint32_t mDeadline           = 0;
+        uint32_t mMaxIntervalTick    = 0;
+        NodeId mPeerNodeId           = kUndefinedNodeId;
+        FabricIndex mPeerFabricIndex = kUndefinedFabricIndex;
+        Phase mPhase                 = Phase::kIdle;
+    };
+
+    class Delegate
+    {
+    public:
+        virtual ~Delegate() = default;
+
+        /**
+         * The min interval of the entry has elapsed. The entry stays scheduled until its max interval elapses.
+         */
+        virtual void OnMinIntervalElapsed(Entry & aEntry) = 0;
+
+        /**
+         * The max interval of the entry has elapsed, or was brought forward to coalesce with other reports. The entry is no
+         * longer scheduled.
+         */
+        virtual void OnMaxIntervalElapsed(Entry & aEntry) = 0;
+    };
+
+    /**
+     * Drop all the entries and restart the wheel at the given tick.
+     */
+    void Reset(uint32_t aNowTick);
+
+    /**
+     * Schedule an entry, replacing its previous deadlines if it was already scheduled.
+     *
+     * @param[in] aEntry            The entry to schedule.
+     * @param[in] aMinIntervalTick  The first tick at which a report may be sent.
+     * @param[in] aMaxIntervalTick  The tick by which a report must be sent.
+     * @param[in] aPeerFabricIndex  The fabric of the subscriber.
+     * @param[in] aPeerNodeId       The node id of the subscriber.
+     */
+    void Schedule(Entry & aEntry, uint32_t aMinIntervalTick, uint32_t aMaxIntervalTick, FabricIndex aPeerFabricIndex,
+                  NodeId aPeerNodeId);
+
+    /**
+     * Schedule an entry whose min interval has already elapsed, so that only its max interval deadline is tracked. The
+     * deadline may be brought forward to coalesce with other reports, as when a min interval elapses in Advance().
+     */
+    void ScheduleMaxInterval(Entry & aEntry, uint32_t aMaxIntervalTick, FabricIndex aPeerFabricIndex, NodeId aPeerNodeId);
+
+    void Cancel(Entry & aEntry);
+
+    /**
+     * Move the wheel to the given tick, notifying the delegate of every deadline reached on the way. The delegate must not
+     * cancel or schedule other entries from its callbacks.
+     */
+    void Advance(uint32_t aNowTick, Delegate & aDelegate);
+
+    /**
+     * Get the earliest deadline of all the scheduled entries. The deadline is cached, and only looked up again, scanning
+     * forward from the current tick, after the entry that held it is removed.
+     *
+     * @retval false if no entry is scheduled.
+     */
+    bool GetNextDeadline(uint32_t & aTick) const;
+
+    uint32_t GetCurrentTick() const { return mCurrentTick; }
+
+private:
+    static constexpr uint32_t kNumSlots = CHIP_IM_SUBSCRIPTION_WHEEL_SLOTS;
+
+    void Insert(Entry & aEntry, uint32_t aTick);
+    void OnUnlinked(const Entry & aEntry);
+    uint32_t ChooseMaxIntervalTick(const Entry & aEntry) const;
+
+    Entry * mSlots[kNumSlots]         = {};
+    uint32_t mCurrentTick             = 0;
+    uint32_t mNumEntries              = 0;
+    mutable uint32_t mNextDeadline    = 0;
+    mutable bool mIsNextDeadlineKnown = false;
+};
+
+} // namespace reporting
+} // namespace app
+} // namespace chip
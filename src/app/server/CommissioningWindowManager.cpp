@@ -21,6 +21,7 @@
 #include <lib/dnssd/Advertiser.h>
 #include <lib/support/CodeUtils.h>
 #include <platform/CHIPDeviceLayer.h>
+#include <protocols/secure_channel/PASEVerifierCache.h>
 
 namespace {
 
@@ -90,6 +91,9 @@ void CommissioningWindowManager::Cleanup()
 {
     Shutdown();
 
+    // The cached verifiers give the setup PIN code away, keep them no longer than the window is open.
+    PASEVerifierCache::Instance().Clear();
+
     // reset all advertising
     app::DnssdServer::Instance().StartServer(Dnssd::CommissioningMode::kDisabled);
 }
@@ -188,10 +192,17 @@ CHIP_ERROR CommissioningWindowManager::OpenCommissioningWindow()
         uint32_t pinCode;
         ReturnErrorOnFailure(DeviceLayer::ConfigurationMgr().GetSetupPinCode(pinCode));
 
-        ReturnErrorOnFailure(mPairingSession.WaitForPairing(
-            pinCode, kSpake2p_Iteration_Count,
-            ByteSpan(reinterpret_cast<const uint8_t *>(kSpake2pKeyExchangeSalt), strlen(kSpake2pKeyExchangeSalt)), keyID,
-            Optional<ReliableMessageProtocolConfig>::Value(gDefaultMRPConfig), this));
+        ByteSpan salt(reinterpret_cast<const uint8_t *>(kSpake2pKeyExchangeSalt), strlen(kSpake2pKeyExchangeSalt));
+        ReturnErrorOnFailure(mPairingSession.WaitForPairing(pinCode, kSpake2p_Iteration_Count, salt, keyID,
+                                                            Optional<ReliableMessageProtocolConfig>::Value(gDefaultMRPConfig),
+                                                            this));
+
+        // Derive the PASE verifier in the background while waiting for the PBKDF param request.
+        CHIP_ERROR err = PASEVerifierCache::Instance().Precompute(pinCode, kSpake2p_Iteration_Count, salt);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(AppServer, "Failed to precompute PASE verifier: %" CHIP_ERROR_FORMAT, err.Format());
+        }
 
         // reset all advertising, indicating we are in commissioningMode
         app::DnssdServer::Instance().StartServer(Dnssd::CommissioningMode::kEnabledBasic);
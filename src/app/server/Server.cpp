@@ -166,6 +166,12 @@ CHIP_ERROR Server::Init(AppDelegate * delegate, uint16_t secureServicePort, uint
     err = chip::app::InteractionModelEngine::GetInstance()->Init(&mExchangeMgr, nullptr);
     SuccessOrExit(err);
 
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    err = mSubscriptionResumptionStorage.Init(&mServerStorage);
+    SuccessOrExit(err);
+    chip::app::InteractionModelEngine::GetInstance()->SetSubscriptionResumptionStorage(&mSubscriptionResumptionStorage);
+#endif
+
 #if CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
     // Initialize event logging subsystem
     {
@@ -227,6 +233,12 @@ CHIP_ERROR Server::Init(AppDelegate * delegate, uint16_t secureServicePort, uint
     SuccessOrExit(err);
 
     err = mCASESessionManager.Init();
+    SuccessOrExit(err);
+
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    // Sessions can now be established with the subscribers of the subscriptions served before the restart.
+    chip::app::InteractionModelEngine::GetInstance()->ResumeSubscriptions(mCASESessionManager, mFabrics);
+#endif
 
 exit:
     if (err != CHIP_NO_ERROR)
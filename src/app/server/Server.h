@@ -20,6 +20,7 @@
 #include <app/CASEClientPool.h>
 #include <app/CASESessionManager.h>
 #include <app/OperationalDeviceProxyPool.h>
+#include <app/SubscriptionResumptionStorage.h>
 #include <app/server/AppDelegate.h>
 #include <app/server/CommissioningWindowManager.h>
 #include <credentials/FabricTable.h>
@@ -159,6 +160,9 @@ private:
     // (https://github.com/project-chip/connectedhomeip/issues/12174)
     TestPersistentStorageDelegate mGroupsStorage;
     Credentials::GroupDataProviderImpl mGroupsProvider;
+#if CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+    app::SubscriptionResumptionStorage mSubscriptionResumptionStorage;
+#endif
 
     // TODO @ceille: Maybe use OperationalServicePort and CommissionableServicePort
     uint16_t mSecuredServicePort;
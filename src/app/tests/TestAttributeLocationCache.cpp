@@ -0,0 +1,192 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/util/attribute-location-cache.h>
+#include <app/util/mock/Constants.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::Test;
+
+// Provided by the mock attribute storage
+extern uint16_t emberAfIndexFromEndpoint(EndpointId endpoint);
+
+namespace {
+
+constexpr size_t kCacheSize   = 4;
+constexpr uint8_t kServerMask = 0x40;
+constexpr uint8_t kClientMask = 0x80;
+
+struct MockMetadata
+{
+    AttributeId attributeId;
+};
+
+using Cache = app::AttributeLocationCache<MockMetadata, kCacheSize>;
+
+struct Attribute
+{
+    EndpointId endpoint;
+    ClusterId clusterId;
+    AttributeId attributeId;
+    uint8_t clusterMask;
+};
+
+MockMetadata sMetadata[2];
+uint8_t sStorage[8];
+
+// Endpoint indexes of the mock endpoints, which are all enabled unless disabled by a test.
+bool sEndpointDisabled[3];
+
+bool IsEndpointIndexEnabled(uint16_t index)
+{
+    return index >= ArraySize(sEndpointDisabled) || !sEndpointDisabled[index];
+}
+
+Attribute MakeAttribute(EndpointId endpoint, ClusterId cluster, AttributeId attribute, uint8_t mask = kServerMask)
+{
+    return Attribute{ endpoint, cluster, attribute, mask };
+}
+
+const Cache::Entry * Find(const Cache & cache, const Attribute & attribute)
+{
+    return cache.Find(attribute.endpoint, attribute.clusterId, attribute.attributeId, attribute.clusterMask,
+                      IsEndpointIndexEnabled);
+}
+
+void Store(Cache & cache, const Attribute & attribute, MockMetadata * metadata, uint8_t * location)
+{
+    cache.Store(attribute.endpoint, attribute.clusterId, attribute.attributeId, attribute.clusterMask,
+                emberAfIndexFromEndpoint(attribute.endpoint), metadata, location);
+}
+
+size_t SlotOf(const Attribute & attribute)
+{
+    return Cache::SlotOf(attribute.endpoint, attribute.clusterId, attribute.attributeId);
+}
+
+void TestHit(nlTestSuite * apSuite, void * apContext)
+{
+    Cache cache;
+    const Attribute attribute = MakeAttribute(kMockEndpoint1, MockClusterId(1), MockAttributeId(1));
+
+    NL_TEST_ASSERT(apSuite, Find(cache, attribute) == nullptr);
+
+    Store(cache, attribute, &sMetadata[0], &sStorage[2]);
+
+    const Cache::Entry * entry = Find(cache, attribute);
+    NL_TEST_ASSERT(apSuite, entry != nullptr);
+    NL_TEST_ASSERT(apSuite, entry != nullptr && entry->metadata == &sMetadata[0] && entry->location == &sStorage[2]);
+    NL_TEST_ASSERT(apSuite, entry != nullptr && entry->endpointIndex == emberAfIndexFromEndpoint(kMockEndpoint1));
+
+    // Every part of the search record must match
+    NL_TEST_ASSERT(apSuite, Find(cache, MakeAttribute(kMockEndpoint2, MockClusterId(1), MockAttributeId(1))) == nullptr);
+    NL_TEST_ASSERT(apSuite, Find(cache, MakeAttribute(kMockEndpoint1, MockClusterId(2), MockAttributeId(1))) == nullptr);
+    NL_TEST_ASSERT(apSuite, Find(cache, MakeAttribute(kMockEndpoint1, MockClusterId(1), MockAttributeId(2))) == nullptr);
+    NL_TEST_ASSERT(apSuite,
+                   Find(cache, MakeAttribute(kMockEndpoint1, MockClusterId(1), MockAttributeId(1), kClientMask)) == nullptr);
+}
+
+void TestCollision(nlTestSuite * apSuite, void * apContext)
+{
+    Cache cache;
+    const Attribute first = MakeAttribute(kMockEndpoint2, MockClusterId(2), MockAttributeId(1));
+
+    // Find another attribute of the same cluster cached in the same slot
+    Attribute second = first;
+    do
+    {
+        second.attributeId++;
+    } while (SlotOf(second) != SlotOf(first));
+
+    Store(cache, first, &sMetadata[0], &sStorage[0]);
+    Store(cache, second, &sMetadata[1], &sStorage[4]);
+
+    // The last attribute stored evicts the other one
+    NL_TEST_ASSERT(apSuite, Find(cache, first) == nullptr);
+    const Cache::Entry * entry = Find(cache, second);
+    NL_TEST_ASSERT(apSuite, entry != nullptr && entry->metadata == &sMetadata[1] && entry->location == &sStorage[4]);
+
+    Store(cache, first, &sMetadata[0], &sStorage[0]);
+    NL_TEST_ASSERT(apSuite, Find(cache, second) == nullptr);
+    entry = Find(cache, first);
+    NL_TEST_ASSERT(apSuite, entry != nullptr && entry->metadata == &sMetadata[0] && entry->location == &sStorage[0]);
+}
+
+void TestDisabledEndpoint(nlTestSuite * apSuite, void * apContext)
+{
+    Cache cache;
+    const Attribute attribute    = MakeAttribute(kMockEndpoint3, MockClusterId(3), MockAttributeId(2));
+    const uint16_t endpointIndex = emberAfIndexFromEndpoint(kMockEndpoint3);
+
+    NL_TEST_ASSERT(apSuite, endpointIndex < ArraySize(sEndpointDisabled));
+    Store(cache, attribute, &sMetadata[0], &sStorage[1]);
+
+    // A disabled endpoint is a miss, so that the caller searches the endpoints and finds it disabled too
+    sEndpointDisabled[endpointIndex] = true;
+    NL_TEST_ASSERT(apSuite, Find(cache, attribute) == nullptr);
+
+    // The entry is served again once the endpoint is enabled
+    sEndpointDisabled[endpointIndex] = false;
+    NL_TEST_ASSERT(apSuite, Find(cache, attribute) != nullptr);
+}
+
+void TestClear(nlTestSuite * apSuite, void * apContext)
+{
+    Cache cache;
+    const Attribute attributes[] = {
+        MakeAttribute(kMockEndpoint1, MockClusterId(1), MockAttributeId(1)),
+        MakeAttribute(kMockEndpoint2, MockClusterId(2), MockAttributeId(2)),
+        MakeAttribute(kMockEndpoint3, MockClusterId(3), MockAttributeId(3)),
+    };
+
+    for (const auto & attribute : attributes)
+    {
+        Store(cache, attribute, &sMetadata[0], &sStorage[0]);
+    }
+    NL_TEST_ASSERT(apSuite, Find(cache, attributes[ArraySize(attributes) - 1]) != nullptr);
+
+    // Configuring the endpoints again, as emberAfEndpointConfigure does, forgets every location
+    cache.Clear();
+    for (const auto & attribute : attributes)
+    {
+        NL_TEST_ASSERT(apSuite, Find(cache, attribute) == nullptr);
+    }
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("TestHit", TestHit),
+    NL_TEST_DEF("TestCollision", TestCollision),
+    NL_TEST_DEF("TestDisabledEndpoint", TestDisabledEndpoint),
+    NL_TEST_DEF("TestClear", TestClear),
+    NL_TEST_SENTINEL()
+};
+
+} // namespace
+
+int TestAttributeLocationCache()
+{
+    nlTestSuite theSuite = { "AttributeLocationCache", &sTests[0], nullptr, nullptr };
+
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestAttributeLocationCache)
@@ -0,0 +1,201 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the attribute report cache of the reporting engine.
+ *
+ */
+
+#include <app/AttributeAccessInterface.h>
+#include <app/MessageDef/AttributeReportIBs.h>
+#include <app/reporting/AttributeReportCache.h>
+#include <lib/core/CHIPTLV.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+
+#include <string.h>
+
+using namespace chip;
+using namespace chip::app;
+using namespace chip::app::reporting;
+
+namespace {
+
+#if CHIP_IM_REPORT_CACHE_SIZE > 0
+
+constexpr EndpointId kTestEndpointId   = 1;
+constexpr ClusterId kTestClusterId     = 6;
+constexpr AttributeId kTestAttributeId = 0;
+constexpr DataVersion kTestDataVersion = 3;
+constexpr FabricIndex kTestFabricIndex = 1;
+
+const ConcreteAttributePath kTestPath(kTestEndpointId, kTestClusterId, kTestAttributeId);
+
+// Encodes the reports of a boolean attribute the way the reporting engine does, in the available buffer of the cache.
+ByteSpan EncodeInCache(nlTestSuite * apSuite, AttributeReportCache & aCache, bool aValue)
+{
+    MutableByteSpan buffer = aCache.GetAvailableBuffer();
+    TLV::TLVWriter writer;
+    AttributeReportIBs::Builder reportIBs;
+
+    writer.Init(buffer);
+    NL_TEST_ASSERT(apSuite, reportIBs.Init(&writer) == CHIP_NO_ERROR);
+    uint32_t start = writer.GetLengthWritten();
+
+    AttributeValueEncoder encoder(reportIBs, kTestFabricIndex, kTestPath, kTestDataVersion);
+    NL_TEST_ASSERT(apSuite, encoder.Encode(aValue) == CHIP_NO_ERROR);
+
+    return ByteSpan(buffer.data() + start, writer.GetLengthWritten() - start);
+}
+
+void TestFind(nlTestSuite * apSuite, void * apContext)
+{
+    static AttributeReportCache cache;
+    ByteSpan found;
+
+    cache.Reset(true);
+    NL_TEST_ASSERT(apSuite, !cache.Find(kTestPath, kUndefinedFabricIndex, found));
+
+    ByteSpan encoded = EncodeInCache(apSuite, cache, true);
+    NL_TEST_ASSERT(apSuite, !encoded.empty());
+    NL_TEST_ASSERT(apSuite, cache.Add(kTestPath, kUndefinedFabricIndex, encoded) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(apSuite, cache.Find(kTestPath, kUndefinedFabricIndex, found));
+    NL_TEST_ASSERT(apSuite, found.data_equal(encoded));
+    NL_TEST_ASSERT(apSuite, !cache.Find(ConcreteAttributePath(kTestEndpointId, kTestClusterId, 1), kUndefinedFabricIndex, found));
+
+    // Entries encoded for a fabric are only found for that fabric.
+    const ConcreteAttributePath fabricScopedPath(kTestEndpointId, kTestClusterId, 2);
+    ByteSpan fabricEncoded = EncodeInCache(apSuite, cache, false);
+    NL_TEST_ASSERT(apSuite, cache.Add(fabricScopedPath, kTestFabricIndex, fabricEncoded) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, cache.Find(fabricScopedPath, kTestFabricIndex, found));
+    NL_TEST_ASSERT(apSuite, found.data_equal(fabricEncoded));
+    NL_TEST_ASSERT(apSuite, !cache.Find(fabricScopedPath, kTestFabricIndex + 1, found));
+    NL_TEST_ASSERT(apSuite, !cache.Find(fabricScopedPath, kUndefinedFabricIndex, found));
+
+    // The first entry is still intact.
+    NL_TEST_ASSERT(apSuite, cache.Find(kTestPath, kUndefinedFabricIndex, found));
+    NL_TEST_ASSERT(apSuite, found.data_equal(encoded));
+
+    cache.Reset(true);
+    NL_TEST_ASSERT(apSuite, !cache.Find(kTestPath, kUndefinedFabricIndex, found));
+}
+
+void TestCopyIntoReport(nlTestSuite * apSuite, void * apContext)
+{
+    static AttributeReportCache cache;
+    uint8_t directBuffer[128];
+    uint8_t copiedBuffer[128];
+    TLV::TLVWriter writer;
+    AttributeReportIBs::Builder reportIBs;
+
+    // The reports encoded directly into a message...
+    writer.Init(directBuffer);
+    NL_TEST_ASSERT(apSuite, reportIBs.Init(&writer) == CHIP_NO_ERROR);
+    AttributeValueEncoder encoder(reportIBs, kTestFabricIndex, kTestPath, kTestDataVersion);
+    NL_TEST_ASSERT(apSuite, encoder.Encode(true) == CHIP_NO_ERROR);
+    uint32_t directLength = writer.GetLengthWritten();
+
+    // ... are the same as the ones copied from the cache.
+    cache.Reset(true);
+    ByteSpan encoded = EncodeInCache(apSuite, cache, true);
+    NL_TEST_ASSERT(apSuite, cache.Add(kTestPath, kUndefinedFabricIndex, encoded) == CHIP_NO_ERROR);
+
+    writer.Init(copiedBuffer);
+    NL_TEST_ASSERT(apSuite, reportIBs.Init(&writer) == CHIP_NO_ERROR);
+
+    TLV::TLVReader reader;
+    CHIP_ERROR err;
+    reader.Init(encoded);
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        NL_TEST_ASSERT(apSuite, reportIBs.GetWriter()->CopyElement(reader) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(apSuite, err == CHIP_END_OF_TLV);
+    NL_TEST_ASSERT(apSuite, writer.GetLengthWritten() == directLength);
+    NL_TEST_ASSERT(apSuite, memcmp(directBuffer, copiedBuffer, directLength) == 0);
+}
+
+void TestCapacity(nlTestSuite * apSuite, void * apContext)
+{
+    static AttributeReportCache cache;
+    ByteSpan found;
+
+    cache.Reset(false);
+    NL_TEST_ASSERT(apSuite, cache.GetAvailableBuffer().empty());
+
+    cache.Reset(true);
+    NL_TEST_ASSERT(apSuite, cache.GetAvailableBuffer().size() == CHIP_IM_REPORT_CACHE_SIZE);
+
+    // Only data encoded in the available buffer can be added.
+    uint8_t outside[4] = {};
+    NL_TEST_ASSERT(apSuite, cache.Add(kTestPath, kUndefinedFabricIndex, ByteSpan(outside)) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    MutableByteSpan buffer = cache.GetAvailableBuffer();
+    NL_TEST_ASSERT(apSuite, cache.Add(kTestPath, kUndefinedFabricIndex, ByteSpan(buffer.data(), 4)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, cache.GetAvailableBuffer().size() == CHIP_IM_REPORT_CACHE_SIZE - 4);
+
+    cache.MarkFull();
+    NL_TEST_ASSERT(apSuite, cache.GetAvailableBuffer().empty());
+    NL_TEST_ASSERT(apSuite, cache.Find(kTestPath, kUndefinedFabricIndex, found));
+
+    // The number of entries is limited too.
+    cache.Reset(true);
+    for (AttributeId i = 0; i < CHIP_IM_REPORT_CACHE_MAX_ENTRIES; i++)
+    {
+        NL_TEST_ASSERT(apSuite,
+                       cache.Add(ConcreteAttributePath(kTestEndpointId, kTestClusterId, i), kUndefinedFabricIndex,
+                                 ByteSpan(cache.GetAvailableBuffer().data(), 0)) == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(apSuite, cache.GetAvailableBuffer().empty());
+}
+
+#else // CHIP_IM_REPORT_CACHE_SIZE > 0
+
+void TestCacheDisabled(nlTestSuite * apSuite, void * apContext)
+{
+    NL_TEST_ASSERT(apSuite, true);
+}
+
+#endif // CHIP_IM_REPORT_CACHE_SIZE > 0
+
+const nlTest sTests[] = {
+#if CHIP_IM_REPORT_CACHE_SIZE > 0
+    NL_TEST_DEF("TestFind", TestFind),
+    NL_TEST_DEF("TestCopyIntoReport", TestCopyIntoReport),
+    NL_TEST_DEF("TestCapacity", TestCapacity),
+#else
+    NL_TEST_DEF("TestCacheDisabled", TestCacheDisabled),
+#endif
+    NL_TEST_SENTINEL()
+};
+
+} // namespace
+
+int TestAttributeReportCache()
+{
+    nlTestSuite theSuite = { "AttributeReportCache", &sTests[0], nullptr, nullptr };
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestAttributeReportCache)
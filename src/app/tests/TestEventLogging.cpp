@@ -45,6 +45,7 @@ namespace {
 
 static const chip::NodeId kTestDeviceNodeId1      = 0x18B4300000000001ULL;
 static const chip::ClusterId kLivenessClusterId   = 0x00000022;
+static const chip::ClusterId kOtherClusterId      = 0x00000006;
 static const uint32_t kLivenessChangeEvent        = 1;
 static const chip::EndpointId kTestEndpointId1    = 2;
 static const chip::EndpointId kTestEndpointId2    = 3;
@@ -154,6 +155,20 @@ static void CheckLogReadOut(nlTestSuite * apSuite, chip::app::EventManagement &
     chip::TLV::Debug::Dump(reader, SimpleDumpWriter);
 }
 
+static void CheckNoEventReadOut(nlTestSuite * apSuite, chip::app::EventManagement & alogMgmt, chip::EventNumber startingEventNumber,
+                                chip::EventNumber expectedNextEventNumber, chip::app::ClusterInfo * clusterInfo)
+{
+    CHIP_ERROR err;
+    chip::TLV::TLVWriter writer;
+    size_t eventCount = 0;
+    uint8_t backingStore[1024];
+    writer.Init(backingStore, sizeof(backingStore));
+    err = alogMgmt.FetchEventsSince(writer, clusterInfo, startingEventNumber, eventCount);
+    NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, eventCount == 0 && writer.GetLengthWritten() == 0);
+    NL_TEST_ASSERT(apSuite, startingEventNumber == expectedNextEventNumber);
+}
+
 class TestEventGenerator : public chip::app::EventLoggingDelegate
 {
 public:
@@ -237,6 +252,13 @@ static void CheckLogEventWithEvictToNextBuffer(nlTestSuite * apSuite, void * apC
     CheckLogReadOut(apSuite, logMgmt, 3, 3, &testClusterInfo2);
     CheckLogReadOut(apSuite, logMgmt, 4, 2, &testClusterInfo2);
     CheckLogReadOut(apSuite, logMgmt, 5, 1, &testClusterInfo2);
+
+    // Skipped buffers, whether all their events were already fetched or are on other clusters, still advance the event number
+    chip::app::ClusterInfo testClusterInfo3;
+    testClusterInfo3.mNodeId    = kTestDeviceNodeId1;
+    testClusterInfo3.mClusterId = kOtherClusterId;
+    CheckNoEventReadOut(apSuite, logMgmt, 0, eid6 + 1, &testClusterInfo3);
+    CheckNoEventReadOut(apSuite, logMgmt, eid6 + 1, eid6 + 1, &testClusterInfo1);
 }
 
 static void CheckLogEventWithDiscardLowEvent(nlTestSuite * apSuite, void * apContext)
@@ -280,12 +302,126 @@ static void CheckLogEventWithDiscardLowEvent(nlTestSuite * apSuite, void * apCon
     NL_TEST_ASSERT(apSuite, err == CHIP_NO_ERROR);
     CheckLogState(apSuite, logMgmt, 3, chip::app::PriorityLevel::Debug);
 }
+static bool MayContainClusterEvents(chip::app::CircularEventBuffer & aBuffer, chip::ClusterId aClusterId)
+{
+    chip::app::ClusterInfo path;
+    path.mClusterId = aClusterId;
+    return aBuffer.MayContainEvents(0, &path);
+}
+
+static void CheckClusterFilterAfterEviction(nlTestSuite * apSuite, void * apContext)
+{
+    static const chip::ClusterId kThirdClusterId = 0x00000008;
+    uint8_t backingStore[64];
+    chip::app::CircularEventBuffer buffer;
+    chip::TLV::CircularTLVWriter writer;
+
+    // The filter is only consulted for a buffer holding data
+    buffer.Init(backingStore, sizeof(backingStore), nullptr, nullptr, chip::app::PriorityLevel::Debug);
+    writer.Init(buffer);
+    NL_TEST_ASSERT(apSuite, writer.Put(chip::TLV::AnonymousTag(), static_cast<uint8_t>(1)) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, writer.Finalize() == CHIP_NO_ERROR);
+
+    buffer.NoteEvent(1, kLivenessClusterId, backingStore);
+    buffer.NoteEvent(2, kOtherClusterId, backingStore);
+    NL_TEST_ASSERT(apSuite, MayContainClusterEvents(buffer, kLivenessClusterId));
+    NL_TEST_ASSERT(apSuite, MayContainClusterEvents(buffer, kOtherClusterId));
+    NL_TEST_ASSERT(apSuite, !MayContainClusterEvents(buffer, kThirdClusterId));
+
+    // Event 2 is still buffered, so its generation is kept
+    buffer.NoteEventEvicted(1);
+    buffer.NoteEvent(3, kThirdClusterId, backingStore);
+    NL_TEST_ASSERT(apSuite, MayContainClusterEvents(buffer, kOtherClusterId));
+    NL_TEST_ASSERT(apSuite, MayContainClusterEvents(buffer, kThirdClusterId));
+
+    // Once every event of that generation is gone, its clusters stop matching
+    buffer.NoteEventEvicted(2);
+    NL_TEST_ASSERT(apSuite, !MayContainClusterEvents(buffer, kLivenessClusterId));
+    NL_TEST_ASSERT(apSuite, !MayContainClusterEvents(buffer, kOtherClusterId));
+    NL_TEST_ASSERT(apSuite, MayContainClusterEvents(buffer, kThirdClusterId));
+}
+
+static void AppendNumberedEvent(nlTestSuite * apSuite, chip::app::CircularEventBuffer & aBuffer, uint8_t aEventNumber)
+{
+    chip::TLV::CircularTLVWriter writer;
+    const uint8_t * eventStart;
+
+    // Each test event is its own number, evict the oldest ones to make room
+    while (aBuffer.AvailableDataLength() < 2)
+    {
+        chip::TLV::CircularTLVReader reader;
+        uint8_t evicted = 0;
+        reader.Init(aBuffer);
+        NL_TEST_ASSERT(apSuite, reader.Next() == CHIP_NO_ERROR && reader.Get(evicted) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, aBuffer.EvictHead() == CHIP_NO_ERROR);
+        aBuffer.NoteEventEvicted(evicted);
+    }
+
+    writer.Init(aBuffer);
+    eventStart = aBuffer.QueueTail();
+    NL_TEST_ASSERT(apSuite, writer.Put(chip::TLV::AnonymousTag(), aEventNumber) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, writer.Finalize() == CHIP_NO_ERROR);
+    aBuffer.NoteEvent(aEventNumber, kLivenessClusterId, eventStart);
+}
+
+static void CheckReadFromEventStart(nlTestSuite * apSuite, chip::app::CircularEventBuffer & aBuffer, chip::EventNumber aEventMin,
+                                    chip::EventNumber aLastEventNumber)
+{
+    chip::app::CircularEventBufferWrapper bufWrapper;
+    chip::TLV::TLVReader reader;
+    chip::EventNumber expected = 0;
+    uint8_t eventNumber;
+
+    bufWrapper.mpCurrent = &aBuffer;
+    bufWrapper.mpStart   = aBuffer.FindEventStart(aEventMin, expected);
+    NL_TEST_ASSERT(apSuite, bufWrapper.mpStart != nullptr);
+    NL_TEST_ASSERT(apSuite, expected <= aEventMin && aEventMin - expected < 4);
+
+    // Reading from the indexed event goes through every newer event, across the end of the storage too
+    reader.Init(bufWrapper, aBuffer.DataLength());
+    while (reader.Next() == CHIP_NO_ERROR)
+    {
+        NL_TEST_ASSERT(apSuite, reader.Get(eventNumber) == CHIP_NO_ERROR && eventNumber == expected);
+        expected++;
+    }
+    NL_TEST_ASSERT(apSuite, expected == aLastEventNumber + 1);
+}
+
+static void CheckEventOffsetIndex(nlTestSuite * apSuite, void * apContext)
+{
+    uint8_t backingStore[64];
+    chip::app::CircularEventBuffer buffer;
+    chip::EventNumber eventNumber = 0;
+
+    buffer.Init(backingStore, sizeof(backingStore), nullptr, nullptr, chip::app::PriorityLevel::Debug);
+    for (uint8_t i = 1; i <= 10; i++)
+    {
+        AppendNumberedEvent(apSuite, buffer, i);
+    }
+
+    // Checkpoints are spaced by an eighth of the storage, i.e. every fourth 2 byte event
+    NL_TEST_ASSERT(apSuite, buffer.FindEventStart(0, eventNumber) == nullptr);
+    NL_TEST_ASSERT(apSuite, buffer.FindEventStart(7, eventNumber) == backingStore + 8 && eventNumber == 5);
+    CheckReadFromEventStart(apSuite, buffer, 7, 10);
+
+    // Once the buffer wraps around, evicted events are no longer indexed
+    for (uint8_t i = 11; i <= 40; i++)
+    {
+        AppendNumberedEvent(apSuite, buffer, i);
+    }
+    NL_TEST_ASSERT(apSuite, buffer.FindEventStart(8, eventNumber) == nullptr);
+    CheckReadFromEventStart(apSuite, buffer, 12, 40);
+    CheckReadFromEventStart(apSuite, buffer, 30, 40);
+}
+
 /**
  *   Test Suite. It lists all the test functions.
  */
 
 const nlTest sTests[] = { NL_TEST_DEF("CheckLogEventWithEvictToNextBuffer", CheckLogEventWithEvictToNextBuffer),
-                          NL_TEST_DEF("CheckLogEventWithDiscardLowEvent", CheckLogEventWithDiscardLowEvent), NL_TEST_SENTINEL() };
+                          NL_TEST_DEF("CheckLogEventWithDiscardLowEvent", CheckLogEventWithDiscardLowEvent),
+                          NL_TEST_DEF("CheckClusterFilterAfterEviction", CheckClusterFilterAfterEviction),
+                          NL_TEST_DEF("CheckEventOffsetIndex", CheckEventOffsetIndex), NL_TEST_SENTINEL() };
 
 // clang-format off
 nlTestSuite sSuite =
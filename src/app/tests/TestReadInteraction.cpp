@@ -238,6 +238,7 @@ public:
     static void TestSubscribeRoundtrip(nlTestSuite * apSuite, void * apContext);
     static void TestSubscribeWildcard(nlTestSuite * apSuite, void * apContext);
     static void TestSubscribeEarlyShutdown(nlTestSuite * apSuite, void * apContext);
+    static void TestSubscribeResume(nlTestSuite * apSuite, void * apContext);
     static void TestSubscribeInvalidAttributePathRoundtrip(nlTestSuite * apSuite, void * apContext);
     static void TestReadInvalidAttributePathRoundtrip(nlTestSuite * apSuite, void * apContext);
     static void TestSubscribeInvalidIterval(nlTestSuite * apSuite, void * apContext);
@@ -1293,6 +1294,92 @@ void TestReadInteraction::TestSubscribeEarlyShutdown(nlTestSuite * apSuite, void
     engine.Shutdown();
 }
 
+void TestReadInteraction::TestSubscribeResume(nlTestSuite * apSuite, void * apContext)
+{
+    TestContext & ctx                  = *static_cast<TestContext *>(apContext);
+    Messaging::ReliableMessageMgr * rm = ctx.GetExchangeManager().GetReliableMessageMgr();
+    InteractionModelEngine & engine    = *InteractionModelEngine::GetInstance();
+    MockInteractionModelApp delegate;
+
+    // Initialize Interaction Model Engine
+    NL_TEST_ASSERT(apSuite, rm->TestGetCountRetransTable() == 0);
+    NL_TEST_ASSERT(apSuite, engine.Init(&ctx.GetExchangeManager(), &delegate) == CHIP_NO_ERROR);
+
+    // Subscribe to two attributes
+    AttributePathParams attributePathParams[2];
+    attributePathParams[0].mEndpointId  = kTestEndpointId;
+    attributePathParams[0].mClusterId   = kTestClusterId;
+    attributePathParams[0].mAttributeId = 1;
+    attributePathParams[1].mEndpointId  = kTestEndpointId;
+    attributePathParams[1].mClusterId   = kTestClusterId;
+    attributePathParams[1].mAttributeId = 2;
+
+    ReadPrepareParams readPrepareParams(ctx.GetSessionBobToAlice());
+    readPrepareParams.mpAttributePathParamsList    = attributePathParams;
+    readPrepareParams.mAttributePathParamsListSize = 2;
+    readPrepareParams.mMinIntervalFloorSeconds     = 2;
+    readPrepareParams.mMaxIntervalCeilingSeconds   = 5;
+    readPrepareParams.mKeepSubscriptions           = false;
+
+    {
+        app::ReadClient readClient(chip::app::InteractionModelEngine::GetInstance(), &ctx.GetExchangeManager(), delegate,
+                                   chip::app::ReadClient::InteractionType::Subscribe);
+
+        NL_TEST_ASSERT(apSuite, readClient.SendRequest(readPrepareParams) == CHIP_NO_ERROR);
+
+        engine.GetReportingEngine().Run();
+        NL_TEST_ASSERT(apSuite, delegate.mNumAttributeResponse == 2);
+        NL_TEST_ASSERT(apSuite, delegate.mNumSubscriptions == 1);
+        NL_TEST_ASSERT(apSuite, delegate.mpReadHandler != nullptr);
+
+        // Save the subscription the way it is persisted, then drop the read handler as a restart of the server would.
+        ReadHandler * readHandler = delegate.mpReadHandler;
+        SubscriptionResumptionStorage::SubscriptionInfo info;
+        info.mNodeId                    = readHandler->mInitiatorNodeId;
+        info.mFabricIndex               = readHandler->GetAccessingFabricIndex();
+        info.mSubscriptionId            = readHandler->mSubscriptionId;
+        info.mMinIntervalFloorSeconds   = readHandler->mMinIntervalFloorSeconds;
+        info.mMaxIntervalCeilingSeconds = readHandler->mMaxIntervalCeilingSeconds;
+        for (ClusterInfo * path = readHandler->mpAttributeClusterInfoList; path != nullptr; path = path->mpNext)
+        {
+            info.mAttributePaths[info.mAttributePathCount++] = *path;
+        }
+        NL_TEST_ASSERT(apSuite, info.mAttributePathCount == 2);
+
+        readHandler->Shutdown();
+        NL_TEST_ASSERT(apSuite, readHandler->IsFree());
+        NL_TEST_ASSERT(apSuite, delegate.mNumSubscriptions == 0);
+
+        // Resume the subscription in the same handler. Nothing was marked dirty, but the subscriber may have missed changes
+        // while the subscription was down, so the first report carries every attribute.
+        delegate.mGotReport            = false;
+        delegate.mNumAttributeResponse = 0;
+        NL_TEST_ASSERT(apSuite, readHandler->RestoreSubscription(&ctx.GetExchangeManager(), &delegate, info) == CHIP_NO_ERROR);
+        readHandler->OnResumedSession(ctx.GetSessionAliceToBob());
+        NL_TEST_ASSERT(apSuite, delegate.mNumSubscriptions == 1);
+        NL_TEST_ASSERT(apSuite, readHandler->IsReportable());
+
+        engine.GetReportingEngine().Run();
+        NL_TEST_ASSERT(apSuite, delegate.mGotReport);
+        NL_TEST_ASSERT(apSuite, delegate.mNumAttributeResponse == 2);
+        NL_TEST_ASSERT(apSuite, !delegate.mReadError);
+        NL_TEST_ASSERT(apSuite, readHandler->IsGeneratingReports());
+
+        // Later reports only carry what changed again.
+        readHandler->mHoldSync         = false;
+        delegate.mGotReport            = false;
+        delegate.mNumAttributeResponse = 0;
+        engine.GetReportingEngine().Run();
+        NL_TEST_ASSERT(apSuite, delegate.mNumAttributeResponse == 0);
+        NL_TEST_ASSERT(apSuite, !delegate.mReadError);
+    }
+
+    // Cleanup
+    NL_TEST_ASSERT(apSuite, engine.GetNumActiveReadClients() == 0);
+    NL_TEST_ASSERT(apSuite, rm->TestGetCountRetransTable() == 0);
+    engine.Shutdown();
+}
+
 void TestReadInteraction::TestSubscribeInvalidAttributePathRoundtrip(nlTestSuite * apSuite, void * apContext)
 {
     TestContext & ctx = *static_cast<TestContext *>(apContext);
@@ -1451,6 +1538,7 @@ const nlTest sTests[] =
     NL_TEST_DEF("TestSubscribeRoundtrip", chip::app::TestReadInteraction::TestSubscribeRoundtrip),
     NL_TEST_DEF("TestSubscribeWildcard", chip::app::TestReadInteraction::TestSubscribeWildcard),
     NL_TEST_DEF("TestSubscribeEarlyShutdown", chip::app::TestReadInteraction::TestSubscribeEarlyShutdown),
+    NL_TEST_DEF("TestSubscribeResume", chip::app::TestReadInteraction::TestSubscribeResume),
     NL_TEST_DEF("TestSubscribeInvalidAttributePathRoundtrip", chip::app::TestReadInteraction::TestSubscribeInvalidAttributePathRoundtrip),
     NL_TEST_DEF("TestReadInvalidAttributePathRoundtrip", chip::app::TestReadInteraction::TestReadInvalidAttributePathRoundtrip),
     NL_TEST_DEF("TestSubscribeInvalidIterval", chip::app::TestReadInteraction::TestSubscribeInvalidIterval),
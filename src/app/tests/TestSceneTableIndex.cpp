@@ -0,0 +1,228 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/clusters/scenes/SceneTableIndex.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::app::Clusters::Scenes;
+
+namespace {
+
+constexpr uint8_t kTableSize = 8;
+
+using Index = SceneTableIndex<kTableSize>;
+
+// Scene table as stored, with kUnusedEndpoint marking the entries not in use.
+constexpr EndpointId kUnusedEndpoint = 0xFFFF;
+
+struct StoredScene
+{
+    EndpointId endpoint;
+    GroupId groupId;
+    uint8_t sceneId;
+};
+
+struct FakeStorage
+{
+    StoredScene scenes[kTableSize];
+    uint8_t readCount = 0;
+
+    FakeStorage()
+    {
+        for (auto & scene : scenes)
+        {
+            scene = { kUnusedEndpoint, 0, 0 };
+        }
+    }
+
+    void Rebuild(Index & index)
+    {
+        index.Rebuild([this](uint8_t i, Index::Entry & entry) {
+            readCount++;
+            entry.endpoint = scenes[i].endpoint;
+            entry.groupId  = scenes[i].groupId;
+            entry.sceneId  = scenes[i].sceneId;
+            return scenes[i].endpoint != kUnusedEndpoint;
+        });
+    }
+};
+
+void TestAddAndFind(nlTestSuite * apSuite, void * apContext)
+{
+    Index index;
+
+    NL_TEST_ASSERT(apSuite, index.Count() == 0);
+    NL_TEST_ASSERT(apSuite, index.Find(1, 1, 1) == Index::kNotFound);
+
+    // Added out of order, kept sorted by endpoint, group id and scene id.
+    index.Add(2, 1, 1, 0);
+    index.Add(1, 2, 1, 1);
+    index.Add(1, 1, 2, 2);
+    index.Add(1, 1, 1, 3);
+
+    NL_TEST_ASSERT(apSuite, index.Count() == 4);
+    NL_TEST_ASSERT(apSuite, index.Find(1, 1, 1) == 0 && index.At(0).index == 3);
+    NL_TEST_ASSERT(apSuite, index.Find(1, 1, 2) == 1 && index.At(1).index == 2);
+    NL_TEST_ASSERT(apSuite, index.Find(1, 2, 1) == 2 && index.At(2).index == 1);
+    NL_TEST_ASSERT(apSuite, index.Find(2, 1, 1) == 3 && index.At(3).index == 0);
+
+    NL_TEST_ASSERT(apSuite, index.Find(1, 1, 3) == Index::kNotFound);
+    NL_TEST_ASSERT(apSuite, index.Find(2, 2, 1) == Index::kNotFound);
+    NL_TEST_ASSERT(apSuite, index.Find(3, 1, 1) == Index::kNotFound);
+
+    NL_TEST_ASSERT(apSuite, index.CountForEndpoint(1) == 3);
+    NL_TEST_ASSERT(apSuite, index.CountForEndpoint(2) == 1);
+    NL_TEST_ASSERT(apSuite, index.CountForEndpoint(3) == 0);
+}
+
+void TestGroupLookup(nlTestSuite * apSuite, void * apContext)
+{
+    Index index;
+
+    index.Add(1, 5, 3, 0);
+    index.Add(1, 4, 1, 1);
+    index.Add(1, 5, 1, 2);
+    index.Add(1, 6, 1, 3);
+    index.Add(2, 5, 2, 4);
+
+    // The scenes of a group are contiguous, in scene id order.
+    uint8_t sceneIds[kTableSize];
+    uint8_t count = 0;
+    for (uint8_t position = index.LowerBound(1, 5, 0); index.InGroup(position, 1, 5); position++)
+    {
+        sceneIds[count++] = index.At(position).sceneId;
+    }
+    NL_TEST_ASSERT(apSuite, count == 2);
+    NL_TEST_ASSERT(apSuite, sceneIds[0] == 1 && sceneIds[1] == 3);
+
+    NL_TEST_ASSERT(apSuite, !index.InGroup(index.LowerBound(1, 7, 0), 1, 7));
+    NL_TEST_ASSERT(apSuite, !index.InGroup(index.Count(), 2, 5));
+}
+
+void TestRemove(nlTestSuite * apSuite, void * apContext)
+{
+    Index index;
+
+    index.Add(1, 1, 1, 0);
+    index.Add(1, 1, 2, 1);
+    index.Add(1, 2, 1, 2);
+
+    index.Remove(index.Find(1, 1, 2));
+    NL_TEST_ASSERT(apSuite, index.Count() == 2);
+    NL_TEST_ASSERT(apSuite, index.Find(1, 1, 2) == Index::kNotFound);
+    NL_TEST_ASSERT(apSuite, index.At(index.Find(1, 1, 1)).index == 0);
+    NL_TEST_ASSERT(apSuite, index.At(index.Find(1, 2, 1)).index == 2);
+
+    // The freed table entry is the first one handed out again.
+    NL_TEST_ASSERT(apSuite, index.FindUnusedIndex() == 1);
+
+    // Removing all the scenes of a group the way the cluster does.
+    index.Add(1, 1, 5, 1);
+    uint8_t position = index.LowerBound(1, 1, 0);
+    while (index.InGroup(position, 1, 1))
+    {
+        index.Remove(position);
+    }
+    NL_TEST_ASSERT(apSuite, index.Count() == 1);
+    NL_TEST_ASSERT(apSuite, index.Find(1, 2, 1) == 0);
+}
+
+void TestFindUnusedIndex(nlTestSuite * apSuite, void * apContext)
+{
+    Index index;
+
+    for (uint8_t i = 0; i < kTableSize; i++)
+    {
+        NL_TEST_ASSERT(apSuite, index.FindUnusedIndex() == i);
+        index.Add(1, 1, i, i);
+    }
+    NL_TEST_ASSERT(apSuite, index.Count() == kTableSize);
+    NL_TEST_ASSERT(apSuite, index.FindUnusedIndex() == Index::kNotFound);
+
+    // A full index ignores further entries.
+    index.Add(1, 1, kTableSize, 0);
+    NL_TEST_ASSERT(apSuite, index.Count() == kTableSize);
+    NL_TEST_ASSERT(apSuite, index.Find(1, 1, kTableSize) == Index::kNotFound);
+
+    index.Remove(index.Find(1, 1, 5));
+
+    // So does an entry outside of the table.
+    index.Add(1, 1, 5, kTableSize);
+    NL_TEST_ASSERT(apSuite, index.Count() == kTableSize - 1);
+    NL_TEST_ASSERT(apSuite, index.Find(1, 1, 5) == Index::kNotFound);
+    NL_TEST_ASSERT(apSuite, index.FindUnusedIndex() == 5);
+}
+
+void TestRebuildFromStorage(nlTestSuite * apSuite, void * apContext)
+{
+    Index index;
+    FakeStorage storage;
+
+    storage.scenes[1] = { 3, 1, 7 };
+    storage.scenes[4] = { 1, 2, 1 };
+    storage.scenes[6] = { 1, 1, 9 };
+
+    NL_TEST_ASSERT(apSuite, !index.IsValid());
+    storage.Rebuild(index);
+    NL_TEST_ASSERT(apSuite, index.IsValid());
+    NL_TEST_ASSERT(apSuite, storage.readCount == kTableSize);
+    NL_TEST_ASSERT(apSuite, index.Count() == 3);
+    NL_TEST_ASSERT(apSuite, index.Find(1, 1, 9) == 0 && index.At(0).index == 6);
+    NL_TEST_ASSERT(apSuite, index.Find(1, 2, 1) == 1 && index.At(1).index == 4);
+    NL_TEST_ASSERT(apSuite, index.Find(3, 1, 7) == 2 && index.At(2).index == 1);
+    NL_TEST_ASSERT(apSuite, index.FindUnusedIndex() == 0);
+
+    // A valid index does not read the table again.
+    storage.Rebuild(index);
+    NL_TEST_ASSERT(apSuite, storage.readCount == kTableSize);
+
+    // Once invalidated, the index is rebuilt from what storage holds now.
+    storage.scenes[1] = { kUnusedEndpoint, 0, 0 };
+    storage.scenes[0] = { 2, 1, 1 };
+    index.Invalidate();
+    storage.Rebuild(index);
+    NL_TEST_ASSERT(apSuite, storage.readCount == 2 * kTableSize);
+    NL_TEST_ASSERT(apSuite, index.Count() == 3);
+    NL_TEST_ASSERT(apSuite, index.Find(3, 1, 7) == Index::kNotFound);
+    NL_TEST_ASSERT(apSuite, index.At(index.Find(2, 1, 1)).index == 0);
+    NL_TEST_ASSERT(apSuite, index.FindUnusedIndex() == 1);
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("TestAddAndFind", TestAddAndFind),
+    NL_TEST_DEF("TestGroupLookup", TestGroupLookup),
+    NL_TEST_DEF("TestRemove", TestRemove),
+    NL_TEST_DEF("TestFindUnusedIndex", TestFindUnusedIndex),
+    NL_TEST_DEF("TestRebuildFromStorage", TestRebuildFromStorage),
+    NL_TEST_SENTINEL()
+};
+
+} // namespace
+
+int TestSceneTableIndex()
+{
+    nlTestSuite theSuite = { "SceneTableIndex", &sTests[0], nullptr, nullptr };
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestSceneTableIndex)
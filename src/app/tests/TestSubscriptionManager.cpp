@@ -0,0 +1,430 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the client subscription manager.
+ *
+ */
+
+#include <app/CASEClientPool.h>
+#include <app/CASESessionManager.h>
+#include <app/InteractionModelEngine.h>
+#include <app/SubscriptionManager.h>
+#include <app/tests/AppTestContext.h>
+#include <credentials/FabricTable.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+#include <protocols/secure_channel/SessionIDAllocator.h>
+
+namespace chip {
+namespace app {
+
+namespace {
+
+using TestContext = Test::AppContext;
+
+constexpr FabricIndex kTestFabricIndex = 1;
+constexpr NodeId kTestNodeId           = 0x1234;
+constexpr NodeId kOtherNodeId          = 0x5678;
+constexpr uint32_t kMinRetryDelayMs    = CHIP_IM_SUBSCRIPTION_MANAGER_MIN_RETRY_DELAY_MS;
+constexpr uint32_t kMaxRetryDelayMs    = CHIP_IM_SUBSCRIPTION_MANAGER_MAX_RETRY_DELAY_MS;
+constexpr uint32_t kMaxAttempts        = CHIP_IM_SUBSCRIPTION_MANAGER_MAX_CONCURRENT_RESUBSCRIBES;
+constexpr uint32_t kMaxSessionSetups   = CHIP_IM_SUBSCRIPTION_MANAGER_MAX_CONCURRENT_SESSION_SETUPS;
+
+// An attribute the read handlers of the loopback peer report, see ReadSingleClusterData in TestReadInteraction.cpp.
+constexpr EndpointId kTestEndpointId   = 1;
+constexpr ClusterId kTestClusterId     = 6;
+constexpr AttributeId kTestAttributeId = 1;
+
+class TestCallback : public ReadClient::Callback
+{
+public:
+    void OnAttributeData(const ReadClient * apReadClient, const ConcreteDataAttributePath & aPath, TLV::TLVReader * apData,
+                         const StatusIB & aStatus) override
+    {
+        mNumAttributeData++;
+        if (mpRemoveOnData != nullptr)
+        {
+            mpManager->RemoveSubscription(mpRemoveOnData);
+            mpRemoveOnData = nullptr;
+        }
+    }
+    void OnReportEnd(const ReadClient * apReadClient) override { mNumReportEnd++; }
+    void OnSubscriptionEstablished(const ReadClient * apReadClient) override { mNumEstablished++; }
+    void OnError(const ReadClient * apReadClient, CHIP_ERROR aError) override
+    {
+        mNumErrors++;
+        mLastError = aError;
+    }
+    void OnDone(ReadClient * apReadClient) override {}
+
+    uint32_t mNumAttributeData = 0;
+    uint32_t mNumReportEnd     = 0;
+    uint32_t mNumEstablished   = 0;
+    uint32_t mNumErrors        = 0;
+    CHIP_ERROR mLastError      = CHIP_NO_ERROR;
+
+    // When set, the subscription is removed from within the first attribute data callback.
+    SubscriptionManager * mpManager                    = nullptr;
+    SubscriptionManager::Subscription * mpRemoveOnData = nullptr;
+};
+
+/**
+ * Subscription manager whose sessions are provided by the test, rather than established with CASE: every session request
+ * is recorded, in order, until the test completes it with a session of the loopback context.
+ */
+class LoopbackSubscriptionManager : public SubscriptionManager
+{
+public:
+    static constexpr uint32_t kMaxSessionRequests = 2 * CHIP_IM_SUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS;
+
+    explicit LoopbackSubscriptionManager(TestContext & aContext) :
+        mCASESessionManager(MakeCASESessionManagerConfig(aContext, mIdAllocator, mCASEClientPool, mpFabricTable))
+    {}
+
+    CHIP_ERROR Init(TestContext & aContext)
+    {
+        return SubscriptionManager::Init(&aContext.GetExchangeManager(), &mCASESessionManager, mpFabricTable);
+    }
+
+    ~LoopbackSubscriptionManager() override
+    {
+        Shutdown();
+        Platform::Delete(mpFabricTable);
+    }
+
+    Subscription * mSessionRequests[kMaxSessionRequests];
+    uint32_t mNumSessionRequests = 0;
+
+protected:
+    CHIP_ERROR EstablishSession(Subscription & aSubscription) override
+    {
+        VerifyOrReturnError(mNumSessionRequests < kMaxSessionRequests, CHIP_ERROR_NO_MEMORY);
+        mSessionRequests[mNumSessionRequests++] = &aSubscription;
+        return CHIP_NO_ERROR;
+    }
+
+private:
+    // Only needed to initialize the manager, since EstablishSession does not use CASE.
+    static CASESessionManagerConfig MakeCASESessionManagerConfig(TestContext & aContext, SessionIDAllocator & aIdAllocator,
+                                                                 CASEClientPoolDelegate & aClientPool, FabricTable * apFabricTable)
+    {
+        CASESessionManagerConfig config;
+        config.sessionInitParams.sessionManager = &aContext.GetSecureSessionManager();
+        config.sessionInitParams.exchangeMgr    = &aContext.GetExchangeManager();
+        config.sessionInitParams.idAllocator    = &aIdAllocator;
+        config.sessionInitParams.fabricTable    = apFabricTable;
+        config.sessionInitParams.clientPool     = &aClientPool;
+        return config;
+    }
+
+    SessionIDAllocator mIdAllocator;
+    CASEClientPool<1> mCASEClientPool;
+    // Heap-allocate the fairly large FabricTable so we don't end up with a huge stack.
+    FabricTable * mpFabricTable = Platform::New<FabricTable>();
+    CASESessionManager mCASESessionManager;
+};
+
+} // namespace
+
+class TestSubscriptionManager
+{
+public:
+    static void TestRetryDelay(nlTestSuite * apSuite, void * apContext)
+    {
+        // The first retry waits between half and all of the minimum delay.
+        NL_TEST_ASSERT(apSuite, SubscriptionManager::ComputeRetryDelay(1, 0).count() == kMinRetryDelayMs - kMinRetryDelayMs / 2);
+        NL_TEST_ASSERT(apSuite, SubscriptionManager::ComputeRetryDelay(1, kMinRetryDelayMs / 2).count() == kMinRetryDelayMs);
+
+        // The window doubles with each failure.
+        NL_TEST_ASSERT(apSuite, SubscriptionManager::ComputeRetryDelay(2, 0).count() == kMinRetryDelayMs);
+        NL_TEST_ASSERT(apSuite, SubscriptionManager::ComputeRetryDelay(2, kMinRetryDelayMs).count() == 2 * kMinRetryDelayMs);
+
+        // Whatever the random number, the delay stays in the window, which never grows past the maximum.
+        for (uint8_t failures = 1; failures < UINT8_MAX; failures++)
+        {
+            for (uint32_t random : { 0u, 12345u, UINT32_MAX })
+            {
+                uint32_t delayMs = SubscriptionManager::ComputeRetryDelay(failures, random).count();
+                NL_TEST_ASSERT(apSuite, delayMs >= kMinRetryDelayMs / 2);
+                NL_TEST_ASSERT(apSuite, delayMs <= kMaxRetryDelayMs);
+            }
+        }
+        NL_TEST_ASSERT(apSuite,
+                       SubscriptionManager::ComputeRetryDelay(UINT8_MAX, 0).count() == kMaxRetryDelayMs - kMaxRetryDelayMs / 2);
+    }
+
+    static void TestNodeHealth(nlTestSuite * apSuite, void * apContext)
+    {
+        SubscriptionManager manager;
+        TestCallback callback;
+        SubscriptionManager::NodeHealth health;
+
+        SubscriptionManager::SubscribeParams params;
+        params.mFabricIndex = kTestFabricIndex;
+        params.mNodeId      = kTestNodeId;
+
+        NL_TEST_ASSERT(apSuite, manager.GetNodeHealth(kTestFabricIndex, kTestNodeId, health) == CHIP_ERROR_NOT_FOUND);
+
+        SubscriptionManager::Subscription * active = manager.mSubscriptions.CreateObject(manager, params, callback);
+        active->mState                             = SubscriptionManager::Subscription::State::kActive;
+        active->mLastReportTime                    = System::Clock::Timestamp(200);
+
+        SubscriptionManager::Subscription * failing = manager.mSubscriptions.CreateObject(manager, params, callback);
+        failing->mState                             = SubscriptionManager::Subscription::State::kWaitingToRetry;
+        failing->mConsecutiveFailures               = 3;
+        failing->mLastReportTime                    = System::Clock::Timestamp(100);
+
+        params.mNodeId = kOtherNodeId;
+        manager.mSubscriptions.CreateObject(manager, params, callback);
+
+        NL_TEST_ASSERT(apSuite, manager.GetNodeHealth(kTestFabricIndex, kTestNodeId, health) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, health.mSubscriptionCount == 2);
+        NL_TEST_ASSERT(apSuite, health.mActiveSubscriptionCount == 1);
+        NL_TEST_ASSERT(apSuite, health.mMaxConsecutiveFailures == 3);
+        NL_TEST_ASSERT(apSuite, health.mLastReportTime == System::Clock::Timestamp(200));
+
+        NL_TEST_ASSERT(apSuite, manager.GetNodeHealth(kTestFabricIndex, kOtherNodeId, health) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, health.mSubscriptionCount == 1 && health.mActiveSubscriptionCount == 0);
+
+        // Removed subscriptions no longer count, even before they are released.
+        manager.RemoveSubscription(failing);
+        NL_TEST_ASSERT(apSuite, manager.GetNodeHealth(kTestFabricIndex, kTestNodeId, health) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, health.mSubscriptionCount == 1 && health.mMaxConsecutiveFailures == 0);
+
+        manager.mSubscriptions.ReleaseAll();
+    }
+
+    static void TestLivenessTimeout(nlTestSuite * apSuite, void * apContext)
+    {
+        TestContext & ctx               = *static_cast<TestContext *>(apContext);
+        InteractionModelEngine & engine = *InteractionModelEngine::GetInstance();
+        NL_TEST_ASSERT(apSuite, engine.Init(&ctx.GetExchangeManager(), nullptr) == CHIP_NO_ERROR);
+
+        LoopbackSubscriptionManager manager(ctx);
+        NL_TEST_ASSERT(apSuite, manager.Init(ctx) == CHIP_NO_ERROR);
+
+        TestCallback callback;
+        AttributePathParams path(kTestEndpointId, kTestClusterId, kTestAttributeId);
+        SubscriptionManager::Subscription * subscription = nullptr;
+        NL_TEST_ASSERT(apSuite, manager.AddSubscription(MakeParams(path), callback, &subscription) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(apSuite, manager.mNumSessionRequests == 1 && manager.mSessionRequests[0] == subscription);
+
+        CompleteSession(manager, 0, ctx);
+        engine.GetReportingEngine().Run();
+        NL_TEST_ASSERT(apSuite, callback.mNumEstablished == 1);
+        NL_TEST_ASSERT(apSuite, callback.mNumAttributeData == 1);
+        NL_TEST_ASSERT(apSuite, subscription->IsActive());
+        NL_TEST_ASSERT(apSuite, manager.mNumAttempts == 0);
+
+        // The timer is armed for the earliest deadline of the wheel, the liveness deadline of the subscription.
+        uint32_t tick;
+        NL_TEST_ASSERT(apSuite, manager.mWheel.GetNextDeadline(tick));
+        NL_TEST_ASSERT(apSuite, manager.mWheelTimerArmed && manager.mWheelTimerTick == tick);
+
+        // No report comes before the liveness deadline: the subscription is torn down and retried after a backoff.
+        FireNextDeadline(manager);
+        NL_TEST_ASSERT(apSuite, callback.mNumErrors == 1 && callback.mLastError == CHIP_ERROR_TIMEOUT);
+        NL_TEST_ASSERT(apSuite, subscription->mState == SubscriptionManager::Subscription::State::kWaitingToRetry);
+        NL_TEST_ASSERT(apSuite, subscription->mConsecutiveFailures == 1);
+        NL_TEST_ASSERT(apSuite, subscription->mpReadClient == nullptr);
+        NL_TEST_ASSERT(apSuite, manager.mNumSessionRequests == 1);
+
+        // Once the backoff has elapsed, the subscription is established again.
+        FireNextDeadline(manager);
+        NL_TEST_ASSERT(apSuite, manager.mNumSessionRequests == 2 && manager.mSessionRequests[1] == subscription);
+        CompleteSession(manager, 1, ctx);
+        engine.GetReportingEngine().Run();
+        NL_TEST_ASSERT(apSuite, callback.mNumEstablished == 2);
+        NL_TEST_ASSERT(apSuite, callback.mNumAttributeData == 2);
+        NL_TEST_ASSERT(apSuite, subscription->IsActive());
+        NL_TEST_ASSERT(apSuite, subscription->mConsecutiveFailures == 0);
+
+        manager.Shutdown();
+        engine.Shutdown();
+    }
+
+    static void TestConcurrencyCaps(nlTestSuite * apSuite, void * apContext)
+    {
+        TestContext & ctx = *static_cast<TestContext *>(apContext);
+
+        // The interaction model engine is not initialized, so no peer answers the subscribe requests and the attempts stay
+        // in flight.
+        LoopbackSubscriptionManager manager(ctx);
+        NL_TEST_ASSERT(apSuite, manager.Init(ctx) == CHIP_NO_ERROR);
+
+        constexpr uint32_t kNumSubscriptions = kMaxAttempts + 2;
+        static_assert(kNumSubscriptions <= CHIP_IM_SUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS, "Too many subscriptions for the test");
+        static_assert(kMaxSessionSetups < kMaxAttempts, "The test expects fewer session setups than attempts");
+
+        TestCallback callback;
+        AttributePathParams path(kTestEndpointId, kTestClusterId, kTestAttributeId);
+        SubscriptionManager::Subscription * subscriptions[kNumSubscriptions];
+        for (auto & subscription : subscriptions)
+        {
+            NL_TEST_ASSERT(apSuite, manager.AddSubscription(MakeParams(path), callback, &subscription) == CHIP_NO_ERROR);
+        }
+
+        // Sessions are requested for as many subscriptions as session setups are allowed, in the order they were added.
+        NL_TEST_ASSERT(apSuite, manager.mNumSessionRequests == kMaxSessionSetups);
+        NL_TEST_ASSERT(apSuite, manager.mNumAttempts == kMaxSessionSetups);
+        NL_TEST_ASSERT(apSuite, manager.mNumSessionSetups == kMaxSessionSetups);
+
+        // A failed session setup makes room for the next subscription, and the failed one waits for its retry.
+        SubscriptionManager::Subscription::OnSessionFailure(subscriptions[0], PeerId(), CHIP_ERROR_TIMEOUT);
+        NL_TEST_ASSERT(apSuite, subscriptions[0]->mState == SubscriptionManager::Subscription::State::kWaitingToRetry);
+        NL_TEST_ASSERT(apSuite, manager.mNumSessionRequests == kMaxSessionSetups + 1);
+
+        // Each established session makes room for another session setup, until the cap on attempts is reached.
+        for (uint32_t i = 1; i < manager.mNumSessionRequests; i++)
+        {
+            CompleteSession(manager, i, ctx);
+        }
+        NL_TEST_ASSERT(apSuite, manager.mNumSessionRequests == kMaxAttempts + 1);
+        NL_TEST_ASSERT(apSuite, manager.mNumAttempts == kMaxAttempts);
+        NL_TEST_ASSERT(apSuite, manager.mNumSessionSetups == 0);
+        for (uint32_t i = 0; i < manager.mNumSessionRequests; i++)
+        {
+            NL_TEST_ASSERT(apSuite, manager.mSessionRequests[i] == subscriptions[i]);
+        }
+        NL_TEST_ASSERT(apSuite, subscriptions[kMaxAttempts + 1]->mState == SubscriptionManager::Subscription::State::kQueued);
+
+        // The retry of the failed subscription queues behind the subscription already waiting.
+        FireNextDeadline(manager);
+        NL_TEST_ASSERT(apSuite, subscriptions[0]->mState == SubscriptionManager::Subscription::State::kQueued);
+        NL_TEST_ASSERT(apSuite, manager.mNumSessionRequests == kMaxAttempts + 1);
+
+        // Ending an attempt starts the subscription at the head of the queue.
+        manager.RemoveSubscription(subscriptions[1]);
+        DriveRemovals(manager, ctx);
+        NL_TEST_ASSERT(apSuite, manager.mNumSessionRequests == kMaxAttempts + 2);
+        NL_TEST_ASSERT(apSuite, manager.mSessionRequests[kMaxAttempts + 1] == subscriptions[kMaxAttempts + 1]);
+        NL_TEST_ASSERT(apSuite, subscriptions[0]->mState == SubscriptionManager::Subscription::State::kQueued);
+        NL_TEST_ASSERT(apSuite, manager.mNumAttempts == kMaxAttempts);
+
+        manager.Shutdown();
+    }
+
+    static void TestRemoveFromCallback(nlTestSuite * apSuite, void * apContext)
+    {
+        TestContext & ctx               = *static_cast<TestContext *>(apContext);
+        InteractionModelEngine & engine = *InteractionModelEngine::GetInstance();
+        NL_TEST_ASSERT(apSuite, engine.Init(&ctx.GetExchangeManager(), nullptr) == CHIP_NO_ERROR);
+
+        LoopbackSubscriptionManager manager(ctx);
+        NL_TEST_ASSERT(apSuite, manager.Init(ctx) == CHIP_NO_ERROR);
+
+        TestCallback callback;
+        AttributePathParams path(kTestEndpointId, kTestClusterId, kTestAttributeId);
+        SubscriptionManager::Subscription * subscription = nullptr;
+        NL_TEST_ASSERT(apSuite, manager.AddSubscription(MakeParams(path), callback, &subscription) == CHIP_NO_ERROR);
+
+        // Remove the subscription from within the callback of its priming report.
+        callback.mpManager      = &manager;
+        callback.mpRemoveOnData = subscription;
+        CompleteSession(manager, 0, ctx);
+        engine.GetReportingEngine().Run();
+
+        // The rest of the report is not forwarded, but the subscription is only released once its read client has returned.
+        NL_TEST_ASSERT(apSuite, callback.mNumAttributeData == 1);
+        NL_TEST_ASSERT(apSuite, callback.mNumReportEnd == 0);
+        NL_TEST_ASSERT(apSuite, callback.mNumEstablished == 0);
+        NL_TEST_ASSERT(apSuite, manager.mRemovalScheduled);
+        NL_TEST_ASSERT(apSuite, manager.mSubscriptions.Allocated() == 1);
+
+        SubscriptionManager::NodeHealth health;
+        NL_TEST_ASSERT(apSuite, manager.GetNodeHealth(kTestFabricIndex, kTestNodeId, health) == CHIP_ERROR_NOT_FOUND);
+
+        DriveRemovals(manager, ctx);
+        NL_TEST_ASSERT(apSuite, manager.mSubscriptions.Allocated() == 0);
+        NL_TEST_ASSERT(apSuite, manager.mNumAttempts == 0 && manager.mNumSessionSetups == 0);
+        uint32_t tick;
+        NL_TEST_ASSERT(apSuite, !manager.mWheel.GetNextDeadline(tick));
+        NL_TEST_ASSERT(apSuite, !manager.mWheelTimerArmed);
+
+        manager.Shutdown();
+        engine.Shutdown();
+    }
+
+private:
+    static SubscriptionManager::SubscribeParams MakeParams(AttributePathParams & aPath)
+    {
+        SubscriptionManager::SubscribeParams params;
+        params.mFabricIndex                 = kTestFabricIndex;
+        params.mNodeId                      = kTestNodeId;
+        params.mpAttributePathParamsList    = &aPath;
+        params.mAttributePathParamsListSize = 1;
+        params.mMinIntervalFloorSeconds     = 0;
+        params.mMaxIntervalCeilingSeconds   = 5;
+        return params;
+    }
+
+    // Hand the subscription of the given session request a session with the loopback peer.
+    static void CompleteSession(LoopbackSubscriptionManager & aManager, uint32_t aRequest, TestContext & aContext)
+    {
+        aManager.mSessionRequests[aRequest]->OnSessionReady(aContext.GetSessionBobToAlice());
+    }
+
+    // Move the wheel to its next deadline, as its timer does once the deadline is reached.
+    static void FireNextDeadline(SubscriptionManager & aManager)
+    {
+        uint32_t tick;
+        VerifyOrReturn(aManager.mWheel.GetNextDeadline(tick));
+        aManager.mIsAdvancingWheel = true;
+        aManager.mWheel.Advance(tick, aManager);
+        aManager.mIsAdvancingWheel = false;
+        aManager.StartQueuedSubscriptions();
+    }
+
+    // Service the system layer until the removed subscriptions are released.
+    static void DriveRemovals(SubscriptionManager & aManager, TestContext & aContext)
+    {
+        aContext.GetIOContext().DriveIOUntil(System::Clock::Seconds16(1), [&aManager]() { return !aManager.mRemovalScheduled; });
+    }
+};
+
+} // namespace app
+} // namespace chip
+
+namespace {
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("TestRetryDelay", chip::app::TestSubscriptionManager::TestRetryDelay),
+    NL_TEST_DEF("TestNodeHealth", chip::app::TestSubscriptionManager::TestNodeHealth),
+    NL_TEST_DEF("TestLivenessTimeout", chip::app::TestSubscriptionManager::TestLivenessTimeout),
+    NL_TEST_DEF("TestConcurrencyCaps", chip::app::TestSubscriptionManager::TestConcurrencyCaps),
+    NL_TEST_DEF("TestRemoveFromCallback", chip::app::TestSubscriptionManager::TestRemoveFromCallback),
+    NL_TEST_SENTINEL()
+};
+
+nlTestSuite sSuite = { "SubscriptionManager", &sTests[0], chip::app::TestContext::Initialize,
+                       chip::app::TestContext::Finalize };
+
+} // namespace
+
+int TestSubscriptionManager()
+{
+    chip::app::TestContext gContext;
+    nlTestRunner(&sSuite, &gContext);
+    return (nlTestRunnerStats(&sSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestSubscriptionManager)
@@ -0,0 +1,160 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the persistent storage of the
+ *      subscriptions resumed after a restart.
+ *
+ */
+
+#include <app/SubscriptionResumptionStorage.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+using SubscriptionInfo = SubscriptionResumptionStorage::SubscriptionInfo;
+
+constexpr FabricIndex kTestFabricIndex  = 1;
+constexpr NodeId kTestNodeId            = 0x1234;
+constexpr uint64_t kTestSubscriptionId  = 0xdeadbeefcafe0001;
+constexpr EndpointId kTestEndpointId    = 1;
+constexpr ClusterId kTestClusterId      = 6;
+constexpr AttributeId kTestAttributeId  = 0;
+constexpr EventId kTestEventId          = 2;
+constexpr ListIndex kTestListIndex      = 3;
+constexpr uint16_t kTestMinIntervalSecs = 1;
+constexpr uint16_t kTestMaxIntervalSecs = 60;
+
+bool IsSamePath(const ClusterInfo & aLeft, const ClusterInfo & aRight)
+{
+    return aLeft.mEndpointId == aRight.mEndpointId && aLeft.mClusterId == aRight.mClusterId &&
+        aLeft.mAttributeId == aRight.mAttributeId && aLeft.mEventId == aRight.mEventId && aLeft.mListIndex == aRight.mListIndex;
+}
+
+void TestSaveAndLoad(nlTestSuite * apSuite, void * apContext)
+{
+    TestPersistentStorageDelegate storageDelegate;
+    SubscriptionResumptionStorage storage;
+    NL_TEST_ASSERT(apSuite, storage.Init(&storageDelegate) == CHIP_NO_ERROR);
+
+    SubscriptionInfo saved;
+    saved.mNodeId                    = kTestNodeId;
+    saved.mFabricIndex               = kTestFabricIndex;
+    saved.mSubscriptionId            = kTestSubscriptionId;
+    saved.mMinIntervalFloorSeconds   = kTestMinIntervalSecs;
+    saved.mMaxIntervalCeilingSeconds = kTestMaxIntervalSecs;
+    saved.mIsFabricFiltered          = true;
+
+    // A concrete path, a path to a list entry and a wildcard path.
+    saved.mAttributePaths[0].mEndpointId  = kTestEndpointId;
+    saved.mAttributePaths[0].mClusterId   = kTestClusterId;
+    saved.mAttributePaths[0].mAttributeId = kTestAttributeId;
+    saved.mAttributePaths[1].mEndpointId  = kTestEndpointId;
+    saved.mAttributePaths[1].mClusterId   = kTestClusterId;
+    saved.mAttributePaths[1].mAttributeId = kTestAttributeId;
+    saved.mAttributePaths[1].mListIndex   = kTestListIndex;
+    saved.mAttributePaths[2].mClusterId   = kTestClusterId;
+    saved.mAttributePathCount             = 3;
+    saved.mEventPaths[0].mEndpointId      = kTestEndpointId;
+    saved.mEventPaths[0].mClusterId       = kTestClusterId;
+    saved.mEventPaths[0].mEventId         = kTestEventId;
+    saved.mEventPathCount                 = 2;
+
+    NL_TEST_ASSERT(apSuite, storage.Save(0, saved) == CHIP_NO_ERROR);
+
+    SubscriptionInfo loaded;
+    NL_TEST_ASSERT(apSuite, storage.Load(0, loaded) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, loaded.mNodeId == kTestNodeId);
+    NL_TEST_ASSERT(apSuite, loaded.mFabricIndex == kTestFabricIndex);
+    NL_TEST_ASSERT(apSuite, loaded.mSubscriptionId == kTestSubscriptionId);
+    NL_TEST_ASSERT(apSuite, loaded.mMinIntervalFloorSeconds == kTestMinIntervalSecs);
+    NL_TEST_ASSERT(apSuite, loaded.mMaxIntervalCeilingSeconds == kTestMaxIntervalSecs);
+    NL_TEST_ASSERT(apSuite, loaded.mIsFabricFiltered);
+    NL_TEST_ASSERT(apSuite, loaded.mAttributePathCount == saved.mAttributePathCount);
+    for (size_t i = 0; i < saved.mAttributePathCount; i++)
+    {
+        NL_TEST_ASSERT(apSuite, IsSamePath(loaded.mAttributePaths[i], saved.mAttributePaths[i]));
+    }
+    NL_TEST_ASSERT(apSuite, loaded.mAttributePaths[2].HasWildcardEndpointId());
+    NL_TEST_ASSERT(apSuite, loaded.mAttributePaths[2].HasWildcardAttributeId());
+    NL_TEST_ASSERT(apSuite, loaded.mEventPathCount == saved.mEventPathCount);
+    for (size_t i = 0; i < saved.mEventPathCount; i++)
+    {
+        NL_TEST_ASSERT(apSuite, IsSamePath(loaded.mEventPaths[i], saved.mEventPaths[i]));
+    }
+    NL_TEST_ASSERT(apSuite, loaded.mEventPaths[1].HasWildcardEventId());
+
+    // Saving again at the same index replaces the subscription.
+    saved.mSubscriptionId     = kTestSubscriptionId + 1;
+    saved.mIsFabricFiltered   = false;
+    saved.mAttributePathCount = 0;
+    saved.mEventPathCount     = 0;
+    NL_TEST_ASSERT(apSuite, storage.Save(0, saved) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, storage.Load(0, loaded) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, loaded.mSubscriptionId == kTestSubscriptionId + 1);
+    NL_TEST_ASSERT(apSuite, !loaded.mIsFabricFiltered);
+    NL_TEST_ASSERT(apSuite, loaded.mAttributePathCount == 0 && loaded.mEventPathCount == 0);
+}
+
+void TestDelete(nlTestSuite * apSuite, void * apContext)
+{
+    TestPersistentStorageDelegate storageDelegate;
+    SubscriptionResumptionStorage storage;
+    SubscriptionInfo info;
+
+    NL_TEST_ASSERT(apSuite, storage.Save(0, info) == CHIP_ERROR_INCORRECT_STATE);
+    NL_TEST_ASSERT(apSuite, storage.Init(&storageDelegate) == CHIP_NO_ERROR);
+
+    info.mNodeId         = kTestNodeId;
+    info.mFabricIndex    = kTestFabricIndex;
+    info.mSubscriptionId = kTestSubscriptionId;
+    NL_TEST_ASSERT(apSuite, storage.Save(0, info) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, storage.Save(1, info) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, storage.Save(SubscriptionResumptionStorage::kMaxSubscriptions, info) == CHIP_ERROR_INVALID_ARGUMENT);
+
+    NL_TEST_ASSERT(apSuite, storage.Delete(0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, storage.Load(0, info) == CHIP_ERROR_NOT_FOUND);
+    NL_TEST_ASSERT(apSuite, storage.Load(1, info) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(apSuite, info.mSubscriptionId == kTestSubscriptionId);
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("TestSaveAndLoad", TestSaveAndLoad),
+    NL_TEST_DEF("TestDelete", TestDelete),
+    NL_TEST_SENTINEL()
+};
+
+} // namespace
+
+int TestSubscriptionResumptionStorage()
+{
+    nlTestSuite theSuite = { "SubscriptionResumptionStorage", &sTests[0], nullptr, nullptr };
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestSubscriptionResumptionStorage)
@@ -0,0 +1,287 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the timing wheel scheduling the
+ *      reports of subscriptions.
+ *
+ */
+
+#include <app/reporting/SubscriptionTimingWheel.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::app::reporting;
+
+namespace {
+
+constexpr FabricIndex kTestFabricIndex = 1;
+constexpr NodeId kTestNodeId           = 0x1234;
+constexpr NodeId kOtherNodeId          = 0x5678;
+constexpr uint32_t kNumSlots           = CHIP_IM_SUBSCRIPTION_WHEEL_SLOTS;
+
+struct TestEntry : public SubscriptionTimingWheel::Entry
+{
+    uint32_t mMinIntervalElapsedCount = 0;
+    uint32_t mMaxIntervalElapsedCount = 0;
+    uint32_t mMaxIntervalElapsedTick  = 0;
+};
+
+class TestDelegate : public SubscriptionTimingWheel::Delegate
+{
+public:
+    explicit TestDelegate(SubscriptionTimingWheel & aWheel) : mWheel(aWheel) {}
+
+    void OnMinIntervalElapsed(SubscriptionTimingWheel::Entry & aEntry) override
+    {
+        static_cast<TestEntry &>(aEntry).mMinIntervalElapsedCount++;
+    }
+
+    void OnMaxIntervalElapsed(SubscriptionTimingWheel::Entry & aEntry) override
+    {
+        TestEntry & entry = static_cast<TestEntry &>(aEntry);
+        entry.mMaxIntervalElapsedCount++;
+        entry.mMaxIntervalElapsedTick = mWheel.GetCurrentTick();
+    }
+
+private:
+    SubscriptionTimingWheel & mWheel;
+};
+
+void TestMinAndMaxIntervals(nlTestSuite * apSuite, void * apContext)
+{
+    SubscriptionTimingWheel wheel;
+    TestDelegate delegate(wheel);
+    TestEntry entry;
+    uint32_t nextTick;
+
+    wheel.Reset(100);
+    NL_TEST_ASSERT(apSuite, !wheel.GetNextDeadline(nextTick));
+
+    wheel.Schedule(entry, 104, 120, kTestFabricIndex, kTestNodeId);
+    NL_TEST_ASSERT(apSuite, entry.IsScheduled());
+    NL_TEST_ASSERT(apSuite, wheel.GetNextDeadline(nextTick) && nextTick == 104);
+
+    wheel.Advance(103, delegate);
+    NL_TEST_ASSERT(apSuite, entry.mMinIntervalElapsedCount == 0);
+
+    wheel.Advance(104, delegate);
+    NL_TEST_ASSERT(apSuite, entry.mMinIntervalElapsedCount == 1);
+    NL_TEST_ASSERT(apSuite, entry.mMaxIntervalElapsedCount == 0);
+    NL_TEST_ASSERT(apSuite, wheel.GetNextDeadline(nextTick) && nextTick == 120);
+
+    wheel.Advance(119, delegate);
+    NL_TEST_ASSERT(apSuite, entry.mMaxIntervalElapsedCount == 0);
+
+    // A late timer still notifies every deadline.
+    wheel.Advance(125, delegate);
+    NL_TEST_ASSERT(apSuite, entry.mMinIntervalElapsedCount == 1);
+    NL_TEST_ASSERT(apSuite, entry.mMaxIntervalElapsedCount == 1);
+    NL_TEST_ASSERT(apSuite, !entry.IsScheduled());
+    NL_TEST_ASSERT(apSuite, !wheel.GetNextDeadline(nextTick));
+
+    // Both deadlines in the same tick.
+    wheel.Schedule(entry, 130, 130, kTestFabricIndex, kTestNodeId);
+    wheel.Advance(130, delegate);
+    NL_TEST_ASSERT(apSuite, entry.mMinIntervalElapsedCount == 2);
+    NL_TEST_ASSERT(apSuite, entry.mMaxIntervalElapsedCount == 2);
+    NL_TEST_ASSERT(apSuite, !entry.IsScheduled());
+}
+
+void TestLongIntervals(nlTestSuite * apSuite, void * apContext)
+{
+    SubscriptionTimingWheel wheel;
+    TestDelegate delegate(wheel);
+    TestEntry entry;
+    TestEntry other;
+    uint32_t nextTick;
+
+    // Deadlines several turns of the wheel away share slots with nearer ones.
+    wheel.Reset(0);
+    wheel.Schedule(entry, 3 * kNumSlots + 1, 5 * kNumSlots + 1, kTestFabricIndex, kTestNodeId);
+    wheel.Schedule(other, 1, 2, kTestFabricIndex, kOtherNodeId);
+    NL_TEST_ASSERT(apSuite, wheel.GetNextDeadline(nextTick) && nextTick == 1);
+
+    wheel.Advance(2, delegate);
+    NL_TEST_ASSERT(apSuite, other.mMaxIntervalElapsedCount == 1);
+    NL_TEST_ASSERT(apSuite, entry.mMinIntervalElapsedCount == 0);
+    NL_TEST_ASSERT(apSuite, wheel.GetNextDeadline(nextTick) && nextTick == 3 * kNumSlots + 1);
+
+    wheel.Advance(kNumSlots + 1, delegate);
+    NL_TEST_ASSERT(apSuite, entry.mMinIntervalElapsedCount == 0);
+
+    wheel.Advance(3 * kNumSlots + 1, delegate);
+    NL_TEST_ASSERT(apSuite, entry.mMinIntervalElapsedCount == 1);
+    NL_TEST_ASSERT(apSuite, wheel.GetNextDeadline(nextTick) && nextTick == 5 * kNumSlots + 1);
+
+    wheel.Advance(10 * kNumSlots, delegate);
+    NL_TEST_ASSERT(apSuite, entry.mMaxIntervalElapsedCount == 1);
+    NL_TEST_ASSERT(apSuite, !wheel.GetNextDeadline(nextTick));
+}
+
+void TestCancel(nlTestSuite * apSuite, void * apContext)
+{
+    SubscriptionTimingWheel wheel;
+    TestDelegate delegate(wheel);
+    TestEntry entry;
+    TestEntry other;
+    uint32_t nextTick;
+
+    wheel.Reset(0);
+    wheel.Schedule(entry, 5, 10, kTestFabricIndex, kTestNodeId);
+    wheel.Schedule(other, 5, 20, kTestFabricIndex, kOtherNodeId);
+    wheel.Cancel(entry);
+    NL_TEST_ASSERT(apSuite, !entry.IsScheduled());
+
+    // Scheduling again replaces the previous deadlines.
+    wheel.Schedule(other, 7, 20, kTestFabricIndex, kOtherNodeId);
+    NL_TEST_ASSERT(apSuite, wheel.GetNextDeadline(nextTick) && nextTick == 7);
+
+    wheel.Advance(30, delegate);
+    NL_TEST_ASSERT(apSuite, entry.mMinIntervalElapsedCount == 0 && entry.mMaxIntervalElapsedCount == 0);
+    NL_TEST_ASSERT(apSuite, other.mMinIntervalElapsedCount == 1 && other.mMaxIntervalElapsedCount == 1);
+
+    wheel.Schedule(entry, 35, 40, kTestFabricIndex, kTestNodeId);
+    wheel.Reset(50);
+    NL_TEST_ASSERT(apSuite, !entry.IsScheduled());
+    NL_TEST_ASSERT(apSuite, !wheel.GetNextDeadline(nextTick));
+}
+
+void TestNextDeadline(nlTestSuite * apSuite, void * apContext)
+{
+    SubscriptionTimingWheel wheel;
+    TestDelegate delegate(wheel);
+    TestEntry first;
+    TestEntry second;
+    TestEntry later;
+    uint32_t nextTick;
+
+    wheel.Reset(0);
+    wheel.Schedule(later, kNumSlots + 2, 2 * kNumSlots, kTestFabricIndex, kTestNodeId);
+    wheel.Schedule(second, 10, 20, kTestFabricIndex, kTestNodeId);
+    wheel.Schedule(first, 3, 40, kTestFabricIndex, kOtherNodeId);
+    NL_TEST_ASSERT(apSuite, wheel.GetNextDeadline(nextTick) && nextTick == 3);
+
+    // Removing the earliest deadline looks the next one up again, including in a later turn of the wheel.
+    wheel.Cancel(first);
+    NL_TEST_ASSERT(apSuite, wheel.GetNextDeadline(nextTick) && nextTick == 10);
+    wheel.Cancel(second);
+    NL_TEST_ASSERT(apSuite, wheel.GetNextDeadline(nextTick) && nextTick == kNumSlots + 2);
+
+    // Removing a later deadline keeps the earliest one.
+    wheel.Schedule(first, 5, 40, kTestFabricIndex, kOtherNodeId);
+    wheel.Cancel(later);
+    NL_TEST_ASSERT(apSuite, wheel.GetNextDeadline(nextTick) && nextTick == 5);
+
+    wheel.Advance(5, delegate);
+    NL_TEST_ASSERT(apSuite, wheel.GetNextDeadline(nextTick) && nextTick == 40);
+}
+
+void TestScheduleMaxInterval(nlTestSuite * apSuite, void * apContext)
+{
+    SubscriptionTimingWheel wheel;
+    TestDelegate delegate(wheel);
+    TestEntry entry;
+    TestEntry samePeer;
+    uint32_t nextTick;
+
+    wheel.Reset(0);
+    wheel.ScheduleMaxInterval(entry, 20, kTestFabricIndex, kTestNodeId);
+    NL_TEST_ASSERT(apSuite, entry.IsScheduled());
+    NL_TEST_ASSERT(apSuite, wheel.GetNextDeadline(nextTick) && nextTick == 20);
+
+    // The deadline is coalesced with a report already due for the same peer.
+    wheel.ScheduleMaxInterval(samePeer, 24, kTestFabricIndex, kTestNodeId);
+    NL_TEST_ASSERT(apSuite, wheel.GetNextDeadline(nextTick) && nextTick == 20);
+
+    wheel.Advance(20, delegate);
+    NL_TEST_ASSERT(apSuite, entry.mMinIntervalElapsedCount == 0 && entry.mMaxIntervalElapsedCount == 1);
+    NL_TEST_ASSERT(apSuite, samePeer.mMinIntervalElapsedCount == 0 && samePeer.mMaxIntervalElapsedCount == 1);
+    NL_TEST_ASSERT(apSuite, !wheel.GetNextDeadline(nextTick));
+}
+
+void TestCoalescing(nlTestSuite * apSuite, void * apContext)
+{
+    constexpr NodeId kThirdNodeId  = 0x9abc;
+    constexpr NodeId kFourthNodeId = 0xdef0;
+
+    SubscriptionTimingWheel wheel;
+    TestDelegate delegate(wheel);
+    TestEntry first;
+    TestEntry samePeer;
+    TestEntry waiting;
+    TestEntry thirdPeer;
+    TestEntry fourthPeer;
+
+    wheel.Reset(0);
+    wheel.Schedule(first, 1, 30, kTestFabricIndex, kTestNodeId);
+    wheel.Schedule(waiting, 32, 100, kTestFabricIndex, kOtherNodeId);
+    wheel.Advance(1, delegate);
+
+    wheel.Schedule(samePeer, 2, 34, kTestFabricIndex, kTestNodeId);
+    wheel.Schedule(thirdPeer, 2, 33, kTestFabricIndex, kThirdNodeId);
+    wheel.Schedule(fourthPeer, 2, 80, kTestFabricIndex, kFourthNodeId);
+    wheel.Advance(2, delegate);
+
+    // The keep-alive is brought forward to the one already due for the same peer, even though the engine also has to run later
+    // in the window.
+    wheel.Advance(29, delegate);
+    NL_TEST_ASSERT(apSuite, first.mMaxIntervalElapsedCount == 0 && samePeer.mMaxIntervalElapsedCount == 0);
+    wheel.Advance(30, delegate);
+    NL_TEST_ASSERT(apSuite, first.mMaxIntervalElapsedCount == 1);
+    NL_TEST_ASSERT(apSuite, samePeer.mMaxIntervalElapsedCount == 1 && samePeer.mMaxIntervalElapsedTick == 30);
+    NL_TEST_ASSERT(apSuite, thirdPeer.mMaxIntervalElapsedCount == 0);
+
+    // Without a report due for the same peer, the latest deadline of any entry in the window is used.
+    wheel.Advance(32, delegate);
+    NL_TEST_ASSERT(apSuite, waiting.mMinIntervalElapsedCount == 1);
+    NL_TEST_ASSERT(apSuite, thirdPeer.mMaxIntervalElapsedCount == 1 && thirdPeer.mMaxIntervalElapsedTick == 32);
+
+    // Deadlines in the first half of the window are too early to coalesce with.
+    wheel.Advance(79, delegate);
+    NL_TEST_ASSERT(apSuite, fourthPeer.mMaxIntervalElapsedCount == 0);
+    wheel.Advance(80, delegate);
+    NL_TEST_ASSERT(apSuite, fourthPeer.mMaxIntervalElapsedCount == 1 && fourthPeer.mMaxIntervalElapsedTick == 80);
+    NL_TEST_ASSERT(apSuite, waiting.mMaxIntervalElapsedCount == 1 && waiting.mMaxIntervalElapsedTick == 80);
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("TestMinAndMaxIntervals", TestMinAndMaxIntervals),
+    NL_TEST_DEF("TestLongIntervals", TestLongIntervals),
+    NL_TEST_DEF("TestCancel", TestCancel),
+    NL_TEST_DEF("TestNextDeadline", TestNextDeadline),
+    NL_TEST_DEF("TestScheduleMaxInterval", TestScheduleMaxInterval),
+    NL_TEST_DEF("TestCoalescing", TestCoalescing),
+    NL_TEST_SENTINEL()
+};
+
+} // namespace
+
+int TestSubscriptionTimingWheel()
+{
+    nlTestSuite theSuite = { "SubscriptionTimingWheel", &sTests[0], nullptr, nullptr };
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestSubscriptionTimingWheel)
@@ -0,0 +1,232 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <app/util/transition-tick-queue.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+using namespace chip;
+using namespace chip::app;
+
+namespace {
+
+constexpr uint32_t kTickMs = 10;
+
+struct FakeControl
+{
+    uint64_t transitionDeadlineMs = 0;
+    FakeControl * nextTransition  = nullptr;
+    FakeControl * prevTransition  = nullptr;
+
+    uint32_t runCount  = 0;
+    uint64_t lastRunMs = 0;
+
+    // When set, each run reschedules the control delayMs later, runsLeft times.
+    bool reschedule   = false;
+    uint32_t delayMs  = 0;
+    uint32_t runsLeft = 0;
+};
+
+using Queue = TransitionTickQueue<FakeControl>;
+
+void RunDue(Queue & queue, uint64_t nowMs)
+{
+    queue.RunDue(nowMs, [&queue, nowMs](FakeControl * control) {
+        control->runCount++;
+        control->lastRunMs = control->transitionDeadlineMs;
+        if (control->reschedule && control->runsLeft > 0)
+        {
+            control->runsLeft--;
+            queue.Schedule(control, nowMs, control->delayMs);
+        }
+    });
+}
+
+void TestDeadlineOrder(nlTestSuite * apSuite, void * apContext)
+{
+    Queue queue(kTickMs);
+    FakeControl late;
+    FakeControl early;
+    FakeControl middle;
+
+    NL_TEST_ASSERT(apSuite, queue.IsEmpty());
+
+    queue.Schedule(&late, 0, 30);
+    queue.Schedule(&early, 0, 5);
+    queue.Schedule(&middle, 0, 20);
+    NL_TEST_ASSERT(apSuite, !queue.IsEmpty());
+
+    // The earliest deadline is rounded up to the next tick.
+    NL_TEST_ASSERT(apSuite, queue.NextTickMs() == 10);
+
+    RunDue(queue, 10);
+    NL_TEST_ASSERT(apSuite, early.runCount == 1);
+    NL_TEST_ASSERT(apSuite, middle.runCount == 0 && late.runCount == 0);
+    NL_TEST_ASSERT(apSuite, queue.NextTickMs() == 20);
+
+    RunDue(queue, 30);
+    NL_TEST_ASSERT(apSuite, middle.runCount == 1 && late.runCount == 1);
+    NL_TEST_ASSERT(apSuite, queue.IsEmpty());
+    NL_TEST_ASSERT(apSuite, !queue.IsRunning());
+}
+
+void TestZeroDelay(nlTestSuite * apSuite, void * apContext)
+{
+    Queue queue(kTickMs);
+    FakeControl control;
+
+    // A control that keeps rescheduling itself with no delay must not keep a single tick running forever.
+    control.reschedule = true;
+    control.delayMs    = 0;
+    control.runsLeft   = UINT32_MAX;
+
+    queue.Schedule(&control, 0, 0);
+    NL_TEST_ASSERT(apSuite, control.transitionDeadlineMs == Queue::kMinDelayMs);
+
+    RunDue(queue, 10);
+    NL_TEST_ASSERT(apSuite, control.runCount == 10);
+    NL_TEST_ASSERT(apSuite, control.transitionDeadlineMs == 11);
+    NL_TEST_ASSERT(apSuite, !queue.IsEmpty());
+    NL_TEST_ASSERT(apSuite, queue.NextTickMs() == 20);
+
+    // Running a tick late only runs a tick's worth of steps before resynchronizing to now.
+    control.runCount = 0;
+    RunDue(queue, 1000);
+    NL_TEST_ASSERT(apSuite, control.runCount <= kTickMs + 1);
+    NL_TEST_ASSERT(apSuite, control.transitionDeadlineMs == 1001);
+
+    queue.Unlink(&control);
+    NL_TEST_ASSERT(apSuite, queue.IsEmpty());
+}
+
+void TestRescheduleFromDeadline(nlTestSuite * apSuite, void * apContext)
+{
+    Queue queue(kTickMs);
+    FakeControl control;
+
+    control.reschedule = true;
+    control.delayMs    = 3;
+    control.runsLeft   = 100;
+
+    // Steps shorter than a tick run several times per tick, each one relative to the deadline it was due at, so the
+    // transition keeps its overall duration.
+    queue.Schedule(&control, 0, 3);
+    RunDue(queue, 10);
+    NL_TEST_ASSERT(apSuite, control.runCount == 3);
+    NL_TEST_ASSERT(apSuite, control.lastRunMs == 9);
+    NL_TEST_ASSERT(apSuite, control.transitionDeadlineMs == 12);
+
+    // A tick running a bit late does not shift the following deadlines.
+    RunDue(queue, 21);
+    NL_TEST_ASSERT(apSuite, control.runCount == 7);
+    NL_TEST_ASSERT(apSuite, control.lastRunMs == 21);
+    NL_TEST_ASSERT(apSuite, control.transitionDeadlineMs == 24);
+}
+
+void TestResync(nlTestSuite * apSuite, void * apContext)
+{
+    Queue queue(kTickMs);
+    FakeControl control;
+
+    control.reschedule = true;
+    control.delayMs    = 5;
+    control.runsLeft   = 1;
+
+    queue.Schedule(&control, 0, 5);
+
+    // More than a tick behind: the next step is scheduled from now rather than catching up.
+    RunDue(queue, 100);
+    NL_TEST_ASSERT(apSuite, control.runCount == 1);
+    NL_TEST_ASSERT(apSuite, control.transitionDeadlineMs == 105);
+}
+
+void TestUnlink(nlTestSuite * apSuite, void * apContext)
+{
+    Queue queue(kTickMs);
+    FakeControl first;
+    FakeControl second;
+
+    queue.Schedule(&first, 0, 10);
+    queue.Schedule(&second, 0, 20);
+
+    queue.Unlink(&first);
+    NL_TEST_ASSERT(apSuite, first.nextTransition == nullptr);
+    NL_TEST_ASSERT(apSuite, queue.NextTickMs() == 20);
+
+    // Unlinking a control that is not scheduled is a no-op.
+    queue.Unlink(&first);
+
+    // Scheduling again replaces the previous deadline.
+    queue.Schedule(&second, 0, 40);
+    RunDue(queue, 30);
+    NL_TEST_ASSERT(apSuite, second.runCount == 0);
+    RunDue(queue, 40);
+    NL_TEST_ASSERT(apSuite, second.runCount == 1);
+    NL_TEST_ASSERT(apSuite, first.runCount == 0);
+    NL_TEST_ASSERT(apSuite, queue.IsEmpty());
+}
+
+void TestWheelWrap(nlTestSuite * apSuite, void * apContext)
+{
+    Queue queue(kTickMs);
+    FakeControl far;
+    FakeControl near;
+    FakeControl next;
+
+    // far is more than a turn of the wheel away and shares a bucket with near.
+    queue.Schedule(&far, 0, (Queue::kWheelSize + 2) * kTickMs);
+    queue.Schedule(&near, 0, 2 * kTickMs);
+    queue.Schedule(&next, 0, 3 * kTickMs);
+    NL_TEST_ASSERT(apSuite, queue.NextTickMs() == 2 * kTickMs);
+
+    RunDue(queue, 2 * kTickMs);
+    NL_TEST_ASSERT(apSuite, near.runCount == 1 && far.runCount == 0 && next.runCount == 0);
+    NL_TEST_ASSERT(apSuite, queue.NextTickMs() == 3 * kTickMs);
+
+    RunDue(queue, 3 * kTickMs);
+    NL_TEST_ASSERT(apSuite, next.runCount == 1 && far.runCount == 0);
+    NL_TEST_ASSERT(apSuite, queue.NextTickMs() == (Queue::kWheelSize + 2) * kTickMs);
+
+    // A tick running more than a turn late still runs the control.
+    RunDue(queue, 10 * Queue::kWheelSize * kTickMs);
+    NL_TEST_ASSERT(apSuite, far.runCount == 1);
+    NL_TEST_ASSERT(apSuite, queue.IsEmpty());
+}
+
+const nlTest sTests[] = {
+    NL_TEST_DEF("TestDeadlineOrder", TestDeadlineOrder),
+    NL_TEST_DEF("TestZeroDelay", TestZeroDelay),
+    NL_TEST_DEF("TestRescheduleFromDeadline", TestRescheduleFromDeadline),
+    NL_TEST_DEF("TestResync", TestResync),
+    NL_TEST_DEF("TestUnlink", TestUnlink),
+    NL_TEST_DEF("TestWheelWrap", TestWheelWrap),
+    NL_TEST_SENTINEL()
+};
+
+} // namespace
+
+int TestTransitionTickQueue()
+{
+    nlTestSuite theSuite = { "TransitionTickQueue", &sTests[0], nullptr, nullptr };
+
+    nlTestRunner(&theSuite, nullptr);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestTransitionTickQueue)
@@ -0,0 +1,843 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements chip-im-benchmark, a load generator for the
+ *      CHIP Interaction Data Model Protocol.
+ *
+ *      It keeps a configurable number of read, subscribe, write or invoke
+ *      interactions in flight, either against a chip-im-responder over UDP
+ *      or in-process over the loopback transport, and prints the latency
+ *      distribution, throughput, CPU time and heap allocation count as JSON.
+ *
+ */
+
+#include <stdlib.h>
+
+#include <app/CommandHandler.h>
+#include <app/CommandSender.h>
+#include <app/ConcreteAttributePath.h>
+#include <app/InteractionModelEngine.h>
+#include <app/ReadClient.h>
+#include <app/WriteClient.h>
+#include <app/tests/AppTestContext.h>
+#include <app/tests/integration/common.h>
+#include <lib/core/CHIPCore.h>
+#include <lib/support/CHIPArgParser.hpp>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/ErrorStr.h>
+#include <platform/CHIPDeviceLayer.h>
+#include <protocols/secure_channel/PASESession.h>
+#include <system/SystemClock.h>
+#include <transport/SessionManager.h>
+#include <transport/raw/UDP.h>
+
+#include <algorithm>
+#include <atomic>
+#include <math.h>
+#include <sys/resource.h>
+#include <unordered_map>
+#include <vector>
+
+#define IM_CLIENT_PORT (CHIP_PORT + 1)
+
+// Heap allocations are counted by interposing the C allocator, which sanitizers already replace.
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(memory_sanitizer) || __has_feature(thread_sanitizer)
+#define CHIP_IM_BENCHMARK_SANITIZED 1
+#endif
+#endif
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define CHIP_IM_BENCHMARK_SANITIZED 1
+#endif
+
+#if defined(__GLIBC__) && !defined(CHIP_IM_BENCHMARK_SANITIZED)
+#define CHIP_IM_BENCHMARK_COUNT_ALLOCATIONS 1
+#else
+#define CHIP_IM_BENCHMARK_COUNT_ALLOCATIONS 0
+#endif
+
+namespace {
+std::atomic<uint64_t> gAllocationCount{ 0 };
+} // namespace
+
+#if CHIP_IM_BENCHMARK_COUNT_ALLOCATIONS
+extern "C" {
+void * __libc_malloc(size_t size);
+void * __libc_calloc(size_t num, size_t size);
+void * __libc_realloc(void * p, size_t size);
+
+void * malloc(size_t size) noexcept
+{
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void * calloc(size_t num, size_t size) noexcept
+{
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(num, size);
+}
+
+void * realloc(void * p, size_t size) noexcept
+{
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(p, size);
+}
+}
+#endif // CHIP_IM_BENCHMARK_COUNT_ALLOCATIONS
+
+namespace {
+
+using namespace chip;
+using namespace chip::ArgParser;
+
+constexpr FabricIndex gFabricIndex                    = 0;
+constexpr AttributeId kTestAttributeId                = 1;
+constexpr System::Clock::Timeout gMessageTimeout      = System::Clock::Milliseconds32(1000);
+constexpr System::Clock::Timeout gLoopbackServiceTime = System::Clock::Milliseconds32(100);
+
+enum class Workload : uint8_t
+{
+    kRead,
+    kSubscribe,
+    kWrite,
+    kInvoke,
+};
+
+const char * WorkloadName(Workload workload)
+{
+    switch (workload)
+    {
+    case Workload::kRead:
+        return "read";
+    case Workload::kSubscribe:
+        return "subscribe";
+    case Workload::kWrite:
+        return "write";
+    case Workload::kInvoke:
+        return "invoke";
+    }
+    return "unknown";
+}
+
+// Counts the messages handed to the UDP transport, to report the message rate.
+class CountingUDP : public Transport::UDP
+{
+public:
+    CHIP_ERROR SendMessage(const Transport::PeerAddress & address, System::PacketBufferHandle && msgBuf) override
+    {
+        mSentMessageCount++;
+        return UDP::SendMessage(address, std::move(msgBuf));
+    }
+
+    uint64_t mSentMessageCount = 0;
+};
+
+TransportMgr<CountingUDP> gTransportManager;
+
+/**
+ * Keeps up to a given number of interactions in flight until the requested number of them completed, and records the
+ * latency of each successful one.
+ *
+ * Subscribe interactions complete once the subscription is established. Each new subscription replaces the previous one
+ * on the responder, so the subscribe workload always runs one interaction at a time.
+ */
+class Benchmark : public app::ReadClient::Callback, public app::CommandSender::Callback, public app::WriteClient::Callback
+{
+public:
+    CHIP_ERROR Start(System::Layer & systemLayer, Messaging::ExchangeManager & exchangeMgr, const SessionHandle & session,
+                     Workload workload, uint32_t concurrency, uint32_t requestCount)
+    {
+        VerifyOrReturnError(concurrency > 0 && requestCount > 0, CHIP_ERROR_INVALID_ARGUMENT);
+
+        mSystemLayer  = &systemLayer;
+        mExchangeMgr  = &exchangeMgr;
+        mWorkload     = workload;
+        mConcurrency  = (workload == Workload::kSubscribe) ? 1 : concurrency;
+        mRequestCount = requestCount;
+        mSession.Grab(session);
+        mLatenciesUs.reserve(requestCount);
+
+        // Resource usage is sampled around the measured requests only, leaving out the stack setup and teardown.
+        getrusage(RUSAGE_SELF, &mStartUsage);
+        mStartAllocationCount = gAllocationCount.load();
+        mStartTime            = System::SystemClock().GetMonotonicMicroseconds64();
+        return mSystemLayer->ScheduleWork(IssueRequests, this);
+    }
+
+    bool IsDone() const { return mCompletedCount == mRequestCount; }
+
+    uint32_t GetConcurrency() const { return mConcurrency; }
+    uint32_t GetCompletedCount() const { return mCompletedCount; }
+    uint32_t GetFailedCount() const { return mFailedCount; }
+    System::Clock::Microseconds64 GetElapsedTime() const { return mEndTime - mStartTime; }
+    const rusage & GetStartUsage() const { return mStartUsage; }
+    const rusage & GetEndUsage() const { return mEndUsage; }
+    uint64_t GetAllocationCount() const { return mEndAllocationCount - mStartAllocationCount; }
+
+    // Sorts the recorded latencies, which are then read with GetLatencyPercentile.
+    void SortLatencies() { std::sort(mLatenciesUs.begin(), mLatenciesUs.end()); }
+    uint64_t GetLatencyPercentile(double percentile) const
+    {
+        if (mLatenciesUs.empty())
+        {
+            return 0;
+        }
+        size_t rank = static_cast<size_t>(ceil(percentile / 100 * static_cast<double>(mLatenciesUs.size())));
+        return mLatenciesUs[rank == 0 ? 0 : rank - 1];
+    }
+    uint64_t GetLatencyMean() const
+    {
+        uint64_t total = 0;
+        for (uint64_t latency : mLatenciesUs)
+        {
+            total += latency;
+        }
+        return mLatenciesUs.empty() ? 0 : total / mLatenciesUs.size();
+    }
+
+    void Shutdown()
+    {
+        ReleaseEstablishedSubscription();
+        mSession.Release();
+    }
+
+    // ReadClient::Callback
+    void OnAttributeData(const app::ReadClient * apReadClient, const app::ConcreteDataAttributePath & aPath,
+                         TLV::TLVReader * apData, const app::StatusIB & aStatus) override
+    {}
+    void OnSubscriptionEstablished(const app::ReadClient * apReadClient) override
+    {
+        mEstablishedSubscription = const_cast<app::ReadClient *>(apReadClient);
+        CompleteRequest(apReadClient);
+    }
+    void OnError(const app::ReadClient * apReadClient, CHIP_ERROR aError) override { FailRequest(apReadClient); }
+    void OnDone(app::ReadClient * apReadClient) override
+    {
+        if (apReadClient == mEstablishedSubscription)
+        {
+            mEstablishedSubscription = nullptr;
+        }
+        CompleteRequest(apReadClient);
+        Platform::Delete(apReadClient);
+    }
+
+    // CommandSender::Callback
+    void OnError(const app::CommandSender * apCommandSender, const app::StatusIB & aStatus, CHIP_ERROR aError) override
+    {
+        FailRequest(apCommandSender);
+    }
+    void OnDone(app::CommandSender * apCommandSender) override
+    {
+        CompleteRequest(apCommandSender);
+        Platform::Delete(apCommandSender);
+    }
+
+    // WriteClient::Callback
+    void OnError(const app::WriteClient * apWriteClient, const app::StatusIB & aStatus, CHIP_ERROR aError) override
+    {
+        FailRequest(apWriteClient);
+    }
+    void OnDone(app::WriteClient * apWriteClient) override { CompleteRequest(apWriteClient); }
+
+private:
+    struct Request
+    {
+        System::Clock::Microseconds64 mStartTime;
+        bool mFailed;
+    };
+
+    static void IssueRequests(System::Layer * systemLayer, void * context)
+    {
+        Benchmark * benchmark = static_cast<Benchmark *>(context);
+
+        benchmark->ReleaseEstablishedSubscription();
+        while (benchmark->mInFlight.size() < benchmark->mConcurrency && benchmark->mIssuedCount < benchmark->mRequestCount)
+        {
+            benchmark->mIssuedCount++;
+            CHIP_ERROR err = benchmark->SendRequest();
+            if (err != CHIP_NO_ERROR)
+            {
+                ChipLogError(NotSpecified, "Failed to send %s request: %s", WorkloadName(benchmark->mWorkload), ErrorStr(err));
+                benchmark->mFailedCount++;
+                benchmark->RecordCompletion();
+            }
+        }
+    }
+
+    CHIP_ERROR SendRequest()
+    {
+        switch (mWorkload)
+        {
+        case Workload::kRead:
+            return SendReadRequest(app::ReadClient::InteractionType::Read);
+        case Workload::kSubscribe:
+            return SendReadRequest(app::ReadClient::InteractionType::Subscribe);
+        case Workload::kWrite:
+            return SendWriteRequest();
+        case Workload::kInvoke:
+            return SendCommandRequest();
+        }
+        return CHIP_ERROR_INVALID_ARGUMENT;
+    }
+
+    CHIP_ERROR SendReadRequest(app::ReadClient::InteractionType interactionType)
+    {
+        app::AttributePathParams attributePathParams(kTestEndpointId, kTestClusterId, kTestAttributeId);
+
+        app::ReadPrepareParams readPrepareParams(mSession.Get());
+        readPrepareParams.mTimeout                     = gMessageTimeout;
+        readPrepareParams.mpAttributePathParamsList    = &attributePathParams;
+        readPrepareParams.mAttributePathParamsListSize = 1;
+        if (interactionType == app::ReadClient::InteractionType::Subscribe)
+        {
+            readPrepareParams.mMinIntervalFloorSeconds   = 0;
+            readPrepareParams.mMaxIntervalCeilingSeconds = 10;
+            readPrepareParams.mKeepSubscriptions         = false;
+        }
+
+        auto readClient = Platform::MakeUnique<app::ReadClient>(app::InteractionModelEngine::GetInstance(), mExchangeMgr, *this,
+                                                                interactionType);
+        VerifyOrReturnError(readClient != nullptr, CHIP_ERROR_NO_MEMORY);
+
+        TrackRequest(readClient.get());
+        CHIP_ERROR err = readClient->SendRequest(readPrepareParams);
+        if (err != CHIP_NO_ERROR)
+        {
+            mInFlight.erase(readClient.get());
+            return err;
+        }
+
+        readClient.release();
+        return CHIP_NO_ERROR;
+    }
+
+    CHIP_ERROR SendWriteRequest()
+    {
+        app::WriteClientHandle writeClient;
+        ReturnErrorOnFailure(app::InteractionModelEngine::GetInstance()->NewWriteClient(writeClient, this));
+
+        app::AttributePathParams attributePathParams(kTestEndpointId, kTestClusterId, kTestAttributeId);
+        ReturnErrorOnFailure(writeClient.EncodeAttributeWritePayload(attributePathParams, kTestFieldValue1));
+
+        const app::WriteClient * request = writeClient.operator->();
+        TrackRequest(request);
+        CHIP_ERROR err = writeClient.SendWriteRequest(mSession.Get(), gMessageTimeout);
+        if (err != CHIP_NO_ERROR)
+        {
+            mInFlight.erase(request);
+        }
+        return err;
+    }
+
+    CHIP_ERROR SendCommandRequest()
+    {
+        auto commandSender = Platform::MakeUnique<app::CommandSender>(this, mExchangeMgr);
+        VerifyOrReturnError(commandSender != nullptr, CHIP_ERROR_NO_MEMORY);
+
+        app::CommandPathParams commandPathParams = { kTestEndpointId, 0, kTestClusterId, kTestCommandId,
+                                                     app::CommandPathFlags::kEndpointIdValid };
+        ReturnErrorOnFailure(commandSender->PrepareCommand(commandPathParams));
+        TLV::TLVWriter * writer = commandSender->GetCommandDataIBTLVWriter();
+        ReturnErrorOnFailure(writer->Put(TLV::ContextTag(kTestFieldId1), kTestFieldValue1));
+        ReturnErrorOnFailure(commandSender->FinishCommand());
+
+        TrackRequest(commandSender.get());
+        CHIP_ERROR err = commandSender->SendCommandRequest(mSession.Get(), gMessageTimeout);
+        if (err != CHIP_NO_ERROR)
+        {
+            mInFlight.erase(commandSender.get());
+            return err;
+        }
+
+        commandSender.release();
+        return CHIP_NO_ERROR;
+    }
+
+    void TrackRequest(const void * request)
+    {
+        mInFlight[request] = Request{ System::SystemClock().GetMonotonicMicroseconds64(), false };
+    }
+
+    void FailRequest(const void * request)
+    {
+        auto it = mInFlight.find(request);
+        if (it != mInFlight.end())
+        {
+            it->second.mFailed = true;
+        }
+    }
+
+    // Called once per request. Requests that were already completed, such as established subscriptions, are ignored.
+    void CompleteRequest(const void * request)
+    {
+        auto it = mInFlight.find(request);
+        if (it == mInFlight.end())
+        {
+            return;
+        }
+
+        if (it->second.mFailed)
+        {
+            mFailedCount++;
+        }
+        else
+        {
+            mLatenciesUs.push_back((System::SystemClock().GetMonotonicMicroseconds64() - it->second.mStartTime).count());
+        }
+        mInFlight.erase(it);
+
+        RecordCompletion();
+        if (!IsDone())
+        {
+            // Issue the next requests once the client that completed has returned.
+            mSystemLayer->ScheduleWork(IssueRequests, this);
+        }
+    }
+
+    void RecordCompletion()
+    {
+        mCompletedCount++;
+        if (IsDone())
+        {
+            mEndTime            = System::SystemClock().GetMonotonicMicroseconds64();
+            mEndAllocationCount = gAllocationCount.load();
+            getrusage(RUSAGE_SELF, &mEndUsage);
+        }
+    }
+
+    void ReleaseEstablishedSubscription()
+    {
+        if (mEstablishedSubscription != nullptr)
+        {
+            Platform::Delete(mEstablishedSubscription);
+            mEstablishedSubscription = nullptr;
+        }
+    }
+
+    System::Layer * mSystemLayer             = nullptr;
+    Messaging::ExchangeManager * mExchangeMgr = nullptr;
+    SessionHolder mSession;
+    Workload mWorkload     = Workload::kRead;
+    uint32_t mConcurrency  = 1;
+    uint32_t mRequestCount = 0;
+
+    uint32_t mIssuedCount    = 0;
+    uint32_t mCompletedCount = 0;
+    uint32_t mFailedCount    = 0;
+    std::unordered_map<const void *, Request> mInFlight;
+    app::ReadClient * mEstablishedSubscription = nullptr;
+
+    System::Clock::Microseconds64 mStartTime = System::Clock::kZero;
+    System::Clock::Microseconds64 mEndTime   = System::Clock::kZero;
+    std::vector<uint64_t> mLatenciesUs;
+
+    rusage mStartUsage             = {};
+    rusage mEndUsage               = {};
+    uint64_t mStartAllocationCount = 0;
+    uint64_t mEndAllocationCount   = 0;
+};
+
+Benchmark gBenchmark;
+
+// Command line options.
+
+enum
+{
+    kOptionTransport   = 't',
+    kOptionWorkload    = 'w',
+    kOptionConcurrency = 'c',
+    kOptionRequests    = 'n',
+    kOptionOutput      = 'o',
+};
+
+bool gUseUdp               = false;
+Inet::IPAddress gDestAddr  = Inet::IPAddress::Any;
+Workload gWorkload         = Workload::kRead;
+uint32_t gConcurrency      = 1;
+uint32_t gRequestCount     = 1000;
+const char * gOutputPath   = nullptr;
+
+bool HandleOption(const char * progName, OptionSet * optSet, int id, const char * name, const char * arg)
+{
+    switch (id)
+    {
+    case kOptionTransport:
+        if (strcmp(arg, "udp") == 0)
+        {
+            gUseUdp = true;
+        }
+        else if (strcmp(arg, "loopback") == 0)
+        {
+            gUseUdp = false;
+        }
+        else
+        {
+            PrintArgError("%s: Invalid value specified for transport: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case kOptionWorkload:
+        if (strcmp(arg, "read") == 0)
+        {
+            gWorkload = Workload::kRead;
+        }
+        else if (strcmp(arg, "subscribe") == 0)
+        {
+            gWorkload = Workload::kSubscribe;
+        }
+        else if (strcmp(arg, "write") == 0)
+        {
+            gWorkload = Workload::kWrite;
+        }
+        else if (strcmp(arg, "invoke") == 0)
+        {
+            gWorkload = Workload::kInvoke;
+        }
+        else
+        {
+            PrintArgError("%s: Invalid value specified for workload: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case kOptionConcurrency:
+        if (!ParseInt(arg, gConcurrency) || gConcurrency == 0)
+        {
+            PrintArgError("%s: Invalid value specified for concurrency: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case kOptionRequests:
+        if (!ParseInt(arg, gRequestCount) || gRequestCount == 0)
+        {
+            PrintArgError("%s: Invalid value specified for request count: %s\n", progName, arg);
+            return false;
+        }
+        break;
+    case kOptionOutput:
+        gOutputPath = arg;
+        break;
+    default:
+        PrintArgError("%s: Unhandled option: %s\n", progName, name);
+        return false;
+    }
+
+    return true;
+}
+
+bool HandleNonOptionArgs(const char * progName, int argc, char * argv[])
+{
+    if (!gUseUdp)
+    {
+        if (argc != 0)
+        {
+            PrintArgError("%s: Unexpected argument: %s\n", progName, argv[0]);
+            return false;
+        }
+        return true;
+    }
+
+    if (argc != 1)
+    {
+        PrintArgError("%s: Please specify the IP address of the responder.\n", progName);
+        return false;
+    }
+
+    if (!Inet::IPAddress::FromString(argv[0], gDestAddr))
+    {
+        PrintArgError("%s: Invalid responder IP address: %s\n", progName, argv[0]);
+        return false;
+    }
+
+    return true;
+}
+
+// clang-format off
+OptionDef gCmdOptionDefs[] =
+{
+    { "transport",   kArgumentRequired, kOptionTransport },
+    { "workload",    kArgumentRequired, kOptionWorkload },
+    { "concurrency", kArgumentRequired, kOptionConcurrency },
+    { "requests",    kArgumentRequired, kOptionRequests },
+    { "output",      kArgumentRequired, kOptionOutput },
+    { }
+};
+
+const char * const gCmdOptionHelp =
+    "   -t, --transport <loopback|udp>\n"
+    "\n"
+    "       Send requests to an in-process responder over the loopback transport (default),\n"
+    "       or to a chip-im-responder over UDP.\n"
+    "\n"
+    "   -w, --workload <read|subscribe|write|invoke>\n"
+    "\n"
+    "       The interaction to send. Defaults to read.\n"
+    "\n"
+    "   -c, --concurrency <count>\n"
+    "\n"
+    "       The number of interactions kept in flight. Defaults to 1. Subscriptions are\n"
+    "       always established one at a time.\n"
+    "\n"
+    "   -n, --requests <count>\n"
+    "\n"
+    "       The number of interactions to complete. Defaults to 1000.\n"
+    "\n"
+    "   -o, --output <file>\n"
+    "\n"
+    "       Write the JSON results to the given file instead of stdout.\n"
+    "\n"
+    ;
+
+OptionSet gCmdOptions =
+{
+    HandleOption,
+    gCmdOptionDefs,
+    "GENERAL OPTIONS",
+    gCmdOptionHelp
+};
+
+HelpOptions gHelpOptions(
+    "chip-im-benchmark",
+    "Usage: chip-im-benchmark [<options...>] [<responder IP address>]\n",
+    "1.0",
+    "Measure Interaction Model latency and throughput.\n"
+);
+
+OptionSet * gCmdOptionSets[] =
+{
+    &gCmdOptions,
+    &gHelpOptions,
+    nullptr
+};
+// clang-format on
+
+uint64_t GetCpuTimeUs(const timeval & time)
+{
+    return static_cast<uint64_t>(time.tv_sec) * 1000000 + static_cast<uint64_t>(time.tv_usec);
+}
+
+void PrintResults(FILE * out, uint64_t sentMessageCount)
+{
+    const rusage & startUsage = gBenchmark.GetStartUsage();
+    const rusage & endUsage   = gBenchmark.GetEndUsage();
+
+    gBenchmark.SortLatencies();
+
+    double elapsedSeconds = static_cast<double>(gBenchmark.GetElapsedTime().count()) / 1000000;
+    if (elapsedSeconds <= 0)
+    {
+        elapsedSeconds = 1e-6;
+    }
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"transport\": \"%s\",\n", gUseUdp ? "udp" : "loopback");
+    fprintf(out, "  \"workload\": \"%s\",\n", WorkloadName(gWorkload));
+    fprintf(out, "  \"concurrency\": %u,\n", gBenchmark.GetConcurrency());
+    fprintf(out, "  \"requests\": %u,\n", gBenchmark.GetCompletedCount());
+    fprintf(out, "  \"failures\": %u,\n", gBenchmark.GetFailedCount());
+    fprintf(out, "  \"duration_us\": %" PRIu64 ",\n", gBenchmark.GetElapsedTime().count());
+    fprintf(out, "  \"requests_per_second\": %.1f,\n", static_cast<double>(gBenchmark.GetCompletedCount()) / elapsedSeconds);
+    fprintf(out, "  \"messages_sent\": %" PRIu64 ",\n", sentMessageCount);
+    fprintf(out, "  \"messages_per_second\": %.1f,\n", static_cast<double>(sentMessageCount) / elapsedSeconds);
+    fprintf(out, "  \"latency_us\": {\n");
+    fprintf(out, "    \"mean\": %" PRIu64 ",\n", gBenchmark.GetLatencyMean());
+    fprintf(out, "    \"p50\": %" PRIu64 ",\n", gBenchmark.GetLatencyPercentile(50));
+    fprintf(out, "    \"p99\": %" PRIu64 ",\n", gBenchmark.GetLatencyPercentile(99));
+    fprintf(out, "    \"p999\": %" PRIu64 ",\n", gBenchmark.GetLatencyPercentile(99.9));
+    fprintf(out, "    \"max\": %" PRIu64 "\n", gBenchmark.GetLatencyPercentile(100));
+    fprintf(out, "  },\n");
+    fprintf(out, "  \"cpu_time_us\": {\n");
+    fprintf(out, "    \"user\": %" PRIu64 ",\n", GetCpuTimeUs(endUsage.ru_utime) - GetCpuTimeUs(startUsage.ru_utime));
+    fprintf(out, "    \"system\": %" PRIu64 "\n", GetCpuTimeUs(endUsage.ru_stime) - GetCpuTimeUs(startUsage.ru_stime));
+    fprintf(out, "  },\n");
+    if (CHIP_IM_BENCHMARK_COUNT_ALLOCATIONS)
+    {
+        fprintf(out, "  \"allocations\": %" PRIu64 "\n", gBenchmark.GetAllocationCount());
+    }
+    else
+    {
+        fprintf(out, "  \"allocations\": null\n");
+    }
+    fprintf(out, "}\n");
+}
+
+CHIP_ERROR EstablishSecureSession()
+{
+    SecurePairingUsingTestSecret * testSecurePairingSecret = Platform::New<SecurePairingUsingTestSecret>();
+    VerifyOrReturnError(testSecurePairingSecret != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    CHIP_ERROR err = gSessionManager.NewPairing(
+        gSession,
+        Optional<Transport::PeerAddress>::Value(Transport::PeerAddress::UDP(gDestAddr, CHIP_PORT, Inet::InterfaceId::Null())),
+        kTestDeviceNodeId, testSecurePairingSecret, CryptoContext::SessionRole::kInitiator, gFabricIndex);
+
+    Platform::Delete(testSecurePairingSecret);
+    return err;
+}
+
+void StartUdpBenchmark(System::Layer * systemLayer, void * appState)
+{
+    CHIP_ERROR err = gBenchmark.Start(*systemLayer, gExchangeManager, gSession.Get(), gWorkload, gConcurrency, gRequestCount);
+    if (err != CHIP_NO_ERROR)
+    {
+        printf("Failed to start benchmark: %s\n", ErrorStr(err));
+        DeviceLayer::PlatformMgr().StopEventLoopTask();
+    }
+}
+
+void StopUdpBenchmarkWhenDone(System::Layer * systemLayer, void * appState)
+{
+    if (gBenchmark.IsDone())
+    {
+        DeviceLayer::PlatformMgr().StopEventLoopTask();
+        return;
+    }
+    systemLayer->StartTimer(System::Clock::Milliseconds32(10), StopUdpBenchmarkWhenDone, appState);
+}
+
+CHIP_ERROR RunUdpBenchmark(uint64_t & sentMessageCount)
+{
+    InitializeChip();
+
+    ReturnErrorOnFailure(gTransportManager.Init(Transport::UdpListenParameters(DeviceLayer::UDPEndPointManager())
+                                                   .SetAddressType(gDestAddr.Type())
+                                                   .SetListenPort(IM_CLIENT_PORT)));
+    ReturnErrorOnFailure(gSessionManager.Init(&DeviceLayer::SystemLayer(), &gTransportManager, &gMessageCounterManager));
+    ReturnErrorOnFailure(gExchangeManager.Init(&gSessionManager));
+    ReturnErrorOnFailure(gMessageCounterManager.Init(&gExchangeManager));
+    ReturnErrorOnFailure(app::InteractionModelEngine::GetInstance()->Init(&gExchangeManager, nullptr));
+    ReturnErrorOnFailure(EstablishSecureSession());
+
+    ReturnErrorOnFailure(DeviceLayer::SystemLayer().StartTimer(System::Clock::kZero, StartUdpBenchmark, nullptr));
+    ReturnErrorOnFailure(DeviceLayer::SystemLayer().StartTimer(System::Clock::kZero, StopUdpBenchmarkWhenDone, nullptr));
+
+    DeviceLayer::PlatformMgr().RunEventLoop();
+
+    sentMessageCount = gTransportManager.GetTransport().GetImplAtIndex<0>().mSentMessageCount;
+    gBenchmark.Shutdown();
+
+    app::InteractionModelEngine::GetInstance()->Shutdown();
+    gTransportManager.Close();
+    ShutdownChip();
+
+    return gBenchmark.IsDone() ? CHIP_NO_ERROR : CHIP_ERROR_INTERNAL;
+}
+
+CHIP_ERROR RunLoopbackBenchmark(uint64_t & sentMessageCount)
+{
+    Test::AppContext ctx;
+    ReturnErrorOnFailure(ctx.Init());
+    ctx.EnableAsyncDispatch();
+
+    CHIP_ERROR err = gBenchmark.Start(ctx.GetSystemLayer(), ctx.GetExchangeManager(), ctx.GetSessionBobToAlice(), gWorkload,
+                                      gConcurrency, gRequestCount);
+    if (err == CHIP_NO_ERROR)
+    {
+        while (!gBenchmark.IsDone())
+        {
+            ctx.GetIOContext().DriveIOUntil(gLoopbackServiceTime, [] { return gBenchmark.IsDone(); });
+        }
+    }
+
+    sentMessageCount = ctx.GetLoopback().mSentMessageCount;
+    gBenchmark.Shutdown();
+    ctx.DrainAndServiceIO();
+
+    ReturnErrorOnFailure(ctx.Shutdown());
+    return err;
+}
+
+} // namespace
+
+namespace chip {
+namespace app {
+
+bool ServerClusterCommandExists(const ConcreteCommandPath & aCommandPath)
+{
+    return (aCommandPath.mEndpointId == kTestEndpointId && aCommandPath.mClusterId == kTestClusterId &&
+            aCommandPath.mCommandId == kTestCommandId);
+}
+
+void DispatchSingleClusterCommand(const ConcreteCommandPath & aCommandPath, TLV::TLVReader & aReader,
+                                  CommandHandler * apCommandObj)
+{
+    apCommandObj->AddStatus(aCommandPath, Protocols::InteractionModel::Status::Success);
+}
+
+void DispatchSingleClusterResponseCommand(const ConcreteCommandPath & aCommandPath, TLV::TLVReader & aReader,
+                                          CommandSender * apCommandObj)
+{}
+
+CHIP_ERROR ReadSingleClusterData(const Access::SubjectDescriptor & aSubjectDescriptor, const ConcreteReadAttributePath & aPath,
+                                 AttributeReportIBs::Builder & aAttributeReports,
+                                 AttributeValueEncoder::AttributeEncodeState * apEncoderState)
+{
+    return AttributeValueEncoder(aAttributeReports, 0, aPath, 0).Encode(kTestFieldValue1);
+}
+
+CHIP_ERROR WriteSingleClusterData(const Access::SubjectDescriptor & aSubjectDescriptor, ClusterInfo & aClusterInfo,
+                                  TLV::TLVReader & aReader, WriteHandler * apWriteHandler)
+{
+    AttributePathParams attributePathParams(aClusterInfo.mEndpointId, aClusterInfo.mClusterId, aClusterInfo.mAttributeId);
+    return apWriteHandler->AddStatus(attributePathParams, Protocols::InteractionModel::Status::Success);
+}
+
+} // namespace app
+} // namespace chip
+
+int main(int argc, char * argv[])
+{
+    CHIP_ERROR err            = CHIP_NO_ERROR;
+    uint64_t sentMessageCount = 0;
+    FILE * out                = stdout;
+
+    if (!ParseArgs(argv[0], argc, argv, gCmdOptionSets, HandleNonOptionArgs))
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (gOutputPath != nullptr)
+    {
+        out = fopen(gOutputPath, "w");
+        if (out == nullptr)
+        {
+            printf("Failed to open %s\n", gOutputPath);
+            return EXIT_FAILURE;
+        }
+    }
+
+    err = gUseUdp ? RunUdpBenchmark(sentMessageCount) : RunLoopbackBenchmark(sentMessageCount);
+
+    if (err != CHIP_NO_ERROR)
+    {
+        printf("IM benchmark failed: %s\n", ErrorStr(err));
+    }
+    else
+    {
+        PrintResults(out, sentMessageCount);
+    }
+
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+
+    return (err == CHIP_NO_ERROR && gBenchmark.GetFailedCount() == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -41,6 +41,7 @@
 
 #include <app/util/af.h>
 #include <app/util/attribute-storage.h>
+#include <app/util/transition-tick-queue.h>
 
 #include <platform/CHIPDeviceLayer.h>
 
@@ -96,28 +97,78 @@ EmberEventData emAfEvents[] = {
     { NULL, NULL }
 };
 
+// Event controls waiting on the transition tick.
+static chip::app::TransitionTickQueue<EmberEventControl> sTransitionQueue(EMBER_AF_TRANSITION_TICK_MS);
+// The time the transition tick timer is armed for, 0 when it is not armed.
+static uint64_t sTransitionTimerDeadlineMs = 0;
+
+static void RunEventControl(EmberEventControl * control)
+{
+    if (control->callback != NULL)
+    {
+        (control->callback)(control->endpoint);
+        return;
+    }
+
+    for (const EmberEventData & event : emAfEvents)
+    {
+        if (event.control != control)
+            continue;
+        control->status = EMBER_EVENT_INACTIVE;
+        event.handler();
+        break;
+    }
+}
+
 void EventControlHandler(chip::System::Layer * systemLayer, void * appState)
 {
     EmberEventControl * control = reinterpret_cast<EmberEventControl *>(appState);
     if (control->status != EMBER_EVENT_INACTIVE)
     {
         control->status = EMBER_EVENT_INACTIVE;
+        RunEventControl(control);
+    }
+}
 
-        if (control->callback != NULL)
-        {
-            (control->callback)(control->endpoint);
-            return;
-        }
+static uint64_t GetTransitionTimeMs()
+{
+    return chip::System::SystemClock().GetMonotonicMilliseconds64().count();
+}
 
-        for (const EmberEventData & event : emAfEvents)
-        {
-            if (event.control != control)
-                continue;
-            control->status = EMBER_EVENT_INACTIVE;
-            event.handler();
-            break;
-        }
+static void TransitionTickHandler(chip::System::Layer * systemLayer, void * appState);
+
+static void ArmTransitionTimer(uint64_t nowMs)
+{
+    // The tick handler arms the timer once it is done running the controls that are due
+    if (sTransitionQueue.IsEmpty() || sTransitionQueue.IsRunning())
+    {
+        return;
+    }
+
+    uint64_t deadlineMs = sTransitionQueue.NextTickMs();
+    if (sTransitionTimerDeadlineMs != 0 && sTransitionTimerDeadlineMs <= deadlineMs)
+    {
+        return;
     }
+
+    sTransitionTimerDeadlineMs = deadlineMs;
+#if !CHIP_DEVICE_LAYER_NONE
+    uint32_t delayMs = (deadlineMs > nowMs) ? static_cast<uint32_t>(deadlineMs - nowMs) : 0;
+    chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(delayMs), TransitionTickHandler, nullptr);
+#endif
+}
+
+static void TransitionTickHandler(chip::System::Layer * systemLayer, void * appState)
+{
+    uint64_t nowMs             = GetTransitionTimeMs();
+    sTransitionTimerDeadlineMs = 0;
+
+    sTransitionQueue.RunDue(nowMs, [](EmberEventControl * control) {
+        control->status = EMBER_EVENT_INACTIVE;
+        RunEventControl(control);
+    });
+
+    ArmTransitionTimer(nowMs);
 }
 
 const char emAfStackEventString[] = "Stack";
@@ -153,6 +204,10 @@ EmberStatus emberEventControlSetDelayMS(EmberEventControl * control, uint32_t de
 {
     if (delayMs <= EMBER_MAX_EVENT_CONTROL_DELAY_MS)
     {
+        if (control->status != EMBER_EVENT_INACTIVE)
+        {
+            sTransitionQueue.Unlink(control);
+        }
         control->status = EMBER_EVENT_MS_TIME;
 #if !CHIP_DEVICE_LAYER_NONE
         chip::DeviceLayer::SystemLayer().StartTimer(chip::System::Clock::Milliseconds32(delayMs), EventControlHandler, control);
@@ -165,11 +220,29 @@ EmberStatus emberEventControlSetDelayMS(EmberEventControl * control, uint32_t de
     return EMBER_SUCCESS;
 }
 
+EmberStatus emberEventControlSetDelayOnTransitionTick(EmberEventControl * control, uint32_t delayMs)
+{
+    if (delayMs > EMBER_MAX_EVENT_CONTROL_DELAY_MS)
+    {
+        return EMBER_BAD_ARGUMENT;
+    }
+
+    uint64_t nowMs = GetTransitionTimeMs();
+
+    emberEventControlSetInactive(control);
+    control->status = EMBER_EVENT_MS_TIME;
+    sTransitionQueue.Schedule(control, nowMs, delayMs);
+
+    ArmTransitionTimer(nowMs);
+    return EMBER_SUCCESS;
+}
+
 void emberEventControlSetInactive(EmberEventControl * control)
 {
     if (control->status != EMBER_EVENT_INACTIVE)
     {
         control->status = EMBER_EVENT_INACTIVE;
+        sTransitionQueue.Unlink(control);
 #if !CHIP_DEVICE_LAYER_NONE
         chip::DeviceLayer::SystemLayer().CancelTimer(EventControlHandler, control);
 #endif
@@ -183,6 +256,10 @@ bool emberEventControlGetActive(EmberEventControl * control)
 
 void emberEventControlSetActive(EmberEventControl * control)
 {
+    if (control->status != EMBER_EVENT_INACTIVE)
+    {
+        sTransitionQueue.Unlink(control);
+    }
     control->status = EMBER_EVENT_ZERO_DELAY;
 #if !CHIP_DEVICE_LAYER_NONE
     chip::DeviceLayer::SystemLayer().ScheduleWork(EventControlHandler, control);
@@ -232,6 +309,20 @@ EmberStatus emberAfScheduleTickExtended(EndpointId endpoint, ClusterId clusterId
     return EMBER_BAD_ARGUMENT;
 }
 
+EmberStatus emberAfScheduleServerTransitionTick(EndpointId endpoint, ClusterId clusterId, uint32_t delayMs)
+{
+    EmberAfEventContext * context = findEventContext(endpoint, clusterId, EMBER_AF_SERVER_CLUSTER_TICK);
+
+    if (context != NULL && emberAfEndpointIsEnabled(endpoint) &&
+        (emberEventControlSetDelayOnTransitionTick(context->eventControl, delayMs) == EMBER_SUCCESS))
+    {
+        context->pollControl  = EMBER_AF_LONG_POLL;
+        context->sleepControl = EMBER_AF_OK_TO_SLEEP;
+        return EMBER_SUCCESS;
+    }
+    return EMBER_BAD_ARGUMENT;
+}
+
 EmberStatus emberAfScheduleClusterTick(EndpointId endpoint, ClusterId clusterId, bool isClient, uint32_t delayMs,
                                        EmberAfEventSleepControl sleepControl)
 {
@@ -44,6 +44,15 @@
 #define MAX_TIMER_UNITS_HOST 0x7fff
 #define MAX_TIMER_MILLISECONDS_HOST (MAX_TIMER_UNITS_HOST * MILLISECOND_TICKS_PER_MINUTE)
 
+/**
+ * The period of the shared transition tick, in milliseconds.  Event controls
+ * scheduled with ::emberEventControlSetDelayOnTransitionTick run on the first
+ * tick at or after the time they are due.
+ */
+#ifndef EMBER_AF_TRANSITION_TICK_MS
+#define EMBER_AF_TRANSITION_TICK_MS 10
+#endif
+
 /** @brief Complete events with a control and a handler procedure.
  *
  * An application typically creates an array of events
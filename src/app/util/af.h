@@ -947,6 +947,12 @@ EmberStatus emberAfScheduleServerTickExtended(chip::EndpointId endpoint, chip::C
  */
 EmberStatus emberAfScheduleServerTick(chip::EndpointId endpoint, chip::ClusterId clusterId, uint32_t delayMs);
 
+/**
+ * @brief Schedules a server cluster tick on the shared transition tick.  See
+ * ::emberEventControlSetDelayOnTransitionTick.
+ */
+EmberStatus emberAfScheduleServerTransitionTick(chip::EndpointId endpoint, chip::ClusterId clusterId, uint32_t delayMs);
+
 /**
  * @brief A function used to deactivate a cluster-related event.  This function
  * provides a wrapper for the Ember stack's event mechanism which allows an
@@ -1000,6 +1006,31 @@ EmberStatus emberAfDeactivateServerTick(chip::EndpointId endpoint, chip::Cluster
  */
 EmberStatus emberEventControlSetDelayMS(EmberEventControl * control, uint32_t delayMs);
 
+/**
+ * @brief Sets the ::EmberEventControl to run "delayMs" milliseconds in the
+ * future on the shared transition tick.
+ *
+ * All the event controls scheduled this way are run from a single timer, on
+ * ticks that are ::EMBER_AF_TRANSITION_TICK_MS milliseconds apart, so that
+ * many concurrent transitions (e.g. a scene recalled on a bridge) advance
+ * together instead of each holding a timer.  When an event control is
+ * rescheduled from its own handler, the delay counts from the time it was due
+ * at rather than from the tick that ran it, so steps shorter than a tick run
+ * several times per tick and transitions keep their overall duration.  A delay
+ * of 0 is run as 1 ms, and a control that has fallen more than a tick behind
+ * restarts from the current time, so one tick never runs a control more than
+ * about ::EMBER_AF_TRANSITION_TICK_MS times.
+ *
+ * @param control a pointer to the event control.
+ * @param delayMs the number of milliseconds until the next event.
+ *
+ * @return If delayMs is less than or equal to
+           ::EMBER_MAX_EVENT_CONTROL_DELAY_MS, this function will schedule the
+           event and return ::EMBER_SUCCESS.  Otherwise it will return
+           ::EMBER_BAD_ARGUMENT.
+ */
+EmberStatus emberEventControlSetDelayOnTransitionTick(EmberEventControl * control, uint32_t delayMs);
+
 /**
  * @brief Sets the ::EmberEventControl to run "delayQs" quarter seconds in the
  * future.  The 'quarter seconds' are actually 256 milliseconds long.  This
@@ -0,0 +1,103 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <lib/core/DataModelTypes.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chip {
+namespace app {
+
+/**
+ * Remembers the metadata and storage location of the attributes of fixed endpoints found by emAfReadOrWriteAttribute.
+ * The layout of the fixed endpoints never changes, so the entries stay valid until the endpoints are configured again,
+ * which must Clear the cache.
+ *
+ * The cache is direct-mapped: an attribute replaces whichever attribute was cached in the same slot. Metadata is the
+ * attribute metadata type, EmberAfAttributeMetadata outside of tests.
+ */
+template <typename Metadata, size_t kSize>
+class AttributeLocationCache
+{
+public:
+    struct Entry
+    {
+        Metadata * metadata; // nullptr when the entry is unused.
+        uint8_t * location;
+        ClusterId clusterId;
+        AttributeId attributeId;
+        EndpointId endpoint;
+        uint16_t endpointIndex;
+        uint8_t clusterMask;
+    };
+
+    /**
+     * The entry of the given attribute, or nullptr when it is not cached or when isEndpointIndexEnabled(index) reports
+     * that its endpoint is disabled, in which case the caller searches the endpoints as usual.
+     */
+    template <typename IsEnabled>
+    const Entry * Find(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId, uint8_t clusterMask,
+                       IsEnabled && isEndpointIndexEnabled) const
+    {
+        const Entry & entry = mEntries[SlotOf(endpoint, clusterId, attributeId)];
+        if (entry.metadata == nullptr || entry.endpoint != endpoint || entry.clusterId != clusterId ||
+            entry.attributeId != attributeId || entry.clusterMask != clusterMask || !isEndpointIndexEnabled(entry.endpointIndex))
+        {
+            return nullptr;
+        }
+        return &entry;
+    }
+
+    void Store(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId, uint8_t clusterMask, uint16_t endpointIndex,
+               Metadata * metadata, uint8_t * location)
+    {
+        Entry & entry       = mEntries[SlotOf(endpoint, clusterId, attributeId)];
+        entry.metadata      = metadata;
+        entry.location      = location;
+        entry.clusterId     = clusterId;
+        entry.attributeId   = attributeId;
+        entry.endpoint      = endpoint;
+        entry.endpointIndex = endpointIndex;
+        entry.clusterMask   = clusterMask;
+    }
+
+    void Clear()
+    {
+        for (Entry & entry : mEntries)
+        {
+            entry = Entry{};
+        }
+    }
+
+    /// Slot an attribute is cached in, exposed so that tests can pick colliding attributes.
+    static size_t SlotOf(EndpointId endpoint, ClusterId clusterId, AttributeId attributeId)
+    {
+        uint32_t hash = (clusterId * 0x9E3779B1u) ^ (attributeId * 0x85EBCA6Bu) ^ endpoint;
+        return (hash ^ (hash >> 16)) % kSize;
+    }
+
+private:
+    static_assert(kSize > 0, "An empty cache is disabled by the caller instead");
+
+    Entry mEntries[kSize] = {};
+};
+
+} // namespace app
+} // namespace chip
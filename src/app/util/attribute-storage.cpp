@@ -43,6 +43,7 @@
 #include <app/InteractionModelEngine.h>
 #include <app/reporting/reporting.h>
 #include <app/util/af.h>
+#include <app/util/attribute-location-cache.h>
 #include <app/util/attribute-storage.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
@@ -107,6 +108,10 @@ constexpr const EmberAfEndpointType generatedEmberAfEndpointTypes[] = GENERATED_
 #endif
 
 app::AttributeAccessInterface * gAttributeAccessOverrides = nullptr;
+
+#if CHIP_CONFIG_ATTRIBUTE_LOCATION_CACHE_SIZE > 0
+app::AttributeLocationCache<EmberAfAttributeMetadata, CHIP_CONFIG_ATTRIBUTE_LOCATION_CACHE_SIZE> attributeLocationCache;
+#endif // CHIP_CONFIG_ATTRIBUTE_LOCATION_CACHE_SIZE > 0
 } // anonymous namespace
 
 //------------------------------------------------------------------------------
@@ -141,6 +146,10 @@ void emberAfEndpointConfigure(void)
         emAfEndpoints[ep].bitmask       = EMBER_AF_ENDPOINT_ENABLED;
     }
 
+#if CHIP_CONFIG_ATTRIBUTE_LOCATION_CACHE_SIZE > 0
+    attributeLocationCache.Clear();
+#endif
+
 #if CHIP_DEVICE_CONFIG_DYNAMIC_ENDPOINT_COUNT
     if (MAX_ENDPOINT_COUNT > FIXED_ENDPOINT_COUNT)
     {
@@ -512,6 +521,57 @@ bool emAfMatchAttribute(EmberAfCluster * cluster, EmberAfAttributeMetadata * am,
     return (am->attributeId == attRecord->attributeId);
 }
 
+// Reads or writes the attribute described by am, found at the given location of the attribute storage. See
+// emAfReadOrWriteAttribute for the semantics of readLength.
+static EmberAfStatus readOrWriteAttributeAt(EmberAfAttributeSearchRecord * attRecord, EmberAfAttributeMetadata * am,
+                                            uint8_t * attributeLocation, bool isDynamicEndpoint, uint8_t * buffer,
+                                            uint16_t readLength, bool write)
+{
+    uint8_t *src, *dst;
+    if (write)
+    {
+        src = buffer;
+        dst = attributeLocation;
+        if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId, EMBER_AF_NULL_MANUFACTURER_CODE,
+                                                 am->attributeId))
+        {
+            return EMBER_ZCL_STATUS_NOT_AUTHORIZED;
+        }
+    }
+    else
+    {
+        if (buffer == NULL)
+        {
+            return EMBER_ZCL_STATUS_SUCCESS;
+        }
+
+        src = attributeLocation;
+        dst = buffer;
+        if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId, EMBER_AF_NULL_MANUFACTURER_CODE,
+                                                am->attributeId))
+        {
+            return EMBER_ZCL_STATUS_NOT_AUTHORIZED;
+        }
+    }
+
+    // Is the attribute externally stored?
+    if (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE)
+    {
+        return (write ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId, am,
+                                                              EMBER_AF_NULL_MANUFACTURER_CODE, buffer)
+                      : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId, am,
+                                                             EMBER_AF_NULL_MANUFACTURER_CODE, buffer, emberAfAttributeSize(am)));
+    }
+
+    // Internal storage is only supported for fixed endpoints
+    if (isDynamicEndpoint)
+    {
+        return EMBER_ZCL_STATUS_FAILURE;
+    }
+
+    return typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength);
+}
+
 // When reading non-string attributes, this function returns an error when destination
 // buffer isn't large enough to accommodate the attribute type.  For strings, the
 // function will copy at most readLength bytes.  This means the resulting string
@@ -530,6 +590,20 @@ EmberAfStatus emAfReadOrWriteAttribute(EmberAfAttributeSearchRecord * attRecord,
 {
     uint16_t attributeOffsetIndex = 0;
 
+#if CHIP_CONFIG_ATTRIBUTE_LOCATION_CACHE_SIZE > 0
+    // Attributes of fixed endpoints that were found before don't need to be searched again.
+    const auto * cached = attributeLocationCache.Find(attRecord->endpoint, attRecord->clusterId, attRecord->attributeId,
+                                                      attRecord->clusterMask, emberAfEndpointIndexIsEnabled);
+    if (cached != NULL)
+    {
+        if (metadata != NULL)
+        {
+            *metadata = cached->metadata;
+        }
+        return readOrWriteAttributeAt(attRecord, cached->metadata, cached->location, false, buffer, readLength, write);
+    }
+#endif // CHIP_CONFIG_ATTRIBUTE_LOCATION_CACHE_SIZE > 0
+
     for (uint8_t ep = 0; ep < emberAfEndpointCount(); ep++)
     {
         // Is this a dynamic endpoint?
@@ -560,60 +634,20 @@ EmberAfStatus emAfReadOrWriteAttribute(EmberAfAttributeSearchRecord * attRecord,
                                 *metadata = am;
                             }
 
+                            uint8_t * attributeLocation =
+                                (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am)
+                                                                     : attributeData + attributeOffsetIndex);
+
+#if CHIP_CONFIG_ATTRIBUTE_LOCATION_CACHE_SIZE > 0
+                            if (!isDynamicEndpoint)
                             {
-                                uint8_t * attributeLocation =
-                                    (am->mask & ATTRIBUTE_MASK_SINGLETON ? singletonAttributeLocation(am)
-                                                                         : attributeData + attributeOffsetIndex);
-                                uint8_t *src, *dst;
-                                if (write)
-                                {
-                                    src = buffer;
-                                    dst = attributeLocation;
-                                    if (!emberAfAttributeWriteAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                             EMBER_AF_NULL_MANUFACTURER_CODE, am->attributeId))
-                                    {
-                                        return EMBER_ZCL_STATUS_NOT_AUTHORIZED;
-                                    }
-                                }
-                                else
-                                {
-                                    if (buffer == NULL)
-                                    {
-                                        return EMBER_ZCL_STATUS_SUCCESS;
-                                    }
-
-                                    src = attributeLocation;
-                                    dst = buffer;
-                                    if (!emberAfAttributeReadAccessCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                            EMBER_AF_NULL_MANUFACTURER_CODE, am->attributeId))
-                                    {
-                                        return EMBER_ZCL_STATUS_NOT_AUTHORIZED;
-                                    }
-                                }
-
-                                // Is the attribute externally stored?
-                                if (am->mask & ATTRIBUTE_MASK_EXTERNAL_STORAGE)
-                                {
-                                    return (write
-                                                ? emberAfExternalAttributeWriteCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                                        am, EMBER_AF_NULL_MANUFACTURER_CODE, buffer)
-                                                : emberAfExternalAttributeReadCallback(attRecord->endpoint, attRecord->clusterId,
-                                                                                       am, EMBER_AF_NULL_MANUFACTURER_CODE, buffer,
-                                                                                       emberAfAttributeSize(am)));
-                                }
-                                else
-                                {
-                                    // Internal storage is only supported for fixed endpoints
-                                    if (!isDynamicEndpoint)
-                                    {
-                                        return typeSensitiveMemCopy(attRecord->clusterId, dst, src, am, write, readLength);
-                                    }
-                                    else
-                                    {
-                                        return EMBER_ZCL_STATUS_FAILURE;
-                                    }
-                                }
+                                attributeLocationCache.Store(attRecord->endpoint, attRecord->clusterId, attRecord->attributeId,
+                                                             attRecord->clusterMask, ep, am, attributeLocation);
                             }
+#endif // CHIP_CONFIG_ATTRIBUTE_LOCATION_CACHE_SIZE > 0
+
+                            return readOrWriteAttributeAt(attRecord, am, attributeLocation, isDynamicEndpoint, buffer, readLength,
+                                                          write);
                         }
                         else
                         { // Not the attribute we are looking for
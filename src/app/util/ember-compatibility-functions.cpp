@@ -689,6 +689,14 @@ CHIP_ERROR ReadSingleClusterData(const SubjectDescriptor & aSubjectDescriptor, c
     return SendFailureStatus(aPath, attributeReport, imStatus, &backup);
 }
 
+bool IsAttributeDataFabricDependent(const ConcreteAttributePath & aPath)
+{
+    // Only AttributeAccessInterface implementations are given the accessing fabric. The global attribute list and the attributes
+    // in Ember storage are the same for every reader.
+    return aPath.mAttributeId != Clusters::Globals::Attributes::AttributeList::Id &&
+        findAttributeAccessOverride(aPath.mEndpointId, aPath.mClusterId) != nullptr;
+}
+
 namespace {
 
 template <typename T>
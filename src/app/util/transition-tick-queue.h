@@ -0,0 +1,211 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace chip {
+namespace app {
+
+/**
+ * Queue of the event controls run by the shared transition tick, see ::emberEventControlSetDelayOnTransitionTick.
+ *
+ * The queue is a hashed timing wheel: a control is kept in the bucket of the tick its deadline falls on, so that
+ * scheduling and unlinking a control take constant time whatever the number of running transitions. Deadlines more
+ * than a turn of the wheel away share a bucket with nearer ones and are skipped until they are due.
+ *
+ * Control must provide `uint64_t transitionDeadlineMs`, `Control * nextTransition` and `Control * prevTransition`
+ * members, which the queue owns while the control is scheduled. The queue does not arm any timer itself: the owner runs
+ * RunDue from its tick timer and arms the timer for NextTickMs afterwards.
+ */
+template <typename Control>
+class TransitionTickQueue
+{
+public:
+    /// Smallest delay between two runs of a control, so that a control rescheduling itself always moves forward.
+    static constexpr uint32_t kMinDelayMs = 1;
+    /// Number of tick buckets in the wheel, a power of two.
+    static constexpr uint32_t kWheelSize = 16;
+
+    explicit TransitionTickQueue(uint32_t tickMs) : mTickMs(tickMs) {}
+
+    bool IsEmpty() const { return mCount == 0; }
+
+    /// Whether RunDue is running a control right now.
+    bool IsRunning() const { return mRunning != nullptr; }
+
+    /**
+     * Schedule a control delayMs after now, replacing any earlier schedule.
+     *
+     * A control rescheduling itself from its own run is scheduled relative to the deadline it ran for rather than to
+     * now, so that tick latency does not add up over a transition. If that would leave it more than a tick behind, it
+     * is resynchronized to now instead of catching up with a burst of runs.
+     */
+    void Schedule(Control * control, uint64_t nowMs, uint32_t delayMs)
+    {
+        Unlink(control);
+
+        if (IsEmpty() && !IsRunning())
+        {
+            mCursorTick = nowMs / mTickMs;
+        }
+
+        uint64_t baseMs = nowMs;
+        if (control == mRunning && mRunningDeadlineMs + mTickMs >= nowMs)
+        {
+            baseMs = mRunningDeadlineMs;
+        }
+        control->transitionDeadlineMs = baseMs + ((delayMs > kMinDelayMs) ? delayMs : kMinDelayMs);
+
+        Control *& head         = Bucket(TickOf(control->transitionDeadlineMs));
+        control->prevTransition = nullptr;
+        control->nextTransition = head;
+        if (head != nullptr)
+        {
+            head->prevTransition = control;
+        }
+        head = control;
+        mCount++;
+    }
+
+    /// Remove a control from the queue.
+    void Unlink(Control * control)
+    {
+        Control *& head = Bucket(TickOf(control->transitionDeadlineMs));
+        if (control->prevTransition == nullptr && head != control)
+        {
+            // Not scheduled
+            return;
+        }
+
+        if (control->prevTransition != nullptr)
+        {
+            control->prevTransition->nextTransition = control->nextTransition;
+        }
+        else
+        {
+            head = control->nextTransition;
+        }
+        if (control->nextTransition != nullptr)
+        {
+            control->nextTransition->prevTransition = control->prevTransition;
+        }
+        control->nextTransition = nullptr;
+        control->prevTransition = nullptr;
+        mCount--;
+    }
+
+    /**
+     * Run every control due at nowMs, by calling run(control). Controls due on the same tick run in deadline order.
+     *
+     * A control that reschedules itself for a deadline that has already passed runs again within the same call, so that
+     * steps shorter than a tick keep their overall duration. The minimum delay and the resynchronization done by Schedule
+     * bound this to about one run per millisecond of the tick period.
+     */
+    template <typename Run>
+    void RunDue(uint64_t nowMs, Run && run)
+    {
+        const uint64_t lastTick = TickOf(nowMs);
+
+        // A rescheduled control never moves to an earlier tick, so one pass over the ticks in order finds every due run.
+        // When the wheel is more than a turn behind, every bucket is visited once instead.
+        uint64_t tick = mCursorTick;
+        if (lastTick >= tick + kWheelSize)
+        {
+            tick = lastTick - kWheelSize + 1;
+        }
+        for (; tick <= lastTick && !IsEmpty(); tick++)
+        {
+            Control * control;
+            while ((control = EarliestDue(Bucket(tick), nowMs)) != nullptr)
+            {
+                Unlink(control);
+
+                mRunning           = control;
+                mRunningDeadlineMs = control->transitionDeadlineMs;
+                run(control);
+                mRunning = nullptr;
+            }
+        }
+
+        mCursorTick = lastTick;
+    }
+
+    /// Time of the tick the earliest control is due on, aligned on the tick period so that controls due at nearby times
+    /// share a tick. Only meaningful when the queue is not empty.
+    uint64_t NextTickMs() const
+    {
+        // Deadlines within a turn of the wheel are found on the first bucket holding one for its own tick
+        for (uint64_t tick = mCursorTick; tick < mCursorTick + kWheelSize; tick++)
+        {
+            for (const Control * control = Bucket(tick); control != nullptr; control = control->nextTransition)
+            {
+                if (TickOf(control->transitionDeadlineMs) == tick)
+                {
+                    return tick * mTickMs;
+                }
+            }
+        }
+
+        // Every control is more than a turn away
+        uint64_t nextTick = UINT64_MAX;
+        for (const Control * head : mBuckets)
+        {
+            for (const Control * control = head; control != nullptr; control = control->nextTransition)
+            {
+                uint64_t controlTick = TickOf(control->transitionDeadlineMs);
+                nextTick             = (controlTick < nextTick) ? controlTick : nextTick;
+            }
+        }
+        return nextTick * mTickMs;
+    }
+
+private:
+    static_assert((kWheelSize & (kWheelSize - 1)) == 0, "The wheel size must be a power of two");
+
+    /// Tick a deadline is run on: the first tick at or after it.
+    uint64_t TickOf(uint64_t deadlineMs) const { return (deadlineMs + mTickMs - 1) / mTickMs; }
+
+    Control *& Bucket(uint64_t tick) { return mBuckets[tick & (kWheelSize - 1)]; }
+    const Control * Bucket(uint64_t tick) const { return mBuckets[tick & (kWheelSize - 1)]; }
+
+    static Control * EarliestDue(Control * head, uint64_t nowMs)
+    {
+        Control * earliest = nullptr;
+        for (Control * control = head; control != nullptr; control = control->nextTransition)
+        {
+            if (control->transitionDeadlineMs <= nowMs &&
+                (earliest == nullptr || control->transitionDeadlineMs < earliest->transitionDeadlineMs))
+            {
+                earliest = control;
+            }
+        }
+        return earliest;
+    }
+
+    const uint32_t mTickMs;
+    Control * mBuckets[kWheelSize] = {}; // Scheduled controls, by tick of their deadline
+    size_t mCount                  = 0;
+    uint64_t mCursorTick           = 0; // No scheduled control is due before this tick
+    Control * mRunning             = nullptr;
+    uint64_t mRunningDeadlineMs    = 0;
+};
+
+} // namespace app
+} // namespace chip
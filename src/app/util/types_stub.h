@@ -1641,7 +1641,7 @@ typedef void (*TimerCallback)(chip::EndpointId);
  * It holds the event status (one of the @e EMBER_EVENT_ values)
  * and the callback and it's parameters
  */
-typedef struct
+typedef struct EmberEventControl
 {
     /** The event's status, either inactive or the units for timeToExecute. */
     EmberEventUnits status;
@@ -1650,6 +1650,11 @@ typedef struct
     TimerCallback callback;
     chip::EndpointId endpoint;
 
+    /* Transition tick information, see ::emberEventControlSetDelayOnTransitionTick */
+    uint64_t transitionDeadlineMs;
+    struct EmberEventControl * nextTransition;
+    struct EmberEventControl * prevTransition;
+
 } EmberEventControl;
 
 /**
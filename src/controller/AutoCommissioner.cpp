@@ -133,6 +133,7 @@ void AutoCommissioner::StartCommissioning(CommissioneeDeviceProxy * proxy)
 {
     // TODO: check that there is no commissioning in progress currently.
     mCommissioneeDeviceProxy = proxy;
+    mCommissioningStartTime  = System::SystemClock().GetMonotonicTimestamp();
     mCommissioner->PerformCommissioningStep(mCommissioneeDeviceProxy, CommissioningStage::kArmFailsafe, mParams, this);
 }
 
@@ -155,6 +156,13 @@ void AutoCommissioner::CommissioningStepFinished(CHIP_ERROR err, CommissioningDe
         ChipLogError(Controller, "Invalid device for commissioning");
         return;
     }
+    if (nextStage == CommissioningStage::kCleanup)
+    {
+        ChipLogProgress(Controller, "Commissioning took %" PRIu32 " ms",
+                        std::chrono::duration_cast<System::Clock::Milliseconds32>(System::SystemClock().GetMonotonicTimestamp() -
+                                                                                  mCommissioningStartTime)
+                            .count());
+    }
     mCommissioner->PerformCommissioningStep(proxy, nextStage, mParams, this);
 }
 
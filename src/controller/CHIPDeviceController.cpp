@@ -602,19 +602,37 @@ ControllerDeviceInitParams DeviceController::GetControllerDeviceInitParams()
     };
 }
 
-DeviceCommissioner::DeviceCommissioner() :
+DeviceCommissioner::CommissioningContext::CommissioningContext(DeviceCommissioner * commissioner, CommissioneeDeviceProxy * device,
+                                                               bool isIPRendezvous) :
+    mCommissioner(commissioner),
+    mDevice(device), mNodeId(device->GetDeviceId()), mIsIPRendezvous(isIPRendezvous), mAutoCommissioner(commissioner),
     mSuccess(BasicSuccess, this), mFailure(BasicFailure, this), mCertificateChainResponseCallback(OnCertificateChainResponse, this),
     mAttestationResponseCallback(OnAttestationResponse, this), mOpCSRResponseCallback(OnOperationalCertificateSigningRequest, this),
     mNOCResponseCallback(OnOperationalCertificateAddResponse, this), mRootCertResponseCallback(OnRootCertSuccessResponse, this),
     mOnCertificateChainFailureCallback(OnCertificateChainFailureResponse, this),
     mOnAttestationFailureCallback(OnAttestationFailureResponse, this), mOnCSRFailureCallback(OnCSRFailureResponse, this),
     mOnCertFailureCallback(OnAddNOCFailureResponse, this), mOnRootCertFailureCallback(OnRootCertFailureResponse, this),
+    mOnDeviceConnectedCallback(OnCommissioneeConnectedFn, this),
+    mOnDeviceConnectionFailureCallback(OnCommissioneeConnectionFailureFn, this),
+    mDeviceNOCChainCallback(OnDeviceNOCChainGeneration, this)
+{}
+
+void DeviceCommissioner::CommissioningContext::OnSessionEstablishmentError(CHIP_ERROR error)
+{
+    mCommissioner->OnSessionEstablishmentError(*this, error);
+}
+
+void DeviceCommissioner::CommissioningContext::OnSessionEstablished()
+{
+    mCommissioner->OnSessionEstablished(*this);
+}
+
+DeviceCommissioner::DeviceCommissioner() :
     mOnDeviceConnectedCallback(OnDeviceConnectedFn, this), mOnDeviceConnectionFailureCallback(OnDeviceConnectionFailureFn, this),
-    mDeviceNOCChainCallback(OnDeviceNOCChainGeneration, this), mSetUpCodePairer(this), mAutoCommissioner(this)
+    mSetUpCodePairer(this)
 {
-    mPairingDelegate         = nullptr;
-    mPairedDevicesUpdated    = false;
-    mDeviceBeingCommissioned = nullptr;
+    mPairingDelegate      = nullptr;
+    mPairedDevicesUpdated = false;
 }
 
 CHIP_ERROR DeviceCommissioner::Init(CommissionerInitParams params)
@@ -681,6 +699,11 @@ CHIP_ERROR DeviceCommissioner::Shutdown()
     }
 #endif // CHIP_DEVICE_CONFIG_ENABLE_COMMISSIONER_DISCOVERY
 
+    mCommissioningContextPool.ForEachActiveObject([&](auto * context) {
+        ReleaseCommissioningContext(*context);
+        return Loop::Continue;
+    });
+
     DeviceController::Shutdown();
     return CHIP_NO_ERROR;
 }
@@ -727,9 +750,47 @@ CommissioneeDeviceProxy * DeviceCommissioner::FindCommissioneeDevice(NodeId id)
 
 void DeviceCommissioner::ReleaseCommissioneeDevice(CommissioneeDeviceProxy * device)
 {
+    mCommissioningContextPool.ForEachActiveObject([&](auto * context) {
+        if (context->mDevice == device)
+        {
+            CancelAttestationVerification(*context);
+            context->mDevice = nullptr;
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    });
     mCommissioneeDevicePool.ReleaseObject(device);
 }
 
+DeviceCommissioner::CommissioningContext * DeviceCommissioner::FindCommissioningContext(NodeId id)
+{
+    CommissioningContext * foundContext = nullptr;
+    mCommissioningContextPool.ForEachActiveObject([&](auto * context) {
+        if (context->mNodeId == id)
+        {
+            foundContext = context;
+            return Loop::Break;
+        }
+        return Loop::Continue;
+    });
+
+    return foundContext;
+}
+
+void DeviceCommissioner::ReleaseCommissioningContext(CommissioningContext & context)
+{
+    mSystemState->SystemLayer()->CancelTimer(OnSessionEstablishmentTimeoutCallback, &context);
+
+    if (context.mDevice != nullptr)
+    {
+        ReleaseCommissioneeDevice(context.mDevice);
+    }
+    CancelAttestationVerification(context);
+
+    // Releasing the context cancels the cluster callbacks still waiting on the commissionee.
+    mCommissioningContextPool.ReleaseObject(&context);
+}
+
 CHIP_ERROR DeviceCommissioner::GetDeviceBeingCommissioned(NodeId deviceId, CommissioneeDeviceProxy ** out_device)
 {
     VerifyOrReturnError(out_device != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
@@ -771,7 +832,10 @@ CHIP_ERROR DeviceCommissioner::EstablishPASEConnection(NodeId remoteDeviceId, Re
 
     CHIP_ERROR err                     = CHIP_NO_ERROR;
     CommissioneeDeviceProxy * device   = nullptr;
+    CommissioningContext * context     = nullptr;
     Transport::PeerAddress peerAddress = Transport::PeerAddress::UDP(Inet::IPAddress::Any);
+    bool isIPRendezvous                = (params.GetPeerAddress().GetTransportType() != Transport::Type::kBle);
+    bool bleInUse                      = false;
 
     Messaging::ExchangeContext * exchangeCtxt = nullptr;
     Optional<SessionHandle> session;
@@ -782,9 +846,16 @@ CHIP_ERROR DeviceCommissioner::EstablishPASEConnection(NodeId remoteDeviceId, Re
 
     VerifyOrExit(IsOperationalNodeId(remoteDeviceId), err = CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrExit(mState == State::Initialized, err = CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrExit(mDeviceBeingCommissioned == nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(FindCommissioningContext(remoteDeviceId) == nullptr, err = CHIP_ERROR_INCORRECT_STATE);
     VerifyOrExit(fabric != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
 
+    // The BLE connections of the commissionees can't be told apart, so only one of them can use BLE at a time.
+    mCommissioningContextPool.ForEachActiveObject([&](auto * other) {
+        bleInUse = !other->mIsIPRendezvous && other->mDevice != nullptr;
+        return bleInUse ? Loop::Break : Loop::Continue;
+    });
+    VerifyOrExit(isIPRendezvous || !bleInUse, err = CHIP_ERROR_INCORRECT_STATE);
+
     err = InitializePairedDeviceList();
     SuccessOrExit(err);
 
@@ -810,12 +881,11 @@ CHIP_ERROR DeviceCommissioner::EstablishPASEConnection(NodeId remoteDeviceId, Re
     device = mCommissioneeDevicePool.CreateObject();
     VerifyOrExit(device != nullptr, err = CHIP_ERROR_NO_MEMORY);
 
-    mDeviceBeingCommissioned = device;
-
-    mIsIPRendezvous = (params.GetPeerAddress().GetTransportType() != Transport::Type::kBle);
-
     device->Init(GetControllerDeviceInitParams(), remoteDeviceId, peerAddress, fabric->GetFabricIndex());
 
+    context = mCommissioningContextPool.CreateObject(this, device, isIPRendezvous);
+    VerifyOrExit(context != nullptr, err = CHIP_ERROR_NO_MEMORY);
+
     if (params.GetPeerAddress().GetTransportType() != Transport::Type::kBle)
     {
         device->SetAddress(params.GetPeerAddress().GetIPAddress());
@@ -851,7 +921,7 @@ CHIP_ERROR DeviceCommissioner::EstablishPASEConnection(NodeId remoteDeviceId, Re
     device->SetActive(true);
 
     err = device->GetPairing().Pair(params.GetPeerAddress(), params.GetSetupPINCode(), keyID,
-                                    Optional<ReliableMessageProtocolConfig>::Value(mMRPConfig), exchangeCtxt, this);
+                                    Optional<ReliableMessageProtocolConfig>::Value(mMRPConfig), exchangeCtxt, context);
     SuccessOrExit(err);
 
     // Immediately persist the updated mNextKeyID value
@@ -861,13 +931,13 @@ CHIP_ERROR DeviceCommissioner::EstablishPASEConnection(NodeId remoteDeviceId, Re
 exit:
     if (err != CHIP_NO_ERROR)
     {
-        // Delete the current rendezvous session only if a device is not currently being paired.
-        if (mDeviceBeingCommissioned == nullptr)
+        FreeRendezvousSession();
+
+        if (context != nullptr)
         {
-            FreeRendezvousSession();
+            ReleaseCommissioningContext(*context);
         }
-
-        if (device != nullptr)
+        else if (device != nullptr)
         {
             ReleaseCommissioneeDevice(device);
         }
@@ -878,20 +948,19 @@ exit:
 
 CHIP_ERROR DeviceCommissioner::Commission(NodeId remoteDeviceId, CommissioningParameters & params)
 {
-    // TODO(cecille): Can we get rid of mDeviceBeingCommissioned and use the remote id instead? Would require storing the
-    // commissioning stage in the device.
-    CommissioneeDeviceProxy * device = mDeviceBeingCommissioned;
-    if (device->GetDeviceId() != remoteDeviceId || (!device->IsSecureConnected() && !device->IsSessionSetupInProgress()))
+    CommissioningContext * context = FindCommissioningContext(remoteDeviceId);
+    CommissioneeDeviceProxy * device = (context != nullptr) ? context->mDevice : nullptr;
+    if (device == nullptr || (!device->IsSecureConnected() && !device->IsSessionSetupInProgress()))
     {
         ChipLogError(Controller, "Invalid device for commissioning" ChipLogFormatX64, ChipLogValueX64(remoteDeviceId));
         return CHIP_ERROR_INCORRECT_STATE;
     }
-    if (mCommissioningStage != CommissioningStage::kSecurePairing)
+    if (context->mCommissioningStage != CommissioningStage::kSecurePairing || context->mRunCommissioningAfterConnection)
     {
         ChipLogError(Controller, "Commissioning already in progress - not restarting");
         return CHIP_ERROR_INCORRECT_STATE;
     }
-    if (!params.HasWifiCredentials() && !params.HasThreadOperationalDataset() && !mIsIPRendezvous)
+    if (!params.HasWifiCredentials() && !params.HasThreadOperationalDataset() && !context->mIsIPRendezvous)
     {
         ChipLogError(Controller, "Network commissioning parameters are required for BLE auto commissioning.");
         return CHIP_ERROR_INVALID_ARGUMENT;
@@ -923,16 +992,16 @@ CHIP_ERROR DeviceCommissioner::Commission(NodeId remoteDeviceId, CommissioningPa
     }
 
     mSystemState->SystemLayer()->StartTimer(chip::System::Clock::Milliseconds32(kSessionEstablishmentTimeout),
-                                            OnSessionEstablishmentTimeoutCallback, this);
+                                            OnSessionEstablishmentTimeoutCallback, context);
 
-    mAutoCommissioner.SetCommissioningParameters(params);
+    context->mAutoCommissioner.SetCommissioningParameters(params);
     if (device->IsSecureConnected())
     {
-        mAutoCommissioner.StartCommissioning(device);
+        context->mAutoCommissioner.StartCommissioning(device);
     }
     else
     {
-        mRunCommissioningAfterConnection = true;
+        context->mRunCommissioningAfterConnection = true;
     }
     return CHIP_NO_ERROR;
 }
@@ -941,12 +1010,20 @@ CHIP_ERROR DeviceCommissioner::StopPairing(NodeId remoteDeviceId)
 {
     VerifyOrReturnError(mState == State::Initialized, CHIP_ERROR_INCORRECT_STATE);
 
+    CommissioningContext * context = FindCommissioningContext(remoteDeviceId);
     CommissioneeDeviceProxy * device = FindCommissioneeDevice(remoteDeviceId);
-    VerifyOrReturnError(device != nullptr, CHIP_ERROR_INVALID_DEVICE_DESCRIPTOR);
+    VerifyOrReturnError(context != nullptr || device != nullptr, CHIP_ERROR_INVALID_DEVICE_DESCRIPTOR);
 
     FreeRendezvousSession();
 
-    ReleaseCommissioneeDevice(device);
+    if (context != nullptr)
+    {
+        ReleaseCommissioningContext(*context);
+    }
+    else
+    {
+        ReleaseCommissioneeDevice(device);
+    }
     return CHIP_NO_ERROR;
 }
 
@@ -961,17 +1038,16 @@ void DeviceCommissioner::FreeRendezvousSession()
     PersistNextKeyId();
 }
 
-void DeviceCommissioner::RendezvousCleanup(CHIP_ERROR status)
+void DeviceCommissioner::RendezvousCleanup(CommissioningContext & context, CHIP_ERROR status)
 {
     FreeRendezvousSession();
 
-    if (mDeviceBeingCommissioned != nullptr)
+    if (context.mDevice != nullptr)
     {
         // Release the commissionee device. For BLE, this is stored,
         // for IP commissioning, we have taken a reference to the
         // operational node to send the completion command.
-        ReleaseCommissioneeDevice(mDeviceBeingCommissioned);
-        mDeviceBeingCommissioned = nullptr;
+        ReleaseCommissioneeDevice(context.mDevice);
     }
 
     if (mPairingDelegate != nullptr)
@@ -980,40 +1056,37 @@ void DeviceCommissioner::RendezvousCleanup(CHIP_ERROR status)
     }
 }
 
-void DeviceCommissioner::OnSessionEstablishmentError(CHIP_ERROR err)
+void DeviceCommissioner::OnSessionEstablishmentError(CommissioningContext & context, CHIP_ERROR err)
 {
-    mSystemState->SystemLayer()->CancelTimer(OnSessionEstablishmentTimeoutCallback, this);
+    mSystemState->SystemLayer()->CancelTimer(OnSessionEstablishmentTimeoutCallback, &context);
 
     if (mPairingDelegate != nullptr)
     {
         mPairingDelegate->OnStatusUpdate(DevicePairingDelegate::SecurePairingFailed);
     }
 
-    RendezvousCleanup(err);
-
-    if (mDeviceBeingCommissioned != nullptr)
-    {
-        ReleaseCommissioneeDevice(mDeviceBeingCommissioned);
-        mDeviceBeingCommissioned = nullptr;
-    }
+    RendezvousCleanup(context, err);
+    ReleaseCommissioningContext(context);
 }
 
-void DeviceCommissioner::OnSessionEstablished()
+void DeviceCommissioner::OnSessionEstablished(CommissioningContext & context)
 {
-    VerifyOrReturn(mDeviceBeingCommissioned != nullptr, OnSessionEstablishmentError(CHIP_ERROR_INVALID_DEVICE_DESCRIPTOR));
+    VerifyOrReturn(context.mDevice != nullptr, OnSessionEstablishmentError(context, CHIP_ERROR_INVALID_DEVICE_DESCRIPTOR));
 
-    PASESession * pairing = &mDeviceBeingCommissioned->GetPairing();
+    CommissioneeDeviceProxy * device = context.mDevice;
+    PASESession * pairing            = &device->GetPairing();
 
     // TODO: the session should know which peer we are trying to connect to when started
-    pairing->SetPeerNodeId(mDeviceBeingCommissioned->GetDeviceId());
+    pairing->SetPeerNodeId(device->GetDeviceId());
 
-    CHIP_ERROR err = mSystemState->SessionMgr()->NewPairing(
-        mDeviceBeingCommissioned->GetSecureSessionHolder(), Optional<Transport::PeerAddress>::Value(pairing->GetPeerAddress()),
-        pairing->GetPeerNodeId(), pairing, CryptoContext::SessionRole::kInitiator, mFabricIndex);
+    CHIP_ERROR err = mSystemState->SessionMgr()->NewPairing(device->GetSecureSessionHolder(),
+                                                            Optional<Transport::PeerAddress>::Value(pairing->GetPeerAddress()),
+                                                            pairing->GetPeerNodeId(), pairing,
+                                                            CryptoContext::SessionRole::kInitiator, mFabricIndex);
     if (err != CHIP_NO_ERROR)
     {
         ChipLogError(Controller, "Failed in setting up secure channel: err %s", ErrorStr(err));
-        OnSessionEstablishmentError(err);
+        OnSessionEstablishmentError(context, err);
         return;
     }
 
@@ -1021,10 +1094,10 @@ void DeviceCommissioner::OnSessionEstablished()
 
     // TODO: Add code to receive OpCSR from the device, and process the signing request
     // For IP rendezvous, this is sent as part of the state machine.
-    if (mRunCommissioningAfterConnection)
+    if (context.mRunCommissioningAfterConnection)
     {
-        mRunCommissioningAfterConnection = false;
-        mAutoCommissioner.StartCommissioning(mDeviceBeingCommissioned);
+        context.mRunCommissioningAfterConnection = false;
+        context.mAutoCommissioner.StartCommissioning(device);
     }
     else
     {
@@ -1033,18 +1106,19 @@ void DeviceCommissioner::OnSessionEstablished()
     }
 }
 
-CHIP_ERROR DeviceCommissioner::SendCertificateChainRequestCommand(CommissioneeDeviceProxy * device,
+CHIP_ERROR DeviceCommissioner::SendCertificateChainRequestCommand(CommissioningContext & context,
                                                                   Credentials::CertificateType certificateType)
 {
+    CommissioneeDeviceProxy * device = context.mDevice;
     ChipLogDetail(Controller, "Sending Certificate Chain request to %p device", device);
     VerifyOrReturnError(device != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
     chip::Controller::OperationalCredentialsCluster cluster;
     cluster.Associate(device, 0);
 
-    mCertificateTypeBeingRequested = certificateType;
+    context.mCertificateTypeBeingRequested = certificateType;
 
-    Callback::Cancelable * successCallback = mCertificateChainResponseCallback.Cancel();
-    Callback::Cancelable * failureCallback = mOnCertificateChainFailureCallback.Cancel();
+    Callback::Cancelable * successCallback = context.mCertificateChainResponseCallback.Cancel();
+    Callback::Cancelable * failureCallback = context.mOnCertificateChainFailureCallback.Cancel();
 
     ReturnErrorOnFailure(cluster.CertificateChainRequest(successCallback, failureCallback, certificateType));
     ChipLogDetail(Controller, "Sent Certificate Chain request, waiting for the DAC Certificate");
@@ -1054,39 +1128,40 @@ CHIP_ERROR DeviceCommissioner::SendCertificateChainRequestCommand(CommissioneeDe
 void DeviceCommissioner::OnCertificateChainFailureResponse(void * context, uint8_t status)
 {
     ChipLogProgress(Controller, "Device failed to receive the Certificate Chain request Response: 0x%02x", status);
-    DeviceCommissioner * commissioner = reinterpret_cast<DeviceCommissioner *>(context);
-    commissioner->mCertificateChainResponseCallback.Cancel();
-    commissioner->mOnCertificateChainFailureCallback.Cancel();
+    CommissioningContext * commissioningContext = static_cast<CommissioningContext *>(context);
+    commissioningContext->mCertificateChainResponseCallback.Cancel();
+    commissioningContext->mOnCertificateChainFailureCallback.Cancel();
     // TODO: Map error status to correct error code
-    commissioner->OnSessionEstablishmentError(CHIP_ERROR_INTERNAL);
+    commissioningContext->OnSessionEstablishmentError(CHIP_ERROR_INTERNAL);
 }
 
 void DeviceCommissioner::OnCertificateChainResponse(void * context, ByteSpan certificate)
 {
     ChipLogProgress(Controller, "Received certificate chain from the device");
-    DeviceCommissioner * commissioner = reinterpret_cast<DeviceCommissioner *>(context);
+    CommissioningContext * commissioningContext = static_cast<CommissioningContext *>(context);
+    DeviceCommissioner * commissioner           = commissioningContext->mCommissioner;
 
-    commissioner->mCertificateChainResponseCallback.Cancel();
-    commissioner->mOnCertificateChainFailureCallback.Cancel();
+    commissioningContext->mCertificateChainResponseCallback.Cancel();
+    commissioningContext->mOnCertificateChainFailureCallback.Cancel();
 
-    if (commissioner->ProcessCertificateChain(certificate) != CHIP_NO_ERROR)
+    if (commissioner->ProcessCertificateChain(*commissioningContext, certificate) != CHIP_NO_ERROR)
     {
         // Handle error, and notify session failure to the commissioner application.
         ChipLogError(Controller, "Failed to process the certificate chain request");
         // TODO: Map error status to correct error code
-        commissioner->OnSessionEstablishmentError(CHIP_ERROR_INTERNAL);
+        commissioningContext->OnSessionEstablishmentError(CHIP_ERROR_INTERNAL);
     }
 }
 
-CHIP_ERROR DeviceCommissioner::ProcessCertificateChain(const ByteSpan & certificate)
+CHIP_ERROR DeviceCommissioner::ProcessCertificateChain(CommissioningContext & context, const ByteSpan & certificate)
 {
     VerifyOrReturnError(mState == State::Initialized, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(mDeviceBeingCommissioned != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(context.mDevice != nullptr, CHIP_ERROR_INCORRECT_STATE);
 
-    CommissioneeDeviceProxy * device = mDeviceBeingCommissioned;
+    CommissioneeDeviceProxy * device = context.mDevice;
 
     // PAI is being requested first - If PAI is not present, DAC will be requested next anyway.
-    switch (mCertificateTypeBeingRequested)
+    switch (context.mCertificateTypeBeingRequested)
     {
     case CertificateType::kDAC: {
         device->SetDAC(certificate);
@@ -1105,15 +1180,14 @@ CHIP_ERROR DeviceCommissioner::ProcessCertificateChain(const ByteSpan & certific
     if (device->AreCredentialsAvailable())
     {
         ChipLogProgress(Controller, "Sending Attestation Request to the device.");
-        ReturnErrorOnFailure(SendAttestationRequestCommand(device, device->GetAttestationNonce()));
+        ReturnErrorOnFailure(SendAttestationRequestCommand(context, device->GetAttestationNonce()));
     }
     else
     {
-        CHIP_ERROR err = SendCertificateChainRequestCommand(device, CertificateType::kDAC);
+        CHIP_ERROR err = SendCertificateChainRequestCommand(context, CertificateType::kDAC);
         if (err != CHIP_NO_ERROR)
         {
             ChipLogError(Controller, "Failed in sending Certificate Chain request command to the device: err %s", ErrorStr(err));
-            OnSessionEstablishmentError(err);
             return err;
         }
     }
@@ -1121,15 +1195,16 @@ CHIP_ERROR DeviceCommissioner::ProcessCertificateChain(const ByteSpan & certific
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR DeviceCommissioner::SendAttestationRequestCommand(CommissioneeDeviceProxy * device, const ByteSpan & attestationNonce)
+CHIP_ERROR DeviceCommissioner::SendAttestationRequestCommand(CommissioningContext & context, const ByteSpan & attestationNonce)
 {
+    CommissioneeDeviceProxy * device = context.mDevice;
     ChipLogDetail(Controller, "Sending Attestation request to %p device", device);
     VerifyOrReturnError(device != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
     chip::Controller::OperationalCredentialsCluster cluster;
     cluster.Associate(device, 0);
 
-    Callback::Cancelable * successCallback = mAttestationResponseCallback.Cancel();
-    Callback::Cancelable * failureCallback = mOnAttestationFailureCallback.Cancel();
+    Callback::Cancelable * successCallback = context.mAttestationResponseCallback.Cancel();
+    Callback::Cancelable * failureCallback = context.mOnAttestationFailureCallback.Cancel();
 
     ReturnErrorOnFailure(cluster.AttestationRequest(successCallback, failureCallback, attestationNonce));
     ChipLogDetail(Controller, "Sent Attestation request, waiting for the Attestation Information");
@@ -1139,41 +1214,131 @@ CHIP_ERROR DeviceCommissioner::SendAttestationRequestCommand(CommissioneeDeviceP
 void DeviceCommissioner::OnAttestationFailureResponse(void * context, uint8_t status)
 {
     ChipLogProgress(Controller, "Device failed to receive the Attestation Information Response: 0x%02x", status);
-    DeviceCommissioner * commissioner = reinterpret_cast<DeviceCommissioner *>(context);
-    commissioner->mAttestationResponseCallback.Cancel();
-    commissioner->mOnAttestationFailureCallback.Cancel();
+    CommissioningContext * commissioningContext = static_cast<CommissioningContext *>(context);
+    commissioningContext->mAttestationResponseCallback.Cancel();
+    commissioningContext->mOnAttestationFailureCallback.Cancel();
     // TODO: Map error status to correct error code
-    commissioner->OnSessionEstablishmentError(CHIP_ERROR_INTERNAL);
+    commissioningContext->OnSessionEstablishmentError(CHIP_ERROR_INTERNAL);
 }
 
+class DeviceCommissioner::AttestationVerificationJob : public Crypto::CryptoJob
+{
+public:
+    CHIP_ERROR Init(DeviceAttestationVerifier * verifier, const ByteSpan & attestationElements, const ByteSpan & challenge,
+                    const ByteSpan & signature, const ByteSpan & pai, const ByteSpan & dac, const ByteSpan & nonce)
+    {
+        // The job can't rely on the device proxy or the response buffers staying put while it runs.
+        size_t size = attestationElements.size() + challenge.size() + signature.size() + pai.size() + dac.size() + nonce.size();
+        VerifyOrReturnError(mBuffer.Alloc(size), CHIP_ERROR_NO_MEMORY);
+
+        size_t offset        = 0;
+        mAttestationElements = CopyToBuffer(attestationElements, offset);
+        mChallenge           = CopyToBuffer(challenge, offset);
+        mSignature           = CopyToBuffer(signature, offset);
+        mPAI                 = CopyToBuffer(pai, offset);
+        mDAC                 = CopyToBuffer(dac, offset);
+        mNonce               = CopyToBuffer(nonce, offset);
+
+        mVerifier = verifier;
+        return CHIP_NO_ERROR;
+    }
+
+    void Run() override
+    {
+        mResult = mVerifier->VerifyAttestationInformation(mAttestationElements, mChallenge, mSignature, mPAI, mDAC, mNonce);
+    }
+
+    void OnComplete() override
+    {
+        if (mContext != nullptr)
+        {
+            mContext->mCommissioner->OnAttestationVerificationComplete(*mContext, *this);
+        }
+        Platform::Delete(this);
+    }
+
+    // Commissioning to resume once the job completes, null if the commissionee was released in the meantime.
+    CommissioningContext * mContext = nullptr;
+
+    AttestationVerificationResult mResult = AttestationVerificationResult::kNotImplemented;
+
+private:
+    ByteSpan CopyToBuffer(const ByteSpan & span, size_t & offset)
+    {
+        uint8_t * copy = mBuffer.Get() + offset;
+        memcpy(copy, span.data(), span.size());
+        offset += span.size();
+        return ByteSpan(copy, span.size());
+    }
+
+    DeviceAttestationVerifier * mVerifier = nullptr;
+    Platform::ScopedMemoryBuffer<uint8_t> mBuffer;
+    ByteSpan mAttestationElements;
+    ByteSpan mChallenge;
+    ByteSpan mSignature;
+    ByteSpan mPAI;
+    ByteSpan mDAC;
+    ByteSpan mNonce;
+};
+
 void DeviceCommissioner::OnAttestationResponse(void * context, chip::ByteSpan attestationElements, chip::ByteSpan signature)
 {
     ChipLogProgress(Controller, "Received Attestation Information from the device");
-    DeviceCommissioner * commissioner = reinterpret_cast<DeviceCommissioner *>(context);
+    CommissioningContext * commissioningContext = static_cast<CommissioningContext *>(context);
+    DeviceCommissioner * commissioner           = commissioningContext->mCommissioner;
 
-    commissioner->mAttestationResponseCallback.Cancel();
-    commissioner->mOnAttestationFailureCallback.Cancel();
+    commissioningContext->mAttestationResponseCallback.Cancel();
+    commissioningContext->mOnAttestationFailureCallback.Cancel();
+
+    bool pending   = false;
+    CHIP_ERROR err = commissioner->ValidateAttestationInfo(*commissioningContext, attestationElements, signature, pending);
+    if (!pending)
+    {
+        commissioner->HandleAttestationResult(*commissioningContext, err);
+        return;
+    }
 
-    commissioner->HandleAttestationResult(commissioner->ValidateAttestationInfo(attestationElements, signature));
+    // Overlap the CSR round trip with the verification. The NOC isn't requested until the verification completes.
+    commissioner->RequestOperationalCSR(*commissioningContext);
 }
 
-CHIP_ERROR DeviceCommissioner::ValidateAttestationInfo(const ByteSpan & attestationElements, const ByteSpan & signature)
+CHIP_ERROR DeviceCommissioner::ValidateAttestationInfo(CommissioningContext & context, const ByteSpan & attestationElements,
+                                                       const ByteSpan & signature, bool & pending)
 {
+    pending = false;
+
     VerifyOrReturnError(mState == State::Initialized, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(mDeviceBeingCommissioned != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(context.mDevice != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(context.mAttestationVerificationJob == nullptr, CHIP_ERROR_INCORRECT_STATE);
 
-    CommissioneeDeviceProxy * device = mDeviceBeingCommissioned;
+    CommissioneeDeviceProxy * device = context.mDevice;
 
     DeviceAttestationVerifier * dac_verifier = GetDeviceAttestationVerifier();
 
     // Retrieve attestation challenge
-    ByteSpan attestationChallenge = mSystemState->SessionMgr()
-                                        ->GetSecureSession(mDeviceBeingCommissioned->GetSecureSession().Value())
-                                        ->GetCryptoContext()
-                                        .GetAttestationChallenge();
+    ByteSpan attestationChallenge =
+        mSystemState->SessionMgr()->GetSecureSession(device->GetSecureSession().Value())->GetCryptoContext().GetAttestationChallenge();
+
+    Platform::UniquePtr<AttestationVerificationJob> job = Platform::MakeUnique<AttestationVerificationJob>();
+    VerifyOrReturnError(job != nullptr, CHIP_ERROR_NO_MEMORY);
+    ReturnErrorOnFailure(job->Init(dac_verifier, attestationElements, attestationChallenge, signature, device->GetPAI(),
+                                   device->GetDAC(), device->GetAttestationNonce()));
+    job->mContext = &context;
+
+    pending = (Crypto::PostCryptoJob(*job) == CHIP_NO_ERROR);
+    if (pending)
+    {
+        // The job now owns itself.
+        context.mAttestationVerificationJob = job.release();
+        return CHIP_NO_ERROR;
+    }
+
+    job->Run();
+    return ConvertFromAttestationVerificationResult(job->mResult);
+}
 
-    AttestationVerificationResult result = dac_verifier->VerifyAttestationInformation(
-        attestationElements, attestationChallenge, signature, device->GetPAI(), device->GetDAC(), device->GetAttestationNonce());
+CHIP_ERROR DeviceCommissioner::ConvertFromAttestationVerificationResult(AttestationVerificationResult result)
+{
     if (result != AttestationVerificationResult::kSuccess)
     {
         if (result == AttestationVerificationResult::kNotImplemented)
@@ -1202,7 +1367,7 @@ CHIP_ERROR DeviceCommissioner::ValidateAttestationInfo(const ByteSpan & attestat
     return CHIP_NO_ERROR;
 }
 
-void DeviceCommissioner::HandleAttestationResult(CHIP_ERROR err)
+void DeviceCommissioner::HandleAttestationResult(CommissioningContext & context, CHIP_ERROR err)
 {
     if (err != CHIP_NO_ERROR)
     {
@@ -1212,30 +1377,71 @@ void DeviceCommissioner::HandleAttestationResult(CHIP_ERROR err)
         ChipLogError(Controller, "Failed to validate the Attestation Information");
     }
 
-    VerifyOrReturn(mState == State::Initialized);
-    VerifyOrReturn(mDeviceBeingCommissioned != nullptr);
+    RequestOperationalCSR(context);
+}
 
-    CommissioneeDeviceProxy * device = mDeviceBeingCommissioned;
+void DeviceCommissioner::OnAttestationVerificationComplete(CommissioningContext & context, AttestationVerificationJob & job)
+{
+    context.mAttestationVerificationJob = nullptr;
+
+    if (ConvertFromAttestationVerificationResult(job.mResult) != CHIP_NO_ERROR)
+    {
+        // As in HandleAttestationResult(), commissioning continues despite the failure for now.
+        ChipLogError(Controller, "Failed to validate the Attestation Information");
+    }
+
+    VerifyOrReturn(context.mPendingOpCSR.Get() != nullptr);
+
+    ByteSpan NOCSRElements(context.mPendingOpCSR.Get(), context.mPendingNOCSRElementsLen);
+    ByteSpan AttestationSignature(context.mPendingOpCSR.Get() + context.mPendingNOCSRElementsLen,
+                                  context.mPendingAttestationSignatureLen);
+    CHIP_ERROR err = ProcessOpCSR(context, NOCSRElements, AttestationSignature);
+    context.mPendingOpCSR.Free();
+
+    if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Controller, "Failed to process the certificate signing request");
+        // TODO: Map error status to correct error code
+        OnSessionEstablishmentError(context, CHIP_ERROR_INTERNAL);
+    }
+}
+
+void DeviceCommissioner::CancelAttestationVerification(CommissioningContext & context)
+{
+    if (context.mAttestationVerificationJob != nullptr)
+    {
+        // The job deletes itself once it completes.
+        context.mAttestationVerificationJob->mContext = nullptr;
+        context.mAttestationVerificationJob           = nullptr;
+    }
+    context.mPendingOpCSR.Free();
+}
+
+void DeviceCommissioner::RequestOperationalCSR(CommissioningContext & context)
+{
+    VerifyOrReturn(mState == State::Initialized);
+    VerifyOrReturn(context.mDevice != nullptr);
 
     ChipLogProgress(Controller, "Sending 'CSR request' command to the device.");
-    CHIP_ERROR error = SendOperationalCertificateSigningRequestCommand(device);
+    CHIP_ERROR error = SendOperationalCertificateSigningRequestCommand(context);
     if (error != CHIP_NO_ERROR)
     {
         ChipLogError(Controller, "Failed in sending 'CSR request' command to the device: err %s", ErrorStr(error));
-        OnSessionEstablishmentError(error);
+        OnSessionEstablishmentError(context, error);
         return;
     }
 }
 
-CHIP_ERROR DeviceCommissioner::SendOperationalCertificateSigningRequestCommand(CommissioneeDeviceProxy * device)
+CHIP_ERROR DeviceCommissioner::SendOperationalCertificateSigningRequestCommand(CommissioningContext & context)
 {
+    CommissioneeDeviceProxy * device = context.mDevice;
     ChipLogDetail(Controller, "Sending OpCSR request to %p device", device);
     VerifyOrReturnError(device != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
     chip::Controller::OperationalCredentialsCluster cluster;
     cluster.Associate(device, 0);
 
-    Callback::Cancelable * successCallback = mOpCSRResponseCallback.Cancel();
-    Callback::Cancelable * failureCallback = mOnCSRFailureCallback.Cancel();
+    Callback::Cancelable * successCallback = context.mOpCSRResponseCallback.Cancel();
+    Callback::Cancelable * failureCallback = context.mOnCSRFailureCallback.Cancel();
 
     uint8_t csrNonceBuf[kOpCSRNonceLength];
     MutableByteSpan csrNonce(csrNonceBuf);
@@ -1251,28 +1457,47 @@ CHIP_ERROR DeviceCommissioner::SendOperationalCertificateSigningRequestCommand(C
 void DeviceCommissioner::OnCSRFailureResponse(void * context, uint8_t status)
 {
     ChipLogProgress(Controller, "Device failed to receive the CSR request Response: 0x%02x", status);
-    DeviceCommissioner * commissioner = static_cast<DeviceCommissioner *>(context);
-    commissioner->mOpCSRResponseCallback.Cancel();
-    commissioner->mOnCSRFailureCallback.Cancel();
+    CommissioningContext * commissioningContext = static_cast<CommissioningContext *>(context);
+    commissioningContext->mOpCSRResponseCallback.Cancel();
+    commissioningContext->mOnCSRFailureCallback.Cancel();
     // TODO: Map error status to correct error code
-    commissioner->OnSessionEstablishmentError(CHIP_ERROR_INTERNAL);
+    commissioningContext->OnSessionEstablishmentError(CHIP_ERROR_INTERNAL);
 }
 
 void DeviceCommissioner::OnOperationalCertificateSigningRequest(void * context, ByteSpan NOCSRElements,
                                                                 ByteSpan AttestationSignature)
 {
     ChipLogProgress(Controller, "Received certificate signing request from the device");
-    DeviceCommissioner * commissioner = static_cast<DeviceCommissioner *>(context);
+    CommissioningContext * commissioningContext = static_cast<CommissioningContext *>(context);
+    DeviceCommissioner * commissioner           = commissioningContext->mCommissioner;
+
+    commissioningContext->mOpCSRResponseCallback.Cancel();
+    commissioningContext->mOnCSRFailureCallback.Cancel();
 
-    commissioner->mOpCSRResponseCallback.Cancel();
-    commissioner->mOnCSRFailureCallback.Cancel();
+    if (commissioningContext->mAttestationVerificationJob != nullptr)
+    {
+        // Keep the CSR until the attestation information is verified.
+        ChipLogProgress(Controller, "Waiting for the Attestation Information to be verified");
+        size_t size = NOCSRElements.size() + AttestationSignature.size();
+        if (!commissioningContext->mPendingOpCSR.Alloc(size))
+        {
+            commissioningContext->OnSessionEstablishmentError(CHIP_ERROR_NO_MEMORY);
+            return;
+        }
+        memcpy(commissioningContext->mPendingOpCSR.Get(), NOCSRElements.data(), NOCSRElements.size());
+        memcpy(commissioningContext->mPendingOpCSR.Get() + NOCSRElements.size(), AttestationSignature.data(),
+               AttestationSignature.size());
+        commissioningContext->mPendingNOCSRElementsLen        = NOCSRElements.size();
+        commissioningContext->mPendingAttestationSignatureLen = AttestationSignature.size();
+        return;
+    }
 
-    if (commissioner->ProcessOpCSR(NOCSRElements, AttestationSignature) != CHIP_NO_ERROR)
+    if (commissioner->ProcessOpCSR(*commissioningContext, NOCSRElements, AttestationSignature) != CHIP_NO_ERROR)
     {
         // Handle error, and notify session failure to the commissioner application.
         ChipLogError(Controller, "Failed to process the certificate signing request");
         // TODO: Map error status to correct error code
-        commissioner->OnSessionEstablishmentError(CHIP_ERROR_INTERNAL);
+        commissioningContext->OnSessionEstablishmentError(CHIP_ERROR_INTERNAL);
     }
 }
 
@@ -1281,19 +1506,20 @@ void DeviceCommissioner::OnDeviceNOCChainGeneration(void * context, CHIP_ERROR s
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
-    DeviceCommissioner * commissioner = static_cast<DeviceCommissioner *>(context);
+    CommissioningContext * commissioningContext = static_cast<CommissioningContext *>(context);
+    DeviceCommissioner * commissioner           = commissioningContext->mCommissioner;
 
     ChipLogProgress(Controller, "Received callback from the CA for NOC Chain generation. Status %s", ErrorStr(status));
     CommissioneeDeviceProxy * device = nullptr;
     VerifyOrExit(commissioner->mState == State::Initialized, err = CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrExit(commissioner->mDeviceBeingCommissioned != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(commissioningContext->mDevice != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
 
     // Check if the callback returned a failure
     VerifyOrExit(status == CHIP_NO_ERROR, err = status);
 
     // TODO - Verify that the generated root cert matches with commissioner's root cert
 
-    device = commissioner->mDeviceBeingCommissioned;
+    device = commissioningContext->mDevice;
 
     {
         // Reuse NOC Cert buffer for temporary store Root Cert.
@@ -1302,7 +1528,7 @@ void DeviceCommissioner::OnDeviceNOCChainGeneration(void * context, CHIP_ERROR s
         err = ConvertX509CertToChipCert(rcac, rootCert);
         SuccessOrExit(err);
 
-        err = commissioner->SendTrustedRootCertificate(device, rootCert);
+        err = commissioner->SendTrustedRootCertificate(*commissioningContext, rootCert);
         SuccessOrExit(err);
     }
 
@@ -1331,16 +1557,17 @@ exit:
     if (err != CHIP_NO_ERROR)
     {
         ChipLogError(Controller, "Failed in generating device's operational credentials. Error %s", ErrorStr(err));
-        commissioner->OnSessionEstablishmentError(err);
+        commissioningContext->OnSessionEstablishmentError(err);
     }
 }
 
-CHIP_ERROR DeviceCommissioner::ProcessOpCSR(const ByteSpan & NOCSRElements, const ByteSpan & AttestationSignature)
+CHIP_ERROR DeviceCommissioner::ProcessOpCSR(CommissioningContext & context, const ByteSpan & NOCSRElements,
+                                            const ByteSpan & AttestationSignature)
 {
     VerifyOrReturnError(mState == State::Initialized, CHIP_ERROR_INCORRECT_STATE);
-    VerifyOrReturnError(mDeviceBeingCommissioned != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(context.mDevice != nullptr, CHIP_ERROR_INCORRECT_STATE);
 
-    CommissioneeDeviceProxy * device = mDeviceBeingCommissioned;
+    CommissioneeDeviceProxy * device = context.mDevice;
 
     ChipLogProgress(Controller, "Getting certificate chain for the device from the issuer");
 
@@ -1350,18 +1577,18 @@ CHIP_ERROR DeviceCommissioner::ProcessOpCSR(const ByteSpan & NOCSRElements, cons
     mOperationalCredentialsDelegate->SetFabricIdForNextNOCRequest(fabric->GetFabricId());
 
     return mOperationalCredentialsDelegate->GenerateNOCChain(NOCSRElements, AttestationSignature, device->GetDAC(), ByteSpan(),
-                                                             ByteSpan(), &mDeviceNOCChainCallback);
+                                                             ByteSpan(), &context.mDeviceNOCChainCallback);
 }
 
-CHIP_ERROR DeviceCommissioner::SendOperationalCertificate(CommissioneeDeviceProxy * device, const ByteSpan & nocCertBuf,
+CHIP_ERROR DeviceCommissioner::SendOperationalCertificate(CommissioningContext & context, const ByteSpan & nocCertBuf,
                                                           const ByteSpan & icaCertBuf)
 {
-    VerifyOrReturnError(device != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(context.mDevice != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
     chip::Controller::OperationalCredentialsCluster cluster;
-    cluster.Associate(device, 0);
+    cluster.Associate(context.mDevice, 0);
 
-    Callback::Cancelable * successCallback = mNOCResponseCallback.Cancel();
-    Callback::Cancelable * failureCallback = mOnCertFailureCallback.Cancel();
+    Callback::Cancelable * successCallback = context.mNOCResponseCallback.Cancel();
+    Callback::Cancelable * failureCallback = context.mOnCertFailureCallback.Cancel();
 
     ReturnErrorOnFailure(cluster.AddNOC(successCallback, failureCallback, nocCertBuf, icaCertBuf, ByteSpan(nullptr, 0),
                                         mLocalId.GetNodeId(), mVendorId));
@@ -1401,55 +1628,53 @@ CHIP_ERROR DeviceCommissioner::ConvertFromNodeOperationalCertStatus(uint8_t err)
 void DeviceCommissioner::OnAddNOCFailureResponse(void * context, uint8_t status)
 {
     ChipLogProgress(Controller, "Device failed to receive the operational certificate Response: 0x%02x", status);
-    DeviceCommissioner * commissioner = static_cast<DeviceCommissioner *>(context);
-    commissioner->mOpCSRResponseCallback.Cancel();
-    commissioner->mOnCertFailureCallback.Cancel();
+    CommissioningContext * commissioningContext = static_cast<CommissioningContext *>(context);
+    commissioningContext->mOpCSRResponseCallback.Cancel();
+    commissioningContext->mOnCertFailureCallback.Cancel();
     // TODO: Map error status to correct error code
-    commissioner->OnSessionEstablishmentError(CHIP_ERROR_INTERNAL);
+    commissioningContext->OnSessionEstablishmentError(CHIP_ERROR_INTERNAL);
 }
 
 void DeviceCommissioner::OnOperationalCertificateAddResponse(void * context, uint8_t StatusCode, uint8_t FabricIndex,
                                                              CharSpan DebugText)
 {
     ChipLogProgress(Controller, "Device returned status %d on receiving the NOC", StatusCode);
-    DeviceCommissioner * commissioner = static_cast<DeviceCommissioner *>(context);
+    CommissioningContext * commissioningContext = static_cast<CommissioningContext *>(context);
+    DeviceCommissioner * commissioner           = commissioningContext->mCommissioner;
 
-    CHIP_ERROR err                   = CHIP_NO_ERROR;
-    CommissioneeDeviceProxy * device = nullptr;
+    CHIP_ERROR err = CHIP_NO_ERROR;
 
     VerifyOrExit(commissioner->mState == State::Initialized, err = CHIP_ERROR_INCORRECT_STATE);
 
-    commissioner->mOpCSRResponseCallback.Cancel();
-    commissioner->mOnCertFailureCallback.Cancel();
+    commissioningContext->mOpCSRResponseCallback.Cancel();
+    commissioningContext->mOnCertFailureCallback.Cancel();
 
-    VerifyOrExit(commissioner->mDeviceBeingCommissioned != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(commissioningContext->mDevice != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
 
     err = ConvertFromNodeOperationalCertStatus(StatusCode);
     SuccessOrExit(err);
 
-    device = commissioner->mDeviceBeingCommissioned;
-
-    err = commissioner->OnOperationalCredentialsProvisioningCompletion(device);
+    err = commissioner->OnOperationalCredentialsProvisioningCompletion(*commissioningContext);
 
 exit:
     if (err != CHIP_NO_ERROR)
     {
         ChipLogProgress(Controller, "Add NOC failed with error %s", ErrorStr(err));
-        commissioner->OnSessionEstablishmentError(err);
+        commissioningContext->OnSessionEstablishmentError(err);
     }
 }
 
-CHIP_ERROR DeviceCommissioner::SendTrustedRootCertificate(CommissioneeDeviceProxy * device, const ByteSpan & rcac)
+CHIP_ERROR DeviceCommissioner::SendTrustedRootCertificate(CommissioningContext & context, const ByteSpan & rcac)
 {
-    VerifyOrReturnError(device != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(context.mDevice != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
 
     ChipLogProgress(Controller, "Sending root certificate to the device");
 
     chip::Controller::OperationalCredentialsCluster cluster;
-    cluster.Associate(device, 0);
+    cluster.Associate(context.mDevice, 0);
 
-    Callback::Cancelable * successCallback = mRootCertResponseCallback.Cancel();
-    Callback::Cancelable * failureCallback = mOnRootCertFailureCallback.Cancel();
+    Callback::Cancelable * successCallback = context.mRootCertResponseCallback.Cancel();
+    Callback::Cancelable * failureCallback = context.mOnRootCertFailureCallback.Cancel();
 
     ReturnErrorOnFailure(cluster.AddTrustedRootCertificate(successCallback, failureCallback, rcac));
 
@@ -1461,47 +1686,49 @@ CHIP_ERROR DeviceCommissioner::SendTrustedRootCertificate(CommissioneeDeviceProx
 void DeviceCommissioner::OnRootCertSuccessResponse(void * context)
 {
     ChipLogProgress(Controller, "Device confirmed that it has received the root certificate");
-    DeviceCommissioner * commissioner = static_cast<DeviceCommissioner *>(context);
+    CommissioningContext * commissioningContext = static_cast<CommissioningContext *>(context);
+    DeviceCommissioner * commissioner           = commissioningContext->mCommissioner;
 
     CHIP_ERROR err                   = CHIP_NO_ERROR;
     CommissioneeDeviceProxy * device = nullptr;
 
     VerifyOrExit(commissioner->mState == State::Initialized, err = CHIP_ERROR_INCORRECT_STATE);
 
-    commissioner->mRootCertResponseCallback.Cancel();
-    commissioner->mOnRootCertFailureCallback.Cancel();
+    commissioningContext->mRootCertResponseCallback.Cancel();
+    commissioningContext->mOnRootCertFailureCallback.Cancel();
 
-    VerifyOrExit(commissioner->mDeviceBeingCommissioned != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrExit(commissioningContext->mDevice != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
 
-    device = commissioner->mDeviceBeingCommissioned;
+    device = commissioningContext->mDevice;
 
     ChipLogProgress(Controller, "Sending operational certificate chain to the device");
-    err = commissioner->SendOperationalCertificate(device, device->GetNOCCert(), device->GetICACert());
+    err = commissioner->SendOperationalCertificate(*commissioningContext, device->GetNOCCert(), device->GetICACert());
     SuccessOrExit(err);
 
 exit:
     if (err != CHIP_NO_ERROR)
     {
-        commissioner->OnSessionEstablishmentError(err);
+        commissioningContext->OnSessionEstablishmentError(err);
     }
 }
 
 void DeviceCommissioner::OnRootCertFailureResponse(void * context, uint8_t status)
 {
     ChipLogProgress(Controller, "Device failed to receive the root certificate Response: 0x%02x", status);
-    DeviceCommissioner * commissioner = static_cast<DeviceCommissioner *>(context);
-    commissioner->mRootCertResponseCallback.Cancel();
-    commissioner->mOnRootCertFailureCallback.Cancel();
+    CommissioningContext * commissioningContext = static_cast<CommissioningContext *>(context);
+    commissioningContext->mRootCertResponseCallback.Cancel();
+    commissioningContext->mOnRootCertFailureCallback.Cancel();
     // TODO: Map error status to correct error code
-    commissioner->OnSessionEstablishmentError(CHIP_ERROR_INTERNAL);
+    commissioningContext->OnSessionEstablishmentError(CHIP_ERROR_INTERNAL);
 }
 
-CHIP_ERROR DeviceCommissioner::OnOperationalCredentialsProvisioningCompletion(CommissioneeDeviceProxy * device)
+CHIP_ERROR DeviceCommissioner::OnOperationalCredentialsProvisioningCompletion(CommissioningContext & context)
 {
+    CommissioneeDeviceProxy * device = context.mDevice;
     ChipLogProgress(Controller, "Operational credentials provisioned on device %p", device);
     VerifyOrReturnError(device != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
 
-    mSystemState->SystemLayer()->CancelTimer(OnSessionEstablishmentTimeoutCallback, this);
+    mSystemState->SystemLayer()->CancelTimer(OnSessionEstablishmentTimeoutCallback, &context);
 
     mPairedDevices.Insert(device->GetDeviceId());
     mPairedDevicesUpdated = true;
@@ -1510,7 +1737,7 @@ CHIP_ERROR DeviceCommissioner::OnOperationalCredentialsProvisioningCompletion(Co
     {
         mPairingDelegate->OnStatusUpdate(DevicePairingDelegate::SecurePairingSuccess);
     }
-    CommissioningStageComplete(CHIP_NO_ERROR);
+    CommissioningStageComplete(context, CHIP_NO_ERROR);
 
     return CHIP_NO_ERROR;
 }
@@ -1518,20 +1745,18 @@ CHIP_ERROR DeviceCommissioner::OnOperationalCredentialsProvisioningCompletion(Co
 #if CONFIG_NETWORK_LAYER_BLE
 CHIP_ERROR DeviceCommissioner::CloseBleConnection()
 {
-    // It is fine since we can only commission one device at the same time.
+    // It is fine since only one device can be commissioned over BLE at the same time.
     // We should be able to distinguish different BLE connections if we want
     // to commission multiple devices at the same time over BLE.
     return mSystemState->BleLayer()->CloseAllBleConnections();
 }
 #endif
 
-void DeviceCommissioner::OnSessionEstablishmentTimeout()
+void DeviceCommissioner::OnSessionEstablishmentTimeout(CommissioningContext & context)
 {
     VerifyOrReturn(mState == State::Initialized);
-    VerifyOrReturn(mDeviceBeingCommissioned != nullptr);
 
-    CommissioneeDeviceProxy * device = mDeviceBeingCommissioned;
-    StopPairing(device->GetDeviceId());
+    StopPairing(context.mNodeId);
 
     if (mPairingDelegate != nullptr)
     {
@@ -1541,7 +1766,8 @@ void DeviceCommissioner::OnSessionEstablishmentTimeout()
 
 void DeviceCommissioner::OnSessionEstablishmentTimeoutCallback(System::Layer * aLayer, void * aAppState)
 {
-    static_cast<DeviceCommissioner *>(aAppState)->OnSessionEstablishmentTimeout();
+    CommissioningContext * context = static_cast<CommissioningContext *>(aAppState);
+    context->mCommissioner->OnSessionEstablishmentTimeout(*context);
 }
 #if CHIP_DEVICE_CONFIG_ENABLE_DNSSD
 CHIP_ERROR DeviceCommissioner::DiscoverCommissionableNodes(Dnssd::DiscoveryFilter filter)
@@ -1608,26 +1834,36 @@ void DeviceCommissioner::OnNodeDiscoveryComplete(const chip::Dnssd::DiscoveredNo
 void BasicSuccess(void * context, uint16_t val)
 {
     ChipLogProgress(Controller, "Received success response 0x%x\n", val);
-    DeviceCommissioner * commissioner = static_cast<DeviceCommissioner *>(context);
-    commissioner->CommissioningStageComplete(CHIP_NO_ERROR);
+    DeviceCommissioner::CommissioningContext * commissioningContext = static_cast<DeviceCommissioner::CommissioningContext *>(context);
+    commissioningContext->mCommissioner->CommissioningStageComplete(*commissioningContext, CHIP_NO_ERROR);
 }
 
 void BasicFailure(void * context, uint8_t status)
 {
     ChipLogProgress(Controller, "Received failure response %d\n", (int) status);
-    DeviceCommissioner * commissioner = static_cast<DeviceCommissioner *>(context);
-    commissioner->OnSessionEstablishmentError(static_cast<CHIP_ERROR>(status));
+    DeviceCommissioner::CommissioningContext * commissioningContext = static_cast<DeviceCommissioner::CommissioningContext *>(context);
+    commissioningContext->OnSessionEstablishmentError(static_cast<CHIP_ERROR>(status));
 }
 
-void DeviceCommissioner::CommissioningStageComplete(CHIP_ERROR err)
+void DeviceCommissioner::CommissioningStageComplete(CommissioningContext & context, CHIP_ERROR err)
 {
-    if (mCommissioningDelegate == nullptr)
+    if (context.mCommissioningDelegate == nullptr)
     {
         return;
     }
     CommissioningDelegate::CommissioningReport report;
-    report.stageCompleted = mCommissioningStage;
-    mCommissioningDelegate->CommissioningStepFinished(err, report);
+    report.stageCompleted = context.mCommissioningStage;
+    report.stageDuration  = GetCommissioningStageDuration(context);
+    ChipLogProgress(Controller, "Commissioning stage %u of device 0x" ChipLogFormatX64 " completed in %" PRIu32 " ms: %s",
+                    static_cast<unsigned>(context.mCommissioningStage), ChipLogValueX64(context.mNodeId),
+                    report.stageDuration.count(), ErrorStr(err));
+    context.mCommissioningDelegate->CommissioningStepFinished(err, report);
+}
+
+System::Clock::Milliseconds32 DeviceCommissioner::GetCommissioningStageDuration(const CommissioningContext & context)
+{
+    return std::chrono::duration_cast<System::Clock::Milliseconds32>(System::SystemClock().GetMonotonicTimestamp() -
+                                                                     context.mCommissioningStageStartTime);
 }
 
 #if CHIP_DEVICE_CONFIG_ENABLE_DNSSD
@@ -1637,30 +1873,38 @@ void DeviceCommissioner::OnNodeIdResolved(const chip::Dnssd::ResolvedNodeData &
                     ChipLogValueX64(nodeData.mPeerId.GetNodeId()));
     VerifyOrReturn(mState == State::Initialized);
 
-    if (mDeviceBeingCommissioned != nullptr && mDeviceBeingCommissioned->GetDeviceId() == nodeData.mPeerId.GetNodeId())
+    Callback::Callback<OnDeviceConnected> * onConnection       = &mOnDeviceConnectedCallback;
+    Callback::Callback<OnDeviceConnectionFailure> * onFailure = &mOnDeviceConnectionFailureCallback;
+
+    CommissioningContext * context = FindCommissioningContext(nodeData.mPeerId.GetNodeId());
+    if (context != nullptr && context->mCommissioningStage == CommissioningStage::kFindOperational)
     {
-        RendezvousCleanup(CHIP_NO_ERROR);
         // Let's release the device that's being paired, if pairing was successful,
         // and the device is available on the operational network.
-        ReleaseCommissioneeDevice(mDeviceBeingCommissioned);
-        mDeviceBeingCommissioned = nullptr;
+        RendezvousCleanup(*context, CHIP_NO_ERROR);
+        onConnection = &context->mOnDeviceConnectedCallback;
+        onFailure    = &context->mOnDeviceConnectionFailureCallback;
+    }
+    else if (context != nullptr && context->mCommissioningStage == CommissioningStage::kSecurePairing &&
+             !context->mRunCommissioningAfterConnection)
+    {
+        // The device was paired without being commissioned, there is nothing left to do for it.
+        RendezvousCleanup(*context, CHIP_NO_ERROR);
+        ReleaseCommissioningContext(*context);
     }
 
     mDNSCache.Insert(nodeData);
 
-    mCASESessionManager->FindOrEstablishSession(nodeData.mPeerId, &mOnDeviceConnectedCallback, &mOnDeviceConnectionFailureCallback);
+    mCASESessionManager->FindOrEstablishSession(nodeData.mPeerId, onConnection, onFailure);
     DeviceController::OnNodeIdResolved(nodeData);
 }
 
 void DeviceCommissioner::OnNodeIdResolutionFailed(const chip::PeerId & peer, CHIP_ERROR error)
 {
-    if (mDeviceBeingCommissioned != nullptr)
+    CommissioningContext * context = FindCommissioningContext(peer.GetNodeId());
+    if (context != nullptr && context->mCommissioningStage == CommissioningStage::kFindOperational)
     {
-        CommissioneeDeviceProxy * device = mDeviceBeingCommissioned;
-        if (device->GetDeviceId() == peer.GetNodeId() && mCommissioningStage == CommissioningStage::kFindOperational)
-        {
-            OnSessionEstablishmentError(error);
-        }
+        OnSessionEstablishmentError(*context, error);
     }
     DeviceController::OnNodeIdResolutionFailed(peer, error);
 }
@@ -1671,23 +1915,9 @@ void DeviceCommissioner::OnDeviceConnectedFn(void * context, OperationalDevicePr
 {
     DeviceCommissioner * commissioner = static_cast<DeviceCommissioner *>(context);
     VerifyOrReturn(commissioner != nullptr, ChipLogProgress(Controller, "Device connected callback with null context. Ignoring"));
-
-    if (commissioner->mCommissioningStage == CommissioningStage::kFindOperational)
-    {
-        if (commissioner->mCommissioningDelegate != nullptr)
-        {
-            CommissioningDelegate::CommissioningReport report;
-            report.stageCompleted                            = CommissioningStage::kFindOperational;
-            report.OperationalNodeFoundData.operationalProxy = device;
-            commissioner->mCommissioningDelegate->CommissioningStepFinished(CHIP_NO_ERROR, report);
-        }
-    }
-    else
-    {
-        VerifyOrReturn(commissioner->mPairingDelegate != nullptr,
-                       ChipLogProgress(Controller, "Device connected callback with null pairing delegate. Ignoring"));
-        commissioner->mPairingDelegate->OnPairingComplete(CHIP_NO_ERROR);
-    }
+    VerifyOrReturn(commissioner->mPairingDelegate != nullptr,
+                   ChipLogProgress(Controller, "Device connected callback with null pairing delegate. Ignoring"));
+    commissioner->mPairingDelegate->OnPairingComplete(CHIP_NO_ERROR);
 }
 
 void DeviceCommissioner::OnDeviceConnectionFailureFn(void * context, PeerId peerId, CHIP_ERROR error)
@@ -1701,13 +1931,44 @@ void DeviceCommissioner::OnDeviceConnectionFailureFn(void * context, PeerId peer
     commissioner->mPairingDelegate->OnCommissioningComplete(peerId.GetNodeId(), error);
 }
 
+void DeviceCommissioner::OnCommissioneeConnectedFn(void * context, OperationalDeviceProxy * device)
+{
+    CommissioningContext * commissioningContext = static_cast<CommissioningContext *>(context);
+    VerifyOrReturn(commissioningContext->mCommissioningDelegate != nullptr,
+                   ChipLogProgress(Controller, "Device connected callback with null commissioning delegate. Ignoring"));
+
+    CommissioningDelegate::CommissioningReport report;
+    report.stageCompleted                            = CommissioningStage::kFindOperational;
+    report.stageDuration                             = GetCommissioningStageDuration(*commissioningContext);
+    report.OperationalNodeFoundData.operationalProxy = device;
+    commissioningContext->mCommissioningDelegate->CommissioningStepFinished(CHIP_NO_ERROR, report);
+}
+
+void DeviceCommissioner::OnCommissioneeConnectionFailureFn(void * context, PeerId peerId, CHIP_ERROR error)
+{
+    CommissioningContext * commissioningContext = static_cast<CommissioningContext *>(context);
+    DeviceCommissioner * commissioner           = commissioningContext->mCommissioner;
+    ChipLogProgress(Controller, "Device connection failed. Error %s", ErrorStr(error));
+
+    commissioner->ReleaseCommissioningContext(*commissioningContext);
+    VerifyOrReturn(commissioner->mPairingDelegate != nullptr,
+                   ChipLogProgress(Controller, "Device connection failure callback with null pairing delegate. Ignoring"));
+    commissioner->mPairingDelegate->OnCommissioningComplete(peerId.GetNodeId(), error);
+}
+
 void DeviceCommissioner::PerformCommissioningStep(DeviceProxy * proxy, CommissioningStage step, CommissioningParameters & params,
                                                   CommissioningDelegate * delegate)
 {
+    CommissioningContext * context = FindCommissioningContext(proxy->GetDeviceId());
+    VerifyOrReturn(context != nullptr,
+                   ChipLogError(Controller, "No commissioning in progress for device 0x" ChipLogFormatX64,
+                                ChipLogValueX64(proxy->GetDeviceId())));
+
     // For now, we ignore errors coming in from the device since not all commissioning clusters are implemented on the device
     // side.
-    mCommissioningStage    = step;
-    mCommissioningDelegate = delegate;
+    context->mCommissioningStage          = step;
+    context->mCommissioningDelegate       = delegate;
+    context->mCommissioningStageStartTime = System::SystemClock().GetMonotonicTimestamp();
 
     // TODO(cecille): We probably want something better than this for breadcrumbs.
     uint64_t breadcrumb = static_cast<uint64_t>(step);
@@ -1727,7 +1988,7 @@ void DeviceCommissioner::PerformCommissioningStep(DeviceProxy * proxy, Commissio
         genCom.Associate(proxy, 0);
         // TODO(cecille): Make this a parameter
         uint16_t commissioningExpirySeconds = 60;
-        genCom.ArmFailSafe(mSuccess.Cancel(), mFailure.Cancel(), commissioningExpirySeconds, breadcrumb, kCommandTimeoutMs);
+        genCom.ArmFailSafe(context->mSuccess.Cancel(), context->mFailure.Cancel(), commissioningExpirySeconds, breadcrumb, kCommandTimeoutMs);
     }
     break;
     case CommissioningStage::kConfigRegulatory: {
@@ -1768,20 +2029,19 @@ void DeviceCommissioner::PerformCommissioningStep(DeviceProxy * proxy, Commissio
 
         GeneralCommissioningCluster genCom;
         genCom.Associate(proxy, 0);
-        genCom.SetRegulatoryConfig(mSuccess.Cancel(), mFailure.Cancel(), regulatoryLocation, countryCode, breadcrumb,
+        genCom.SetRegulatoryConfig(context->mSuccess.Cancel(), context->mFailure.Cancel(), regulatoryLocation, countryCode, breadcrumb,
                                    kCommandTimeoutMs);
     }
     break;
     case CommissioningStage::kDeviceAttestation: {
         ChipLogProgress(Controller, "Exchanging vendor certificates");
         // TODO(cecille): Remove the certificates from the CommissioneeDeviceProxy and take from the commissioning parameters.
-        CHIP_ERROR status =
-            SendCertificateChainRequestCommand(reinterpret_cast<CommissioneeDeviceProxy *>(proxy), CertificateType::kPAI);
+        CHIP_ERROR status = SendCertificateChainRequestCommand(*context, CertificateType::kPAI);
         if (status != CHIP_NO_ERROR)
         {
             ChipLogError(Controller, "Failed in sending 'Certificate Chain Request' command to the device: err %s",
                          ErrorStr(status));
-            OnSessionEstablishmentError(status);
+            OnSessionEstablishmentError(*context, status);
             return;
         }
     }
@@ -1790,14 +2050,11 @@ void DeviceCommissioner::PerformCommissioningStep(DeviceProxy * proxy, Commissio
         ChipLogProgress(Controller, "Exchanging certificates");
         // TODO(cecille): Once this is implemented through the clusters, it should be moved to the proper stage and the callback
         // should advance the commissioning stage
-        // TODO(cecille): The pointer re-interpret here is ugly. Once these steps are moved into the commissioning state machine,
-        // the commissioning state machine can hold the parameters instead of the CommissioneeDeviceProxy and we can use the base
-        // class here.
-        CHIP_ERROR status = SendOperationalCertificateSigningRequestCommand(reinterpret_cast<CommissioneeDeviceProxy *>(proxy));
+        CHIP_ERROR status = SendOperationalCertificateSigningRequestCommand(*context);
         if (status != CHIP_NO_ERROR)
         {
             ChipLogError(Controller, "Failed in sending 'CSR Request' command to the device: err %s", ErrorStr(status));
-            OnSessionEstablishmentError(status);
+            OnSessionEstablishmentError(*context, status);
             return;
         }
     }
@@ -1813,13 +2070,13 @@ void DeviceCommissioner::PerformCommissioningStep(DeviceProxy * proxy, Commissio
         {
             CommissioningDelegate::CommissioningReport report;
             report.stageCompleted = step;
-            mCommissioningDelegate->CommissioningStepFinished(CHIP_ERROR_INVALID_ARGUMENT, report);
+            delegate->CommissioningStepFinished(CHIP_ERROR_INVALID_ARGUMENT, report);
             return;
         }
         ChipLogProgress(Controller, "Adding wifi network");
         NetworkCommissioningCluster netCom;
         netCom.Associate(proxy, 0);
-        netCom.AddOrUpdateWiFiNetwork(mSuccess.Cancel(), mFailure.Cancel(), params.GetWifiCredentials().Value().ssid,
+        netCom.AddOrUpdateWiFiNetwork(context->mSuccess.Cancel(), context->mFailure.Cancel(), params.GetWifiCredentials().Value().ssid,
                                       params.GetWifiCredentials().Value().credentials, breadcrumb);
     }
     break;
@@ -1828,13 +2085,13 @@ void DeviceCommissioner::PerformCommissioningStep(DeviceProxy * proxy, Commissio
         {
             CommissioningDelegate::CommissioningReport report;
             report.stageCompleted = step;
-            mCommissioningDelegate->CommissioningStepFinished(CHIP_ERROR_INVALID_ARGUMENT, report);
+            delegate->CommissioningStepFinished(CHIP_ERROR_INVALID_ARGUMENT, report);
             return;
         }
         ChipLogProgress(Controller, "Adding thread network");
         NetworkCommissioningCluster netCom;
         netCom.Associate(proxy, 0);
-        netCom.AddOrUpdateThreadNetwork(mSuccess.Cancel(), mFailure.Cancel(), params.GetThreadOperationalDataset().Value(),
+        netCom.AddOrUpdateThreadNetwork(context->mSuccess.Cancel(), context->mFailure.Cancel(), params.GetThreadOperationalDataset().Value(),
                                         breadcrumb);
     }
     break;
@@ -1843,13 +2100,13 @@ void DeviceCommissioner::PerformCommissioningStep(DeviceProxy * proxy, Commissio
         {
             CommissioningDelegate::CommissioningReport report;
             report.stageCompleted = step;
-            mCommissioningDelegate->CommissioningStepFinished(CHIP_ERROR_INVALID_ARGUMENT, report);
+            delegate->CommissioningStepFinished(CHIP_ERROR_INVALID_ARGUMENT, report);
             return;
         }
         ChipLogProgress(Controller, "Enabling wifi network");
         NetworkCommissioningCluster netCom;
         netCom.Associate(proxy, 0);
-        netCom.ConnectNetwork(mSuccess.Cancel(), mFailure.Cancel(), params.GetWifiCredentials().Value().ssid, breadcrumb);
+        netCom.ConnectNetwork(context->mSuccess.Cancel(), context->mFailure.Cancel(), params.GetWifiCredentials().Value().ssid, breadcrumb);
     }
     break;
     case CommissioningStage::kThreadNetworkEnable: {
@@ -1862,13 +2119,13 @@ void DeviceCommissioner::PerformCommissioningStep(DeviceProxy * proxy, Commissio
             ChipLogError(Controller, "Unable to get extended pan ID for thread operational dataset\n");
             CommissioningDelegate::CommissioningReport report;
             report.stageCompleted = step;
-            mCommissioningDelegate->CommissioningStepFinished(CHIP_ERROR_INVALID_ARGUMENT, report);
+            delegate->CommissioningStepFinished(CHIP_ERROR_INVALID_ARGUMENT, report);
             return;
         }
         ChipLogProgress(Controller, "Enabling thread network");
         NetworkCommissioningCluster netCom;
         netCom.Associate(proxy, 0);
-        netCom.ConnectNetwork(mSuccess.Cancel(), mFailure.Cancel(), extendedPanId, breadcrumb);
+        netCom.ConnectNetwork(context->mSuccess.Cancel(), context->mFailure.Cancel(), extendedPanId, breadcrumb);
     }
     break;
     case CommissioningStage::kFindOperational: {
@@ -1879,7 +2136,7 @@ void DeviceCommissioner::PerformCommissioningStep(DeviceProxy * proxy, Commissio
         ChipLogProgress(Controller, "Calling commissioning complete");
         GeneralCommissioningCluster genCom;
         genCom.Associate(proxy, 0);
-        genCom.CommissioningComplete(mSuccess.Cancel(), mFailure.Cancel());
+        genCom.CommissioningComplete(context->mSuccess.Cancel(), context->mFailure.Cancel());
     }
     break;
     case CommissioningStage::kCleanup:
@@ -1888,6 +2145,7 @@ void DeviceCommissioner::PerformCommissioningStep(DeviceProxy * proxy, Commissio
         {
             mPairingDelegate->OnCommissioningComplete(proxy->GetDeviceId(), CHIP_NO_ERROR);
         }
+        ReleaseCommissioningContext(*context);
         break;
     case CommissioningStage::kSecurePairing:
     case CommissioningStage::kError:
@@ -44,12 +44,14 @@
 #include <controller/SetUpCodePairer.h>
 #include <credentials/DeviceAttestationVerifier.h>
 #include <credentials/FabricTable.h>
+#include <crypto/CryptoJobQueue.h>
 #include <lib/core/CHIPConfig.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/CHIPPersistentStorageDelegate.h>
 #include <lib/core/CHIPTLV.h>
 #include <lib/support/DLLUtil.h>
 #include <lib/support/Pool.h>
+#include <lib/support/ScopedBuffer.h>
 #include <lib/support/SerializableIntegerSet.h>
 #include <lib/support/Span.h>
 #include <lib/support/ThreadOperationalDataset.h>
@@ -57,6 +59,7 @@
 #include <protocols/secure_channel/MessageCounterManager.h>
 #include <protocols/secure_channel/RendezvousParameters.h>
 #include <protocols/user_directed_commissioning/UserDirectedCommissioning.h>
+#include <system/SystemClock.h>
 #include <transport/SessionManager.h>
 #include <transport/TransportMgr.h>
 #include <transport/raw/UDP.h>
@@ -83,7 +86,8 @@ namespace Controller {
 
 using namespace chip::Protocols::UserDirectedCommissioning;
 
-constexpr uint16_t kNumMaxActiveDevices = CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_DEVICES;
+constexpr uint16_t kNumMaxActiveDevices       = CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_DEVICES;
+constexpr uint16_t kNumMaxActiveCommissionees = CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_COMMISSIONEES;
 constexpr uint16_t kNumMaxPairedDevices = 128;
 
 // Raw functions for cluster callbacks
@@ -427,13 +431,16 @@ private:
  *   The commissioner applications can use this class to pair new/unpaired CHIP devices. The application is
  *   required to provide write access to the persistent storage, where the paired device information
  *   will be stored.
+ *
+ *   Up to kNumMaxActiveCommissionees devices can be commissioned at the same time, each going through the
+ *   commissioning stages on its own. Only one of them can use BLE rendezvous at a time.
  */
-class DLL_EXPORT DeviceCommissioner : public DeviceController,
+class DLL_EXPORT DeviceCommissioner : public DeviceController
 #if CHIP_DEVICE_CONFIG_ENABLE_COMMISSIONER_DISCOVERY // make this commissioner discoverable
+                                      ,
                                       public Protocols::UserDirectedCommissioning::InstanceNameResolver,
-                                      public Protocols::UserDirectedCommissioning::UserConfirmationProvider,
+                                      public Protocols::UserDirectedCommissioning::UserConfirmationProvider
 #endif
-                                      public SessionEstablishmentDelegate
 {
 public:
     DeviceCommissioner();
@@ -558,17 +565,20 @@ public:
      */
     CHIP_ERROR UnpairDevice(NodeId remoteDeviceId);
 
-    //////////// SessionEstablishmentDelegate Implementation ///////////////
-    void OnSessionEstablishmentError(CHIP_ERROR error) override;
-    void OnSessionEstablished() override;
-
-    void RendezvousCleanup(CHIP_ERROR status);
-
+    /**
+     * @brief
+     *   Run a commissioning stage on a device being commissioned. The stage completion is reported to the delegate
+     *   through CommissioningDelegate::CommissioningStepFinished.
+     *
+     * @param[in] device    The device, either the commissionee or, once found on the operational network, its
+     *                      operational proxy.
+     * @param[in] step      The stage to run.
+     * @param[in] params    The commissioning parameters.
+     * @param[in] delegate  The delegate to report the stage completion to.
+     */
     void PerformCommissioningStep(DeviceProxy * device, CommissioningStage step, CommissioningParameters & params,
                                   CommissioningDelegate * delegate);
 
-    void CommissioningStageComplete(CHIP_ERROR err);
-
 #if CONFIG_NETWORK_LAYER_BLE
     /**
      * @brief
@@ -652,27 +662,85 @@ public:
     void RegisterPairingDelegate(DevicePairingDelegate * pairingDelegate) { mPairingDelegate = pairingDelegate; }
 
 private:
-    DevicePairingDelegate * mPairingDelegate;
+    class AttestationVerificationJob;
+
+    /**
+     * @brief
+     *   The state of a device being commissioned, from the PASE session establishment up to the end of its
+     *   commissioning. The cluster callbacks of a commissionee get its context as their context, so that the
+     *   commissionees advance through the commissioning stages independently of each other.
+     */
+    class CommissioningContext : public SessionEstablishmentDelegate
+    {
+    public:
+        CommissioningContext(DeviceCommissioner * commissioner, CommissioneeDeviceProxy * device, bool isIPRendezvous);
+
+        //////////// SessionEstablishmentDelegate Implementation ///////////////
+        void OnSessionEstablishmentError(CHIP_ERROR error) override;
+        void OnSessionEstablished() override;
+
+        DeviceCommissioner * const mCommissioner;
+
+        // The commissionee, released once the device is found on the operational network.
+        CommissioneeDeviceProxy * mDevice;
+        const NodeId mNodeId;
+
+        /* TODO: BLE rendezvous and IP rendezvous should share the same procedure, so this is just a
+           workaround-like flag and should be removed in the future.
+           When using IP rendezvous, we need to disable network provisioning. In the future, network
+           provisioning will no longer be a part of rendezvous procedure. */
+        const bool mIsIPRendezvous;
 
-    CommissioneeDeviceProxy * mDeviceBeingCommissioned = nullptr;
+        CommissioningStage mCommissioningStage = CommissioningStage::kSecurePairing;
+        bool mRunCommissioningAfterConnection  = false;
 
-    Credentials::CertificateType mCertificateTypeBeingRequested = Credentials::CertificateType::kUnknown;
+        System::Clock::Timestamp mCommissioningStageStartTime = System::Clock::kZero;
 
-    /* TODO: BLE rendezvous and IP rendezvous should share the same procedure, so this is just a
-       workaround-like flag and should be removed in the future.
-       When using IP rendezvous, we need to disable network provisioning. In the future, network
-       provisioning will no longer be a part of rendezvous procedure. */
-    bool mIsIPRendezvous;
+        CommissioningDelegate * mCommissioningDelegate = nullptr;
+        AutoCommissioner mAutoCommissioner;
+
+        Credentials::CertificateType mCertificateTypeBeingRequested = Credentials::CertificateType::kUnknown;
+
+        // The CSR is requested while the attestation information is verified, but the NOC is only requested once the
+        // verification completes. A CSR received before then is kept in mPendingOpCSR.
+        AttestationVerificationJob * mAttestationVerificationJob = nullptr;
+        Platform::ScopedMemoryBuffer<uint8_t> mPendingOpCSR;
+        size_t mPendingNOCSRElementsLen        = 0;
+        size_t mPendingAttestationSignatureLen = 0;
+
+        // Cluster callbacks for advancing commissioning flows
+        Callback::Callback<BasicSuccessCallback> mSuccess;
+        Callback::Callback<BasicFailureCallback> mFailure;
+
+        Callback::Callback<OperationalCredentialsClusterCertificateChainResponseCallback> mCertificateChainResponseCallback;
+        Callback::Callback<OperationalCredentialsClusterAttestationResponseCallback> mAttestationResponseCallback;
+        Callback::Callback<OperationalCredentialsClusterOpCSRResponseCallback> mOpCSRResponseCallback;
+        Callback::Callback<OperationalCredentialsClusterNOCResponseCallback> mNOCResponseCallback;
+        Callback::Callback<DefaultSuccessCallback> mRootCertResponseCallback;
+        Callback::Callback<DefaultFailureCallback> mOnCertificateChainFailureCallback;
+        Callback::Callback<DefaultFailureCallback> mOnAttestationFailureCallback;
+        Callback::Callback<DefaultFailureCallback> mOnCSRFailureCallback;
+        Callback::Callback<DefaultFailureCallback> mOnCertFailureCallback;
+        Callback::Callback<DefaultFailureCallback> mOnRootCertFailureCallback;
+
+        Callback::Callback<OnDeviceConnected> mOnDeviceConnectedCallback;
+        Callback::Callback<OnDeviceConnectionFailure> mOnDeviceConnectionFailureCallback;
+
+        Callback::Callback<OnNOCChainGeneration> mDeviceNOCChainCallback;
+    };
+
+    friend void BasicSuccess(void * context, uint16_t val);
+    friend void BasicFailure(void * context, uint8_t status);
+
+    DevicePairingDelegate * mPairingDelegate;
 
     /* This field is true when device pairing information changes, e.g. a new device is paired, or
        the pairing for a device is removed. The DeviceCommissioner uses this to decide when to
        persist the device list */
     bool mPairedDevicesUpdated;
 
-    CommissioningStage mCommissioningStage = CommissioningStage::kSecurePairing;
-    bool mRunCommissioningAfterConnection  = false;
-
     BitMapObjectPool<CommissioneeDeviceProxy, kNumMaxActiveDevices> mCommissioneeDevicePool;
+    BitMapObjectPool<CommissioningContext, kNumMaxActiveCommissionees> mCommissioningContextPool;
 
 #if CHIP_DEVICE_CONFIG_ENABLE_COMMISSIONER_DISCOVERY // make this commissioner discoverable
     UserDirectedCommissioningServer * mUdcServer = nullptr;
@@ -685,40 +753,44 @@ private:
 
     CHIP_ERROR LoadKeyId(PersistentStorageDelegate * delegate, uint16_t & out);
 
-    void OnSessionEstablishmentTimeout();
+    void OnSessionEstablishmentError(CommissioningContext & context, CHIP_ERROR error);
+    void OnSessionEstablished(CommissioningContext & context);
+    void RendezvousCleanup(CommissioningContext & context, CHIP_ERROR status);
+    void CommissioningStageComplete(CommissioningContext & context, CHIP_ERROR err);
+
+    void OnSessionEstablishmentTimeout(CommissioningContext & context);
 
     //////////// SessionReleaseDelegate Implementation ///////////////
     void OnSessionReleased(const SessionHandle & session) override;
 
     static void OnSessionEstablishmentTimeoutCallback(System::Layer * aLayer, void * aAppState);
 
-    /* This function sends a Device Attestation Certificate chain request to the device.
+    /* This function sends a Device Attestation Certificate chain request to the commissionee.
        The function does not hold a reference to the device object.
      */
-    CHIP_ERROR SendCertificateChainRequestCommand(CommissioneeDeviceProxy * device, Credentials::CertificateType certificateType);
-    /* This function sends an Attestation request to the device.
+    CHIP_ERROR SendCertificateChainRequestCommand(CommissioningContext & context, Credentials::CertificateType certificateType);
+    /* This function sends an Attestation request to the commissionee.
        The function does not hold a reference to the device object.
      */
-    CHIP_ERROR SendAttestationRequestCommand(CommissioneeDeviceProxy * device, const ByteSpan & attestationNonce);
-    /* This function sends an OpCSR request to the device.
+    CHIP_ERROR SendAttestationRequestCommand(CommissioningContext & context, const ByteSpan & attestationNonce);
+    /* This function sends an OpCSR request to the commissionee.
        The function does not hold a reference to the device object.
      */
-    CHIP_ERROR SendOperationalCertificateSigningRequestCommand(CommissioneeDeviceProxy * device);
-    /* This function sends the operational credentials to the device.
+    CHIP_ERROR SendOperationalCertificateSigningRequestCommand(CommissioningContext & context);
+    /* This function sends the operational credentials to the commissionee.
        The function does not hold a reference to the device object.
      */
-    CHIP_ERROR SendOperationalCertificate(CommissioneeDeviceProxy * device, const ByteSpan & nocCertBuf,
-                                          const ByteSpan & icaCertBuf);
-    /* This function sends the trusted root certificate to the device.
+    CHIP_ERROR SendOperationalCertificate(CommissioningContext & context, const ByteSpan & nocCertBuf, const ByteSpan & icaCertBuf);
+    /* This function sends the trusted root certificate to the commissionee.
        The function does not hold a reference to the device object.
      */
-    CHIP_ERROR SendTrustedRootCertificate(CommissioneeDeviceProxy * device, const ByteSpan & rcac);
+    CHIP_ERROR SendTrustedRootCertificate(CommissioningContext & context, const ByteSpan & rcac);
 
-    /* This function is called by the commissioner code when the device completes
+    /* This function is called by the commissioner code when the commissionee completes
        the operational credential provisioning process.
        The function does not hold a reference to the device object.
        */
-    CHIP_ERROR OnOperationalCredentialsProvisioningCompletion(CommissioneeDeviceProxy * device);
+    CHIP_ERROR OnOperationalCredentialsProvisioningCompletion(CommissioningContext & context);
 
     /* Callback when the previously sent CSR request results in failure */
     static void OnCSRFailureResponse(void * context, uint8_t status);
@@ -753,6 +825,10 @@ private:
     static void OnDeviceConnectedFn(void * context, OperationalDeviceProxy * device);
     static void OnDeviceConnectionFailureFn(void * context, PeerId peerId, CHIP_ERROR error);
 
+    /* Callbacks when a commissionee is connected to, or fails to be connected to, on the operational network */
+    static void OnCommissioneeConnectedFn(void * context, OperationalDeviceProxy * device);
+    static void OnCommissioneeConnectionFailureFn(void * context, PeerId peerId, CHIP_ERROR error);
+
     static void OnDeviceNOCChainGeneration(void * context, CHIP_ERROR status, const ByteSpan & noc, const ByteSpan & icac,
                                            const ByteSpan & rcac);
 
@@ -761,56 +837,60 @@ private:
      *   This function processes the CSR sent by the device.
      *   (Reference: Specifications section 11.22.5.8. OpCSR Elements)
      *
-     * @param[in] NOCSRElements   CSR elements as per specifications section 11.22.5.6. NOCSR Elements.
-     * @param[in] AttestationSignature       Cryptographic signature generated for all the above fields.
+     * @param[in] context                The commissioning context of the device.
+     * @param[in] NOCSRElements          CSR elements as per specifications section 11.22.5.6. NOCSR Elements.
+     * @param[in] AttestationSignature   Cryptographic signature generated for all the above fields.
      */
-    CHIP_ERROR ProcessOpCSR(const ByteSpan & NOCSRElements, const ByteSpan & AttestationSignature);
+    CHIP_ERROR ProcessOpCSR(CommissioningContext & context, const ByteSpan & NOCSRElements, const ByteSpan & AttestationSignature);
 
     /**
      * @brief
      *   This function processes the DAC or PAI certificate sent by the device.
      */
-    CHIP_ERROR ProcessCertificateChain(const ByteSpan & certificate);
+    CHIP_ERROR ProcessCertificateChain(CommissioningContext & context, const ByteSpan & certificate);
 
     /**
      * @brief
      *   This function validates the Attestation Information sent by the device.
      *
+     *   When a crypto job queue is running, the verification is posted to it and @a pending is set. The result
+     *   is then handled by OnAttestationVerificationComplete() on the CHIP thread.
+     *
+     * @param[in] context             The commissioning context of the device.
      * @param[in] attestationElements Attestation Elements TLV.
      * @param[in] signature           Attestation signature generated for all the above fields + Attestation Challenge.
+     * @param[out] pending            Whether the verification is still running.
      */
-    CHIP_ERROR ValidateAttestationInfo(const ByteSpan & attestationElements, const ByteSpan & signature);
+    CHIP_ERROR ValidateAttestationInfo(CommissioningContext & context, const ByteSpan & attestationElements,
+                                       const ByteSpan & signature, bool & pending);
 
-    void HandleAttestationResult(CHIP_ERROR err);
+    static CHIP_ERROR ConvertFromAttestationVerificationResult(Credentials::AttestationVerificationResult result);
+
+    void HandleAttestationResult(CommissioningContext & context, CHIP_ERROR err);
+    void OnAttestationVerificationComplete(CommissioningContext & context, AttestationVerificationJob & job);
+    void CancelAttestationVerification(CommissioningContext & context);
+
+    /* This function sends the OpCSR request once the attestation information is received,
+       and ends commissioning if it can't be sent. */
+    void RequestOperationalCSR(CommissioningContext & context);
+
+    /* Returns the time spent in the current commissioning stage of the device so far. */
+    static System::Clock::Milliseconds32 GetCommissioningStageDuration(const CommissioningContext & context);
 
     CommissioneeDeviceProxy * FindCommissioneeDevice(const SessionHandle & session);
     CommissioneeDeviceProxy * FindCommissioneeDevice(NodeId id);
     void ReleaseCommissioneeDevice(CommissioneeDeviceProxy * device);
 
-    // Cluster callbacks for advancing commissioning flows
-    Callback::Callback<BasicSuccessCallback> mSuccess;
-    Callback::Callback<BasicFailureCallback> mFailure;
+    CommissioningContext * FindCommissioningContext(NodeId id);
+    void ReleaseCommissioningContext(CommissioningContext & context);
 
     static CHIP_ERROR ConvertFromNodeOperationalCertStatus(uint8_t err);
 
-    Callback::Callback<OperationalCredentialsClusterCertificateChainResponseCallback> mCertificateChainResponseCallback;
-    Callback::Callback<OperationalCredentialsClusterAttestationResponseCallback> mAttestationResponseCallback;
-    Callback::Callback<OperationalCredentialsClusterOpCSRResponseCallback> mOpCSRResponseCallback;
-    Callback::Callback<OperationalCredentialsClusterNOCResponseCallback> mNOCResponseCallback;
-    Callback::Callback<DefaultSuccessCallback> mRootCertResponseCallback;
-    Callback::Callback<DefaultFailureCallback> mOnCertificateChainFailureCallback;
-    Callback::Callback<DefaultFailureCallback> mOnAttestationFailureCallback;
-    Callback::Callback<DefaultFailureCallback> mOnCSRFailureCallback;
-    Callback::Callback<DefaultFailureCallback> mOnCertFailureCallback;
-    Callback::Callback<DefaultFailureCallback> mOnRootCertFailureCallback;
-
+    // Connection callbacks for devices resolved on the operational network outside of their commissioning
     Callback::Callback<OnDeviceConnected> mOnDeviceConnectedCallback;
     Callback::Callback<OnDeviceConnectionFailure> mOnDeviceConnectionFailureCallback;
 
-    Callback::Callback<OnNOCChainGeneration> mDeviceNOCChainCallback;
     SetUpCodePairer mSetUpCodePairer;
-    AutoCommissioner mAutoCommissioner;
-    CommissioningDelegate * mCommissioningDelegate = nullptr;
 };
 
 } // namespace Controller
@@ -19,6 +19,7 @@
 #pragma once
 #include <app/OperationalDeviceProxy.h>
 #include <controller/CommissioneeDeviceProxy.h>
+#include <system/SystemClock.h>
 
 namespace chip {
 namespace Controller {
@@ -106,6 +107,8 @@ public:
     struct CommissioningReport
     {
         CommissioningStage stageCompleted;
+        // Time between the start of the stage and its completion.
+        System::Clock::Milliseconds32 stageDuration = System::Clock::kZero;
         // TODO: Add other things the delegate needs to know.
         union
         {
@@ -25,6 +25,8 @@
 #include <app/WriteClient.h>
 #include <lib/support/CodeUtils.h>
 
+#include <chip/tlv/PickleEncoder.h>
+
 #include <cstdio>
 #include <lib/support/logging/CHIPLogging.h>
 
@@ -50,13 +52,13 @@ struct __attribute__((packed)) EventPath
     chip::EventId eventId;
 };
 
-using OnReadAttributeDataCallback       = void (*)(PyObject * appContext, chip::EndpointId endpointId, chip::ClusterId clusterId,
-                                             chip::AttributeId attributeId,
-                                             std::underlying_type_t<Protocols::InteractionModel::Status> imstatus, uint8_t * data,
-                                             uint32_t dataLen);
+// Delivers all the attributes of a report at once, as a pickled list of (endpointId, clusterId, attributeId, imstatus, value)
+// tuples.
+using OnReadAttributeDataCallback       = void (*)(PyObject * appContext, const uint8_t * report, uint32_t reportLen);
+// The event data is a pickled value.
 using OnReadEventDataCallback           = void (*)(PyObject * appContext, chip::EndpointId endpointId, chip::ClusterId clusterId,
                                          chip::EventId eventId, chip::EventNumber eventNumber, uint8_t priority, uint64_t timestamp,
-                                         uint8_t timestampType, uint8_t * data, uint32_t dataLen);
+                                         uint8_t timestampType, const uint8_t * data, uint32_t dataLen);
 using OnSubscriptionEstablishedCallback = void (*)(PyObject * appContext, uint64_t subscriptionId);
 using OnReadErrorCallback               = void (*)(PyObject * appContext, uint32_t chiperror);
 using OnReadDoneCallback                = void (*)(PyObject * appContext);
@@ -86,31 +88,33 @@ public:
         // callback. If we do, that's a bug.
         //
         VerifyOrDie(!aPath.IsListItemOperation());
-        size_t bufferLen                  = (apData == nullptr ? 0 : apData->GetRemainingLength() + apData->GetLengthRead());
-        std::unique_ptr<uint8_t[]> buffer = std::unique_ptr<uint8_t[]>(apData == nullptr ? nullptr : new uint8_t[bufferLen]);
-        uint32_t size                     = 0;
+
+        // The attributes are decoded here and handed over to Python in a single call at the end of the report.
+        size_t position = mReport.Position();
+        mReport.StartTuple();
+        mReport.PutInt(aPath.mEndpointId);
+        mReport.PutInt(aPath.mClusterId);
+        mReport.PutInt(aPath.mAttributeId);
+        mReport.PutInt(to_underlying(aStatus.mStatus));
         // When the apData is nullptr, means we did not receive a valid attribute data from server, status will be some error
         // status.
         if (apData != nullptr)
         {
-            // The TLVReader's read head is not pointing to the first element in the container instead of the container itself, use
-            // a TLVWriter to get a TLV with a normalized TLV buffer (Wrapped with a anonymous tag, no extra "end of container" tag
-            // at the end.)
-            TLV::TLVWriter writer;
-            writer.Init(buffer.get(), bufferLen);
-            CHIP_ERROR err = writer.CopyElement(TLV::AnonymousTag(), *apData);
+            TLV::TLVReader reader;
+            reader.Init(*apData);
+            CHIP_ERROR err = mReport.PutTLVElement(reader);
             if (err != CHIP_NO_ERROR)
             {
-                app::StatusIB status;
-                status.mStatus = Protocols::InteractionModel::Status::Failure;
+                mReport.Truncate(position);
                 this->OnError(apReadClient, err);
                 return;
             }
-            size = writer.GetLengthWritten();
         }
-
-        gOnReadAttributeDataCallback(mAppContext, aPath.mEndpointId, aPath.mClusterId, aPath.mAttributeId,
-                                     to_underlying(aStatus.mStatus), buffer.get(), size);
+        else
+        {
+            mReport.PutNone();
+        }
+        mReport.EndTuple();
     }
 
     void OnSubscriptionEstablished(const ReadClient * apReadClient) override
@@ -121,48 +125,66 @@ public:
     void OnEventData(const ReadClient * apReadClient, const EventHeader & aEventHeader, TLV::TLVReader * apData,
                      const StatusIB * apStatus) override
     {
-        uint8_t buffer[CHIP_CONFIG_DEFAULT_UDP_MTU_SIZE];
-        uint32_t size  = 0;
+        PickleEncoder encoder;
         CHIP_ERROR err = CHIP_NO_ERROR;
+
+        encoder.Reset();
         // When the apData is nullptr, means we did not receive a valid event data from server, status will be some error
         // status.
         if (apData != nullptr)
         {
-            // The TLVReader's read head is not pointing to the first element in the container instead of the container itself, use
-            // a TLVWriter to get a TLV with a normalized TLV buffer (Wrapped with a anonymous tag, no extra "end of container" tag
-            // at the end.)
-            TLV::TLVWriter writer;
-            writer.Init(buffer);
-            err = writer.CopyElement(TLV::AnonymousTag(), *apData);
+            TLV::TLVReader reader;
+            reader.Init(*apData);
+            err = encoder.PutTLVElement(reader);
             if (err != CHIP_NO_ERROR)
             {
                 this->OnError(apReadClient, err);
                 return;
             }
-            size = writer.GetLengthWritten();
         }
         else
         {
             err = CHIP_ERROR_INCORRECT_STATE;
             this->OnError(apReadClient, err);
+            encoder.PutNone();
         }
+        encoder.Finish();
 
         gOnReadEventDataCallback(mAppContext, aEventHeader.mPath.mEndpointId, aEventHeader.mPath.mClusterId,
                                  aEventHeader.mPath.mEventId, aEventHeader.mEventNumber, to_underlying(aEventHeader.mPriorityLevel),
-                                 aEventHeader.mTimestamp.mValue, to_underlying(aEventHeader.mTimestamp.mType), buffer, size);
+                                 aEventHeader.mTimestamp.mValue, to_underlying(aEventHeader.mTimestamp.mType), encoder.Data(),
+                                 static_cast<uint32_t>(encoder.Length()));
     }
 
     void OnError(const ReadClient * apReadClient, CHIP_ERROR aError) override
     {
+        // Hand the attributes received so far over before the error. The report may go on after an error, in which case
+        // its remaining attributes are collected again and handed over at the end of the report.
+        const bool inReport = mReportInProgress;
+        FlushReport();
         gOnReadErrorCallback(mAppContext, aError.AsInteger());
+        if (inReport)
+        {
+            StartReport();
+        }
     }
 
-    void OnReportBegin(const ReadClient * apReadClient) override { gOnReportBeginCallback(mAppContext); }
+    void OnReportBegin(const ReadClient * apReadClient) override
+    {
+        StartReport();
+        gOnReportBeginCallback(mAppContext);
+    }
 
-    void OnReportEnd(const ReadClient * apReadClient) override { gOnReportEndCallback(mAppContext); }
+    void OnReportEnd(const ReadClient * apReadClient) override
+    {
+        FlushReport();
+        gOnReportEndCallback(mAppContext);
+    }
 
     void OnDone(ReadClient * apReadClient) override
     {
+        // A report cut short by the end of the interaction does not get its OnReportEnd.
+        FlushReport();
         gOnReadDoneCallback(mAppContext);
 
         delete apReadClient;
@@ -170,7 +192,26 @@ public:
     };
 
 private:
+    void StartReport()
+    {
+        mReport.Reset();
+        mReport.StartList();
+        mReportInProgress = true;
+    }
+
+    // Hand the attributes collected since StartReport over to Python, if there is a report in progress.
+    void FlushReport()
+    {
+        VerifyOrReturn(mReportInProgress);
+        mReportInProgress = false;
+        mReport.EndList();
+        mReport.Finish();
+        gOnReadAttributeDataCallback(mAppContext, mReport.Data(), static_cast<uint32_t>(mReport.Length()));
+    }
+
     BufferedReadCallback mBufferedReadCallback;
+    PickleEncoder mReport;
+    bool mReportInProgress = false;
     PyObject * mAppContext;
 };
 
@@ -0,0 +1,420 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "PickleEncoder.h"
+
+#include <cstring>
+
+#include <lib/core/CHIPSafeCasts.h>
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace python {
+
+namespace {
+
+// Opcodes of the pickle protocol, see Lib/pickletools.py in the CPython sources.
+constexpr uint8_t kProto      = 0x80;
+constexpr uint8_t kStop       = '.';
+constexpr uint8_t kPop        = '0';
+constexpr uint8_t kMark       = '(';
+constexpr uint8_t kNone       = 'N';
+constexpr uint8_t kNewTrue    = 0x88;
+constexpr uint8_t kNewFalse   = 0x89;
+constexpr uint8_t kBinInt     = 'J';
+constexpr uint8_t kBinInt1    = 'K';
+constexpr uint8_t kBinInt2    = 'M';
+constexpr uint8_t kLong1      = 0x8a;
+constexpr uint8_t kBinFloat   = 'G';
+constexpr uint8_t kBinUnicode = 'X';
+constexpr uint8_t kBinBytes   = 'B';
+constexpr uint8_t kEmptyList  = ']';
+constexpr uint8_t kAppends    = 'e';
+constexpr uint8_t kEmptyDict  = '}';
+constexpr uint8_t kSetItems   = 'u';
+constexpr uint8_t kTuple      = 't';
+constexpr uint8_t kTuple1     = 0x85;
+constexpr uint8_t kTuple2     = 0x86;
+constexpr uint8_t kGlobal     = 'c';
+constexpr uint8_t kBinPut     = 'q';
+constexpr uint8_t kBinGet     = 'h';
+constexpr uint8_t kReduce     = 'R';
+
+constexpr uint8_t kProtocolVersion = 3;
+
+// Memo slot holding chip.tlv.uint, which unsigned integers are wrapped in.
+constexpr uint8_t kUintMemoIndex = 0;
+constexpr char kUintGlobal[]     = "chip.tlv\nuint\n";
+
+// chip.tlv.TLVReader stores an anonymous member of a structure under this key.
+constexpr char kAnonymousTagKey[] = "Any";
+
+// Strict UTF-8 validation, matching what str(value, "utf-8") accepts: no overlong encodings, no surrogates and nothing
+// above U+10FFFF.
+bool IsValidUtf8(const uint8_t * data, size_t length)
+{
+    size_t i = 0;
+    while (i < length)
+    {
+        uint8_t lead = data[i];
+        size_t count;
+        uint8_t min = 0x80;
+        uint8_t max = 0xBF;
+
+        if (lead < 0x80)
+        {
+            i++;
+            continue;
+        }
+        else if (lead >= 0xC2 && lead <= 0xDF)
+        {
+            count = 1;
+        }
+        else if (lead >= 0xE0 && lead <= 0xEF)
+        {
+            count = 2;
+            min   = (lead == 0xE0) ? 0xA0 : 0x80;
+            max   = (lead == 0xED) ? 0x9F : 0xBF;
+        }
+        else if (lead >= 0xF0 && lead <= 0xF4)
+        {
+            count = 3;
+            min   = (lead == 0xF0) ? 0x90 : 0x80;
+            max   = (lead == 0xF4) ? 0x8F : 0xBF;
+        }
+        else
+        {
+            return false;
+        }
+
+        if (length - i <= count || data[i + 1] < min || data[i + 1] > max)
+        {
+            return false;
+        }
+        for (size_t j = 2; j <= count; j++)
+        {
+            if ((data[i + j] & 0xC0) != 0x80)
+            {
+                return false;
+            }
+        }
+        i += count + 1;
+    }
+
+    return true;
+}
+
+} // namespace
+
+void PickleEncoder::Reset()
+{
+    mBuffer.clear();
+
+    const uint8_t proto[] = { kProto, kProtocolVersion };
+    mBuffer.insert(mBuffer.end(), proto, proto + sizeof(proto));
+
+    // Look chip.tlv.uint up once and keep it in the memo for all the unsigned integers of the stream.
+    PutOpcode(kGlobal);
+    mBuffer.insert(mBuffer.end(), kUintGlobal, kUintGlobal + sizeof(kUintGlobal) - 1);
+    PutOpcode(kBinPut);
+    PutByte(kUintMemoIndex);
+    PutOpcode(kPop);
+}
+
+void PickleEncoder::Finish()
+{
+    PutOpcode(kStop);
+}
+
+void PickleEncoder::PutNone()
+{
+    PutOpcode(kNone);
+}
+
+void PickleEncoder::PutBool(bool value)
+{
+    PutOpcode(value ? kNewTrue : kNewFalse);
+}
+
+void PickleEncoder::PutInt(int64_t value)
+{
+    if (value >= 0 && value <= UINT8_MAX)
+    {
+        PutOpcode(kBinInt1);
+        PutLittleEndian(static_cast<uint64_t>(value), 1);
+    }
+    else if (value >= 0 && value <= UINT16_MAX)
+    {
+        PutOpcode(kBinInt2);
+        PutLittleEndian(static_cast<uint64_t>(value), 2);
+    }
+    else if (value >= INT32_MIN && value <= INT32_MAX)
+    {
+        PutOpcode(kBinInt);
+        PutLittleEndian(static_cast<uint64_t>(value), 4);
+    }
+    else
+    {
+        // Little endian two's complement of the given length.
+        PutOpcode(kLong1);
+        PutByte(8);
+        PutLittleEndian(static_cast<uint64_t>(value), 8);
+    }
+}
+
+void PickleEncoder::PutUnsignedInt(uint64_t value)
+{
+    // uint(value)
+    PutOpcode(kBinGet);
+    PutByte(kUintMemoIndex);
+    if (value <= INT64_MAX)
+    {
+        PutInt(static_cast<int64_t>(value));
+    }
+    else
+    {
+        // The extra byte keeps the sign bit clear.
+        PutOpcode(kLong1);
+        PutByte(9);
+        PutLittleEndian(value, 8);
+        PutByte(0);
+    }
+    PutOpcode(kTuple1);
+    PutOpcode(kReduce);
+}
+
+void PickleEncoder::PutDouble(double value)
+{
+    uint64_t bits;
+    static_assert(sizeof(bits) == sizeof(value), "Unexpected size of double");
+    memcpy(&bits, &value, sizeof(bits));
+
+    // Floats are big endian.
+    PutOpcode(kBinFloat);
+    for (int shift = 56; shift >= 0; shift -= 8)
+    {
+        PutByte(static_cast<uint8_t>(bits >> shift));
+    }
+}
+
+void PickleEncoder::PutString(CharSpan value)
+{
+    PutSized(kBinUnicode, Uint8::from_const_char(value.data()), value.size());
+}
+
+void PickleEncoder::PutBytes(ByteSpan value)
+{
+    PutSized(kBinBytes, value.data(), value.size());
+}
+
+void PickleEncoder::StartList()
+{
+    PutOpcode(kEmptyList);
+    PutOpcode(kMark);
+}
+
+void PickleEncoder::EndList()
+{
+    PutOpcode(kAppends);
+}
+
+void PickleEncoder::StartTuple()
+{
+    PutOpcode(kMark);
+}
+
+void PickleEncoder::EndTuple()
+{
+    PutOpcode(kTuple);
+}
+
+CHIP_ERROR PickleEncoder::PutTLVElement(TLV::TLVReader & reader)
+{
+    switch (reader.GetType())
+    {
+    case TLV::kTLVType_SignedInteger: {
+        int64_t value;
+        ReturnErrorOnFailure(reader.Get(value));
+        PutInt(value);
+        break;
+    }
+    case TLV::kTLVType_UnsignedInteger: {
+        uint64_t value;
+        ReturnErrorOnFailure(reader.Get(value));
+        PutUnsignedInt(value);
+        break;
+    }
+    case TLV::kTLVType_Boolean: {
+        bool value;
+        ReturnErrorOnFailure(reader.Get(value));
+        PutBool(value);
+        break;
+    }
+    case TLV::kTLVType_FloatingPointNumber: {
+        double value;
+        ReturnErrorOnFailure(reader.Get(value));
+        PutDouble(value);
+        break;
+    }
+    case TLV::kTLVType_UTF8String: {
+        CharSpan value;
+        ReturnErrorOnFailure(reader.Get(value));
+        if (IsValidUtf8(Uint8::from_const_char(value.data()), value.size()))
+        {
+            PutString(value);
+        }
+        else
+        {
+            PutBytes(ByteSpan(Uint8::from_const_char(value.data()), value.size()));
+        }
+        break;
+    }
+    case TLV::kTLVType_ByteString: {
+        ByteSpan value;
+        ReturnErrorOnFailure(reader.Get(value));
+        PutBytes(value);
+        break;
+    }
+    case TLV::kTLVType_Null:
+        PutNone();
+        break;
+    case TLV::kTLVType_Structure:
+    case TLV::kTLVType_Array:
+    case TLV::kTLVType_List:
+        return PutTLVContainer(reader);
+    default:
+        return CHIP_ERROR_WRONG_TLV_TYPE;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PickleEncoder::PutTLVTag(const TLV::TLVReader & reader)
+{
+    const TLV::Tag tag = reader.GetTag();
+
+    if (TLV::IsContextTag(tag))
+    {
+        PutInt(TLV::TagNumFromTag(tag));
+    }
+    else if (TLV::IsProfileTag(tag))
+    {
+        // Like chip.tlv.TLVReader, which does not know the implicit profile either, implicit profile tags decode to
+        // (None, number). Common profile tags have profile id 0.
+        const auto tagControl = static_cast<TLV::TLVTagControl>(reader.GetControlByte() & TLV::kTLVTagControlMask);
+        if (tagControl == TLV::TLVTagControl::ImplicitProfile_2Bytes || tagControl == TLV::TLVTagControl::ImplicitProfile_4Bytes)
+        {
+            PutNone();
+        }
+        else
+        {
+            PutInt(TLV::ProfileIdFromTag(tag));
+        }
+        PutInt(TLV::TagNumFromTag(tag));
+        PutOpcode(kTuple2);
+    }
+    else if (tag == TLV::AnonymousTag())
+    {
+        PutString(CharSpan(kAnonymousTagKey, sizeof(kAnonymousTagKey) - 1));
+    }
+    else
+    {
+        return CHIP_ERROR_INVALID_TLV_TAG;
+    }
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PickleEncoder::PutTLVContainer(TLV::TLVReader & reader)
+{
+    const bool isStructure = (reader.GetType() == TLV::kTLVType_Structure);
+    TLV::TLVType containerType;
+    CHIP_ERROR err;
+
+    PutOpcode(isStructure ? kEmptyDict : kEmptyList);
+    PutOpcode(kMark);
+
+    // The reader fails on implicit profile tags unless it is given an implicit profile. Any profile does, since
+    // PutTLVTag does not encode it.
+    const uint32_t implicitProfileId = reader.ImplicitProfileId;
+    if (implicitProfileId == TLV::kProfileIdNotSpecified)
+    {
+        reader.ImplicitProfileId = TLV::kCommonProfileId;
+    }
+
+    ReturnErrorOnFailure(reader.EnterContainer(containerType));
+    while ((err = reader.Next()) == CHIP_NO_ERROR)
+    {
+        if (isStructure)
+        {
+            ReturnErrorOnFailure(PutTLVTag(reader));
+        }
+        ReturnErrorOnFailure(PutTLVElement(reader));
+    }
+    VerifyOrReturnError(err == CHIP_END_OF_TLV, err);
+    ReturnErrorOnFailure(reader.ExitContainer(containerType));
+    reader.ImplicitProfileId = implicitProfileId;
+
+    PutOpcode(isStructure ? kSetItems : kAppends);
+    return CHIP_NO_ERROR;
+}
+
+void PickleEncoder::PutLittleEndian(uint64_t value, size_t length)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        PutByte(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void PickleEncoder::PutSized(uint8_t opcode, const uint8_t * data, size_t length)
+{
+    PutOpcode(opcode);
+    PutLittleEndian(length, 4);
+    if (length > 0)
+    {
+        mBuffer.insert(mBuffer.end(), data, data + length);
+    }
+}
+
+} // namespace python
+} // namespace chip
+
+using namespace chip;
+
+// Encodes the single TLV element of the given buffer as a pickle, so that the Python unit tests can compare it with what
+// chip.tlv.TLVReader decodes. On entry, pickleLength is the size of the pickle buffer.
+extern "C" ChipError::StorageType pychip_tlv_to_pickle(const uint8_t * tlv, uint32_t tlvLength, uint8_t * pickle,
+                                                       uint32_t * pickleLength)
+{
+    TLV::TLVReader reader;
+    python::PickleEncoder encoder;
+
+    reader.Init(tlv, tlvLength);
+    CHIP_ERROR err = reader.Next();
+    VerifyOrReturnError(err == CHIP_NO_ERROR, err.AsInteger());
+
+    encoder.Reset();
+    err = encoder.PutTLVElement(reader);
+    VerifyOrReturnError(err == CHIP_NO_ERROR, err.AsInteger());
+    encoder.Finish();
+
+    VerifyOrReturnError(encoder.Length() <= *pickleLength, CHIP_ERROR_BUFFER_TOO_SMALL.AsInteger());
+    memcpy(pickle, encoder.Data(), encoder.Length());
+    *pickleLength = static_cast<uint32_t>(encoder.Length());
+    return CHIP_NO_ERROR.AsInteger();
+}
@@ -0,0 +1,89 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <lib/core/CHIPError.h>
+#include <lib/core/CHIPTLV.h>
+#include <lib/support/Span.h>
+
+namespace chip {
+namespace python {
+
+/// Encodes values, and whole TLV elements, as a Python pickle stream
+/// (protocol 3), so that a single `pickle.loads` call in the C
+/// implementation of the pickle module builds all the Python objects of a
+/// payload instead of decoding it byte by byte in `chip.tlv`.
+///
+/// TLV elements decode to the same objects as `chip.tlv.TLVReader`:
+/// structures become dictionaries keyed by tag, arrays and lists become
+/// lists, unsigned integers become `chip.tlv.uint` and UTF-8 strings that
+/// are not valid UTF-8 are kept as bytes.
+class PickleEncoder
+{
+public:
+    /// Discards the stream and starts a new one.
+    void Reset();
+
+    /// Terminates the stream; it holds a single object at this point.
+    void Finish();
+
+    const uint8_t * Data() const { return mBuffer.data(); }
+    size_t Length() const { return mBuffer.size(); }
+
+    /// Current position in the stream, to undo a partially encoded value
+    /// with Truncate().
+    size_t Position() const { return mBuffer.size(); }
+    void Truncate(size_t position) { mBuffer.resize(position); }
+
+    void PutNone();
+    void PutBool(bool value);
+    void PutInt(int64_t value);
+    void PutUnsignedInt(uint64_t value);
+    void PutDouble(double value);
+    void PutString(CharSpan value);
+    void PutBytes(ByteSpan value);
+
+    /// A list or a tuple holds the values put between its Start and End
+    /// calls.
+    void StartList();
+    void EndList();
+    void StartTuple();
+    void EndTuple();
+
+    /// Encodes the element the reader is positioned on, including all the
+    /// members of a container.
+    CHIP_ERROR PutTLVElement(TLV::TLVReader & reader);
+
+private:
+    CHIP_ERROR PutTLVTag(const TLV::TLVReader & reader);
+    CHIP_ERROR PutTLVContainer(TLV::TLVReader & reader);
+
+    void PutOpcode(uint8_t opcode) { mBuffer.push_back(opcode); }
+    void PutByte(uint8_t value) { mBuffer.push_back(value); }
+    void PutLittleEndian(uint64_t value, size_t length);
+    void PutSized(uint8_t opcode, const uint8_t * data, size_t length);
+
+    std::vector<uint8_t> mBuffer;
+};
+
+} // namespace python
+} // namespace chip
@@ -206,6 +206,11 @@ CHIP_ERROR ChipCertificateSet::LoadCert(TLVReader & reader, BitFlags<CertDecodeF
         cert.mCertFlags.Set(CertFlags::kIsTrustAnchor);
     }
 
+    return LoadCert(cert);
+}
+
+CHIP_ERROR ChipCertificateSet::LoadCert(const ChipCertificateData & cert)
+{
     // Check if this cert matches any currently loaded certificates
     for (uint32_t i = 0; i < mCertCount; i++)
     {
@@ -410,9 +415,13 @@ CHIP_ERROR ChipCertificateSet::ValidateCert(const ChipCertificateData * cert, Va
     }
 
     // Verify signature of the current certificate against public key of the CA certificate. If signature verification
-    // succeeds, the current certificate is valid.
-    err = VerifySignature(cert, caCert);
-    SuccessOrExit(err);
+    // succeeds, the current certificate is valid. A signature that was already verified against this CA doesn't need
+    // to be checked again.
+    if (!cert->mCertFlags.Has(CertFlags::kSignatureVerified))
+    {
+        err = VerifySignature(cert, caCert);
+        SuccessOrExit(err);
+    }
 
 exit:
     return err;
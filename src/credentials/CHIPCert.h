@@ -159,6 +159,8 @@ enum class CertFlags : uint16_t
     kIsCA                        = 0x0080, /**< Indicates that certificate is a CA certificate. */
     kIsTrustAnchor               = 0x0100, /**< Indicates that certificate is a trust anchor. */
     kTBSHashPresent              = 0x0200, /**< Indicates that TBS hash of the certificate was generated and stored. */
+    kSignatureVerified           = 0x0400, /**< Indicates that the certificate signature was already verified against the
+                                                issuer certificate it chains to, so only its issuer needs to be validated. */
 };
 
 /** CHIP Certificate Decode Flags
@@ -447,6 +449,17 @@ public:
      **/
     CHIP_ERROR LoadCert(chip::TLV::TLVReader & reader, BitFlags<CertDecodeFlags> decodeFlags, ByteSpan chipCert = ByteSpan());
 
+    /**
+     * @brief Load already decoded CHIP certificate data into set.
+     *        It is required that the CHIP certificate buffer referenced by certData stays valid while
+     *        the certificate data in the set is used.
+     *
+     * @param certData  Decoded certificate data, as produced by a previous LoadCert() call.
+     *
+     * @return Returns a CHIP_ERROR on error, CHIP_NO_ERROR otherwise
+     **/
+    CHIP_ERROR LoadCert(const ChipCertificateData & certData);
+
     CHIP_ERROR ReleaseLastCert();
 
     /**
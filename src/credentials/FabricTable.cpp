@@ -34,6 +34,18 @@ namespace chip {
 using namespace Credentials;
 using namespace Crypto;
 
+namespace {
+
+// Decode through a single entry set, so that the certificate gets the same checks as when loaded for validation.
+CHIP_ERROR DecodeCert(const ByteSpan & cert, BitFlags<CertDecodeFlags> decodeFlags, ChipCertificateData & certData)
+{
+    ChipCertificateSet certificates;
+    ReturnErrorOnFailure(certificates.Init(&certData, 1));
+    return certificates.LoadCert(cert, decodeFlags);
+}
+
+} // namespace
+
 CHIP_ERROR FabricInfo::SetFabricLabel(const CharSpan & fabricLabel)
 {
     Platform::CopyString(mFabricLabel, fabricLabel);
@@ -277,23 +289,81 @@ CHIP_ERROR FabricInfo::SetCert(MutableByteSpan & dstCert, const ByteSpan & srcCe
     return CHIP_NO_ERROR;
 }
 
+const FabricInfo::VerifiedICAC * FabricInfo::FindVerifiedICAC(const ByteSpan & icac) const
+{
+    for (const VerifiedICAC & entry : mVerifiedICACs)
+    {
+        if (!entry.mCert.empty() && entry.mCert.data_equal(icac))
+        {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
+
+void FabricInfo::CacheVerifiedICAC(Platform::ScopedMemoryBuffer<uint8_t> & icac, size_t icacLen,
+                                   const ChipCertificateData & icacData) const
+{
+    VerifiedICAC & entry = mVerifiedICACs[mNextVerifiedICAC];
+    mNextVerifiedICAC    = static_cast<uint8_t>((mNextVerifiedICAC + 1) % CHIP_CONFIG_FABRIC_VERIFIED_ICAC_CACHE_SIZE);
+
+    // icacData references the icac buffer, which is now owned by the cache entry.
+    ReleaseCert(entry.mCert);
+    entry.mCert     = MutableByteSpan(icac.Release(), icacLen);
+    entry.mCertData = icacData;
+    entry.mCertData.mCertFlags.Set(CertFlags::kSignatureVerified);
+}
+
+void FabricInfo::ReleaseVerifiedCertCache()
+{
+    for (VerifiedICAC & entry : mVerifiedICACs)
+    {
+        ReleaseCert(entry.mCert);
+        entry.mCertData.Clear();
+    }
+    mNextVerifiedICAC = 0;
+
+    mRootCertData.Clear();
+    mRootCertDataValid = false;
+}
+
 CHIP_ERROR FabricInfo::VerifyCredentials(const ByteSpan & noc, const ByteSpan & icac, ValidationContext & context,
                                          PeerId & nocPeerId, FabricId & fabricId, Crypto::P256PublicKey & nocPubkey) const
 {
-    // TODO - Optimize credentials verification logic
-    //        The certificate chain construction and verification is a compute and memory intensive operation.
-    //        It can be optimized by not loading certificate (i.e. rcac) that's local and implicitly trusted.
-    //        The FindValidCert() algorithm will need updates to achieve this refactor.
     constexpr uint8_t kMaxNumCertsInOpCreds = 3;
 
     ChipCertificateSet certificates;
     ReturnErrorOnFailure(certificates.Init(kMaxNumCertsInOpCreds));
 
-    ReturnErrorOnFailure(certificates.LoadCert(mRootCert, BitFlags<CertDecodeFlags>(CertDecodeFlags::kIsTrustAnchor)));
+    // The root certificate is implicitly trusted, so it is only decoded once.
+    if (!mRootCertDataValid)
+    {
+        ReturnErrorOnFailure(DecodeCert(mRootCert, BitFlags<CertDecodeFlags>(CertDecodeFlags::kIsTrustAnchor), mRootCertData));
+        mRootCertDataValid = true;
+    }
+    ReturnErrorOnFailure(certificates.LoadCert(mRootCertData));
 
+    // An ICAC that was already verified against the root is loaded pre-decoded, and only its validity is checked again.
+    // Other ICACs are decoded from a copy, which is cached once the chain has been validated through them.
+    const VerifiedICAC * verifiedICAC = nullptr;
+    Platform::ScopedMemoryBuffer<uint8_t> icacCopy;
+    ChipCertificateData icacData;
     if (!icac.empty())
     {
-        ReturnErrorOnFailure(certificates.LoadCert(icac, BitFlags<CertDecodeFlags>(CertDecodeFlags::kGenerateTBSHash)));
+        verifiedICAC = FindVerifiedICAC(icac);
+        if (verifiedICAC != nullptr)
+        {
+            ReturnErrorOnFailure(certificates.LoadCert(verifiedICAC->mCertData));
+        }
+        else
+        {
+            ReturnErrorCodeIf(!icacCopy.Alloc(icac.size()), CHIP_ERROR_NO_MEMORY);
+            memcpy(icacCopy.Get(), icac.data(), icac.size());
+            ReturnErrorOnFailure(DecodeCert(ByteSpan(icacCopy.Get(), icac.size()),
+                                            BitFlags<CertDecodeFlags>(CertDecodeFlags::kGenerateTBSHash), icacData));
+            ReturnErrorOnFailure(certificates.LoadCert(icacData));
+        }
     }
 
     ReturnErrorOnFailure(certificates.LoadCert(noc, BitFlags<CertDecodeFlags>(CertDecodeFlags::kGenerateTBSHash)));
@@ -321,6 +391,20 @@ CHIP_ERROR FabricInfo::VerifyCredentials(const ByteSpan & noc, const ByteSpan &
     ReturnErrorOnFailure(GetCompressedId(fabricId, nodeId, &nocPeerId));
     nocPubkey = P256PublicKey(certificates.GetLastCert()[0].mPublicKey);
 
+    // The ICAC signature was verified only if the NOC chains to the root through it.
+    if (!icac.empty() && verifiedICAC == nullptr)
+    {
+        const ChipCertificateData & nocData = certificates.GetLastCert()[0];
+        bool nocIssuedByRoot = nocData.mIssuerDN.IsEqual(mRootCertData.mSubjectDN) &&
+            nocData.mAuthKeyId.data_equal(mRootCertData.mSubjectKeyId);
+        bool nocIssuedByICAC =
+            nocData.mIssuerDN.IsEqual(icacData.mSubjectDN) && nocData.mAuthKeyId.data_equal(icacData.mSubjectKeyId);
+        if (nocIssuedByICAC && !nocIssuedByRoot)
+        {
+            CacheVerifiedICAC(icacCopy, icac.size(), icacData);
+        }
+    }
+
     return CHIP_NO_ERROR;
 }
 
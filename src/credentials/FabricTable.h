@@ -32,6 +32,7 @@
 #include <lib/core/Optional.h>
 #include <lib/support/CHIPMem.h>
 #include <lib/support/DLLUtil.h>
+#include <lib/support/ScopedBuffer.h>
 #include <lib/support/Span.h>
 
 #ifdef ENABLE_HSM_CASE_OPS_KEY
@@ -175,7 +176,11 @@ public:
     // TODO - Update these APIs to take ownership of the buffer, instead of copying
     //        internally.
     // TODO - Optimize persistent storage of NOC and Root Cert in FabricInfo.
-    CHIP_ERROR SetRootCert(const chip::ByteSpan & cert) { return SetCert(mRootCert, cert); }
+    CHIP_ERROR SetRootCert(const chip::ByteSpan & cert)
+    {
+        ReleaseVerifiedCertCache();
+        return SetCert(mRootCert, cert);
+    }
     CHIP_ERROR SetICACert(const chip::ByteSpan & cert) { return SetCert(mICACert, cert); }
     CHIP_ERROR SetICACert(const Optional<ByteSpan> & cert) { return SetICACert(cert.ValueOr(ByteSpan())); }
     CHIP_ERROR SetNOCCert(const chip::ByteSpan & cert) { return SetCert(mNOCCert, cert); }
@@ -273,6 +278,19 @@ private:
 
     FabricId mFabricId = 0;
 
+    // An ICAC whose signature was verified against mRootCert, with its data decoded from the owned mCert copy.
+    struct VerifiedICAC
+    {
+        MutableByteSpan mCert;
+        Credentials::ChipCertificateData mCertData;
+    };
+
+    // Certificates decoded and verified by VerifyCredentials(), reused by later calls until the root changes.
+    mutable Credentials::ChipCertificateData mRootCertData;
+    mutable bool mRootCertDataValid = false;
+    mutable VerifiedICAC mVerifiedICACs[CHIP_CONFIG_FABRIC_VERIFIED_ICAC_CACHE_SIZE];
+    mutable uint8_t mNextVerifiedICAC = 0;
+
     static constexpr size_t kKeySize = sizeof(kFabricTableKeyPrefix) + 2 * sizeof(FabricIndex);
 
     static CHIP_ERROR GenerateKey(FabricIndex id, char * key, size_t len);
@@ -281,9 +299,10 @@ private:
     CHIP_ERROR LoadFromStorage(FabricStorage * storage);
     static CHIP_ERROR DeleteFromStorage(FabricStorage * storage, FabricIndex fabricIndex);
 
-    void ReleaseCert(MutableByteSpan & cert);
+    static void ReleaseCert(MutableByteSpan & cert);
     void ReleaseOperationalCerts()
     {
+        ReleaseVerifiedCertCache();
         ReleaseCert(mRootCert);
         ReleaseCert(mICACert);
         ReleaseCert(mNOCCert);
@@ -291,6 +310,11 @@ private:
 
     CHIP_ERROR SetCert(MutableByteSpan & dstCert, const ByteSpan & srcCert);
 
+    const VerifiedICAC * FindVerifiedICAC(const ByteSpan & icac) const;
+    void CacheVerifiedICAC(Platform::ScopedMemoryBuffer<uint8_t> & icac, size_t icacLen,
+                           const Credentials::ChipCertificateData & icacData) const;
+    void ReleaseVerifiedCertCache();
+
     struct StorableFabricInfo
     {
         uint16_t mFabric;   /* This field is serialized in LittleEndian byte order */
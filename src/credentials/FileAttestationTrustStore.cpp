@@ -0,0 +1,138 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include "FileAttestationTrustStore.h"
+
+#include <credentials/CHIPCert.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+
+#include <algorithm>
+#include <dirent.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+namespace chip {
+namespace Credentials {
+
+namespace {
+
+constexpr char kDerFileExtension[] = ".der";
+
+bool HasDerFileExtension(const char * fileName)
+{
+    size_t fileNameLen  = strlen(fileName);
+    size_t extensionLen = strlen(kDerFileExtension);
+    return fileNameLen > extensionLen && strcmp(fileName + fileNameLen - extensionLen, kDerFileExtension) == 0;
+}
+
+CHIP_ERROR ReadDerFile(const std::string & path, std::vector<uint8_t> & derCert)
+{
+    FILE * file = fopen(path.c_str(), "rb");
+    VerifyOrReturnError(file != nullptr, CHIP_ERROR_OPEN_FAILED);
+
+    // Read one byte more than a certificate may hold, to tell files that are too large apart.
+    derCert.resize(kMaxDERCertLength + 1);
+    size_t derCertLen = fread(derCert.data(), 1, derCert.size(), file);
+    bool readFailed   = ferror(file) != 0;
+    fclose(file);
+
+    VerifyOrReturnError(!readFailed, CHIP_ERROR_READ_FAILED);
+    VerifyOrReturnError(derCertLen > 0 && derCertLen <= kMaxDERCertLength, CHIP_ERROR_INVALID_ARGUMENT);
+    derCert.resize(derCertLen);
+
+    return CHIP_NO_ERROR;
+}
+
+} // namespace
+
+bool FileAttestationTrustStore::SkidLessThan(const PaaCert & paaCert, const ByteSpan & skid)
+{
+    return memcmp(paaCert.mSkid, skid.data(), sizeof(paaCert.mSkid)) < 0;
+}
+
+CHIP_ERROR FileAttestationTrustStore::LoadPaaCerts(const char * paaTrustStorePath)
+{
+    VerifyOrReturnError(paaTrustStorePath != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    DIR * dir = opendir(paaTrustStorePath);
+    VerifyOrReturnError(dir != nullptr, CHIP_ERROR_OPEN_FAILED);
+
+    size_t loadedCount = 0;
+    struct dirent * entry;
+    while ((entry = readdir(dir)) != nullptr)
+    {
+        if (!HasDerFileExtension(entry->d_name))
+        {
+            continue;
+        }
+
+        std::string path = std::string(paaTrustStorePath) + "/" + entry->d_name;
+        std::vector<uint8_t> derCert;
+        CHIP_ERROR err = ReadDerFile(path, derCert);
+        if (err == CHIP_NO_ERROR)
+        {
+            err = AddPaaCert(ByteSpan(derCert.data(), derCert.size()));
+        }
+
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(NotSpecified, "Skipping PAA certificate %s: %" CHIP_ERROR_FORMAT, path.c_str(), err.Format());
+            continue;
+        }
+        loadedCount++;
+    }
+    closedir(dir);
+
+    ChipLogProgress(NotSpecified, "Loaded %u PAA certificates from %s", static_cast<unsigned>(loadedCount), paaTrustStorePath);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR FileAttestationTrustStore::AddPaaCert(const ByteSpan & paaDerCert)
+{
+    VerifyOrReturnError(!paaDerCert.empty() && paaDerCert.size() <= kMaxDERCertLength, CHIP_ERROR_INVALID_ARGUMENT);
+
+    PaaCert paaCert;
+    MutableByteSpan skidSpan(paaCert.mSkid);
+    VerifyOrReturnError(Crypto::ExtractSKIDFromX509Cert(paaDerCert, skidSpan) == CHIP_NO_ERROR, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(skidSpan.size() == sizeof(paaCert.mSkid), CHIP_ERROR_INVALID_ARGUMENT);
+
+    ByteSpan skid(paaCert.mSkid);
+    auto position = std::lower_bound(mPaaCerts.begin(), mPaaCerts.end(), skid, SkidLessThan);
+    VerifyOrReturnError(position == mPaaCerts.end() || memcmp(position->mSkid, paaCert.mSkid, sizeof(paaCert.mSkid)) != 0,
+                        CHIP_ERROR_DUPLICATE_KEY_ID);
+
+    paaCert.mDerCert.assign(paaDerCert.begin(), paaDerCert.end());
+    mPaaCerts.insert(position, std::move(paaCert));
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR FileAttestationTrustStore::GetProductAttestationAuthorityCert(const ByteSpan & skid,
+                                                                         MutableByteSpan & outPaaDerBuffer) const
+{
+    VerifyOrReturnError(!skid.empty() && (skid.data() != nullptr), CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(skid.size() == Crypto::kSubjectKeyIdentifierLength, CHIP_ERROR_INVALID_ARGUMENT);
+
+    auto position = std::lower_bound(mPaaCerts.begin(), mPaaCerts.end(), skid, SkidLessThan);
+    VerifyOrReturnError(position != mPaaCerts.end() && skid.data_equal(ByteSpan(position->mSkid)), CHIP_ERROR_CA_CERT_NOT_FOUND);
+
+    return CopySpanToMutableSpan(ByteSpan(position->mDerCert.data(), position->mDerCert.size()), outPaaDerBuffer);
+}
+
+} // namespace Credentials
+} // namespace chip
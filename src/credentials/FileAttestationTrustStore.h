@@ -0,0 +1,76 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#pragma once
+
+#include <credentials/DeviceAttestationVerifier.h>
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/Span.h>
+
+#include <vector>
+
+namespace chip {
+namespace Credentials {
+
+/**
+ * @brief AttestationTrustStore holding PAA certificates loaded from a directory of DER files.
+ *
+ * The SKID of each PAA is extracted once, when the certificate is added, and the certificates are kept
+ * sorted by SKID, so that looking up a PAA doesn't parse every certificate in the store.
+ *
+ * Certificates must all be added before the store is used to verify attestation information. Lookups may
+ * then run concurrently.
+ */
+class FileAttestationTrustStore : public AttestationTrustStore
+{
+public:
+    /**
+     * @brief Add every file with a `.der` extension found in the given directory.
+     *
+     * Files that can't be read, or aren't X.509 certificates with a SKID, are skipped.
+     *
+     * @returns CHIP_ERROR_OPEN_FAILED if the directory can't be opened.
+     */
+    CHIP_ERROR LoadPaaCerts(const char * paaTrustStorePath);
+
+    /**
+     * @brief Add a PAA certificate in DER format.
+     *
+     * @returns CHIP_ERROR_INVALID_ARGUMENT if no SKID can be extracted from the certificate,
+     *          CHIP_ERROR_DUPLICATE_KEY_ID if a certificate with the same SKID was already added.
+     */
+    CHIP_ERROR AddPaaCert(const ByteSpan & paaDerCert);
+
+    size_t GetPaaCertCount() const { return mPaaCerts.size(); }
+
+    CHIP_ERROR GetProductAttestationAuthorityCert(const ByteSpan & skid, MutableByteSpan & outPaaDerBuffer) const override;
+
+private:
+    struct PaaCert
+    {
+        uint8_t mSkid[Crypto::kSubjectKeyIdentifierLength];
+        std::vector<uint8_t> mDerCert;
+    };
+
+    static bool SkidLessThan(const PaaCert & paaCert, const ByteSpan & skid);
+
+    // Sorted by SKID.
+    std::vector<PaaCert> mPaaCerts;
+};
+
+} // namespace Credentials
+} // namespace chip
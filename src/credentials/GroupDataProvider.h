@@ -138,6 +138,25 @@ public:
         }
     };
 
+    // An operational group key, together with the group it protects. Used to encrypt and decrypt group messages.
+    struct GroupSession
+    {
+        using SecurityPolicy = KeySet::SecurityPolicy;
+
+        GroupSession() = default;
+
+        // Group the key is mapped to
+        chip::GroupId group_id = kUndefinedGroupId;
+        // Fabric the group belongs to
+        chip::FabricIndex fabric_index = kUndefinedFabricIndex;
+        // Security policy of the keyset the key comes from
+        SecurityPolicy security_policy = SecurityPolicy::kStandard;
+        // Group session identifier (key hash) carried in the header of messages encrypted with this key
+        uint16_t session_id = 0;
+        // Operational group key
+        uint8_t key[EpochKey::kLengthBytes] = { 0 };
+    };
+
     /**
      *  Interface to listen for changes in the Group info.
      */
@@ -187,10 +206,11 @@ public:
         Iterator() = default;
     };
 
-    using GroupInfoIterator = Iterator<GroupInfo>;
-    using GroupKeyIterator  = Iterator<GroupKey>;
-    using EndpointIterator  = Iterator<GroupEndpoint>;
-    using KeySetIterator    = Iterator<KeySet>;
+    using GroupInfoIterator    = Iterator<GroupInfo>;
+    using GroupKeyIterator     = Iterator<GroupKey>;
+    using EndpointIterator     = Iterator<GroupEndpoint>;
+    using KeySetIterator       = Iterator<KeySet>;
+    using GroupSessionIterator = Iterator<GroupSession>;
 
     GroupDataProvider(uint16_t maxGroupsPerFabric    = CHIP_CONFIG_MAX_GROUPS_PER_FABRIC,
                       uint16_t maxGroupKeysPerFabric = CHIP_CONFIG_MAX_GROUP_KEYS_PER_FABRIC) :
@@ -274,9 +294,15 @@ public:
     // Key Sets
     //
 
-    virtual CHIP_ERROR SetKeySet(chip::FabricIndex fabric_index, const KeySet & keys)                     = 0;
-    virtual CHIP_ERROR GetKeySet(chip::FabricIndex fabric_index, chip::KeysetId keyset_id, KeySet & keys) = 0;
-    virtual CHIP_ERROR RemoveKeySet(chip::FabricIndex fabric_index, chip::KeysetId keyset_id)             = 0;
+    /**
+     *  Store a key set. The epoch keys are stored as given; the operational group keys used on the wire are
+     *  derived from them and from the compressed fabric identifier of the fabric.
+     *
+     *  @param[in] compressed_fabric_id  Compressed fabric identifier of fabric_index, kCompressedFabricIdentifierSize long.
+     */
+    virtual CHIP_ERROR SetKeySet(chip::FabricIndex fabric_index, const ByteSpan & compressed_fabric_id, const KeySet & keys) = 0;
+    virtual CHIP_ERROR GetKeySet(chip::FabricIndex fabric_index, chip::KeysetId keyset_id, KeySet & keys)                    = 0;
+    virtual CHIP_ERROR RemoveKeySet(chip::FabricIndex fabric_index, chip::KeysetId keyset_id)                                = 0;
     /**
      *  Creates an iterator that may be used to obtain the list of key sets associated with the given fabric.
      *  In order to release the allocated memory, the Release() method must be called after the iteration is finished.
@@ -289,8 +315,23 @@ public:
     // Fabrics
     virtual CHIP_ERROR RemoveFabric(chip::FabricIndex fabric_index) = 0;
 
-    // General
-    virtual CHIP_ERROR Decrypt(PacketHeader packetHeader, PayloadHeader & payloadHeader, System::PacketBufferHandle & msg) = 0;
+    //
+    // Group Sessions
+    //
+
+    /**
+     *  Creates an iterator over the operational group keys whose session id matches the given one, on any fabric.
+     *  These are the candidate keys for the trial decryption of a received group message.
+     *  In order to release the allocated memory, the Release() method must be called after the iteration is finished.
+     *  @retval An instance of GroupSessionIterator on success
+     *  @retval nullptr if no iterator instances are available.
+     */
+    virtual GroupSessionIterator * IterateGroupSessions(uint16_t session_id) = 0;
+    /**
+     *  Get the operational group key to use when sending a message to the given group.
+     *  @retval #CHIP_ERROR_NOT_FOUND if no key set is mapped to the group.
+     */
+    virtual CHIP_ERROR GetGroupSession(chip::FabricIndex fabric_index, chip::GroupId group_id, GroupSession & session) = 0;
 
     // Listener
     void SetListener(GroupListener * listener) { mListener = listener; };
@@ -323,9 +364,11 @@ GroupDataProvider * GetGroupDataProvider();
  *
  * Callers have to externally synchronize usage of this function.
  *
- * If the `provider` is nullptr, no change is done.
+ * Passing nullptr clears the global instance, e.g. before the provider it pointed to is destroyed:
+ * GetGroupDataProvider() then returns nullptr until another provider is set. Earlier versions ignored
+ * nullptr, so callers must not pass it expecting the current provider to be kept.
  *
- * @param[in] provider the Group Data Provider
+ * @param[in] provider the Group Data Provider, or nullptr
  */
 void SetGroupDataProvider(GroupDataProvider * provider);
 
@@ -14,11 +14,17 @@
  *    See the License for the specific language governing permissions and
  *    limitations under the License.
  */
+#include <credentials/FabricTable.h>
 #include <credentials/GroupDataProviderImpl.h>
+#include <crypto/CHIPCryptoPAL.h>
 #include <lib/core/CHIPTLV.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CHIPMemString.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/DefaultStorageKeyAllocator.h>
 #include <lib/support/Pool.h>
+#include <algorithm>
+#include <new>
 #include <stdlib.h>
 #include <string.h>
 
@@ -108,6 +114,7 @@ struct FabricData : public PersistentData<kPersistentBufferMax>
     static constexpr TLV::Tag TagMapCount() { return TLV::ContextTag(4); }
     static constexpr TLV::Tag TagFirstKeyset() { return TLV::ContextTag(5); }
     static constexpr TLV::Tag TagKeysetCount() { return TLV::ContextTag(6); }
+    static constexpr TLV::Tag TagCompressedFabricId() { return TLV::ContextTag(7); }
 
     chip::FabricIndex fabric_index = kUndefinedFabricIndex;
     chip::GroupId first_group      = kUndefinedGroupId;
@@ -116,6 +123,9 @@ struct FabricData : public PersistentData<kPersistentBufferMax>
     uint16_t map_count             = 0;
     chip::KeysetId first_keyset    = 0xffff;
     uint16_t keyset_count          = 0;
+    // Needed to derive operational group keys; only known once a keyset has been set.
+    bool has_compressed_fabric_id                                        = false;
+    uint8_t compressed_fabric_id[Crypto::kCompressedFabricIdentifierSize] = { 0 };
 
     FabricData() = default;
     FabricData(chip::FabricIndex fabric) : fabric_index(fabric) {}
@@ -133,6 +143,9 @@ struct FabricData : public PersistentData<kPersistentBufferMax>
         group_count  = 0;
         first_keyset = 0xffff;
         keyset_count = 0;
+
+        has_compressed_fabric_id = false;
+        memset(compressed_fabric_id, 0x00, sizeof(compressed_fabric_id));
     }
 
     CHIP_ERROR Serialize(TLV::TLVWriter & writer) const override
@@ -146,6 +159,10 @@ struct FabricData : public PersistentData<kPersistentBufferMax>
         ReturnErrorOnFailure(writer.Put(TagMapCount(), static_cast<uint16_t>(map_count)));
         ReturnErrorOnFailure(writer.Put(TagFirstKeyset(), static_cast<uint16_t>(first_keyset)));
         ReturnErrorOnFailure(writer.Put(TagKeysetCount(), static_cast<uint16_t>(keyset_count)));
+        if (has_compressed_fabric_id)
+        {
+            ReturnErrorOnFailure(writer.Put(TagCompressedFabricId(), ByteSpan(compressed_fabric_id)));
+        }
 
         return writer.EndContainer(container);
     }
@@ -175,6 +192,20 @@ struct FabricData : public PersistentData<kPersistentBufferMax>
         // keyset_count
         ReturnErrorOnFailure(reader.Next(TagKeysetCount()));
         ReturnErrorOnFailure(reader.Get(keyset_count));
+        // compressed_fabric_id, optional
+        CHIP_ERROR err = reader.Next(TagCompressedFabricId());
+        if (CHIP_NO_ERROR == err)
+        {
+            ByteSpan id;
+            ReturnErrorOnFailure(reader.Get(id));
+            VerifyOrReturnError(sizeof(compressed_fabric_id) == id.size(), CHIP_ERROR_INTERNAL);
+            memcpy(compressed_fabric_id, id.data(), sizeof(compressed_fabric_id));
+            has_compressed_fabric_id = true;
+        }
+        else
+        {
+            VerifyOrReturnError(CHIP_END_OF_TLV == err, err);
+        }
 
         return reader.ExitContainer(container);
     }
@@ -665,6 +696,201 @@ struct KeySetData : public GroupDataProvider::KeySet, PersistentData<kPersistent
     }
 };
 
+//
+// Storage Cache
+//
+
+namespace {
+
+uint32_t HashStorageKey(const char * key)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (; *key != '\0'; key++)
+    {
+        hash = (hash ^ static_cast<uint8_t>(*key)) * 16777619u;
+    }
+    return hash;
+}
+
+// Key of a group membership in the endpoint index; sorts by fabric, then group, then endpoint.
+uint64_t EndpointIndexKey(chip::FabricIndex fabric_index, chip::GroupId group_id, chip::EndpointId endpoint_id)
+{
+    return (static_cast<uint64_t>(fabric_index) << 32) | (static_cast<uint64_t>(group_id) << 16) | endpoint_id;
+}
+
+} // namespace
+
+static_assert(kPersistentBufferMax <= 128, "Group data records must fit in the storage cache entries");
+
+CHIP_ERROR GroupDataProviderImpl::StorageCache::SyncGetKeyValue(const char * key, void * buffer, uint16_t & size)
+{
+    const uint32_t hash = HashStorageKey(key);
+    Entry * entry       = Find(key, hash);
+
+    if (entry == nullptr || entry->state == State::kStale)
+    {
+        uint8_t value[kValueLengthMax];
+        uint16_t value_size = static_cast<uint16_t>(sizeof(value));
+        CHIP_ERROR err      = mStorage.SyncGetKeyValue(key, value, value_size);
+
+        if (CHIP_NO_ERROR != err && CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND != err)
+        {
+            // Not cacheable (e.g. too large), read straight into the caller's buffer
+            return mStorage.SyncGetKeyValue(key, buffer, size);
+        }
+
+        entry = FindOrAdd(key, hash);
+        if (entry == nullptr)
+        {
+            // Cache full
+            VerifyOrReturnError(CHIP_NO_ERROR == err, err);
+            VerifyOrReturnError(value_size <= size, CHIP_ERROR_BUFFER_TOO_SMALL);
+            memcpy(buffer, value, value_size);
+            size = value_size;
+            return CHIP_NO_ERROR;
+        }
+        entry->state = (CHIP_NO_ERROR == err) ? State::kPresent : State::kAbsent;
+        entry->size  = (CHIP_NO_ERROR == err) ? value_size : 0;
+        memcpy(entry->value, value, entry->size);
+    }
+
+    VerifyOrReturnError(entry->state == State::kPresent, CHIP_ERROR_PERSISTED_STORAGE_VALUE_NOT_FOUND);
+    VerifyOrReturnError(entry->size <= size, CHIP_ERROR_BUFFER_TOO_SMALL);
+    memcpy(buffer, entry->value, entry->size);
+    size = entry->size;
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR GroupDataProviderImpl::StorageCache::SyncSetKeyValue(const char * key, const void * value, uint16_t size)
+{
+    const uint32_t hash = HashStorageKey(key);
+    Entry * entry       = Find(key, hash);
+
+    if (entry != nullptr && entry->state == State::kPresent && entry->size == size && 0 == memcmp(entry->value, value, size))
+    {
+        // Unchanged, nothing to write
+        return CHIP_NO_ERROR;
+    }
+
+    mGeneration++;
+    CHIP_ERROR err = mStorage.SyncSetKeyValue(key, value, size);
+    if (CHIP_NO_ERROR == err && size <= kValueLengthMax)
+    {
+        entry = (entry != nullptr) ? entry : FindOrAdd(key, hash);
+        if (entry != nullptr)
+        {
+            entry->state = State::kPresent;
+            entry->size  = size;
+            memcpy(entry->value, value, size);
+        }
+    }
+    else if (entry != nullptr)
+    {
+        // The stored value is unknown after a failed write
+        entry->state = State::kStale;
+    }
+    return err;
+}
+
+CHIP_ERROR GroupDataProviderImpl::StorageCache::SyncDeleteKeyValue(const char * key)
+{
+    Entry * entry = Find(key, HashStorageKey(key));
+    mGeneration++;
+    CHIP_ERROR err = mStorage.SyncDeleteKeyValue(key);
+    if (entry != nullptr)
+    {
+        entry->state = (CHIP_NO_ERROR == err) ? State::kAbsent : State::kStale;
+        entry->size  = 0;
+    }
+    return err;
+}
+
+void GroupDataProviderImpl::StorageCache::Release()
+{
+    if (mEntries != nullptr)
+    {
+        // Keysets bypass the cache, but group names and key maps are still fabric data: do not leave them in freed memory
+        Crypto::ClearSecretData(reinterpret_cast<uint8_t *>(mEntries), mCapacity * sizeof(Entry));
+        Platform::MemoryFree(mEntries);
+    }
+    mEntries  = nullptr;
+    mCapacity = 0;
+    mCount    = 0;
+}
+
+GroupDataProviderImpl::StorageCache::Entry * GroupDataProviderImpl::StorageCache::Find(const char * key, uint32_t hash)
+{
+    VerifyOrReturnError(mCapacity > 0, nullptr);
+
+    // Linear probing, the table is never more than half full
+    for (size_t i = hash & (mCapacity - 1);; i = (i + 1) & (mCapacity - 1))
+    {
+        Entry & entry = mEntries[i];
+        if (entry.state == State::kEmpty)
+        {
+            return nullptr;
+        }
+        if (entry.hash == hash && 0 == strcmp(entry.key, key))
+        {
+            return &entry;
+        }
+    }
+}
+
+GroupDataProviderImpl::StorageCache::Entry * GroupDataProviderImpl::StorageCache::FindOrAdd(const char * key, uint32_t hash)
+{
+    Entry * entry = Find(key, hash);
+    VerifyOrReturnError(entry == nullptr, entry);
+    VerifyOrReturnError(strlen(key) <= kKeyLengthMax, nullptr);
+    VerifyOrReturnError(mCount < CHIP_CONFIG_GROUP_DATA_CACHE_MAX_ENTRIES, nullptr);
+    if (2 * (mCount + 1) > mCapacity)
+    {
+        VerifyOrReturnError(CHIP_NO_ERROR == Grow(), nullptr);
+    }
+
+    size_t i = hash & (mCapacity - 1);
+    while (mEntries[i].state != State::kEmpty)
+    {
+        i = (i + 1) & (mCapacity - 1);
+    }
+    entry        = &mEntries[i];
+    entry->state = State::kStale;
+    entry->size  = 0;
+    entry->hash  = hash;
+    Platform::CopyString(entry->key, key);
+    mCount++;
+    return entry;
+}
+
+CHIP_ERROR GroupDataProviderImpl::StorageCache::Grow()
+{
+    const size_t capacity = (mCapacity > 0) ? 2 * mCapacity : 16;
+    Entry * entries       = static_cast<Entry *>(Platform::MemoryCalloc(capacity, sizeof(Entry)));
+    VerifyOrReturnError(entries != nullptr, CHIP_ERROR_NO_MEMORY);
+    static_assert(static_cast<uint8_t>(State::kEmpty) == 0, "Zeroed entries must be empty");
+
+    for (size_t j = 0; j < mCapacity; j++)
+    {
+        if (mEntries[j].state != State::kEmpty)
+        {
+            size_t i = mEntries[j].hash & (capacity - 1);
+            while (entries[i].state != State::kEmpty)
+            {
+                i = (i + 1) & (capacity - 1);
+            }
+            entries[i] = mEntries[j];
+        }
+    }
+
+    const size_t count = mCount;
+    Release();
+    mEntries  = entries;
+    mCapacity = capacity;
+    mCount    = count;
+    return CHIP_NO_ERROR;
+}
+
 //
 // General
 //
@@ -685,6 +911,10 @@ void GroupDataProviderImpl::Finish()
     mGroupKeyIterators.ReleaseAll();
     mEndpointIterators.ReleaseAll();
     mKeySetIterators.ReleaseAll();
+    mGroupSessionIterators.ReleaseAll();
+    ReleaseGroupSessionIndex();
+    ReleaseEndpointIndex();
+    mStorage.Release();
 }
 
 //
@@ -875,6 +1105,13 @@ bool GroupDataProviderImpl::HasEndpoint(chip::FabricIndex fabric_index, chip::Gr
 {
     VerifyOrReturnError(mInitialized, false);
 
+    if (CHIP_NO_ERROR == UpdateEndpointIndex())
+    {
+        return std::binary_search(mEndpointIndex, mEndpointIndex + mEndpointIndexCount,
+                                  EndpointIndexKey(fabric_index, group_id, endpoint_id));
+    }
+
+    // The index could not be allocated, walk the lists instead
     FabricData fabric(fabric_index);
     GroupData group;
     EndpointData endpoint;
@@ -1046,6 +1283,28 @@ GroupDataProviderImpl::GroupInfoIteratorImpl::GroupInfoIteratorImpl(GroupDataPro
     mProvider(provider),
     mFabric(fabric_index)
 {
+    if (CHIP_NO_ERROR == provider.UpdateEndpointIndex())
+    {
+        GroupIndexEntry * first = nullptr;
+        size_t count            = 0;
+        provider.FindGroupIndexRange(fabric_index, first, count);
+        if (count == 0)
+        {
+            return;
+        }
+        mSnapshot = static_cast<GroupInfo *>(Platform::MemoryCalloc(count, sizeof(GroupInfo)));
+        if (mSnapshot != nullptr)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                mSnapshot[i] = first[i].info;
+            }
+            mTotal = count;
+            return;
+        }
+    }
+
+    // No index, walk the stored group list
     FabricData fabric(fabric_index);
     if (CHIP_NO_ERROR == fabric.Load(provider.mStorage))
     {
@@ -1055,6 +1314,14 @@ GroupDataProviderImpl::GroupInfoIteratorImpl::GroupInfoIteratorImpl(GroupDataPro
     }
 }
 
+GroupDataProviderImpl::GroupInfoIteratorImpl::~GroupInfoIteratorImpl()
+{
+    if (mSnapshot != nullptr)
+    {
+        Platform::MemoryFree(mSnapshot);
+    }
+}
+
 size_t GroupDataProviderImpl::GroupInfoIteratorImpl::Count()
 {
     return mTotal;
@@ -1064,6 +1331,12 @@ bool GroupDataProviderImpl::GroupInfoIteratorImpl::Next(GroupInfo & output)
 {
     VerifyOrReturnError(mCount < mTotal, false);
 
+    if (mSnapshot != nullptr)
+    {
+        output = mSnapshot[mCount++];
+        return true;
+    }
+
     GroupData group(mFabric, mNextId);
     VerifyOrReturnError(CHIP_NO_ERROR == group.Load(mProvider.mStorage), false);
 
@@ -1090,6 +1363,26 @@ GroupDataProviderImpl::EndpointIteratorImpl::EndpointIteratorImpl(GroupDataProvi
     mProvider(provider),
     mFabric(fabric_index)
 {
+    if (CHIP_NO_ERROR == provider.UpdateEndpointIndex())
+    {
+        const uint64_t * first = nullptr;
+        size_t count           = 0;
+        provider.FindEndpointIndexRange(fabric_index, first, count);
+        if (count == 0)
+        {
+            // Nothing to walk either: the group count stays at zero
+            return;
+        }
+        mSnapshot = static_cast<uint64_t *>(Platform::MemoryCalloc(count, sizeof(uint64_t)));
+        if (mSnapshot != nullptr)
+        {
+            memcpy(mSnapshot, first, count * sizeof(uint64_t));
+            mSnapshotCount = count;
+            return;
+        }
+    }
+
+    // No index, walk the stored group and endpoint lists
     FabricData fabric(fabric_index);
     VerifyOrReturn(CHIP_NO_ERROR == fabric.Load(provider.mStorage));
 
@@ -1103,8 +1396,21 @@ GroupDataProviderImpl::EndpointIteratorImpl::EndpointIteratorImpl(GroupDataProvi
     mEndpointCount = group.endpoint_count;
 }
 
+GroupDataProviderImpl::EndpointIteratorImpl::~EndpointIteratorImpl()
+{
+    if (mSnapshot != nullptr)
+    {
+        Platform::MemoryFree(mSnapshot);
+    }
+}
+
 size_t GroupDataProviderImpl::EndpointIteratorImpl::Count()
 {
+    if (mSnapshot != nullptr)
+    {
+        return mSnapshotCount;
+    }
+
     GroupData group(mFabric, mFirstGroup);
     size_t group_index    = 0;
     size_t endpoint_index = 0;
@@ -1134,6 +1440,15 @@ size_t GroupDataProviderImpl::EndpointIteratorImpl::Count()
 
 bool GroupDataProviderImpl::EndpointIteratorImpl::Next(GroupEndpoint & output)
 {
+    if (mSnapshot != nullptr)
+    {
+        VerifyOrReturnError(mSnapshotIndex < mSnapshotCount, false);
+        const uint64_t key = mSnapshot[mSnapshotIndex++];
+        output.group_id    = static_cast<chip::GroupId>(key >> 16);
+        output.endpoint_id = static_cast<chip::EndpointId>(key);
+        return true;
+    }
+
     while (mGroupIndex < mGroupCount)
     {
         GroupData group(mFabric, mGroup);
@@ -1202,6 +1517,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveEndpoints(chip::FabricIndex fabric_index
 CHIP_ERROR GroupDataProviderImpl::SetGroupKeyAt(chip::FabricIndex fabric_index, size_t index, const GroupKey & in_map)
 {
     VerifyOrReturnError(mInitialized, CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionIndex();
 
     FabricData fabric(fabric_index);
     KeyMapData map(fabric_index);
@@ -1268,6 +1584,7 @@ CHIP_ERROR GroupDataProviderImpl::GetGroupKeyAt(chip::FabricIndex fabric_index,
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_index, size_t index)
 {
     VerifyOrReturnError(mInitialized, CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionIndex();
 
     FabricData fabric(fabric_index);
     KeyMapData map;
@@ -1300,6 +1617,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeyAt(chip::FabricIndex fabric_inde
 CHIP_ERROR GroupDataProviderImpl::RemoveGroupKeys(chip::FabricIndex fabric_index)
 {
     VerifyOrReturnError(mInitialized, CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionIndex();
 
     FabricData fabric(fabric_index);
     VerifyOrReturnError(CHIP_NO_ERROR == fabric.Load(mStorage), CHIP_ERROR_INVALID_FABRIC_ID);
@@ -1372,9 +1690,12 @@ void GroupDataProviderImpl::GroupKeyIteratorImpl::Release()
 
 constexpr size_t GroupDataProvider::EpochKey::kLengthBytes;
 
-CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, const KeySet & in_keyset)
+CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, const ByteSpan & compressed_fabric_id,
+                                            const KeySet & in_keyset)
 {
     VerifyOrReturnError(mInitialized, CHIP_ERROR_INTERNAL);
+    VerifyOrReturnError(Crypto::kCompressedFabricIdentifierSize == compressed_fabric_id.size(), CHIP_ERROR_INVALID_ARGUMENT);
+    InvalidateGroupSessionIndex();
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
@@ -1383,8 +1704,15 @@ CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, cons
     CHIP_ERROR err = fabric.Load(mStorage);
     VerifyOrReturnError(CHIP_NO_ERROR == err || CHIP_ERROR_NOT_FOUND == err, err);
 
+    if (!fabric.has_compressed_fabric_id || !compressed_fabric_id.data_equal(ByteSpan(fabric.compressed_fabric_id)))
+    {
+        memcpy(fabric.compressed_fabric_id, compressed_fabric_id.data(), sizeof(fabric.compressed_fabric_id));
+        fabric.has_compressed_fabric_id = true;
+        ReturnErrorOnFailure(fabric.Save(mStorage));
+    }
+
     // Search existing keyset
-    bool found = keyset.Find(mStorage, fabric, in_keyset.keyset_id);
+    bool found = keyset.Find(mStorage.Uncached(), fabric, in_keyset.keyset_id);
 
     keyset.keyset_id     = in_keyset.keyset_id;
     keyset.policy        = in_keyset.policy;
@@ -1394,13 +1722,13 @@ CHIP_ERROR GroupDataProviderImpl::SetKeySet(chip::FabricIndex fabric_index, cons
     if (found)
     {
         // Update existing keyset info, keep next
-        return keyset.Save(mStorage);
+        return keyset.Save(mStorage.Uncached());
     }
     else
     {
         // New keyset, insert first
         keyset.next = fabric.first_keyset;
-        ReturnErrorOnFailure(keyset.Save(mStorage));
+        ReturnErrorOnFailure(keyset.Save(mStorage.Uncached()));
         // Update fabric
         fabric.keyset_count++;
         fabric.first_keyset = in_keyset.keyset_id;
@@ -1416,9 +1744,9 @@ CHIP_ERROR GroupDataProviderImpl::GetKeySet(chip::FabricIndex fabric_index, uint
     KeySetData keyset;
 
     ReturnErrorOnFailure(fabric.Load(mStorage));
-    VerifyOrReturnError(keyset.Find(mStorage, fabric, target_id), CHIP_ERROR_NOT_FOUND);
+    VerifyOrReturnError(keyset.Find(mStorage.Uncached(), fabric, target_id), CHIP_ERROR_NOT_FOUND);
 
-    VerifyOrReturnError(keyset.Find(mStorage, fabric, target_id), CHIP_ERROR_NOT_FOUND);
+    VerifyOrReturnError(keyset.Find(mStorage.Uncached(), fabric, target_id), CHIP_ERROR_NOT_FOUND);
 
     // Target keyset found
     out_keyset.policy        = keyset.policy;
@@ -1430,13 +1758,14 @@ CHIP_ERROR GroupDataProviderImpl::GetKeySet(chip::FabricIndex fabric_index, uint
 CHIP_ERROR GroupDataProviderImpl::RemoveKeySet(chip::FabricIndex fabric_index, uint16_t target_id)
 {
     VerifyOrReturnError(mInitialized, CHIP_ERROR_INTERNAL);
+    InvalidateGroupSessionIndex();
 
     FabricData fabric(fabric_index);
     KeySetData keyset;
 
     ReturnErrorOnFailure(fabric.Load(mStorage));
-    VerifyOrReturnError(keyset.Find(mStorage, fabric, target_id), CHIP_ERROR_NOT_FOUND);
-    ReturnErrorOnFailure(keyset.Delete(mStorage));
+    VerifyOrReturnError(keyset.Find(mStorage.Uncached(), fabric, target_id), CHIP_ERROR_NOT_FOUND);
+    ReturnErrorOnFailure(keyset.Delete(mStorage.Uncached()));
 
     if (keyset.first)
     {
@@ -1447,9 +1776,9 @@ CHIP_ERROR GroupDataProviderImpl::RemoveKeySet(chip::FabricIndex fabric_index, u
     {
         // Remove intermediate keyset, update previous
         KeySetData prev_data(fabric_index, keyset.prev);
-        ReturnErrorOnFailure(prev_data.Load(mStorage));
+        ReturnErrorOnFailure(prev_data.Load(mStorage.Uncached()));
         prev_data.next = keyset.next;
-        ReturnErrorOnFailure(prev_data.Save(mStorage));
+        ReturnErrorOnFailure(prev_data.Save(mStorage.Uncached()));
     }
     if (fabric.keyset_count > 0)
     {
@@ -1487,7 +1816,7 @@ bool GroupDataProviderImpl::KeySetIteratorImpl::Next(KeySet & output)
     VerifyOrReturnError(mCount < mTotal, false);
 
     KeySetData keyset(mFabric, mNextId);
-    VerifyOrReturnError(CHIP_NO_ERROR == keyset.Load(mProvider.mStorage), false);
+    VerifyOrReturnError(CHIP_NO_ERROR == keyset.Load(mProvider.mStorage.Uncached()), false);
 
     mCount++;
     mNextId              = keyset.next;
@@ -1510,6 +1839,7 @@ void GroupDataProviderImpl::KeySetIteratorImpl::Release()
 CHIP_ERROR GroupDataProviderImpl::RemoveFabric(chip::FabricIndex fabric_index)
 {
     FabricData fabric(fabric_index);
+    InvalidateGroupSessionIndex();
 
     // Fabric data defaults to zero, so if not entry is found, no mappings, or keys are removed
     // However, states has a separate list, and needs to be removed regardless
@@ -1538,7 +1868,7 @@ CHIP_ERROR GroupDataProviderImpl::RemoveFabric(chip::FabricIndex fabric_index)
     // Loop the keysets associated with the target fabric
     while (keyset_count < fabric.keyset_count)
     {
-        if (CHIP_NO_ERROR != keyset.Load(mStorage))
+        if (CHIP_NO_ERROR != keyset.Load(mStorage.Uncached()))
         {
             break;
         }
@@ -1552,18 +1882,278 @@ CHIP_ERROR GroupDataProviderImpl::RemoveFabric(chip::FabricIndex fabric_index)
 }
 
 //
-// General
+// Endpoint Index
 //
 
-CHIP_ERROR GroupDataProviderImpl::Decrypt(PacketHeader packetHeader, PayloadHeader & payloadHeader,
-                                          System::PacketBufferHandle & msg)
+CHIP_ERROR GroupDataProviderImpl::UpdateEndpointIndex()
 {
-    (void) packetHeader;
-    (void) payloadHeader;
-    (void) msg;
+    VerifyOrReturnError(!mEndpointIndexValid || mEndpointIndexGeneration != mStorage.GetGeneration(), CHIP_NO_ERROR);
+
+    ReleaseEndpointIndex();
+
+    size_t capacity       = 0;
+    size_t group_capacity = 0;
+    for (FabricIndex fabric_index = kMinValidFabricIndex; fabric_index <= kMaxValidFabricIndex; fabric_index++)
+    {
+        FabricData fabric(fabric_index);
+        if (CHIP_NO_ERROR == fabric.Load(mStorage))
+        {
+            GroupData group(fabric_index, fabric.first_group);
+            for (size_t i = 0; i < fabric.group_count && CHIP_NO_ERROR == group.Load(mStorage); i++, group.id = group.next)
+            {
+                capacity += group.endpoint_count;
+                group_capacity++;
+            }
+        }
+        if (fabric_index == kMaxValidFabricIndex)
+        {
+            break;
+        }
+    }
+
+    if (capacity > 0)
+    {
+        mEndpointIndex = static_cast<uint64_t *>(Platform::MemoryCalloc(capacity, sizeof(uint64_t)));
+        VerifyOrReturnError(mEndpointIndex != nullptr, CHIP_ERROR_NO_MEMORY);
+    }
+    if (group_capacity > 0)
+    {
+        mGroupIndex = static_cast<GroupIndexEntry *>(Platform::MemoryCalloc(group_capacity, sizeof(GroupIndexEntry)));
+        if (mGroupIndex == nullptr)
+        {
+            ReleaseEndpointIndex();
+            return CHIP_ERROR_NO_MEMORY;
+        }
+    }
+
+    // Fabrics are visited in ascending order, so the group index is sorted by fabric and keeps the list order within a fabric
+    for (FabricIndex fabric_index = kMinValidFabricIndex; fabric_index <= kMaxValidFabricIndex; fabric_index++)
+    {
+        FabricData fabric(fabric_index);
+        if (CHIP_NO_ERROR == fabric.Load(mStorage))
+        {
+            GroupData group(fabric_index, fabric.first_group);
+            for (size_t i = 0; i < fabric.group_count && mGroupIndexCount < group_capacity && CHIP_NO_ERROR == group.Load(mStorage);
+                 i++, group.id = group.next)
+            {
+                GroupIndexEntry & entry = mGroupIndex[mGroupIndexCount++];
+                entry.fabric_index      = fabric_index;
+                entry.info.group_id     = group.group_id;
+                entry.info.SetName(group.name);
+
+                EndpointData endpoint(fabric_index, group.id, group.first_endpoint);
+                for (size_t j = 0;
+                     j < group.endpoint_count && mEndpointIndexCount < capacity && CHIP_NO_ERROR == endpoint.Load(mStorage);
+                     j++, endpoint.id = endpoint.next)
+                {
+                    mEndpointIndex[mEndpointIndexCount++] = EndpointIndexKey(fabric_index, group.group_id, endpoint.endpoint_id);
+                }
+            }
+        }
+        if (fabric_index == kMaxValidFabricIndex)
+        {
+            break;
+        }
+    }
+
+    if (mEndpointIndexCount > 0)
+    {
+        std::sort(mEndpointIndex, mEndpointIndex + mEndpointIndexCount);
+    }
+
+    mEndpointIndexGeneration = mStorage.GetGeneration();
+    mEndpointIndexValid      = true;
     return CHIP_NO_ERROR;
 }
 
+void GroupDataProviderImpl::ReleaseEndpointIndex()
+{
+    if (mEndpointIndex != nullptr)
+    {
+        Platform::MemoryFree(mEndpointIndex);
+    }
+    if (mGroupIndex != nullptr)
+    {
+        Platform::MemoryFree(mGroupIndex);
+    }
+    mEndpointIndex      = nullptr;
+    mEndpointIndexCount = 0;
+    mGroupIndex         = nullptr;
+    mGroupIndexCount    = 0;
+    mEndpointIndexValid = false;
+}
+
+void GroupDataProviderImpl::FindEndpointIndexRange(chip::FabricIndex fabric_index, const uint64_t *& first, size_t & count)
+{
+    const uint64_t * begin = mEndpointIndex;
+    const uint64_t * end   = mEndpointIndex + mEndpointIndexCount;
+    first                  = std::lower_bound(begin, end, EndpointIndexKey(fabric_index, 0, 0));
+    const uint64_t * last  = std::lower_bound(first, end, static_cast<uint64_t>(fabric_index + 1) << 32);
+    count                  = static_cast<size_t>(last - first);
+}
+
+void GroupDataProviderImpl::FindGroupIndexRange(chip::FabricIndex fabric_index, GroupIndexEntry *& first, size_t & count)
+{
+    auto before = [](const GroupIndexEntry & entry, chip::FabricIndex fabric) { return entry.fabric_index < fabric; };
+    auto after  = [](chip::FabricIndex fabric, const GroupIndexEntry & entry) { return fabric < entry.fabric_index; };
+
+    GroupIndexEntry * end  = mGroupIndex + mGroupIndexCount;
+    first                  = std::lower_bound(mGroupIndex, end, fabric_index, before);
+    GroupIndexEntry * last = std::upper_bound(first, end, fabric_index, after);
+    count                  = static_cast<size_t>(last - first);
+}
+
+//
+// Group Sessions
+//
+
+CHIP_ERROR GroupDataProviderImpl::UpdateGroupSessionIndex()
+{
+    VerifyOrReturnError(!mGroupSessionIndexValid, CHIP_NO_ERROR);
+
+    ReleaseGroupSessionIndex();
+
+    // Upper bound of the index size: every group-key map entry may use every epoch key of its keyset.
+    size_t capacity = 0;
+    for (FabricIndex fabric_index = kMinValidFabricIndex; fabric_index <= kMaxValidFabricIndex; fabric_index++)
+    {
+        FabricData fabric(fabric_index);
+        if (CHIP_NO_ERROR == fabric.Load(mStorage) && fabric.has_compressed_fabric_id)
+        {
+            capacity += fabric.map_count * ArraySize(KeySet().epoch_keys);
+        }
+        if (fabric_index == kMaxValidFabricIndex)
+        {
+            break;
+        }
+    }
+    if (capacity == 0)
+    {
+        mGroupSessionIndexValid = true;
+        return CHIP_NO_ERROR;
+    }
+
+    mGroupSessions = static_cast<GroupSessionEntry *>(Platform::MemoryCalloc(capacity, sizeof(GroupSessionEntry)));
+    VerifyOrReturnError(mGroupSessions != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    for (FabricIndex fabric_index = kMinValidFabricIndex; fabric_index <= kMaxValidFabricIndex; fabric_index++)
+    {
+        FabricData fabric(fabric_index);
+        if (CHIP_NO_ERROR == fabric.Load(mStorage) && fabric.has_compressed_fabric_id)
+        {
+            const ByteSpan compressed_fabric_id(fabric.compressed_fabric_id);
+            KeyMapData map(fabric_index, fabric.first_map);
+
+            for (size_t i = 0; i < fabric.map_count && CHIP_NO_ERROR == map.Load(mStorage); i++, map.id = map.next)
+            {
+                KeySetData keyset;
+                if (!keyset.Find(mStorage.Uncached(), fabric, map.keyset_id))
+                {
+                    continue;
+                }
+
+                for (size_t k = 0; k < keyset.num_keys_used && k < ArraySize(keyset.epoch_keys) && mGroupSessionCount < capacity;
+                     k++)
+                {
+                    GroupSessionEntry & entry = *new (&mGroupSessions[mGroupSessionCount]) GroupSessionEntry();
+                    MutableByteSpan key(entry.key);
+
+                    ReturnErrorOnFailure(Crypto::DeriveGroupOperationalKey(
+                        ByteSpan(keyset.epoch_keys[k].key, EpochKey::kLengthBytes), compressed_fabric_id, key));
+                    ReturnErrorOnFailure(Crypto::DeriveGroupSessionId(key, entry.session_id));
+                    entry.group_id        = map.group_id;
+                    entry.fabric_index    = fabric_index;
+                    entry.security_policy = keyset.policy;
+                    entry.start_time      = keyset.epoch_keys[k].start_time;
+                    mGroupSessionCount++;
+                }
+            }
+        }
+        if (fabric_index == kMaxValidFabricIndex)
+        {
+            break;
+        }
+    }
+
+    std::sort(mGroupSessions, mGroupSessions + mGroupSessionCount,
+              [](const GroupSessionEntry & a, const GroupSessionEntry & b) { return a.session_id < b.session_id; });
+
+    mGroupSessionIndexValid = true;
+    return CHIP_NO_ERROR;
+}
+
+void GroupDataProviderImpl::ReleaseGroupSessionIndex()
+{
+    if (mGroupSessions != nullptr)
+    {
+        Crypto::ClearSecretData(reinterpret_cast<uint8_t *>(mGroupSessions), mGroupSessionCount * sizeof(GroupSessionEntry));
+        Platform::MemoryFree(mGroupSessions);
+    }
+    mGroupSessions          = nullptr;
+    mGroupSessionCount      = 0;
+    mGroupSessionIndexValid = false;
+}
+
+GroupDataProvider::GroupSessionIterator * GroupDataProviderImpl::IterateGroupSessions(uint16_t session_id)
+{
+    VerifyOrReturnError(mInitialized, nullptr);
+    VerifyOrReturnError(CHIP_NO_ERROR == UpdateGroupSessionIndex(), nullptr);
+    return mGroupSessionIterators.CreateObject(*this, session_id);
+}
+
+CHIP_ERROR GroupDataProviderImpl::GetGroupSession(chip::FabricIndex fabric_index, chip::GroupId group_id, GroupSession & session)
+{
+    VerifyOrReturnError(mInitialized, CHIP_ERROR_INTERNAL);
+    ReturnErrorOnFailure(UpdateGroupSessionIndex());
+
+    // Without a trusted time source, the epoch key with the latest start time is the current one.
+    const GroupSessionEntry * current = nullptr;
+    for (size_t i = 0; i < mGroupSessionCount; i++)
+    {
+        const GroupSessionEntry & entry = mGroupSessions[i];
+        if (entry.fabric_index == fabric_index && entry.group_id == group_id &&
+            (current == nullptr || entry.start_time > current->start_time))
+        {
+            current = &entry;
+        }
+    }
+    VerifyOrReturnError(current != nullptr, CHIP_ERROR_NOT_FOUND);
+
+    session = *current;
+    return CHIP_NO_ERROR;
+}
+
+GroupDataProviderImpl::GroupSessionIteratorImpl::GroupSessionIteratorImpl(GroupDataProviderImpl & provider, uint16_t session_id) :
+    mProvider(provider)
+{
+    const GroupSessionEntry * begin = provider.mGroupSessions;
+    const GroupSessionEntry * end   = provider.mGroupSessions + provider.mGroupSessionCount;
+    auto first = std::lower_bound(begin, end, session_id,
+                                  [](const GroupSessionEntry & entry, uint16_t id) { return entry.session_id < id; });
+    auto last  = std::upper_bound(first, end, session_id,
+                                 [](uint16_t id, const GroupSessionEntry & entry) { return id < entry.session_id; });
+    mFirst = static_cast<size_t>(first - begin);
+    mIndex = mFirst;
+    mEnd   = static_cast<size_t>(last - begin);
+}
+
+size_t GroupDataProviderImpl::GroupSessionIteratorImpl::Count()
+{
+    return mEnd - mFirst;
+}
+
+bool GroupDataProviderImpl::GroupSessionIteratorImpl::Next(GroupSession & output)
+{
+    VerifyOrReturnError(mIndex < mEnd && mIndex < mProvider.mGroupSessionCount, false);
+    output = mProvider.mGroupSessions[mIndex++];
+    return true;
+}
+
+void GroupDataProviderImpl::GroupSessionIteratorImpl::Release()
+{
+    mProvider.mGroupSessionIterators.ReleaseObject(this);
+}
+
 namespace {
 
 GroupDataProvider * gGroupsProvider = nullptr;
@@ -1587,16 +2177,14 @@ GroupDataProvider * GetGroupDataProvider()
  *
  * Callers have to externally synchronize usage of this function.
  *
- * If the `provider` is nullptr, no change is done.
+ * If the `provider` is nullptr, the global instance is cleared and GetGroupDataProvider() returns nullptr
+ * until another provider is set. Earlier versions ignored nullptr.
  *
- * @param[in] provider the GroupDataProvider to start returning with the getter
+ * @param[in] provider the GroupDataProvider to start returning with the getter, or nullptr
  */
 void SetGroupDataProvider(GroupDataProvider * provider)
 {
-    if (provider)
-    {
-        gGroupsProvider = provider;
-    }
+    gGroupsProvider = provider;
 }
 
 } // namespace Credentials
@@ -34,7 +34,11 @@ public:
         GroupDataProvider(maxGroupsPerFabric, maxGroupKeysPerFabric),
         mStorage(storage_delegate)
     {}
-    virtual ~GroupDataProviderImpl() {}
+    virtual ~GroupDataProviderImpl()
+    {
+        ReleaseGroupSessionIndex();
+        ReleaseEndpointIndex();
+    }
 
     CHIP_ERROR Init() override;
     void Finish() override;
@@ -74,7 +78,7 @@ public:
     // Key Sets
     //
 
-    CHIP_ERROR SetKeySet(chip::FabricIndex fabric_index, const KeySet & keys) override;
+    CHIP_ERROR SetKeySet(chip::FabricIndex fabric_index, const ByteSpan & compressed_fabric_id, const KeySet & keys) override;
     CHIP_ERROR GetKeySet(chip::FabricIndex fabric_index, chip::KeysetId keyset_id, KeySet & keys) override;
     CHIP_ERROR RemoveKeySet(chip::FabricIndex fabric_index, chip::KeysetId keyset_id) override;
     KeySetIterator * IterateKeySets(chip::FabricIndex fabric_index) override;
@@ -82,14 +86,26 @@ public:
     // Fabrics
     CHIP_ERROR RemoveFabric(chip::FabricIndex fabric_index) override;
 
-    // General
-    CHIP_ERROR Decrypt(PacketHeader packetHeader, PayloadHeader & payloadHeader, System::PacketBufferHandle & msg) override;
+    //
+    // Group Sessions
+    //
+
+    GroupSessionIterator * IterateGroupSessions(uint16_t session_id) override;
+    CHIP_ERROR GetGroupSession(chip::FabricIndex fabric_index, chip::GroupId group_id, GroupSession & session) override;
 
 private:
+    // Entry of the in-memory group session index
+    struct GroupSessionEntry : public GroupSession
+    {
+        // Start time of the epoch key the operational key was derived from
+        uint64_t start_time = 0;
+    };
+
     class GroupInfoIteratorImpl : public GroupInfoIterator
     {
     public:
         GroupInfoIteratorImpl(GroupDataProviderImpl & provider, chip::FabricIndex fabric_index);
+        ~GroupInfoIteratorImpl() override;
         size_t Count() override;
         bool Next(GroupInfo & output) override;
         void Release() override;
@@ -100,6 +116,8 @@ private:
         uint16_t mNextId          = 0;
         size_t mCount             = 0;
         size_t mTotal             = 0;
+        // Copy of the fabric's groups taken from the group index, or null to walk the stored group list instead
+        GroupInfo * mSnapshot = nullptr;
     };
 
     class GroupKeyIteratorImpl : public GroupKeyIterator
@@ -122,6 +140,7 @@ private:
     {
     public:
         EndpointIteratorImpl(GroupDataProviderImpl & provider, chip::FabricIndex fabric_index);
+        ~EndpointIteratorImpl() override;
         size_t Count() override;
         bool Next(GroupEndpoint & output) override;
         void Release() override;
@@ -136,6 +155,10 @@ private:
         uint16_t mEndpoint        = 0;
         size_t mEndpointIndex     = 0;
         size_t mEndpointCount     = 0;
+        // Copy of the fabric's memberships taken from the endpoint index, or null to walk the stored lists instead
+        uint64_t * mSnapshot  = nullptr;
+        size_t mSnapshotCount = 0;
+        size_t mSnapshotIndex = 0;
     };
 
     class KeySetIteratorImpl : public KeySetIterator
@@ -153,14 +176,118 @@ private:
         size_t mCount             = 0;
         size_t mTotal             = 0;
     };
+    class GroupSessionIteratorImpl : public GroupSessionIterator
+    {
+    public:
+        GroupSessionIteratorImpl(GroupDataProviderImpl & provider, uint16_t session_id);
+        size_t Count() override;
+        bool Next(GroupSession & output) override;
+        void Release() override;
+
+    private:
+        GroupDataProviderImpl & mProvider;
+        size_t mFirst = 0;
+        size_t mIndex = 0;
+        size_t mEnd   = 0;
+    };
     CHIP_ERROR RemoveEndpoints(chip::FabricIndex fabric_index, chip::GroupId group_id);
 
-    chip::PersistentStorageDelegate & mStorage;
+    // Write-through cache of the stored records, indexed by storage key. Lookups walk the linked lists of groups,
+    // endpoints, maps and keysets on every access, so reads are served from memory once a record has been loaded
+    // (or found missing). Writes reach the backing storage immediately, and are skipped when the stored value is
+    // unchanged.
+    class StorageCache : public chip::PersistentStorageDelegate
+    {
+    public:
+        StorageCache(chip::PersistentStorageDelegate & storage) : mStorage(storage) {}
+        ~StorageCache() override { Release(); }
+
+        CHIP_ERROR SyncGetKeyValue(const char * key, void * buffer, uint16_t & size) override;
+        CHIP_ERROR SyncSetKeyValue(const char * key, const void * value, uint16_t size) override;
+        CHIP_ERROR SyncDeleteKeyValue(const char * key) override;
+
+        // Drop all cached records
+        void Release();
+
+        // The backing storage, for the records that must not be kept in memory: the keysets hold the plaintext epoch keys
+        chip::PersistentStorageDelegate & Uncached() { return mStorage; }
+
+        // Changes whenever a record is written or deleted, so that indexes derived from the records can tell they are stale
+        uint32_t GetGeneration() const { return mGeneration; }
+
+    private:
+        static constexpr size_t kKeyLengthMax   = 32;
+        static constexpr size_t kValueLengthMax = 128;
+
+        enum class State : uint8_t
+        {
+            kEmpty,   // Unused slot
+            kPresent, // Value cached
+            kAbsent,  // Known missing from storage
+            kStale,   // Must be read from storage again
+        };
+
+        struct Entry
+        {
+            State state;
+            uint16_t size;
+            uint32_t hash;
+            char key[kKeyLengthMax + 1];
+            uint8_t value[kValueLengthMax];
+        };
+
+        Entry * Find(const char * key, uint32_t hash);
+        Entry * FindOrAdd(const char * key, uint32_t hash);
+        CHIP_ERROR Grow();
+
+        chip::PersistentStorageDelegate & mStorage;
+        Entry * mEntries = nullptr;
+        size_t mCapacity    = 0;
+        size_t mCount       = 0;
+        uint32_t mGeneration = 0;
+    };
+
+    // The group session index maps session ids to operational group keys. It is derived from the stored key sets and
+    // group-key maps, rebuilt lazily after any of them changes, and kept sorted by session id so that the candidate
+    // keys for a received message are found with a binary search.
+    CHIP_ERROR UpdateGroupSessionIndex();
+    void InvalidateGroupSessionIndex() { mGroupSessionIndexValid = false; }
+    void ReleaseGroupSessionIndex();
+
+    // The endpoint index holds every (fabric, group, endpoint) membership as a sorted array of packed keys, so that
+    // HasEndpoint is a binary search instead of a walk of the group and endpoint lists. Alongside it, the group index
+    // holds the groups of every fabric, by fabric and in list order, for the group iterators. Both are rebuilt lazily
+    // whenever the stored records have changed since they were built.
+    struct GroupIndexEntry
+    {
+        chip::FabricIndex fabric_index;
+        GroupInfo info;
+    };
+
+    CHIP_ERROR UpdateEndpointIndex();
+    void ReleaseEndpointIndex();
+    // Ranges of the given fabric in the endpoint and group indexes; only valid after a successful UpdateEndpointIndex()
+    void FindEndpointIndexRange(chip::FabricIndex fabric_index, const uint64_t *& first, size_t & count);
+    void FindGroupIndexRange(chip::FabricIndex fabric_index, GroupIndexEntry *& first, size_t & count);
+
+    StorageCache mStorage;
     bool mInitialized = false;
     BitMapObjectPool<GroupInfoIteratorImpl, kIteratorsMax> mGroupInfoIterators;
     BitMapObjectPool<GroupKeyIteratorImpl, kIteratorsMax> mGroupKeyIterators;
     BitMapObjectPool<EndpointIteratorImpl, kIteratorsMax> mEndpointIterators;
     BitMapObjectPool<KeySetIteratorImpl, kIteratorsMax> mKeySetIterators;
+    BitMapObjectPool<GroupSessionIteratorImpl, kIteratorsMax> mGroupSessionIterators;
+
+    GroupSessionEntry * mGroupSessions = nullptr;
+    size_t mGroupSessionCount          = 0;
+    bool mGroupSessionIndexValid       = false;
+
+    uint64_t * mEndpointIndex         = nullptr;
+    size_t mEndpointIndexCount        = 0;
+    GroupIndexEntry * mGroupIndex     = nullptr;
+    size_t mGroupIndexCount           = 0;
+    uint32_t mEndpointIndexGeneration = 0;
+    bool mEndpointIndexValid          = false;
 };
 
 } // namespace Credentials
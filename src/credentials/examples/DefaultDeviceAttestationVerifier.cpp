@@ -22,10 +22,12 @@
 #include <credentials/DeviceAttestationVendorReserved.h>
 #include <crypto/CHIPCryptoPAL.h>
 
+#include <lib/core/CHIPConfig.h>
 #include <lib/core/CHIPError.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/ScopedBuffer.h>
 #include <lib/support/Span.h>
+#include <system/SystemMutex.h>
 
 // TODO: Remove once the Attestation Credentials storage mechanism is updated.
 namespace chip {
@@ -145,7 +147,10 @@ CHIP_ERROR GetCertificationDeclarationCertificate(const ByteSpan & skid, Mutable
 class DefaultDACVerifier : public DeviceAttestationVerifier
 {
 public:
-    DefaultDACVerifier(const AttestationTrustStore * paaRootStore) : mAttestationTrustStore(paaRootStore) {}
+    DefaultDACVerifier(const AttestationTrustStore * paaRootStore) : mAttestationTrustStore(paaRootStore)
+    {
+        System::Mutex::Init(mVerifiedPaiLock);
+    }
 
     AttestationVerificationResult VerifyAttestationInformation(const ByteSpan & attestationInfoBuffer,
                                                                const ByteSpan & attestationChallengeBuffer,
@@ -161,11 +166,64 @@ public:
                                                                         const DeviceInfoForAttestation & deviceInfo) override;
 
 protected:
-    DefaultDACVerifier() {}
+    DefaultDACVerifier() { System::Mutex::Init(mVerifiedPaiLock); }
+
+    using VerifiedPaiKey = uint8_t[kSHA256_Hash_Length];
+
+    static CHIP_ERROR ComputeVerifiedPaiKey(const ByteSpan & paaDerBuffer, const ByteSpan & paiDerBuffer, VerifiedPaiKey & key);
+    bool IsVerifiedPai(const VerifiedPaiKey & key);
+    void AddVerifiedPai(const VerifiedPaiKey & key);
 
     const AttestationTrustStore * mAttestationTrustStore;
+
+    // Hashes of the (PAA, PAI) pairs that passed chain validation. Verification may run on several crypto worker threads.
+    System::Mutex mVerifiedPaiLock;
+    VerifiedPaiKey mVerifiedPais[CHIP_CONFIG_DEVICE_ATTESTATION_VERIFIED_PAI_CACHE_SIZE];
+    uint8_t mVerifiedPaiCount = 0;
+    uint8_t mNextVerifiedPai  = 0;
 };
 
+CHIP_ERROR DefaultDACVerifier::ComputeVerifiedPaiKey(const ByteSpan & paaDerBuffer, const ByteSpan & paiDerBuffer,
+                                                     VerifiedPaiKey & key)
+{
+    Hash_SHA256_stream hashStream;
+    MutableByteSpan keySpan(key);
+
+    ReturnErrorOnFailure(hashStream.Begin());
+    ReturnErrorOnFailure(hashStream.AddData(paaDerBuffer));
+    ReturnErrorOnFailure(hashStream.AddData(paiDerBuffer));
+    return hashStream.Finish(keySpan);
+}
+
+bool DefaultDACVerifier::IsVerifiedPai(const VerifiedPaiKey & key)
+{
+    bool found = false;
+
+    mVerifiedPaiLock.Lock();
+    for (uint8_t i = 0; i < mVerifiedPaiCount && !found; i++)
+    {
+        found = (memcmp(mVerifiedPais[i], key, sizeof(VerifiedPaiKey)) == 0);
+    }
+    mVerifiedPaiLock.Unlock();
+
+    return found;
+}
+
+void DefaultDACVerifier::AddVerifiedPai(const VerifiedPaiKey & key)
+{
+    mVerifiedPaiLock.Lock();
+
+    // Replace the oldest entry once the cache is full.
+    memcpy(mVerifiedPais[mNextVerifiedPai], key, sizeof(VerifiedPaiKey));
+    mNextVerifiedPai = static_cast<uint8_t>((mNextVerifiedPai + 1) % CHIP_CONFIG_DEVICE_ATTESTATION_VERIFIED_PAI_CACHE_SIZE);
+    if (mVerifiedPaiCount < CHIP_CONFIG_DEVICE_ATTESTATION_VERIFIED_PAI_CACHE_SIZE)
+    {
+        mVerifiedPaiCount++;
+    }
+
+    mVerifiedPaiLock.Unlock();
+}
+
 AttestationVerificationResult DefaultDACVerifier::VerifyAttestationInformation(const ByteSpan & attestationInfoBuffer,
                                                                                const ByteSpan & attestationChallengeBuffer,
                                                                                const ByteSpan & attestationSignatureBuffer,
@@ -228,10 +286,25 @@ AttestationVerificationResult DefaultDACVerifier::VerifyAttestationInformation(c
     VerifyOrReturnError(IsCertificateValidAtIssuance(dacDerBuffer, paaDerBuffer) == CHIP_NO_ERROR,
                         AttestationVerificationResult::kPaaExpired);
 
+    // DACs of a product line share their PAI, so the PAI only needs to be validated against its PAA once.
+    VerifiedPaiKey paiKey;
+    VerifyOrReturnError(ComputeVerifiedPaiKey(paaDerBuffer, paiDerBuffer, paiKey) == CHIP_NO_ERROR,
+                        AttestationVerificationResult::kInternalError);
+
     CertificateChainValidationResult chainValidationResult;
-    VerifyOrReturnError(ValidateCertificateChain(paaDerBuffer.data(), paaDerBuffer.size(), paiDerBuffer.data(), paiDerBuffer.size(),
-                                                 dacDerBuffer.data(), dacDerBuffer.size(), chainValidationResult) == CHIP_NO_ERROR,
-                        MapError(chainValidationResult));
+    if (IsVerifiedPai(paiKey))
+    {
+        VerifyOrReturnError(ValidateCertificateAgainstTrustedCA(paiDerBuffer, dacDerBuffer, chainValidationResult) == CHIP_NO_ERROR,
+                            MapError(chainValidationResult));
+    }
+    else
+    {
+        VerifyOrReturnError(ValidateCertificateChain(paaDerBuffer.data(), paaDerBuffer.size(), paiDerBuffer.data(),
+                                                     paiDerBuffer.size(), dacDerBuffer.data(), dacDerBuffer.size(),
+                                                     chainValidationResult) == CHIP_NO_ERROR,
+                            MapError(chainValidationResult));
+        AddVerifiedPai(paiKey);
+    }
 
     // if PAA contains VID, see if matches with DAC's VID.
     {
@@ -217,6 +217,12 @@ static void TestDACVerifierExample_AttestationInfoVerification(nlTestSuite * inS
         ByteSpan(attestationElementsTestVector), ByteSpan(attestationChallengeTestVector), ByteSpan(attestationSignatureTestVector),
         pai_span, dac_span, ByteSpan(attestationNonceTestVector));
     NL_TEST_ASSERT(inSuite, attestation_result == AttestationVerificationResult::kSuccess);
+
+    // The PAI was verified above, so this time only the DAC is checked against it.
+    attestation_result = default_verifier->VerifyAttestationInformation(
+        ByteSpan(attestationElementsTestVector), ByteSpan(attestationChallengeTestVector), ByteSpan(attestationSignatureTestVector),
+        pai_span, dac_span, ByteSpan(attestationNonceTestVector));
+    NL_TEST_ASSERT(inSuite, attestation_result == AttestationVerificationResult::kSuccess);
 }
 
 static void TestDACVerifierExample_CertDeclarationVerification(nlTestSuite * inSuite, void * inContext)
@@ -27,12 +27,15 @@
 #include <lib/core/CHIPCore.h>
 
 #include <credentials/FabricTable.h>
+#include <credentials/tests/CHIPCert_test_vectors.h>
 
 #include <lib/support/CodeUtils.h>
 #include <lib/support/UnitTestRegistration.h>
 #include <stdarg.h>
 
 using namespace chip;
+using namespace chip::Credentials;
+using namespace chip::TestCerts;
 
 static const uint8_t sTestRootCert[] = {
     0x15, 0x30, 0x01, 0x08, 0x59, 0xea, 0xa6, 0x32, 0x94, 0x7f, 0x54, 0x1c, 0x24, 0x02, 0x01, 0x37, 0x03, 0x27, 0x14, 0x01, 0x00,
@@ -73,6 +76,79 @@ void TestGetCompressedFabricID(nlTestSuite * inSuite, void * inContext)
     NL_TEST_ASSERT(inSuite, compressedId.GetNodeId() == 0xdeed);
 }
 
+static const BitFlags<TestCertLoadFlags> sNullLoadFlag;
+
+static CHIP_ERROR VerifyTestCredentials(FabricInfo & fabricInfo, const ByteSpan & noc, const ByteSpan & icac, PeerId & nocPeerId,
+                                        FabricId & fabricId)
+{
+    ValidationContext validContext;
+    validContext.Reset();
+    validContext.mRequiredKeyUsages.Set(KeyUsageFlags::kDigitalSignature);
+
+    ASN1::ASN1UniversalTime effectiveTime;
+    effectiveTime.Year   = 2022;
+    effectiveTime.Month  = 1;
+    effectiveTime.Day    = 1;
+    effectiveTime.Hour   = 0;
+    effectiveTime.Minute = 0;
+    effectiveTime.Second = 0;
+    ReturnErrorOnFailure(ASN1ToChipEpochTime(effectiveTime, validContext.mEffectiveTime));
+
+    Crypto::P256PublicKey nocPubkey;
+    return fabricInfo.VerifyCredentials(noc, icac, validContext, nocPeerId, fabricId, nocPubkey);
+}
+
+void TestVerifyCredentialsCache(nlTestSuite * inSuite, void * inContext)
+{
+    FabricInfo fabricInfo;
+    ByteSpan rootCert, icaCert, nocCert, rootIssuedNocCert, otherIcaCert, otherNocCert;
+    PeerId nocPeerId;
+    FabricId fabricId;
+
+    NL_TEST_ASSERT(inSuite, GetTestCert(TestCert::kRoot01, sNullLoadFlag, rootCert) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, GetTestCert(TestCert::kICA01, sNullLoadFlag, icaCert) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, GetTestCert(TestCert::kNode01_01, sNullLoadFlag, nocCert) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, GetTestCert(TestCert::kNode01_02, sNullLoadFlag, rootIssuedNocCert) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, GetTestCert(TestCert::kICA02, sNullLoadFlag, otherIcaCert) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, GetTestCert(TestCert::kNode02_01, sNullLoadFlag, otherNocCert) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, fabricInfo.SetRootCert(rootCert) == CHIP_NO_ERROR);
+
+    // The first verification goes through the whole chain, the second one reuses the verified ICAC.
+    for (int i = 0; i < 2; i++)
+    {
+        NL_TEST_ASSERT(inSuite, VerifyTestCredentials(fabricInfo, nocCert, icaCert, nocPeerId, fabricId) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, nocPeerId.GetNodeId() == 0xDEDEDEDE00010001);
+        NL_TEST_ASSERT(inSuite, fabricId == 0xFAB000000000001D);
+    }
+
+    // A NOC presented along with a cached ICAC still has its own signature verified.
+    uint8_t badNocCert[kMaxCHIPCertLength];
+    memcpy(badNocCert, nocCert.data(), nocCert.size());
+    badNocCert[nocCert.size() - 3] ^= 0x01;
+    NL_TEST_ASSERT(inSuite,
+                   VerifyTestCredentials(fabricInfo, ByteSpan(badNocCert, nocCert.size()), icaCert, nocPeerId, fabricId) !=
+                       CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite,
+                   VerifyTestCredentials(fabricInfo, rootIssuedNocCert, icaCert, nocPeerId, fabricId) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, nocPeerId.GetNodeId() == 0xDEDEDEDE00010002);
+
+    // An ICAC issued by another root is not trusted, and doesn't get cached.
+    for (int i = 0; i < 2; i++)
+    {
+        NL_TEST_ASSERT(inSuite,
+                       VerifyTestCredentials(fabricInfo, otherNocCert, otherIcaCert, nocPeerId, fabricId) != CHIP_NO_ERROR);
+    }
+
+    // Changing the root drops the verified ICACs.
+    NL_TEST_ASSERT(inSuite, GetTestCert(TestCert::kRoot02, sNullLoadFlag, rootCert) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, fabricInfo.SetRootCert(rootCert) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, VerifyTestCredentials(fabricInfo, nocCert, icaCert, nocPeerId, fabricId) != CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, VerifyTestCredentials(fabricInfo, otherNocCert, otherIcaCert, nocPeerId, fabricId) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, nocPeerId.GetNodeId() == 0xDEDEDEDE00020001);
+}
+
 // Test Suite
 
 /**
@@ -82,6 +158,7 @@ void TestGetCompressedFabricID(nlTestSuite * inSuite, void * inContext)
 static const nlTest sTests[] =
 {
     NL_TEST_DEF("Compressed Fabric ID",    TestGetCompressedFabricID),
+    NL_TEST_DEF("Verify Credentials Cache", TestVerifyCredentialsCache),
     NL_TEST_SENTINEL()
 };
 // clang-format on
@@ -0,0 +1,186 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+#include <credentials/CHIPCert.h>
+#include <credentials/FileAttestationTrustStore.h>
+
+#include <lib/core/CHIPError.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/Span.h>
+#include <lib/support/UnitTestRegistration.h>
+
+#include <nlunit-test.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unistd.h>
+
+#include "CHIPAttCert_test_vectors.h"
+
+using namespace chip;
+using namespace chip::Credentials;
+
+namespace {
+
+bool WriteFile(const std::string & path, const ByteSpan & contents)
+{
+    FILE * file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    bool written = fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+    fclose(file);
+    return written;
+}
+
+void CheckPaaCert(nlTestSuite * inSuite, const FileAttestationTrustStore & trustStore, const ByteSpan & skid,
+                  const ByteSpan & expectedCert)
+{
+    uint8_t buf[kMaxDERCertLength];
+    MutableByteSpan paaCertSpan{ buf };
+    NL_TEST_ASSERT(inSuite, trustStore.GetProductAttestationAuthorityCert(skid, paaCertSpan) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, paaCertSpan.data_equal(expectedCert));
+}
+
+} // namespace
+
+static void TestFileAttestationTrustStore_AddPaaCert(nlTestSuite * inSuite, void * inContext)
+{
+    FileAttestationTrustStore trustStore;
+
+    // Certificates are found whatever order they were added in.
+    NL_TEST_ASSERT(inSuite, trustStore.AddPaaCert(TestCerts::sTestCert_PAA_NoVID_Cert) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, trustStore.AddPaaCert(TestCerts::sTestCert_PAA_FFF1_Cert) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, trustStore.GetPaaCertCount() == 2);
+
+    CheckPaaCert(inSuite, trustStore, TestCerts::sTestCert_PAA_FFF1_SKID, TestCerts::sTestCert_PAA_FFF1_Cert);
+    CheckPaaCert(inSuite, trustStore, TestCerts::sTestCert_PAA_NoVID_SKID, TestCerts::sTestCert_PAA_NoVID_Cert);
+
+    NL_TEST_ASSERT(inSuite, trustStore.AddPaaCert(TestCerts::sTestCert_PAA_FFF1_Cert) == CHIP_ERROR_DUPLICATE_KEY_ID);
+    NL_TEST_ASSERT(inSuite, trustStore.AddPaaCert(TestCerts::sTestCert_PAA_FFF1_SKID) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, trustStore.AddPaaCert(ByteSpan()) == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, trustStore.GetPaaCertCount() == 2);
+
+    uint8_t buf[kMaxDERCertLength];
+    MutableByteSpan paaCertSpan{ buf };
+
+    // The PAI SKID is well formed, but isn't one of a PAA in the store.
+    NL_TEST_ASSERT(inSuite,
+                   trustStore.GetProductAttestationAuthorityCert(TestCerts::sTestCert_PAI_FFF1_8000_SKID, paaCertSpan) ==
+                       CHIP_ERROR_CA_CERT_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite,
+                   trustStore.GetProductAttestationAuthorityCert(TestCerts::sTestCert_PAA_FFF1_SKID.SubSpan(1), paaCertSpan) ==
+                       CHIP_ERROR_INVALID_ARGUMENT);
+
+    paaCertSpan = paaCertSpan.SubSpan(0, 16);
+    NL_TEST_ASSERT(inSuite,
+                   trustStore.GetProductAttestationAuthorityCert(TestCerts::sTestCert_PAA_FFF1_SKID, paaCertSpan) ==
+                       CHIP_ERROR_BUFFER_TOO_SMALL);
+}
+
+static void TestFileAttestationTrustStore_LoadPaaCerts(nlTestSuite * inSuite, void * inContext)
+{
+    char dirTemplate[] = "/tmp/chip-paa-store-XXXXXX";
+    const char * dir   = mkdtemp(dirTemplate);
+    NL_TEST_ASSERT(inSuite, dir != nullptr);
+    if (dir == nullptr)
+    {
+        return;
+    }
+
+    const uint8_t notACert[] = { 0x30, 0x03, 0x02, 0x01, 0x00 };
+    const std::string paths[] = {
+        std::string(dir) + "/paa-fff1.der",
+        std::string(dir) + "/paa-novid.der",
+        std::string(dir) + "/not-a-cert.der",
+        std::string(dir) + "/paa-fff1-copy.pem",
+    };
+    NL_TEST_ASSERT(inSuite, WriteFile(paths[0], TestCerts::sTestCert_PAA_FFF1_Cert));
+    NL_TEST_ASSERT(inSuite, WriteFile(paths[1], TestCerts::sTestCert_PAA_NoVID_Cert));
+    NL_TEST_ASSERT(inSuite, WriteFile(paths[2], ByteSpan(notACert)));
+    NL_TEST_ASSERT(inSuite, WriteFile(paths[3], TestCerts::sTestCert_PAA_FFF1_Cert));
+
+    FileAttestationTrustStore trustStore;
+    NL_TEST_ASSERT(inSuite, trustStore.LoadPaaCerts(dir) == CHIP_NO_ERROR);
+
+    // Only the DER files holding certificates are loaded.
+    NL_TEST_ASSERT(inSuite, trustStore.GetPaaCertCount() == 2);
+    CheckPaaCert(inSuite, trustStore, TestCerts::sTestCert_PAA_FFF1_SKID, TestCerts::sTestCert_PAA_FFF1_Cert);
+    CheckPaaCert(inSuite, trustStore, TestCerts::sTestCert_PAA_NoVID_SKID, TestCerts::sTestCert_PAA_NoVID_Cert);
+
+    for (const std::string & path : paths)
+    {
+        unlink(path.c_str());
+    }
+    rmdir(dir);
+
+    NL_TEST_ASSERT(inSuite, trustStore.LoadPaaCerts(dir) == CHIP_ERROR_OPEN_FAILED);
+}
+
+/**
+ *  Set up the test suite.
+ */
+int TestFileAttestationTrustStore_Setup(void * inContext)
+{
+    CHIP_ERROR error = chip::Platform::MemoryInit();
+
+    if (error != CHIP_NO_ERROR)
+    {
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+int TestFileAttestationTrustStore_Teardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+// clang-format off
+static const nlTest sTests[] = {
+    NL_TEST_DEF("Test adding PAA certificates to the file trust store", TestFileAttestationTrustStore_AddPaaCert),
+    NL_TEST_DEF("Test loading PAA certificates from a directory", TestFileAttestationTrustStore_LoadPaaCerts),
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestFileAttestationTrustStore()
+{
+    // clang-format off
+    nlTestSuite theSuite =
+    {
+        "File Attestation Trust Store",
+        &sTests[0],
+        TestFileAttestationTrustStore_Setup,
+        TestFileAttestationTrustStore_Teardown
+    };
+    // clang-format on
+    nlTestRunner(&theSuite, nullptr);
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestFileAttestationTrustStore);
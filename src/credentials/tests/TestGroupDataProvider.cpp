@@ -17,6 +17,7 @@
  */
 
 #include <credentials/GroupDataProviderImpl.h>
+#include <crypto/CHIPCryptoPAL.h>
 #include <lib/core/CHIPTLV.h>
 #include <lib/support/CHIPMem.h>
 #include <lib/support/TestPersistentStorageDelegate.h>
@@ -34,6 +35,7 @@ using GroupKey      = GroupDataProvider::GroupKey;
 using GroupEndpoint = GroupDataProvider::GroupEndpoint;
 using EpochKey      = GroupDataProvider::EpochKey;
 using KeySet        = GroupDataProvider::KeySet;
+using GroupSession  = GroupDataProvider::GroupSession;
 
 namespace chip {
 namespace app {
@@ -48,6 +50,11 @@ static const size_t kSize2  = strlen(kValue2) + 1;
 constexpr chip::FabricIndex kFabric1 = 1;
 constexpr chip::FabricIndex kFabric2 = 7;
 
+static const uint8_t kCompressedFabricIdBuffer1[] = { 0x87, 0xe1, 0xb0, 0x04, 0xe2, 0x35, 0xa1, 0x30 };
+static const uint8_t kCompressedFabricIdBuffer2[] = { 0x29, 0x06, 0xc9, 0x08, 0xd1, 0x15, 0xd3, 0x62 };
+static const chip::ByteSpan kCompressedFabricId1(kCompressedFabricIdBuffer1);
+static const chip::ByteSpan kCompressedFabricId2(kCompressedFabricIdBuffer2);
+
 constexpr uint16_t kMaxGroupsPerFabric    = 5;
 constexpr uint16_t kMaxGroupKeysPerFabric = 8;
 
@@ -693,14 +700,14 @@ void TestKeySets(nlTestSuite * apSuite, void * apContext)
 
     // Add KeySets
 
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kKeySet1));
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kKeySet0));
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kKeySet2));
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kKeySet3));
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kKeySet3));
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kKeySet0));
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kKeySet2));
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kKeySet1));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet1));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet0));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet2));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet3));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet3));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet0));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet2));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet1));
 
     // Get KeySets
 
@@ -777,13 +784,13 @@ void TestKeySetIterator(nlTestSuite * apSuite, void * apContext)
 
     // Add data to iterate
 
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kKeySet1));
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kKeySet0));
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kKeySet2));
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kKeySet3));
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kKeySet3));
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kKeySet2));
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kKeySet1));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet1));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet0));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet2));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet3));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet3));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet2));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet1));
 
     // Iterate Fabric 1
 
@@ -894,12 +901,12 @@ void TestPerFabricData(nlTestSuite * apSuite, void * apContext)
 
     KeySet keys;
 
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kKeySet0));
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kKeySet2));
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kKeySet1));
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kKeySet1));
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kKeySet2));
-    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kKeySet0));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet0));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet2));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet1));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet1));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet2));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet0));
 
     NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->GetKeySet(kFabric2, kKeysetId0, keys));
     NL_TEST_ASSERT(apSuite, kKeySet0.policy == keys.policy);
@@ -991,6 +998,181 @@ void TestPerFabricData(nlTestSuite * apSuite, void * apContext)
     NL_TEST_ASSERT(apSuite, CHIP_ERROR_NOT_FOUND == provider->GetKeySet(kFabric1, 606, keys));
 }
 
+void TestGroupSessions(nlTestSuite * apSuite, void * apContext)
+{
+    GroupDataProvider * provider = GetGroupDataProvider();
+    NL_TEST_ASSERT(apSuite, provider);
+
+    // Reset test
+    provider->RemoveFabric(kFabric1);
+    provider->RemoveFabric(kFabric2);
+
+    GroupSession session;
+
+    // Invalid compressed fabric id
+    NL_TEST_ASSERT(apSuite,
+                   CHIP_ERROR_INVALID_ARGUMENT == provider->SetKeySet(kFabric1, kCompressedFabricId1.SubSpan(0, 4), kKeySet1));
+
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet1));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric1, kCompressedFabricId1, kKeySet2));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetKeySet(kFabric2, kCompressedFabricId2, kKeySet1));
+
+    // No group is mapped to a keyset yet
+    NL_TEST_ASSERT(apSuite, CHIP_ERROR_NOT_FOUND == provider->GetGroupSession(kFabric1, kGroup1, session));
+
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric1, 0, kGroup1Keyset1));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric1, 1, kGroup2Keyset2));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->SetGroupKeyAt(kFabric2, 0, kGroup1Keyset1));
+
+    // Expected operational keys and session ids
+    uint8_t key_buffer[EpochKey::kLengthBytes];
+    MutableByteSpan key(key_buffer);
+    uint16_t session_id = 0;
+
+    NL_TEST_ASSERT(apSuite,
+                   CHIP_NO_ERROR ==
+                       Crypto::DeriveGroupOperationalKey(ByteSpan(kKeySet1.epoch_keys[0].key), kCompressedFabricId1, key));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == Crypto::DeriveGroupSessionId(key, session_id));
+
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->GetGroupSession(kFabric1, kGroup1, session));
+    NL_TEST_ASSERT(apSuite, session.fabric_index == kFabric1);
+    NL_TEST_ASSERT(apSuite, session.group_id == kGroup1);
+    NL_TEST_ASSERT(apSuite, session.security_policy == kKeySet1.policy);
+    NL_TEST_ASSERT(apSuite, session.session_id == session_id);
+    NL_TEST_ASSERT(apSuite, 0 == memcmp(session.key, key_buffer, sizeof(key_buffer)));
+
+    // The same epoch key yields a different operational key on another fabric
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->GetGroupSession(kFabric2, kGroup1, session));
+    NL_TEST_ASSERT(apSuite, session.fabric_index == kFabric2);
+    NL_TEST_ASSERT(apSuite, 0 != memcmp(session.key, key_buffer, sizeof(key_buffer)));
+
+    // Received messages are matched by session id
+    auto * it = provider->IterateGroupSessions(session_id);
+    NL_TEST_ASSERT(apSuite, it);
+    if (it)
+    {
+        bool found = false;
+        NL_TEST_ASSERT(apSuite, it->Count() >= 1);
+        while (it->Next(session))
+        {
+            NL_TEST_ASSERT(apSuite, session.session_id == session_id);
+            found = found || (session.fabric_index == kFabric1 && session.group_id == kGroup1);
+        }
+        NL_TEST_ASSERT(apSuite, found);
+        it->Release();
+    }
+
+    // The epoch key with the latest start time is used to send
+    key = MutableByteSpan(key_buffer);
+    NL_TEST_ASSERT(apSuite,
+                   CHIP_NO_ERROR ==
+                       Crypto::DeriveGroupOperationalKey(ByteSpan(kKeySet2.epoch_keys[1].key), kCompressedFabricId1, key));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->GetGroupSession(kFabric1, kGroup2, session));
+    NL_TEST_ASSERT(apSuite, 0 == memcmp(session.key, key_buffer, sizeof(key_buffer)));
+
+    // Changes to the group-key map are reflected
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->RemoveGroupKeyAt(kFabric1, 0));
+    NL_TEST_ASSERT(apSuite, CHIP_ERROR_NOT_FOUND == provider->GetGroupSession(kFabric1, kGroup1, session));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->GetGroupSession(kFabric1, kGroup2, session));
+
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->RemoveFabric(kFabric1));
+    NL_TEST_ASSERT(apSuite, CHIP_ERROR_NOT_FOUND == provider->GetGroupSession(kFabric1, kGroup2, session));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider->GetGroupSession(kFabric2, kGroup1, session));
+}
+
+class CountingStorageDelegate : public TestPersistentStorageDelegate
+{
+public:
+    CHIP_ERROR SyncGetKeyValue(const char * key, void * buffer, uint16_t & size) override
+    {
+        reads++;
+        return TestPersistentStorageDelegate::SyncGetKeyValue(key, buffer, size);
+    }
+    CHIP_ERROR SyncSetKeyValue(const char * key, const void * value, uint16_t size) override
+    {
+        writes++;
+        return TestPersistentStorageDelegate::SyncSetKeyValue(key, value, size);
+    }
+    size_t reads  = 0;
+    size_t writes = 0;
+};
+
+void TestStorageCache(nlTestSuite * apSuite, void * apContext)
+{
+    CountingStorageDelegate storage;
+    GroupDataProviderImpl provider(storage, kMaxGroupsPerFabric, kMaxGroupKeysPerFabric);
+    GroupInfo group;
+
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider.Init());
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider.SetGroupInfo(kFabric1, kGroupInfo1_1));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider.SetGroupInfo(kFabric1, kGroupInfo1_2));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider.AddEndpoint(kFabric1, kGroup1, kEndpointId0));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider.AddEndpoint(kFabric1, kGroup2, kEndpointId1));
+
+    // Records read or written once are served from memory
+    NL_TEST_ASSERT(apSuite, provider.HasEndpoint(kFabric1, kGroup2, kEndpointId1));
+    NL_TEST_ASSERT(apSuite, !provider.HasEndpoint(kFabric1, kGroup2, kEndpointId2));
+    size_t reads = storage.reads;
+    NL_TEST_ASSERT(apSuite, provider.HasEndpoint(kFabric1, kGroup1, kEndpointId0));
+    NL_TEST_ASSERT(apSuite, provider.HasEndpoint(kFabric1, kGroup2, kEndpointId1));
+    NL_TEST_ASSERT(apSuite, !provider.HasEndpoint(kFabric1, kGroup2, kEndpointId2));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider.GetGroupInfo(kFabric1, kGroup2, group));
+    NL_TEST_ASSERT(apSuite, group == kGroupInfo1_2);
+    NL_TEST_ASSERT(apSuite, reads == storage.reads);
+
+    // Iterators are served from the group and endpoint indexes
+    auto * groups = provider.IterateGroupInfo(kFabric1);
+    NL_TEST_ASSERT(apSuite, groups != nullptr && groups->Count() == 2);
+    NL_TEST_ASSERT(apSuite, groups != nullptr && groups->Next(group) && group == kGroupInfo1_1);
+    NL_TEST_ASSERT(apSuite, groups != nullptr && groups->Next(group) && group == kGroupInfo1_2);
+    NL_TEST_ASSERT(apSuite, groups != nullptr && !groups->Next(group));
+    if (groups != nullptr)
+    {
+        groups->Release();
+    }
+    GroupDataProvider::GroupEndpoint mapping;
+    auto * endpoints = provider.IterateEndpoints(kFabric1);
+    NL_TEST_ASSERT(apSuite, endpoints != nullptr && endpoints->Count() == 2);
+    NL_TEST_ASSERT(apSuite, endpoints != nullptr && endpoints->Next(mapping));
+    NL_TEST_ASSERT(apSuite, mapping.group_id == kGroup1 && mapping.endpoint_id == kEndpointId0);
+    NL_TEST_ASSERT(apSuite, endpoints != nullptr && endpoints->Next(mapping));
+    NL_TEST_ASSERT(apSuite, mapping.group_id == kGroup2 && mapping.endpoint_id == kEndpointId1);
+    NL_TEST_ASSERT(apSuite, endpoints != nullptr && !endpoints->Next(mapping));
+    if (endpoints != nullptr)
+    {
+        endpoints->Release();
+    }
+    NL_TEST_ASSERT(apSuite, reads == storage.reads);
+
+    // Keysets hold epoch keys and are always read from storage
+    KeySet keyset;
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider.SetKeySet(kFabric1, kCompressedFabricId1, kKeySet1));
+    reads = storage.reads;
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider.GetKeySet(kFabric1, kKeysetId1, keyset));
+    NL_TEST_ASSERT(apSuite, reads < storage.reads);
+    reads = storage.reads;
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider.GetKeySet(kFabric1, kKeysetId1, keyset));
+    NL_TEST_ASSERT(apSuite, reads < storage.reads);
+
+    // Unchanged records are not rewritten
+    size_t writes = storage.writes;
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider.SetGroupInfo(kFabric1, kGroupInfo1_2));
+    NL_TEST_ASSERT(apSuite, writes == storage.writes);
+
+    // Changes are written through to storage
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider.SetGroupInfo(kFabric1, kGroupInfo2_2));
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == provider.RemoveEndpoint(kFabric1, kGroup1, kEndpointId0));
+    provider.Finish();
+
+    GroupDataProviderImpl reloaded(storage, kMaxGroupsPerFabric, kMaxGroupKeysPerFabric);
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == reloaded.Init());
+    NL_TEST_ASSERT(apSuite, CHIP_NO_ERROR == reloaded.GetGroupInfo(kFabric1, kGroup2, group));
+    NL_TEST_ASSERT(apSuite, group == kGroupInfo2_2);
+    NL_TEST_ASSERT(apSuite, !reloaded.HasEndpoint(kFabric1, kGroup1, kEndpointId0));
+    NL_TEST_ASSERT(apSuite, reloaded.HasEndpoint(kFabric1, kGroup2, kEndpointId1));
+    reloaded.Finish();
+}
+
 } // namespace TestGroups
 } // namespace app
 } // namespace chip
@@ -1041,12 +1223,12 @@ int Test_Setup(void * inContext)
  */
 int Test_Teardown(void * inContext)
 {
-    chip::Platform::MemoryShutdown();
     GroupDataProvider * provider = GetGroupDataProvider();
     if (nullptr != provider)
     {
         provider->Finish();
     }
+    chip::Platform::MemoryShutdown();
     return SUCCESS;
 }
 
@@ -1060,6 +1242,8 @@ const nlTest sTests[] = { NL_TEST_DEF("TestStorageDelegate", chip::app::TestGrou
                           NL_TEST_DEF("TestKeySets", chip::app::TestGroups::TestKeySets),
                           NL_TEST_DEF("TestKeySetIterator", chip::app::TestGroups::TestKeySetIterator),
                           NL_TEST_DEF("TestPerFabricData", chip::app::TestGroups::TestPerFabricData),
+                          NL_TEST_DEF("TestGroupSessions", chip::app::TestGroups::TestGroupSessions),
+                          NL_TEST_DEF("TestStorageCache", chip::app::TestGroups::TestStorageCache),
                           NL_TEST_SENTINEL() };
 } // namespace
 
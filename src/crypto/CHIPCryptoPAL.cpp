@@ -657,5 +657,49 @@ CHIP_ERROR GenerateCompressedFabricId(const Crypto::P256PublicKey & root_public_
     return status;
 }
 
+CHIP_ERROR DeriveGroupOperationalKey(const ByteSpan & epoch_key, const ByteSpan & compressed_fabric_id, MutableByteSpan & out_key)
+{
+    VerifyOrReturnError(epoch_key.size() == CHIP_CRYPTO_SYMMETRIC_KEY_LENGTH_BYTES, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(compressed_fabric_id.size() == kCompressedFabricIdentifierSize, CHIP_ERROR_INVALID_ARGUMENT);
+    VerifyOrReturnError(out_key.size() >= CHIP_CRYPTO_SYMMETRIC_KEY_LENGTH_BYTES, CHIP_ERROR_BUFFER_TOO_SMALL);
+
+    //   OperationalGroupKey =
+    //     CHIP_Crypto_KDF(
+    //       inputKey := EpochKey,
+    //       salt := CompressedFabricIdentifier,
+    //       info := "GroupKey v1.0",
+    //       len := CRYPTO_SYMMETRIC_KEY_LENGTH_BITS)
+    constexpr uint8_t kGroupKeyInfo[13] = /* "GroupKey v1.0" */
+        { 0x47, 0x72, 0x6f, 0x75, 0x70, 0x4b, 0x65, 0x79, 0x20, 0x76, 0x31, 0x2e, 0x30 };
+    HKDF_sha hkdf;
+
+    ReturnErrorOnFailure(hkdf.HKDF_SHA256(epoch_key.data(), epoch_key.size(), compressed_fabric_id.data(),
+                                          compressed_fabric_id.size(), kGroupKeyInfo, sizeof(kGroupKeyInfo), out_key.data(),
+                                          CHIP_CRYPTO_SYMMETRIC_KEY_LENGTH_BYTES));
+    out_key = out_key.SubSpan(0, CHIP_CRYPTO_SYMMETRIC_KEY_LENGTH_BYTES);
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR DeriveGroupSessionId(const ByteSpan & operational_key, uint16_t & session_id)
+{
+    VerifyOrReturnError(operational_key.size() == CHIP_CRYPTO_SYMMETRIC_KEY_LENGTH_BYTES, CHIP_ERROR_INVALID_ARGUMENT);
+
+    //   GroupSessionId =
+    //     CHIP_Crypto_KDF(
+    //       inputKey := OperationalGroupKey,
+    //       salt := [],
+    //       info := "GroupKeyHash",
+    //       len := 16)
+    constexpr uint8_t kGroupKeyHashInfo[12] = /* "GroupKeyHash" */
+        { 0x47, 0x72, 0x6f, 0x75, 0x70, 0x4b, 0x65, 0x79, 0x48, 0x61, 0x73, 0x68 };
+    HKDF_sha hkdf;
+    uint8_t out_key[sizeof(uint16_t)];
+
+    ReturnErrorOnFailure(hkdf.HKDF_SHA256(operational_key.data(), operational_key.size(), nullptr, 0, kGroupKeyHashInfo,
+                                          sizeof(kGroupKeyHashInfo), out_key, sizeof(out_key)));
+    session_id = chip::Encoding::BigEndian::Get16(out_key);
+    return CHIP_NO_ERROR;
+}
+
 } // namespace Crypto
 } // namespace chip
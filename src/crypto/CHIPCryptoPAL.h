@@ -1200,6 +1200,33 @@ private:
 CHIP_ERROR GenerateCompressedFabricId(const Crypto::P256PublicKey & root_public_key, uint64_t fabric_id,
                                       MutableByteSpan & out_compressed_fabric_id);
 
+/**
+ * @brief Derive an operational group key from an epoch key and the compressed fabric identifier
+ *        of the fabric the group belongs to. On success, out_key will have a size of exactly
+ *        CHIP_CRYPTO_SYMMETRIC_KEY_LENGTH_BYTES.
+ *
+ * Errors are:
+ *   - CHIP_ERROR_INVALID_ARGUMENT if epoch_key or compressed_fabric_id have the wrong size
+ *   - CHIP_ERROR_BUFFER_TOO_SMALL if out_key is too small
+ *   - CHIP_ERROR_INTERNAL on any unexpected crypto error.
+ *
+ * @param[in] epoch_key The epoch key, CHIP_CRYPTO_SYMMETRIC_KEY_LENGTH_BYTES long
+ * @param[in] compressed_fabric_id The compressed fabric identifier, kCompressedFabricIdentifierSize long
+ * @param[out] out_key Span where the operational group key will be written.
+ * @returns a CHIP_ERROR (see above) on failure or CHIP_NO_ERROR otherwise.
+ */
+CHIP_ERROR DeriveGroupOperationalKey(const ByteSpan & epoch_key, const ByteSpan & compressed_fabric_id, MutableByteSpan & out_key);
+
+/**
+ * @brief Derive the group session identifier (key hash) carried in the header of group messages
+ *        encrypted with the given operational group key.
+ *
+ * @param[in] operational_key The operational group key, CHIP_CRYPTO_SYMMETRIC_KEY_LENGTH_BYTES long
+ * @param[out] session_id The group session identifier
+ * @returns CHIP_ERROR_INVALID_ARGUMENT if operational_key has the wrong size, CHIP_NO_ERROR on success.
+ */
+CHIP_ERROR DeriveGroupSessionId(const ByteSpan & operational_key, uint16_t & session_id);
+
 typedef CapacityBoundBuffer<kMax_x509_Certificate_Length> X509DerCertificate;
 
 CHIP_ERROR LoadCertsFromPKCS7(const char * pkcs7, X509DerCertificate * x509list, uint32_t * max_certs);
@@ -1232,6 +1259,16 @@ CHIP_ERROR ValidateCertificateChain(const uint8_t * rootCertificate, size_t root
                                     size_t caCertificateLen, const uint8_t * leafCertificate, size_t leafCertificateLen,
                                     CertificateChainValidationResult & result);
 
+/**
+ * @brief Validate a leaf certificate against a CA certificate that is already trusted, without validating the CA
+ *        certificate against its root.
+ *
+ * This lets a CA certificate that was validated once, such as a PAI shared by many DACs, be reused for every
+ * leaf certificate it issued.
+ **/
+CHIP_ERROR ValidateCertificateAgainstTrustedCA(const ByteSpan & caCertificate, const ByteSpan & leafCertificate,
+                                               CertificateChainValidationResult & result);
+
 /**
  * @brief Validate timestamp of a certificate (toBeEvaluatedCertificate) in comparison with other certificate's
  *        (referenceCertificate) issuing timestamp.
@@ -1713,6 +1713,64 @@ exit:
     return err;
 }
 
+CHIP_ERROR ValidateCertificateAgainstTrustedCA(const ByteSpan & caCertificate, const ByteSpan & leafCertificate,
+                                               CertificateChainValidationResult & result)
+{
+    CHIP_ERROR err                  = CHIP_NO_ERROR;
+    int status                      = 0;
+    X509_STORE_CTX * verifyCtx      = nullptr;
+    X509_STORE * store              = nullptr;
+    X509 * x509CACertificate        = nullptr;
+    X509 * x509LeafCertificate      = nullptr;
+    const unsigned char * pCACert   = caCertificate.data();
+    const unsigned char * pLeafCert = leafCertificate.data();
+
+    result = CertificateChainValidationResult::kInternalFrameworkError;
+
+    VerifyOrReturnError(!caCertificate.empty() && caCertificate.data() != nullptr,
+                        (result = CertificateChainValidationResult::kICAArgumentInvalid, CHIP_ERROR_INVALID_ARGUMENT));
+    VerifyOrReturnError(!leafCertificate.empty() && leafCertificate.data() != nullptr,
+                        (result = CertificateChainValidationResult::kLeafArgumentInvalid, CHIP_ERROR_INVALID_ARGUMENT));
+
+    store = X509_STORE_new();
+    VerifyOrExit(store != nullptr, (result = CertificateChainValidationResult::kNoMemory, err = CHIP_ERROR_NO_MEMORY));
+
+    // The CA certificate is the trust anchor, even though it isn't self-signed.
+    status = X509_STORE_set_flags(store, X509_V_FLAG_PARTIAL_CHAIN);
+    VerifyOrExit(status == 1, (result = CertificateChainValidationResult::kInternalFrameworkError, err = CHIP_ERROR_INTERNAL));
+
+    verifyCtx = X509_STORE_CTX_new();
+    VerifyOrExit(verifyCtx != nullptr, (result = CertificateChainValidationResult::kNoMemory, err = CHIP_ERROR_NO_MEMORY));
+
+    x509CACertificate = d2i_X509(NULL, &pCACert, static_cast<long>(caCertificate.size()));
+    VerifyOrExit(x509CACertificate != nullptr,
+                 (result = CertificateChainValidationResult::kICAFormatInvalid, err = CHIP_ERROR_INTERNAL));
+
+    status = X509_STORE_add_cert(store, x509CACertificate);
+    VerifyOrExit(status == 1, (result = CertificateChainValidationResult::kInternalFrameworkError, err = CHIP_ERROR_INTERNAL));
+
+    x509LeafCertificate = d2i_X509(NULL, &pLeafCert, static_cast<long>(leafCertificate.size()));
+    VerifyOrExit(x509LeafCertificate != nullptr,
+                 (result = CertificateChainValidationResult::kLeafFormatInvalid, err = CHIP_ERROR_INTERNAL));
+
+    status = X509_STORE_CTX_init(verifyCtx, store, x509LeafCertificate, NULL);
+    VerifyOrExit(status == 1, (result = CertificateChainValidationResult::kInternalFrameworkError, err = CHIP_ERROR_INTERNAL));
+
+    status = X509_verify_cert(verifyCtx);
+    VerifyOrExit(status == 1, (result = CertificateChainValidationResult::kChainInvalid, err = CHIP_ERROR_CERT_NOT_TRUSTED));
+
+    err    = CHIP_NO_ERROR;
+    result = CertificateChainValidationResult::kSuccess;
+
+exit:
+    X509_free(x509LeafCertificate);
+    X509_free(x509CACertificate);
+    X509_STORE_CTX_free(verifyCtx);
+    X509_STORE_free(store);
+
+    return err;
+}
+
 CHIP_ERROR IsCertificateValidAtIssuance(const ByteSpan & referenceCertificate, const ByteSpan & toBeEvaluatedCertificate)
 {
     CHIP_ERROR error                                = CHIP_NO_ERROR;
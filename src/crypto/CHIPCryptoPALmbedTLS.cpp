@@ -1291,6 +1291,64 @@ exit:
     return error;
 }
 
+CHIP_ERROR ValidateCertificateAgainstTrustedCA(const ByteSpan & caCertificate, const ByteSpan & leafCertificate,
+                                               CertificateChainValidationResult & result)
+{
+#if defined(MBEDTLS_X509_CRT_PARSE_C)
+    CHIP_ERROR error = CHIP_NO_ERROR;
+    mbedtls_x509_crt leafCert;
+    mbedtls_x509_crt caCert;
+    int mbedResult;
+    uint32_t flags;
+
+    result = CertificateChainValidationResult::kInternalFrameworkError;
+
+    VerifyOrReturnError(!caCertificate.empty() && caCertificate.data() != nullptr,
+                        (result = CertificateChainValidationResult::kICAArgumentInvalid, CHIP_ERROR_INVALID_ARGUMENT));
+    VerifyOrReturnError(!leafCertificate.empty() && leafCertificate.data() != nullptr,
+                        (result = CertificateChainValidationResult::kLeafArgumentInvalid, CHIP_ERROR_INVALID_ARGUMENT));
+
+    mbedtls_x509_crt_init(&leafCert);
+    mbedtls_x509_crt_init(&caCert);
+
+    mbedResult = mbedtls_x509_crt_parse(&leafCert, Uint8::to_const_uchar(leafCertificate.data()), leafCertificate.size());
+    VerifyOrExit(mbedResult == 0, (result = CertificateChainValidationResult::kLeafFormatInvalid, error = CHIP_ERROR_INTERNAL));
+
+    mbedResult = mbedtls_x509_crt_parse(&caCert, Uint8::to_const_uchar(caCertificate.data()), caCertificate.size());
+    VerifyOrExit(mbedResult == 0, (result = CertificateChainValidationResult::kICAFormatInvalid, error = CHIP_ERROR_INTERNAL));
+
+    /* Trusted CA certificates end the chain, whether or not they are self-signed */
+    mbedResult = mbedtls_x509_crt_verify(&leafCert, &caCert, NULL, NULL, &flags, NULL, NULL);
+
+    switch (mbedResult)
+    {
+    case 0:
+        VerifyOrExit(flags == 0, (result = CertificateChainValidationResult::kInternalFrameworkError, error = CHIP_ERROR_INTERNAL));
+        result = CertificateChainValidationResult::kSuccess;
+        break;
+    case MBEDTLS_ERR_X509_CERT_VERIFY_FAILED:
+        result = CertificateChainValidationResult::kChainInvalid;
+        error  = CHIP_ERROR_CERT_NOT_TRUSTED;
+        break;
+    default:
+        SuccessOrExit((result = CertificateChainValidationResult::kInternalFrameworkError, error = CHIP_ERROR_INTERNAL));
+    }
+
+exit:
+    _log_mbedTLS_error(mbedResult);
+    mbedtls_x509_crt_free(&leafCert);
+    mbedtls_x509_crt_free(&caCert);
+
+#else
+    (void) caCertificate;
+    (void) leafCertificate;
+    (void) result;
+    CHIP_ERROR error = CHIP_ERROR_NOT_IMPLEMENTED;
+#endif // defined(MBEDTLS_X509_CRT_PARSE_C)
+
+    return error;
+}
+
 inline bool IsTimeGreaterThanEqual(const mbedtls_x509_time * const timeA, const mbedtls_x509_time * const timeB)
 {
     return timeA->year > timeB->year || (timeA->year == timeB->year && timeA->mon > timeB->mon) ||
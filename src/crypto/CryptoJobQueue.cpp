@@ -0,0 +1,41 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include "CryptoJobQueue.h"
+
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+namespace Crypto {
+
+namespace {
+CryptoJobQueue * sCryptoJobQueue = nullptr;
+} // namespace
+
+void SetCryptoJobQueue(CryptoJobQueue * queue)
+{
+    sCryptoJobQueue = queue;
+}
+
+CHIP_ERROR PostCryptoJob(CryptoJob & job)
+{
+    VerifyOrReturnError(sCryptoJobQueue != nullptr, CHIP_ERROR_INCORRECT_STATE);
+    return sCryptoJobQueue->Post(job);
+}
+
+} // namespace Crypto
+} // namespace chip
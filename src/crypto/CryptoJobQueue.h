@@ -0,0 +1,104 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the interface used to run expensive cryptographic
+ *      operations, such as the asymmetric operations of session establishment,
+ *      away from the CHIP thread.
+ *
+ */
+
+#pragma once
+
+#include <lib/core/CHIPError.h>
+
+namespace chip {
+namespace Crypto {
+
+/**
+ * A unit of cryptographic work.
+ *
+ * Run() only works on the state owned by the job, and may be called from any thread. OnComplete() is then
+ * called on the CHIP thread, where the results can be handed back to the stack.
+ */
+class CryptoJob
+{
+public:
+    virtual ~CryptoJob() = default;
+
+    /**
+     * Run the expensive part of the job. Must not touch the stack state.
+     */
+    virtual void Run() = 0;
+
+    /**
+     * Called on the CHIP thread once Run() has returned. The job may delete itself.
+     */
+    virtual void OnComplete() = 0;
+
+    /**
+     * Called instead of OnComplete() when the queue could not get back to the CHIP thread once Run() returned, with
+     * the stack locked or the event loop stopped. The job should fail the operation it belongs to with @a error, and
+     * may delete itself. By default the job completes as usual.
+     */
+    virtual void OnCompletionError(CHIP_ERROR error) { OnComplete(); }
+
+private:
+    friend class CryptoJobQueue;
+
+    // Link used by queues to hold pending jobs without allocating.
+    CryptoJob * mNextJob = nullptr;
+};
+
+/**
+ * Runs crypto jobs, typically on worker threads.
+ *
+ * The cryptographic backend must be thread-safe when jobs are run concurrently.
+ */
+class CryptoJobQueue
+{
+public:
+    virtual ~CryptoJobQueue() = default;
+
+    /**
+     * Queue @a job. Once Run() has returned, OnComplete() must be called on the CHIP thread.
+     *
+     * @retval CHIP_ERROR_INCORRECT_STATE if the queue is not running, in which case the caller keeps the job.
+     */
+    virtual CHIP_ERROR Post(CryptoJob & job) = 0;
+
+protected:
+    static CryptoJob *& NextJob(CryptoJob & job) { return job.mNextJob; }
+};
+
+/**
+ * Install the queue that crypto jobs are posted to. Without a queue, which is the default, jobs are run
+ * inline on the CHIP thread.
+ */
+void SetCryptoJobQueue(CryptoJobQueue * queue);
+
+/**
+ * Post @a job to the installed queue.
+ *
+ * @retval CHIP_ERROR_INCORRECT_STATE if no queue is installed or running, in which case the caller should run
+ *                                    the job inline.
+ */
+CHIP_ERROR PostCryptoJob(CryptoJob & job);
+
+} // namespace Crypto
+} // namespace chip
@@ -1887,6 +1887,46 @@ static void TestX509_CertChainValidation(nlTestSuite * inSuite, void * inContext
     NL_TEST_ASSERT(inSuite, chainValidationResult == CertificateChainValidationResult::kChainInvalid);
 }
 
+static void TestX509_TrustedCAValidation(nlTestSuite * inSuite, void * inContext)
+{
+    using namespace TestCerts;
+
+    HeapChecker heapChecker(inSuite);
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    ByteSpan ica_cert;
+    err = GetTestCert(TestCert::kICA01, TestCertLoadFlags::kDERForm, ica_cert);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    ByteSpan leaf_cert;
+    err = GetTestCert(TestCert::kNode01_01, TestCertLoadFlags::kDERForm, leaf_cert);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    // The ICA certificate is trusted without its root.
+    CertificateChainValidationResult chainValidationResult;
+    err = ValidateCertificateAgainstTrustedCA(ica_cert, leaf_cert, chainValidationResult);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, chainValidationResult == CertificateChainValidationResult::kSuccess);
+
+    // Now test for invalid arguments.
+    err = ValidateCertificateAgainstTrustedCA(ByteSpan(), leaf_cert, chainValidationResult);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, chainValidationResult == CertificateChainValidationResult::kICAArgumentInvalid);
+
+    err = ValidateCertificateAgainstTrustedCA(ica_cert, ByteSpan(), chainValidationResult);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_INVALID_ARGUMENT);
+    NL_TEST_ASSERT(inSuite, chainValidationResult == CertificateChainValidationResult::kLeafArgumentInvalid);
+
+    // Now test with an ICA certificate that did not issue the leaf certificate
+    ByteSpan wrong_ica_cert;
+    err = GetTestCert(TestCert::kICA02, TestCertLoadFlags::kDERForm, wrong_ica_cert);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    err = ValidateCertificateAgainstTrustedCA(wrong_ica_cert, leaf_cert, chainValidationResult);
+    NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_CERT_NOT_TRUSTED);
+    NL_TEST_ASSERT(inSuite, chainValidationResult == CertificateChainValidationResult::kChainInvalid);
+}
+
 static void TestX509_IssuingTimestampValidation(nlTestSuite * inSuite, void * inContext)
 {
     using namespace TestCerts;
@@ -2177,6 +2217,7 @@ static const nlTest sTests[] = {
     NL_TEST_DEF("Test x509 Certificate Extraction from PKCS7", TestX509_PKCS7Extraction),
 #endif // CHIP_CRYPTO_OPENSSL
     NL_TEST_DEF("Test x509 Certificate Chain Validation", TestX509_CertChainValidation),
+    NL_TEST_DEF("Test x509 Certificate Validation Against a Trusted CA", TestX509_TrustedCAValidation),
     NL_TEST_DEF("Test x509 Certificate Timestamp Validation", TestX509_IssuingTimestampValidation),
     NL_TEST_DEF("Test Subject Key Id Extraction from x509 Certificate", TestSKID_x509Extraction),
     NL_TEST_DEF("Test Authority Key Id Extraction from x509 Certificate", TestAKID_x509Extraction),
@@ -82,6 +82,18 @@
 #define CHIP_DEVICE_CONFIG_CHIP_TASK_PRIORITY 1
 #endif
 
+/**
+ * CHIP_DEVICE_CONFIG_CRYPTO_OFFLOAD_THREADS
+ *
+ * The number of worker threads running the asymmetric crypto operations of session establishment
+ * off the chip task, on platforms that support it. 0 runs them on the chip task.
+ *
+ * The crypto backend must be thread-safe for this to be enabled.
+ */
+#ifndef CHIP_DEVICE_CONFIG_CRYPTO_OFFLOAD_THREADS
+#define CHIP_DEVICE_CONFIG_CRYPTO_OFFLOAD_THREADS 0
+#endif
+
 /**
  * CHIP_DEVICE_CONFIG_MAX_EVENT_QUEUE_SIZE
  *
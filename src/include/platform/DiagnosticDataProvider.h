@@ -96,6 +96,13 @@ public:
      *   Called when a software fault that has taken place on the Node.
      */
     virtual void OnSoftwareFaultDetected(chip::app::Clusters::SoftwareDiagnostics::Structs::SoftwareFault::Type & softwareFault) {}
+
+    /**
+     * @brief
+     *   Called when the platform detects that the value of an attribute of the cluster has changed, so that it can be
+     *   reported without being polled.
+     */
+    virtual void OnAttributeChanged(AttributeId attributeId) {}
 };
 
 /**
@@ -123,6 +130,29 @@ public:
      *   Called when the Node’s connection status to a Wi-Fi network has changed.
      */
     virtual void OnConnectionStatusChanged(uint8_t connectionStatus) {}
+
+    /**
+     * @brief
+     *   Called when the platform detects that the value of an attribute of the cluster has changed, so that it can be
+     *   reported without being polled.
+     */
+    virtual void OnAttributeChanged(AttributeId attributeId) {}
+};
+
+/**
+ * Defines the Ethernet Diagnostics Delegate class to notify Ethernet network events.
+ */
+class EthernetDiagnosticsDelegate
+{
+public:
+    virtual ~EthernetDiagnosticsDelegate() {}
+
+    /**
+     * @brief
+     *   Called when the platform detects that the value of an attribute of the cluster has changed, so that it can be
+     *   reported without being polled.
+     */
+    virtual void OnAttributeChanged(AttributeId attributeId) {}
 };
 
 /**
@@ -151,6 +181,9 @@ public:
     void SetWiFiDiagnosticsDelegate(WiFiDiagnosticsDelegate * delegate) { mWiFiDiagnosticsDelegate = delegate; }
     WiFiDiagnosticsDelegate * GetWiFiDiagnosticsDelegate() const { return mWiFiDiagnosticsDelegate; }
 
+    void SetEthernetDiagnosticsDelegate(EthernetDiagnosticsDelegate * delegate) { mEthernetDiagnosticsDelegate = delegate; }
+    EthernetDiagnosticsDelegate * GetEthernetDiagnosticsDelegate() const { return mEthernetDiagnosticsDelegate; }
+
     /**
      * General Diagnostics methods.
      */
@@ -226,6 +259,7 @@ private:
     GeneralDiagnosticsDelegate * mGeneralDiagnosticsDelegate   = nullptr;
     SoftwareDiagnosticsDelegate * mSoftwareDiagnosticsDelegate = nullptr;
     WiFiDiagnosticsDelegate * mWiFiDiagnosticsDelegate         = nullptr;
+    EthernetDiagnosticsDelegate * mEthernetDiagnosticsDelegate = nullptr;
 
     // No copy, move or assignment.
     DiagnosticDataProvider(const DiagnosticDataProvider &)  = delete;
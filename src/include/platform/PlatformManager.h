@@ -47,6 +47,8 @@ class TimeSyncManager;
 
 namespace Internal {
 class BLEManagerImpl;
+class CryptoWorkerPool;
+class DiagnosticDataCache;
 template <class>
 class GenericConfigurationManagerImpl;
 template <class>
@@ -200,6 +202,8 @@ private:
     friend class ThreadStackManagerImpl;
     friend class TimeSyncManager;
     friend class Internal::BLEManagerImpl;
+    friend class Internal::CryptoWorkerPool;
+    friend class Internal::DiagnosticDataCache;
     template <class>
     friend class Internal::GenericPlatformManagerImpl;
     template <class>
@@ -250,4 +250,21 @@
 #ifndef INET_CONFIG_IP_MULTICAST_HOP_LIMIT
 #define INET_CONFIG_IP_MULTICAST_HOP_LIMIT                 (64)
 #endif // INET_CONFIG_IP_MULTICAST_HOP_LIMIT
+
+/**
+ *  @def INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE
+ *
+ *  @brief
+ *    The maximum number of datagrams a sockets-based UDP endpoint
+ *    receives or transmits with a single system call.
+ *
+ *  @details
+ *    Values greater than 1 enable the use of recvmmsg() / sendmmsg()
+ *    on platforms that provide them (see HAVE_RECVMMSG and
+ *    HAVE_SENDMMSG).  Each batch slot preallocates one packet buffer
+ *    on receive, so this should be kept small on constrained systems.
+ */
+#ifndef INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE
+#define INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE              1
+#endif // INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE
 // clang-format on
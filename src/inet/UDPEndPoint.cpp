@@ -121,6 +121,50 @@ CHIP_ERROR UDPEndPoint::SendMsg(const IPPacketInfo * pktInfo, System::PacketBuff
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR UDPEndPoint::SendMsgs(const IPPacketInfo * pktInfos, System::PacketBufferHandle * msgs, size_t count,
+                                 CHIP_ERROR * errors)
+{
+    CHIP_ERROR err = CHIP_NO_ERROR;
+    INET_FAULT_INJECT(FaultInjection::kFault_Send, err = INET_ERROR_UNKNOWN_INTERFACE;);
+    INET_FAULT_INJECT(FaultInjection::kFault_SendNonCritical, err = CHIP_ERROR_NO_MEMORY;);
+    if (err != CHIP_NO_ERROR)
+    {
+        // Every message of the batch fails, and the caller may be looking at the error of any of them.
+        for (size_t i = 0; (errors != nullptr) && (i < count); i++)
+        {
+            errors[i] = err;
+        }
+        return err;
+    }
+
+    ReturnErrorOnFailure(SendMsgsImpl(pktInfos, msgs, count, errors));
+
+    CHIP_SYSTEM_FAULT_INJECT_ASYNC_EVENT();
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR UDPEndPoint::SendMsgsImpl(const IPPacketInfo * pktInfos, System::PacketBufferHandle * msgs, size_t count,
+                                     CHIP_ERROR * errors)
+{
+    CHIP_ERROR firstError = CHIP_NO_ERROR;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        CHIP_ERROR err = SendMsgImpl(&pktInfos[i], std::move(msgs[i]));
+        if (errors != nullptr)
+        {
+            errors[i] = err;
+        }
+        if (firstError == CHIP_NO_ERROR)
+        {
+            firstError = err;
+        }
+    }
+
+    return firstError;
+}
+
 void UDPEndPoint::Close()
 {
     if (mState != State::kClosed)
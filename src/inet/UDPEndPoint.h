@@ -83,6 +83,21 @@ public:
      */
     using OnReceiveErrorFunct = void (*)(UDPEndPoint * endPoint, CHIP_ERROR err, const IPPacketInfo * pktInfo);
 
+    /**
+     * Type of batched message text reception event handling function.
+     *
+     * @param[in]   endPoint    The endpoint associated with the event.
+     * @param[in]   msgs        The messages received, in arrival order.
+     * @param[in]   pktInfos    The IP information of each message in \c msgs.
+     * @param[in]   count       The number of entries in \c msgs and \c pktInfos.
+     *
+     *  Provide a function of this type to \c SetBatchReceiveHandler to process
+     *  all of the datagrams drained by a single readiness event at once. The
+     *  handler may move out of any entry of \c msgs.
+     */
+    using OnMessageBatchReceivedFunct = void (*)(UDPEndPoint * endPoint, chip::System::PacketBufferHandle * msgs,
+                                                 const IPPacketInfo * pktInfos, size_t count);
+
     /**
      * Set whether IP multicast traffic should be looped back.
      */
@@ -225,6 +240,37 @@ public:
      */
     CHIP_ERROR SendMsg(const IPPacketInfo * pktInfo, chip::System::PacketBufferHandle && msg);
 
+    /**
+     * Send several UDP messages, each to its own destination.
+     *
+     *  Sends \c msgs[i] as described by \c pktInfos[i] for every \c i below \c count.
+     *  Implementations that support it hand the whole batch to the system with
+     *  a single call; otherwise the messages are sent one at a time.
+     *
+     * @param[in]   pktInfos    Source and destination information for each message.
+     * @param[in]   msgs        Packet buffers containing the UDP messages.
+     * @param[in]   count       The number of entries in \c pktInfos and \c msgs.
+     * @param[out]  errors      Optional; receives the send status of each message.
+     *
+     * @retval  CHIP_NO_ERROR   Success: every message is queued for transmit.
+     * @retval  other           The first error encountered; see \c SendMsg.
+     */
+    CHIP_ERROR SendMsgs(const IPPacketInfo * pktInfos, chip::System::PacketBufferHandle * msgs, size_t count,
+                        CHIP_ERROR * errors = nullptr);
+
+    /**
+     * Deliver received datagrams in batches.
+     *
+     *  When set, implementations that drain several datagrams per readiness
+     *  event pass them to \c handler together instead of invoking the
+     *  \c OnMessageReceived delegate once per datagram. Implementations that
+     *  receive one datagram at a time keep using \c OnMessageReceived, so that
+     *  delegate must still be provided to \c Listen.
+     *
+     * @param[in]   handler     The batch reception handler, or \c nullptr to disable batching.
+     */
+    void SetBatchReceiveHandler(OnMessageBatchReceivedFunct handler) { OnMessageBatchReceived = handler; }
+
     /**
      * Close the endpoint.
      *
@@ -247,7 +293,8 @@ public:
 
 protected:
     UDPEndPoint(EndPointManager<UDPEndPoint> & endPointManager) :
-        EndPointBasis(endPointManager), mState(State::kReady), OnMessageReceived(nullptr), OnReceiveError(nullptr)
+        EndPointBasis(endPointManager), mState(State::kReady), OnMessageReceived(nullptr), OnReceiveError(nullptr),
+        OnMessageBatchReceived(nullptr)
     {}
 
     virtual ~UDPEndPoint() = default;
@@ -274,6 +321,9 @@ protected:
     /** The endpoint's receive error event handling function delegate. */
     OnReceiveErrorFunct OnReceiveError;
 
+    /** The endpoint's batched message reception event handling function delegate, if any. */
+    OnMessageBatchReceivedFunct OnMessageBatchReceived;
+
     /*
      * Implementation helpers for shared methods.
      */
@@ -286,6 +336,8 @@ protected:
     virtual CHIP_ERROR BindInterfaceImpl(IPAddressType addressType, InterfaceId interfaceId)                                  = 0;
     virtual CHIP_ERROR ListenImpl()                                                                                           = 0;
     virtual CHIP_ERROR SendMsgImpl(const IPPacketInfo * pktInfo, chip::System::PacketBufferHandle && msg)                     = 0;
+    virtual CHIP_ERROR SendMsgsImpl(const IPPacketInfo * pktInfos, chip::System::PacketBufferHandle * msgs, size_t count,
+                                    CHIP_ERROR * errors);
     virtual void CloseImpl()                                                                                                  = 0;
 };
 
@@ -156,6 +156,66 @@ CHIP_ERROR IPv4Bind(int socket, const IPAddress & address, uint16_t port)
 }
 #endif // INET_CONFIG_ENABLE_IPV4
 
+/**
+ * Extract the source address/port from the peer address of a received datagram, and the
+ * destination address/interface from its IP_PKTINFO/IPV6_PKTINFO control message.
+ */
+CHIP_ERROR GetReceivedPacketInfo(struct msghdr & msgHeader, const SockAddr & peerSockAddr, IPPacketInfo & packetInfo)
+{
+    if (peerSockAddr.any.sa_family == AF_INET6)
+    {
+        packetInfo.SrcAddress = IPAddress(peerSockAddr.in6.sin6_addr);
+        packetInfo.SrcPort    = ntohs(peerSockAddr.in6.sin6_port);
+    }
+#if INET_CONFIG_ENABLE_IPV4
+    else if (peerSockAddr.any.sa_family == AF_INET)
+    {
+        packetInfo.SrcAddress = IPAddress(peerSockAddr.in.sin_addr);
+        packetInfo.SrcPort    = ntohs(peerSockAddr.in.sin_port);
+    }
+#endif // INET_CONFIG_ENABLE_IPV4
+    else
+    {
+        return CHIP_ERROR_INCORRECT_STATE;
+    }
+
+    for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
+         controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
+    {
+#if INET_CONFIG_ENABLE_IPV4
+#ifdef IP_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
+        {
+            auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
+            {
+                return CHIP_ERROR_INCORRECT_STATE;
+            }
+            packetInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
+            packetInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
+            continue;
+        }
+#endif // defined(IP_PKTINFO)
+#endif // INET_CONFIG_ENABLE_IPV4
+
+#ifdef IPV6_PKTINFO
+        if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
+        {
+            auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
+            if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
+            {
+                return CHIP_ERROR_INCORRECT_STATE;
+            }
+            packetInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
+            packetInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
+            continue;
+        }
+#endif // defined(IPV6_PKTINFO)
+    }
+
+    return CHIP_NO_ERROR;
+}
+
 } // anonymous namespace
 
 #if CHIP_SYSTEM_CONFIG_USE_PLATFORM_MULTICAST_API
@@ -283,7 +343,21 @@ CHIP_ERROR UDPEndPointImplSockets::ListenImpl()
     return layer->RequestCallbackOnPendingRead(mWatch);
 }
 
-CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, System::PacketBufferHandle && msg)
+/**
+ * Storage backing one outbound msghdr: the payload vector, the destination
+ * address and the IP_PKTINFO/IPV6_PKTINFO control message.
+ */
+struct UDPEndPointImplSockets::SendMsgState
+{
+    struct iovec msgIOV;
+    SockAddr peerSockAddr;
+#if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
+    uint8_t controlData[256];
+#endif // defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
+};
+
+CHIP_ERROR UDPEndPointImplSockets::PrepareSendMsgHeader(const IPPacketInfo * aPktInfo, const System::PacketBufferHandle & msg,
+                                                        SendMsgState & state, struct msghdr & msgHeader)
 {
     // Make sure we have the appropriate type of socket based on the
     // destination address.
@@ -295,22 +369,19 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     // For now the entire message must fit within a single buffer.
     VerifyOrReturnError(!msg->HasChainedBuffer(), CHIP_ERROR_MESSAGE_TOO_LONG);
 
-    struct iovec msgIOV;
-    msgIOV.iov_base = msg->Start();
-    msgIOV.iov_len  = msg->DataLength();
+    state.msgIOV.iov_base = msg->Start();
+    state.msgIOV.iov_len  = msg->DataLength();
 
 #if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
-    uint8_t controlData[256];
-    memset(controlData, 0, sizeof(controlData));
+    memset(state.controlData, 0, sizeof(state.controlData));
 #endif // defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
 
-    struct msghdr msgHeader;
     memset(&msgHeader, 0, sizeof(msgHeader));
-    msgHeader.msg_iov    = &msgIOV;
+    msgHeader.msg_iov    = &state.msgIOV;
     msgHeader.msg_iovlen = 1;
 
     // Construct a sockaddr_in/sockaddr_in6 structure containing the destination information.
-    SockAddr peerSockAddr;
+    SockAddr & peerSockAddr = state.peerSockAddr;
     memset(&peerSockAddr, 0, sizeof(peerSockAddr));
     msgHeader.msg_name = &peerSockAddr;
     if (mAddrType == IPAddressType::kIPv6)
@@ -352,8 +423,8 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     if (intf.IsPresent() || aPktInfo->SrcAddress.Type() != IPAddressType::kAny)
     {
 #if defined(IP_PKTINFO) || defined(IPV6_PKTINFO)
-        msgHeader.msg_control    = controlData;
-        msgHeader.msg_controllen = sizeof(controlData);
+        msgHeader.msg_control    = state.controlData;
+        msgHeader.msg_controllen = sizeof(state.controlData);
 
         struct cmsghdr * controlHdr      = CMSG_FIRSTHDR(&msgHeader);
         InterfaceId::PlatformType intfId = intf.GetPlatformInterface();
@@ -410,6 +481,16 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
 #endif // !(defined(IP_PKTINFO) && defined(IPV6_PKTINFO))
     }
 
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, System::PacketBufferHandle && msg)
+{
+    SendMsgState state;
+    struct msghdr msgHeader;
+
+    ReturnErrorOnFailure(PrepareSendMsgHeader(aPktInfo, msg, state, msgHeader));
+
     // Send IP packet.
     const ssize_t lenSent = sendmsg(mSocket, &msgHeader, 0);
     if (lenSent == -1)
@@ -423,6 +504,82 @@ CHIP_ERROR UDPEndPointImplSockets::SendMsgImpl(const IPPacketInfo * aPktInfo, Sy
     return CHIP_NO_ERROR;
 }
 
+#if INET_UDP_SOCKETS_BATCH_SEND
+CHIP_ERROR UDPEndPointImplSockets::SendMsgsImpl(const IPPacketInfo * pktInfos, System::PacketBufferHandle * msgs, size_t count,
+                                                CHIP_ERROR * errors)
+{
+    constexpr size_t kBatchSize = INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE;
+
+    SendMsgState states[kBatchSize];
+    struct mmsghdr headers[kBatchSize];
+    size_t headerIndex[kBatchSize];
+    CHIP_ERROR firstError = CHIP_NO_ERROR;
+
+    auto recordResult = [&](size_t i, CHIP_ERROR err) {
+        if (errors != nullptr)
+        {
+            errors[i] = err;
+        }
+        if (firstError == CHIP_NO_ERROR)
+        {
+            firstError = err;
+        }
+    };
+
+    size_t next = 0;
+    while (next < count)
+    {
+        // Fill up to one batch worth of headers. Messages that cannot be described (wrong
+        // address family, chained buffers, ...) fail individually without holding up the rest.
+        unsigned int batchCount = 0;
+        while (next < count && batchCount < kBatchSize)
+        {
+            CHIP_ERROR err = PrepareSendMsgHeader(&pktInfos[next], msgs[next], states[batchCount], headers[batchCount].msg_hdr);
+            if (err != CHIP_NO_ERROR)
+            {
+                recordResult(next, err);
+            }
+            else
+            {
+                headers[batchCount].msg_len = 0;
+                headerIndex[batchCount]     = next;
+                batchCount++;
+            }
+            next++;
+        }
+
+        // sendmmsg() stops at the first datagram that fails; report that one and carry on with
+        // the remainder of the batch.
+        unsigned int sent = 0;
+        while (sent < batchCount)
+        {
+            const int result = sendmmsg(mSocket, &headers[sent], batchCount - sent, 0);
+            if (result <= 0)
+            {
+                recordResult(headerIndex[sent], (result < 0) ? CHIP_ERROR_POSIX(errno) : CHIP_ERROR_INTERNAL);
+                sent++;
+                continue;
+            }
+
+            for (unsigned int i = sent; i < sent + static_cast<unsigned int>(result); i++)
+            {
+                const size_t index = headerIndex[i];
+                recordResult(index,
+                             (headers[i].msg_len == msgs[index]->DataLength()) ? CHIP_NO_ERROR : CHIP_ERROR_OUTBOUND_MESSAGE_TOO_BIG);
+            }
+            sent += static_cast<unsigned int>(result);
+        }
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        msgs[i] = nullptr;
+    }
+
+    return firstError;
+}
+#endif // INET_UDP_SOCKETS_BATCH_SEND
+
 void UDPEndPointImplSockets::CloseImpl()
 {
     if (mSocket != kInvalidSocketFd)
@@ -432,6 +589,13 @@ void UDPEndPointImplSockets::CloseImpl()
         mSocket = kInvalidSocketFd;
     }
 
+#if INET_UDP_SOCKETS_BATCH_RECEIVE
+    for (auto & buffer : mRecvBuffers)
+    {
+        buffer = nullptr;
+    }
+#endif // INET_UDP_SOCKETS_BATCH_RECEIVE
+
 #if CHIP_SYSTEM_CONFIG_USE_DISPATCH
     if (mReadableSource)
     {
@@ -576,6 +740,9 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
         return;
     }
 
+#if INET_UDP_SOCKETS_BATCH_RECEIVE
+    HandlePendingBatchIO();
+#else  // !INET_UDP_SOCKETS_BATCH_RECEIVE
     CHIP_ERROR lStatus = CHIP_NO_ERROR;
     IPPacketInfo lPacketInfo;
     System::PacketBufferHandle lBuffer;
@@ -619,62 +786,7 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
         else
         {
             lBuffer->SetDataLength(static_cast<uint16_t>(rcvLen));
-
-            if (lPeerSockAddr.any.sa_family == AF_INET6)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in6.sin6_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in6.sin6_port);
-            }
-#if INET_CONFIG_ENABLE_IPV4
-            else if (lPeerSockAddr.any.sa_family == AF_INET)
-            {
-                lPacketInfo.SrcAddress = IPAddress(lPeerSockAddr.in.sin_addr);
-                lPacketInfo.SrcPort    = ntohs(lPeerSockAddr.in.sin_port);
-            }
-#endif // INET_CONFIG_ENABLE_IPV4
-            else
-            {
-                lStatus = CHIP_ERROR_INCORRECT_STATE;
-            }
-        }
-
-        if (lStatus == CHIP_NO_ERROR)
-        {
-            for (struct cmsghdr * controlHdr = CMSG_FIRSTHDR(&msgHeader); controlHdr != nullptr;
-                 controlHdr                  = CMSG_NXTHDR(&msgHeader, controlHdr))
-            {
-#if INET_CONFIG_ENABLE_IPV4
-#ifdef IP_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IP && controlHdr->cmsg_type == IP_PKTINFO)
-                {
-                    auto * inPktInfo = reinterpret_cast<struct in_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(inPktInfo->ipi_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(inPktInfo->ipi_addr);
-                    continue;
-                }
-#endif // defined(IP_PKTINFO)
-#endif // INET_CONFIG_ENABLE_IPV4
-
-#ifdef IPV6_PKTINFO
-                if (controlHdr->cmsg_level == IPPROTO_IPV6 && controlHdr->cmsg_type == IPV6_PKTINFO)
-                {
-                    auto * in6PktInfo = reinterpret_cast<struct in6_pktinfo *> CMSG_DATA(controlHdr);
-                    if (!CanCastTo<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex))
-                    {
-                        lStatus = CHIP_ERROR_INCORRECT_STATE;
-                        break;
-                    }
-                    lPacketInfo.Interface   = InterfaceId(static_cast<InterfaceId::PlatformType>(in6PktInfo->ipi6_ifindex));
-                    lPacketInfo.DestAddress = IPAddress(in6PktInfo->ipi6_addr);
-                    continue;
-                }
-#endif // defined(IPV6_PKTINFO)
-            }
+            lStatus = GetReceivedPacketInfo(msgHeader, lPeerSockAddr, lPacketInfo);
         }
     }
     else
@@ -694,7 +806,124 @@ void UDPEndPointImplSockets::HandlePendingIO(System::SocketEvents events)
             OnReceiveError(this, lStatus, nullptr);
         }
     }
+#endif // !INET_UDP_SOCKETS_BATCH_RECEIVE
+}
+
+#if INET_UDP_SOCKETS_BATCH_RECEIVE
+void UDPEndPointImplSockets::HandlePendingBatchIO()
+{
+    constexpr size_t kBatchSize = INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE;
+
+    struct iovec msgIOVs[kBatchSize];
+    SockAddr peerSockAddrs[kBatchSize];
+    uint8_t controlData[kBatchSize][256];
+    struct mmsghdr headers[kBatchSize];
+    unsigned int slotCount = 0;
+
+    // Receive buffers left unused by a previous readiness event are kept for the next one, so a
+    // steady trickle of single datagrams does not allocate and free a whole batch every time.
+    for (; slotCount < kBatchSize; slotCount++)
+    {
+        System::PacketBufferHandle & buffer = mRecvBuffers[slotCount];
+        if (buffer.IsNull())
+        {
+            buffer = System::PacketBufferHandle::New(System::PacketBuffer::kMaxSizeWithoutReserve, 0);
+            if (buffer.IsNull())
+            {
+                break;
+            }
+        }
+
+        msgIOVs[slotCount].iov_base = buffer->Start();
+        msgIOVs[slotCount].iov_len  = buffer->AvailableDataLength();
+
+        memset(&peerSockAddrs[slotCount], 0, sizeof(peerSockAddrs[slotCount]));
+        memset(&headers[slotCount], 0, sizeof(headers[slotCount]));
+
+        struct msghdr & msgHeader = headers[slotCount].msg_hdr;
+        msgHeader.msg_name        = &peerSockAddrs[slotCount];
+        msgHeader.msg_namelen     = sizeof(peerSockAddrs[slotCount]);
+        msgHeader.msg_iov         = &msgIOVs[slotCount];
+        msgHeader.msg_iovlen      = 1;
+        msgHeader.msg_control     = controlData[slotCount];
+        msgHeader.msg_controllen  = sizeof(controlData[slotCount]);
+    }
+
+    if (slotCount == 0)
+    {
+        if (OnReceiveError != nullptr)
+        {
+            OnReceiveError(this, CHIP_ERROR_NO_MEMORY, nullptr);
+        }
+        return;
+    }
+
+    const int rcvCount = recvmmsg(mSocket, headers, slotCount, MSG_DONTWAIT, nullptr);
+    if (rcvCount < 0)
+    {
+        const CHIP_ERROR lStatus = CHIP_ERROR_POSIX(errno);
+        if (OnReceiveError != nullptr && lStatus != CHIP_ERROR_POSIX(EAGAIN))
+        {
+            OnReceiveError(this, lStatus, nullptr);
+        }
+        return;
+    }
+
+    System::PacketBufferHandle msgs[kBatchSize];
+    IPPacketInfo pktInfos[kBatchSize];
+    size_t msgCount       = 0;
+    CHIP_ERROR lastStatus = CHIP_NO_ERROR;
+
+    for (int i = 0; i < rcvCount; i++)
+    {
+        System::PacketBufferHandle buffer = std::move(mRecvBuffers[i]);
+        IPPacketInfo & pktInfo            = pktInfos[msgCount];
+        CHIP_ERROR lStatus                = CHIP_NO_ERROR;
+
+        pktInfo.Clear();
+        pktInfo.DestPort = mBoundPort;
+
+        if ((headers[i].msg_hdr.msg_flags & MSG_TRUNC) != 0)
+        {
+            lStatus = CHIP_ERROR_INBOUND_MESSAGE_TOO_BIG;
+        }
+        else
+        {
+            buffer->SetDataLength(static_cast<uint16_t>(headers[i].msg_len));
+            lStatus = GetReceivedPacketInfo(headers[i].msg_hdr, peerSockAddrs[i], pktInfo);
+        }
+
+        if (lStatus != CHIP_NO_ERROR)
+        {
+            lastStatus = lStatus;
+            continue;
+        }
+
+        buffer.RightSize();
+        msgs[msgCount++] = std::move(buffer);
+    }
+
+    if (lastStatus != CHIP_NO_ERROR && OnReceiveError != nullptr)
+    {
+        OnReceiveError(this, lastStatus, nullptr);
+    }
+
+    if (OnMessageBatchReceived != nullptr)
+    {
+        if (msgCount > 0 && mState == State::kListening)
+        {
+            OnMessageBatchReceived(this, msgs, pktInfos, msgCount);
+        }
+        return;
+    }
+
+    // A delegate may close the endpoint while handling a message; stop delivering once it has.
+    for (size_t i = 0; i < msgCount && mState == State::kListening; i++)
+    {
+        OnMessageReceived(this, std::move(msgs[i]), &pktInfos[i]);
+    }
 }
+#endif // INET_UDP_SOCKETS_BATCH_RECEIVE
 
 #if IP_MULTICAST_LOOP || IPV6_MULTICAST_LOOP
 static CHIP_ERROR SocketsSetMulticastLoopback(int aSocket, bool aLoopback, int aProtocol, int aOption)
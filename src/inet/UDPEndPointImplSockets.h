@@ -30,6 +30,20 @@
 #include <dispatch/dispatch.h>
 #endif
 
+#if HAVE_SYS_SOCKET_H
+#include <sys/socket.h>
+#endif // HAVE_SYS_SOCKET_H
+
+/**
+ * Whether sockets-based UDP endpoints drain several datagrams per readiness event with recvmmsg().
+ */
+#define INET_UDP_SOCKETS_BATCH_RECEIVE (HAVE_RECVMMSG && INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE > 1)
+
+/**
+ * Whether sockets-based UDP endpoints transmit UDPEndPoint::SendMsgs() batches with sendmmsg().
+ */
+#define INET_UDP_SOCKETS_BATCH_SEND (HAVE_SENDMMSG && INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE > 1)
+
 namespace chip {
 namespace Inet {
 
@@ -56,15 +70,30 @@ private:
     CHIP_ERROR BindInterfaceImpl(IPAddressType addressType, InterfaceId interfaceId) override;
     CHIP_ERROR ListenImpl() override;
     CHIP_ERROR SendMsgImpl(const IPPacketInfo * pktInfo, chip::System::PacketBufferHandle && msg) override;
+#if INET_UDP_SOCKETS_BATCH_SEND
+    CHIP_ERROR SendMsgsImpl(const IPPacketInfo * pktInfos, chip::System::PacketBufferHandle * msgs, size_t count,
+                            CHIP_ERROR * errors) override;
+#endif // INET_UDP_SOCKETS_BATCH_SEND
     void CloseImpl() override;
 
+    struct SendMsgState;
+    CHIP_ERROR PrepareSendMsgHeader(const IPPacketInfo * pktInfo, const System::PacketBufferHandle & msg, SendMsgState & state,
+                                    struct msghdr & msgHeader);
+
     CHIP_ERROR GetSocket(IPAddressType addressType);
     void HandlePendingIO(System::SocketEvents events);
     static void HandlePendingIO(System::SocketEvents events, intptr_t data);
+#if INET_UDP_SOCKETS_BATCH_RECEIVE
+    void HandlePendingBatchIO();
+#endif // INET_UDP_SOCKETS_BATCH_RECEIVE
 
     InterfaceId mBoundIntfId;
     uint16_t mBoundPort;
 
+#if INET_UDP_SOCKETS_BATCH_RECEIVE
+    System::PacketBufferHandle mRecvBuffers[INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE];
+#endif // INET_UDP_SOCKETS_BATCH_RECEIVE
+
 #if CHIP_SYSTEM_CONFIG_USE_DISPATCH
     dispatch_source_t mReadableSource = nullptr;
 #endif // CHIP_SYSTEM_CONFIG_USE_DISPATCH
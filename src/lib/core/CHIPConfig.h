@@ -491,6 +491,34 @@
 #define CHIP_CONFIG_MEMORY_DEBUG_CHECKS 0
 #endif // CHIP_CONFIG_MEMORY_DEBUG_CHECKS
 
+/**
+ *  @def CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+ *
+ *  @brief
+ *    Enable (1) or disable (0) recording of structured trace spans and
+ *    counters (see system/SystemTrace.h). When disabled, the trace
+ *    macros compile to nothing.
+ */
+#ifndef CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+#define CHIP_CONFIG_STRUCTURED_TRACE_ENABLED 0
+#endif // CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+
+/**
+ *  @def CHIP_CONFIG_STRUCTURED_TRACE_BUFFER_SIZE
+ *
+ *  @brief
+ *    The number of trace events each thread can hold before they are
+ *    drained; must be a power of two. Events recorded while a thread's
+ *    buffer is full are dropped and counted.
+ *
+ *  @note This configuration is only relevant when
+ *        #CHIP_CONFIG_STRUCTURED_TRACE_ENABLED is set and
+ *        ignored otherwise.
+ */
+#ifndef CHIP_CONFIG_STRUCTURED_TRACE_BUFFER_SIZE
+#define CHIP_CONFIG_STRUCTURED_TRACE_BUFFER_SIZE 4096
+#endif // CHIP_CONFIG_STRUCTURED_TRACE_BUFFER_SIZE
+
 /**
  *  @def CHIP_CONFIG_MEMORY_DEBUG_DMALLOC
  *
@@ -1025,6 +1053,21 @@
 #define CHIP_CONFIG_MAX_INCOMING_TCP_CON_FROM_SINGLE_IP 2
 #endif // CHIP_CONFIG_MAX_INCOMING_TCP_CON_FROM_SINGLE_IP
 
+/**
+ *  @def CHIP_CONFIG_TCP_CONNECTION_IDLE_TIMEOUT_MS
+ *
+ *  @brief
+ *    Default time, in milliseconds, after which a TCP transport
+ *    connection that has neither sent nor received data is closed.
+ *
+ *    A value of zero disables idle connection reaping.  The idle check
+ *    runs every #INET_TCP_IDLE_CHECK_INTERVAL milliseconds, so the
+ *    effective timeout is rounded up to a multiple of that interval.
+ */
+#ifndef CHIP_CONFIG_TCP_CONNECTION_IDLE_TIMEOUT_MS
+#define CHIP_CONFIG_TCP_CONNECTION_IDLE_TIMEOUT_MS 0
+#endif // CHIP_CONFIG_TCP_CONNECTION_IDLE_TIMEOUT_MS
+
 /**
  *  @def CHIP_CONFIG_MAX_SESSION_KEYS
  *
@@ -2468,6 +2511,104 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_IM_MAX_REPORTS_IN_FLIGHT 4
 #endif
 
+/**
+ * @def CHIP_IM_REPORT_CACHE_SIZE
+ *
+ * @brief Defines the size, in bytes, of the buffer in which the reporting engine keeps the attribute data it has encoded
+ *        during one run, so that readers interested in the same attributes share the encoding instead of each reading and
+ *        encoding them again. 0 disables the cache.
+ */
+#ifndef CHIP_IM_REPORT_CACHE_SIZE
+#define CHIP_IM_REPORT_CACHE_SIZE 1024
+#endif
+
+/**
+ * @def CHIP_IM_REPORT_CACHE_MAX_ENTRIES
+ *
+ * @brief Defines the maximum number of attribute paths kept in the cache of the reporting engine.
+ */
+#ifndef CHIP_IM_REPORT_CACHE_MAX_ENTRIES
+#define CHIP_IM_REPORT_CACHE_MAX_ENTRIES 16
+#endif
+
+/**
+ * @def CHIP_IM_SUBSCRIPTION_WHEEL_TICK_MS
+ *
+ * @brief Defines the granularity, in milliseconds, of the timing wheel scheduling the reports of all subscriptions.
+ *        Subscription deadlines falling within the same tick are handled by the same run of the reporting engine.
+ */
+#ifndef CHIP_IM_SUBSCRIPTION_WHEEL_TICK_MS
+#define CHIP_IM_SUBSCRIPTION_WHEEL_TICK_MS 250
+#endif
+
+/**
+ * @def CHIP_IM_SUBSCRIPTION_WHEEL_SLOTS
+ *
+ * @brief Defines the number of slots of the subscription timing wheel. Deadlines further away than one turn of the wheel
+ *        are still supported, but are visited once per turn.
+ */
+#ifndef CHIP_IM_SUBSCRIPTION_WHEEL_SLOTS
+#define CHIP_IM_SUBSCRIPTION_WHEEL_SLOTS 64
+#endif
+
+/**
+ * @def CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+ *
+ * @brief Enables saving the subscriptions served over CASE to persistent storage, so that the server re-establishes them
+ *        with their subscribers after a restart.
+ */
+#ifndef CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+#define CHIP_CONFIG_PERSIST_SUBSCRIPTIONS 0
+#endif
+
+/**
+ * @def CHIP_IM_SUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS
+ *
+ * @brief Defines the maximum number of subscriptions owned by the client subscription manager, when pools are not
+ *        allocated from the heap.
+ */
+#ifndef CHIP_IM_SUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS
+#define CHIP_IM_SUBSCRIPTION_MANAGER_MAX_SUBSCRIPTIONS 16
+#endif
+
+/**
+ * @def CHIP_IM_SUBSCRIPTION_MANAGER_MAX_CONCURRENT_RESUBSCRIBES
+ *
+ * @brief Defines the maximum number of subscriptions the client subscription manager (re)establishes at the same time. The
+ *        others wait their turn, so that a controller coming back online does not flood the network.
+ */
+#ifndef CHIP_IM_SUBSCRIPTION_MANAGER_MAX_CONCURRENT_RESUBSCRIBES
+#define CHIP_IM_SUBSCRIPTION_MANAGER_MAX_CONCURRENT_RESUBSCRIBES 8
+#endif
+
+/**
+ * @def CHIP_IM_SUBSCRIPTION_MANAGER_MAX_CONCURRENT_SESSION_SETUPS
+ *
+ * @brief Defines the maximum number of CASE sessions the client subscription manager sets up at the same time.
+ */
+#ifndef CHIP_IM_SUBSCRIPTION_MANAGER_MAX_CONCURRENT_SESSION_SETUPS
+#define CHIP_IM_SUBSCRIPTION_MANAGER_MAX_CONCURRENT_SESSION_SETUPS 4
+#endif
+
+/**
+ * @def CHIP_IM_SUBSCRIPTION_MANAGER_MIN_RETRY_DELAY_MS
+ *
+ * @brief Defines the delay before the first attempt to re-establish a failed subscription. The delay doubles with each
+ *        consecutive failure and is jittered to spread the attempts of many subscriptions over time.
+ */
+#ifndef CHIP_IM_SUBSCRIPTION_MANAGER_MIN_RETRY_DELAY_MS
+#define CHIP_IM_SUBSCRIPTION_MANAGER_MIN_RETRY_DELAY_MS 1000
+#endif
+
+/**
+ * @def CHIP_IM_SUBSCRIPTION_MANAGER_MAX_RETRY_DELAY_MS
+ *
+ * @brief Defines the maximum delay between two attempts to re-establish a failed subscription.
+ */
+#ifndef CHIP_IM_SUBSCRIPTION_MANAGER_MAX_RETRY_DELAY_MS
+#define CHIP_IM_SUBSCRIPTION_MANAGER_MAX_RETRY_DELAY_MS 300000
+#endif
+
 /**
  * @def CHIP_IM_SERVER_MAX_NUM_PATH_GROUPS
  *
@@ -2552,6 +2693,15 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_DEVICES 64
 #endif
 
+/**
+ * @def CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_COMMISSIONEES
+ *
+ * @brief Number of devices a commissioner can be simultaneously commissioning
+ */
+#ifndef CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_COMMISSIONEES
+#define CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_COMMISSIONEES 4
+#endif
+
 /**
  * @def CHIP_CONFIG_CONTROLLER_MAX_ACTIVE_CASE_CLIENTS
  *
@@ -2632,6 +2782,42 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_MAX_GROUP_NAME_LENGTH 16
 #endif
 
+/**
+ * @def CHIP_CONFIG_GROUP_DATA_CACHE_MAX_ENTRIES
+ *
+ * @brief Defines the maximum number of group data records kept in memory by GroupDataProviderImpl
+ *
+ * Records are cached as they are read, the cache grows on demand up to this number of entries.
+ * Once full, further records are read from storage on every access. Set to 0 to disable the cache.
+ * Each entry takes about 170 bytes of heap, platforms with memory to spare may raise this limit.
+ */
+#ifndef CHIP_CONFIG_GROUP_DATA_CACHE_MAX_ENTRIES
+#define CHIP_CONFIG_GROUP_DATA_CACHE_MAX_ENTRIES 16
+#endif
+
+/**
+ * @def CHIP_CONFIG_MAX_GROUP_DATA_PEERS
+ *
+ * @brief Defines the number of group data message senders whose message counters are tracked
+ *
+ * Senders are tracked per (fabric, source node). When the table is full, the least recently
+ * heard sender is forgotten, and its next message is trusted as if it were the first one.
+ */
+#ifndef CHIP_CONFIG_MAX_GROUP_DATA_PEERS
+#define CHIP_CONFIG_MAX_GROUP_DATA_PEERS 15
+#endif
+
+/**
+ * @def CHIP_CONFIG_MAX_GROUP_CONTROL_PEERS
+ *
+ * @brief Defines the number of group control message senders whose message counters are tracked
+ *
+ * Same as CHIP_CONFIG_MAX_GROUP_DATA_PEERS, for messages with the control message flag set.
+ */
+#ifndef CHIP_CONFIG_MAX_GROUP_CONTROL_PEERS
+#define CHIP_CONFIG_MAX_GROUP_CONTROL_PEERS 2
+#endif
+
 /**
  * @def CHIP_CONFIG_EXAMPLE_ACCESS_CONTROL_MAX_ENTRIES_PER_FABRIC
  *
@@ -2750,6 +2936,80 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_CASE_SESSION_RESUME_CACHE_SIZE 4
 #endif
 
+/**
+ * @def CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS
+ *
+ * @brief
+ *   Maximum number of CASE handshakes that a device responds to concurrently.
+ *   Sigma1 messages received while all the responders are busy are dropped.
+ *   Each responder holds a CASE session, so constrained devices keep the
+ *   default of a single one; platforms expecting many controllers, such as
+ *   Linux and Darwin, raise it.
+ */
+#ifndef CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS
+#define CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS 1
+#endif
+
+/**
+ * @def CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS_PER_PEER
+ *
+ * @brief
+ *   Number of concurrent CASE handshakes with the same peer address (IP address and port)
+ *   past which, when all the responders are busy, a new Sigma1 from that address replaces
+ *   its oldest pending handshake instead of being dropped.
+ */
+#ifndef CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS_PER_PEER
+#define CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS_PER_PEER 1
+#endif
+
+/**
+ * @def CHIP_CONFIG_FABRIC_VERIFIED_ICAC_CACHE_SIZE
+ *
+ * @brief
+ *   Number of intermediate CA certificates that each fabric remembers as already verified
+ *   against its root certificate. Peers presenting a cached ICAC during CASE only need their
+ *   NOC signature to be verified. Must be at least 1.
+ */
+#ifndef CHIP_CONFIG_FABRIC_VERIFIED_ICAC_CACHE_SIZE
+#define CHIP_CONFIG_FABRIC_VERIFIED_ICAC_CACHE_SIZE 2
+#endif
+
+/**
+ * @def CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE
+ *
+ * @brief
+ *   Number of PASE verifiers kept after being derived from a setup PIN code, so that
+ *   retrying commissioning within a window or pairing again with the same setup PIN
+ *   code doesn't run PBKDF2 again. Must be at least 1.
+ */
+#ifndef CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE
+#define CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE 2
+#endif
+
+/**
+ * @def CHIP_CONFIG_DEVICE_ATTESTATION_VERIFIED_PAI_CACHE_SIZE
+ *
+ * @brief
+ *   Number of product attestation intermediate certificates that the default device attestation
+ *   verifier remembers as already validated against their PAA. DACs issued by a cached PAI only
+ *   need their own signature to be validated. Must be at least 1.
+ */
+#ifndef CHIP_CONFIG_DEVICE_ATTESTATION_VERIFIED_PAI_CACHE_SIZE
+#define CHIP_CONFIG_DEVICE_ATTESTATION_VERIFIED_PAI_CACHE_SIZE 4
+#endif
+
+/**
+ * @def CHIP_CONFIG_ATTRIBUTE_LOCATION_CACHE_SIZE
+ *
+ * @brief
+ *   Number of attributes of fixed endpoints whose metadata and storage location are remembered
+ *   once found, so that reading or writing them again, e.g. through the generated attribute
+ *   accessors, does not search the endpoint configuration. 0 disables the cache.
+ */
+#ifndef CHIP_CONFIG_ATTRIBUTE_LOCATION_CACHE_SIZE
+#define CHIP_CONFIG_ATTRIBUTE_LOCATION_CACHE_SIZE 16
+#endif
+
 /**
  * @def CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD
  *
@@ -2770,6 +3030,21 @@ extern const char CHIP_NON_PRODUCTION_MARKER[];
 #define CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD 512
 #endif /* CHIP_CONFIG_EVENT_LOGGING_BYTE_THRESHOLD */
 
+/**
+ * @def CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE
+ *
+ * @brief The number of event number to buffer offset checkpoints kept by
+ *   each event logging buffer.
+ *
+ * Checkpoints are spread over the buffer so that fetching the events since
+ * a given event number starts reading close to it instead of at the oldest
+ * event of the buffer. 0 disables the index.
+ *
+ */
+#ifndef CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE
+#define CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE 8
+#endif /* CHIP_CONFIG_EVENT_OFFSET_INDEX_SIZE */
+
 /**
  * @def CHIP_CONFIG_ENABLE_SERVER_IM_EVENT
  *
@@ -86,5 +86,11 @@ void RegisterNFCCommands();
  */
 void RegisterDnsCommands();
 
+/**
+ * This function registers the runtime metrics commands.
+ *
+ */
+void RegisterMetricsCommands();
+
 } // namespace Shell
 } // namespace chip
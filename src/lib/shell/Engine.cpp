@@ -29,6 +29,7 @@
 #include <lib/support/CodeUtils.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <platform/CHIPDeviceLayer.h>
+#include <system/SystemConfig.h>
 
 #include <assert.h>
 #include <ctype.h>
@@ -117,6 +118,9 @@ void Engine::RegisterDefaultCommands()
 #if CHIP_DEVICE_CONFIG_ENABLE_OTA_REQUESTOR
     RegisterOtaCommands();
 #endif
+#if CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+    RegisterMetricsCommands();
+#endif
 }
 
 } // namespace Shell
@@ -0,0 +1,129 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <inttypes.h>
+#include <string.h>
+
+#include <lib/core/CHIPCore.h>
+#include <lib/shell/Commands.h>
+#include <lib/shell/Engine.h>
+#include <lib/shell/commands/Help.h>
+#include <lib/support/CodeUtils.h>
+#include <system/SystemMetrics.h>
+
+chip::Shell::Engine sShellMetricsCommands;
+
+namespace chip {
+namespace Shell {
+
+using System::Metrics::Counter;
+using System::Metrics::Gauge;
+using System::Metrics::Histogram;
+using System::Metrics::Metric;
+
+static CHIP_ERROR MetricsHelpHandler(int argc, char ** argv)
+{
+    sShellMetricsCommands.ForEachCommand(PrintCommandHelp, nullptr);
+    return CHIP_NO_ERROR;
+}
+
+static void PrintMetric(streamer_t * sout, const Metric & metric)
+{
+    switch (metric.GetType())
+    {
+    case Metric::Type::kCounter:
+        streamer_printf(sout, "%s: %" PRIu64 "\r\n", metric.GetName(), static_cast<const Counter &>(metric).Get());
+        break;
+    case Metric::Type::kGauge: {
+        const Gauge & gauge = static_cast<const Gauge &>(metric);
+        streamer_printf(sout, "%s: %" PRId64 " (max %" PRId64 ")\r\n", metric.GetName(), gauge.Get(), gauge.GetHighWatermark());
+        break;
+    }
+    case Metric::Type::kHistogram: {
+        const Histogram & histogram = static_cast<const Histogram &>(metric);
+        streamer_printf(sout, "%s: count %" PRIu64 " sum %" PRIu64 " p50 <= %" PRIu64 " p90 <= %" PRIu64 " p99 <= %" PRIu64 "\r\n",
+                        metric.GetName(), histogram.GetCount(), histogram.GetSum(), histogram.GetPercentileUpperBound(50),
+                        histogram.GetPercentileUpperBound(90), histogram.GetPercentileUpperBound(99));
+        break;
+    }
+    }
+}
+
+static CHIP_ERROR MetricsListHandler(int argc, char ** argv)
+{
+    streamer_t * sout = streamer_get();
+
+    for (const Metric * metric = System::Metrics::GetFirstMetric(); metric != nullptr; metric = metric->GetNext())
+    {
+        PrintMetric(sout, *metric);
+    }
+    return CHIP_NO_ERROR;
+}
+
+static CHIP_ERROR MetricsGetHandler(int argc, char ** argv)
+{
+    VerifyOrReturnError(argc == 1, CHIP_ERROR_INVALID_ARGUMENT);
+
+    const Metric * metric = System::Metrics::FindMetric(argv[0]);
+    VerifyOrReturnError(metric != nullptr, CHIP_ERROR_KEY_NOT_FOUND);
+
+    PrintMetric(streamer_get(), *metric);
+    return CHIP_NO_ERROR;
+}
+
+static void PrintPrometheusText(const char * text, void * context)
+{
+    streamer_printf(streamer_get(), "%s", text);
+}
+
+static CHIP_ERROR MetricsPrometheusHandler(int argc, char ** argv)
+{
+    System::Metrics::WritePrometheusText(PrintPrometheusText, nullptr);
+    return CHIP_NO_ERROR;
+}
+
+static CHIP_ERROR MetricsDispatch(int argc, char ** argv)
+{
+    if (argc == 0)
+    {
+        return MetricsListHandler(argc, argv);
+    }
+    return sShellMetricsCommands.ExecCommand(argc, argv);
+}
+
+void RegisterMetricsCommands()
+{
+    /// Subcommands for root command: `metrics <subcommand>`
+    static const shell_command_t sMetricsSubCommands[] = {
+        { &MetricsHelpHandler, "help", "Usage: metrics <subcommand>" },
+        { &MetricsListHandler, "list", "Print the value of every metric. Usage: metrics list" },
+        { &MetricsGetHandler, "get", "Print the value of a metric. Usage: metrics get <name>" },
+        { &MetricsPrometheusHandler, "prometheus", "Print all metrics in the Prometheus text format. Usage: metrics prometheus" },
+    };
+
+    static const shell_command_t sMetricsCommand = { &MetricsDispatch, "metrics", "Runtime metrics" };
+
+    // Register `metrics` subcommands with the local shell dispatcher.
+    sShellMetricsCommands.RegisterCommands(sMetricsSubCommands, ArraySize(sMetricsSubCommands));
+
+    // Register the root `metrics` command with the top-level shell.
+    Engine::Root().RegisterCommands(&sMetricsCommand, 1);
+}
+
+} // namespace Shell
+} // namespace chip
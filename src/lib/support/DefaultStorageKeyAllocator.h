@@ -45,6 +45,14 @@ public:
     }
     const char * FabricKeyset(chip::FabricIndex fabric, uint16_t keyset) { return Format("f/%x/k/%x", fabric, keyset); }
 
+    // Interaction Model
+
+    const char * SubscriptionResumption(uint16_t index) { return Format("g/su/%x", index); }
+
+    // Scenes
+
+    const char * SceneTableEntry(uint8_t index) { return Format("g/sc/%x", index); }
+
 private:
     static const size_t kKeyLengthMax = 32;
 
@@ -43,6 +43,8 @@
 #include <messaging/ExchangeMgr.h>
 #include <protocols/Protocols.h>
 #include <protocols/secure_channel/Constants.h>
+#include <system/SystemMetrics.h>
+#include <system/SystemTrace.h>
 
 #if CONFIG_DEVICE_LAYER
 #include <platform/CHIPDeviceLayer.h>
@@ -55,6 +57,8 @@ using namespace chip::System;
 namespace chip {
 namespace Messaging {
 
+SYSTEM_METRICS_GAUGE(sExchangesInUse, "chip_exchanges_in_use", "Number of exchange contexts in use");
+
 static void DefaultOnMessageReceived(ExchangeContext * ec, Protocols::Id protocolId, uint8_t msgType, uint32_t messageCounter,
                                      PacketBufferHandle && payload)
 {
@@ -273,6 +277,8 @@ ExchangeContext::ExchangeContext(ExchangeManager * em, uint16_t ExchangeId, cons
     ChipLogDetail(ExchangeManager, "ec++ id: " ChipLogFormatExchange, ChipLogValueExchange(this));
 #endif
     SYSTEM_STATS_INCREMENT(chip::System::Stats::kExchangeMgr_NumContexts);
+    SYSTEM_METRICS_INCREMENT(sExchangesInUse);
+    CHIP_TRACE_ASYNC_BEGIN(Messaging, "Exchange", reinterpret_cast<uintptr_t>(this));
 }
 
 ExchangeContext::~ExchangeContext()
@@ -291,6 +297,8 @@ ExchangeContext::~ExchangeContext()
     ChipLogDetail(ExchangeManager, "ec-- id: " ChipLogFormatExchange, ChipLogValueExchange(this));
 #endif
     SYSTEM_STATS_DECREMENT(chip::System::Stats::kExchangeMgr_NumContexts);
+    SYSTEM_METRICS_DECREMENT(sExchangesInUse);
+    CHIP_TRACE_ASYNC_END(Messaging, "Exchange", reinterpret_cast<uintptr_t>(this));
 }
 
 bool ExchangeContext::MatchExchange(const SessionHandle & session, const PacketHeader & packetHeader,
@@ -42,6 +42,7 @@
 #include <messaging/ExchangeContext.h>
 #include <messaging/ExchangeMgr.h>
 #include <protocols/Protocols.h>
+#include <system/SystemMetrics.h>
 
 using namespace chip::Encoding;
 using namespace chip::Inet;
@@ -50,6 +51,9 @@ using namespace chip::System;
 namespace chip {
 namespace Messaging {
 
+SYSTEM_METRICS_COUNTER(sExchangeAllocationFailures, "chip_exchange_allocation_failures_total",
+                       "Number of exchange contexts that could not be allocated");
+
 /**
  *  Constructor for the ExchangeManager class.
  *  It sets the state to kState_NotInitialized.
@@ -86,7 +90,7 @@ CHIP_ERROR ExchangeManager::Init(SessionManager * sessionManager)
     sessionManager->RegisterReleaseDelegate(*this);
     sessionManager->SetMessageDelegate(this);
 
-    mReliableMessageMgr.Init(sessionManager->SystemLayer());
+    mReliableMessageMgr.Init(sessionManager->SystemLayer(), sessionManager);
 
     mState = State::kState_Initialized;
 
@@ -117,7 +121,12 @@ CHIP_ERROR ExchangeManager::Shutdown()
 
 ExchangeContext * ExchangeManager::NewContext(const SessionHandle & session, ExchangeDelegate * delegate)
 {
-    return mContextPool.CreateObject(this, mNextExchangeId++, session, true, delegate);
+    ExchangeContext * ec = mContextPool.CreateObject(this, mNextExchangeId++, session, true, delegate);
+    if (ec == nullptr)
+    {
+        SYSTEM_METRICS_INCREMENT(sExchangeAllocationFailures);
+    }
+    return ec;
 }
 
 CHIP_ERROR ExchangeManager::RegisterUnsolicitedMessageHandlerForProtocol(Protocols::Id protocolId, ExchangeDelegate * delegate)
@@ -289,6 +298,7 @@ void ExchangeManager::OnMessageReceived(const PacketHeader & packetHeader, const
 
         if (ec == nullptr)
         {
+            SYSTEM_METRICS_INCREMENT(sExchangeAllocationFailures);
             // Using same error message for all errors to reduce code size.
             ChipLogError(ExchangeManager, "OnMessageReceived failed, err = %s", ErrorStr(CHIP_ERROR_NO_MEMORY));
             return;
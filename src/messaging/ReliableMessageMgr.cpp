@@ -34,10 +34,18 @@
 #include <messaging/ExchangeMgr.h>
 #include <messaging/Flags.h>
 #include <messaging/ReliableMessageContext.h>
+#include <system/SystemMetrics.h>
+#include <system/SystemTrace.h>
 
 namespace chip {
 namespace Messaging {
 
+SYSTEM_METRICS_COUNTER(sRetransmissions, "chip_mrp_retransmissions_total", "Number of reliable messages retransmitted");
+SYSTEM_METRICS_COUNTER(sRetransmitLimitReached, "chip_mrp_retransmit_limit_reached_total",
+                       "Number of reliable messages dropped after reaching the retransmission limit");
+SYSTEM_METRICS_HISTOGRAM(sAckLatency, "chip_mrp_ack_latency_microseconds",
+                         "Time from the first transmission of a reliable message to its acknowledgement");
+
 ReliableMessageMgr::RetransTableEntry::RetransTableEntry(ReliableMessageContext * rc) :
     ec(*rc->GetExchangeContext()), retainedBuf(EncryptedPacketBufferHandle()), nextRetransTime(0), sendCount(0)
 {
@@ -55,9 +63,15 @@ ReliableMessageMgr::ReliableMessageMgr(BitMapObjectPool<ExchangeContext, CHIP_CO
 
 ReliableMessageMgr::~ReliableMessageMgr() {}
 
-void ReliableMessageMgr::Init(chip::System::Layer * systemLayer)
+void ReliableMessageMgr::Init(chip::System::Layer * systemLayer, SessionManager * sessionManager)
 {
-    mSystemLayer = systemLayer;
+    mSystemLayer    = systemLayer;
+    mSessionManager = sessionManager;
+
+    if (mSessionManager != nullptr)
+    {
+        mSessionManager->SetSendBatchErrorDelegate(this);
+    }
 }
 
 void ReliableMessageMgr::Shutdown()
@@ -70,7 +84,13 @@ void ReliableMessageMgr::Shutdown()
         return Loop::Continue;
     });
 
-    mSystemLayer = nullptr;
+    if (mSessionManager != nullptr)
+    {
+        mSessionManager->SetSendBatchErrorDelegate(nullptr);
+    }
+
+    mSystemLayer    = nullptr;
+    mSessionManager = nullptr;
 }
 
 #if defined(RMP_TICKLESS_DEBUG)
@@ -101,6 +121,9 @@ void ReliableMessageMgr::ExecuteActions()
     ChipLogDetail(ExchangeManager, "ReliableMessageMgr::ExecuteActions at % " PRIu64 "ms", now.count());
 #endif
 
+    // Standalone acks and retransmissions that fall due on the same tick are handed to the transport together.
+    ScopedSendBatch sendBatch(mSessionManager);
+
     ExecuteForAllContext([&](ReliableMessageContext * rc) {
         if (rc->IsAckPending())
         {
@@ -131,6 +154,9 @@ void ReliableMessageMgr::ExecuteActions()
                          " sendCount: %" PRIu8 " max retries: %d",
                          messageCounter, ChipLogValueExchange(&entry->ec.Get()), sendCount, CHIP_CONFIG_RMP_DEFAULT_MAX_RETRANS);
 
+            CHIP_TRACE_INSTANT(Messaging, "MRPRetransmitLimitReached");
+            SYSTEM_METRICS_INCREMENT(sRetransmitLimitReached);
+
             // Do not StartTimer, we will schedule the timer at the end of the timer handler.
             mRetransTable.ReleaseObject(entry);
             return Loop::Continue;
@@ -140,6 +166,8 @@ void ReliableMessageMgr::ExecuteActions()
                       "Retransmitting MessageCounter:" ChipLogFormatMessageCounter " on exchange " ChipLogFormatExchange
                       " Send Cnt %d",
                       messageCounter, ChipLogValueExchange(&entry->ec.Get()), entry->sendCount);
+        CHIP_TRACE_INSTANT(Messaging, "MRPRetransmit");
+        SYSTEM_METRICS_INCREMENT(sRetransmissions);
         // TODO: Choose active/idle timeout corresponding to the activity of exchanges of the session.
         entry->nextRetransTime = System::SystemClock().GetMonotonicTimestamp() + entry->ec->GetMRPConfig().mActiveRetransTimeout;
         SendFromRetransTable(entry);
@@ -186,6 +214,9 @@ void ReliableMessageMgr::StartRetransmision(RetransTableEntry * entry)
 {
     // TODO: Choose active/idle timeout corresponding to the activity of exchanges of the session.
     entry->nextRetransTime = System::SystemClock().GetMonotonicTimestamp() + entry->ec->GetMRPConfig().mIdleRetransTimeout;
+#if CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+    entry->firstSendTime = System::SystemClock().GetMonotonicMicroseconds64();
+#endif
     StartTimer();
 }
 
@@ -195,6 +226,10 @@ bool ReliableMessageMgr::CheckAndRemRetransTable(ReliableMessageContext * rc, ui
     mRetransTable.ForEachActiveObject([&](auto * entry) {
         if (entry->ec->GetReliableMessageContext() == rc && entry->retainedBuf.GetMessageCounter() == ackMessageCounter)
         {
+#if CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+            SYSTEM_METRICS_RECORD(sAckLatency, (System::SystemClock().GetMonotonicMicroseconds64() - entry->firstSendTime).count());
+#endif
+
             // Clear the entry from the retransmision table.
             ClearRetransTable(*entry);
 
@@ -259,6 +294,28 @@ CHIP_ERROR ReliableMessageMgr::SendFromRetransTable(RetransTableEntry * entry)
     return err;
 }
 
+void ReliableMessageMgr::OnBatchedSendFailed(const System::PacketBufferHandle & message, CHIP_ERROR error)
+{
+    // ENOBUFS is transient and left to retransmission, as ExchangeMessageDispatch::SendMessage does.
+    VerifyOrReturn(error != CHIP_ERROR_POSIX(ENOBUFS));
+
+    mRetransTable.ForEachActiveObject([&](auto * entry) {
+        if (!entry->retainedBuf.HoldsBuffer(message))
+        {
+            return Loop::Continue;
+        }
+
+        // Using same error message for all errors to reduce code size.
+        ChipLogError(ExchangeManager,
+                     "Crit-err %" CHIP_ERROR_FORMAT " when sending CHIP MessageCounter:" ChipLogFormatMessageCounter
+                     " on exchange " ChipLogFormatExchange ", send tries: %d",
+                     error.Format(), entry->retainedBuf.GetMessageCounter(), ChipLogValueExchange(&entry->ec.Get()),
+                     entry->sendCount);
+        ClearRetransTable(*entry);
+        return Loop::Break;
+    });
+}
+
 void ReliableMessageMgr::ClearRetransTable(ReliableMessageContext * rc)
 {
     mRetransTable.ForEachActiveObject([&](auto * entry) {
@@ -33,6 +33,7 @@
 #include <messaging/ReliableMessageProtocolConfig.h>
 #include <system/SystemLayer.h>
 #include <system/SystemPacketBuffer.h>
+#include <transport/SessionManager.h>
 #include <transport/raw/MessageHeader.h>
 
 namespace chip {
@@ -44,7 +45,7 @@ using ExchangeHandle = ReferenceCountedHandle<ExchangeContext>;
 enum class SendMessageFlags : uint16_t;
 class ReliableMessageContext;
 
-class ReliableMessageMgr
+class ReliableMessageMgr : public SendBatchErrorDelegate
 {
 public:
     /**
@@ -67,13 +68,16 @@ public:
         System::Clock::Timestamp nextRetransTime; /**< A counter representing the next retransmission time for the message. */
         uint8_t sendCount;                        /**< The number of times we have tried to send this entry,
                                                        including both successfully and failure send. */
+#if CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+        System::Clock::Microseconds64 firstSendTime{ 0 }; /**< When the message was first sent, to measure the ack latency. */
+#endif
     };
 
 public:
     ReliableMessageMgr(BitMapObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & contextPool);
     ~ReliableMessageMgr();
 
-    void Init(chip::System::Layer * systemLayer);
+    void Init(chip::System::Layer * systemLayer, SessionManager * sessionManager = nullptr);
     void Shutdown();
 
     /**
@@ -162,6 +166,12 @@ public:
      */
     void StopTimer();
 
+    /**
+     * A message of the retrans table that failed to send as part of a send batch is handled as if it had failed
+     * to send right away.
+     */
+    void OnBatchedSendFailed(const System::PacketBufferHandle & message, CHIP_ERROR error) override;
+
 #if CHIP_CONFIG_TEST
     // Functions for testing
     int TestGetCountRetransTable();
@@ -170,6 +180,7 @@ public:
 private:
     BitMapObjectPool<ExchangeContext, CHIP_CONFIG_MAX_EXCHANGE_CONTEXTS> & mContextPool;
     chip::System::Layer * mSystemLayer;
+    SessionManager * mSessionManager = nullptr;
 
     /* Placeholder function to run a function for all exchanges */
     template <typename Function>
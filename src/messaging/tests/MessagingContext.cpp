@@ -20,9 +20,35 @@
 #include <lib/support/CodeUtils.h>
 #include <lib/support/ErrorStr.h>
 
+#include <string.h>
+
 namespace chip {
 namespace Test {
 
+namespace {
+
+constexpr uint16_t kFriendsKeySetId            = 0x0101;
+constexpr uint8_t kFriendsCompressedFabricId[] = { 0x87, 0xe1, 0xb0, 0x04, 0xe2, 0x35, 0xa1, 0x30 };
+constexpr uint8_t kFriendsEpochKey[] = { 0xd0, 0xd1, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xdb, 0xdc, 0xdd, 0xde, 0xdf };
+
+} // namespace
+
+CHIP_ERROR MessagingContext::InitGroups()
+{
+    using KeySet   = Credentials::GroupDataProvider::KeySet;
+    using GroupKey = Credentials::GroupDataProvider::GroupKey;
+
+    ReturnErrorOnFailure(mGroupsProvider.Init());
+    mPreviousGroupsProvider = Credentials::GetGroupDataProvider();
+    Credentials::SetGroupDataProvider(&mGroupsProvider);
+
+    KeySet keyset(kFriendsKeySetId, KeySet::SecurityPolicy::kStandard, 1);
+    keyset.epoch_keys[0].start_time = 1;
+    memcpy(keyset.epoch_keys[0].key, kFriendsEpochKey, sizeof(kFriendsEpochKey));
+    ReturnErrorOnFailure(mGroupsProvider.SetKeySet(mFriendsFabricIndex, ByteSpan(kFriendsCompressedFabricId), keyset));
+    return mGroupsProvider.SetGroupKeyAt(mFriendsFabricIndex, 0, GroupKey(mFriendsGroupId, kFriendsKeySetId));
+}
+
 CHIP_ERROR MessagingContext::Init(TransportMgrBase * transport, IOContext * ioContext)
 {
     VerifyOrReturnError(mInitialized == false, CHIP_ERROR_INTERNAL);
@@ -35,8 +61,10 @@ CHIP_ERROR MessagingContext::Init(TransportMgrBase * transport, IOContext * ioCo
 
     ReturnErrorOnFailure(mExchangeManager.Init(&mSessionManager));
     ReturnErrorOnFailure(mMessageCounterManager.Init(&mExchangeManager));
+    ReturnErrorOnFailure(InitGroups());
 
-    mSessionBobToFriends.Grab(mSessionManager.CreateGroupSession(GetBobKeyId(), GetFriendsGroupId(), GetFabricIndex()).Value());
+    mSessionBobToFriends.Grab(
+        mSessionManager.CreateGroupSession(GetBobKeyId(), GetFriendsGroupId(), GetFriendsFabricIndex()).Value());
 
     ReturnErrorOnFailure(mSessionManager.NewPairing(mSessionBobToAlice, Optional<Transport::PeerAddress>::Value(mAliceAddress),
                                                     GetAliceNodeId(), &mPairingBobToAlice, CryptoContext::SessionRole::kInitiator,
@@ -54,6 +82,14 @@ CHIP_ERROR MessagingContext::Shutdown()
 
     mExchangeManager.Shutdown();
     mSessionManager.Shutdown();
+
+    // Do not leave the global provider pointing at a finished (and soon destroyed) instance.
+    if (Credentials::GetGroupDataProvider() == &mGroupsProvider)
+    {
+        Credentials::SetGroupDataProvider(mPreviousGroupsProvider);
+    }
+    mPreviousGroupsProvider = nullptr;
+    mGroupsProvider.Finish();
     return CHIP_NO_ERROR;
 }
 
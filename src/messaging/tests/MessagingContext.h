@@ -16,6 +16,8 @@
  */
 #pragma once
 
+#include <credentials/GroupDataProviderImpl.h>
+#include <lib/support/TestPersistentStorageDelegate.h>
 #include <messaging/ExchangeContext.h>
 #include <messaging/ExchangeMgr.h>
 #include <protocols/secure_channel/MessageCounterManager.h>
@@ -40,7 +42,7 @@ public:
     MessagingContext() :
         mInitialized(false), mAliceAddress(Transport::PeerAddress::UDP(GetAddress(), CHIP_PORT + 1)),
         mBobAddress(Transport::PeerAddress::UDP(GetAddress(), CHIP_PORT)), mPairingAliceToBob(GetBobKeyId(), GetAliceKeyId()),
-        mPairingBobToAlice(GetAliceKeyId(), GetBobKeyId())
+        mPairingBobToAlice(GetAliceKeyId(), GetBobKeyId()), mGroupsProvider(mGroupsStorage)
     {}
     ~MessagingContext() { VerifyOrDie(mInitialized == false); }
 
@@ -73,6 +75,7 @@ public:
     uint16_t GetBobKeyId() const { return mBobKeyId; }
     uint16_t GetAliceKeyId() const { return mAliceKeyId; }
     GroupId GetFriendsGroupId() const { return mFriendsGroupId; }
+    FabricIndex GetFriendsFabricIndex() const { return mFriendsFabricIndex; }
 
     void SetBobKeyId(uint16_t id) { mBobKeyId = id; }
     void SetAliceKeyId(uint16_t id) { mAliceKeyId = id; }
@@ -101,6 +104,8 @@ public:
     System::Layer & GetSystemLayer() { return mIOContext->GetSystemLayer(); }
 
 private:
+    CHIP_ERROR InitGroups();
+
     bool mInitialized;
     SessionManager mSessionManager;
     Messaging::ExchangeManager mExchangeManager;
@@ -113,6 +118,8 @@ private:
     uint16_t mBobKeyId      = 1;
     uint16_t mAliceKeyId    = 2;
     GroupId mFriendsGroupId = 517;
+    // Group sessions need a valid fabric to look up the group keys
+    FabricIndex mFriendsFabricIndex = 1;
     Transport::PeerAddress mAliceAddress;
     Transport::PeerAddress mBobAddress;
     SecurePairingUsingTestSecret mPairingAliceToBob;
@@ -122,6 +129,10 @@ private:
     SessionHolder mSessionBobToFriends;
     FabricIndex mSrcFabricIndex  = 0;
     FabricIndex mDestFabricIndex = 0;
+    TestPersistentStorageDelegate mGroupsStorage;
+    Credentials::GroupDataProviderImpl mGroupsProvider;
+    // Global group data provider installed before InitGroups, restored on Shutdown.
+    Credentials::GroupDataProvider * mPreviousGroupsProvider = nullptr;
 };
 
 template <typename Transport = LoopbackTransport>
@@ -177,6 +188,8 @@ public:
 
     TransportMgrBase & GetTransportMgr() { return mTransportManager; }
 
+    Test::IOContext & GetIOContext() { return mIOContext; }
+
     /*
      * For unit-tests that simulate end-to-end transmission and reception of messages in loopback mode,
      * this mode better replicates a real-functioning stack that correctly handles the processing
@@ -78,6 +78,10 @@
 #define CHIP_CONFIG_MAX_PEER_NODES 16
 #endif // CHIP_CONFIG_MAX_PEER_NODES
 
+#ifndef CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS
+#define CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS 4
+#endif // CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS
+
 #ifndef CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS
 #define CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS 8
 #endif // CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS
@@ -119,3 +123,7 @@
 #ifndef CHIP_CONFIG_ENABLE_CASE_RESPONDER
 #define CHIP_CONFIG_ENABLE_CASE_RESPONDER 1
 #endif // CHIP_CONFIG_ENABLE_CASE_RESPONDER
+
+#ifndef CHIP_CONFIG_GROUP_DATA_CACHE_MAX_ENTRIES
+#define CHIP_CONFIG_GROUP_DATA_CACHE_MAX_ENTRIES 256
+#endif // CHIP_CONFIG_GROUP_DATA_CACHE_MAX_ENTRIES
@@ -0,0 +1,568 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *  Implements asynchronous log output for Linux.
+ *
+ *  Each logging thread owns a single-producer, single-consumer ring buffer of log records. A record holds the
+ *  timestamp, module and category of the message, a copy of its format string and its arguments as captured by
+ *  EncodeLogArgs(), so that the logging thread never formats the message nor touches stdout. The format is copied
+ *  since it may be built at runtime, in a buffer that is gone by the time the message is written out. The background thread
+ *  drains the buffers every CHIP_DEVICE_CONFIG_LOG_FLUSH_INTERVAL_MS, or as soon as one of them is half full, merging
+ *  the records of all the threads by timestamp and writing them out with a single flush per batch.
+ */
+
+#include <platform/Linux/AsyncLogSink.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceConfig.h>
+#include <platform/Linux/DeferredLogFormatter.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <inttypes.h>
+#include <mutex>
+#include <new>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+namespace {
+
+constexpr uint32_t kBufferSize = CHIP_DEVICE_CONFIG_LOG_BUFFER_SIZE;
+static_assert((kBufferSize & (kBufferSize - 1)) == 0, "CHIP_DEVICE_CONFIG_LOG_BUFFER_SIZE must be a power of two");
+
+// Longer messages are truncated.
+constexpr size_t kMaxMessageSize  = 512;
+constexpr uint32_t kRecordAlign   = 8;
+constexpr size_t kMaxPrefixSize   = 64;
+constexpr size_t kMaxLineSize     = kMaxPrefixSize + kMaxMessageSize;
+constexpr size_t kOutputSize      = 16384;
+constexpr auto kFlushInterval     = std::chrono::milliseconds(CHIP_DEVICE_CONFIG_LOG_FLUSH_INTERVAL_MS);
+constexpr uint8_t kModuleNameSize = Logging::kMaxModuleNameLen + 1;
+
+enum RecordFlags : uint8_t
+{
+    kRecordFlag_Padding      = 0x01, ///< Fills the end of the buffer; the next record starts at the beginning.
+    kRecordFlag_Preformatted = 0x02, ///< The payload is the formatted message rather than its format and arguments.
+};
+
+struct RecordHeader
+{
+    // Only the first kRecordPrefixSize bytes are written for padding records.
+    uint32_t mSize; ///< Size of the record, including the header and the alignment padding.
+    uint8_t mFlags;
+    uint8_t mCategory;
+    char mModule[kModuleNameSize];
+    uint32_t mThreadId;
+    uint32_t mPayloadLength;
+    uint64_t mTimestampUs;
+    uint32_t mFormatLength; ///< Length of the format at the start of the payload, including its null terminator.
+};
+
+constexpr uint32_t kRecordPrefixSize = kRecordAlign;
+static_assert(offsetof(RecordHeader, mFlags) < kRecordPrefixSize, "Padding records must fit in the alignment");
+static_assert(sizeof(RecordHeader) % kRecordAlign == 0, "Payloads must be aligned");
+static_assert(sizeof(RecordHeader) + kMaxMessageSize <= kBufferSize / 2, "CHIP_DEVICE_CONFIG_LOG_BUFFER_SIZE is too small");
+
+struct ThreadBuffer
+{
+    alignas(kRecordAlign) uint8_t mData[kBufferSize];
+
+    // mHead is only written by the owning thread and mTail only by the thread draining the buffer. Both are byte
+    // offsets that wrap around at 2^32, which is a multiple of the buffer size.
+    std::atomic<uint32_t> mHead{ 0 };
+    std::atomic<uint32_t> mTail{ 0 };
+    std::atomic<uint32_t> mDroppedCount{ 0 };
+    std::atomic<uint32_t> mThreadId{ 0 };
+    std::atomic<bool> mInUse{ true };
+    ThreadBuffer * mNext = nullptr;
+
+    // Only used by Drain(), under SinkState::mDrainLock.
+    uint32_t mDrainLimit = 0;
+
+    // Only used by the owning thread, to build the payload of a record: the format followed by the encoded arguments,
+    // or the formatted message.
+    uint8_t mScratch[kMaxMessageSize];
+};
+
+struct SinkState
+{
+    std::mutex mWakeLock;
+    std::condition_variable mWakeCondition;
+    bool mStopping = false;
+    std::thread mThread;
+
+    std::mutex mDrainLock;
+    char mOutput[kOutputSize];
+    size_t mOutputLength = 0;
+};
+
+enum class SinkStatus : uint8_t
+{
+    kUninitialized,
+    kRunning,
+    kUnavailable,
+};
+
+// All of these are constant-initialized, so that messages can be logged during static initialization and destruction.
+// The sink state and the thread buffers are never freed, since a message may be logged at any time until the process
+// exits; the buffers of exited threads are reused by new threads instead.
+std::atomic<SinkStatus> sStatus{ SinkStatus::kUninitialized };
+std::mutex sStartLock;
+SinkState * sSinkState = nullptr;
+std::atomic<ThreadBuffer *> sThreadBuffers{ nullptr };
+
+class ThreadBufferOwner
+{
+public:
+    ~ThreadBufferOwner()
+    {
+        if (mBuffer != nullptr)
+        {
+            mBuffer->mInUse.store(false, std::memory_order_release);
+            mBuffer = nullptr;
+        }
+    }
+
+    ThreadBuffer * mBuffer = nullptr;
+};
+
+thread_local ThreadBufferOwner tBufferOwner;
+
+ThreadBuffer * GetThreadBuffer()
+{
+    ThreadBuffer * buffer = tBufferOwner.mBuffer;
+    if (buffer != nullptr)
+    {
+        return buffer;
+    }
+
+    for (buffer = sThreadBuffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->mNext)
+    {
+        bool inUse = false;
+        if (buffer->mInUse.compare_exchange_strong(inUse, true, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            break;
+        }
+    }
+
+    if (buffer == nullptr)
+    {
+        buffer = new (std::nothrow) ThreadBuffer();
+        VerifyOrReturnError(buffer != nullptr, nullptr);
+
+        buffer->mNext = sThreadBuffers.load(std::memory_order_relaxed);
+        while (!sThreadBuffers.compare_exchange_weak(buffer->mNext, buffer, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    buffer->mThreadId.store(static_cast<uint32_t>(syscall(SYS_gettid)), std::memory_order_relaxed);
+    tBufferOwner.mBuffer = buffer;
+    return buffer;
+}
+
+uint64_t GetRealTimeMicroseconds()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000 + static_cast<uint64_t>(ts.tv_nsec) / 1000;
+}
+
+/**
+ * Append a record to the buffer of the calling thread, or count it as dropped if the buffer is full.
+ *
+ * @return Whether the buffer is more than half full, in which case it should be drained soon.
+ */
+bool Enqueue(ThreadBuffer & buffer, RecordHeader & header, const uint8_t * payload)
+{
+    header.mSize = (static_cast<uint32_t>(sizeof(header)) + header.mPayloadLength + kRecordAlign - 1) & ~(kRecordAlign - 1);
+
+    uint32_t head       = buffer.mHead.load(std::memory_order_relaxed);
+    uint32_t tail       = buffer.mTail.load(std::memory_order_acquire);
+    uint32_t offset     = head & (kBufferSize - 1);
+    uint32_t contiguous = kBufferSize - offset;
+    uint32_t needed     = header.mSize + ((header.mSize > contiguous) ? contiguous : 0);
+
+    if (kBufferSize - (head - tail) < needed)
+    {
+        buffer.mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    if (header.mSize > contiguous)
+    {
+        // Records are never split, so skip to the beginning of the buffer.
+        RecordHeader padding = {};
+        padding.mSize        = contiguous;
+        padding.mFlags       = kRecordFlag_Padding;
+        memcpy(&buffer.mData[offset], &padding, kRecordPrefixSize);
+        head += contiguous;
+        offset = 0;
+    }
+
+    memcpy(&buffer.mData[offset], &header, sizeof(header));
+    memcpy(&buffer.mData[offset + sizeof(header)], payload, header.mPayloadLength);
+    head += header.mSize;
+    buffer.mHead.store(head, std::memory_order_release);
+
+    return (head - tail) > kBufferSize / 2;
+}
+
+/**
+ * Read the header of the next record to drain from a buffer, skipping padding.
+ */
+bool PeekRecord(ThreadBuffer & buffer, RecordHeader & header)
+{
+    uint32_t tail = buffer.mTail.load(std::memory_order_relaxed);
+
+    while (tail != buffer.mDrainLimit)
+    {
+        uint32_t offset = tail & (kBufferSize - 1);
+        memcpy(&header, &buffer.mData[offset], kRecordPrefixSize);
+        if ((header.mFlags & kRecordFlag_Padding) == 0)
+        {
+            memcpy(&header, &buffer.mData[offset], sizeof(header));
+            return true;
+        }
+        tail += header.mSize;
+        buffer.mTail.store(tail, std::memory_order_release);
+    }
+
+    return false;
+}
+
+void FlushOutput(SinkState & state)
+{
+    if (state.mOutputLength > 0)
+    {
+        fwrite(state.mOutput, 1, state.mOutputLength, stdout);
+        fflush(stdout);
+        state.mOutputLength = 0;
+    }
+}
+
+/**
+ * Reserve space for a line of output, writing out what was buffered so far if needed.
+ */
+char * BeginLine(SinkState & state, uint64_t timestampUs, uint32_t threadId, const char * module)
+{
+    if (kOutputSize - state.mOutputLength < kMaxLineSize)
+    {
+        FlushOutput(state);
+    }
+
+    char * line = &state.mOutput[state.mOutputLength];
+    int length  = snprintf(line, kMaxPrefixSize, "[%" PRIu64 ".%06" PRIu64 "][%lld:%lld] CHIP:%s: ", timestampUs / 1000000,
+                          timestampUs % 1000000, static_cast<long long>(getpid()), static_cast<long long>(threadId), module);
+    state.mOutputLength += (length > 0) ? std::min(static_cast<size_t>(length), kMaxPrefixSize - 1) : 0;
+    return &state.mOutput[state.mOutputLength];
+}
+
+void EndLine(SinkState & state, size_t messageLength)
+{
+    state.mOutputLength += messageLength;
+    state.mOutput[state.mOutputLength++] = '\n';
+}
+
+void WriteRecord(SinkState & state, ThreadBuffer & buffer, const RecordHeader & header)
+{
+    const uint8_t * payload = &buffer.mData[(buffer.mTail.load(std::memory_order_relaxed) & (kBufferSize - 1)) + sizeof(header)];
+    char * message          = BeginLine(state, header.mTimestampUs, header.mThreadId, header.mModule);
+    size_t messageLength;
+
+    if (header.mFlags & kRecordFlag_Preformatted)
+    {
+        messageLength = header.mPayloadLength;
+        memcpy(message, payload, messageLength);
+    }
+    else
+    {
+        messageLength = FormatLogArgs(message, kMaxMessageSize, reinterpret_cast<const char *>(payload),
+                                      payload + header.mFormatLength, header.mPayloadLength - header.mFormatLength);
+    }
+
+    EndLine(state, messageLength);
+}
+
+void WriteDroppedCount(SinkState & state, ThreadBuffer & buffer, uint32_t droppedCount)
+{
+    char * message = BeginLine(state, GetRealTimeMicroseconds(), buffer.mThreadId.load(std::memory_order_relaxed), "LOG");
+    int length     = snprintf(message, kMaxMessageSize, "%" PRIu32 " messages dropped, log buffer full", droppedCount);
+    EndLine(state, (length > 0) ? std::min(static_cast<size_t>(length), kMaxMessageSize - 1) : 0);
+}
+
+void Drain(SinkState & state)
+{
+    std::lock_guard<std::mutex> lock(state.mDrainLock);
+
+    // Only drain what has been logged so far, so that busy threads cannot keep this going.
+    ThreadBuffer * buffers = sThreadBuffers.load(std::memory_order_acquire);
+    for (ThreadBuffer * buffer = buffers; buffer != nullptr; buffer = buffer->mNext)
+    {
+        buffer->mDrainLimit = buffer->mHead.load(std::memory_order_acquire);
+    }
+
+    for (;;)
+    {
+        ThreadBuffer * oldest = nullptr;
+        RecordHeader oldestHeader = {};
+        RecordHeader header;
+
+        for (ThreadBuffer * buffer = buffers; buffer != nullptr; buffer = buffer->mNext)
+        {
+            if (PeekRecord(*buffer, header) && (oldest == nullptr || header.mTimestampUs < oldestHeader.mTimestampUs))
+            {
+                oldest       = buffer;
+                oldestHeader = header;
+            }
+        }
+
+        if (oldest == nullptr)
+        {
+            break;
+        }
+
+        WriteRecord(state, *oldest, oldestHeader);
+        oldest->mTail.store(oldest->mTail.load(std::memory_order_relaxed) + oldestHeader.mSize, std::memory_order_release);
+    }
+
+    for (ThreadBuffer * buffer = buffers; buffer != nullptr; buffer = buffer->mNext)
+    {
+        uint32_t droppedCount = buffer->mDroppedCount.exchange(0, std::memory_order_relaxed);
+        if (droppedCount > 0)
+        {
+            WriteDroppedCount(state, *buffer, droppedCount);
+        }
+    }
+
+    FlushOutput(state);
+}
+
+void FlushThreadMain(SinkState * state)
+{
+    std::unique_lock<std::mutex> lock(state->mWakeLock);
+
+    while (!state->mStopping)
+    {
+        state->mWakeCondition.wait_for(lock, kFlushInterval);
+
+        lock.unlock();
+        Drain(*state);
+        lock.lock();
+    }
+}
+
+void Shutdown()
+{
+    // Messages logged from here on, e.g. by static destructors, are written out synchronously by the caller.
+    sStatus.store(SinkStatus::kUnavailable, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> lock(sSinkState->mWakeLock);
+        sSinkState->mStopping = true;
+    }
+    sSinkState->mWakeCondition.notify_one();
+    sSinkState->mThread.join();
+
+    Drain(*sSinkState);
+}
+
+SinkState * Start()
+{
+    std::lock_guard<std::mutex> lock(sStartLock);
+
+    SinkStatus status = sStatus.load(std::memory_order_acquire);
+    if (status == SinkStatus::kUninitialized)
+    {
+        status = SinkStatus::kUnavailable;
+
+        if (getenv("CHIP_LOG_SYNC") == nullptr && (sSinkState = new (std::nothrow) SinkState()) != nullptr)
+        {
+            sSinkState->mThread = std::thread(FlushThreadMain, sSinkState);
+            atexit(Shutdown);
+            status = SinkStatus::kRunning;
+        }
+
+        sStatus.store(status, std::memory_order_release);
+    }
+
+    return (status == SinkStatus::kRunning) ? sSinkState : nullptr;
+}
+
+SinkState * GetSinkState()
+{
+    SinkStatus status = sStatus.load(std::memory_order_acquire);
+    if (status == SinkStatus::kRunning)
+    {
+        return sSinkState;
+    }
+    return (status == SinkStatus::kUninitialized) ? Start() : nullptr;
+}
+
+} // namespace
+
+uint32_t LogRateLimiter::MakeKey(const char * module, uint8_t category)
+{
+    uint32_t key = 0x80000000u | (static_cast<uint32_t>(category & 0x7f) << 24);
+    for (uint8_t i = 0; i < Logging::kMaxModuleNameLen && module[i] != '\0'; i++)
+    {
+        key |= static_cast<uint32_t>(static_cast<uint8_t>(module[i])) << (8 * i);
+    }
+    return key;
+}
+
+LogRateLimiter::Slot * LogRateLimiter::FindSlot(uint32_t key)
+{
+    size_t index = (key * 2654435761u) >> 24;
+
+    for (size_t i = 0; i < kNumSlots; i++)
+    {
+        Slot & slot      = mSlots[(index + i) % kNumSlots];
+        uint32_t slotKey = slot.mKey.load(std::memory_order_relaxed);
+        if (slotKey == 0 && slot.mKey.compare_exchange_strong(slotKey, key, std::memory_order_relaxed))
+        {
+            return &slot;
+        }
+        if (slotKey == key)
+        {
+            return &slot;
+        }
+    }
+
+    return nullptr;
+}
+
+bool LogRateLimiter::Allow(const char * module, uint8_t category, uint64_t nowMs, uint32_t & suppressedCount)
+{
+    suppressedCount = 0;
+
+    // Tools and test scripts parse progress and automation messages, dropping any of them would break them.
+    if (mMaxMessagesPerWindow == 0 || category == Logging::kLogCategory_Error || category == Logging::kLogCategory_Progress ||
+        category == Logging::kLogCategory_Automation)
+    {
+        return true;
+    }
+
+    Slot * slot = FindSlot(MakeKey(module, category));
+    if (slot == nullptr)
+    {
+        return true;
+    }
+
+    // The first message of a window starts a new count and reports what was suppressed in the previous one. Updates
+    // racing with this may be counted in either window, which does not matter for a rate limit.
+    uint32_t window     = static_cast<uint32_t>(nowMs / kWindowMs);
+    uint32_t slotWindow = slot->mWindow.load(std::memory_order_relaxed);
+    if (slotWindow != window && slot->mWindow.compare_exchange_strong(slotWindow, window, std::memory_order_relaxed))
+    {
+        slot->mCount.store(0, std::memory_order_relaxed);
+        suppressedCount = slot->mSuppressedCount.exchange(0, std::memory_order_relaxed);
+    }
+
+    if (slot->mCount.fetch_add(1, std::memory_order_relaxed) < mMaxMessagesPerWindow)
+    {
+        return true;
+    }
+
+    slot->mSuppressedCount.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool AsyncLogV(const char * module, uint8_t category, const char * msg, va_list v)
+{
+    SinkState * state = GetSinkState();
+    VerifyOrReturnError(state != nullptr, false);
+
+    ThreadBuffer * buffer = GetThreadBuffer();
+    VerifyOrReturnError(buffer != nullptr, false);
+
+    RecordHeader header = {};
+    header.mCategory    = category;
+    header.mThreadId    = buffer->mThreadId.load(std::memory_order_relaxed);
+    header.mTimestampUs = GetRealTimeMicroseconds();
+    strncpy(header.mModule, module, kModuleNameSize - 1);
+
+    va_list args;
+    int payloadLength   = -1;
+    size_t formatLength = strlen(msg) + 1;
+    if (formatLength < sizeof(buffer->mScratch))
+    {
+        memcpy(buffer->mScratch, msg, formatLength);
+
+        va_copy(args, v);
+        int argsLength = EncodeLogArgs(&buffer->mScratch[formatLength], sizeof(buffer->mScratch) - formatLength, msg, args);
+        va_end(args);
+
+        if (argsLength >= 0)
+        {
+            header.mFormatLength = static_cast<uint32_t>(formatLength);
+            payloadLength        = static_cast<int>(formatLength) + argsLength;
+        }
+    }
+
+    if (payloadLength < 0)
+    {
+        // The message cannot be deferred, so format it now.
+        va_copy(args, v);
+        payloadLength = vsnprintf(reinterpret_cast<char *>(buffer->mScratch), sizeof(buffer->mScratch), msg, args);
+        va_end(args);
+
+        header.mFlags = kRecordFlag_Preformatted;
+        payloadLength = (payloadLength < 0) ? 0 : std::min(payloadLength, static_cast<int>(sizeof(buffer->mScratch) - 1));
+    }
+    header.mPayloadLength = static_cast<uint32_t>(payloadLength);
+
+    bool needsDrain = Enqueue(*buffer, header, buffer->mScratch);
+
+    // Errors are written out before returning, since the process may abort right after, e.g. in VerifyOrDie().
+    if (category == Logging::kLogCategory_Error)
+    {
+        Drain(*state);
+    }
+    else if (needsDrain)
+    {
+        state->mWakeCondition.notify_one();
+    }
+
+    return true;
+}
+
+void FlushAsyncLog()
+{
+    SinkState * state = GetSinkState();
+    if (state != nullptr)
+    {
+        Drain(*state);
+    }
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
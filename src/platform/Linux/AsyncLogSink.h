@@ -0,0 +1,102 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *  Asynchronous log output for Linux: messages are queued in per-thread buffers by the logging thread and written
+ *  to stdout by a background thread.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+/**
+ * Limits the number of log messages per module and category over fixed one second windows. Error, progress and
+ * automation messages are never limited.
+ *
+ * The state is a fixed-size table updated with atomic operations only, so Allow() may be called concurrently from any
+ * thread. If the table fills up, messages of the modules and categories that do not fit are not limited.
+ */
+class LogRateLimiter
+{
+public:
+    static constexpr uint64_t kWindowMs = 1000;
+
+    /**
+     * @param[in] maxMessagesPerWindow  The number of messages allowed per window for each module and category, or 0
+     *                                  to allow all messages.
+     */
+    explicit LogRateLimiter(uint32_t maxMessagesPerWindow) : mMaxMessagesPerWindow(maxMessagesPerWindow) {}
+
+    /**
+     * Account for a message and decide whether it should be logged.
+     *
+     * @param[in]  module           The name of the module logging the message.
+     * @param[in]  category         The category of the message.
+     * @param[in]  nowMs            The current monotonic time, in milliseconds.
+     * @param[out] suppressedCount  The number of messages of the same module and category that were dropped during the
+     *                              previous window, to be reported by the caller; 0 if none or if already reported.
+     *
+     * @return Whether the message should be logged.
+     */
+    bool Allow(const char * module, uint8_t category, uint64_t nowMs, uint32_t & suppressedCount);
+
+private:
+    static constexpr size_t kNumSlots = 256;
+
+    struct Slot
+    {
+        std::atomic<uint32_t> mKey{ 0 };
+        std::atomic<uint32_t> mWindow{ 0 };
+        std::atomic<uint32_t> mCount{ 0 };
+        std::atomic<uint32_t> mSuppressedCount{ 0 };
+    };
+
+    static uint32_t MakeKey(const char * module, uint8_t category);
+    Slot * FindSlot(uint32_t key);
+
+    const uint32_t mMaxMessagesPerWindow;
+    Slot mSlots[kNumSlots];
+};
+
+/**
+ * Queue a log message for output by the background log thread, which is started on first use.
+ *
+ * Error messages are written out before this returns, so that they are not lost if the process aborts right after.
+ *
+ * @return false, without having used the arguments, if asynchronous output is not available (it is disabled by the
+ *         CHIP_LOG_SYNC environment variable, could not be started, or has been shut down at exit), in which case the
+ *         caller should write the message itself.
+ */
+bool AsyncLogV(const char * module, uint8_t category, const char * msg, va_list v);
+
+/**
+ * Write out all the messages queued so far.
+ */
+void FlushAsyncLog();
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
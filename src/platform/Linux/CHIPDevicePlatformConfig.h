@@ -80,6 +80,73 @@
 #define CHIP_DEVICE_CONFIG_THREAD_TASK_STACK_SIZE 8192
 #endif // CHIP_DEVICE_CONFIG_THREAD_TASK_STACK_SIZE
 
+#ifndef CHIP_DEVICE_CONFIG_CRYPTO_OFFLOAD_THREADS
+#define CHIP_DEVICE_CONFIG_CRYPTO_OFFLOAD_THREADS 2
+#endif // CHIP_DEVICE_CONFIG_CRYPTO_OFFLOAD_THREADS
+
+/**
+ * @def CHIP_DEVICE_CONFIG_LOG_ASYNC
+ *
+ * Whether log messages are queued in per-thread buffers and written out by a background thread, rather than on the
+ * logging thread. Error messages still reach the output before the logging call returns, but other messages logged
+ * shortly before a crash may be lost, so this is off by default. Setting the CHIP_LOG_SYNC environment variable
+ * disables this at runtime.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LOG_ASYNC
+#define CHIP_DEVICE_CONFIG_LOG_ASYNC 0
+#endif // CHIP_DEVICE_CONFIG_LOG_ASYNC
+
+/**
+ * @def CHIP_DEVICE_CONFIG_LOG_BUFFER_SIZE
+ *
+ * The size, in bytes, of the log buffer of each thread when CHIP_DEVICE_CONFIG_LOG_ASYNC is set. Must be a power of
+ * two. Messages logged while the buffer is full are dropped and counted.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LOG_BUFFER_SIZE
+#define CHIP_DEVICE_CONFIG_LOG_BUFFER_SIZE 65536
+#endif // CHIP_DEVICE_CONFIG_LOG_BUFFER_SIZE
+
+/**
+ * @def CHIP_DEVICE_CONFIG_LOG_FLUSH_INTERVAL_MS
+ *
+ * The longest time, in milliseconds, that a log message stays queued when CHIP_DEVICE_CONFIG_LOG_ASYNC is set.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LOG_FLUSH_INTERVAL_MS
+#define CHIP_DEVICE_CONFIG_LOG_FLUSH_INTERVAL_MS 20
+#endif // CHIP_DEVICE_CONFIG_LOG_FLUSH_INTERVAL_MS
+
+/**
+ * @def CHIP_DEVICE_CONFIG_LOG_RATE_LIMIT
+ *
+ * The maximum number of messages logged per second for each module and category; the excess is dropped and counted.
+ * Only detail messages are limited: error, progress and automation messages are always logged. 0, the default,
+ * disables rate limiting.
+ */
+#ifndef CHIP_DEVICE_CONFIG_LOG_RATE_LIMIT
+#define CHIP_DEVICE_CONFIG_LOG_RATE_LIMIT 0
+#endif // CHIP_DEVICE_CONFIG_LOG_RATE_LIMIT
+
+/**
+ * @def CHIP_DEVICE_CONFIG_DIAGNOSTICS_SAMPLE_INTERVAL_MS
+ *
+ * The interval, in milliseconds, at which a background thread samples the network counters and thread list served by
+ * the diagnostics clusters. Link and address changes are picked up from netlink as soon as they happen. 0 disables the
+ * background thread, so that every read samples the system directly.
+ */
+#ifndef CHIP_DEVICE_CONFIG_DIAGNOSTICS_SAMPLE_INTERVAL_MS
+#define CHIP_DEVICE_CONFIG_DIAGNOSTICS_SAMPLE_INTERVAL_MS 5000
+#endif // CHIP_DEVICE_CONFIG_DIAGNOSTICS_SAMPLE_INTERVAL_MS
+
+/**
+ * @def CHIP_DEVICE_CONFIG_DIAGNOSTICS_MAX_THREADS
+ *
+ * The maximum number of threads of the process reported by the software diagnostics cluster. The threads beyond it are
+ * left out of the thread metrics, which is logged whenever it starts happening.
+ */
+#ifndef CHIP_DEVICE_CONFIG_DIAGNOSTICS_MAX_THREADS
+#define CHIP_DEVICE_CONFIG_DIAGNOSTICS_MAX_THREADS 64
+#endif // CHIP_DEVICE_CONFIG_DIAGNOSTICS_MAX_THREADS
+
 #define CHIP_DEVICE_CONFIG_ENABLE_WIFI_TELEMETRY 0
 #define CHIP_DEVICE_CONFIG_ENABLE_THREAD_TELEMETRY 0
 #define CHIP_DEVICE_CONFIG_ENABLE_THREAD_TELEMETRY_FULL 0
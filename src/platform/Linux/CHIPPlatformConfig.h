@@ -82,6 +82,10 @@ using CHIP_CONFIG_PERSISTED_STORAGE_KEY_TYPE = const char *;
 #define CHIP_CONFIG_MAX_PEER_NODES 16
 #endif // CHIP_CONFIG_MAX_PEER_NODES
 
+#ifndef CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS
+#define CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS 4
+#endif // CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS
+
 #ifndef CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS
 #define CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS 8
 #endif // CHIP_CONFIG_MAX_UNSOLICITED_MESSAGE_HANDLERS
@@ -98,6 +102,10 @@ using CHIP_CONFIG_PERSISTED_STORAGE_KEY_TYPE = const char *;
 #define CHIP_CONFIG_MAX_CHANNEL_HANDLES 32
 #endif // CHIP_CONFIG_MAX_CHANNEL_HANDLES
 
+#ifndef CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+#define CHIP_CONFIG_PERSIST_SUBSCRIPTIONS 1
+#endif // CHIP_CONFIG_PERSIST_SUBSCRIPTIONS
+
 #ifndef CHIP_LOG_FILTERING
 #define CHIP_LOG_FILTERING 0
 #endif // CHIP_LOG_FILTERING
@@ -120,6 +128,10 @@ using CHIP_CONFIG_PERSISTED_STORAGE_KEY_TYPE = const char *;
 #define CHIP_CONFIG_ENABLE_CASE_RESPONDER 1
 #endif // CHIP_CONFIG_ENABLE_CASE_RESPONDER
 
+#ifndef CHIP_CONFIG_GROUP_DATA_CACHE_MAX_ENTRIES
+#define CHIP_CONFIG_GROUP_DATA_CACHE_MAX_ENTRIES 256
+#endif // CHIP_CONFIG_GROUP_DATA_CACHE_MAX_ENTRIES
+
 #ifndef CHIP_CONFIG_KVS_PATH
 #define CHIP_CONFIG_KVS_PATH "/tmp/chip_kvs"
 #endif // CHIP_CONFIG_KVS_PATH
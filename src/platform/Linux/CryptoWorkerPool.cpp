@@ -0,0 +1,165 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Implements a pool of worker threads running crypto jobs for Linux platforms.
+ */
+
+#include <platform/internal/CHIPDeviceLayerInternal.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/Linux/CryptoWorkerPool.h>
+#include <platform/PlatformManager.h>
+
+#if CHIP_DEVICE_CONFIG_CRYPTO_OFFLOAD_THREADS > 0
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+CHIP_ERROR CryptoWorkerPool::Init()
+{
+    VerifyOrReturnError(!mRunning, CHIP_ERROR_INCORRECT_STATE);
+
+    mRunning = true;
+    for (std::thread & worker : mWorkers)
+    {
+        worker = std::thread(&CryptoWorkerPool::WorkerMain, this);
+    }
+
+    ChipLogProgress(DeviceLayer, "Started %u crypto worker threads",
+                    static_cast<unsigned>(CHIP_DEVICE_CONFIG_CRYPTO_OFFLOAD_THREADS));
+    return CHIP_NO_ERROR;
+}
+
+void CryptoWorkerPool::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        VerifyOrReturn(mRunning);
+        mRunning = false;
+    }
+    mJobAvailable.notify_all();
+
+    // Workers run the jobs still queued before exiting.
+    for (std::thread & worker : mWorkers)
+    {
+        worker.join();
+    }
+
+    CompleteAbandonedJobs(CHIP_ERROR_INCORRECT_STATE);
+}
+
+CHIP_ERROR CryptoWorkerPool::Post(Crypto::CryptoJob & job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        VerifyOrReturnError(mRunning, CHIP_ERROR_INCORRECT_STATE);
+
+        NextJob(job) = nullptr;
+        if (mLastJob == nullptr)
+        {
+            mFirstJob = &job;
+        }
+        else
+        {
+            NextJob(*mLastJob) = &job;
+        }
+        mLastJob = &job;
+    }
+    mJobAvailable.notify_one();
+
+    return CHIP_NO_ERROR;
+}
+
+void CryptoWorkerPool::WorkerMain()
+{
+    for (;;)
+    {
+        Crypto::CryptoJob * job;
+        {
+            std::unique_lock<std::mutex> lock(mLock);
+            mJobAvailable.wait(lock, [this] { return mFirstJob != nullptr || !mRunning; });
+            if (mFirstJob == nullptr)
+            {
+                return;
+            }
+
+            job       = mFirstJob;
+            mFirstJob = NextJob(*job);
+            if (mFirstJob == nullptr)
+            {
+                mLastJob = nullptr;
+            }
+        }
+
+        job->Run();
+
+        ChipDeviceEvent event;
+        event.Type                    = DeviceEventType::kCallWorkFunct;
+        event.CallWorkFunct.WorkFunct = CompleteJob;
+        event.CallWorkFunct.Arg       = reinterpret_cast<intptr_t>(job);
+
+        CHIP_ERROR err = PlatformMgr().PostEvent(&event);
+        if (err != CHIP_NO_ERROR)
+        {
+            ChipLogError(DeviceLayer, "Failed to post crypto job completion: %" CHIP_ERROR_FORMAT, err.Format());
+            {
+                std::lock_guard<std::mutex> lock(mLock);
+                NextJob(*job)  = mAbandonedJobs;
+                mAbandonedJobs = job;
+            }
+
+            // Waiting for the stack lock could deadlock with Shutdown() joining this thread.
+            if (PlatformMgr().TryLockChipStack())
+            {
+                CompleteAbandonedJobs(err);
+                PlatformMgr().UnlockChipStack();
+            }
+        }
+    }
+}
+
+void CryptoWorkerPool::CompleteAbandonedJobs(CHIP_ERROR error)
+{
+    Crypto::CryptoJob * job;
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        job            = mAbandonedJobs;
+        mAbandonedJobs = nullptr;
+    }
+
+    while (job != nullptr)
+    {
+        Crypto::CryptoJob * next = NextJob(*job);
+        job->OnCompletionError(error);
+        job = next;
+    }
+}
+
+void CryptoWorkerPool::CompleteJob(intptr_t arg)
+{
+    reinterpret_cast<Crypto::CryptoJob *>(arg)->OnComplete();
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
+
+#endif // CHIP_DEVICE_CONFIG_CRYPTO_OFFLOAD_THREADS > 0
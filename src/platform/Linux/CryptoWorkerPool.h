@@ -0,0 +1,70 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Provides a pool of worker threads running crypto jobs for Linux platforms.
+ */
+
+#pragma once
+
+#include <crypto/CryptoJobQueue.h>
+#include <platform/CHIPDeviceConfig.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if CHIP_DEVICE_CONFIG_CRYPTO_OFFLOAD_THREADS > 0
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+/**
+ * Runs crypto jobs on CHIP_DEVICE_CONFIG_CRYPTO_OFFLOAD_THREADS worker threads, and completes them on the
+ * CHIP thread through a kCallWorkFunct event. A job whose event can't be posted is completed with an error
+ * instead, by its worker if the stack lock is free, or else by Shutdown().
+ */
+class CryptoWorkerPool : public Crypto::CryptoJobQueue
+{
+public:
+    CHIP_ERROR Init();
+    void Shutdown();
+
+    CHIP_ERROR Post(Crypto::CryptoJob & job) override;
+
+private:
+    void WorkerMain();
+    void CompleteAbandonedJobs(CHIP_ERROR error);
+    static void CompleteJob(intptr_t arg);
+
+    std::thread mWorkers[CHIP_DEVICE_CONFIG_CRYPTO_OFFLOAD_THREADS];
+    std::mutex mLock;
+    std::condition_variable mJobAvailable;
+    Crypto::CryptoJob * mFirstJob = nullptr;
+    Crypto::CryptoJob * mLastJob  = nullptr;
+    // Jobs that ran but could not be handed back to the CHIP thread.
+    Crypto::CryptoJob * mAbandonedJobs = nullptr;
+    bool mRunning                      = false;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
+
+#endif // CHIP_DEVICE_CONFIG_CRYPTO_OFFLOAD_THREADS > 0
@@ -0,0 +1,544 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *  Implements deferred formatting of printf-style log messages.
+ *
+ *  The encoded arguments are the values of the arguments consumed by each conversion, in order, copied with their
+ *  promoted C types. Strings are stored as a 32-bit length followed by the (null-terminated) characters, truncated to
+ *  the precision of the conversion if it has one.
+ */
+
+#include <platform/Linux/DeferredLogFormatter.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+namespace {
+
+enum class ArgKind : uint8_t
+{
+    kNone, // %%
+    kInt,
+    kLong,
+    kLongLong,
+    kIntMax,
+    kSize,
+    kPtrDiff,
+    kDouble,
+    kLongDouble,
+    kPointer,
+    kString,
+    kUnsupported,
+};
+
+enum class Length : uint8_t
+{
+    kDefault,
+    kChar,
+    kShort,
+    kLong,
+    kLongLong,
+    kIntMax,
+    kSize,
+    kPtrDiff,
+    kLongDouble,
+};
+
+// Long enough for any sensible conversion specification, e.g. "%-#0*.*llx".
+constexpr size_t kMaxSpecLength = 32;
+
+struct ConversionSpec
+{
+    size_t mLength;        ///< Length of the specification, from the '%' to the conversion character.
+    uint8_t mStarCount;    ///< Number of '*' width and precision arguments.
+    bool mPrecisionIsStar; ///< Whether the last '*' argument is the precision.
+    int mPrecision;        ///< The literal precision, or -1.
+    ArgKind mKind;
+};
+
+bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+ArgKind IntegerKind(Length length)
+{
+    switch (length)
+    {
+    case Length::kDefault:
+    case Length::kChar:
+    case Length::kShort:
+        return ArgKind::kInt;
+    case Length::kLong:
+        return ArgKind::kLong;
+    case Length::kLongLong:
+        return ArgKind::kLongLong;
+    case Length::kIntMax:
+        return ArgKind::kIntMax;
+    case Length::kSize:
+        return ArgKind::kSize;
+    case Length::kPtrDiff:
+        return ArgKind::kPtrDiff;
+    case Length::kLongDouble:
+        break;
+    }
+    return ArgKind::kUnsupported;
+}
+
+/**
+ * Parse the conversion specification that starts at the '%' pointed to by format.
+ */
+void ParseSpec(const char * format, ConversionSpec & spec)
+{
+    const char * p        = format + 1;
+    spec.mStarCount       = 0;
+    spec.mPrecisionIsStar = false;
+    spec.mPrecision       = -1;
+    spec.mKind            = ArgKind::kUnsupported;
+
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0' || *p == '\'')
+    {
+        p++;
+    }
+
+    if (*p == '*')
+    {
+        spec.mStarCount++;
+        p++;
+    }
+    else
+    {
+        while (IsDigit(*p))
+        {
+            p++;
+        }
+        if (*p == '$')
+        {
+            // Positional arguments are not supported.
+            spec.mLength = static_cast<size_t>(p - format);
+            return;
+        }
+    }
+
+    if (*p == '.')
+    {
+        p++;
+        if (*p == '*')
+        {
+            spec.mStarCount++;
+            spec.mPrecisionIsStar = true;
+            p++;
+        }
+        else
+        {
+            spec.mPrecision = 0;
+            while (IsDigit(*p))
+            {
+                spec.mPrecision = spec.mPrecision * 10 + (*p - '0');
+                p++;
+            }
+        }
+    }
+
+    Length length = Length::kDefault;
+    switch (*p)
+    {
+    case 'h':
+        length = (p[1] == 'h') ? Length::kChar : Length::kShort;
+        p += (p[1] == 'h') ? 2 : 1;
+        break;
+    case 'l':
+        length = (p[1] == 'l') ? Length::kLongLong : Length::kLong;
+        p += (p[1] == 'l') ? 2 : 1;
+        break;
+    case 'q':
+        length = Length::kLongLong;
+        p++;
+        break;
+    case 'j':
+        length = Length::kIntMax;
+        p++;
+        break;
+    case 'z':
+        length = Length::kSize;
+        p++;
+        break;
+    case 't':
+        length = Length::kPtrDiff;
+        p++;
+        break;
+    case 'L':
+        length = Length::kLongDouble;
+        p++;
+        break;
+    default:
+        break;
+    }
+
+    const char conversion = *p;
+    if (conversion == '\0')
+    {
+        spec.mLength = static_cast<size_t>(p - format);
+        return;
+    }
+    spec.mLength = static_cast<size_t>(p + 1 - format);
+
+    switch (conversion)
+    {
+    case '%':
+        spec.mKind = (spec.mLength == 2) ? ArgKind::kNone : ArgKind::kUnsupported;
+        break;
+    case 'd':
+    case 'i':
+    case 'o':
+    case 'u':
+    case 'x':
+    case 'X':
+        spec.mKind = IntegerKind(length);
+        break;
+    case 'c':
+        spec.mKind = (length == Length::kDefault) ? ArgKind::kInt : ArgKind::kUnsupported;
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        spec.mKind = (length == Length::kLongDouble) ? ArgKind::kLongDouble
+                                                       : ((length == Length::kDefault) ? ArgKind::kDouble : ArgKind::kUnsupported);
+        break;
+    case 'p':
+        spec.mKind = (length == Length::kDefault) ? ArgKind::kPointer : ArgKind::kUnsupported;
+        break;
+    case 's':
+        spec.mKind = (length == Length::kDefault) ? ArgKind::kString : ArgKind::kUnsupported;
+        break;
+    default:
+        // %n, %m and wide characters cannot be deferred.
+        break;
+    }
+
+    if (spec.mLength >= kMaxSpecLength)
+    {
+        spec.mKind = ArgKind::kUnsupported;
+    }
+}
+
+class ArgWriter
+{
+public:
+    ArgWriter(uint8_t * buffer, size_t size) : mBuffer(buffer), mSize(size) {}
+
+    template <typename T>
+    void Put(T value)
+    {
+        PutBytes(&value, sizeof(value));
+    }
+
+    void PutString(const char * str, int precision)
+    {
+        if (str == nullptr)
+        {
+            // Matches glibc, which would not have dereferenced it either.
+            str = "(null)";
+        }
+        size_t length = (precision >= 0) ? strnlen(str, static_cast<size_t>(precision)) : strlen(str);
+        if (length > UINT32_MAX)
+        {
+            mOk = false;
+            return;
+        }
+        Put(static_cast<uint32_t>(length));
+        PutBytes(str, length);
+        Put('\0');
+    }
+
+    bool IsOk() const { return mOk; }
+    size_t GetLength() const { return mLength; }
+
+private:
+    void PutBytes(const void * data, size_t size)
+    {
+        if (!mOk || size > mSize - mLength)
+        {
+            mOk = false;
+            return;
+        }
+        memcpy(mBuffer + mLength, data, size);
+        mLength += size;
+    }
+
+    uint8_t * mBuffer;
+    size_t mSize;
+    size_t mLength = 0;
+    bool mOk       = true;
+};
+
+class ArgReader
+{
+public:
+    ArgReader(const uint8_t * buffer, size_t size) : mBuffer(buffer), mSize(size) {}
+
+    template <typename T>
+    bool Get(T & value)
+    {
+        if (sizeof(value) > mSize - mOffset)
+        {
+            return false;
+        }
+        memcpy(&value, mBuffer + mOffset, sizeof(value));
+        mOffset += sizeof(value);
+        return true;
+    }
+
+    bool GetString(const char *& str)
+    {
+        uint32_t length;
+        if (!Get(length) || static_cast<size_t>(length) + 1 > mSize - mOffset)
+        {
+            return false;
+        }
+        str = reinterpret_cast<const char *>(mBuffer + mOffset);
+        mOffset += static_cast<size_t>(length) + 1;
+        return true;
+    }
+
+private:
+    const uint8_t * mBuffer;
+    size_t mSize;
+    size_t mOffset = 0;
+};
+
+template <typename T>
+int FormatValue(char * out, size_t outSize, const char * spec, const int * stars, uint8_t starCount, T value)
+{
+    switch (starCount)
+    {
+    case 0:
+        return snprintf(out, outSize, spec, value);
+    case 1:
+        return snprintf(out, outSize, spec, stars[0], value);
+    default:
+        return snprintf(out, outSize, spec, stars[0], stars[1], value);
+    }
+}
+
+template <typename T>
+int FormatArg(ArgReader & reader, char * out, size_t outSize, const char * spec, const int * stars, uint8_t starCount)
+{
+    T value;
+    if (!reader.Get(value))
+    {
+        return -1;
+    }
+    return FormatValue(out, outSize, spec, stars, starCount, value);
+}
+
+} // namespace
+
+int EncodeLogArgs(uint8_t * buffer, size_t bufferSize, const char * format, va_list args)
+{
+    ArgWriter writer(buffer, bufferSize);
+
+    for (const char * p = strchr(format, '%'); p != nullptr; p = strchr(p, '%'))
+    {
+        ConversionSpec spec;
+        ParseSpec(p, spec);
+        p += spec.mLength;
+
+        if (spec.mKind == ArgKind::kUnsupported)
+        {
+            return -1;
+        }
+
+        int precision = spec.mPrecision;
+        for (uint8_t i = 0; i < spec.mStarCount; i++)
+        {
+            int star = va_arg(args, int);
+            writer.Put(star);
+            if (spec.mPrecisionIsStar && i == spec.mStarCount - 1)
+            {
+                precision = star;
+            }
+        }
+
+        switch (spec.mKind)
+        {
+        case ArgKind::kNone:
+            break;
+        case ArgKind::kInt:
+            writer.Put(va_arg(args, int));
+            break;
+        case ArgKind::kLong:
+            writer.Put(va_arg(args, long));
+            break;
+        case ArgKind::kLongLong:
+            writer.Put(va_arg(args, long long));
+            break;
+        case ArgKind::kIntMax:
+            writer.Put(va_arg(args, intmax_t));
+            break;
+        case ArgKind::kSize:
+            writer.Put(va_arg(args, size_t));
+            break;
+        case ArgKind::kPtrDiff:
+            writer.Put(va_arg(args, ptrdiff_t));
+            break;
+        case ArgKind::kDouble:
+            writer.Put(va_arg(args, double));
+            break;
+        case ArgKind::kLongDouble:
+            writer.Put(va_arg(args, long double));
+            break;
+        case ArgKind::kPointer:
+            writer.Put(va_arg(args, void *));
+            break;
+        case ArgKind::kString:
+            writer.PutString(va_arg(args, const char *), precision);
+            break;
+        case ArgKind::kUnsupported:
+            return -1;
+        }
+
+        if (!writer.IsOk())
+        {
+            return -1;
+        }
+    }
+
+    return static_cast<int>(writer.GetLength());
+}
+
+size_t FormatLogArgs(char * out, size_t outSize, const char * format, const uint8_t * encodedArgs, size_t encodedArgsLength)
+{
+    if (outSize == 0)
+    {
+        return 0;
+    }
+
+    ArgReader reader(encodedArgs, encodedArgsLength);
+    size_t length = 0;
+    out[0]        = '\0';
+
+    const char * p = format;
+    while (*p != '\0' && length < outSize - 1)
+    {
+        const char * percent = strchr(p, '%');
+        size_t literalLength = (percent != nullptr) ? static_cast<size_t>(percent - p) : strlen(p);
+        size_t copyLength    = (literalLength < outSize - 1 - length) ? literalLength : outSize - 1 - length;
+        memcpy(out + length, p, copyLength);
+        length += copyLength;
+        out[length] = '\0';
+        if (percent == nullptr || copyLength < literalLength)
+        {
+            break;
+        }
+
+        ConversionSpec spec;
+        ParseSpec(percent, spec);
+        p = percent + spec.mLength;
+
+        if (spec.mKind == ArgKind::kUnsupported)
+        {
+            // EncodeLogArgs() would have rejected the format.
+            break;
+        }
+
+        char specString[kMaxSpecLength];
+        memcpy(specString, percent, spec.mLength);
+        specString[spec.mLength] = '\0';
+
+        int stars[2] = { 0, 0 };
+        bool ok      = true;
+        for (uint8_t i = 0; i < spec.mStarCount; i++)
+        {
+            ok = ok && reader.Get(stars[i]);
+        }
+        if (!ok)
+        {
+            break;
+        }
+
+        char * dest     = out + length;
+        size_t destSize = outSize - length;
+        int written     = 0;
+        switch (spec.mKind)
+        {
+        case ArgKind::kNone:
+            written = snprintf(dest, destSize, "%%");
+            break;
+        case ArgKind::kInt:
+            written = FormatArg<int>(reader, dest, destSize, specString, stars, spec.mStarCount);
+            break;
+        case ArgKind::kLong:
+            written = FormatArg<long>(reader, dest, destSize, specString, stars, spec.mStarCount);
+            break;
+        case ArgKind::kLongLong:
+            written = FormatArg<long long>(reader, dest, destSize, specString, stars, spec.mStarCount);
+            break;
+        case ArgKind::kIntMax:
+            written = FormatArg<intmax_t>(reader, dest, destSize, specString, stars, spec.mStarCount);
+            break;
+        case ArgKind::kSize:
+            written = FormatArg<size_t>(reader, dest, destSize, specString, stars, spec.mStarCount);
+            break;
+        case ArgKind::kPtrDiff:
+            written = FormatArg<ptrdiff_t>(reader, dest, destSize, specString, stars, spec.mStarCount);
+            break;
+        case ArgKind::kDouble:
+            written = FormatArg<double>(reader, dest, destSize, specString, stars, spec.mStarCount);
+            break;
+        case ArgKind::kLongDouble:
+            written = FormatArg<long double>(reader, dest, destSize, specString, stars, spec.mStarCount);
+            break;
+        case ArgKind::kPointer:
+            written = FormatArg<void *>(reader, dest, destSize, specString, stars, spec.mStarCount);
+            break;
+        case ArgKind::kString: {
+            const char * str;
+            written = reader.GetString(str) ? FormatValue(dest, destSize, specString, stars, spec.mStarCount, str) : -1;
+            break;
+        }
+        case ArgKind::kUnsupported:
+            written = -1;
+            break;
+        }
+
+        if (written < 0)
+        {
+            break;
+        }
+        length += (static_cast<size_t>(written) < destSize) ? static_cast<size_t>(written) : destSize - 1;
+    }
+
+    return length;
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
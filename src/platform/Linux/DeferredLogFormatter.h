@@ -0,0 +1,59 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *  Deferred formatting of printf-style log messages: the arguments are captured in a compact binary form when the
+ *  message is logged, and formatted later, off the logging thread.
+ */
+
+#pragma once
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+/**
+ * Capture the arguments of a log message. The format string is not copied, so it must outlive the encoded arguments,
+ * which holds for the string literals used by the logging macros. String arguments are copied.
+ *
+ * @param[out] buffer      Where to write the encoded arguments.
+ * @param[in]  bufferSize  The size of the buffer.
+ * @param[in]  format      The printf-style format string.
+ * @param[in]  args        The arguments matching the format.
+ *
+ * @return The number of bytes written, or a negative value if the arguments do not fit in the buffer or the format
+ *         uses a conversion that cannot be deferred (e.g. %n, or %m, which depends on errno), in which case the
+ *         message should be formatted immediately instead.
+ */
+int EncodeLogArgs(uint8_t * buffer, size_t bufferSize, const char * format, va_list args);
+
+/**
+ * Format a message from arguments captured by EncodeLogArgs(), as vsnprintf() would have at the time they were
+ * captured. The output is truncated, and always null-terminated, if it does not fit.
+ *
+ * @return The length of the formatted message, excluding the null terminator.
+ */
+size_t FormatLogArgs(char * out, size_t outSize, const char * format, const uint8_t * encodedArgs, size_t encodedArgsLength);
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
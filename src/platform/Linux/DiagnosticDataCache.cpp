@@ -0,0 +1,459 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Implements the cache of the diagnostic data of Linux platforms.
+ */
+
+#include <platform/internal/CHIPDeviceLayerInternal.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/Linux/ConnectivityUtils.h>
+#include <platform/Linux/DiagnosticDataCache.h>
+#include <platform/PlatformManager.h>
+#include <system/SystemError.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include <dirent.h>
+#include <errno.h>
+#include <ifaddrs.h>
+#include <linux/if_link.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace ::chip::app::Clusters::GeneralDiagnostics;
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+namespace {
+
+constexpr int kSampleIntervalMs = CHIP_DEVICE_CONFIG_DIAGNOSTICS_SAMPLE_INTERVAL_MS;
+
+void CopyIfName(char (&dest)[IFNAMSIZ], const char * src)
+{
+    strncpy(dest, src, IFNAMSIZ - 1);
+    dest[IFNAMSIZ - 1] = '\0';
+}
+
+void ReadLinkCounters(const struct ifaddrs * ifa, DiagnosticDataCache::LinkCounters & counters)
+{
+    CopyIfName(counters.ifName, ifa->ifa_name);
+    VerifyOrReturn(ifa->ifa_data != nullptr);
+
+    const struct rtnl_link_stats * stats = static_cast<const struct rtnl_link_stats *>(ifa->ifa_data);
+
+    counters.valid        = true;
+    counters.rxPackets    = stats->rx_packets;
+    counters.txPackets    = stats->tx_packets;
+    counters.txErrors     = stats->tx_errors;
+    counters.collisions   = stats->collisions;
+    counters.multicast    = stats->multicast;
+    counters.rxOverErrors = stats->rx_over_errors;
+}
+
+CHIP_ERROR SampleInterfaces(DiagnosticDataCache::Snapshot & snapshot)
+{
+    struct ifaddrs * ifaddr = nullptr;
+
+    if (getifaddrs(&ifaddr) == -1)
+    {
+        ChipLogError(DeviceLayer, "Failed to get network interfaces");
+        return CHIP_ERROR_READ_FAILED;
+    }
+
+    // The link layer entries carry the statistics of each interface.
+    for (struct ifaddrs * ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next)
+    {
+        if (ifa->ifa_addr == nullptr || ifa->ifa_addr->sa_family != AF_PACKET)
+        {
+            continue;
+        }
+
+        InterfaceType type = ConnectivityUtils::GetInterfaceConnectionType(ifa->ifa_name);
+
+        if (snapshot.interfaceCount < DiagnosticDataCache::kMaxInterfaces)
+        {
+            DiagnosticDataCache::Interface & netif = snapshot.interfaces[snapshot.interfaceCount++];
+
+            CopyIfName(netif.name, ifa->ifa_name);
+            netif.type    = type;
+            netif.running = (ifa->ifa_flags & IFF_RUNNING) != 0;
+            netif.hasHardwareAddress =
+                ConnectivityUtils::GetInterfaceHardwareAddrs(ifa->ifa_name, netif.hardwareAddress, kMaxHardwareAddrSize) ==
+                CHIP_NO_ERROR;
+        }
+
+        if (type == InterfaceType::EMBER_ZCL_INTERFACE_TYPE_ETHERNET && snapshot.ethernet.ifName[0] == '\0')
+        {
+            ReadLinkCounters(ifa, snapshot.ethernet);
+        }
+#if CHIP_DEVICE_CONFIG_ENABLE_WIFI
+        else if (type == InterfaceType::EMBER_ZCL_INTERFACE_TYPE_WI_FI && snapshot.wifi.ifName[0] == '\0')
+        {
+            ReadLinkCounters(ifa, snapshot.wifi);
+        }
+#endif
+    }
+
+    freeifaddrs(ifaddr);
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR SampleThreads(DiagnosticDataCache::Snapshot & snapshot)
+{
+    DIR * proc_dir = opendir("/proc/self/task");
+    struct dirent * entry;
+
+    if (proc_dir == nullptr)
+    {
+        ChipLogError(DeviceLayer, "Failed to open current process task directory");
+        return CHIP_ERROR_READ_FAILED;
+    }
+
+    // Log when the process starts having more threads than reported, rather than on every sample.
+    static std::atomic<bool> sTruncated{ false };
+    size_t threadTotal = 0;
+
+    while ((entry = readdir(proc_dir)) != nullptr)
+    {
+        if (entry->d_name[0] == '.')
+            continue;
+
+        if (threadTotal++ < DiagnosticDataCache::kMaxThreads)
+        {
+            snapshot.threadIds[snapshot.threadCount++] = strtoull(entry->d_name, nullptr, 10);
+        }
+    }
+
+    closedir(proc_dir);
+
+    bool truncated = threadTotal > DiagnosticDataCache::kMaxThreads;
+    if (truncated && !sTruncated.exchange(truncated))
+    {
+        ChipLogError(DeviceLayer, "Only reporting %u of the %u threads, see CHIP_DEVICE_CONFIG_DIAGNOSTICS_MAX_THREADS",
+                     static_cast<unsigned>(DiagnosticDataCache::kMaxThreads), static_cast<unsigned>(threadTotal));
+    }
+    else if (!truncated)
+    {
+        sTruncated = false;
+    }
+
+    // Keep the ids sorted, so that two samples of the same threads compare equal.
+    std::sort(snapshot.threadIds, snapshot.threadIds + snapshot.threadCount);
+
+    return CHIP_NO_ERROR;
+}
+
+int OpenNetlinkSocket()
+{
+    struct sockaddr_nl addr;
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_ROUTE);
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR;
+
+    if (bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+bool IsSameInterface(const DiagnosticDataCache::Interface & previous, const DiagnosticDataCache::Interface & current)
+{
+    return strcmp(previous.name, current.name) == 0 && previous.type == current.type && previous.running == current.running &&
+        previous.hasHardwareAddress == current.hasHardwareAddress &&
+        memcmp(previous.hardwareAddress, current.hardwareAddress, sizeof(current.hardwareAddress)) == 0;
+}
+
+bool HasCounterChanged(const DiagnosticDataCache::LinkCounters & previous, const DiagnosticDataCache::LinkCounters & current,
+                       uint64_t DiagnosticDataCache::LinkCounters::*counter)
+{
+    return previous.valid != current.valid || previous.*counter != current.*counter;
+}
+
+} // namespace
+
+CHIP_ERROR DiagnosticDataCache::Init(ChangeHandler handler)
+{
+    VerifyOrReturnError(!mRunning, CHIP_ERROR_INCORRECT_STATE);
+    if (kSampleIntervalMs == 0)
+    {
+        // Every read samples the system directly.
+        return CHIP_NO_ERROR;
+    }
+
+    mWakeFd = eventfd(0, EFD_CLOEXEC);
+    VerifyOrReturnError(mWakeFd >= 0, CHIP_ERROR_POSIX(errno));
+
+    mNetlinkFd = OpenNetlinkSocket();
+    if (mNetlinkFd < 0)
+    {
+        ChipLogError(DeviceLayer, "Failed to listen to netlink, network diagnostics are only sampled periodically");
+    }
+
+    mChangeHandler = handler;
+    mSnapshotError = Sample(mSnapshot);
+    mRunning       = true;
+    mSampler       = std::thread(&DiagnosticDataCache::SamplerMain, this);
+
+    ChipLogProgress(DeviceLayer, "Sampling diagnostics every %d ms", kSampleIntervalMs);
+    return CHIP_NO_ERROR;
+}
+
+void DiagnosticDataCache::Shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        VerifyOrReturn(mRunning);
+        mRunning = false;
+    }
+
+    uint64_t wake = 1;
+    if (write(mWakeFd, &wake, sizeof(wake)) != sizeof(wake))
+    {
+        ChipLogError(DeviceLayer, "Failed to wake the diagnostics sampler: %s", strerror(errno));
+    }
+    mSampler.join();
+
+    close(mWakeFd);
+    mWakeFd = -1;
+    if (mNetlinkFd >= 0)
+    {
+        close(mNetlinkFd);
+        mNetlinkFd = -1;
+    }
+}
+
+CHIP_ERROR DiagnosticDataCache::GetSnapshot(Snapshot & snapshot)
+{
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        if (mRunning)
+        {
+            ReturnErrorOnFailure(mSnapshotError);
+            snapshot = mSnapshot;
+            return CHIP_NO_ERROR;
+        }
+    }
+
+    return Sample(snapshot);
+}
+
+CHIP_ERROR DiagnosticDataCache::Sample(Snapshot & snapshot)
+{
+    memset(&snapshot, 0, sizeof(snapshot));
+
+    CHIP_ERROR interfacesErr = SampleInterfaces(snapshot);
+    CHIP_ERROR threadsErr    = SampleThreads(snapshot);
+
+    if (snapshot.ethernet.ifName[0] != '\0')
+    {
+        snapshot.hasEthPHYRate = ConnectivityUtils::GetEthPHYRate(snapshot.ethernet.ifName, snapshot.ethPHYRate) == CHIP_NO_ERROR;
+        snapshot.hasEthFullDuplex =
+            ConnectivityUtils::GetEthFullDuplex(snapshot.ethernet.ifName, snapshot.ethFullDuplex) == CHIP_NO_ERROR;
+    }
+
+#if CHIP_DEVICE_CONFIG_ENABLE_WIFI
+    if (snapshot.wifi.ifName[0] != '\0')
+    {
+        const char * ifName = snapshot.wifi.ifName;
+
+        snapshot.hasWiFiChannelNumber =
+            ConnectivityUtils::GetWiFiChannelNumber(ifName, snapshot.wiFiChannelNumber) == CHIP_NO_ERROR;
+        snapshot.hasWiFiRssi = ConnectivityUtils::GetWiFiRssi(ifName, snapshot.wiFiRssi) == CHIP_NO_ERROR;
+        snapshot.hasWiFiBeaconLostCount =
+            ConnectivityUtils::GetWiFiBeaconLostCount(ifName, snapshot.wiFiBeaconLostCount) == CHIP_NO_ERROR;
+        snapshot.hasWiFiCurrentMaxRate =
+            ConnectivityUtils::GetWiFiCurrentMaxRate(ifName, snapshot.wiFiCurrentMaxRate) == CHIP_NO_ERROR;
+    }
+#endif
+
+    ReturnErrorOnFailure(interfacesErr);
+    return threadsErr;
+}
+
+void DiagnosticDataCache::SamplerMain()
+{
+    struct pollfd fds[2] = { { mWakeFd, POLLIN, 0 }, { mNetlinkFd, POLLIN, 0 } };
+    nfds_t nfds          = (mNetlinkFd >= 0) ? 2 : 1;
+
+    for (;;)
+    {
+        if (poll(fds, nfds, kSampleIntervalMs) < 0)
+        {
+            VerifyOrReturn(errno == EINTR, ChipLogError(DeviceLayer, "Diagnostics sampler failed: %s", strerror(errno)));
+            continue;
+        }
+
+        if (fds[0].revents & POLLIN)
+        {
+            return;
+        }
+
+        if (nfds > 1 && (fds[1].revents & POLLIN))
+        {
+            DrainNetlink();
+        }
+
+        PublishSample(Sample(mNextSnapshot));
+    }
+}
+
+void DiagnosticDataCache::PublishSample(CHIP_ERROR err)
+{
+    bool scheduleDispatch = false;
+    {
+        std::lock_guard<std::mutex> lock(mLock);
+        mSnapshotError = err;
+        if (err == CHIP_NO_ERROR)
+        {
+            mPendingChanges.Set(Compare(mSnapshot, mNextSnapshot));
+            mSnapshot          = mNextSnapshot;
+            scheduleDispatch   = mPendingChanges.HasAny() && !mDispatchScheduled;
+            mDispatchScheduled = mDispatchScheduled || scheduleDispatch;
+        }
+    }
+
+    VerifyOrReturn(scheduleDispatch);
+
+    err = mPostWork(DispatchChanges, reinterpret_cast<intptr_t>(this));
+    if (err != CHIP_NO_ERROR)
+    {
+        // Keep the changes pending, so that the next sample tries to dispatch them again.
+        ChipLogError(DeviceLayer, "Failed to dispatch diagnostic data changes: %" CHIP_ERROR_FORMAT, err.Format());
+        std::lock_guard<std::mutex> lock(mLock);
+        mDispatchScheduled = false;
+    }
+}
+
+CHIP_ERROR DiagnosticDataCache::PostToChipThread(AsyncWorkFunct work, intptr_t arg)
+{
+    ChipDeviceEvent event;
+    event.Type                    = DeviceEventType::kCallWorkFunct;
+    event.CallWorkFunct.WorkFunct = work;
+    event.CallWorkFunct.Arg       = arg;
+
+    return PlatformMgr().PostEvent(&event);
+}
+
+void DiagnosticDataCache::DrainNetlink()
+{
+    // Any link or address message triggers a full sample, so the messages themselves are not parsed. A burst of them is
+    // drained before sampling once.
+    uint8_t buffer[4096];
+
+    while (recv(mNetlinkFd, buffer, sizeof(buffer), 0) > 0)
+    {
+    }
+}
+
+BitFlags<DiagnosticDataChange> DiagnosticDataCache::Compare(const Snapshot & previous, const Snapshot & current)
+{
+    BitFlags<DiagnosticDataChange> changes;
+
+    bool sameInterfaces = previous.interfaceCount == current.interfaceCount;
+    for (size_t i = 0; sameInterfaces && i < current.interfaceCount; i++)
+    {
+        sameInterfaces = IsSameInterface(previous.interfaces[i], current.interfaces[i]);
+    }
+    changes.Set(DiagnosticDataChange::kNetworkInterfaces, !sameInterfaces);
+
+    changes.Set(DiagnosticDataChange::kThreadMetrics,
+                previous.threadCount != current.threadCount ||
+                    memcmp(previous.threadIds, current.threadIds, current.threadCount * sizeof(current.threadIds[0])) != 0);
+
+    changes.Set(DiagnosticDataChange::kEthPHYRate,
+                previous.hasEthPHYRate != current.hasEthPHYRate || previous.ethPHYRate != current.ethPHYRate);
+    changes.Set(DiagnosticDataChange::kEthFullDuplex,
+                previous.hasEthFullDuplex != current.hasEthFullDuplex || previous.ethFullDuplex != current.ethFullDuplex);
+    changes.Set(DiagnosticDataChange::kEthPacketRxCount,
+                HasCounterChanged(previous.ethernet, current.ethernet, &LinkCounters::rxPackets));
+    changes.Set(DiagnosticDataChange::kEthPacketTxCount,
+                HasCounterChanged(previous.ethernet, current.ethernet, &LinkCounters::txPackets));
+    changes.Set(DiagnosticDataChange::kEthTxErrCount,
+                HasCounterChanged(previous.ethernet, current.ethernet, &LinkCounters::txErrors));
+    changes.Set(DiagnosticDataChange::kEthCollisionCount,
+                HasCounterChanged(previous.ethernet, current.ethernet, &LinkCounters::collisions));
+    changes.Set(DiagnosticDataChange::kEthOverrunCount,
+                HasCounterChanged(previous.ethernet, current.ethernet, &LinkCounters::rxOverErrors));
+
+#if CHIP_DEVICE_CONFIG_ENABLE_WIFI
+    changes.Set(DiagnosticDataChange::kWiFiChannelNumber,
+                previous.hasWiFiChannelNumber != current.hasWiFiChannelNumber ||
+                    previous.wiFiChannelNumber != current.wiFiChannelNumber);
+    changes.Set(DiagnosticDataChange::kWiFiRssi,
+                previous.hasWiFiRssi != current.hasWiFiRssi || previous.wiFiRssi != current.wiFiRssi);
+    changes.Set(DiagnosticDataChange::kWiFiBeaconLostCount,
+                previous.hasWiFiBeaconLostCount != current.hasWiFiBeaconLostCount ||
+                    previous.wiFiBeaconLostCount != current.wiFiBeaconLostCount);
+    changes.Set(DiagnosticDataChange::kWiFiCurrentMaxRate,
+                previous.hasWiFiCurrentMaxRate != current.hasWiFiCurrentMaxRate ||
+                    previous.wiFiCurrentMaxRate != current.wiFiCurrentMaxRate);
+    changes.Set(DiagnosticDataChange::kWiFiPacketMulticastRxCount,
+                HasCounterChanged(previous.wifi, current.wifi, &LinkCounters::multicast));
+    changes.Set(DiagnosticDataChange::kWiFiPacketUnicastRxCount,
+                HasCounterChanged(previous.wifi, current.wifi, &LinkCounters::rxPackets));
+    changes.Set(DiagnosticDataChange::kWiFiPacketUnicastTxCount,
+                HasCounterChanged(previous.wifi, current.wifi, &LinkCounters::txPackets));
+    changes.Set(DiagnosticDataChange::kWiFiOverrunCount,
+                HasCounterChanged(previous.wifi, current.wifi, &LinkCounters::rxOverErrors));
+#endif
+
+    return changes;
+}
+
+void DiagnosticDataCache::DispatchChanges(intptr_t arg)
+{
+    DiagnosticDataCache * cache = reinterpret_cast<DiagnosticDataCache *>(arg);
+    BitFlags<DiagnosticDataChange> changes;
+
+    {
+        std::lock_guard<std::mutex> lock(cache->mLock);
+        changes = cache->mPendingChanges;
+        cache->mPendingChanges.ClearAll();
+        cache->mDispatchScheduled = false;
+        VerifyOrReturn(cache->mRunning);
+    }
+
+    cache->mChangeHandler(changes);
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
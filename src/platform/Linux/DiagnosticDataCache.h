@@ -0,0 +1,170 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *          Provides a cache of the diagnostic data of Linux platforms, kept up to date by a background thread.
+ */
+
+#pragma once
+
+#include <app-common/zap-generated/enums.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/BitFlags.h>
+#include <platform/CHIPDeviceConfig.h>
+#include <platform/CHIPDeviceEvent.h>
+#include <platform/DiagnosticDataProvider.h>
+
+#include <net/if.h>
+
+#include <mutex>
+#include <thread>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+/**
+ * The diagnostic data that changed between two samples.
+ */
+enum class DiagnosticDataChange : uint32_t
+{
+    kNetworkInterfaces          = 0x00000001,
+    kThreadMetrics              = 0x00000002,
+    kEthPHYRate                 = 0x00000004,
+    kEthFullDuplex              = 0x00000008,
+    kEthPacketRxCount           = 0x00000010,
+    kEthPacketTxCount           = 0x00000020,
+    kEthTxErrCount              = 0x00000040,
+    kEthCollisionCount          = 0x00000080,
+    kEthOverrunCount            = 0x00000100,
+    kWiFiChannelNumber          = 0x00000200,
+    kWiFiRssi                   = 0x00000400,
+    kWiFiBeaconLostCount        = 0x00000800,
+    kWiFiPacketMulticastRxCount = 0x00001000,
+    kWiFiPacketUnicastRxCount   = 0x00002000,
+    kWiFiPacketUnicastTxCount   = 0x00004000,
+    kWiFiCurrentMaxRate         = 0x00008000,
+    kWiFiOverrunCount           = 0x00010000,
+};
+
+/**
+ * Keeps the last sample of the network interfaces, link counters and threads of the process. The sample is refreshed by
+ * a background thread every CHIP_DEVICE_CONFIG_DIAGNOSTICS_SAMPLE_INTERVAL_MS, and as soon as netlink reports a link or
+ * address change, so that reading diagnostics attributes does not cost any system call on the CHIP thread. The changes
+ * found by a refresh are handed to the change handler on the CHIP thread.
+ */
+class DiagnosticDataCache
+{
+public:
+    static constexpr size_t kMaxInterfaces = 16;
+    static constexpr size_t kMaxThreads    = CHIP_DEVICE_CONFIG_DIAGNOSTICS_MAX_THREADS;
+
+    struct Interface
+    {
+        char name[IFNAMSIZ];
+        app::Clusters::GeneralDiagnostics::InterfaceType type;
+        bool running;
+        bool hasHardwareAddress;
+        uint8_t hardwareAddress[kMaxHardwareAddrSize];
+    };
+
+    struct LinkCounters
+    {
+        bool valid;
+        char ifName[IFNAMSIZ];
+        uint64_t rxPackets;
+        uint64_t txPackets;
+        uint64_t txErrors;
+        uint64_t collisions;
+        uint64_t multicast;
+        uint64_t rxOverErrors;
+    };
+
+    struct Snapshot
+    {
+        Interface interfaces[kMaxInterfaces];
+        size_t interfaceCount;
+        uint64_t threadIds[kMaxThreads];
+        size_t threadCount;
+
+        LinkCounters ethernet;
+        bool hasEthPHYRate;
+        uint8_t ethPHYRate;
+        bool hasEthFullDuplex;
+        bool ethFullDuplex;
+
+#if CHIP_DEVICE_CONFIG_ENABLE_WIFI
+        LinkCounters wifi;
+        bool hasWiFiChannelNumber;
+        uint16_t wiFiChannelNumber;
+        bool hasWiFiRssi;
+        int8_t wiFiRssi;
+        bool hasWiFiBeaconLostCount;
+        uint32_t wiFiBeaconLostCount;
+        bool hasWiFiCurrentMaxRate;
+        uint64_t wiFiCurrentMaxRate;
+#endif
+    };
+
+    using ChangeHandler = void (*)(BitFlags<DiagnosticDataChange> changes);
+    using WorkPoster    = CHIP_ERROR (*)(AsyncWorkFunct work, intptr_t arg);
+
+    /**
+     * Take a first sample and start the background thread, unless CHIP_DEVICE_CONFIG_DIAGNOSTICS_SAMPLE_INTERVAL_MS is 0.
+     */
+    CHIP_ERROR Init(ChangeHandler handler);
+    void Shutdown();
+
+    /**
+     * Copy the last sample, or sample the system directly when the background thread is not running.
+     */
+    CHIP_ERROR GetSnapshot(Snapshot & snapshot);
+
+    /**
+     * Sample the system on the calling thread.
+     */
+    static CHIP_ERROR Sample(Snapshot & snapshot);
+
+private:
+    friend class TestDiagnosticDataCache;
+
+    void SamplerMain();
+    void DrainNetlink();
+    // Make mNextSnapshot the current sample, and hand the changes it brings to the CHIP thread
+    void PublishSample(CHIP_ERROR err);
+    static BitFlags<DiagnosticDataChange> Compare(const Snapshot & previous, const Snapshot & current);
+    static void DispatchChanges(intptr_t arg);
+    static CHIP_ERROR PostToChipThread(AsyncWorkFunct work, intptr_t arg);
+
+    std::thread mSampler;
+    std::mutex mLock;
+    Snapshot mSnapshot;
+    Snapshot mNextSnapshot;
+    BitFlags<DiagnosticDataChange> mPendingChanges;
+    CHIP_ERROR mSnapshotError    = CHIP_NO_ERROR;
+    ChangeHandler mChangeHandler = nullptr;
+    WorkPoster mPostWork         = PostToChipThread;
+    int mNetlinkFd               = -1;
+    int mWakeFd                  = -1;
+    bool mRunning                = false;
+    bool mDispatchScheduled      = false;
+};
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
@@ -24,27 +24,17 @@
 #include <platform/internal/CHIPDeviceLayerInternal.h>
 
 #include <app-common/zap-generated/enums.h>
+#include <app-common/zap-generated/ids/Attributes.h>
 #include <lib/support/CHIPMem.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <platform/DiagnosticDataProvider.h>
-#include <platform/Linux/ConnectivityUtils.h>
+#include <platform/Linux/DiagnosticDataCache.h>
 #include <platform/Linux/DiagnosticDataProviderImpl.h>
 
-#include <arpa/inet.h>
-#include <dirent.h>
-#include <ifaddrs.h>
-#include <linux/ethtool.h>
-#include <linux/if_link.h>
-#include <linux/netlink.h>
-#include <linux/rtnetlink.h>
+#include <inttypes.h>
 #include <malloc.h>
-#include <net/if.h>
-#include <netinet/in.h>
 #include <stdio.h>
-#include <stdlib.h>
 #include <string.h>
-#include <sys/types.h>
-#include <unistd.h>
 
 using namespace ::chip;
 using namespace ::chip::TLV;
@@ -52,168 +42,102 @@ using namespace ::chip::DeviceLayer;
 using namespace ::chip::DeviceLayer::Internal;
 using namespace ::chip::app::Clusters::GeneralDiagnostics;
 
-namespace {
+namespace chip {
+namespace DeviceLayer {
 
-enum class EthernetStatsCountType
+DiagnosticDataProviderImpl & DiagnosticDataProviderImpl::GetDefaultInstance()
 {
-    kEthPacketRxCount,
-    kEthPacketTxCount,
-    kEthTxErrCount,
-    kEthCollisionCount,
-    kEthOverrunCount
-};
+    static DiagnosticDataProviderImpl sInstance;
+    return sInstance;
+}
+
+CHIP_ERROR DiagnosticDataProviderImpl::StartSampling()
+{
+    return mCache.Init(OnDiagnosticDataChanged);
+}
 
-enum class WiFiStatsCountType
+void DiagnosticDataProviderImpl::StopSampling()
 {
-    kWiFiUnicastPacketRxCount,
-    kWiFiUnicastPacketTxCount,
-    kWiFiMulticastPacketRxCount,
-    kWiFiMulticastPacketTxCount,
-    kWiFiOverrunCount
-};
+    mCache.Shutdown();
+}
 
-CHIP_ERROR GetEthernetStatsCount(EthernetStatsCountType type, uint64_t & count)
+void DiagnosticDataProviderImpl::OnDiagnosticDataChanged(BitFlags<DiagnosticDataChange> changes)
 {
-    CHIP_ERROR err          = CHIP_ERROR_READ_FAILED;
-    struct ifaddrs * ifaddr = nullptr;
+    DiagnosticDataProviderImpl & provider = GetDefaultInstance();
 
-    if (getifaddrs(&ifaddr) == -1)
+    if (changes.Has(DiagnosticDataChange::kNetworkInterfaces))
     {
-        ChipLogError(DeviceLayer, "Failed to get network interfaces");
+        ConnectivityManagerDelegate * connectivityDelegate = ConnectivityMgr().GetDelegate();
+        if (connectivityDelegate != nullptr)
+        {
+            connectivityDelegate->OnNetworkInfoChanged();
+        }
     }
-    else
+
+    SoftwareDiagnosticsDelegate * softwareDelegate = provider.GetSoftwareDiagnosticsDelegate();
+    if (softwareDelegate != nullptr && changes.Has(DiagnosticDataChange::kThreadMetrics))
     {
-        struct ifaddrs * ifa = nullptr;
+        softwareDelegate->OnAttributeChanged(app::Clusters::SoftwareDiagnostics::Attributes::ThreadMetrics::Id);
+    }
 
-        // Walk through linked list, maintaining head pointer so we can free list later.
-        for (ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next)
-        {
-            if (ConnectivityUtils::GetInterfaceConnectionType(ifa->ifa_name) == InterfaceType::EMBER_ZCL_INTERFACE_TYPE_ETHERNET)
-            {
-                ChipLogProgress(DeviceLayer, "Found the primary Ethernet interface:%s", ifa->ifa_name);
-                break;
-            }
-        }
+    EthernetDiagnosticsDelegate * ethernetDelegate = provider.GetEthernetDiagnosticsDelegate();
+    if (ethernetDelegate != nullptr)
+    {
+        using namespace app::Clusters::EthernetNetworkDiagnostics::Attributes;
 
-        if (ifa != nullptr)
+        const struct
+        {
+            DiagnosticDataChange change;
+            AttributeId attributeId;
+        } ethernetAttributes[] = {
+            { DiagnosticDataChange::kEthPHYRate, PHYRate::Id },
+            { DiagnosticDataChange::kEthFullDuplex, FullDuplex::Id },
+            { DiagnosticDataChange::kEthPacketRxCount, PacketRxCount::Id },
+            { DiagnosticDataChange::kEthPacketTxCount, PacketTxCount::Id },
+            { DiagnosticDataChange::kEthTxErrCount, TxErrCount::Id },
+            { DiagnosticDataChange::kEthCollisionCount, CollisionCount::Id },
+            { DiagnosticDataChange::kEthOverrunCount, OverrunCount::Id },
+        };
+
+        for (const auto & attribute : ethernetAttributes)
         {
-            if (ifa->ifa_addr->sa_family == AF_PACKET && ifa->ifa_data != nullptr)
+            if (changes.Has(attribute.change))
             {
-                struct rtnl_link_stats * stats = (struct rtnl_link_stats *) ifa->ifa_data;
-                switch (type)
-                {
-                case EthernetStatsCountType::kEthPacketRxCount:
-                    count = stats->rx_packets;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                case EthernetStatsCountType::kEthPacketTxCount:
-                    count = stats->tx_packets;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                case EthernetStatsCountType::kEthTxErrCount:
-                    count = stats->tx_errors;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                case EthernetStatsCountType::kEthCollisionCount:
-                    count = stats->collisions;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                case EthernetStatsCountType::kEthOverrunCount:
-                    count = stats->rx_over_errors;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                default:
-                    ChipLogError(DeviceLayer, "Unknown Ethernet statistic metric type");
-                    break;
-                }
+                ethernetDelegate->OnAttributeChanged(attribute.attributeId);
             }
         }
-
-        freeifaddrs(ifaddr);
     }
 
-    return err;
-}
-
 #if CHIP_DEVICE_CONFIG_ENABLE_WIFI
-CHIP_ERROR GetWiFiStatsCount(WiFiStatsCountType type, uint64_t & count)
-{
-    CHIP_ERROR err          = CHIP_ERROR_READ_FAILED;
-    struct ifaddrs * ifaddr = nullptr;
-
-    if (getifaddrs(&ifaddr) == -1)
+    WiFiDiagnosticsDelegate * wifiDelegate = provider.GetWiFiDiagnosticsDelegate();
+    if (wifiDelegate != nullptr)
     {
-        ChipLogError(DeviceLayer, "Failed to get network interfaces");
-    }
-    else
-    {
-        struct ifaddrs * ifa = nullptr;
+        using namespace app::Clusters::WiFiNetworkDiagnostics::Attributes;
 
-        // Walk through linked list, maintaining head pointer so we can free list later.
-        for (ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next)
+        const struct
         {
-            if (ConnectivityUtils::GetInterfaceConnectionType(ifa->ifa_name) == InterfaceType::EMBER_ZCL_INTERFACE_TYPE_WI_FI)
-            {
-                ChipLogProgress(DeviceLayer, "Found the primary WiFi interface:%s", ifa->ifa_name);
-                break;
-            }
-        }
-
-        if (ifa != nullptr)
+            DiagnosticDataChange change;
+            AttributeId attributeId;
+        } wifiAttributes[] = {
+            { DiagnosticDataChange::kWiFiChannelNumber, ChannelNumber::Id },
+            { DiagnosticDataChange::kWiFiRssi, Rssi::Id },
+            { DiagnosticDataChange::kWiFiBeaconLostCount, BeaconLostCount::Id },
+            { DiagnosticDataChange::kWiFiPacketMulticastRxCount, PacketMulticastRxCount::Id },
+            { DiagnosticDataChange::kWiFiPacketUnicastRxCount, PacketUnicastRxCount::Id },
+            { DiagnosticDataChange::kWiFiPacketUnicastTxCount, PacketUnicastTxCount::Id },
+            { DiagnosticDataChange::kWiFiCurrentMaxRate, CurrentMaxRate::Id },
+            { DiagnosticDataChange::kWiFiOverrunCount, OverrunCount::Id },
+        };
+
+        for (const auto & attribute : wifiAttributes)
         {
-            if (ifa->ifa_addr->sa_family == AF_PACKET && ifa->ifa_data != nullptr)
+            if (changes.Has(attribute.change))
             {
-                // The usecase of this function is embedded devices,on which we can interact with the WiFi
-                // driver to get the accurate number of muticast and unicast packets accurately.
-                // On Linux simulation, we can only get the total packets received, the total bytes transmitted,
-                // the multicast packets received and receiver ring buff overflow.
-
-                struct rtnl_link_stats * stats = (struct rtnl_link_stats *) ifa->ifa_data;
-                switch (type)
-                {
-                case WiFiStatsCountType::kWiFiUnicastPacketRxCount:
-                    count = stats->rx_packets;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                case WiFiStatsCountType::kWiFiUnicastPacketTxCount:
-                    count = stats->tx_packets;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                case WiFiStatsCountType::kWiFiMulticastPacketRxCount:
-                    count = stats->multicast;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                case WiFiStatsCountType::kWiFiMulticastPacketTxCount:
-                    count = 0;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                case WiFiStatsCountType::kWiFiOverrunCount:
-                    count = stats->rx_over_errors;
-                    err   = CHIP_NO_ERROR;
-                    break;
-                default:
-                    ChipLogError(DeviceLayer, "Unknown WiFi statistic metric type");
-                    break;
-                }
+                wifiDelegate->OnAttributeChanged(attribute.attributeId);
             }
         }
-
-        freeifaddrs(ifaddr);
     }
-
-    return err;
-}
-#endif // #if CHIP_DEVICE_CONFIG_ENABLE_WIFI
-
-} // namespace
-
-namespace chip {
-namespace DeviceLayer {
-
-DiagnosticDataProviderImpl & DiagnosticDataProviderImpl::GetDefaultInstance()
-{
-    static DiagnosticDataProviderImpl sInstance;
-    return sInstance;
+#endif // CHIP_DEVICE_CONFIG_ENABLE_WIFI
 }
 
 CHIP_ERROR DiagnosticDataProviderImpl::GetCurrentHeapFree(uint64_t & currentHeapFree)
@@ -256,47 +180,31 @@ CHIP_ERROR DiagnosticDataProviderImpl::GetCurrentHeapHighWatermark(uint64_t & cu
 
 CHIP_ERROR DiagnosticDataProviderImpl::GetThreadMetrics(ThreadMetrics ** threadMetricsOut)
 {
-    CHIP_ERROR err = CHIP_ERROR_READ_FAILED;
-    DIR * proc_dir = opendir("/proc/self/task");
-
-    if (proc_dir == nullptr)
-    {
-        ChipLogError(DeviceLayer, "Failed to open current process task directory");
-    }
-    else
-    {
-        ThreadMetrics * head = nullptr;
-        struct dirent * entry;
-
-        /* proc available, iterate through tasks... */
-        while ((entry = readdir(proc_dir)) != NULL)
-        {
-            if (entry->d_name[0] == '.')
-                continue;
+    DiagnosticDataCache::Snapshot snapshot;
+    ThreadMetrics * head = nullptr;
 
-            ThreadMetrics * thread = new ThreadMetrics();
+    ReturnErrorOnFailure(mCache.GetSnapshot(snapshot));
 
-            strncpy(thread->NameBuf, entry->d_name, kMaxThreadNameLength);
-            thread->NameBuf[kMaxThreadNameLength] = '\0';
-            thread->name                          = CharSpan(thread->NameBuf, strlen(thread->NameBuf));
-            thread->id                            = atoi(entry->d_name);
-
-            // TODO: Get stack info of each thread
-            thread->stackFreeCurrent = 0;
-            thread->stackFreeMinimum = 0;
-            thread->stackSize        = 0;
+    for (size_t i = snapshot.threadCount; i > 0; i--)
+    {
+        ThreadMetrics * thread = new ThreadMetrics();
 
-            thread->Next = head;
-            head         = thread;
-        }
+        snprintf(thread->NameBuf, sizeof(thread->NameBuf), "%" PRIu64, snapshot.threadIds[i - 1]);
+        thread->name = CharSpan(thread->NameBuf, strlen(thread->NameBuf));
+        thread->id   = snapshot.threadIds[i - 1];
 
-        closedir(proc_dir);
+        // TODO: Get stack info of each thread
+        thread->stackFreeCurrent = 0;
+        thread->stackFreeMinimum = 0;
+        thread->stackSize        = 0;
 
-        *threadMetricsOut = head;
-        err               = CHIP_NO_ERROR;
+        thread->Next = head;
+        head         = thread;
     }
 
-    return err;
+    *threadMetricsOut = head;
+
+    return CHIP_NO_ERROR;
 }
 
 void DiagnosticDataProviderImpl::ReleaseThreadMetrics(ThreadMetrics * threadMetrics)
@@ -411,56 +319,43 @@ CHIP_ERROR DiagnosticDataProviderImpl::GetActiveNetworkFaults(GeneralFaults<kMax
 
 CHIP_ERROR DiagnosticDataProviderImpl::GetNetworkInterfaces(NetworkInterface ** netifpp)
 {
-    CHIP_ERROR err          = CHIP_ERROR_READ_FAILED;
-    struct ifaddrs * ifaddr = nullptr;
+    DiagnosticDataCache::Snapshot snapshot;
+    NetworkInterface * head = nullptr;
 
-    if (getifaddrs(&ifaddr) == -1)
-    {
-        ChipLogError(DeviceLayer, "Failed to get network interfaces");
-    }
-    else
+    ReturnErrorOnFailure(mCache.GetSnapshot(snapshot));
+
+    for (size_t i = snapshot.interfaceCount; i > 0; i--)
     {
-        NetworkInterface * head = nullptr;
+        const DiagnosticDataCache::Interface & netif = snapshot.interfaces[i - 1];
+        NetworkInterface * ifp                       = new NetworkInterface();
 
-        // Walk through linked list, maintaining head pointer so we can free list later.
-        for (struct ifaddrs * ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next)
+        strncpy(ifp->Name, netif.name, Inet::InterfaceId::kMaxIfNameLength);
+        ifp->Name[Inet::InterfaceId::kMaxIfNameLength - 1] = '\0';
+
+        ifp->name                            = CharSpan(ifp->Name, strlen(ifp->Name));
+        ifp->fabricConnected                 = netif.running;
+        ifp->type                            = netif.type;
+        ifp->offPremiseServicesReachableIPv4 = false;
+        ifp->offPremiseServicesReachableIPv6 = false;
+
+        if (!netif.hasHardwareAddress)
         {
-            if (ifa->ifa_addr && ifa->ifa_addr->sa_family == AF_PACKET)
-            {
-                NetworkInterface * ifp = new NetworkInterface();
-
-                strncpy(ifp->Name, ifa->ifa_name, Inet::InterfaceId::kMaxIfNameLength);
-                ifp->Name[Inet::InterfaceId::kMaxIfNameLength - 1] = '\0';
-
-                ifp->name                            = CharSpan(ifp->Name, strlen(ifp->Name));
-                ifp->fabricConnected                 = ifa->ifa_flags & IFF_RUNNING;
-                ifp->type                            = ConnectivityUtils::GetInterfaceConnectionType(ifa->ifa_name);
-                ifp->offPremiseServicesReachableIPv4 = false;
-                ifp->offPremiseServicesReachableIPv6 = false;
-
-                if (ConnectivityUtils::GetInterfaceHardwareAddrs(ifa->ifa_name, ifp->MacAddress, kMaxHardwareAddrSize) !=
-                    CHIP_NO_ERROR)
-                {
-                    ChipLogError(DeviceLayer, "Failed to get network hardware address");
-                }
-                else
-                {
-                    // Set 48-bit IEEE MAC Address
-                    ifp->hardwareAddress = ByteSpan(ifp->MacAddress, 6);
-                }
-
-                ifp->Next = head;
-                head      = ifp;
-            }
+            ChipLogError(DeviceLayer, "Failed to get network hardware address");
+        }
+        else
+        {
+            // Set 48-bit IEEE MAC Address
+            memcpy(ifp->MacAddress, netif.hardwareAddress, sizeof(ifp->MacAddress));
+            ifp->hardwareAddress = ByteSpan(ifp->MacAddress, 6);
         }
 
-        *netifpp = head;
-        err      = CHIP_NO_ERROR;
-
-        freeifaddrs(ifaddr);
+        ifp->Next = head;
+        head      = ifp;
     }
 
-    return err;
+    *netifpp = head;
+
+    return CHIP_NO_ERROR;
 }
 
 void DiagnosticDataProviderImpl::ReleaseNetworkInterfaces(NetworkInterface * netifp)
@@ -475,22 +370,26 @@ void DiagnosticDataProviderImpl::ReleaseNetworkInterfaces(NetworkInterface * net
 
 CHIP_ERROR DiagnosticDataProviderImpl::GetEthPHYRate(uint8_t & pHYRate)
 {
-    if (ConnectivityMgrImpl().GetEthernetIfName() == nullptr)
-    {
-        return CHIP_ERROR_READ_FAILED;
-    }
+    DiagnosticDataCache::Snapshot snapshot;
+
+    ReturnErrorOnFailure(mCache.GetSnapshot(snapshot));
+    VerifyOrReturnError(snapshot.hasEthPHYRate, CHIP_ERROR_READ_FAILED);
 
-    return ConnectivityUtils::GetEthPHYRate(ConnectivityMgrImpl().GetEthernetIfName(), pHYRate);
+    pHYRate = snapshot.ethPHYRate;
+
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR DiagnosticDataProviderImpl::GetEthFullDuplex(bool & fullDuplex)
 {
-    if (ConnectivityMgrImpl().GetEthernetIfName() == nullptr)
-    {
-        return CHIP_ERROR_READ_FAILED;
-    }
+    DiagnosticDataCache::Snapshot snapshot;
 
-    return ConnectivityUtils::GetEthFullDuplex(ConnectivityMgrImpl().GetEthernetIfName(), fullDuplex);
+    ReturnErrorOnFailure(mCache.GetSnapshot(snapshot));
+    VerifyOrReturnError(snapshot.hasEthFullDuplex, CHIP_ERROR_READ_FAILED);
+
+    fullDuplex = snapshot.ethFullDuplex;
+
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR DiagnosticDataProviderImpl::GetEthTimeSinceReset(uint64_t & timeSinceReset)
@@ -500,163 +399,145 @@ CHIP_ERROR DiagnosticDataProviderImpl::GetEthTimeSinceReset(uint64_t & timeSince
 
 CHIP_ERROR DiagnosticDataProviderImpl::GetEthPacketRxCount(uint64_t & packetRxCount)
 {
-    uint64_t count;
+    DiagnosticDataCache::Snapshot snapshot;
 
-    ReturnErrorOnFailure(GetEthernetStatsCount(EthernetStatsCountType::kEthPacketRxCount, count));
-    VerifyOrReturnError(count >= mEthPacketRxCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
+    ReturnErrorOnFailure(mCache.GetSnapshot(snapshot));
+    VerifyOrReturnError(snapshot.ethernet.valid, CHIP_ERROR_READ_FAILED);
+    VerifyOrReturnError(snapshot.ethernet.rxPackets >= mEthPacketRxCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
 
-    packetRxCount = count - mEthPacketRxCount;
+    packetRxCount = snapshot.ethernet.rxPackets - mEthPacketRxCount;
 
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR DiagnosticDataProviderImpl::GetEthPacketTxCount(uint64_t & packetTxCount)
 {
-    uint64_t count;
+    DiagnosticDataCache::Snapshot snapshot;
 
-    ReturnErrorOnFailure(GetEthernetStatsCount(EthernetStatsCountType::kEthPacketTxCount, count));
-    VerifyOrReturnError(count >= mEthPacketTxCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
+    ReturnErrorOnFailure(mCache.GetSnapshot(snapshot));
+    VerifyOrReturnError(snapshot.ethernet.valid, CHIP_ERROR_READ_FAILED);
+    VerifyOrReturnError(snapshot.ethernet.txPackets >= mEthPacketTxCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
 
-    packetTxCount = count - mEthPacketTxCount;
+    packetTxCount = snapshot.ethernet.txPackets - mEthPacketTxCount;
 
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR DiagnosticDataProviderImpl::GetEthTxErrCount(uint64_t & txErrCount)
 {
-    uint64_t count;
+    DiagnosticDataCache::Snapshot snapshot;
 
-    ReturnErrorOnFailure(GetEthernetStatsCount(EthernetStatsCountType::kEthTxErrCount, count));
-    VerifyOrReturnError(count >= mEthTxErrCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
+    ReturnErrorOnFailure(mCache.GetSnapshot(snapshot));
+    VerifyOrReturnError(snapshot.ethernet.valid, CHIP_ERROR_READ_FAILED);
+    VerifyOrReturnError(snapshot.ethernet.txErrors >= mEthTxErrCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
 
-    txErrCount = count - mEthTxErrCount;
+    txErrCount = snapshot.ethernet.txErrors - mEthTxErrCount;
 
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR DiagnosticDataProviderImpl::GetEthCollisionCount(uint64_t & collisionCount)
 {
-    uint64_t count;
+    DiagnosticDataCache::Snapshot snapshot;
 
-    ReturnErrorOnFailure(GetEthernetStatsCount(EthernetStatsCountType::kEthCollisionCount, count));
-    VerifyOrReturnError(count >= mEthCollisionCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
+    ReturnErrorOnFailure(mCache.GetSnapshot(snapshot));
+    VerifyOrReturnError(snapshot.ethernet.valid, CHIP_ERROR_READ_FAILED);
+    VerifyOrReturnError(snapshot.ethernet.collisions >= mEthCollisionCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
 
-    collisionCount = count - mEthCollisionCount;
+    collisionCount = snapshot.ethernet.collisions - mEthCollisionCount;
 
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR DiagnosticDataProviderImpl::GetEthOverrunCount(uint64_t & overrunCount)
 {
-    uint64_t count;
+    DiagnosticDataCache::Snapshot snapshot;
 
-    ReturnErrorOnFailure(GetEthernetStatsCount(EthernetStatsCountType::kEthOverrunCount, count));
-    VerifyOrReturnError(count >= mEthOverrunCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
+    ReturnErrorOnFailure(mCache.GetSnapshot(snapshot));
+    VerifyOrReturnError(snapshot.ethernet.valid, CHIP_ERROR_READ_FAILED);
+    VerifyOrReturnError(snapshot.ethernet.rxOverErrors >= mEthOverrunCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
 
-    overrunCount = count - mEthOverrunCount;
+    overrunCount = snapshot.ethernet.rxOverErrors - mEthOverrunCount;
 
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR DiagnosticDataProviderImpl::ResetEthNetworkDiagnosticsCounts()
 {
-    CHIP_ERROR err          = CHIP_ERROR_READ_FAILED;
-    struct ifaddrs * ifaddr = nullptr;
-
-    if (getifaddrs(&ifaddr) == -1)
-    {
-        ChipLogError(DeviceLayer, "Failed to get network interfaces");
-    }
-    else
-    {
-        struct ifaddrs * ifa = nullptr;
-
-        // Walk through linked list, maintaining head pointer so we can free list later.
-        for (ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next)
-        {
-            if (ConnectivityUtils::GetInterfaceConnectionType(ifa->ifa_name) == InterfaceType::EMBER_ZCL_INTERFACE_TYPE_ETHERNET)
-            {
-                ChipLogProgress(DeviceLayer, "Found the primary Ethernet interface:%s", ifa->ifa_name);
-                break;
-            }
-        }
+    DiagnosticDataCache::Snapshot snapshot;
 
-        if (ifa != nullptr)
-        {
-            if (ifa->ifa_addr->sa_family == AF_PACKET && ifa->ifa_data != nullptr)
-            {
-                struct rtnl_link_stats * stats = (struct rtnl_link_stats *) ifa->ifa_data;
-
-                mEthPacketRxCount  = stats->rx_packets;
-                mEthPacketTxCount  = stats->tx_packets;
-                mEthTxErrCount     = stats->tx_errors;
-                mEthCollisionCount = stats->collisions;
-                mEthOverrunCount   = stats->rx_over_errors;
-                err                = CHIP_NO_ERROR;
-            }
-        }
+    // Sample now rather than reading the cache, so that the counts restart from the current values.
+    ReturnErrorOnFailure(DiagnosticDataCache::Sample(snapshot));
+    VerifyOrReturnError(snapshot.ethernet.valid, CHIP_ERROR_READ_FAILED);
 
-        freeifaddrs(ifaddr);
-    }
+    mEthPacketRxCount  = snapshot.ethernet.rxPackets;
+    mEthPacketTxCount  = snapshot.ethernet.txPackets;
+    mEthTxErrCount     = snapshot.ethernet.txErrors;
+    mEthCollisionCount = snapshot.ethernet.collisions;
+    mEthOverrunCount   = snapshot.ethernet.rxOverErrors;
 
-    return err;
+    return CHIP_NO_ERROR;
 }
 
 #if CHIP_DEVICE_CONFIG_ENABLE_WIFI
 CHIP_ERROR DiagnosticDataProviderImpl::GetWiFiChannelNumber(uint16_t & channelNumber)
 {
-    if (ConnectivityMgrImpl().GetWiFiIfName() == nullptr)
-    {
-        return CHIP_ERROR_READ_FAILED;
-    }
+    DiagnosticDataCache::Snapshot snapshot;
 
-    return ConnectivityUtils::GetWiFiChannelNumber(ConnectivityMgrImpl().GetWiFiIfName(), channelNumber);
+    ReturnErrorOnFailure(mCache.GetSnapshot(snapshot));
+    VerifyOrReturnError(snapshot.hasWiFiChannelNumber, CHIP_ERROR_READ_FAILED);
+
+    channelNumber = snapshot.wiFiChannelNumber;
+
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR DiagnosticDataProviderImpl::GetWiFiRssi(int8_t & rssi)
 {
-    if (ConnectivityMgrImpl().GetWiFiIfName() == nullptr)
-    {
-        return CHIP_ERROR_READ_FAILED;
-    }
+    DiagnosticDataCache::Snapshot snapshot;
+
+    ReturnErrorOnFailure(mCache.GetSnapshot(snapshot));
+    VerifyOrReturnError(snapshot.hasWiFiRssi, CHIP_ERROR_READ_FAILED);
+
+    rssi = snapshot.wiFiRssi;
 
-    return ConnectivityUtils::GetWiFiRssi(ConnectivityMgrImpl().GetWiFiIfName(), rssi);
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR DiagnosticDataProviderImpl::GetWiFiBeaconLostCount(uint32_t & beaconLostCount)
 {
-    uint32_t count;
+    DiagnosticDataCache::Snapshot snapshot;
 
-    if (ConnectivityMgrImpl().GetWiFiIfName() == nullptr)
-    {
-        return CHIP_ERROR_READ_FAILED;
-    }
+    ReturnErrorOnFailure(mCache.GetSnapshot(snapshot));
+    VerifyOrReturnError(snapshot.hasWiFiBeaconLostCount, CHIP_ERROR_READ_FAILED);
+    VerifyOrReturnError(snapshot.wiFiBeaconLostCount >= mBeaconLostCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
 
-    ReturnErrorOnFailure(ConnectivityUtils::GetWiFiBeaconLostCount(ConnectivityMgrImpl().GetWiFiIfName(), count));
-    VerifyOrReturnError(count >= mBeaconLostCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
-    beaconLostCount = count - mBeaconLostCount;
+    beaconLostCount = snapshot.wiFiBeaconLostCount - mBeaconLostCount;
 
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR DiagnosticDataProviderImpl::GetWiFiCurrentMaxRate(uint64_t & currentMaxRate)
 {
-    if (ConnectivityMgrImpl().GetWiFiIfName() == nullptr)
-    {
-        return CHIP_ERROR_READ_FAILED;
-    }
+    DiagnosticDataCache::Snapshot snapshot;
+
+    ReturnErrorOnFailure(mCache.GetSnapshot(snapshot));
+    VerifyOrReturnError(snapshot.hasWiFiCurrentMaxRate, CHIP_ERROR_READ_FAILED);
 
-    return ConnectivityUtils::GetWiFiCurrentMaxRate(ConnectivityMgrImpl().GetWiFiIfName(), currentMaxRate);
+    currentMaxRate = snapshot.wiFiCurrentMaxRate;
+
+    return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR DiagnosticDataProviderImpl::GetWiFiPacketMulticastRxCount(uint32_t & packetMulticastRxCount)
 {
-    uint64_t count;
+    DiagnosticDataCache::Snapshot snapshot;
 
-    ReturnErrorOnFailure(GetWiFiStatsCount(WiFiStatsCountType::kWiFiMulticastPacketRxCount, count));
-    VerifyOrReturnError(count >= mPacketMulticastRxCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
+    ReturnErrorOnFailure(mCache.GetSnapshot(snapshot));
+    VerifyOrReturnError(snapshot.wifi.valid, CHIP_ERROR_READ_FAILED);
+    VerifyOrReturnError(snapshot.wifi.multicast >= mPacketMulticastRxCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
 
-    count -= mPacketMulticastRxCount;
+    uint64_t count = snapshot.wifi.multicast - mPacketMulticastRxCount;
     VerifyOrReturnError(count <= UINT32_MAX, CHIP_ERROR_INVALID_INTEGER_VALUE);
 
     packetMulticastRxCount = static_cast<uint32_t>(count);
@@ -666,27 +547,21 @@ CHIP_ERROR DiagnosticDataProviderImpl::GetWiFiPacketMulticastRxCount(uint32_t &
 
 CHIP_ERROR DiagnosticDataProviderImpl::GetWiFiPacketMulticastTxCount(uint32_t & packetMulticastTxCount)
 {
-    uint64_t count;
-
-    ReturnErrorOnFailure(GetWiFiStatsCount(WiFiStatsCountType::kWiFiMulticastPacketTxCount, count));
-    VerifyOrReturnError(count >= mPacketMulticastTxCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
-
-    count -= mPacketMulticastTxCount;
-    VerifyOrReturnError(count <= UINT32_MAX, CHIP_ERROR_INVALID_INTEGER_VALUE);
-
-    packetMulticastTxCount = static_cast<uint32_t>(count);
+    // The multicast packets transmitted are not counted by Linux.
+    packetMulticastTxCount = 0;
 
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR DiagnosticDataProviderImpl::GetWiFiPacketUnicastRxCount(uint32_t & packetUnicastRxCount)
 {
-    uint64_t count;
+    DiagnosticDataCache::Snapshot snapshot;
 
-    ReturnErrorOnFailure(GetWiFiStatsCount(WiFiStatsCountType::kWiFiUnicastPacketRxCount, count));
-    VerifyOrReturnError(count >= mPacketUnicastRxCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
+    ReturnErrorOnFailure(mCache.GetSnapshot(snapshot));
+    VerifyOrReturnError(snapshot.wifi.valid, CHIP_ERROR_READ_FAILED);
+    VerifyOrReturnError(snapshot.wifi.rxPackets >= mPacketUnicastRxCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
 
-    count -= mPacketUnicastRxCount;
+    uint64_t count = snapshot.wifi.rxPackets - mPacketUnicastRxCount;
     VerifyOrReturnError(count <= UINT32_MAX, CHIP_ERROR_INVALID_INTEGER_VALUE);
 
     packetUnicastRxCount = static_cast<uint32_t>(count);
@@ -696,12 +571,13 @@ CHIP_ERROR DiagnosticDataProviderImpl::GetWiFiPacketUnicastRxCount(uint32_t & pa
 
 CHIP_ERROR DiagnosticDataProviderImpl::GetWiFiPacketUnicastTxCount(uint32_t & packetUnicastTxCount)
 {
-    uint64_t count;
+    DiagnosticDataCache::Snapshot snapshot;
 
-    ReturnErrorOnFailure(GetWiFiStatsCount(WiFiStatsCountType::kWiFiUnicastPacketTxCount, count));
-    VerifyOrReturnError(count >= mPacketUnicastTxCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
+    ReturnErrorOnFailure(mCache.GetSnapshot(snapshot));
+    VerifyOrReturnError(snapshot.wifi.valid, CHIP_ERROR_READ_FAILED);
+    VerifyOrReturnError(snapshot.wifi.txPackets >= mPacketUnicastTxCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
 
-    count -= mPacketUnicastTxCount;
+    uint64_t count = snapshot.wifi.txPackets - mPacketUnicastTxCount;
     VerifyOrReturnError(count <= UINT32_MAX, CHIP_ERROR_INVALID_INTEGER_VALUE);
 
     packetUnicastTxCount = static_cast<uint32_t>(count);
@@ -711,61 +587,32 @@ CHIP_ERROR DiagnosticDataProviderImpl::GetWiFiPacketUnicastTxCount(uint32_t & pa
 
 CHIP_ERROR DiagnosticDataProviderImpl::GetWiFiOverrunCount(uint64_t & overrunCount)
 {
-    uint64_t count;
+    DiagnosticDataCache::Snapshot snapshot;
 
-    ReturnErrorOnFailure(GetWiFiStatsCount(WiFiStatsCountType::kWiFiOverrunCount, count));
-    VerifyOrReturnError(count >= mOverrunCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
+    ReturnErrorOnFailure(mCache.GetSnapshot(snapshot));
+    VerifyOrReturnError(snapshot.wifi.valid, CHIP_ERROR_READ_FAILED);
+    VerifyOrReturnError(snapshot.wifi.rxOverErrors >= mOverrunCount, CHIP_ERROR_INVALID_INTEGER_VALUE);
 
-    overrunCount = count - mOverrunCount;
+    overrunCount = snapshot.wifi.rxOverErrors - mOverrunCount;
 
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR DiagnosticDataProviderImpl::ResetWiFiNetworkDiagnosticsCounts()
 {
-    CHIP_ERROR err          = CHIP_ERROR_READ_FAILED;
-    struct ifaddrs * ifaddr = nullptr;
-
-    ReturnErrorOnFailure(GetWiFiBeaconLostCount(mBeaconLostCount));
-
-    if (getifaddrs(&ifaddr) == -1)
-    {
-        ChipLogError(DeviceLayer, "Failed to get network interfaces");
-    }
-    else
-    {
-        struct ifaddrs * ifa = nullptr;
+    DiagnosticDataCache::Snapshot snapshot;
 
-        // Walk through linked list, maintaining head pointer so we can free list later.
-        for (ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next)
-        {
-            if (ConnectivityUtils::GetInterfaceConnectionType(ifa->ifa_name) == InterfaceType::EMBER_ZCL_INTERFACE_TYPE_WI_FI)
-            {
-                ChipLogProgress(DeviceLayer, "Found the primary WiFi interface:%s", ifa->ifa_name);
-                break;
-            }
-        }
+    // Sample now rather than reading the cache, so that the counts restart from the current values.
+    ReturnErrorOnFailure(DiagnosticDataCache::Sample(snapshot));
+    VerifyOrReturnError(snapshot.hasWiFiBeaconLostCount && snapshot.wifi.valid, CHIP_ERROR_READ_FAILED);
 
-        if (ifa != nullptr)
-        {
-            if (ifa->ifa_addr->sa_family == AF_PACKET && ifa->ifa_data != nullptr)
-            {
-                struct rtnl_link_stats * stats = (struct rtnl_link_stats *) ifa->ifa_data;
+    mBeaconLostCount        = snapshot.wiFiBeaconLostCount;
+    mPacketMulticastRxCount = snapshot.wifi.multicast;
+    mPacketUnicastRxCount   = snapshot.wifi.rxPackets;
+    mPacketUnicastTxCount   = snapshot.wifi.txPackets;
+    mOverrunCount           = snapshot.wifi.rxOverErrors;
 
-                mPacketMulticastRxCount = stats->multicast;
-                mPacketMulticastTxCount = 0;
-                mPacketUnicastRxCount   = stats->rx_packets;
-                mPacketUnicastTxCount   = stats->tx_packets;
-                mOverrunCount           = stats->rx_over_errors;
-
-                err = CHIP_NO_ERROR;
-            }
-        }
-
-        freeifaddrs(ifaddr);
-    }
-
-    return err;
+    return CHIP_NO_ERROR;
 }
 #endif // CHIP_DEVICE_CONFIG_ENABLE_WIFI
 
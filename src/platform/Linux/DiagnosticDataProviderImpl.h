@@ -25,6 +25,7 @@
 #include <memory>
 
 #include <platform/DiagnosticDataProvider.h>
+#include <platform/Linux/DiagnosticDataCache.h>
 
 namespace chip {
 namespace DeviceLayer {
@@ -37,6 +38,13 @@ class DiagnosticDataProviderImpl : public DiagnosticDataProvider
 public:
     static DiagnosticDataProviderImpl & GetDefaultInstance();
 
+    /**
+     * Start and stop the background sampling of the diagnostic data, which reports the attributes that changed to the
+     * delegates of the diagnostics clusters.
+     */
+    CHIP_ERROR StartSampling();
+    void StopSampling();
+
     // ===== Methods that implement the PlatformManager abstract interface.
 
     CHIP_ERROR GetCurrentHeapFree(uint64_t & currentHeapFree) override;
@@ -87,6 +95,10 @@ public:
 #endif
 
 private:
+    static void OnDiagnosticDataChanged(BitFlags<Internal::DiagnosticDataChange> changes);
+
+    Internal::DiagnosticDataCache mCache;
+
     uint64_t mEthPacketRxCount  = 0;
     uint64_t mEthPacketTxCount  = 0;
     uint64_t mEthTxErrCount     = 0;
@@ -95,10 +107,9 @@ private:
 
 #if CHIP_DEVICE_CONFIG_ENABLE_WIFI
     uint32_t mBeaconLostCount        = 0;
-    uint32_t mPacketMulticastRxCount = 0;
-    uint32_t mPacketMulticastTxCount = 0;
-    uint32_t mPacketUnicastRxCount   = 0;
-    uint32_t mPacketUnicastTxCount   = 0;
+    uint64_t mPacketMulticastRxCount = 0;
+    uint64_t mPacketUnicastRxCount   = 0;
+    uint64_t mPacketUnicastTxCount   = 0;
     uint64_t mOverrunCount           = 0;
 #endif
 };
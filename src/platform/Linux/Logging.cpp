@@ -2,10 +2,15 @@
 
 #include <platform/logging/LogV.h>
 
+#include <lib/support/logging/CHIPLogging.h>
+#include <platform/CHIPDeviceConfig.h>
+#include <platform/Linux/AsyncLogSink.h>
+
 #include <cinttypes>
 #include <cstdio>
 #include <sys/syscall.h>
 #include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
 
 namespace chip {
@@ -24,11 +29,21 @@ void __attribute__((weak)) OnLogOutput() {}
 namespace Logging {
 namespace Platform {
 
-/**
- * CHIP log output functions.
- */
-void LogV(const char * module, uint8_t category, const char * msg, va_list v)
+namespace {
+
+#if CHIP_DEVICE_CONFIG_LOG_RATE_LIMIT
+DeviceLayer::Internal::LogRateLimiter sRateLimiter(CHIP_DEVICE_CONFIG_LOG_RATE_LIMIT);
+#endif // CHIP_DEVICE_CONFIG_LOG_RATE_LIMIT
+
+void WriteLog(const char * module, uint8_t category, const char * msg, va_list v)
 {
+#if CHIP_DEVICE_CONFIG_LOG_ASYNC
+    if (DeviceLayer::Internal::AsyncLogV(module, category, msg, v))
+    {
+        return;
+    }
+#endif // CHIP_DEVICE_CONFIG_LOG_ASYNC
+
     struct timeval tv;
 
     // Should not fail per man page of gettimeofday(), but failed to get time is not a fatal error in log. The bad time value will
@@ -40,6 +55,43 @@ void LogV(const char * module, uint8_t category, const char * msg, va_list v)
     vprintf(msg, v);
     printf("\n");
     fflush(stdout);
+}
+
+void WriteLogMessage(const char * module, uint8_t category, const char * msg, ...) ENFORCE_FORMAT(3, 4);
+
+void WriteLogMessage(const char * module, uint8_t category, const char * msg, ...)
+{
+    va_list v;
+    va_start(v, msg);
+    WriteLog(module, category, msg, v);
+    va_end(v);
+}
+
+} // namespace
+
+/**
+ * CHIP log output functions.
+ */
+void LogV(const char * module, uint8_t category, const char * msg, va_list v)
+{
+#if CHIP_DEVICE_CONFIG_LOG_RATE_LIMIT
+    struct timespec now;
+    uint32_t suppressedCount;
+
+    // The coarse clock is much cheaper to read, and precise enough for one second windows.
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+    uint64_t nowMs = static_cast<uint64_t>(now.tv_sec) * 1000 + static_cast<uint64_t>(now.tv_nsec) / 1000000;
+    if (!sRateLimiter.Allow(module, category, nowMs, suppressedCount))
+    {
+        return;
+    }
+    if (suppressedCount > 0)
+    {
+        WriteLogMessage(module, category, "%" PRIu32 " messages suppressed by the log rate limit", suppressedCount);
+    }
+#endif // CHIP_DEVICE_CONFIG_LOG_RATE_LIMIT
+
+    WriteLog(module, category, msg, v);
 
     // Let the application know that a log message has been emitted.
     DeviceLayer::OnLogOutput();
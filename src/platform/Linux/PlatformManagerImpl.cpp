@@ -234,6 +234,15 @@ CHIP_ERROR PlatformManagerImpl::_InitChipStack()
 
     mStartTime = System::SystemClock().GetMonotonicTimestamp();
 
+#if CHIP_DEVICE_CONFIG_CRYPTO_OFFLOAD_THREADS > 0 && CHIP_CRYPTO_OPENSSL
+    err = mCryptoWorkerPool.Init();
+    SuccessOrExit(err);
+    Crypto::SetCryptoJobQueue(&mCryptoWorkerPool);
+#endif
+
+    err = DiagnosticDataProviderImpl::GetDefaultInstance().StartSampling();
+    SuccessOrExit(err);
+
     ScheduleWork(HandleDeviceRebooted, 0);
 
 exit:
@@ -269,6 +278,13 @@ CHIP_ERROR PlatformManagerImpl::_Shutdown()
         ChipLogError(DeviceLayer, "Failed to get current uptime since the Node’s last reboot");
     }
 
+    DiagnosticDataProviderImpl::GetDefaultInstance().StopSampling();
+
+#if CHIP_DEVICE_CONFIG_CRYPTO_OFFLOAD_THREADS > 0 && CHIP_CRYPTO_OPENSSL
+    Crypto::SetCryptoJobQueue(nullptr);
+    mCryptoWorkerPool.Shutdown();
+#endif
+
     return Internal::GenericPlatformManagerImpl_POSIX<PlatformManagerImpl>::_Shutdown();
 }
 
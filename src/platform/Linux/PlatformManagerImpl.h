@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include <crypto/CryptoBuildConfig.h>
+#include <platform/Linux/CryptoWorkerPool.h>
 #include <platform/PlatformManager.h>
 #include <platform/internal/GenericPlatformManagerImpl_POSIX.h>
 
@@ -80,6 +82,11 @@ private:
 
     System::Clock::Timestamp mStartTime = System::Clock::kZero;
 
+#if CHIP_DEVICE_CONFIG_CRYPTO_OFFLOAD_THREADS > 0 && CHIP_CRYPTO_OPENSSL
+    // OpenSSL is thread-safe, session establishment crypto can run on worker threads.
+    Internal::CryptoWorkerPool mCryptoWorkerPool;
+#endif
+
     static PlatformManagerImpl sInstance;
 
     // The temporary hack for getting IP address change on linux for network provisioning in the rendezvous session.
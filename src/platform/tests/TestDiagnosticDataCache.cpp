@@ -0,0 +1,280 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the change detection and
+ *      change dispatch of the Linux diagnostic data cache.
+ *
+ */
+
+#include <string.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/TypeTraits.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+
+#include <platform/CHIPDeviceLayer.h>
+#include <platform/Linux/DiagnosticDataCache.h>
+
+namespace chip {
+namespace DeviceLayer {
+namespace Internal {
+
+class TestDiagnosticDataCache
+{
+public:
+    static void TestCompare(nlTestSuite * inSuite, void * inContext);
+    static void TestDispatchRetry(nlTestSuite * inSuite, void * inContext);
+
+private:
+    static CHIP_ERROR FailPost(AsyncWorkFunct work, intptr_t arg);
+    static CHIP_ERROR CapturePost(AsyncWorkFunct work, intptr_t arg);
+    static void OnChanges(BitFlags<DiagnosticDataChange> changes);
+
+    static size_t sPostCount;
+    static AsyncWorkFunct sPostedWork;
+    static intptr_t sPostedArg;
+    static size_t sHandledCount;
+    static BitFlags<DiagnosticDataChange> sHandledChanges;
+};
+
+size_t TestDiagnosticDataCache::sPostCount          = 0;
+AsyncWorkFunct TestDiagnosticDataCache::sPostedWork = nullptr;
+intptr_t TestDiagnosticDataCache::sPostedArg        = 0;
+size_t TestDiagnosticDataCache::sHandledCount       = 0;
+BitFlags<DiagnosticDataChange> TestDiagnosticDataCache::sHandledChanges;
+
+namespace {
+
+// Snapshots are too large for the test stack
+DiagnosticDataCache::Snapshot sPrevious;
+DiagnosticDataCache::Snapshot sCurrent;
+
+void ResetSnapshots()
+{
+    memset(&sPrevious, 0, sizeof(sPrevious));
+    memset(&sCurrent, 0, sizeof(sCurrent));
+}
+
+} // namespace
+
+CHIP_ERROR TestDiagnosticDataCache::FailPost(AsyncWorkFunct work, intptr_t arg)
+{
+    sPostCount++;
+    return CHIP_ERROR_NO_MEMORY;
+}
+
+CHIP_ERROR TestDiagnosticDataCache::CapturePost(AsyncWorkFunct work, intptr_t arg)
+{
+    sPostCount++;
+    sPostedWork = work;
+    sPostedArg  = arg;
+    return CHIP_NO_ERROR;
+}
+
+void TestDiagnosticDataCache::OnChanges(BitFlags<DiagnosticDataChange> changes)
+{
+    sHandledCount++;
+    sHandledChanges = changes;
+}
+
+void TestDiagnosticDataCache::TestCompare(nlTestSuite * inSuite, void * inContext)
+{
+    BitFlags<DiagnosticDataChange> changes;
+
+    ResetSnapshots();
+    NL_TEST_ASSERT(inSuite, !DiagnosticDataCache::Compare(sPrevious, sCurrent).HasAny());
+
+    // A new interface
+    sCurrent.interfaceCount = 1;
+    strcpy(sCurrent.interfaces[0].name, "eth0");
+    changes = DiagnosticDataCache::Compare(sPrevious, sCurrent);
+    NL_TEST_ASSERT(inSuite, changes.Raw() == to_underlying(DiagnosticDataChange::kNetworkInterfaces));
+
+    // An interface coming up
+    sPrevious                      = sCurrent;
+    sCurrent.interfaces[0].running = true;
+    changes                        = DiagnosticDataCache::Compare(sPrevious, sCurrent);
+    NL_TEST_ASSERT(inSuite, changes.Raw() == to_underlying(DiagnosticDataChange::kNetworkInterfaces));
+
+    // A new thread
+    sPrevious             = sCurrent;
+    sCurrent.threadCount  = 1;
+    sCurrent.threadIds[0] = 1234;
+    changes               = DiagnosticDataCache::Compare(sPrevious, sCurrent);
+    NL_TEST_ASSERT(inSuite, changes.Raw() == to_underlying(DiagnosticDataChange::kThreadMetrics));
+
+    // The same number of threads, but a different one
+    sPrevious             = sCurrent;
+    sCurrent.threadIds[0] = 1235;
+    changes               = DiagnosticDataCache::Compare(sPrevious, sCurrent);
+    NL_TEST_ASSERT(inSuite, changes.Raw() == to_underlying(DiagnosticDataChange::kThreadMetrics));
+
+    // The Ethernet counters showing up flag all of them
+    sPrevious               = sCurrent;
+    sCurrent.ethernet.valid = true;
+    changes                 = DiagnosticDataCache::Compare(sPrevious, sCurrent);
+    NL_TEST_ASSERT(inSuite, changes.Has(DiagnosticDataChange::kEthPacketRxCount));
+    NL_TEST_ASSERT(inSuite, changes.Has(DiagnosticDataChange::kEthPacketTxCount));
+    NL_TEST_ASSERT(inSuite, changes.Has(DiagnosticDataChange::kEthTxErrCount));
+    NL_TEST_ASSERT(inSuite, changes.Has(DiagnosticDataChange::kEthCollisionCount));
+    NL_TEST_ASSERT(inSuite, changes.Has(DiagnosticDataChange::kEthOverrunCount));
+    NL_TEST_ASSERT(inSuite, !changes.Has(DiagnosticDataChange::kEthPHYRate));
+
+    // Then each counter only flags itself
+    sPrevious                   = sCurrent;
+    sCurrent.ethernet.rxPackets = 10;
+    changes                     = DiagnosticDataCache::Compare(sPrevious, sCurrent);
+    NL_TEST_ASSERT(inSuite, changes.Raw() == to_underlying(DiagnosticDataChange::kEthPacketRxCount));
+
+    sPrevious                    = sCurrent;
+    sCurrent.ethernet.collisions = 1;
+    sCurrent.ethernet.txErrors   = 2;
+    changes                      = DiagnosticDataCache::Compare(sPrevious, sCurrent);
+    NL_TEST_ASSERT(inSuite, changes.Has(DiagnosticDataChange::kEthCollisionCount));
+    NL_TEST_ASSERT(inSuite, changes.Has(DiagnosticDataChange::kEthTxErrCount));
+    NL_TEST_ASSERT(inSuite, !changes.Has(DiagnosticDataChange::kEthPacketRxCount));
+
+    sPrevious              = sCurrent;
+    sCurrent.hasEthPHYRate = true;
+    changes                = DiagnosticDataCache::Compare(sPrevious, sCurrent);
+    NL_TEST_ASSERT(inSuite, changes.Raw() == to_underlying(DiagnosticDataChange::kEthPHYRate));
+
+    sPrevious                 = sCurrent;
+    sCurrent.hasEthFullDuplex = true;
+    sCurrent.ethFullDuplex    = true;
+    changes                   = DiagnosticDataCache::Compare(sPrevious, sCurrent);
+    NL_TEST_ASSERT(inSuite, changes.Raw() == to_underlying(DiagnosticDataChange::kEthFullDuplex));
+
+#if CHIP_DEVICE_CONFIG_ENABLE_WIFI
+    sPrevious           = sCurrent;
+    sCurrent.wifi.valid = true;
+    changes             = DiagnosticDataCache::Compare(sPrevious, sCurrent);
+    NL_TEST_ASSERT(inSuite, changes.Has(DiagnosticDataChange::kWiFiPacketMulticastRxCount));
+    NL_TEST_ASSERT(inSuite, changes.Has(DiagnosticDataChange::kWiFiPacketUnicastRxCount));
+    NL_TEST_ASSERT(inSuite, changes.Has(DiagnosticDataChange::kWiFiPacketUnicastTxCount));
+    NL_TEST_ASSERT(inSuite, changes.Has(DiagnosticDataChange::kWiFiOverrunCount));
+
+    sPrevious               = sCurrent;
+    sCurrent.hasWiFiRssi    = true;
+    sCurrent.wiFiRssi       = -40;
+    sCurrent.wifi.multicast = 3;
+    changes                 = DiagnosticDataCache::Compare(sPrevious, sCurrent);
+    NL_TEST_ASSERT(inSuite, changes.Has(DiagnosticDataChange::kWiFiRssi));
+    NL_TEST_ASSERT(inSuite, changes.Has(DiagnosticDataChange::kWiFiPacketMulticastRxCount));
+    NL_TEST_ASSERT(inSuite, !changes.Has(DiagnosticDataChange::kWiFiPacketUnicastRxCount));
+#endif
+
+    sPrevious = sCurrent;
+    NL_TEST_ASSERT(inSuite, !DiagnosticDataCache::Compare(sPrevious, sCurrent).HasAny());
+}
+
+void TestDiagnosticDataCache::TestDispatchRetry(nlTestSuite * inSuite, void * inContext)
+{
+    DiagnosticDataCache cache;
+    DiagnosticDataCache::Snapshot & next = cache.mNextSnapshot;
+
+    // Stand in for a running sampler, without the thread
+    memset(&cache.mSnapshot, 0, sizeof(cache.mSnapshot));
+    memset(&next, 0, sizeof(next));
+    cache.mChangeHandler = OnChanges;
+    cache.mRunning       = true;
+    sPostCount           = 0;
+    sHandledCount        = 0;
+
+    // A sample without changes dispatches nothing
+    cache.mPostWork = CapturePost;
+    cache.PublishSample(CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sPostCount == 0);
+
+    // The dispatch cannot be posted: the change stays pending
+    cache.mPostWork   = FailPost;
+    next.threadCount  = 1;
+    next.threadIds[0] = 1234;
+    cache.PublishSample(CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sPostCount == 1);
+    NL_TEST_ASSERT(inSuite, !cache.mDispatchScheduled);
+    NL_TEST_ASSERT(inSuite, cache.mPendingChanges.Has(DiagnosticDataChange::kThreadMetrics));
+
+    // The next sample retries, even though nothing changed since
+    cache.mPostWork = CapturePost;
+    cache.PublishSample(CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sPostCount == 2);
+    NL_TEST_ASSERT(inSuite, cache.mDispatchScheduled);
+    NL_TEST_ASSERT(inSuite, sPostedWork != nullptr);
+
+    // Changes found while the dispatch is queued join it rather than posting again
+    next.ethernet.valid     = true;
+    next.ethernet.rxPackets = 5;
+    cache.PublishSample(CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sPostCount == 2);
+
+    // The dispatch hands every pending change to the handler at once
+    sPostedWork(sPostedArg);
+    NL_TEST_ASSERT(inSuite, sHandledCount == 1);
+    NL_TEST_ASSERT(inSuite, sHandledChanges.Has(DiagnosticDataChange::kThreadMetrics));
+    NL_TEST_ASSERT(inSuite, sHandledChanges.Has(DiagnosticDataChange::kEthPacketRxCount));
+    NL_TEST_ASSERT(inSuite, !cache.mPendingChanges.HasAny());
+    NL_TEST_ASSERT(inSuite, !cache.mDispatchScheduled);
+
+    // A failed sample is reported to readers until the next good one
+    DiagnosticDataCache::Snapshot & snapshot = sCurrent;
+    cache.PublishSample(CHIP_ERROR_READ_FAILED);
+    NL_TEST_ASSERT(inSuite, cache.GetSnapshot(snapshot) == CHIP_ERROR_READ_FAILED);
+    NL_TEST_ASSERT(inSuite, sPostCount == 2);
+    cache.PublishSample(CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.GetSnapshot(snapshot) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, snapshot.threadCount == 1 && snapshot.ethernet.rxPackets == 5);
+
+    // Once shut down, a queued dispatch no longer reaches the handler
+    next.ethernet.rxPackets = 6;
+    cache.PublishSample(CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sPostCount == 3);
+    cache.mRunning = false;
+    sPostedWork(sPostedArg);
+    NL_TEST_ASSERT(inSuite, sHandledCount == 1);
+}
+
+} // namespace Internal
+} // namespace DeviceLayer
+} // namespace chip
+
+namespace {
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+const nlTest sTests[] = {
+    NL_TEST_DEF("Test comparison of diagnostic samples", chip::DeviceLayer::Internal::TestDiagnosticDataCache::TestCompare),
+    NL_TEST_DEF("Test dispatch of diagnostic changes", chip::DeviceLayer::Internal::TestDiagnosticDataCache::TestDispatchRetry),
+
+    NL_TEST_SENTINEL()
+};
+
+} // namespace
+
+int TestDiagnosticDataCache()
+{
+    nlTestSuite theSuite = { "Linux diagnostic data cache tests", &sTests[0], nullptr, nullptr };
+
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestDiagnosticDataCache)
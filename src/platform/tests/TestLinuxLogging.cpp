@@ -0,0 +1,259 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements a unit test suite for the deferred formatting,
+ *      asynchronous output and rate limiting of Linux log output.
+ *
+ */
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <lib/support/logging/CHIPLogging.h>
+#include <nlunit-test.h>
+
+#include <platform/Linux/AsyncLogSink.h>
+#include <platform/Linux/DeferredLogFormatter.h>
+
+using namespace chip;
+using namespace chip::Logging;
+using namespace chip::DeviceLayer::Internal;
+
+namespace {
+
+uint8_t sEncodedArgs[512];
+char sExpected[256];
+char sActual[256];
+
+int Encode(size_t bufferSize, const char * format, ...) ENFORCE_FORMAT(2, 3);
+
+int Encode(size_t bufferSize, const char * format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int encodedLength = EncodeLogArgs(sEncodedArgs, bufferSize, format, args);
+    va_end(args);
+    return encodedLength;
+}
+
+// Returns the length of the encoded arguments, or -1 if the format cannot be deferred.
+int EncodeAndFormat(size_t outSize, const char * format, ...) ENFORCE_FORMAT(2, 3);
+
+int EncodeAndFormat(size_t outSize, const char * format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    vsnprintf(sExpected, outSize, format, args);
+    va_end(args);
+
+    va_start(args, format);
+    int encodedLength = EncodeLogArgs(sEncodedArgs, sizeof(sEncodedArgs), format, args);
+    va_end(args);
+
+    memset(sActual, 'x', sizeof(sActual));
+    if (encodedLength >= 0)
+    {
+        size_t length = FormatLogArgs(sActual, outSize, format, sEncodedArgs, static_cast<size_t>(encodedLength));
+        if (length != strlen(sActual))
+        {
+            return -1;
+        }
+    }
+    return encodedLength;
+}
+
+#define NL_TEST_ASSERT_FORMAT(inSuite, format, ...)                                                                                \
+    do                                                                                                                             \
+    {                                                                                                                              \
+        NL_TEST_ASSERT(inSuite, EncodeAndFormat(sizeof(sActual), format, __VA_ARGS__) >= 0);                                     \
+        NL_TEST_ASSERT(inSuite, strcmp(sExpected, sActual) == 0);                                                                  \
+    } while (false)
+
+void TestFormatIntegers(nlTestSuite * inSuite, void * inContext)
+{
+    NL_TEST_ASSERT_FORMAT(inSuite, "no arguments%s", "");
+    NL_TEST_ASSERT_FORMAT(inSuite, "%d %i %u %x %X %o", -1, 2, 3u, 0xabu, 0xcdu, 8u);
+    NL_TEST_ASSERT_FORMAT(inSuite, "%hhd %hu %ld %lu %lld %llx", static_cast<signed char>(-5), static_cast<unsigned short>(65535),
+                          -100000L, 100000UL, -1LL, 0x123456789abcdefULL);
+    NL_TEST_ASSERT_FORMAT(inSuite, "%zu %td %jd", sizeof(sActual), static_cast<ptrdiff_t>(-3), static_cast<intmax_t>(INT64_MIN));
+    NL_TEST_ASSERT_FORMAT(inSuite, "0x%016" PRIX64 " %" PRIu32 " %" PRIu16 " %" PRIu8, UINT64_MAX, UINT32_MAX, UINT16_MAX,
+                          UINT8_MAX);
+    NL_TEST_ASSERT_FORMAT(inSuite, "[%-5d] [%05d] [%+d] [%#x] [% d]", 1, 2, 3, 4u, 5);
+    NL_TEST_ASSERT_FORMAT(inSuite, "[%*d] [%-*d] [%.*d] [%*.*d]", 6, 1, 6, 2, 3, 3, 6, 3, 4);
+    NL_TEST_ASSERT_FORMAT(inSuite, "%c%c 100%%", 'o', 'k');
+}
+
+void TestFormatOthers(nlTestSuite * inSuite, void * inContext)
+{
+    NL_TEST_ASSERT_FORMAT(inSuite, "%f %.2f %e %g %Lf", 3.14159, 2.71828, 1e-10, 0.5, static_cast<long double>(1.25));
+    NL_TEST_ASSERT_FORMAT(inSuite, "%p %p", static_cast<void *>(sActual), static_cast<void *>(nullptr));
+    NL_TEST_ASSERT_FORMAT(inSuite, "%s, %s!", "Hello", "world");
+    NL_TEST_ASSERT_FORMAT(inSuite, "[%10s] [%-10s] [%.3s]", "right", "left", "truncated");
+
+    // Strings with a precision need not be null-terminated.
+    const char unterminated[] = { 'a', 'b', 'c' };
+    NL_TEST_ASSERT_FORMAT(inSuite, "%.*s|%.3s", static_cast<int>(sizeof(unterminated)), unterminated, unterminated);
+
+    const char * nullString = nullptr;
+    NL_TEST_ASSERT_FORMAT(inSuite, "[%s] [%s] [%.0s]", "", nullString, nullString);
+}
+
+void TestFormatTruncated(nlTestSuite * inSuite, void * inContext)
+{
+    NL_TEST_ASSERT(inSuite, EncodeAndFormat(8, "%s and %d", "truncated", 42) >= 0);
+    NL_TEST_ASSERT(inSuite, strcmp(sActual, "truncat") == 0);
+
+    NL_TEST_ASSERT(inSuite, EncodeAndFormat(8, "literal text") >= 0);
+    NL_TEST_ASSERT(inSuite, strcmp(sActual, "literal") == 0);
+
+    NL_TEST_ASSERT(inSuite, EncodeAndFormat(8, "ab%dcd", 12345) >= 0);
+    NL_TEST_ASSERT(inSuite, strcmp(sExpected, sActual) == 0);
+
+    NL_TEST_ASSERT(inSuite, EncodeAndFormat(1, "%d", 1) >= 0);
+    NL_TEST_ASSERT(inSuite, sActual[0] == '\0');
+}
+
+void TestFormatUnsupported(nlTestSuite * inSuite, void * inContext)
+{
+    int count;
+    NL_TEST_ASSERT(inSuite, Encode(sizeof(sEncodedArgs), "%d%n", 1, &count) < 0);
+    NL_TEST_ASSERT(inSuite, Encode(sizeof(sEncodedArgs), "%m") < 0);
+    NL_TEST_ASSERT(inSuite, Encode(sizeof(sEncodedArgs), "%1$d", 1) < 0);
+    NL_TEST_ASSERT(inSuite, Encode(sizeof(sEncodedArgs), "%ls", L"wide") < 0);
+
+    // The arguments do not fit.
+    NL_TEST_ASSERT(inSuite, Encode(4, "%s", "too long for the buffer") < 0);
+    NL_TEST_ASSERT(inSuite, Encode(4, "%llu", 1ULL) < 0);
+    NL_TEST_ASSERT(inSuite, Encode(8, "%llu", 1ULL) == 8);
+}
+
+bool LogAsync(const char * format, ...) ENFORCE_FORMAT(1, 2);
+
+bool LogAsync(const char * format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    bool queued = AsyncLogV("TST", kLogCategory_Detail, format, args);
+    va_end(args);
+    return queued;
+}
+
+void TestAsyncRuntimeFormat(nlTestSuite * inSuite, void * inContext)
+{
+    char format[32];
+    char output[256] = {};
+
+    // Write stdout to a temporary file while the message is logged and written out.
+    fflush(stdout);
+    FILE * file     = tmpfile();
+    int savedStdout = dup(STDOUT_FILENO);
+    NL_TEST_ASSERT(inSuite, file != nullptr && savedStdout >= 0);
+    VerifyOrReturn(file != nullptr && savedStdout >= 0);
+    dup2(fileno(file), STDOUT_FILENO);
+
+    // The format is built at runtime and reused right after the message is logged, before it is written out.
+    strcpy(format, "runtime format %d");
+    bool queued = LogAsync(format, 42);
+    strcpy(format, "overwritten %d");
+    FlushAsyncLog();
+
+    fflush(stdout);
+    dup2(savedStdout, STDOUT_FILENO);
+    close(savedStdout);
+
+    rewind(file);
+    size_t length = fread(output, 1, sizeof(output) - 1, file);
+    fclose(file);
+
+    // Nothing is queued when asynchronous output is disabled by CHIP_LOG_SYNC.
+    if (queued)
+    {
+        NL_TEST_ASSERT(inSuite, length > 0);
+        NL_TEST_ASSERT(inSuite, strstr(output, "CHIP:TST: runtime format 42\n") != nullptr);
+    }
+}
+
+void TestRateLimiter(nlTestSuite * inSuite, void * inContext)
+{
+    LogRateLimiter limiter(3);
+    uint32_t suppressedCount;
+
+    for (int i = 0; i < 3; i++)
+    {
+        NL_TEST_ASSERT(inSuite, limiter.Allow("EM", kLogCategory_Detail, 1000, suppressedCount));
+        NL_TEST_ASSERT(inSuite, suppressedCount == 0);
+    }
+    NL_TEST_ASSERT(inSuite, !limiter.Allow("EM", kLogCategory_Detail, 1500, suppressedCount));
+    NL_TEST_ASSERT(inSuite, !limiter.Allow("EM", kLogCategory_Detail, 1999, suppressedCount));
+
+    // Other modules are counted separately.
+    NL_TEST_ASSERT(inSuite, limiter.Allow("IM", kLogCategory_Detail, 1999, suppressedCount));
+
+    // Errors, progress and automation messages are never limited, since tools and test scripts rely on them.
+    for (int i = 0; i < 10; i++)
+    {
+        NL_TEST_ASSERT(inSuite, limiter.Allow("EM", kLogCategory_Error, 1999, suppressedCount));
+        NL_TEST_ASSERT(inSuite, limiter.Allow("EM", kLogCategory_Progress, 1999, suppressedCount));
+        NL_TEST_ASSERT(inSuite, limiter.Allow("EM", kLogCategory_Automation, 1999, suppressedCount));
+    }
+
+    // The next window reports what was suppressed, once.
+    NL_TEST_ASSERT(inSuite, limiter.Allow("EM", kLogCategory_Detail, 2000, suppressedCount));
+    NL_TEST_ASSERT(inSuite, suppressedCount == 2);
+    NL_TEST_ASSERT(inSuite, limiter.Allow("EM", kLogCategory_Detail, 2001, suppressedCount));
+    NL_TEST_ASSERT(inSuite, suppressedCount == 0);
+
+    LogRateLimiter unlimited(0);
+    for (int i = 0; i < 1000; i++)
+    {
+        NL_TEST_ASSERT(inSuite, unlimited.Allow("EM", kLogCategory_Detail, 1000, suppressedCount));
+    }
+}
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+const nlTest sTests[] = {
+    NL_TEST_DEF("Test deferred formatting of integers", TestFormatIntegers),
+    NL_TEST_DEF("Test deferred formatting of other types", TestFormatOthers),
+    NL_TEST_DEF("Test deferred formatting with truncation", TestFormatTruncated),
+    NL_TEST_DEF("Test formats that cannot be deferred", TestFormatUnsupported),
+    NL_TEST_DEF("Test asynchronous output of a format built at runtime", TestAsyncRuntimeFormat),
+    NL_TEST_DEF("Test log rate limiter", TestRateLimiter),
+
+    NL_TEST_SENTINEL()
+};
+
+} // namespace
+
+int TestLinuxLogging()
+{
+    nlTestSuite theSuite = { "Linux logging tests", &sTests[0], nullptr, nullptr };
+
+    nlTestRunner(&theSuite, nullptr);
+    return nlTestRunnerStats(&theSuite);
+}
+
+CHIP_REGISTER_TEST_SUITE(TestLinuxLogging)
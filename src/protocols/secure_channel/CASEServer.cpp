@@ -29,6 +29,22 @@ using namespace ::chip::Credentials;
 
 namespace chip {
 
+CASEServer::~CASEServer()
+{
+    if (mExchangeManager != nullptr)
+    {
+        mExchangeManager->UnregisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1);
+    }
+
+    for (Responder & responder : mResponders)
+    {
+        if (responder.mInUse)
+        {
+            mSessionManager->SystemLayer()->CancelTimer(OnHandshakeTimeout, &responder);
+        }
+    }
+}
+
 CHIP_ERROR CASEServer::ListenForSessionEstablishment(Messaging::ExchangeManager * exchangeManager, TransportMgrBase * transportMgr,
                                                      Ble::BleLayer * bleLayer, SessionManager * sessionManager,
                                                      FabricTable * fabrics, SessionIDAllocator * idAllocator)
@@ -38,17 +54,82 @@ CHIP_ERROR CASEServer::ListenForSessionEstablishment(Messaging::ExchangeManager
     VerifyOrReturnError(sessionManager != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(fabrics != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
 
+    for (Responder & responder : mResponders)
+    {
+        if (responder.mInUse)
+        {
+            Release(responder, true);
+        }
+        responder.mServer = this;
+    }
+
     mBleLayer        = bleLayer;
     mSessionManager  = sessionManager;
     mFabrics         = fabrics;
     mExchangeManager = exchangeManager;
     mIDAllocator     = idAllocator;
 
-    Cleanup();
-    return CHIP_NO_ERROR;
+    // Sigma1 stays registered for the lifetime of the server, the responder pool does the admission control.
+    return mExchangeManager->RegisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1, this);
+}
+
+size_t CASEServer::GetActiveHandshakeCount() const
+{
+    size_t count = 0;
+    for (const Responder & responder : mResponders)
+    {
+        count += responder.mInUse ? 1 : 0;
+    }
+    return count;
+}
+
+CASEServer::Responder * CASEServer::AdmitPeer(const Transport::PeerAddress & peerAddress)
+{
+    Responder * peerOldest = nullptr;
+    size_t peerHandshakes  = 0;
+
+    for (Responder & responder : mResponders)
+    {
+        if (!responder.mInUse)
+        {
+            return &responder;
+        }
+
+        if (responder.mPeerAddress == peerAddress)
+        {
+            peerHandshakes++;
+            if (peerOldest == nullptr || responder.mStartOrder < peerOldest->mStartOrder)
+            {
+                peerOldest = &responder;
+            }
+        }
+    }
+
+    // All the responders are busy. The initiator would not start over from the same address unless it gave up on its
+    // previous attempt, so that one can go.
+    if (peerOldest != nullptr && peerHandshakes >= CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS_PER_PEER)
+    {
+        ChipLogProgress(Inet, "CASE Server replacing a pending handshake of the same peer");
+        Release(*peerOldest, true);
+        return peerOldest;
+    }
+
+    return nullptr;
+}
+
+CHIP_ERROR CASEServer::Claim(Responder & responder, const Transport::PeerAddress & peerAddress)
+{
+    ReturnErrorOnFailure(mIDAllocator->Allocate(responder.mSessionKeyId));
+    responder.mInUse       = true;
+    responder.mStartOrder  = ++mStartCount;
+    responder.mPeerAddress = peerAddress;
+
+    // Reclaim the slot if the initiator goes away in the middle of the handshake.
+    return mSessionManager->SystemLayer()->StartTimer(
+        System::Clock::Milliseconds32(CHIP_CONFIG_DEFAULT_SECURITY_SESSION_ESTABLISHMENT_TIMEOUT), OnHandshakeTimeout, &responder);
 }
 
-CHIP_ERROR CASEServer::InitCASEHandshake(Messaging::ExchangeContext * ec)
+CHIP_ERROR CASEServer::InitCASEHandshake(Responder & responder, Messaging::ExchangeContext * ec)
 {
     ReturnErrorCodeIf(ec == nullptr, CHIP_ERROR_INVALID_ARGUMENT);
 
@@ -68,14 +149,12 @@ CHIP_ERROR CASEServer::InitCASEHandshake(Messaging::ExchangeContext * ec)
     }
 #endif
 
-    ReturnErrorOnFailure(mIDAllocator->Allocate(mSessionKeyId));
-
     // Setup CASE state machine using the credentials for the current fabric.
-    ReturnErrorOnFailure(GetSession().ListenForSessionEstablishment(
-        mSessionKeyId, mFabrics, this, Optional<ReliableMessageProtocolConfig>::Value(gDefaultMRPConfig)));
+    ReturnErrorOnFailure(GetSession(responder).ListenForSessionEstablishment(
+        responder.mSessionKeyId, mFabrics, &responder, Optional<ReliableMessageProtocolConfig>::Value(gDefaultMRPConfig)));
 
     // Hand over the exchange context to the CASE session.
-    ec->SetDelegate(&GetSession());
+    ec->SetDelegate(&GetSession(responder));
 
     return CHIP_NO_ERROR;
 }
@@ -83,60 +162,85 @@ CHIP_ERROR CASEServer::InitCASEHandshake(Messaging::ExchangeContext * ec)
 CHIP_ERROR CASEServer::OnMessageReceived(Messaging::ExchangeContext * ec, const PayloadHeader & payloadHeader,
                                          System::PacketBufferHandle && payload)
 {
-    ChipLogProgress(Inet, "CASE Server received Sigma1 message. Starting handshake. EC %p", ec);
-    CHIP_ERROR err = InitCASEHandshake(ec);
+    CHIP_ERROR err                             = CHIP_NO_ERROR;
+    Responder * responder                      = nullptr;
+    const Transport::PeerAddress * peerAddress = nullptr;
+
+    VerifyOrExit(ec != nullptr, err = CHIP_ERROR_INVALID_ARGUMENT);
+
+    peerAddress = ec->GetSessionHandle().GetPeerAddress(mSessionManager);
+    VerifyOrExit(peerAddress != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+
+    responder = AdmitPeer(*peerAddress);
+    VerifyOrExit(responder != nullptr, err = CHIP_ERROR_NO_MEMORY;
+                 ChipLogError(Inet, "CASE Server has no free responder, dropping Sigma1. EC %p", ec));
+
+    err = Claim(*responder, *peerAddress);
     SuccessOrExit(err);
 
-    // TODO - Enable multiple concurrent CASE session establishment
-    // https://github.com/project-chip/connectedhomeip/issues/8342
-    ChipLogProgress(Inet, "CASE Server disabling CASE session setups");
-    mExchangeManager->UnregisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1);
+    ChipLogProgress(Inet, "CASE Server received Sigma1 message. Starting handshake. EC %p", ec);
+    err = InitCASEHandshake(*responder, ec);
+    SuccessOrExit(err);
 
-    err = GetSession().OnMessageReceived(ec, payloadHeader, std::move(payload));
+    err = GetSession(*responder).OnMessageReceived(ec, payloadHeader, std::move(payload));
     SuccessOrExit(err);
 
 exit:
-    if (err != CHIP_NO_ERROR)
+    if (err != CHIP_NO_ERROR && responder != nullptr && responder->mInUse)
     {
-        Cleanup();
+        Release(*responder, true);
     }
     return err;
 }
 
-void CASEServer::Cleanup()
+void CASEServer::Release(Responder & responder, bool freeSessionKeyId)
 {
-    // Let's re-register for CASE Sigma1 message, so that the next CASE session setup request can be processed.
-    // https://github.com/project-chip/connectedhomeip/issues/8342
-    ChipLogProgress(Inet, "CASE Server enabling CASE session setups");
-    mExchangeManager->RegisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1, this);
+    mSessionManager->SystemLayer()->CancelTimer(OnHandshakeTimeout, &responder);
 
-    GetSession().Clear();
+    if (freeSessionKeyId)
+    {
+        mIDAllocator->Free(responder.mSessionKeyId);
+    }
+
+    responder.mInUse       = false;
+    responder.mPeerAddress = Transport::PeerAddress();
+    GetSession(responder).Clear();
 }
 
-void CASEServer::OnSessionEstablishmentError(CHIP_ERROR err)
+void CASEServer::OnHandshakeTimeout(System::Layer * systemLayer, void * appState)
+{
+    Responder * responder = static_cast<Responder *>(appState);
+    ChipLogError(Inet, "CASE Session establishment timed out, reclaiming the responder");
+    responder->mServer->Release(*responder, true);
+}
+
+void CASEServer::OnSessionEstablishmentError(Responder & responder, CHIP_ERROR err)
 {
     ChipLogProgress(Inet, "CASE Session establishment failed: %s", ErrorStr(err));
-    mIDAllocator->Free(mSessionKeyId);
-    Cleanup();
+    Release(responder, true);
 }
 
-void CASEServer::OnSessionEstablished()
+void CASEServer::OnSessionEstablished(Responder & responder)
 {
+    CASESession & session = GetSession(responder);
+
     ChipLogProgress(Inet, "CASE Session established. Setting up the secure channel.");
-    mSessionManager->ExpireAllPairings(GetSession().GetPeerNodeId(), GetSession().GetFabricIndex());
+    mSessionManager->ExpireAllPairings(session.GetPeerNodeId(), session.GetFabricIndex());
 
     SessionHolder sessionHolder;
-    CHIP_ERROR err = mSessionManager->NewPairing(
-        sessionHolder, Optional<Transport::PeerAddress>::Value(GetSession().GetPeerAddress()), GetSession().GetPeerNodeId(),
-        &GetSession(), CryptoContext::SessionRole::kResponder, GetSession().GetFabricIndex());
+    CHIP_ERROR err =
+        mSessionManager->NewPairing(sessionHolder, Optional<Transport::PeerAddress>::Value(session.GetPeerAddress()),
+                                    session.GetPeerNodeId(), &session, CryptoContext::SessionRole::kResponder,
+                                    session.GetFabricIndex());
     if (err != CHIP_NO_ERROR)
     {
         ChipLogError(Inet, "Failed in setting up secure channel: err %s", ErrorStr(err));
-        OnSessionEstablishmentError(err);
+        OnSessionEstablishmentError(responder, err);
         return;
     }
 
     ChipLogProgress(Inet, "CASE secure channel is available now.");
-    Cleanup();
+    // The session key id now belongs to the secure session.
+    Release(responder, false);
 }
 } // namespace chip
@@ -25,49 +25,86 @@
 
 namespace chip {
 
-class CASEServer : public SessionEstablishmentDelegate, public Messaging::ExchangeDelegate
+/**
+ * Responds to CASE session establishment requests.
+ *
+ * Up to CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS handshakes are run concurrently, each one in its own responder slot.
+ * When all the slots are busy, a new Sigma1 from a peer address (IP address and port) that already holds
+ * CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS_PER_PEER slots replaces the oldest handshake of that address, which was most
+ * likely abandoned by a restarted initiator; any other Sigma1 is dropped. Pending handshakes are never abandoned while a
+ * slot is free. Slots of handshakes that don't complete within CHIP_CONFIG_DEFAULT_SECURITY_SESSION_ESTABLISHMENT_TIMEOUT
+ * are reclaimed.
+ */
+class CASEServer : public Messaging::ExchangeDelegate
 {
 public:
     CASEServer() {}
-    ~CASEServer()
-    {
-        if (mExchangeManager != nullptr)
-        {
-            mExchangeManager->UnregisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1);
-        }
-    }
+    virtual ~CASEServer();
 
     CHIP_ERROR ListenForSessionEstablishment(Messaging::ExchangeManager * exchangeManager, TransportMgrBase * transportMgr,
                                              Ble::BleLayer * bleLayer, SessionManager * sessionManager, FabricTable * fabrics,
                                              SessionIDAllocator * idAllocator);
 
-    //////////// SessionEstablishmentDelegate Implementation ///////////////
-    void OnSessionEstablishmentError(CHIP_ERROR error) override;
-    void OnSessionEstablished() override;
-
     //// ExchangeDelegate Implementation ////
     CHIP_ERROR OnMessageReceived(Messaging::ExchangeContext * ec, const PayloadHeader & payloadHeader,
                                  System::PacketBufferHandle && payload) override;
     void OnResponseTimeout(Messaging::ExchangeContext * ec) override {}
-    Messaging::ExchangeMessageDispatch & GetMessageDispatch() override { return GetSession().GetMessageDispatch(); }
+    Messaging::ExchangeMessageDispatch & GetMessageDispatch() override
+    {
+        return SessionEstablishmentExchangeDispatch::Instance();
+    }
 
-    virtual CASESession & GetSession() { return mPairingSession; }
+    /**
+     * Returns the session run by the responder slot at @a index, @a index being lower than
+     * CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS.
+     */
+    virtual CASESession & GetSession(size_t index) { return mResponders[index].mSession; }
+
+    /**
+     * Returns the number of handshakes currently in progress.
+     */
+    size_t GetActiveHandshakeCount() const;
 
 private:
+    class Responder : public SessionEstablishmentDelegate
+    {
+    public:
+        //////////// SessionEstablishmentDelegate Implementation ///////////////
+        void OnSessionEstablishmentError(CHIP_ERROR error) override { mServer->OnSessionEstablishmentError(*this, error); }
+        void OnSessionEstablished() override { mServer->OnSessionEstablished(*this); }
+
+        CASEServer * mServer = nullptr;
+        CASESession mSession;
+        Transport::PeerAddress mPeerAddress;
+        uint32_t mStartOrder   = 0;
+        uint16_t mSessionKeyId = 0;
+        bool mInUse            = false;
+    };
+
     Messaging::ExchangeManager * mExchangeManager = nullptr;
 
-    CASESession mPairingSession;
-    uint16_t mSessionKeyId           = 0;
+    Responder mResponders[CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS];
+    uint32_t mStartCount             = 0;
     SessionManager * mSessionManager = nullptr;
     Ble::BleLayer * mBleLayer        = nullptr;
 
     FabricTable * mFabrics = nullptr;
 
-    CHIP_ERROR InitCASEHandshake(Messaging::ExchangeContext * ec);
+    Responder * AdmitPeer(const Transport::PeerAddress & peerAddress);
+    CHIP_ERROR Claim(Responder & responder, const Transport::PeerAddress & peerAddress);
+    CHIP_ERROR InitCASEHandshake(Responder & responder, Messaging::ExchangeContext * ec);
 
     SessionIDAllocator * mIDAllocator = nullptr;
 
-    void Cleanup();
+    CASESession & GetSession(Responder & responder) { return GetSession(static_cast<size_t>(&responder - mResponders)); }
+
+    void OnSessionEstablishmentError(Responder & responder, CHIP_ERROR error);
+    void OnSessionEstablished(Responder & responder);
+    static void OnHandshakeTimeout(System::Layer * systemLayer, void * appState);
+
+    void Release(Responder & responder, bool freeSessionKeyId);
+
+    friend class TestCASEServer;
 };
 
 } // namespace chip
@@ -37,6 +37,7 @@
 #include <lib/support/TypeTraits.h>
 #include <protocols/Protocols.h>
 #include <protocols/secure_channel/StatusReport.h>
+#include <system/SystemTrace.h>
 #include <system/TLVPacketBufferBackingStore.h>
 #include <transport/PairingSession.h>
 #include <transport/SessionManager.h>
@@ -83,11 +84,98 @@ using HKDF_sha_crypto = HKDF_shaHSM;
 using HKDF_sha_crypto = HKDF_sha;
 #endif
 
+#ifdef ENABLE_HSM_CASE_OPS_KEY
+using OperationalKeypair = P256KeypairHSM;
+#else
+using OperationalKeypair = P256Keypair;
+#endif
+
 // Wait at most 30 seconds for the response from the peer.
 // This timeout value assumes the underlying transport is reliable.
 // The session establishment fails if the response is not received within timeout window.
 static constexpr ExchangeContext::Timeout kSigma_Response_Timeout = System::Clock::Seconds16(30);
 
+class CASESession::SigmaSignJob : public CryptoJob
+{
+public:
+    CHIP_ERROR Init(const ByteSpan & nocCert, const ByteSpan & icaCert, const P256Keypair & operationalKey)
+    {
+        // The job can't rely on the fabric certificates staying put while it runs.
+        VerifyOrReturnError(mCerts.Alloc(nocCert.size() + icaCert.size()), CHIP_ERROR_NO_MEMORY);
+        memcpy(mCerts.Get(), nocCert.data(), nocCert.size());
+        memcpy(mCerts.Get() + nocCert.size(), icaCert.data(), icaCert.size());
+        mNOC  = ByteSpan(mCerts.Get(), nocCert.size());
+        mICAC = ByteSpan(mCerts.Get() + nocCert.size(), icaCert.size());
+
+        mTBSDataLen = TLV::EstimateStructOverhead(nocCert.size(), icaCert.size(), kP256_PublicKey_Length, kP256_PublicKey_Length);
+        VerifyOrReturnError(mTBSData.Alloc(mTBSDataLen), CHIP_ERROR_NO_MEMORY);
+
+        // Nor on the fabric keeping its operational key: the fabric may be removed, or its key replaced, meanwhile.
+        return operationalKey.Serialize(mOperationalKeypair);
+    }
+
+    void Run() override
+    {
+        CHIP_TRACE_SCOPE(SecureChannel, "SigmaSign");
+
+        if (mGenerateEphemeralKey)
+        {
+            P256Keypair ephemeralKey;
+            SuccessOrExit(mError = ephemeralKey.Initialize());
+            SuccessOrExit(mError = ephemeralKey.ECDH_derive_secret(mRemotePubKey, mSharedSecret));
+            SuccessOrExit(mError = ephemeralKey.Serialize(mEphemeralKeypair));
+            memcpy(mEphemeralPubKey.Bytes(), ephemeralKey.Pubkey().ConstBytes(), mEphemeralPubKey.Length());
+        }
+
+        SuccessOrExit(mError = ConstructTBSData(mNOC, mICAC, ByteSpan(mEphemeralPubKey, mEphemeralPubKey.Length()),
+                                                ByteSpan(mRemotePubKey, mRemotePubKey.Length()), mTBSData.Get(), mTBSDataLen));
+        {
+            OperationalKeypair operationalKey;
+            SuccessOrExit(mError = operationalKey.Deserialize(mOperationalKeypair));
+            SuccessOrExit(mError = operationalKey.ECDSA_sign_msg(mTBSData.Get(), mTBSDataLen, mSignature));
+        }
+
+    exit:
+        return;
+    }
+
+    void OnComplete() override
+    {
+        if (mSession != nullptr)
+        {
+            mSession->OnSigmaSignJobComplete(*this);
+        }
+        Platform::Delete(this);
+    }
+
+    void OnCompletionError(CHIP_ERROR error) override
+    {
+        mError = error;
+        OnComplete();
+    }
+
+    // Session to resume once the job completes, null if the session was cleared in the meantime.
+    CASESession * mSession = nullptr;
+    bool mForSigma2        = false;
+
+    bool mGenerateEphemeralKey = false;
+    P256PublicKey mRemotePubKey;
+    P256PublicKey mEphemeralPubKey;
+    ByteSpan mNOC;
+    ByteSpan mICAC;
+
+    CHIP_ERROR mError = CHIP_NO_ERROR;
+    P256SerializedKeypair mEphemeralKeypair;
+    P256ECDHDerivedSecret mSharedSecret;
+    P256ECDSASignature mSignature;
+
+private:
+    P256SerializedKeypair mOperationalKeypair;
+    chip::Platform::ScopedMemoryBuffer<uint8_t> mCerts;
+    chip::Platform::ScopedMemoryBuffer<uint8_t> mTBSData;
+    size_t mTBSDataLen = 0;
+};
+
 CASESession::CASESession()
 {
     SetSecureSessionType(Transport::SecureSession::Type::kCASE);
@@ -110,6 +198,16 @@ void CASESession::Clear()
 
     mState = kInitialized;
 
+    if (mSigmaSignJob != nullptr)
+    {
+        // A running job can't be cancelled, it frees itself once complete.
+        if (mSigmaSignJob->mSession == this)
+        {
+            mSigmaSignJob->mSession = nullptr;
+        }
+        mSigmaSignJob = nullptr;
+    }
+
     CloseExchange();
 }
 
@@ -289,6 +387,7 @@ CHIP_ERROR CASESession::DeriveSecureSession(CryptoContext & session, CryptoConte
 
 CHIP_ERROR CASESession::SendSigma1()
 {
+    CHIP_TRACE_SCOPE(SecureChannel, "SendSigma1");
     const size_t mrpParamsSize = mLocalMRPConfig.HasValue() ? TLV::EstimateStructOverhead(sizeof(uint16_t), sizeof(uint16_t)) : 0;
     size_t data_len            = TLV::EstimateStructOverhead(kSigmaParamRandomNumberSize, // initiatorRandom
                                                   sizeof(uint16_t),            // initiatorSessionId,
@@ -378,6 +477,7 @@ CHIP_ERROR CASESession::HandleSigma1_and_SendSigma2(System::PacketBufferHandle &
 
 CHIP_ERROR CASESession::HandleSigma1(System::PacketBufferHandle && msg)
 {
+    CHIP_TRACE_SCOPE(SecureChannel, "HandleSigma1");
     CHIP_ERROR err = CHIP_NO_ERROR;
     System::PacketBufferTLVReader tlvReader;
 
@@ -436,8 +536,6 @@ CHIP_ERROR CASESession::HandleSigma1(System::PacketBufferHandle && msg)
 
     SuccessOrExit(err = SendSigma2());
 
-    mDelegate->OnSessionEstablishmentStarted();
-
 exit:
 
     if (err == CHIP_ERROR_KEY_NOT_FOUND)
@@ -505,6 +603,7 @@ CHIP_ERROR CASESession::SendSigma2Resume(const ByteSpan & initiatorRandom)
 
 CHIP_ERROR CASESession::SendSigma2()
 {
+    CHIP_TRACE_SCOPE(SecureChannel, "SendSigma2");
     VerifyOrReturnError(mFabricInfo != nullptr, CHIP_ERROR_INCORRECT_STATE);
 
     ByteSpan icaCert;
@@ -516,18 +615,46 @@ CHIP_ERROR CASESession::SendSigma2()
     mTrustedRootId = mFabricInfo->GetTrustedRootId();
     VerifyOrReturnError(!mTrustedRootId.empty(), CHIP_ERROR_INTERNAL);
 
-    // Fill in the random value
-    uint8_t msg_rand[kSigmaParamRandomNumberSize];
-    ReturnErrorOnFailure(DRBG_get_bytes(&msg_rand[0], sizeof(msg_rand)));
+    VerifyOrReturnError(mFabricInfo->GetOperationalKey() != nullptr, CHIP_ERROR_INCORRECT_STATE);
+
+    Platform::UniquePtr<SigmaSignJob> job = Platform::MakeUnique<SigmaSignJob>();
+    VerifyOrReturnError(job, CHIP_ERROR_NO_MEMORY);
+    ReturnErrorOnFailure(job->Init(nocCert, icaCert, *mFabricInfo->GetOperationalKey()));
+    job->mForSigma2 = true;
+    memcpy(job->mRemotePubKey.Bytes(), mRemotePubKey.ConstBytes(), mRemotePubKey.Length());
 
-    // Generate an ephemeral keypair
 #ifdef ENABLE_HSM_CASE_EPHEMERAL_KEY
+    // The HSM ephemeral key can't be handed over to the job, only the signature is offloaded.
     mEphemeralKey.SetKeyId(CASE_EPHEMERAL_KEY);
-#endif
     ReturnErrorOnFailure(mEphemeralKey.Initialize());
-
-    // Generate a Shared Secret
     ReturnErrorOnFailure(mEphemeralKey.ECDH_derive_secret(mRemotePubKey, mSharedSecret));
+    memcpy(job->mEphemeralPubKey.Bytes(), mEphemeralKey.Pubkey().ConstBytes(), mEphemeralKey.Pubkey().Length());
+#else
+    // Generate an ephemeral keypair, the shared secret and the Sigma2 TBS data signature
+    job->mGenerateEphemeralKey = true;
+#endif
+
+    bool pending = false;
+    ReturnErrorOnFailure(RunSigmaSignJob(job, pending));
+    return pending ? CHIP_NO_ERROR : FinishSigma2(*job);
+}
+
+CHIP_ERROR CASESession::FinishSigma2(SigmaSignJob & job)
+{
+    CHIP_TRACE_SCOPE(SecureChannel, "FinishSigma2");
+    if (job.mGenerateEphemeralKey)
+    {
+        ReturnErrorOnFailure(mEphemeralKey.Deserialize(job.mEphemeralKeypair));
+        mSharedSecret = job.mSharedSecret;
+    }
+
+    const ByteSpan & nocCert                     = job.mNOC;
+    const ByteSpan & icaCert                     = job.mICAC;
+    const P256ECDSASignature & tbsData2Signature = job.mSignature;
+
+    // Fill in the random value
+    uint8_t msg_rand[kSigmaParamRandomNumberSize];
+    ReturnErrorOnFailure(DRBG_get_bytes(&msg_rand[0], sizeof(msg_rand)));
 
     uint8_t msg_salt[kIPKSize + kSigmaParamRandomNumberSize + kP256_PublicKey_Length + kSHA256_Hash_Length];
 
@@ -539,25 +666,6 @@ CHIP_ERROR CASESession::SendSigma2()
     ReturnErrorOnFailure(mHKDF.HKDF_SHA256(mSharedSecret, mSharedSecret.Length(), saltSpan.data(), saltSpan.size(), kKDFSR2Info,
                                            kKDFInfoLength, sr2k, CHIP_CRYPTO_SYMMETRIC_KEY_LENGTH_BYTES));
 
-    // Construct Sigma2 TBS Data
-    size_t msg_r2_signed_len =
-        TLV::EstimateStructOverhead(nocCert.size(), icaCert.size(), kP256_PublicKey_Length, kP256_PublicKey_Length);
-
-    chip::Platform::ScopedMemoryBuffer<uint8_t> msg_R2_Signed;
-    VerifyOrReturnError(msg_R2_Signed.Alloc(msg_r2_signed_len), CHIP_ERROR_NO_MEMORY);
-
-    ReturnErrorOnFailure(ConstructTBSData(nocCert, icaCert, ByteSpan(mEphemeralKey.Pubkey(), mEphemeralKey.Pubkey().Length()),
-                                          ByteSpan(mRemotePubKey, mRemotePubKey.Length()), msg_R2_Signed.Get(), msg_r2_signed_len));
-
-    // Generate a Signature
-    VerifyOrReturnError(mFabricInfo->GetOperationalKey() != nullptr, CHIP_ERROR_INCORRECT_STATE);
-
-    P256ECDSASignature tbsData2Signature;
-    ReturnErrorOnFailure(
-        mFabricInfo->GetOperationalKey()->ECDSA_sign_msg(msg_R2_Signed.Get(), msg_r2_signed_len, tbsData2Signature));
-
-    msg_R2_Signed.Free();
-
     // Construct Sigma2 TBE Data
     size_t msg_r2_signed_enc_len =
         TLV::EstimateStructOverhead(nocCert.size(), icaCert.size(), tbsData2Signature.Length(), kCASEResumptionIDSize);
@@ -630,6 +738,8 @@ CHIP_ERROR CASESession::SendSigma2()
 
     ChipLogDetail(SecureChannel, "Sent Sigma2 msg");
 
+    mDelegate->OnSessionEstablishmentStarted();
+
     return CHIP_NO_ERROR;
 }
 
@@ -707,6 +817,7 @@ CHIP_ERROR CASESession::HandleSigma2_and_SendSigma3(System::PacketBufferHandle &
 
 CHIP_ERROR CASESession::HandleSigma2(System::PacketBufferHandle && msg)
 {
+    CHIP_TRACE_SCOPE(SecureChannel, "HandleSigma2");
     CHIP_ERROR err = CHIP_NO_ERROR;
     System::PacketBufferTLVReader tlvReader;
     TLV::TLVReader decryptedDataTlvReader;
@@ -860,23 +971,11 @@ exit:
 
 CHIP_ERROR CASESession::SendSigma3()
 {
+    CHIP_TRACE_SCOPE(SecureChannel, "SendSigma3");
     CHIP_ERROR err = CHIP_NO_ERROR;
 
-    MutableByteSpan messageDigestSpan(mMessageDigest);
-    System::PacketBufferHandle msg_R3;
-    size_t data_len;
-
-    chip::Platform::ScopedMemoryBuffer<uint8_t> msg_R3_Encrypted;
-    size_t msg_r3_encrypted_len;
-
-    uint8_t msg_salt[kIPKSize + kSHA256_Hash_Length];
-
-    uint8_t sr3k[CHIP_CRYPTO_SYMMETRIC_KEY_LENGTH_BYTES];
-
-    chip::Platform::ScopedMemoryBuffer<uint8_t> msg_R3_Signed;
-    size_t msg_r3_signed_len;
-
-    P256ECDSASignature tbsData3Signature;
+    Platform::UniquePtr<SigmaSignJob> job;
+    bool pending = false;
 
     ChipLogDetail(SecureChannel, "Sending Sigma3");
 
@@ -891,18 +990,50 @@ CHIP_ERROR CASESession::SendSigma3()
     mTrustedRootId = mFabricInfo->GetTrustedRootId();
     VerifyOrExit(!mTrustedRootId.empty(), err = CHIP_ERROR_INTERNAL);
 
-    // Prepare Sigma3 TBS Data Blob
-    msg_r3_signed_len = TLV::EstimateStructOverhead(icaCert.size(), nocCert.size(), kP256_PublicKey_Length, kP256_PublicKey_Length);
+    // Generate the Sigma3 TBS data signature
+    VerifyOrExit(mFabricInfo->GetOperationalKey() != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
 
-    VerifyOrExit(msg_R3_Signed.Alloc(msg_r3_signed_len), err = CHIP_ERROR_NO_MEMORY);
+    job = Platform::MakeUnique<SigmaSignJob>();
+    VerifyOrExit(job, err = CHIP_ERROR_NO_MEMORY);
+    SuccessOrExit(err = job->Init(nocCert, icaCert, *mFabricInfo->GetOperationalKey()));
+    memcpy(job->mEphemeralPubKey.Bytes(), mEphemeralKey.Pubkey().ConstBytes(), mEphemeralKey.Pubkey().Length());
+    memcpy(job->mRemotePubKey.Bytes(), mRemotePubKey.ConstBytes(), mRemotePubKey.Length());
+
+    SuccessOrExit(err = RunSigmaSignJob(job, pending));
+    if (!pending)
+    {
+        SuccessOrExit(err = FinishSigma3(*job));
+    }
 
-    SuccessOrExit(err = ConstructTBSData(nocCert, icaCert, ByteSpan(mEphemeralKey.Pubkey(), mEphemeralKey.Pubkey().Length()),
-                                         ByteSpan(mRemotePubKey, mRemotePubKey.Length()), msg_R3_Signed.Get(), msg_r3_signed_len));
+exit:
 
-    // Generate a signature
-    VerifyOrExit(mFabricInfo->GetOperationalKey() != nullptr, err = CHIP_ERROR_INCORRECT_STATE);
-    err = mFabricInfo->GetOperationalKey()->ECDSA_sign_msg(msg_R3_Signed.Get(), msg_r3_signed_len, tbsData3Signature);
-    SuccessOrExit(err);
+    if (err != CHIP_NO_ERROR)
+    {
+        SendStatusReport(mExchangeCtxt, kProtocolCodeInvalidParam);
+        mState = kInitialized;
+    }
+    return err;
+}
+
+CHIP_ERROR CASESession::FinishSigma3(SigmaSignJob & job)
+{
+    CHIP_TRACE_SCOPE(SecureChannel, "FinishSigma3");
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    MutableByteSpan messageDigestSpan(mMessageDigest);
+    System::PacketBufferHandle msg_R3;
+    size_t data_len;
+
+    chip::Platform::ScopedMemoryBuffer<uint8_t> msg_R3_Encrypted;
+    size_t msg_r3_encrypted_len;
+
+    uint8_t msg_salt[kIPKSize + kSHA256_Hash_Length];
+
+    uint8_t sr3k[CHIP_CRYPTO_SYMMETRIC_KEY_LENGTH_BYTES];
+
+    const ByteSpan & nocCert                     = job.mNOC;
+    const ByteSpan & icaCert                     = job.mICAC;
+    const P256ECDSASignature & tbsData3Signature = job.mSignature;
 
     // Prepare Sigma3 TBE Data Blob
     msg_r3_encrypted_len = TLV::EstimateStructOverhead(nocCert.size(), icaCert.size(), tbsData3Signature.Length());
@@ -983,17 +1114,48 @@ CHIP_ERROR CASESession::SendSigma3()
     mState = kSentSigma3;
 
 exit:
+    return err;
+}
+
+CHIP_ERROR CASESession::RunSigmaSignJob(Platform::UniquePtr<SigmaSignJob> & job, bool & pending)
+{
+    job->mSession = this;
+
+    pending = (PostCryptoJob(*job) == CHIP_NO_ERROR);
+    if (pending)
+    {
+        // The job now owns itself. Keep the exchange open until it completes and the message is sent.
+        mSigmaSignJob = job.release();
+        mExchangeCtxt->WillSendMessage();
+        return CHIP_NO_ERROR;
+    }
+
+    job->Run();
+    return job->mError;
+}
+
+void CASESession::OnSigmaSignJobComplete(SigmaSignJob & job)
+{
+    mSigmaSignJob  = nullptr;
+    CHIP_ERROR err = job.mError;
+
+    if (err == CHIP_NO_ERROR)
+    {
+        err = job.mForSigma2 ? FinishSigma2(job) : FinishSigma3(job);
+    }
 
     if (err != CHIP_NO_ERROR)
     {
+        ChipLogError(SecureChannel, "Failed to send Sigma%d: %" CHIP_ERROR_FORMAT, job.mForSigma2 ? 2 : 3, err.Format());
         SendStatusReport(mExchangeCtxt, kProtocolCodeInvalidParam);
-        mState = kInitialized;
+        Clear();
+        mDelegate->OnSessionEstablishmentError(err);
     }
-    return err;
 }
 
 CHIP_ERROR CASESession::HandleSigma3(System::PacketBufferHandle && msg)
 {
+    CHIP_TRACE_SCOPE(SecureChannel, "HandleSigma3");
     CHIP_ERROR err = CHIP_NO_ERROR;
     MutableByteSpan messageDigestSpan(mMessageDigest);
     System::PacketBufferTLVReader tlvReader;
@@ -1452,6 +1614,9 @@ CHIP_ERROR CASESession::OnMessageReceived(ExchangeContext * ec, const PayloadHea
     Protocols::SecureChannel::MsgType msgType = static_cast<Protocols::SecureChannel::MsgType>(payloadHeader.GetMessageType());
     SuccessOrExit(err);
 
+    // Nothing is expected from the peer until the pending Sigma message is sent.
+    VerifyOrExit(mSigmaSignJob == nullptr, err = CHIP_ERROR_INCORRECT_STATE);
+
     // By default, CHIP_ERROR_INVALID_MESSAGE_TYPE is returned if in the current state
     // a message handler is not defined for the received message type.
     err = CHIP_ERROR_INVALID_MESSAGE_TYPE;
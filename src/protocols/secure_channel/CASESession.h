@@ -27,6 +27,7 @@
 
 #include <credentials/CHIPCert.h>
 #include <crypto/CHIPCryptoPAL.h>
+#include <crypto/CryptoJobQueue.h>
 #if CHIP_CRYPTO_HSM
 #include <crypto/hsm/CHIPCryptoPALHsm.h>
 #endif
@@ -184,26 +185,34 @@ private:
         kSentSigma2Resume = 4,
     };
 
+    // Computes the ephemeral key, shared secret and TBS data signature of Sigma2 and Sigma3, possibly on a worker thread.
+    class SigmaSignJob;
+
     CHIP_ERROR Init(uint16_t mySessionId, SessionEstablishmentDelegate * delegate);
 
     CHIP_ERROR SendSigma1();
     CHIP_ERROR HandleSigma1_and_SendSigma2(System::PacketBufferHandle && msg);
     CHIP_ERROR HandleSigma1(System::PacketBufferHandle && msg);
     CHIP_ERROR SendSigma2();
+    CHIP_ERROR FinishSigma2(SigmaSignJob & job);
     CHIP_ERROR HandleSigma2_and_SendSigma3(System::PacketBufferHandle && msg);
     CHIP_ERROR HandleSigma2(System::PacketBufferHandle && msg);
     CHIP_ERROR HandleSigma2Resume(System::PacketBufferHandle && msg);
     CHIP_ERROR SendSigma3();
+    CHIP_ERROR FinishSigma3(SigmaSignJob & job);
     CHIP_ERROR HandleSigma3(System::PacketBufferHandle && msg);
 
+    CHIP_ERROR RunSigmaSignJob(Platform::UniquePtr<SigmaSignJob> & job, bool & pending);
+    void OnSigmaSignJobComplete(SigmaSignJob & job);
+
     CHIP_ERROR SendSigma2Resume(const ByteSpan & initiatorRandom);
 
     CHIP_ERROR ConstructSaltSigma2(const ByteSpan & rand, const Crypto::P256PublicKey & pubkey, const ByteSpan & ipk,
                                    MutableByteSpan & salt);
     CHIP_ERROR Validate_and_RetrieveResponderID(const ByteSpan & responderNOC, const ByteSpan & responderICAC,
                                                 Crypto::P256PublicKey & responderID);
-    CHIP_ERROR ConstructTBSData(const ByteSpan & senderNOC, const ByteSpan & senderICAC, const ByteSpan & senderPubKey,
-                                const ByteSpan & receiverPubKey, uint8_t * tbsData, size_t & tbsDataLen);
+    static CHIP_ERROR ConstructTBSData(const ByteSpan & senderNOC, const ByteSpan & senderICAC, const ByteSpan & senderPubKey,
+                                       const ByteSpan & receiverPubKey, uint8_t * tbsData, size_t & tbsDataLen);
     CHIP_ERROR ConstructSaltSigma3(const ByteSpan & ipk, MutableByteSpan & salt);
     CHIP_ERROR RetrieveIPK(FabricId fabricId, MutableByteSpan & ipk);
 
@@ -244,6 +253,9 @@ private:
 
     Messaging::ExchangeContext * mExchangeCtxt = nullptr;
 
+    // Job whose completion the handshake is waiting for, if any.
+    SigmaSignJob * mSigmaSignJob = nullptr;
+
     FabricTable * mFabricsTable = nullptr;
     FabricInfo * mFabricInfo    = nullptr;
 
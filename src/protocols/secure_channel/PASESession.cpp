@@ -42,6 +42,7 @@
 #include <lib/support/TypeTraits.h>
 #include <protocols/Protocols.h>
 #include <protocols/secure_channel/Constants.h>
+#include <protocols/secure_channel/PASEVerifierCache.h>
 #include <protocols/secure_channel/StatusReport.h>
 #include <setup_payload/SetupPayload.h>
 #include <system/TLVPacketBufferBackingStore.h>
@@ -64,12 +65,6 @@ const char * kSpake2pKeyExchangeSalt = "SPAKE2P Key Salt";
 // The session establishment fails if the response is not received with in timeout window.
 static constexpr ExchangeContext::Timeout kSpake2p_Response_Timeout = System::Clock::Seconds16(30);
 
-#ifdef ENABLE_HSM_PBKDF2
-using PBKDF2_sha256_crypto = PBKDF2_sha256HSM;
-#else
-using PBKDF2_sha256_crypto = PBKDF2_sha256;
-#endif
-
 PASESession::PASESession()
 {
     SetSecureSessionType(Transport::SecureSession::Type::kPASE);
@@ -209,12 +204,14 @@ CHIP_ERROR PASESession::ComputePASEVerifier(uint32_t setUpPINCode, uint32_t pbkd
     ReturnErrorCodeIf(salt.data() == nullptr, CHIP_ERROR_INVALID_ARGUMENT);
     ReturnErrorCodeIf(setUpPINCode >= (1 << kSetupPINCodeFieldLengthInBits), CHIP_ERROR_INVALID_ARGUMENT);
 
-    PBKDF2_sha256_crypto mPBKDF;
-    uint8_t littleEndianSetupPINCode[sizeof(uint32_t)];
-    Encoding::LittleEndian::Put32(littleEndianSetupPINCode, setUpPINCode);
+    PASEVerifierCache & cache = PASEVerifierCache::Instance();
+    if (cache.Get(setUpPINCode, pbkdf2IterCount, salt, verifier) == CHIP_NO_ERROR)
+    {
+        return CHIP_NO_ERROR;
+    }
 
-    return mPBKDF.pbkdf2_sha256(littleEndianSetupPINCode, sizeof(littleEndianSetupPINCode), salt.data(), salt.size(),
-                                pbkdf2IterCount, sizeof(PASEVerifier), reinterpret_cast<uint8_t *>(&verifier));
+    ReturnErrorOnFailure(PASEVerifierCache::Compute(setUpPINCode, pbkdf2IterCount, salt, verifier));
+    return cache.Add(setUpPINCode, pbkdf2IterCount, salt, verifier);
 }
 
 CHIP_ERROR PASESession::GeneratePASEVerifier(PASEVerifier & verifier, uint32_t pbkdf2IterCount, const ByteSpan & salt,
@@ -0,0 +1,204 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#include <protocols/secure_channel/PASEVerifierCache.h>
+
+#include <crypto/CryptoJobQueue.h>
+#include <lib/core/CHIPEncoding.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+
+namespace chip {
+
+using namespace Crypto;
+
+#ifdef ENABLE_HSM_PBKDF2
+using PBKDF2_sha256_crypto = PBKDF2_sha256HSM;
+#else
+using PBKDF2_sha256_crypto = PBKDF2_sha256;
+#endif
+
+namespace {
+
+// Derives a verifier on the crypto job queue, and adds it to the cache once back on the CHIP thread.
+class PASEVerifierJob : public CryptoJob
+{
+public:
+    PASEVerifierJob(PASEVerifierCache & cache) : mCache(cache), mGeneration(cache.GetGeneration()) {}
+
+    ~PASEVerifierJob() override
+    {
+        ClearSecretData(reinterpret_cast<uint8_t *>(&mVerifier), sizeof(mVerifier));
+        ClearSecretData(reinterpret_cast<uint8_t *>(&mSetupPINCode), sizeof(mSetupPINCode));
+    }
+
+    CHIP_ERROR Init(uint32_t setupPINCode, uint32_t pbkdf2IterCount, const ByteSpan & salt)
+    {
+        VerifyOrReturnError(salt.size() <= sizeof(mSalt), CHIP_ERROR_INVALID_ARGUMENT);
+
+        mSetupPINCode    = setupPINCode;
+        mPBKDF2IterCount = pbkdf2IterCount;
+        memcpy(mSalt, salt.data(), salt.size());
+        mSaltLength = salt.size();
+
+        return CHIP_NO_ERROR;
+    }
+
+    void Run() override { mResult = PASEVerifierCache::Compute(mSetupPINCode, mPBKDF2IterCount, GetSalt(), mVerifier); }
+
+    void OnComplete() override
+    {
+        if (mResult == CHIP_NO_ERROR && mCache.GetGeneration() == mGeneration)
+        {
+            mCache.Add(mSetupPINCode, mPBKDF2IterCount, GetSalt(), mVerifier);
+        }
+
+        Platform::Delete(this);
+    }
+
+private:
+    ByteSpan GetSalt() const { return ByteSpan(mSalt, mSaltLength); }
+
+    PASEVerifierCache & mCache;
+    const uint32_t mGeneration;
+    uint32_t mSetupPINCode    = 0;
+    uint32_t mPBKDF2IterCount = 0;
+    uint8_t mSalt[kPBKDFMaximumSaltLen];
+    size_t mSaltLength = 0;
+    PASEVerifier mVerifier;
+    CHIP_ERROR mResult = CHIP_NO_ERROR;
+};
+
+} // namespace
+
+PASEVerifierCache & PASEVerifierCache::Instance()
+{
+    static PASEVerifierCache sInstance;
+    return sInstance;
+}
+
+CHIP_ERROR PASEVerifierCache::ComputeKey(uint32_t setupPINCode, uint32_t pbkdf2IterCount, const ByteSpan & salt,
+                                         uint8_t (&key)[kSHA256_Hash_Length])
+{
+    uint8_t littleEndianInputs[2 * sizeof(uint32_t)];
+    Encoding::LittleEndian::Put32(&littleEndianInputs[0], setupPINCode);
+    Encoding::LittleEndian::Put32(&littleEndianInputs[sizeof(uint32_t)], pbkdf2IterCount);
+
+    Hash_SHA256_stream hash;
+    MutableByteSpan keySpan(key);
+    CHIP_ERROR err = hash.Begin();
+    SuccessOrExit(err);
+    SuccessOrExit(err = hash.AddData(ByteSpan(littleEndianInputs)));
+    SuccessOrExit(err = hash.AddData(salt));
+    SuccessOrExit(err = hash.GetDigest(keySpan));
+
+exit:
+    ClearSecretData(littleEndianInputs, sizeof(littleEndianInputs));
+    return err;
+}
+
+CHIP_ERROR PASEVerifierCache::Compute(uint32_t setupPINCode, uint32_t pbkdf2IterCount, const ByteSpan & salt,
+                                      PASEVerifier & verifier)
+{
+    PBKDF2_sha256_crypto mPBKDF;
+    uint8_t littleEndianSetupPINCode[sizeof(uint32_t)];
+    Encoding::LittleEndian::Put32(littleEndianSetupPINCode, setupPINCode);
+
+    return mPBKDF.pbkdf2_sha256(littleEndianSetupPINCode, sizeof(littleEndianSetupPINCode), salt.data(), salt.size(),
+                                pbkdf2IterCount, sizeof(PASEVerifier), reinterpret_cast<uint8_t *>(&verifier));
+}
+
+CHIP_ERROR PASEVerifierCache::Add(uint32_t setupPINCode, uint32_t pbkdf2IterCount, const ByteSpan & salt,
+                                  const PASEVerifier & verifier)
+{
+    uint8_t key[kSHA256_Hash_Length];
+    ReturnErrorOnFailure(ComputeKey(setupPINCode, pbkdf2IterCount, salt, key));
+
+    Entry * entry = nullptr;
+    for (Entry & candidate : mEntries)
+    {
+        if (candidate.mInUse && memcmp(candidate.mKey, key, sizeof(key)) == 0)
+        {
+            entry = &candidate;
+            break;
+        }
+    }
+
+    if (entry == nullptr)
+    {
+        entry      = &mEntries[mNextEntry];
+        mNextEntry = static_cast<uint8_t>((mNextEntry + 1) % CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE);
+    }
+
+    memcpy(entry->mKey, key, sizeof(key));
+    memcpy(&entry->mVerifier, &verifier, sizeof(verifier));
+    entry->mInUse = true;
+
+    return CHIP_NO_ERROR;
+}
+
+CHIP_ERROR PASEVerifierCache::Get(uint32_t setupPINCode, uint32_t pbkdf2IterCount, const ByteSpan & salt,
+                                  PASEVerifier & verifier) const
+{
+    uint8_t key[kSHA256_Hash_Length];
+    ReturnErrorOnFailure(ComputeKey(setupPINCode, pbkdf2IterCount, salt, key));
+
+    for (const Entry & entry : mEntries)
+    {
+        if (entry.mInUse && memcmp(entry.mKey, key, sizeof(key)) == 0)
+        {
+            memcpy(&verifier, &entry.mVerifier, sizeof(verifier));
+            return CHIP_NO_ERROR;
+        }
+    }
+
+    return CHIP_ERROR_KEY_NOT_FOUND;
+}
+
+CHIP_ERROR PASEVerifierCache::Precompute(uint32_t setupPINCode, uint32_t pbkdf2IterCount, const ByteSpan & salt)
+{
+    PASEVerifier verifier;
+    CHIP_ERROR err = Get(setupPINCode, pbkdf2IterCount, salt, verifier);
+    ClearSecretData(reinterpret_cast<uint8_t *>(&verifier), sizeof(verifier));
+    VerifyOrReturnError(err == CHIP_ERROR_KEY_NOT_FOUND, err);
+
+    PASEVerifierJob * job = Platform::New<PASEVerifierJob>(*this);
+    VerifyOrReturnError(job != nullptr, CHIP_ERROR_NO_MEMORY);
+
+    err = job->Init(setupPINCode, pbkdf2IterCount, salt);
+    if (err == CHIP_NO_ERROR && PostCryptoJob(*job) == CHIP_NO_ERROR)
+    {
+        return CHIP_NO_ERROR;
+    }
+
+    Platform::Delete(job);
+    return err;
+}
+
+void PASEVerifierCache::Clear()
+{
+    for (Entry & entry : mEntries)
+    {
+        ClearSecretData(reinterpret_cast<uint8_t *>(&entry.mVerifier), sizeof(entry.mVerifier));
+        memset(entry.mKey, 0, sizeof(entry.mKey));
+        entry.mInUse = false;
+    }
+    mNextEntry = 0;
+    mGeneration++;
+}
+
+} // namespace chip
@@ -0,0 +1,94 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#pragma once
+
+#include <crypto/CHIPCryptoPAL.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/support/Span.h>
+#include <protocols/secure_channel/PASESession.h>
+
+namespace chip {
+
+/**
+ * Keeps the PASE verifiers derived for recently used (setup PIN, salt, iteration count) inputs, so that PBKDF2
+ * doesn't run again each time a commissioning attempt is retried, or a commissionee is paired again with the same
+ * setup PIN.
+ *
+ * Entries are looked up by a SHA-256 hash of their inputs. Neither that hash nor the verifier protects the setup PIN
+ * code: with only 27 bits of PIN, either one gives the PIN away by brute force, so entries are as sensitive as the PIN
+ * itself. They are wiped when replaced or cleared, and the server clears the cache when its commissioning window closes.
+ * The cache is only used from the CHIP thread.
+ */
+class PASEVerifierCache
+{
+public:
+    ~PASEVerifierCache() { Clear(); }
+
+    static PASEVerifierCache & Instance();
+
+    /**
+     * Add the verifier derived from the given inputs, replacing the oldest entry if the cache is full.
+     * This may be used to supply a verifier precomputed during factory provisioning.
+     */
+    CHIP_ERROR Add(uint32_t setupPINCode, uint32_t pbkdf2IterCount, const ByteSpan & salt, const PASEVerifier & verifier);
+
+    /**
+     * @retval CHIP_ERROR_KEY_NOT_FOUND if no verifier was cached for the given inputs.
+     */
+    CHIP_ERROR Get(uint32_t setupPINCode, uint32_t pbkdf2IterCount, const ByteSpan & salt, PASEVerifier & verifier) const;
+
+    /**
+     * Derive the verifier for the given inputs on the crypto job queue, and add it to the cache once done.
+     * Nothing is done if the verifier is already cached, or if no crypto job queue is running, in which
+     * case the verifier gets derived when first needed.
+     */
+    CHIP_ERROR Precompute(uint32_t setupPINCode, uint32_t pbkdf2IterCount, const ByteSpan & salt);
+
+    /**
+     * Wipe all the entries. Verifiers being precomputed when the cache is cleared are dropped once derived.
+     */
+    void Clear();
+
+    /**
+     * Incremented by each Clear(), so that a verifier precomputed for a cleared cache is not added back.
+     */
+    uint32_t GetGeneration() const { return mGeneration; }
+
+    /**
+     * Derive a verifier with PBKDF2, without using any cache. This may be called from any thread.
+     */
+    static CHIP_ERROR Compute(uint32_t setupPINCode, uint32_t pbkdf2IterCount, const ByteSpan & salt, PASEVerifier & verifier);
+
+private:
+    struct Entry
+    {
+        uint8_t mKey[Crypto::kSHA256_Hash_Length];
+        PASEVerifier mVerifier;
+        bool mInUse = false;
+    };
+
+    static CHIP_ERROR ComputeKey(uint32_t setupPINCode, uint32_t pbkdf2IterCount, const ByteSpan & salt,
+                                 uint8_t (&key)[Crypto::kSHA256_Hash_Length]);
+
+    Entry mEntries[CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE];
+    uint8_t mNextEntry  = 0;
+    uint32_t mGeneration = 0;
+};
+
+} // namespace chip
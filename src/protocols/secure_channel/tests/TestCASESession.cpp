@@ -25,6 +25,7 @@
 #include <nlunit-test.h>
 
 #include <credentials/CHIPCert.h>
+#include <crypto/CryptoJobQueue.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/core/CHIPSafeCasts.h>
 #include <lib/support/CHIPMem.h>
@@ -99,10 +100,10 @@ protected:
 class TestCASEServerIPK : public CASEServer
 {
 public:
-    TestCASESessionIPK & GetSession() override { return mPairingSession; }
+    TestCASESessionIPK & GetSession(size_t index) override { return mPairingSessions[index]; }
 
 private:
-    TestCASESessionIPK mPairingSession;
+    TestCASESessionIPK mPairingSessions[CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS];
 };
 
 static CHIP_ERROR InitCredentialSets()
@@ -260,6 +261,94 @@ void CASE_SecurePairingHandshakeTest(nlTestSuite * inSuite, void * inContext)
     CASE_SecurePairingHandshakeTestCommon(inSuite, inContext, pairingCommissioner, delegateCommissioner);
 }
 
+// Holds the posted jobs until the test runs them, the way a worker thread would.
+class DeferredCryptoJobQueue : public Crypto::CryptoJobQueue
+{
+public:
+    CHIP_ERROR Post(Crypto::CryptoJob & job) override
+    {
+        VerifyOrReturnError(mPendingCount < ArraySize(mPending), CHIP_ERROR_NO_MEMORY);
+        mPending[mPendingCount++] = &job;
+        mPostedCount++;
+        return CHIP_NO_ERROR;
+    }
+
+    size_t RunPendingJobs()
+    {
+        Crypto::CryptoJob * jobs[ArraySize(mPending)];
+        size_t count = mPendingCount;
+        memcpy(jobs, mPending, count * sizeof(jobs[0]));
+        mPendingCount = 0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            jobs[i]->Run();
+            jobs[i]->OnComplete();
+        }
+        return count;
+    }
+
+    size_t mPostedCount = 0;
+
+private:
+    Crypto::CryptoJob * mPending[4];
+    size_t mPendingCount = 0;
+};
+
+void CASE_SecurePairingOffloadedHandshakeTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    DeferredCryptoJobQueue jobQueue;
+    TestCASESecurePairingDelegate delegateCommissioner;
+    TestCASESecurePairingDelegate delegateAccessory;
+    TestCASESessionIPK pairingCommissioner;
+    TestCASESessionIPK pairingAccessory;
+    CASESessionCachable serializableCommissioner;
+    CASESessionCachable serializableAccessory;
+
+    Crypto::SetCryptoJobQueue(&jobQueue);
+    gLoopback.mSentMessageCount = 0;
+
+    NL_TEST_ASSERT(inSuite,
+                   ctx.GetExchangeManager().RegisterUnsolicitedMessageHandlerForType(Protocols::SecureChannel::MsgType::CASE_Sigma1,
+                                                                                     &pairingAccessory) == CHIP_NO_ERROR);
+
+    ExchangeContext * contextCommissioner = ctx.NewUnauthenticatedExchangeToBob(&pairingCommissioner);
+
+    FabricInfo * fabric = gCommissionerFabrics.FindFabricWithIndex(gCommissionerFabricIndex);
+    NL_TEST_ASSERT(inSuite, fabric != nullptr);
+
+    NL_TEST_ASSERT(inSuite,
+                   pairingAccessory.ListenForSessionEstablishment(0, &gDeviceFabrics, &delegateAccessory) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   pairingCommissioner.EstablishSession(Transport::PeerAddress(Transport::Type::kBle), fabric, Node01_01, 0,
+                                                        contextCommissioner, &delegateCommissioner) == CHIP_NO_ERROR);
+    ctx.DrainAndServiceIO();
+
+    // Sigma2 waits for its job to complete
+    NL_TEST_ASSERT(inSuite, gLoopback.mSentMessageCount == 1);
+
+    while (jobQueue.RunPendingJobs() > 0)
+    {
+        ctx.DrainAndServiceIO();
+    }
+
+    // Sigma2 and Sigma3 were signed by the queued jobs
+    NL_TEST_ASSERT(inSuite, jobQueue.mPostedCount == 2);
+    NL_TEST_ASSERT(inSuite, gLoopback.mSentMessageCount == 5);
+    NL_TEST_ASSERT(inSuite, delegateAccessory.mNumPairingComplete == 1);
+    NL_TEST_ASSERT(inSuite, delegateCommissioner.mNumPairingComplete == 1);
+
+    NL_TEST_ASSERT(inSuite, pairingCommissioner.ToCachable(serializableCommissioner) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, pairingAccessory.ToCachable(serializableAccessory) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   memcmp(serializableCommissioner.mSharedSecret, serializableAccessory.mSharedSecret,
+                          serializableCommissioner.mSharedSecretLen) == 0);
+
+    Crypto::SetCryptoJobQueue(nullptr);
+}
+
 class TestPersistentStorageDelegate : public PersistentStorageDelegate, public FabricStorage
 {
 public:
@@ -381,6 +470,7 @@ void CASE_SecurePairingHandshakeServerTest(nlTestSuite * inSuite, void * inConte
 
     NL_TEST_ASSERT(inSuite, gLoopback.mSentMessageCount == 5);
     NL_TEST_ASSERT(inSuite, delegateCommissioner.mNumPairingComplete == 1);
+    NL_TEST_ASSERT(inSuite, gPairingServer.GetActiveHandshakeCount() == 0);
 
     auto * pairingCommissioner1            = chip::Platform::New<TestCASESessionIPK>();
     ExchangeContext * contextCommissioner1 = ctx.NewUnauthenticatedExchangeToBob(pairingCommissioner1);
@@ -394,6 +484,133 @@ void CASE_SecurePairingHandshakeServerTest(nlTestSuite * inSuite, void * inConte
     chip::Platform::Delete(pairingCommissioner1);
 }
 
+namespace chip {
+
+class TestCASEServer
+{
+public:
+    // Admits a Sigma1 from the given address and claims its responder slot, as OnMessageReceived does before running
+    // the CASE session.
+    static bool StartHandshake(CASEServer & server, const Transport::PeerAddress & address)
+    {
+        CASEServer::Responder * responder = server.AdmitPeer(address);
+        return responder != nullptr && server.Claim(*responder, address) == CHIP_NO_ERROR;
+    }
+
+    static size_t HandshakeCount(CASEServer & server, const Inet::IPAddress & address)
+    {
+        size_t count = 0;
+        for (CASEServer::Responder & responder : server.mResponders)
+        {
+            count += (responder.mInUse && responder.mPeerAddress.GetIPAddress() == address) ? 1 : 0;
+        }
+        return count;
+    }
+
+    static bool HasHandshake(CASEServer & server, const Transport::PeerAddress & address)
+    {
+        for (CASEServer::Responder & responder : server.mResponders)
+        {
+            if (responder.mInUse && responder.mPeerAddress == address)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Fires the establishment timeout of the handshakes with the given address.
+    static void TimeoutHandshakes(CASEServer & server, const Inet::IPAddress & address)
+    {
+        for (CASEServer::Responder & responder : server.mResponders)
+        {
+            if (responder.mInUse && responder.mPeerAddress.GetIPAddress() == address)
+            {
+                CASEServer::OnHandshakeTimeout(nullptr, &responder);
+            }
+        }
+    }
+};
+
+} // namespace chip
+
+namespace {
+
+Inet::IPAddress MakePeerIPAddress(uint8_t peer)
+{
+    char addressString[Inet::IPAddress::kMaxStringLength];
+    snprintf(addressString, sizeof(addressString), "fe80::%u", static_cast<unsigned>(peer + 1));
+    Inet::IPAddress address;
+    Inet::IPAddress::FromString(addressString, address);
+    return address;
+}
+
+TestCASEServerIPK gAdmissionServer;
+
+} // namespace
+
+void CASE_ServerAdmissionTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+    SessionIDAllocator idAllocator;
+
+    NL_TEST_ASSERT(inSuite,
+                   gAdmissionServer.ListenForSessionEstablishment(&ctx.GetExchangeManager(), &ctx.GetTransportMgr(), nullptr,
+                                                                  &ctx.GetSecureSessionManager(), &gDeviceFabrics,
+                                                                  &idAllocator) == CHIP_NO_ERROR);
+
+    // Handshakes with different peers run concurrently, up to the size of the pool.
+    for (uint8_t peer = 0; peer < CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS; peer++)
+    {
+        NL_TEST_ASSERT(inSuite,
+                       TestCASEServer::StartHandshake(gAdmissionServer, PeerAddress::UDP(MakePeerIPAddress(peer), CHIP_PORT)));
+        NL_TEST_ASSERT(inSuite, gAdmissionServer.GetActiveHandshakeCount() == peer + 1u);
+    }
+
+    // Once the pool is full, a new peer is turned away.
+    const Inet::IPAddress newPeer = MakePeerIPAddress(CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS);
+    NL_TEST_ASSERT(inSuite, !TestCASEServer::StartHandshake(gAdmissionServer, PeerAddress::UDP(newPeer, CHIP_PORT)));
+    NL_TEST_ASSERT(inSuite, gAdmissionServer.GetActiveHandshakeCount() == CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS);
+    NL_TEST_ASSERT(inSuite, TestCASEServer::HandshakeCount(gAdmissionServer, newPeer) == 0);
+
+    // A timed out handshake gives its slot back, and the new peer gets it.
+    const Inet::IPAddress firstPeer = MakePeerIPAddress(0);
+    TestCASEServer::TimeoutHandshakes(gAdmissionServer, firstPeer);
+    NL_TEST_ASSERT(inSuite, gAdmissionServer.GetActiveHandshakeCount() == CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS - 1);
+    NL_TEST_ASSERT(inSuite, TestCASEServer::HandshakeCount(gAdmissionServer, firstPeer) == 0);
+    NL_TEST_ASSERT(inSuite, TestCASEServer::StartHandshake(gAdmissionServer, PeerAddress::UDP(newPeer, CHIP_PORT)));
+    NL_TEST_ASSERT(inSuite, gAdmissionServer.GetActiveHandshakeCount() == CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS);
+
+    for (uint8_t peer = 0; peer <= CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS; peer++)
+    {
+        TestCASEServer::TimeoutHandshakes(gAdmissionServer, MakePeerIPAddress(peer));
+    }
+    NL_TEST_ASSERT(inSuite, gAdmissionServer.GetActiveHandshakeCount() == 0);
+
+    // While a responder is free, every Sigma1 is admitted, even several from the same peer address.
+    const PeerAddress firstAddress = PeerAddress::UDP(firstPeer, CHIP_PORT);
+    for (size_t i = 0; i < CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS; i++)
+    {
+        NL_TEST_ASSERT(inSuite, TestCASEServer::StartHandshake(gAdmissionServer, firstAddress));
+        NL_TEST_ASSERT(inSuite, TestCASEServer::HandshakeCount(gAdmissionServer, firstPeer) == i + 1);
+    }
+
+    // Once the pool is full, a new Sigma1 from an address at its limit replaces the oldest handshake of that address.
+    NL_TEST_ASSERT(inSuite,
+                   CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS_PER_PEER > CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS ||
+                       TestCASEServer::StartHandshake(gAdmissionServer, firstAddress));
+    NL_TEST_ASSERT(inSuite, gAdmissionServer.GetActiveHandshakeCount() == CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS);
+
+    // The same IP address on another port is another peer, which is turned away rather than replacing a handshake.
+    const PeerAddress otherPort = PeerAddress::UDP(firstPeer, static_cast<uint16_t>(CHIP_PORT + 1));
+    NL_TEST_ASSERT(inSuite, !TestCASEServer::StartHandshake(gAdmissionServer, otherPort));
+    NL_TEST_ASSERT(inSuite, !TestCASEServer::HasHandshake(gAdmissionServer, otherPort));
+    NL_TEST_ASSERT(inSuite, gAdmissionServer.GetActiveHandshakeCount() == CHIP_CONFIG_CASE_SERVER_MAX_RESPONDERS);
+
+    TestCASEServer::TimeoutHandshakes(gAdmissionServer, firstPeer);
+    NL_TEST_ASSERT(inSuite, gAdmissionServer.GetActiveHandshakeCount() == 0);
+}
+
 struct Sigma1Params
 {
     // Purposefully not using constants like kSigmaParamRandomNumberSize that
@@ -620,7 +837,9 @@ static const nlTest sTests[] =
     NL_TEST_DEF("WaitInit",    CASE_SecurePairingWaitTest),
     NL_TEST_DEF("Start",       CASE_SecurePairingStartTest),
     NL_TEST_DEF("Handshake",   CASE_SecurePairingHandshakeTest),
+    NL_TEST_DEF("OffloadedHandshake", CASE_SecurePairingOffloadedHandshakeTest),
     NL_TEST_DEF("ServerHandshake", CASE_SecurePairingHandshakeServerTest),
+    NL_TEST_DEF("ServerAdmission", CASE_ServerAdmissionTest),
     NL_TEST_DEF("Sigma1Parsing", CASE_Sigma1ParsingTest),
 
     NL_TEST_SENTINEL()
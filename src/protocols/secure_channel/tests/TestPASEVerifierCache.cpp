@@ -0,0 +1,234 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *    All rights reserved.
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file implements unit tests for the PASEVerifierCache implementation.
+ */
+
+#include <nlunit-test.h>
+
+#include <crypto/CryptoJobQueue.h>
+#include <lib/core/CHIPConfig.h>
+#include <lib/support/CHIPMem.h>
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <protocols/secure_channel/PASEVerifierCache.h>
+
+using namespace chip;
+
+namespace {
+
+constexpr uint32_t sTestSetupPINCode = 20202021;
+constexpr uint32_t sTestIterCount    = 1000;
+const uint8_t sTestSalt[]            = "PASE verifier cache test salt";
+
+bool IsSameVerifier(const PASEVerifier & a, const PASEVerifier & b)
+{
+    return memcmp(&a, &b, sizeof(PASEVerifier)) == 0;
+}
+
+class DeferredCryptoJobQueue : public Crypto::CryptoJobQueue
+{
+public:
+    CHIP_ERROR Post(Crypto::CryptoJob & job) override
+    {
+        VerifyOrReturnError(mPending == nullptr, CHIP_ERROR_NO_MEMORY);
+        mPending = &job;
+        return CHIP_NO_ERROR;
+    }
+
+    bool RunPendingJob()
+    {
+        Crypto::CryptoJob * job = mPending;
+        if (job == nullptr)
+        {
+            return false;
+        }
+        mPending = nullptr;
+
+        job->Run();
+        job->OnComplete();
+        return true;
+    }
+
+private:
+    Crypto::CryptoJob * mPending = nullptr;
+};
+
+} // namespace
+
+void PASEVerifierCache_AddGet_Test(nlTestSuite * inSuite, void * inContext)
+{
+    PASEVerifierCache cache;
+    PASEVerifier computed, cached;
+    ByteSpan salt(sTestSalt);
+
+    NL_TEST_ASSERT(inSuite, cache.Get(sTestSetupPINCode, sTestIterCount, salt, cached) == CHIP_ERROR_KEY_NOT_FOUND);
+
+    NL_TEST_ASSERT(inSuite, PASEVerifierCache::Compute(sTestSetupPINCode, sTestIterCount, salt, computed) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.Add(sTestSetupPINCode, sTestIterCount, salt, computed) == CHIP_NO_ERROR);
+
+    NL_TEST_ASSERT(inSuite, cache.Get(sTestSetupPINCode, sTestIterCount, salt, cached) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, IsSameVerifier(computed, cached));
+
+    // Every input is part of the lookup key.
+    NL_TEST_ASSERT(inSuite, cache.Get(sTestSetupPINCode + 1, sTestIterCount, salt, cached) == CHIP_ERROR_KEY_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, cache.Get(sTestSetupPINCode, sTestIterCount + 1, salt, cached) == CHIP_ERROR_KEY_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite,
+                   cache.Get(sTestSetupPINCode, sTestIterCount, salt.SubSpan(1), cached) == CHIP_ERROR_KEY_NOT_FOUND);
+
+    cache.Clear();
+    NL_TEST_ASSERT(inSuite, cache.Get(sTestSetupPINCode, sTestIterCount, salt, cached) == CHIP_ERROR_KEY_NOT_FOUND);
+}
+
+void PASEVerifierCache_AddWhenFull_Test(nlTestSuite * inSuite, void * inContext)
+{
+    PASEVerifierCache cache;
+    PASEVerifier verifier;
+    ByteSpan salt(sTestSalt);
+
+    for (uint32_t i = 0; i <= CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE; i++)
+    {
+        memset(&verifier, static_cast<int>(i), sizeof(verifier));
+        NL_TEST_ASSERT(inSuite, cache.Add(sTestSetupPINCode + i, sTestIterCount, salt, verifier) == CHIP_NO_ERROR);
+    }
+
+    // The oldest verifier was replaced.
+    NL_TEST_ASSERT(inSuite, cache.Get(sTestSetupPINCode, sTestIterCount, salt, verifier) == CHIP_ERROR_KEY_NOT_FOUND);
+    for (uint32_t i = 1; i <= CHIP_CONFIG_PASE_VERIFIER_CACHE_SIZE; i++)
+    {
+        NL_TEST_ASSERT(inSuite, cache.Get(sTestSetupPINCode + i, sTestIterCount, salt, verifier) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, verifier.mW0[0] == i);
+    }
+}
+
+void PASEVerifierCache_Precompute_Test(nlTestSuite * inSuite, void * inContext)
+{
+    PASEVerifierCache cache;
+    DeferredCryptoJobQueue jobQueue;
+    PASEVerifier computed, cached;
+    ByteSpan salt(sTestSalt);
+
+    // Without a crypto job queue, the verifier is left to be computed when needed.
+    NL_TEST_ASSERT(inSuite, cache.Precompute(sTestSetupPINCode, sTestIterCount, salt) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.Get(sTestSetupPINCode, sTestIterCount, salt, cached) == CHIP_ERROR_KEY_NOT_FOUND);
+
+    Crypto::SetCryptoJobQueue(&jobQueue);
+
+    NL_TEST_ASSERT(inSuite, cache.Precompute(sTestSetupPINCode, sTestIterCount, salt) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.Get(sTestSetupPINCode, sTestIterCount, salt, cached) == CHIP_ERROR_KEY_NOT_FOUND);
+    NL_TEST_ASSERT(inSuite, jobQueue.RunPendingJob());
+
+    NL_TEST_ASSERT(inSuite, PASEVerifierCache::Compute(sTestSetupPINCode, sTestIterCount, salt, computed) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, cache.Get(sTestSetupPINCode, sTestIterCount, salt, cached) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, IsSameVerifier(computed, cached));
+
+    // A cached verifier isn't computed again.
+    NL_TEST_ASSERT(inSuite, cache.Precompute(sTestSetupPINCode, sTestIterCount, salt) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, !jobQueue.RunPendingJob());
+
+    // A verifier derived after the cache was cleared, e.g. by the commissioning window closing, is dropped.
+    cache.Clear();
+    NL_TEST_ASSERT(inSuite, cache.Precompute(sTestSetupPINCode, sTestIterCount, salt) == CHIP_NO_ERROR);
+    cache.Clear();
+    NL_TEST_ASSERT(inSuite, jobQueue.RunPendingJob());
+    NL_TEST_ASSERT(inSuite, cache.Get(sTestSetupPINCode, sTestIterCount, salt, cached) == CHIP_ERROR_KEY_NOT_FOUND);
+
+    Crypto::SetCryptoJobQueue(nullptr);
+}
+
+void PASEVerifierCache_GeneratePASEVerifier_Test(nlTestSuite * inSuite, void * inContext)
+{
+    PASEVerifier computed, generated, cached;
+    ByteSpan salt(sTestSalt);
+    uint32_t setupPINCode = sTestSetupPINCode;
+
+    PASEVerifierCache::Instance().Clear();
+
+    NL_TEST_ASSERT(inSuite,
+                   PASESession::GeneratePASEVerifier(generated, sTestIterCount, salt, false, setupPINCode) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, PASEVerifierCache::Compute(sTestSetupPINCode, sTestIterCount, salt, computed) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, IsSameVerifier(computed, generated));
+
+    NL_TEST_ASSERT(inSuite,
+                   PASEVerifierCache::Instance().Get(sTestSetupPINCode, sTestIterCount, salt, cached) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, IsSameVerifier(computed, cached));
+
+    PASEVerifierCache::Instance().Clear();
+}
+
+// Test Suite
+
+/**
+ *  Test Suite that lists all the test functions.
+ */
+// clang-format off
+static const nlTest sTests[] =
+{
+    NL_TEST_DEF("AddGet", PASEVerifierCache_AddGet_Test),
+    NL_TEST_DEF("AddWhenFull", PASEVerifierCache_AddWhenFull_Test),
+    NL_TEST_DEF("Precompute", PASEVerifierCache_Precompute_Test),
+    NL_TEST_DEF("GeneratePASEVerifier", PASEVerifierCache_GeneratePASEVerifier_Test),
+
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int PASEVerifierCache_Test_Setup(void * inContext);
+int PASEVerifierCache_Test_Teardown(void * inContext);
+
+// clang-format off
+static nlTestSuite sSuite =
+{
+    "Test-CHIP-SecurePairing-PASEVerifierCache",
+    &sTests[0],
+    PASEVerifierCache_Test_Setup,
+    PASEVerifierCache_Test_Teardown,
+};
+// clang-format on
+
+/**
+ *  Set up the test suite.
+ */
+int PASEVerifierCache_Test_Setup(void * inContext)
+{
+    return chip::Platform::MemoryInit() == CHIP_NO_ERROR ? SUCCESS : FAILURE;
+}
+
+/**
+ *  Tear down the test suite.
+ */
+int PASEVerifierCache_Test_Teardown(void * inContext)
+{
+    chip::Platform::MemoryShutdown();
+    return SUCCESS;
+}
+
+/**
+ *  Main
+ */
+int TestPASEVerifierCache()
+{
+    // Run test suit against one context
+    nlTestRunner(&sSuite, nullptr);
+
+    return (nlTestRunnerStats(&sSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestPASEVerifierCache)
@@ -450,6 +450,19 @@ struct LwIPEvent;
 #define CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS 0
 #endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
 
+/**
+ *  @def CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+ *
+ *  @brief
+ *      This defines whether (1) or not (0) the CHIP System Layer provides the runtime metrics registry: named counters,
+ *      gauges and latency histograms that can be queried at runtime and exported in the Prometheus text format.
+ *
+ *      The metrics are updated with 64-bit atomic operations, so this is meant for targets where those are cheap.
+ */
+#ifndef CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+#define CHIP_SYSTEM_CONFIG_PROVIDE_METRICS 0
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+
 /**
  *  @def CHIP_SYSTEM_CONFIG_TEST
  *
@@ -0,0 +1,255 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *  This file implements the runtime metrics registry and its Prometheus text exporter.
+ */
+
+// Include module header
+#include <system/SystemMetrics.h>
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+
+#include <lib/support/logging/CHIPLogging.h>
+#include <system/SystemStats.h>
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace chip {
+namespace System {
+namespace Metrics {
+
+namespace {
+
+// Constant-initialized, so that metrics can register themselves during static initialization.
+std::atomic<Metric *> sMetrics{ nullptr };
+
+class PrometheusWriter
+{
+public:
+    PrometheusWriter(OutputFunction output, void * context) : mOutput(output), mContext(context) {}
+
+    void Printf(const char * format, ...) ENFORCE_FORMAT(2, 3)
+    {
+        char line[160];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(line, sizeof(line), format, args);
+        va_end(args);
+        mOutput(line, mContext);
+    }
+
+    void Header(const char * name, const char * suffix, const char * help, const char * type)
+    {
+        Printf("# HELP %s%s %s\n", name, suffix, help);
+        Printf("# TYPE %s%s %s\n", name, suffix, type);
+    }
+
+    void Write(const Counter & counter)
+    {
+        Header(counter.GetName(), "", counter.GetHelp(), "counter");
+        Printf("%s %" PRIu64 "\n", counter.GetName(), counter.Get());
+    }
+
+    void Write(const Gauge & gauge)
+    {
+        Header(gauge.GetName(), "", gauge.GetHelp(), "gauge");
+        Printf("%s %" PRId64 "\n", gauge.GetName(), gauge.Get());
+        Header(gauge.GetName(), "_high_watermark", "Highest value reached", "gauge");
+        Printf("%s_high_watermark %" PRId64 "\n", gauge.GetName(), gauge.GetHighWatermark());
+    }
+
+    void Write(const Histogram & histogram)
+    {
+        Header(histogram.GetName(), "", histogram.GetHelp(), "histogram");
+
+        // Prometheus buckets are cumulative. Trailing empty buckets are folded into +Inf to keep the output short.
+        size_t lastUsedBucket = 0;
+        for (size_t i = 0; i < Histogram::kNumBuckets; i++)
+        {
+            if (histogram.GetBucketCount(i) != 0)
+            {
+                lastUsedBucket = i;
+            }
+        }
+
+        uint64_t cumulativeCount = 0;
+        for (size_t i = 0; i < Histogram::kNumBuckets; i++)
+        {
+            cumulativeCount += histogram.GetBucketCount(i);
+            if (i <= lastUsedBucket && i < Histogram::kNumBuckets - 1)
+            {
+                Printf("%s_bucket{le=\"%" PRIu64 "\"} %" PRIu64 "\n", histogram.GetName(), Histogram::GetBucketUpperBound(i),
+                       cumulativeCount);
+            }
+        }
+
+        // The count is taken from the buckets rather than GetCount() so that the output stays consistent under concurrent
+        // updates.
+        Printf("%s_bucket{le=\"+Inf\"} %" PRIu64 "\n", histogram.GetName(), cumulativeCount);
+        Printf("%s_sum %" PRIu64 "\n", histogram.GetName(), histogram.GetSum());
+        Printf("%s_count %" PRIu64 "\n", histogram.GetName(), cumulativeCount);
+    }
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    void WriteSystemStats()
+    {
+        Stats::Snapshot snapshot;
+        Stats::UpdateSnapshot(snapshot);
+        const Stats::Label * labels = Stats::GetStrings();
+
+        Header("chip_system_resources_in_use", "", "Number of System Layer resources in use", "gauge");
+        for (int i = 0; i < Stats::kNumEntries; i++)
+        {
+            Printf("chip_system_resources_in_use{resource=\"%s\"} %" PRI_CHIP_SYS_STATS_COUNT "\n", labels[i],
+                   snapshot.mResourcesInUse[i]);
+        }
+
+        Header("chip_system_resources_high_watermark", "", "Highest number of System Layer resources in use", "gauge");
+        for (int i = 0; i < Stats::kNumEntries; i++)
+        {
+            Printf("chip_system_resources_high_watermark{resource=\"%s\"} %" PRI_CHIP_SYS_STATS_COUNT "\n", labels[i],
+                   snapshot.mHighWatermarks[i]);
+        }
+    }
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+
+private:
+    OutputFunction mOutput;
+    void * mContext;
+};
+
+} // namespace
+
+Metric::Metric(const char * name, const char * help, Type type) : mName(name), mHelp(help), mType(type)
+{
+    mNext = sMetrics.load(std::memory_order_relaxed);
+    while (!sMetrics.compare_exchange_weak(mNext, this, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+}
+
+void Gauge::UpdateHighWatermark(int64_t value)
+{
+    int64_t highWatermark = mHighWatermark.load(std::memory_order_relaxed);
+    while (value > highWatermark &&
+           !mHighWatermark.compare_exchange_weak(highWatermark, value, std::memory_order_relaxed, std::memory_order_relaxed))
+    {
+    }
+}
+
+size_t Histogram::GetBucketIndex(uint64_t value)
+{
+    size_t bucket = 0;
+    while (bucket < kNumBuckets - 1 && (static_cast<uint64_t>(1) << bucket) < value)
+    {
+        bucket++;
+    }
+    return bucket;
+}
+
+uint64_t Histogram::GetBucketUpperBound(size_t bucket)
+{
+    return (bucket < kNumBuckets - 1) ? (static_cast<uint64_t>(1) << bucket) : UINT64_MAX;
+}
+
+void Histogram::Record(uint64_t value)
+{
+    mBuckets[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    mCount.fetch_add(1, std::memory_order_relaxed);
+    mSum.fetch_add(value, std::memory_order_relaxed);
+}
+
+uint64_t Histogram::GetPercentileUpperBound(uint8_t percentile) const
+{
+    uint64_t count = 0;
+    uint64_t bucketCounts[kNumBuckets];
+    for (size_t i = 0; i < kNumBuckets; i++)
+    {
+        bucketCounts[i] = GetBucketCount(i);
+        count += bucketCounts[i];
+    }
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    // The rank of the value at the percentile, rounded up so that e.g. the 50th percentile of a single value is that value.
+    uint64_t rank       = (count * (percentile < 100 ? percentile : 100) + 99) / 100;
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < kNumBuckets; i++)
+    {
+        cumulative += bucketCounts[i];
+        if (cumulative >= rank && cumulative != 0)
+        {
+            return GetBucketUpperBound(i);
+        }
+    }
+    return UINT64_MAX;
+}
+
+const Metric * GetFirstMetric()
+{
+    return sMetrics.load(std::memory_order_acquire);
+}
+
+const Metric * FindMetric(const char * name)
+{
+    for (const Metric * metric = GetFirstMetric(); metric != nullptr; metric = metric->GetNext())
+    {
+        if (strcmp(metric->GetName(), name) == 0)
+        {
+            return metric;
+        }
+    }
+    return nullptr;
+}
+
+void WritePrometheusText(OutputFunction output, void * context)
+{
+    PrometheusWriter writer(output, context);
+
+    for (const Metric * metric = GetFirstMetric(); metric != nullptr; metric = metric->GetNext())
+    {
+        switch (metric->GetType())
+        {
+        case Metric::Type::kCounter:
+            writer.Write(*static_cast<const Counter *>(metric));
+            break;
+        case Metric::Type::kGauge:
+            writer.Write(*static_cast<const Gauge *>(metric));
+            break;
+        case Metric::Type::kHistogram:
+            writer.Write(*static_cast<const Histogram *>(metric));
+            break;
+        }
+    }
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+    writer.WriteSystemStats();
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+}
+
+} // namespace Metrics
+} // namespace System
+} // namespace chip
+
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
@@ -0,0 +1,233 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *  This file defines the runtime metrics registry: named counters, gauges and latency histograms that the stack updates
+ *  as it runs, and that can be queried at runtime or exported in the Prometheus text exposition format.
+ *
+ *  Metrics are statically allocated and register themselves on construction. Updates are lock-free, so they can be
+ *  made from any thread.
+ *
+ *  The registry is compiled in only when CHIP_SYSTEM_CONFIG_PROVIDE_METRICS is set; otherwise the SYSTEM_METRICS_*
+ *  macros expand to nothing.
+ */
+
+#pragma once
+
+// Include configuration headers
+#include <system/SystemConfig.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+
+#include <atomic>
+
+namespace chip {
+namespace System {
+namespace Metrics {
+
+class Metric
+{
+public:
+    enum class Type : uint8_t
+    {
+        kCounter,
+        kGauge,
+        kHistogram,
+    };
+
+    const char * GetName() const { return mName; }
+    const char * GetHelp() const { return mHelp; }
+    Type GetType() const { return mType; }
+
+    /**
+     * @return The next registered metric, or nullptr if this is the last one.
+     */
+    const Metric * GetNext() const { return mNext; }
+
+    Metric(const Metric &) = delete;
+    Metric & operator=(const Metric &) = delete;
+
+protected:
+    /**
+     * @param[in] name  The metric name, following the Prometheus naming conventions (e.g. "chip_foo_total"). It must
+     *                  outlive the metric, and is normally a literal.
+     * @param[in] help  A one-line description of the metric, with the same lifetime requirements as the name.
+     */
+    Metric(const char * name, const char * help, Type type);
+
+    // Metrics are never unregistered, so they must live until the process exits.
+    ~Metric() = default;
+
+private:
+    const char * mName;
+    const char * mHelp;
+    Type mType;
+    Metric * mNext = nullptr;
+};
+
+/**
+ * A monotonically increasing count of events.
+ */
+class Counter : public Metric
+{
+public:
+    Counter(const char * name, const char * help) : Metric(name, help, Type::kCounter) {}
+
+    void Add(uint64_t value) { mValue.fetch_add(value, std::memory_order_relaxed); }
+    void Increment() { Add(1); }
+    uint64_t Get() const { return mValue.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> mValue{ 0 };
+};
+
+/**
+ * A value that can go up and down, such as the number of objects in use, along with the highest value it has reached.
+ */
+class Gauge : public Metric
+{
+public:
+    Gauge(const char * name, const char * help) : Metric(name, help, Type::kGauge) {}
+
+    void Set(int64_t value)
+    {
+        mValue.store(value, std::memory_order_relaxed);
+        UpdateHighWatermark(value);
+    }
+    void Increment() { UpdateHighWatermark(mValue.fetch_add(1, std::memory_order_relaxed) + 1); }
+    void Decrement() { mValue.fetch_sub(1, std::memory_order_relaxed); }
+
+    int64_t Get() const { return mValue.load(std::memory_order_relaxed); }
+    int64_t GetHighWatermark() const { return mHighWatermark.load(std::memory_order_relaxed); }
+
+private:
+    void UpdateHighWatermark(int64_t value);
+
+    std::atomic<int64_t> mValue{ 0 };
+    std::atomic<int64_t> mHighWatermark{ 0 };
+};
+
+/**
+ * A distribution of values, such as latencies or sizes, counted into power-of-two buckets: bucket i counts the values
+ * in (2^(i-1), 2^i], bucket 0 counts 0 and 1, and the last bucket counts everything larger than the one before it.
+ */
+class Histogram : public Metric
+{
+public:
+    static constexpr size_t kNumBuckets = 32;
+
+    Histogram(const char * name, const char * help) : Metric(name, help, Type::kHistogram) {}
+
+    void Record(uint64_t value);
+
+    uint64_t GetCount() const { return mCount.load(std::memory_order_relaxed); }
+    uint64_t GetSum() const { return mSum.load(std::memory_order_relaxed); }
+    uint64_t GetBucketCount(size_t bucket) const { return mBuckets[bucket].load(std::memory_order_relaxed); }
+
+    /**
+     * @return The largest value counted by the bucket, or UINT64_MAX for the last bucket.
+     */
+    static uint64_t GetBucketUpperBound(size_t bucket);
+
+    /**
+     * @return The index of the bucket that counts the value.
+     */
+    static size_t GetBucketIndex(uint64_t value);
+
+    /**
+     * @return An upper bound of the given percentile (0-100) of the recorded values: the upper bound of the bucket it
+     *         falls in. Returns 0 if nothing was recorded.
+     */
+    uint64_t GetPercentileUpperBound(uint8_t percentile) const;
+
+private:
+    std::atomic<uint64_t> mBuckets[kNumBuckets] = {};
+    std::atomic<uint64_t> mCount{ 0 };
+    std::atomic<uint64_t> mSum{ 0 };
+};
+
+/**
+ * @return The first registered metric, or nullptr if there is none. Use Metric::GetNext() to walk the registry.
+ */
+const Metric * GetFirstMetric();
+
+/**
+ * @return The registered metric with the given name, or nullptr if there is none.
+ */
+const Metric * FindMetric(const char * name);
+
+/**
+ * Called with successive pieces of the exported text.
+ */
+typedef void (*OutputFunction)(const char * text, void * context);
+
+/**
+ * Write all registered metrics in the Prometheus text exposition format. When CHIP_SYSTEM_CONFIG_PROVIDE_STATISTICS
+ * is set, the System::Stats resource counts are exported as well.
+ */
+void WritePrometheusText(OutputFunction output, void * context);
+
+} // namespace Metrics
+} // namespace System
+} // namespace chip
+
+/**
+ * Define a metric at namespace or function scope, e.g.
+ * SYSTEM_METRICS_COUNTER(sDropped, "chip_foo_dropped_total", "Number of dropped foos").
+ */
+#define SYSTEM_METRICS_COUNTER(var, name, help) static ::chip::System::Metrics::Counter var(name, help)
+#define SYSTEM_METRICS_GAUGE(var, name, help) static ::chip::System::Metrics::Gauge var(name, help)
+#define SYSTEM_METRICS_HISTOGRAM(var, name, help) static ::chip::System::Metrics::Histogram var(name, help)
+
+#define SYSTEM_METRICS_INCREMENT(var) (var).Increment()
+#define SYSTEM_METRICS_ADD(var, value) (var).Add(value)
+#define SYSTEM_METRICS_DECREMENT(var) (var).Decrement()
+#define SYSTEM_METRICS_SET(var, value) (var).Set(value)
+#define SYSTEM_METRICS_RECORD(var, value) (var).Record(value)
+
+#else // CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+
+#define SYSTEM_METRICS_COUNTER(var, name, help) static_assert(true, "")
+#define SYSTEM_METRICS_GAUGE(var, name, help) static_assert(true, "")
+#define SYSTEM_METRICS_HISTOGRAM(var, name, help) static_assert(true, "")
+
+#define SYSTEM_METRICS_INCREMENT(var)                                                                                              \
+    do                                                                                                                             \
+    {                                                                                                                              \
+    } while (0)
+#define SYSTEM_METRICS_ADD(var, value)                                                                                             \
+    do                                                                                                                             \
+    {                                                                                                                              \
+    } while (0)
+#define SYSTEM_METRICS_DECREMENT(var)                                                                                              \
+    do                                                                                                                             \
+    {                                                                                                                              \
+    } while (0)
+#define SYSTEM_METRICS_SET(var, value)                                                                                             \
+    do                                                                                                                             \
+    {                                                                                                                              \
+    } while (0)
+#define SYSTEM_METRICS_RECORD(var, value)                                                                                          \
+    do                                                                                                                             \
+    {                                                                                                                              \
+    } while (0)
+
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
@@ -36,6 +36,7 @@
 #include <lib/support/SafeInt.h>
 #include <lib/support/logging/CHIPLogging.h>
 #include <system/SystemFaultInjection.h>
+#include <system/SystemMetrics.h>
 #include <system/SystemMutex.h>
 #include <system/SystemStats.h>
 
@@ -59,6 +60,10 @@
 namespace chip {
 namespace System {
 
+SYSTEM_METRICS_GAUGE(sPacketBuffersInUse, "chip_packet_buffers_in_use", "Number of packet buffers in use");
+SYSTEM_METRICS_COUNTER(sPacketBufferAllocationFailures, "chip_packet_buffer_allocation_failures_total",
+                       "Number of packet buffers that could not be allocated");
+
 #if CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_POOL
 //
 // Pool allocation for PacketBuffer objects.
@@ -493,10 +498,16 @@ PacketBufferHandle PacketBufferHandle::New(size_t aAvailableSize, uint16_t aRese
 
     if (lPacket == nullptr)
     {
+        SYSTEM_METRICS_INCREMENT(sPacketBufferAllocationFailures);
         ChipLogError(chipSystemLayer, "PacketBuffer: pool EMPTY.");
         return PacketBufferHandle();
     }
 
+#if CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_POOL ||                                                \
+    CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP
+    SYSTEM_METRICS_INCREMENT(sPacketBuffersInUse);
+#endif
+
     lPacket->payload = reinterpret_cast<uint8_t *>(lPacket) + PacketBuffer::kStructureSize + aReservedSize;
     lPacket->len = lPacket->tot_len = 0;
     lPacket->next                   = nullptr;
@@ -563,6 +574,7 @@ void PacketBuffer::Free(PacketBuffer * aPacket)
         if (aPacket->ref == 0)
         {
             SYSTEM_STATS_DECREMENT(chip::System::Stats::kSystemLayer_NumPacketBufs);
+            SYSTEM_METRICS_DECREMENT(sPacketBuffersInUse);
 #if CHIP_SYSTEM_PACKETBUFFER_STORE == CHIP_SYSTEM_PACKETBUFFER_STORE_CHIP_HEAP
             ::chip::Platform::MemoryDebugCheckPointer(aPacket, aPacket->alloc_size + kStructureSize);
 #endif
@@ -0,0 +1,162 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *  This file implements the structured trace ring buffers.
+ */
+
+// Include module header
+#include <system/SystemTrace.h>
+
+#include <system/SystemClock.h>
+
+#if CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+#include <atomic>
+#include <new>
+#endif // CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+
+namespace chip {
+namespace System {
+namespace Trace {
+
+const char * GetCategoryName(Category category)
+{
+    switch (category)
+    {
+    case Category::kMessaging:
+        return "Messaging";
+    case Category::kTransport:
+        return "Transport";
+    case Category::kSecureChannel:
+        return "SecureChannel";
+    case Category::kInteractionModel:
+        return "InteractionModel";
+    }
+    return "Unknown";
+}
+
+#if CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+
+namespace {
+
+constexpr uint32_t kBufferSize = CHIP_CONFIG_STRUCTURED_TRACE_BUFFER_SIZE;
+
+// The ring indices wrap around at 2^32, which must stay a multiple of the buffer size.
+static_assert(kBufferSize > 0 && (kBufferSize & (kBufferSize - 1)) == 0, "The trace buffer size must be a power of two");
+
+/**
+ * A single-producer, single-consumer ring: the owning thread advances mHead as it records events, and the draining
+ * thread advances mTail as it consumes them. Buffers are registered once and kept for the lifetime of the process, so
+ * that events recorded by threads that have exited can still be drained.
+ */
+struct ThreadBuffer
+{
+    Event mEvents[kBufferSize];
+    std::atomic<uint32_t> mHead{ 0 };
+    std::atomic<uint32_t> mTail{ 0 };
+    uint32_t mThreadId   = 0;
+    ThreadBuffer * mNext = nullptr;
+};
+
+std::atomic<ThreadBuffer *> sThreadBuffers{ nullptr };
+std::atomic<uint32_t> sThreadCount{ 0 };
+std::atomic<uint64_t> sDroppedEventCount{ 0 };
+
+thread_local ThreadBuffer * tThreadBuffer = nullptr;
+
+ThreadBuffer * GetThreadBuffer()
+{
+    if (tThreadBuffer != nullptr)
+    {
+        return tThreadBuffer;
+    }
+
+    // Buffers outlive chip::Platform::MemoryShutdown(), so they are not allocated from the CHIP heap.
+    ThreadBuffer * buffer = new (std::nothrow) ThreadBuffer();
+    if (buffer == nullptr)
+    {
+        return nullptr;
+    }
+    buffer->mThreadId = sThreadCount.fetch_add(1, std::memory_order_relaxed);
+
+    buffer->mNext = sThreadBuffers.load(std::memory_order_relaxed);
+    while (!sThreadBuffers.compare_exchange_weak(buffer->mNext, buffer, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+
+    tThreadBuffer = buffer;
+    return buffer;
+}
+
+} // namespace
+
+void Record(Category category, EventType type, const char * name, int64_t value)
+{
+    ThreadBuffer * buffer = GetThreadBuffer();
+    if (buffer == nullptr)
+    {
+        sDroppedEventCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    uint32_t head = buffer->mHead.load(std::memory_order_relaxed);
+    uint32_t tail = buffer->mTail.load(std::memory_order_acquire);
+    if (head - tail >= kBufferSize)
+    {
+        sDroppedEventCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Event & event      = buffer->mEvents[head % kBufferSize];
+    event.mTimestampUs = SystemClock().GetMonotonicMicroseconds64().count();
+    event.mName        = name;
+    event.mValue       = value;
+    event.mCategory    = category;
+    event.mType        = type;
+    buffer->mHead.store(head + 1, std::memory_order_release);
+}
+
+size_t DrainEvents(EventHandler handler, void * context)
+{
+    size_t drainedCount = 0;
+
+    for (ThreadBuffer * buffer = sThreadBuffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->mNext)
+    {
+        uint32_t tail = buffer->mTail.load(std::memory_order_relaxed);
+        uint32_t head = buffer->mHead.load(std::memory_order_acquire);
+        for (; tail != head; tail++)
+        {
+            handler(buffer->mThreadId, buffer->mEvents[tail % kBufferSize], context);
+            drainedCount++;
+        }
+        buffer->mTail.store(tail, std::memory_order_release);
+    }
+
+    return drainedCount;
+}
+
+uint64_t GetDroppedEventCount()
+{
+    return sDroppedEventCount.load(std::memory_order_relaxed);
+}
+
+#endif // CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+
+} // namespace Trace
+} // namespace System
+} // namespace chip
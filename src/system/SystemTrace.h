@@ -0,0 +1,194 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ * @file
+ *  This file defines the structured trace API: spans and counters recorded into per-thread ring buffers, to be
+ *  drained and exported (e.g. to the Chrome trace format) by the application.
+ *
+ *  Recording is compiled in only when CHIP_CONFIG_STRUCTURED_TRACE_ENABLED is set; otherwise the CHIP_TRACE_*
+ *  macros expand to nothing.
+ */
+
+#pragma once
+
+// Include configuration headers
+#include <lib/core/CHIPConfig.h>
+#include <system/SystemConfig.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace chip {
+namespace System {
+namespace Trace {
+
+enum class Category : uint8_t
+{
+    kMessaging,
+    kTransport,
+    kSecureChannel,
+    kInteractionModel,
+};
+
+enum class EventType : uint8_t
+{
+    kBegin,      ///< Start of a span on the recording thread.
+    kEnd,        ///< End of the innermost open span on the recording thread.
+    kAsyncBegin, ///< Start of a span identified by mValue, which may end on any thread.
+    kAsyncEnd,   ///< End of the span identified by mValue.
+    kCounter,    ///< Sample of the counter named mName, with value mValue.
+    kInstant,    ///< A point in time.
+};
+
+struct Event
+{
+    uint64_t mTimestampUs; ///< Monotonic timestamp, in microseconds.
+    const char * mName;    ///< Statically allocated name of the span or counter.
+    int64_t mValue;        ///< Span identifier for asynchronous spans, sample value for counters.
+    Category mCategory;
+    EventType mType;
+};
+
+const char * GetCategoryName(Category category);
+
+/**
+ * Called for each drained event, with a small integer identifying the thread that recorded it.
+ */
+typedef void (*EventHandler)(uint32_t threadId, const Event & event, void * context);
+
+#if CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+
+/**
+ * Record an event into the calling thread's ring buffer. This is lock-free; if the buffer is full, the event is
+ * dropped and counted.
+ *
+ * @param[in] name  A string that outlives the trace, normally a literal.
+ */
+void Record(Category category, EventType type, const char * name, int64_t value);
+
+/**
+ * Pass the events recorded so far to the handler, one thread at a time and in order for each thread, and remove them
+ * from the buffers. Only one thread may drain at a time.
+ *
+ * @return The number of drained events.
+ */
+size_t DrainEvents(EventHandler handler, void * context);
+
+/**
+ * @return The number of events dropped so far because a buffer was full.
+ */
+uint64_t GetDroppedEventCount();
+
+/**
+ * Records a span covering the lifetime of the object.
+ */
+class Scope
+{
+public:
+    Scope(Category category, const char * name) : mCategory(category), mName(name)
+    {
+        Record(mCategory, EventType::kBegin, mName, 0);
+    }
+    ~Scope() { Record(mCategory, EventType::kEnd, mName, 0); }
+
+    Scope(const Scope &) = delete;
+    Scope & operator=(const Scope &) = delete;
+
+private:
+    Category mCategory;
+    const char * mName;
+};
+
+#else // CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+
+inline size_t DrainEvents(EventHandler handler, void * context)
+{
+    return 0;
+}
+
+inline uint64_t GetDroppedEventCount()
+{
+    return 0;
+}
+
+#endif // CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+
+} // namespace Trace
+} // namespace System
+} // namespace chip
+
+#if CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+
+#define _CHIP_TRACE_CONCAT(a, b) a##b
+#define _CHIP_TRACE_SCOPE_NAME(line) _CHIP_TRACE_CONCAT(_chipTraceScope, line)
+
+#define _CHIP_TRACE_RECORD(category, type, name, value)                                                                           \
+    ::chip::System::Trace::Record(::chip::System::Trace::Category::k##category, ::chip::System::Trace::EventType::type, name,     \
+                                  static_cast<int64_t>(value))
+
+/**
+ * Record a span from this point to the end of the enclosing scope, e.g. CHIP_TRACE_SCOPE(Transport, "Encrypt").
+ */
+#define CHIP_TRACE_SCOPE(category, name)                                                                                           \
+    ::chip::System::Trace::Scope _CHIP_TRACE_SCOPE_NAME(__LINE__)(::chip::System::Trace::Category::k##category, name)
+
+#define CHIP_TRACE_BEGIN(category, name) _CHIP_TRACE_RECORD(category, kBegin, name, 0)
+#define CHIP_TRACE_END(category, name) _CHIP_TRACE_RECORD(category, kEnd, name, 0)
+
+/**
+ * Record the start and end of a span that does not follow the call stack, such as the lifetime of an object. The id
+ * tells concurrent spans of the same name apart.
+ */
+#define CHIP_TRACE_ASYNC_BEGIN(category, name, id) _CHIP_TRACE_RECORD(category, kAsyncBegin, name, id)
+#define CHIP_TRACE_ASYNC_END(category, name, id) _CHIP_TRACE_RECORD(category, kAsyncEnd, name, id)
+
+#define CHIP_TRACE_COUNTER(category, name, value) _CHIP_TRACE_RECORD(category, kCounter, name, value)
+#define CHIP_TRACE_INSTANT(category, name) _CHIP_TRACE_RECORD(category, kInstant, name, 0)
+
+#else // CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+
+#define CHIP_TRACE_SCOPE(category, name)                                                                                           \
+    do                                                                                                                             \
+    {                                                                                                                              \
+    } while (0)
+#define CHIP_TRACE_BEGIN(category, name)                                                                                           \
+    do                                                                                                                             \
+    {                                                                                                                              \
+    } while (0)
+#define CHIP_TRACE_END(category, name)                                                                                             \
+    do                                                                                                                             \
+    {                                                                                                                              \
+    } while (0)
+#define CHIP_TRACE_ASYNC_BEGIN(category, name, id)                                                                                 \
+    do                                                                                                                             \
+    {                                                                                                                              \
+    } while (0)
+#define CHIP_TRACE_ASYNC_END(category, name, id)                                                                                   \
+    do                                                                                                                             \
+    {                                                                                                                              \
+    } while (0)
+#define CHIP_TRACE_COUNTER(category, name, value)                                                                                  \
+    do                                                                                                                             \
+    {                                                                                                                              \
+    } while (0)
+#define CHIP_TRACE_INSTANT(category, name)                                                                                         \
+    do                                                                                                                             \
+    {                                                                                                                              \
+    } while (0)
+
+#endif // CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
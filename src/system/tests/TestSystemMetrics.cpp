@@ -0,0 +1,208 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a unit test suite for the runtime metrics registry.
+ */
+
+#include <system/SystemConfig.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+#include <system/SystemMetrics.h>
+
+#include <string>
+
+namespace {
+
+SYSTEM_METRICS_COUNTER(sTestCounter, "chip_test_events_total", "Test counter");
+SYSTEM_METRICS_GAUGE(sTestGauge, "chip_test_objects_in_use", "Test gauge");
+SYSTEM_METRICS_HISTOGRAM(sTestHistogram, "chip_test_latency_microseconds", "Test histogram");
+
+#if CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+
+using namespace chip::System::Metrics;
+
+void TestCounter(nlTestSuite * inSuite, void * inContext)
+{
+    uint64_t value = sTestCounter.Get();
+
+    SYSTEM_METRICS_INCREMENT(sTestCounter);
+    SYSTEM_METRICS_ADD(sTestCounter, 41);
+    NL_TEST_ASSERT(inSuite, sTestCounter.Get() == value + 42);
+}
+
+void TestGauge(nlTestSuite * inSuite, void * inContext)
+{
+    SYSTEM_METRICS_SET(sTestGauge, 0);
+    SYSTEM_METRICS_INCREMENT(sTestGauge);
+    SYSTEM_METRICS_INCREMENT(sTestGauge);
+    SYSTEM_METRICS_DECREMENT(sTestGauge);
+    NL_TEST_ASSERT(inSuite, sTestGauge.Get() == 1);
+    NL_TEST_ASSERT(inSuite, sTestGauge.GetHighWatermark() >= 2);
+
+    SYSTEM_METRICS_SET(sTestGauge, 100);
+    SYSTEM_METRICS_SET(sTestGauge, 3);
+    NL_TEST_ASSERT(inSuite, sTestGauge.Get() == 3);
+    NL_TEST_ASSERT(inSuite, sTestGauge.GetHighWatermark() >= 100);
+}
+
+void TestHistogramBuckets(nlTestSuite * inSuite, void * inContext)
+{
+    NL_TEST_ASSERT(inSuite, Histogram::GetBucketIndex(0) == 0);
+    NL_TEST_ASSERT(inSuite, Histogram::GetBucketIndex(1) == 0);
+    NL_TEST_ASSERT(inSuite, Histogram::GetBucketIndex(2) == 1);
+    NL_TEST_ASSERT(inSuite, Histogram::GetBucketIndex(3) == 2);
+    NL_TEST_ASSERT(inSuite, Histogram::GetBucketIndex(4) == 2);
+    NL_TEST_ASSERT(inSuite, Histogram::GetBucketIndex(5) == 3);
+    NL_TEST_ASSERT(inSuite, Histogram::GetBucketIndex(UINT64_MAX) == Histogram::kNumBuckets - 1);
+
+    for (size_t i = 0; i < Histogram::kNumBuckets - 1; i++)
+    {
+        NL_TEST_ASSERT(inSuite, Histogram::GetBucketIndex(Histogram::GetBucketUpperBound(i)) == i);
+        NL_TEST_ASSERT(inSuite, Histogram::GetBucketIndex(Histogram::GetBucketUpperBound(i) + 1) == i + 1);
+    }
+    NL_TEST_ASSERT(inSuite, Histogram::GetBucketUpperBound(Histogram::kNumBuckets - 1) == UINT64_MAX);
+}
+
+void TestHistogramRecord(nlTestSuite * inSuite, void * inContext)
+{
+    // Metrics are never unregistered, so they must not live on the stack.
+    SYSTEM_METRICS_HISTOGRAM(histogram, "chip_test_local_histogram", "Test histogram");
+
+    NL_TEST_ASSERT(inSuite, histogram.GetPercentileUpperBound(50) == 0);
+
+    // 90 values in (64, 128] and 10 values in (512, 1024].
+    for (int i = 0; i < 90; i++)
+    {
+        histogram.Record(100);
+    }
+    for (int i = 0; i < 10; i++)
+    {
+        histogram.Record(1000);
+    }
+
+    NL_TEST_ASSERT(inSuite, histogram.GetCount() == 100);
+    NL_TEST_ASSERT(inSuite, histogram.GetSum() == 90 * 100 + 10 * 1000);
+    NL_TEST_ASSERT(inSuite, histogram.GetBucketCount(Histogram::GetBucketIndex(100)) == 90);
+    NL_TEST_ASSERT(inSuite, histogram.GetBucketCount(Histogram::GetBucketIndex(1000)) == 10);
+    NL_TEST_ASSERT(inSuite, histogram.GetPercentileUpperBound(50) == 128);
+    NL_TEST_ASSERT(inSuite, histogram.GetPercentileUpperBound(90) == 128);
+    NL_TEST_ASSERT(inSuite, histogram.GetPercentileUpperBound(91) == 1024);
+    NL_TEST_ASSERT(inSuite, histogram.GetPercentileUpperBound(100) == 1024);
+}
+
+void TestRegistry(nlTestSuite * inSuite, void * inContext)
+{
+    NL_TEST_ASSERT(inSuite, FindMetric("chip_test_events_total") == &sTestCounter);
+    NL_TEST_ASSERT(inSuite, FindMetric("chip_test_objects_in_use") == &sTestGauge);
+    NL_TEST_ASSERT(inSuite, FindMetric("chip_test_latency_microseconds") == &sTestHistogram);
+    NL_TEST_ASSERT(inSuite, FindMetric("chip_test_unknown") == nullptr);
+
+    NL_TEST_ASSERT(inSuite, sTestCounter.GetType() == Metric::Type::kCounter);
+    NL_TEST_ASSERT(inSuite, sTestGauge.GetType() == Metric::Type::kGauge);
+    NL_TEST_ASSERT(inSuite, sTestHistogram.GetType() == Metric::Type::kHistogram);
+}
+
+void AppendText(const char * text, void * context)
+{
+    static_cast<std::string *>(context)->append(text);
+}
+
+bool Contains(const std::string & text, const char * expected)
+{
+    return text.find(expected) != std::string::npos;
+}
+
+void TestPrometheusText(nlTestSuite * inSuite, void * inContext)
+{
+    SYSTEM_METRICS_HISTOGRAM(histogram, "chip_test_prometheus_histogram", "Test histogram");
+    histogram.Record(1);
+    histogram.Record(3);
+    histogram.Record(4);
+
+    std::string text;
+    WritePrometheusText(AppendText, &text);
+
+    NL_TEST_ASSERT(inSuite, Contains(text, "# HELP chip_test_events_total Test counter\n"));
+    NL_TEST_ASSERT(inSuite, Contains(text, "# TYPE chip_test_events_total counter\n"));
+    NL_TEST_ASSERT(inSuite, Contains(text, "# TYPE chip_test_objects_in_use gauge\n"));
+    NL_TEST_ASSERT(inSuite, Contains(text, "# TYPE chip_test_objects_in_use_high_watermark gauge\n"));
+
+    // Buckets are cumulative, and end at the last non-empty one.
+    NL_TEST_ASSERT(inSuite, Contains(text, "# TYPE chip_test_prometheus_histogram histogram\n"));
+    NL_TEST_ASSERT(inSuite,
+                   Contains(text,
+                            "chip_test_prometheus_histogram_bucket{le=\"1\"} 1\n"
+                            "chip_test_prometheus_histogram_bucket{le=\"2\"} 1\n"
+                            "chip_test_prometheus_histogram_bucket{le=\"4\"} 3\n"
+                            "chip_test_prometheus_histogram_bucket{le=\"+Inf\"} 3\n"
+                            "chip_test_prometheus_histogram_sum 8\n"
+                            "chip_test_prometheus_histogram_count 3\n"));
+}
+
+#else // CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+
+void TestMetricsDisabled(nlTestSuite * inSuite, void * inContext)
+{
+    // The macros compile to nothing.
+    SYSTEM_METRICS_INCREMENT(sTestCounter);
+    SYSTEM_METRICS_ADD(sTestCounter, 41);
+    SYSTEM_METRICS_SET(sTestGauge, 1);
+    SYSTEM_METRICS_DECREMENT(sTestGauge);
+    SYSTEM_METRICS_RECORD(sTestHistogram, 100);
+    NL_TEST_ASSERT(inSuite, true);
+}
+
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+
+} // namespace
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+// clang-format off
+static const nlTest sTests[] =
+{
+#if CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+    NL_TEST_DEF("TestCounter", TestCounter),
+    NL_TEST_DEF("TestGauge", TestGauge),
+    NL_TEST_DEF("TestHistogramBuckets", TestHistogramBuckets),
+    NL_TEST_DEF("TestHistogramRecord", TestHistogramRecord),
+    NL_TEST_DEF("TestRegistry", TestRegistry),
+    NL_TEST_DEF("TestPrometheusText", TestPrometheusText),
+#else
+    NL_TEST_DEF("TestMetricsDisabled", TestMetricsDisabled),
+#endif // CHIP_SYSTEM_CONFIG_PROVIDE_METRICS
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestSystemMetrics(void)
+{
+    nlTestSuite theSuite = {
+        "chip-system-metrics", &sTests[0], nullptr /* setup */, nullptr /* teardown */
+    };
+
+    nlTestRunner(&theSuite, nullptr /* context */);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestSystemMetrics)
@@ -0,0 +1,210 @@
+/*
+ *
+ *    Copyright (c) 2022 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This is a unit test suite for the structured trace ring buffers.
+ */
+
+#include <system/SystemConfig.h>
+
+#include <lib/support/CodeUtils.h>
+#include <lib/support/UnitTestRegistration.h>
+#include <nlunit-test.h>
+#include <system/SystemClock.h>
+#include <system/SystemTrace.h>
+
+#include <string.h>
+#include <vector>
+
+#if CHIP_CONFIG_STRUCTURED_TRACE_ENABLED && CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#include <pthread.h>
+#endif
+
+using namespace chip::System;
+
+namespace {
+
+struct DrainedEvent
+{
+    uint32_t mThreadId;
+    Trace::Event mEvent;
+};
+
+void CollectEvent(uint32_t threadId, const Trace::Event & event, void * context)
+{
+    static_cast<std::vector<DrainedEvent> *>(context)->push_back(DrainedEvent{ threadId, event });
+}
+
+std::vector<DrainedEvent> DrainAll()
+{
+    std::vector<DrainedEvent> events;
+    Trace::DrainEvents(CollectEvent, &events);
+    return events;
+}
+
+#if CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+
+void CheckEvent(nlTestSuite * inSuite, const Trace::Event & event, Trace::EventType type, const char * name, int64_t value,
+                uint64_t timestampUs)
+{
+    NL_TEST_ASSERT(inSuite, event.mType == type);
+    NL_TEST_ASSERT(inSuite, strcmp(event.mName, name) == 0);
+    NL_TEST_ASSERT(inSuite, event.mValue == value);
+    NL_TEST_ASSERT(inSuite, event.mTimestampUs == timestampUs);
+}
+
+void TestRecordAndDrain(nlTestSuite * inSuite, void * inContext)
+{
+    Clock::Internal::MockClock clock;
+    Clock::ClockBase * savedRealClock = &SystemClock();
+    Clock::Internal::SetSystemClockForTesting(&clock);
+
+    DrainAll();
+
+    clock.SetMonotonic(Clock::Milliseconds64(1));
+    {
+        CHIP_TRACE_SCOPE(Transport, "Scope");
+        clock.SetMonotonic(Clock::Milliseconds64(2));
+        CHIP_TRACE_COUNTER(InteractionModel, "Counter", 42);
+        CHIP_TRACE_ASYNC_BEGIN(Messaging, "Async", 7);
+        clock.SetMonotonic(Clock::Milliseconds64(3));
+    }
+    CHIP_TRACE_ASYNC_END(Messaging, "Async", 7);
+    CHIP_TRACE_INSTANT(SecureChannel, "Instant");
+
+    std::vector<DrainedEvent> events = DrainAll();
+    NL_TEST_ASSERT(inSuite, events.size() == 6);
+    if (events.size() == 6)
+    {
+        CheckEvent(inSuite, events[0].mEvent, Trace::EventType::kBegin, "Scope", 0, 1000);
+        NL_TEST_ASSERT(inSuite, events[0].mEvent.mCategory == Trace::Category::kTransport);
+        CheckEvent(inSuite, events[1].mEvent, Trace::EventType::kCounter, "Counter", 42, 2000);
+        NL_TEST_ASSERT(inSuite, events[1].mEvent.mCategory == Trace::Category::kInteractionModel);
+        CheckEvent(inSuite, events[2].mEvent, Trace::EventType::kAsyncBegin, "Async", 7, 2000);
+        CheckEvent(inSuite, events[3].mEvent, Trace::EventType::kEnd, "Scope", 0, 3000);
+        CheckEvent(inSuite, events[4].mEvent, Trace::EventType::kAsyncEnd, "Async", 7, 3000);
+        CheckEvent(inSuite, events[5].mEvent, Trace::EventType::kInstant, "Instant", 0, 3000);
+
+        for (const DrainedEvent & event : events)
+        {
+            NL_TEST_ASSERT(inSuite, event.mThreadId == events[0].mThreadId);
+        }
+    }
+
+    // Drained events are not returned again.
+    NL_TEST_ASSERT(inSuite, DrainAll().empty());
+
+    Clock::Internal::SetSystemClockForTesting(savedRealClock);
+}
+
+void TestBufferFull(nlTestSuite * inSuite, void * inContext)
+{
+    DrainAll();
+    uint64_t droppedEventCount = Trace::GetDroppedEventCount();
+
+    for (int i = 0; i < CHIP_CONFIG_STRUCTURED_TRACE_BUFFER_SIZE + 2; i++)
+    {
+        CHIP_TRACE_COUNTER(Messaging, "Counter", i);
+    }
+
+    NL_TEST_ASSERT(inSuite, Trace::GetDroppedEventCount() == droppedEventCount + 2);
+
+    // The oldest events are kept, and the buffer accepts events again once drained.
+    std::vector<DrainedEvent> events = DrainAll();
+    NL_TEST_ASSERT(inSuite, events.size() == CHIP_CONFIG_STRUCTURED_TRACE_BUFFER_SIZE);
+    NL_TEST_ASSERT(inSuite, !events.empty() && events.front().mEvent.mValue == 0);
+    NL_TEST_ASSERT(inSuite, !events.empty() && events.back().mEvent.mValue == CHIP_CONFIG_STRUCTURED_TRACE_BUFFER_SIZE - 1);
+
+    CHIP_TRACE_INSTANT(Messaging, "Instant");
+    NL_TEST_ASSERT(inSuite, DrainAll().size() == 1);
+    NL_TEST_ASSERT(inSuite, Trace::GetDroppedEventCount() == droppedEventCount + 2);
+}
+
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+void * RecordOnThread(void * context)
+{
+    CHIP_TRACE_INSTANT(Messaging, "OtherThread");
+    return nullptr;
+}
+
+void TestPerThreadBuffers(nlTestSuite * inSuite, void * inContext)
+{
+    DrainAll();
+
+    CHIP_TRACE_INSTANT(Messaging, "ThisThread");
+    pthread_t thread;
+    NL_TEST_ASSERT(inSuite, pthread_create(&thread, nullptr, RecordOnThread, nullptr) == 0);
+    NL_TEST_ASSERT(inSuite, pthread_join(thread, nullptr) == 0);
+
+    // Events recorded by a thread that has exited can still be drained.
+    std::vector<DrainedEvent> events = DrainAll();
+    NL_TEST_ASSERT(inSuite, events.size() == 2);
+    if (events.size() == 2)
+    {
+        NL_TEST_ASSERT(inSuite, events[0].mThreadId != events[1].mThreadId);
+    }
+}
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+
+#else // CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+
+void TestTraceDisabled(nlTestSuite * inSuite, void * inContext)
+{
+    CHIP_TRACE_SCOPE(Transport, "Scope");
+    CHIP_TRACE_COUNTER(InteractionModel, "Counter", 42);
+    CHIP_TRACE_INSTANT(SecureChannel, "Instant");
+
+    NL_TEST_ASSERT(inSuite, DrainAll().empty());
+    NL_TEST_ASSERT(inSuite, Trace::GetDroppedEventCount() == 0);
+}
+
+#endif // CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+
+} // namespace
+
+/**
+ *   Test Suite. It lists all the test functions.
+ */
+// clang-format off
+static const nlTest sTests[] =
+{
+#if CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+    NL_TEST_DEF("TestRecordAndDrain", TestRecordAndDrain),
+    NL_TEST_DEF("TestBufferFull", TestBufferFull),
+#if CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+    NL_TEST_DEF("TestPerThreadBuffers", TestPerThreadBuffers),
+#endif // CHIP_SYSTEM_CONFIG_POSIX_LOCKING
+#else
+    NL_TEST_DEF("TestTraceDisabled", TestTraceDisabled),
+#endif // CHIP_CONFIG_STRUCTURED_TRACE_ENABLED
+    NL_TEST_SENTINEL()
+};
+// clang-format on
+
+int TestSystemTrace(void)
+{
+    nlTestSuite theSuite = {
+        "chip-system-trace", &sTests[0], nullptr /* setup */, nullptr /* teardown */
+    };
+
+    nlTestRunner(&theSuite, nullptr /* context */);
+
+    return (nlTestRunnerStats(&theSuite));
+}
+
+CHIP_REGISTER_TEST_SUITE(TestSystemTrace)
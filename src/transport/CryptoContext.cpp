@@ -117,6 +117,20 @@ CHIP_ERROR CryptoContext::InitFromSecret(const ByteSpan & secret, const ByteSpan
     return CHIP_NO_ERROR;
 }
 
+CHIP_ERROR CryptoContext::InitFromGroupKey(const ByteSpan & operationalKey)
+{
+    VerifyOrReturnError(mKeyAvailable == false, CHIP_ERROR_INCORRECT_STATE);
+    VerifyOrReturnError(operationalKey.size() == sizeof(CryptoKey), CHIP_ERROR_INVALID_ARGUMENT);
+
+    memcpy(mKeys[kI2RKey], operationalKey.data(), sizeof(CryptoKey));
+    memcpy(mKeys[kR2IKey], operationalKey.data(), sizeof(CryptoKey));
+
+    mKeyAvailable = true;
+    mSessionRole  = SessionRole::kInitiator;
+
+    return CHIP_NO_ERROR;
+}
+
 CHIP_ERROR CryptoContext::InitFromKeyPair(const Crypto::P256Keypair & local_keypair,
                                           const Crypto::P256PublicKey & remote_public_key, const ByteSpan & salt,
                                           SessionInfoType infoType, SessionRole role)
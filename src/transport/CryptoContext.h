@@ -85,6 +85,16 @@ public:
      */
     CHIP_ERROR InitFromSecret(const ByteSpan & secret, const ByteSpan & salt, SessionInfoType infoType, SessionRole role);
 
+    /**
+     * @brief
+     *   Use an operational group key for encrypting/decrypting group messages.
+     *   Group messages use the same key in both directions.
+     *
+     * @param operationalKey     The operational group key
+     * @return CHIP_ERROR        CHIP_ERROR_INVALID_ARGUMENT if the key has the wrong size
+     */
+    CHIP_ERROR InitFromGroupKey(const ByteSpan & operationalKey);
+
     /**
      * @brief
      *   Encrypt the input data using keys established in the secure channel
@@ -0,0 +1,142 @@
+/*
+ *    Copyright (c) 2021 Project CHIP Authors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+/**
+ *    @file
+ *      This file defines the message counters of the remote nodes sending group messages.
+ *
+ */
+#pragma once
+
+#include <lib/core/CHIPConfig.h>
+#include <lib/core/CHIPError.h>
+#include <lib/core/DataModelTypes.h>
+#include <lib/core/NodeId.h>
+#include <transport/PeerMessageCounter.h>
+
+namespace chip {
+namespace Transport {
+
+/**
+ * @brief
+ *   Tracks the message counters of group message senders, separately for data and
+ *   control messages since they use distinct counters on the sender side.
+ *
+ *   Group senders can't be synchronized ahead of time, so the first message from an
+ *   unknown sender is trusted. Entries are rotated using LRU: when a table is full,
+ *   the sender heard least recently is forgotten.
+ */
+class GroupPeerTable
+{
+public:
+    /**
+     * Verify that @a counter is acceptable for the given sender, using the trust-first
+     * policy of PeerMessageCounter::VerifyOrTrustFirst. An unknown sender is added to
+     * the table.
+     *
+     * @return CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED if the message was already received.
+     */
+    CHIP_ERROR VerifyOrTrustFirst(FabricIndex fabricIndex, NodeId nodeId, bool isControl, uint32_t counter)
+    {
+        return FindOrAdd(fabricIndex, nodeId, isControl)->mCounter.VerifyOrTrustFirst(counter);
+    }
+
+    /**
+     * Record @a counter as received once the message has been authenticated.
+     *
+     * @pre VerifyOrTrustFirst(fabricIndex, nodeId, isControl, counter) == CHIP_NO_ERROR
+     */
+    void Commit(FabricIndex fabricIndex, NodeId nodeId, bool isControl, uint32_t counter)
+    {
+        FindOrAdd(fabricIndex, nodeId, isControl)->mCounter.Commit(counter);
+    }
+
+    /**
+     * Forget all the senders of the given fabric.
+     */
+    void RemoveFabric(FabricIndex fabricIndex)
+    {
+        Remove(mDataSenders, fabricIndex);
+        Remove(mControlSenders, fabricIndex);
+    }
+
+private:
+    struct GroupSender
+    {
+        FabricIndex mFabricIndex = kUndefinedFabricIndex;
+        NodeId mNodeId           = kUndefinedNodeId;
+        uint32_t mLastUsed       = 0;
+        PeerMessageCounter mCounter;
+    };
+
+    GroupSender * FindOrAdd(FabricIndex fabricIndex, NodeId nodeId, bool isControl)
+    {
+        return isControl ? FindOrAdd(mControlSenders, fabricIndex, nodeId) : FindOrAdd(mDataSenders, fabricIndex, nodeId);
+    }
+
+    template <size_t N>
+    GroupSender * FindOrAdd(GroupSender (&senders)[N], FabricIndex fabricIndex, NodeId nodeId)
+    {
+        GroupSender * oldest = &senders[0];
+        GroupSender * free   = nullptr;
+        for (GroupSender & sender : senders)
+        {
+            if (sender.mFabricIndex == fabricIndex && sender.mNodeId == nodeId)
+            {
+                sender.mLastUsed = ++mUseCount;
+                return &sender;
+            }
+            if (sender.mFabricIndex == kUndefinedFabricIndex)
+            {
+                free = (free == nullptr) ? &sender : free;
+            }
+            else if (sender.mLastUsed < oldest->mLastUsed)
+            {
+                oldest = &sender;
+            }
+        }
+
+        // Free entries are always picked before evicting a used one
+        oldest = (free != nullptr) ? free : oldest;
+        oldest->mFabricIndex = fabricIndex;
+        oldest->mNodeId      = nodeId;
+        oldest->mLastUsed    = ++mUseCount;
+        oldest->mCounter.Reset();
+        return oldest;
+    }
+
+    template <size_t N>
+    static void Remove(GroupSender (&senders)[N], FabricIndex fabricIndex)
+    {
+        for (GroupSender & sender : senders)
+        {
+            if (sender.mFabricIndex == fabricIndex)
+            {
+                sender.mFabricIndex = kUndefinedFabricIndex;
+                sender.mNodeId      = kUndefinedNodeId;
+                sender.mLastUsed    = 0;
+                sender.mCounter.Reset();
+            }
+        }
+    }
+
+    GroupSender mDataSenders[CHIP_CONFIG_MAX_GROUP_DATA_PEERS];
+    GroupSender mControlSenders[CHIP_CONFIG_MAX_GROUP_CONTROL_PEERS];
+    uint32_t mUseCount = 0;
+};
+
+} // namespace Transport
+} // namespace chip
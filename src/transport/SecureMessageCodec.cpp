@@ -27,6 +27,7 @@
 
 #include <lib/support/CodeUtils.h>
 #include <lib/support/SafeInt.h>
+#include <system/SystemTrace.h>
 #include <transport/SecureMessageCodec.h>
 
 #include "transport/TraceMessage.h"
@@ -41,6 +42,21 @@ namespace SecureMessageCodec {
 CHIP_ERROR Encrypt(Transport::SecureSession * state, PayloadHeader & payloadHeader, PacketHeader & packetHeader,
                    System::PacketBufferHandle & msgBuf, MessageCounter & counter)
 {
+    VerifyOrReturnError(state != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+
+    packetHeader.SetSessionId(state->GetPeerSessionId());
+
+    // TODO set Session Type (Unicast or Group)
+    // packetHeader.SetSessionType(Header::SessionType::kUnicastSession);
+
+    return Encrypt(state->GetCryptoContext(), payloadHeader, packetHeader, msgBuf, counter);
+}
+
+CHIP_ERROR Encrypt(const CryptoContext & context, PayloadHeader & payloadHeader, PacketHeader & packetHeader,
+                   System::PacketBufferHandle & msgBuf, MessageCounter & counter)
+{
+    CHIP_TRACE_SCOPE(Transport, "Encrypt");
+
     VerifyOrReturnError(!msgBuf.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
     VerifyOrReturnError(!msgBuf->HasChainedBuffer(), CHIP_ERROR_INVALID_MESSAGE_LENGTH);
     VerifyOrReturnError(msgBuf->TotalLength() <= kMaxAppMessageLen, CHIP_ERROR_MESSAGE_TOO_LONG);
@@ -50,12 +66,7 @@ CHIP_ERROR Encrypt(Transport::SecureSession * state, PayloadHeader & payloadHead
     static_assert(std::is_same<decltype(msgBuf->TotalLength()), uint16_t>::value,
                   "Addition to generate payloadLength might overflow");
 
-    packetHeader
-        .SetMessageCounter(messageCounter) //
-        .SetSessionId(state->GetPeerSessionId());
-
-    // TODO set Session Type (Unicast or Group)
-    // packetHeader.SetSessionType(Header::SessionType::kUnicastSession);
+    packetHeader.SetMessageCounter(messageCounter);
 
     ReturnErrorOnFailure(payloadHeader.EncodeBeforeData(msgBuf));
 
@@ -65,7 +76,7 @@ CHIP_ERROR Encrypt(Transport::SecureSession * state, PayloadHeader & payloadHead
     CHIP_TRACE_MESSAGE(payloadHeader, packetHeader, data, totalLen);
 
     MessageAuthenticationCode mac;
-    ReturnErrorOnFailure(state->EncryptBeforeSend(data, totalLen, data, packetHeader, mac));
+    ReturnErrorOnFailure(context.Encrypt(data, totalLen, data, packetHeader, mac));
 
     uint16_t taglen = 0;
     ReturnErrorOnFailure(mac.Encode(packetHeader, &data[totalLen], msgBuf->AvailableDataLength(), &taglen));
@@ -80,6 +91,15 @@ CHIP_ERROR Encrypt(Transport::SecureSession * state, PayloadHeader & payloadHead
 CHIP_ERROR Decrypt(Transport::SecureSession * state, PayloadHeader & payloadHeader, const PacketHeader & packetHeader,
                    System::PacketBufferHandle & msg)
 {
+    VerifyOrReturnError(state != nullptr, CHIP_ERROR_INVALID_ARGUMENT);
+    return Decrypt(state->GetCryptoContext(), payloadHeader, packetHeader, msg);
+}
+
+CHIP_ERROR Decrypt(const CryptoContext & context, PayloadHeader & payloadHeader, const PacketHeader & packetHeader,
+                   System::PacketBufferHandle & msg)
+{
+    CHIP_TRACE_SCOPE(Transport, "Decrypt");
+
     ReturnErrorCodeIf(msg.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
 
     uint8_t * data = msg->Start();
@@ -107,7 +127,7 @@ CHIP_ERROR Decrypt(Transport::SecureSession * state, PayloadHeader & payloadHead
     msg->SetDataLength(len);
 
     uint8_t * plainText = msg->Start();
-    ReturnErrorOnFailure(state->DecryptOnReceive(data, len, plainText, packetHeader, mac));
+    ReturnErrorOnFailure(context.Decrypt(data, len, plainText, packetHeader, mac));
 
     ReturnErrorOnFailure(payloadHeader.DecodeAndConsume(msg));
     return CHIP_NO_ERROR;
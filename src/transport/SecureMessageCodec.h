@@ -68,6 +68,45 @@ CHIP_ERROR Encrypt(Transport::SecureSession * state, PayloadHeader & payloadHead
  */
 CHIP_ERROR Decrypt(Transport::SecureSession * state, PayloadHeader & payloadHeader, const PacketHeader & packetHeader,
                    System::PacketBufferHandle & msgBuf);
+
+/**
+ * @brief
+ *  Attach payload header to the message and encrypt the message buffer using
+ *  the given crypto context. The session id of the packet header is left as set
+ *  by the caller; this is used for group messages, which are not tied to a
+ *  secure session.
+ *
+ * @param context       The crypto context holding the encryption key
+ * @param payloadHeader Reference to the payload header that should be inserted in
+ *                      the message
+ * @param packetHeader  Reference to the packet header that contains unencrypted
+ *                      portion of the message header
+ * @param msgBuf        The message buffer that contains the unencrypted message. If
+ *                      the operation is successuful, this buffer will contain the
+ *                      encrypted message.
+ * @param counter       The local counter object to be used
+ * @ return CHIP_ERROR  The result of the encode operation
+ */
+CHIP_ERROR Encrypt(const CryptoContext & context, PayloadHeader & payloadHeader, PacketHeader & packetHeader,
+                   System::PacketBufferHandle & msgBuf, MessageCounter & counter);
+
+/**
+ * @brief
+ *  Decrypt the message with the given crypto context, perform message integrity
+ *  check, and decode the payload header.
+ *
+ * @param context       The crypto context holding the decryption key
+ * @param payloadHeader Reference to the payload header that should be inserted in
+ *                      the message
+ * @param packetHeader  Reference to the packet header that contains unencrypted
+ *                      portion of the message header
+ * @param msgBuf        The message buffer that contains the encrypted message. If
+ *                      the operation is successuful, this buffer will contain the
+ *                      unencrypted message.
+ * @ return CHIP_ERROR  The result of the decode operation
+ */
+CHIP_ERROR Decrypt(const CryptoContext & context, PayloadHeader & payloadHeader, const PacketHeader & packetHeader,
+                   System::PacketBufferHandle & msgBuf);
 } // namespace SecureMessageCodec
 
 } // namespace chip
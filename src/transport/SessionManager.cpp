@@ -37,6 +37,8 @@
 #include <lib/support/logging/CHIPLogging.h>
 #include <platform/CHIPDeviceLayer.h>
 #include <protocols/secure_channel/Constants.h>
+#include <system/SystemMetrics.h>
+#include <system/SystemTrace.h>
 #include <transport/PairingSession.h>
 #include <transport/SecureMessageCodec.h>
 #include <transport/TransportMgr.h>
@@ -49,6 +51,11 @@ using System::PacketBufferHandle;
 using Transport::PeerAddress;
 using Transport::SecureSession;
 
+SYSTEM_METRICS_COUNTER(sDecryptFailures, "chip_session_decrypt_failures_total",
+                       "Number of secure messages that could not be decrypted or authenticated");
+SYSTEM_METRICS_COUNTER(sDuplicateMessages, "chip_session_duplicate_messages_total",
+                       "Number of secure messages received with an already seen message counter");
+
 uint32_t EncryptedPacketBufferHandle::GetMessageCounter() const
 {
     PacketHeader header;
@@ -100,6 +107,16 @@ void SessionManager::Shutdown()
 
     mMessageCounterManager = nullptr;
 
+#if INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE > 1
+    for (size_t i = 0; i < mPendingSendCount; i++)
+    {
+        mPendingSendMessages[i] = nullptr;
+    }
+    mPendingSendCount = 0;
+    mPendingSendError = CHIP_NO_ERROR;
+#endif // INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE > 1
+    mSendBatchDepth = 0;
+
     mState        = State::kNotReady;
     mSystemLayer  = nullptr;
     mTransportMgr = nullptr;
@@ -123,9 +140,17 @@ CHIP_ERROR SessionManager::PrepareMessage(const SessionHandle & sessionHandle, P
     {
         if (sessionHandle.IsGroupSession())
         {
-            // TODO : #11911
-            // For now, just set the packetHeader with the correct data.
+            Credentials::GroupDataProvider * groups = Credentials::GetGroupDataProvider();
+            VerifyOrReturnError(nullptr != groups, CHIP_ERROR_INTERNAL);
+
+            // The current operational key of the group also gives the session id to send with
+            Credentials::GroupDataProvider::GroupSession groupSession;
+            ReturnErrorOnFailure(
+                groups->GetGroupSession(sessionHandle.GetFabricIndex(), sessionHandle.GetGroupId().Value(), groupSession));
+
             packetHeader.SetDestinationGroupId(sessionHandle.GetGroupId());
+            packetHeader.SetSessionId(groupSession.session_id);
+            // TODO: the privacy flag is required for group messages, but privacy obfuscation is not applied yet
             packetHeader.SetFlags(Header::SecFlagValues::kPrivacyFlag);
             packetHeader.SetSessionType(Header::SessionType::kGroupSession);
             // TODO : Replace the PeerNodeId with Our nodeId
@@ -135,8 +160,13 @@ CHIP_ERROR SessionManager::PrepareMessage(const SessionHandle & sessionHandle, P
             {
                 return CHIP_ERROR_INTERNAL;
             }
-            // TODO #11911 Update SecureMessageCodec::Encrypt for Group
-            ReturnErrorOnFailure(payloadHeader.EncodeBeforeData(message));
+
+            CryptoContext context;
+            CHIP_ERROR err = context.InitFromGroupKey(ByteSpan(groupSession.key));
+            Crypto::ClearSecretData(groupSession.key, sizeof(groupSession.key));
+            ReturnErrorOnFailure(err);
+            ReturnErrorOnFailure(
+                SecureMessageCodec::Encrypt(context, payloadHeader, packetHeader, message, mGlobalEncryptedMessageCounter));
 
 #if CHIP_PROGRESS_LOGGING
             destination = sessionHandle.GetPeerNodeId();
@@ -196,14 +226,14 @@ CHIP_ERROR SessionManager::SendPreparedMessage(const SessionHandle & sessionHand
     VerifyOrReturnError(!preparedMessage.IsNull(), CHIP_ERROR_INVALID_ARGUMENT);
 
     const Transport::PeerAddress * destination;
+    Transport::PeerAddress multicastAddress;
 
     if (sessionHandle.IsSecure())
     {
         if (sessionHandle.IsGroupSession())
         {
-            chip::Transport::PeerAddress multicastAddress =
-                Transport::PeerAddress::Multicast(sessionHandle.GetFabricIndex(), sessionHandle.GetGroupId().Value());
-            destination = static_cast<Transport::PeerAddress *>(&multicastAddress);
+            multicastAddress = Transport::PeerAddress::Multicast(sessionHandle.GetFabricIndex(), sessionHandle.GetGroupId().Value());
+            destination      = &multicastAddress;
             char addressStr[Transport::PeerAddress::kMaxToStringSize];
             multicastAddress.ToString(addressStr, Transport::PeerAddress::kMaxToStringSize);
 
@@ -257,6 +287,13 @@ CHIP_ERROR SessionManager::SendPreparedMessage(const SessionHandle & sessionHand
 
     if (mTransportMgr != nullptr)
     {
+#if INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE > 1
+        if (mSendBatchDepth > 0 && destination->GetTransportType() == Transport::Type::kUdp)
+        {
+            QueuePreparedMessage(*destination, std::move(msgBuf));
+            return CHIP_NO_ERROR;
+        }
+#endif // INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE > 1
         return mTransportMgr->SendMessage(*destination, std::move(msgBuf));
     }
     else
@@ -266,6 +303,100 @@ CHIP_ERROR SessionManager::SendPreparedMessage(const SessionHandle & sessionHand
     }
 }
 
+CHIP_ERROR SessionManager::EndSendBatch()
+{
+    VerifyOrDie(mSendBatchDepth > 0);
+    VerifyOrReturnError(--mSendBatchDepth == 0, CHIP_NO_ERROR);
+
+    CHIP_ERROR err = FlushPendingSends();
+#if INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE > 1
+    if (mPendingSendError != CHIP_NO_ERROR)
+    {
+        err               = mPendingSendError;
+        mPendingSendError = CHIP_NO_ERROR;
+    }
+#endif // INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE > 1
+    return err;
+}
+
+#if INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE > 1
+void SessionManager::QueuePreparedMessage(const Transport::PeerAddress & destination, System::PacketBufferHandle && msgBuf)
+{
+    if (mPendingSendCount == kMessageBatchSize)
+    {
+        CHIP_ERROR err = FlushPendingSends();
+        if (mPendingSendError == CHIP_NO_ERROR)
+        {
+            mPendingSendError = err;
+        }
+    }
+
+    mPendingSendAddresses[mPendingSendCount] = destination;
+    mPendingSendMessages[mPendingSendCount]  = std::move(msgBuf);
+    mPendingSendCount++;
+}
+#endif // INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE > 1
+
+CHIP_ERROR SessionManager::FlushPendingSends()
+{
+    CHIP_ERROR firstError = CHIP_NO_ERROR;
+
+#if INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE > 1
+    VerifyOrReturnError(mPendingSendCount > 0, CHIP_NO_ERROR);
+
+    // Move the queue aside first: a transport that delivers synchronously may cause new messages to be
+    // queued while this batch is still being sent.
+    Transport::PeerAddress addresses[kMessageBatchSize];
+    System::PacketBufferHandle messages[kMessageBatchSize];
+    // Extra references to the messages, which the transport consumes, to tell their senders which ones failed.
+    System::PacketBufferHandle sent[kMessageBatchSize];
+    CHIP_ERROR errors[kMessageBatchSize];
+    const size_t count = mPendingSendCount;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        addresses[i] = mPendingSendAddresses[i];
+        messages[i]  = std::move(mPendingSendMessages[i]);
+        sent[i]      = messages[i].Retain();
+        errors[i]    = CHIP_NO_ERROR;
+    }
+    mPendingSendCount = 0;
+
+    if (mTransportMgr == nullptr)
+    {
+        ChipLogError(Inet, "The transport manager is not initialized. Dropping %u batched messages", static_cast<unsigned>(count));
+        for (size_t i = 0; i < count; i++)
+        {
+            errors[i] = CHIP_ERROR_INCORRECT_STATE;
+        }
+    }
+    else
+    {
+        mTransportMgr->SendMessages(addresses, messages, count, errors);
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (errors[i] != CHIP_NO_ERROR)
+        {
+            char addrBuffer[Transport::PeerAddress::kMaxToStringSize];
+            addresses[i].ToString(addrBuffer);
+            ChipLogError(Inet, "Failed to send batched message to %s: %" CHIP_ERROR_FORMAT, addrBuffer, errors[i].Format());
+            if (mSendBatchErrorDelegate != nullptr)
+            {
+                mSendBatchErrorDelegate->OnBatchedSendFailed(sent[i], errors[i]);
+            }
+            if (firstError == CHIP_NO_ERROR)
+            {
+                firstError = errors[i];
+            }
+        }
+    }
+#endif // INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE > 1
+
+    return firstError;
+}
+
 void SessionManager::ExpirePairing(const SessionHandle & sessionHandle)
 {
     SecureSession * session = GetSecureSession(sessionHandle);
@@ -291,6 +422,7 @@ void SessionManager::ExpireAllPairings(NodeId peerNodeId, FabricIndex fabric)
 void SessionManager::ExpireAllPairingsForFabric(FabricIndex fabric)
 {
     ChipLogDetail(Inet, "Expiring all connections for fabric %d!!", fabric);
+    mGroupPeerMsgCounter.RemoveFabric(fabric);
     mSecureSessions.ForEachSession([&](auto session) {
         if (session->GetFabricIndex() == fabric)
         {
@@ -384,6 +516,22 @@ void SessionManager::OnMessageReceived(const PeerAddress & peerAddress, System::
     }
 }
 
+void SessionManager::OnMessageBatchReceived(const PeerAddress * peerAddresses, System::PacketBufferHandle * msgs, size_t count)
+{
+    // Replies generated while dispatching the batch leave together once it has been processed.
+    ScopedSendBatch sendBatch(this);
+
+    // Each message is resolved against the session table only once the messages before it have been dispatched: an
+    // earlier message may establish, release or replace the session a later one is addressed to.
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!msgs[i].IsNull())
+        {
+            OnMessageReceived(peerAddresses[i], std::move(msgs[i]));
+        }
+    }
+}
+
 void SessionManager::RegisterRecoveryDelegate(SessionRecoveryDelegate & cb)
 {
 #ifndef NDEBUG
@@ -465,7 +613,11 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & packetHea
 {
     CHIP_ERROR err = CHIP_NO_ERROR;
 
-    SecureSession * session = mSecureSessions.FindSecureSessionByLocalKey(packetHeader.GetSessionId());
+    SecureSession * session = nullptr;
+    {
+        CHIP_TRACE_SCOPE(Transport, "SessionLookup");
+        session = mSecureSessions.FindSecureSessionByLocalKey(packetHeader.GetSessionId());
+    }
 
     PayloadHeader payloadHeader;
 
@@ -486,6 +638,7 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & packetHea
     // Decrypt and verify the message before message counter verification or any further processing.
     if (SecureMessageCodec::Decrypt(session, payloadHeader, packetHeader, msg) != CHIP_NO_ERROR)
     {
+        SYSTEM_METRICS_INCREMENT(sDecryptFailures);
         ChipLogError(Inet, "Secure transport received message, but failed to decode/authenticate it, discarding");
         return;
     }
@@ -493,6 +646,7 @@ void SessionManager::SecureUnicastMessageDispatch(const PacketHeader & packetHea
     err = session->GetSessionMessageCounter().GetPeerMessageCounter().Verify(packetHeader.GetMessageCounter());
     if (err == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED)
     {
+        SYSTEM_METRICS_INCREMENT(sDuplicateMessages);
         isDuplicate = SessionMessageDelegate::DuplicateMessage::Yes;
         err         = CHIP_NO_ERROR;
     }
@@ -541,8 +695,8 @@ void SessionManager::SecureGroupMessageDispatch(const PacketHeader & packetHeade
 {
     PayloadHeader payloadHeader;
     SessionMessageDelegate::DuplicateMessage isDuplicate = SessionMessageDelegate::DuplicateMessage::No;
-    FabricIndex fabricIndex = 0; // TODO : remove initialization once GroupDataProvider->Decrypt is implemented
-    // Credentials::GroupDataProvider * groups = Credentials::GetGroupDataProvider();
+    FabricIndex fabricIndex                              = kUndefinedFabricIndex;
+    Credentials::GroupDataProvider * groups              = Credentials::GetGroupDataProvider();
 
     if (msg.IsNull())
     {
@@ -557,12 +711,63 @@ void SessionManager::SecureGroupMessageDispatch(const PacketHeader & packetHeade
         return;
     }
 
-    // Trial decryption with GroupDataProvider. TODO: Implement the GroupDataProvider Class
-    // TODO retrieve also the fabricIndex with the GroupDataProvider.
-    // VerifyOrExit(CHIP_NO_ERROR == groups->DecryptMessage(packetHeader, payloadHeader, msg),
-    //     ChipLogError(Inet, "Secure transport received group message, but failed to decode it, discarding"));
+    if (!packetHeader.GetSourceNodeId().HasValue() || nullptr == groups)
+    {
+        return;
+    }
 
-    ReturnOnFailure(payloadHeader.DecodeAndConsume(msg));
+    // Trial decryption: several operational keys may hash to the session id of the message, all those
+    // mapped to the destination group are candidates. The buffer is decrypted in place, so every
+    // attempt but the last one works on a copy.
+    {
+        Credentials::GroupDataProvider::GroupSessionIterator * it = groups->IterateGroupSessions(packetHeader.GetSessionId());
+        if (nullptr == it)
+        {
+            ChipLogError(Inet, "Failed to look up group keys, discarding");
+            return;
+        }
+
+        GroupId destinationGroup = packetHeader.GetDestinationGroupId().ValueOr(kUndefinedGroupId);
+        size_t remaining         = it->Count();
+        bool decrypted           = false;
+        Credentials::GroupDataProvider::GroupSession groupSession;
+
+        while (!decrypted && it->Next(groupSession))
+        {
+            remaining--;
+            if (packetHeader.IsValidGroupMsg() && groupSession.group_id != destinationGroup)
+            {
+                continue;
+            }
+
+            CryptoContext context;
+            if (CHIP_NO_ERROR != context.InitFromGroupKey(ByteSpan(groupSession.key)))
+            {
+                continue;
+            }
+
+            System::PacketBufferHandle attempt = (remaining > 0) ? msg.CloneData() : std::move(msg);
+            if (attempt.IsNull())
+            {
+                continue;
+            }
+            if (CHIP_NO_ERROR == SecureMessageCodec::Decrypt(context, payloadHeader, packetHeader, attempt))
+            {
+                decrypted   = true;
+                fabricIndex = groupSession.fabric_index;
+                msg         = std::move(attempt);
+            }
+        }
+        Crypto::ClearSecretData(groupSession.key, sizeof(groupSession.key));
+        it->Release();
+
+        if (!decrypted)
+        {
+            SYSTEM_METRICS_INCREMENT(sDecryptFailures);
+            ChipLogError(Inet, "Secure transport received group message, but failed to decode it, discarding");
+            return;
+        }
+    }
 
     // MCSP check
     if (packetHeader.IsValidMCSPMsg())
@@ -583,8 +788,21 @@ void SessionManager::SecureGroupMessageDispatch(const PacketHeader & packetHeade
         return;
     }
 
-    // TODO: Handle Group message counter here spec 4.7.3
-    // spec 4.5.1.2 for msg counter
+    // Group message counters are tracked per sender, see spec 4.5.1.2
+    NodeId sourceNodeId = packetHeader.GetSourceNodeId().Value();
+    bool isControl      = packetHeader.IsSecureSessionControlMsg();
+    CHIP_ERROR err =
+        mGroupPeerMsgCounter.VerifyOrTrustFirst(fabricIndex, sourceNodeId, isControl, packetHeader.GetMessageCounter());
+    if (err == CHIP_ERROR_DUPLICATE_MESSAGE_RECEIVED)
+    {
+        SYSTEM_METRICS_INCREMENT(sDuplicateMessages);
+        isDuplicate = SessionMessageDelegate::DuplicateMessage::Yes;
+    }
+    else if (err != CHIP_NO_ERROR)
+    {
+        ChipLogError(Inet, "Message counter verify failed, err = %" CHIP_ERROR_FORMAT, err.Format());
+        return;
+    }
 
     if (isDuplicate == SessionMessageDelegate::DuplicateMessage::Yes)
     {
@@ -597,7 +815,7 @@ void SessionManager::SecureGroupMessageDispatch(const PacketHeader & packetHeade
         return;
     }
 
-    // TODO: Commit Group Message Counter
+    mGroupPeerMsgCounter.Commit(fabricIndex, sourceNodeId, isControl, packetHeader.GetMessageCounter());
 
     if (mCB != nullptr)
     {
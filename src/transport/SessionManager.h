@@ -28,12 +28,14 @@
 #include <utility>
 
 #include <inet/IPAddress.h>
+#include <inet/InetConfig.h>
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/DLLUtil.h>
 #include <messaging/ReliableMessageProtocolConfig.h>
 #include <protocols/secure_channel/Constants.h>
 #include <transport/CryptoContext.h>
+#include <transport/GroupPeerMessageCounter.h>
 #include <transport/MessageCounterManagerInterface.h>
 #include <transport/SecureSessionTable.h>
 #include <transport/SessionDelegate.h>
@@ -72,6 +74,12 @@ public:
 
     uint32_t GetMessageCounter() const;
 
+    /// Whether this handle and the given one hold the same buffer, see SendBatchErrorDelegate.
+    bool HoldsBuffer(const System::PacketBufferHandle & buffer) const
+    {
+        return !IsNull() && !buffer.IsNull() && (*this)->Start() == buffer->Start();
+    }
+
     /**
      * Creates a copy of the data in this packet.
      *
@@ -117,6 +125,23 @@ private:
     EncryptedPacketBufferHandle(PacketBufferHandle && aBuffer) : PacketBufferHandle(std::move(aBuffer)) {}
 };
 
+/**
+ * Told about the messages SendPreparedMessage queued in a send batch (see SessionManager::BeginSendBatch) that
+ * could not be sent once the batch was flushed, so that their sender handles the failure as if SendPreparedMessage
+ * had returned it.
+ */
+class DLL_EXPORT SendBatchErrorDelegate
+{
+public:
+    virtual ~SendBatchErrorDelegate() {}
+
+    /**
+     * @param message  The message that was not sent, to be matched with EncryptedPacketBufferHandle::HoldsBuffer.
+     * @param error    The error reported by the transport.
+     */
+    virtual void OnBatchedSendFailed(const System::PacketBufferHandle & message, CHIP_ERROR error) = 0;
+};
+
 class DLL_EXPORT SessionManager : public TransportMgrDelegate
 {
 public:
@@ -143,6 +168,33 @@ public:
      */
     CHIP_ERROR SendPreparedMessage(const SessionHandle & session, const EncryptedPacketBufferHandle & preparedMessage);
 
+    /**
+     * @brief
+     *   Start deferring UDP sends issued through SendPreparedMessage.
+     *
+     * @details
+     *   Until the matching EndSendBatch, prepared messages bound for UDP peers are queued and handed to the
+     *   transport together, so that a burst of messages (report fan-out, MRP retransmissions, replies to a
+     *   batch of received datagrams) leaves with as few system calls as possible.  SendPreparedMessage
+     *   succeeds once a message is queued; a queued message that then fails to send is reported to the
+     *   SendBatchErrorDelegate, and the first such error is returned by the outermost EndSendBatch.
+     *   Calls may nest.
+     */
+    void BeginSendBatch() { mSendBatchDepth++; }
+
+    /**
+     * @brief
+     *   Close a batch opened by BeginSendBatch; the outermost call flushes any queued messages.
+     *
+     * @return The first error reported by the transport for a message sent as part of the batch, or
+     *         CHIP_NO_ERROR if all of them were sent (or the batch is still open).
+     */
+    CHIP_ERROR EndSendBatch();
+
+    /// Set the delegate told about the batched messages that failed to send. There can be only one (the
+    /// ReliableMessageMgr).
+    void SetSendBatchErrorDelegate(SendBatchErrorDelegate * delegate) { mSendBatchErrorDelegate = delegate; }
+
     Transport::SecureSession * GetSecureSession(const SessionHandle & session);
 
     /// @brief Set the delegate for handling incoming messages. There can be only one message delegate (probably the
@@ -229,6 +281,17 @@ public:
      */
     void OnMessageReceived(const Transport::PeerAddress & source, System::PacketBufferHandle && msgBuf) override;
 
+    /**
+     * @brief
+     *   Handle a batch of received messages. Implements TransportMgrDelegate
+     *
+     * @details
+     *   Messages are processed one after the other, in arrival order, exactly as OnMessageReceived would,
+     *   and replies generated while dispatching them are sent as one batch.
+     */
+    void OnMessageBatchReceived(const Transport::PeerAddress * sources, System::PacketBufferHandle * msgBufs,
+                                size_t count) override;
+
     Optional<SessionHandle> CreateUnauthenticatedSession(const Transport::PeerAddress & peerAddress,
                                                          const ReliableMessageProtocolConfig & config)
     {
@@ -284,6 +347,22 @@ private:
 
     GlobalUnencryptedMessageCounter mGlobalUnencryptedMessageCounter;
     GlobalEncryptedMessageCounter mGlobalEncryptedMessageCounter;
+    Transport::GroupPeerTable mGroupPeerMsgCounter;
+
+    static constexpr size_t kMessageBatchSize = INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE;
+
+    uint16_t mSendBatchDepth                         = 0;
+    SendBatchErrorDelegate * mSendBatchErrorDelegate = nullptr;
+#if INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE > 1
+    Transport::PeerAddress mPendingSendAddresses[kMessageBatchSize];
+    System::PacketBufferHandle mPendingSendMessages[kMessageBatchSize];
+    size_t mPendingSendCount = 0;
+    // First error from a flush forced by a full queue, returned by the outermost EndSendBatch.
+    CHIP_ERROR mPendingSendError = CHIP_NO_ERROR;
+
+    void QueuePreparedMessage(const Transport::PeerAddress & destination, System::PacketBufferHandle && msgBuf);
+#endif // INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE > 1
+    CHIP_ERROR FlushPendingSends();
 
     /** Schedules a new oneshot timer for checking connection expiry. */
     void ScheduleExpiryTimer();
@@ -331,6 +410,41 @@ private:
     }
 };
 
+/**
+ * Holds a SessionManager send batch open for the lifetime of the object; see SessionManager::BeginSendBatch.
+ *
+ * The senders of the messages that fail to send are told through the SendBatchErrorDelegate, so the destructor
+ * may drop the error End() would return.
+ */
+class ScopedSendBatch
+{
+public:
+    explicit ScopedSendBatch(SessionManager * sessionManager) : mSessionManager(sessionManager)
+    {
+        if (mSessionManager != nullptr)
+        {
+            mSessionManager->BeginSendBatch();
+        }
+    }
+    ~ScopedSendBatch() { End(); }
+
+    /**
+     * Close the batch before the object goes out of scope, returning the result of SessionManager::EndSendBatch.
+     */
+    CHIP_ERROR End()
+    {
+        SessionManager * sessionManager = mSessionManager;
+        mSessionManager                 = nullptr;
+        return (sessionManager != nullptr) ? sessionManager->EndSendBatch() : CHIP_NO_ERROR;
+    }
+
+    ScopedSendBatch(const ScopedSendBatch &) = delete;
+    ScopedSendBatch & operator=(const ScopedSendBatch &) = delete;
+
+private:
+    SessionManager * mSessionManager;
+};
+
 namespace MessagePacketBuffer {
 /**
  * Maximum size of a message footer, in bytes.
@@ -51,6 +51,25 @@ public:
      * @param msgBuf    the buffer containing a full CHIP message (except for the optional length field).
      */
     virtual void OnMessageReceived(const Transport::PeerAddress & source, System::PacketBufferHandle && msgBuf) = 0;
+
+    /**
+     * @brief
+     *   Handle several messages received by a single transport wakeup.
+     *
+     * @param sources   the source address of each package
+     * @param msgBufs   the buffers containing full CHIP messages; null entries must be skipped.
+     * @param count     the number of entries in \c sources and \c msgBufs
+     */
+    virtual void OnMessageBatchReceived(const Transport::PeerAddress * sources, System::PacketBufferHandle * msgBufs, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!msgBufs[i].IsNull())
+            {
+                OnMessageReceived(sources[i], std::move(msgBufs[i]));
+            }
+        }
+    }
 };
 
 template <typename... TransportTypes>
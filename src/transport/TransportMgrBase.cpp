@@ -27,6 +27,12 @@ CHIP_ERROR TransportMgrBase::SendMessage(const Transport::PeerAddress & address,
     return mTransport->SendMessage(address, std::move(msgBuf));
 }
 
+CHIP_ERROR TransportMgrBase::SendMessages(const Transport::PeerAddress * addresses, System::PacketBufferHandle * msgBufs,
+                                          size_t count, CHIP_ERROR * errors)
+{
+    return mTransport->SendMessages(addresses, msgBufs, count, errors);
+}
+
 void TransportMgrBase::Disconnect(const Transport::PeerAddress & address)
 {
     mTransport->Disconnect(address);
@@ -78,4 +84,29 @@ void TransportMgrBase::HandleMessageReceived(const Transport::PeerAddress & peer
     }
 }
 
+void TransportMgrBase::HandleMessageBatchReceived(const Transport::PeerAddress * peerAddresses, System::PacketBufferHandle * msgs,
+                                                  size_t count)
+{
+    if (mSessionManager == nullptr)
+    {
+        // Let the single message path log each drop.
+        RawTransportDelegate::HandleMessageBatchReceived(peerAddresses, msgs, count);
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (msgs[i]->HasChainedBuffer())
+        {
+            // Something in the lower levels messed up.
+            char addrBuffer[Transport::PeerAddress::kMaxToStringSize];
+            peerAddresses[i].ToString(addrBuffer);
+            ChipLogError(Inet, "message from %s dropped due to lower layers not ensuring a single packet buffer.", addrBuffer);
+            msgs[i] = nullptr;
+        }
+    }
+
+    mSessionManager->OnMessageBatchReceived(peerAddresses, msgs, count);
+}
+
 } // namespace chip
@@ -37,6 +37,9 @@ public:
 
     CHIP_ERROR SendMessage(const Transport::PeerAddress & address, System::PacketBufferHandle && msgBuf);
 
+    CHIP_ERROR SendMessages(const Transport::PeerAddress * addresses, System::PacketBufferHandle * msgBufs, size_t count,
+                            CHIP_ERROR * errors = nullptr);
+
     void Close();
 
     void Disconnect(const Transport::PeerAddress & address);
@@ -47,6 +50,9 @@ public:
 
     void HandleMessageReceived(const Transport::PeerAddress & peerAddress, System::PacketBufferHandle && msg) override;
 
+    void HandleMessageBatchReceived(const Transport::PeerAddress * peerAddresses, System::PacketBufferHandle * msgs,
+                                    size_t count) override;
+
 private:
     TransportMgrDelegate * mSessionManager = nullptr;
     Transport::Base * mTransport           = nullptr;
@@ -38,6 +38,19 @@ class RawTransportDelegate
 public:
     virtual ~RawTransportDelegate() {}
     virtual void HandleMessageReceived(const Transport::PeerAddress & peerAddress, System::PacketBufferHandle && msg) = 0;
+
+    /**
+     * Handle several messages received by a single transport wakeup. The default implementation hands
+     * them to HandleMessageReceived one at a time.
+     */
+    virtual void HandleMessageBatchReceived(const Transport::PeerAddress * peerAddresses, System::PacketBufferHandle * msgs,
+                                            size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            HandleMessageReceived(peerAddresses[i], std::move(msgs[i]));
+        }
+    }
 };
 
 /**
@@ -65,6 +78,38 @@ public:
      */
     virtual CHIP_ERROR SendMessage(const PeerAddress & address, System::PacketBufferHandle && msgBuf) = 0;
 
+    /**
+     * @brief Send several messages, each to its own target.
+     *
+     * Transports able to hand a whole batch to the system at once (e.g. UDP with sendmmsg) override
+     * this; the default implementation sends the messages one at a time.
+     *
+     * @param[in]  addresses  The target of each message.
+     * @param[in]  msgBufs    The messages to send.
+     * @param[in]  count      The number of entries in \c addresses and \c msgBufs.
+     * @param[out] errors     Optional; receives the send status of each message.
+     *
+     * @return the first error encountered, or CHIP_NO_ERROR if every message was sent.
+     */
+    virtual CHIP_ERROR SendMessages(const PeerAddress * addresses, System::PacketBufferHandle * msgBufs, size_t count,
+                                    CHIP_ERROR * errors = nullptr)
+    {
+        CHIP_ERROR firstError = CHIP_NO_ERROR;
+        for (size_t i = 0; i < count; i++)
+        {
+            CHIP_ERROR err = SendMessage(addresses[i], std::move(msgBufs[i]));
+            if (errors != nullptr)
+            {
+                errors[i] = err;
+            }
+            if (firstError == CHIP_NO_ERROR)
+            {
+                firstError = err;
+            }
+        }
+        return firstError;
+    }
+
     /**
      * Determine if this transport can SendMessage to the specified peer address.
      *
@@ -102,6 +147,14 @@ protected:
         mDelegate->HandleMessageReceived(source, std::move(buffer));
     }
 
+    /**
+     * Method used by subclasses to notify that several packets have been received at once.
+     */
+    void HandleMessageBatchReceived(const PeerAddress * sources, System::PacketBufferHandle * buffers, size_t count)
+    {
+        mDelegate->HandleMessageBatchReceived(sources, buffers, count);
+    }
+
     RawTransportDelegate * mDelegate;
 };
 
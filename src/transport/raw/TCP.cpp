@@ -32,6 +32,7 @@
 
 #include <inttypes.h>
 #include <limits>
+#include <string.h>
 
 namespace chip {
 namespace Transport {
@@ -47,6 +48,36 @@ constexpr uint16_t kMaxMessageSize = static_cast<uint16_t>(System::PacketBuffer:
 
 constexpr int kListenBacklogSize = 2;
 
+// FNV-1a over the peer IP address and port. The interface is left out so that lookups which only know the
+// address and port land in the same bucket.
+size_t HashPeerAddress(const Inet::IPAddress & address, uint16_t port)
+{
+    uint32_t hash = 2166136261u;
+    for (uint32_t word : address.Addr)
+    {
+        hash = (hash ^ word) * 16777619u;
+    }
+    hash = (hash ^ port) * 16777619u;
+    return hash;
+}
+
+size_t HashEndPoint(const Inet::TCPEndPoint * endPoint)
+{
+    // Endpoints are pool allocated, so the low bits of their addresses carry little information.
+    uintptr_t value = reinterpret_cast<uintptr_t>(endPoint);
+    return static_cast<size_t>(value ^ (value >> 4) ^ (value >> 12));
+}
+
+void SetEndPointIdleTimeout(Inet::TCPEndPoint * endPoint, System::Clock::Milliseconds32 timeout)
+{
+#if INET_TCP_IDLE_CHECK_INTERVAL > 0
+    if (timeout > System::Clock::kZero)
+    {
+        endPoint->SetIdleTimeout(timeout.count());
+    }
+#endif // INET_TCP_IDLE_CHECK_INTERVAL > 0
+}
+
 } // namespace
 
 TCPBase::~TCPBase()
@@ -58,19 +89,15 @@ TCPBase::~TCPBase()
         mListenSocket = nullptr;
     }
 
-    CloseActiveConnections();
+    // Active connections are closed by the derived class, which owns the connection pool.
 }
 
 void TCPBase::CloseActiveConnections()
 {
-    for (size_t i = 0; i < mActiveConnectionsSize; i++)
-    {
-        if (mActiveConnections[i].InUse())
-        {
-            mActiveConnections[i].Free();
-            mUsedEndPointCount--;
-        }
-    }
+    mActiveConnections.ForEachActiveObject([&](ActiveConnectionState * state) {
+        ReleaseActiveConnection(state);
+        return Loop::Continue;
+    });
 }
 
 CHIP_ERROR TCPBase::Init(TcpListenParameters & params)
@@ -100,6 +127,7 @@ CHIP_ERROR TCPBase::Init(TcpListenParameters & params)
     mListenSocket->OnConnectionReceived = OnConnectionReceived;
     mListenSocket->OnAcceptError        = OnAcceptError;
     mEndpointType                       = params.GetAddressType();
+    mIdleTimeout                        = params.GetIdleTimeout();
 
     mState = State::kInitialized;
 
@@ -127,6 +155,16 @@ void TCPBase::Close()
     mState = State::kNotReady;
 }
 
+TCPBase::ConnectionIndexBucket & TCPBase::PeerBucket(const PeerAddress & address) const
+{
+    return mIndexBuckets[HashPeerAddress(address.GetIPAddress(), address.GetPort()) % mIndexBucketCount];
+}
+
+TCPBase::ConnectionIndexBucket & TCPBase::EndPointBucket(const Inet::TCPEndPoint * endPoint) const
+{
+    return mIndexBuckets[HashEndPoint(endPoint) % mIndexBucketCount];
+}
+
 TCPBase::ActiveConnectionState * TCPBase::FindActiveConnection(const PeerAddress & address)
 {
     if (address.GetTransportType() != Type::kTcp)
@@ -134,19 +172,12 @@ TCPBase::ActiveConnectionState * TCPBase::FindActiveConnection(const PeerAddress
         return nullptr;
     }
 
-    for (size_t i = 0; i < mActiveConnectionsSize; i++)
+    for (ActiveConnectionState * state = PeerBucket(address).mByPeer; state != nullptr; state = state->mNextByPeer)
     {
-        if (!mActiveConnections[i].InUse())
+        if ((state->mPeerAddress.GetIPAddress() == address.GetIPAddress()) &&
+            (state->mPeerAddress.GetPort() == address.GetPort()))
         {
-            continue;
-        }
-        Inet::IPAddress addr;
-        uint16_t port;
-        mActiveConnections[i].mEndPoint->GetPeerInfo(&addr, &port);
-
-        if ((addr == address.GetIPAddress()) && (port == address.GetPort()))
-        {
-            return &mActiveConnections[i];
+            return state;
         }
     }
 
@@ -155,16 +186,63 @@ TCPBase::ActiveConnectionState * TCPBase::FindActiveConnection(const PeerAddress
 
 TCPBase::ActiveConnectionState * TCPBase::FindActiveConnection(const Inet::TCPEndPoint * endPoint)
 {
-    for (size_t i = 0; i < mActiveConnectionsSize; i++)
+    for (ActiveConnectionState * state = EndPointBucket(endPoint).mByEndPoint; state != nullptr; state = state->mNextByEndPoint)
     {
-        if (mActiveConnections[i].mEndPoint == endPoint)
+        if (state->mEndPoint == endPoint)
         {
-            return &mActiveConnections[i];
+            return state;
         }
     }
     return nullptr;
 }
 
+TCPBase::ActiveConnectionState * TCPBase::AddActiveConnection(Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress)
+{
+    ActiveConnectionState * state = mActiveConnections.CreateObject(endPoint, peerAddress);
+    if (state == nullptr)
+    {
+        return nullptr;
+    }
+
+    // New connections go to the front of their chains, so the most recently established connection to a peer wins lookups.
+    ConnectionIndexBucket & peerBucket = PeerBucket(peerAddress);
+    state->mNextByPeer                 = peerBucket.mByPeer;
+    peerBucket.mByPeer                 = state;
+
+    ConnectionIndexBucket & endPointBucket = EndPointBucket(endPoint);
+    state->mNextByEndPoint                 = endPointBucket.mByEndPoint;
+    endPointBucket.mByEndPoint             = state;
+
+    SetEndPointIdleTimeout(endPoint, mIdleTimeout);
+    return state;
+}
+
+void TCPBase::ReleaseActiveConnection(ActiveConnectionState * state)
+{
+    for (ActiveConnectionState ** link = &PeerBucket(state->mPeerAddress).mByPeer; *link != nullptr; link = &(*link)->mNextByPeer)
+    {
+        if (*link == state)
+        {
+            *link = state->mNextByPeer;
+            break;
+        }
+    }
+
+    for (ActiveConnectionState ** link = &EndPointBucket(state->mEndPoint).mByEndPoint; *link != nullptr;
+         link                          = &(*link)->mNextByEndPoint)
+    {
+        if (*link == state)
+        {
+            *link = state->mNextByEndPoint;
+            break;
+        }
+    }
+
+    state->Free();
+    mActiveConnections.ReleaseObject(state);
+    mUsedEndPointCount--;
+}
+
 CHIP_ERROR TCPBase::SendMessage(const Transport::PeerAddress & address, System::PacketBufferHandle && msgBuf)
 {
     // Sent buffer data format is:
@@ -256,8 +334,7 @@ CHIP_ERROR TCPBase::SendAfterConnect(const PeerAddress & addr, System::PacketBuf
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR TCPBase::ProcessReceivedBuffer(Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress,
-                                          System::PacketBufferHandle && buffer)
+CHIP_ERROR TCPBase::ProcessReceivedBuffer(Inet::TCPEndPoint * endPoint, System::PacketBufferHandle && buffer)
 {
     ActiveConnectionState * state = FindActiveConnection(endPoint);
     VerifyOrReturnError(state != nullptr, CHIP_ERROR_INTERNAL);
@@ -265,18 +342,27 @@ CHIP_ERROR TCPBase::ProcessReceivedBuffer(Inet::TCPEndPoint * endPoint, const Pe
 
     while (!state->mReceived.IsNull())
     {
-        uint8_t messageSizeBuf[kPacketSizeBytes];
-        CHIP_ERROR err = state->mReceived->Read(messageSizeBuf);
-        if (err == CHIP_ERROR_BUFFER_TOO_SMALL)
+        uint16_t messageSize;
+        if (state->mReceived->DataLength() >= kPacketSizeBytes)
         {
-            // We don't have enough data to read the message size. Wait until there's more.
-            return CHIP_NO_ERROR;
+            // The length prefix is contiguous in the head buffer; read it in place.
+            messageSize = LittleEndian::Get16(state->mReceived->Start());
         }
-        else if (err != CHIP_NO_ERROR)
+        else
         {
-            return err;
+            uint8_t messageSizeBuf[kPacketSizeBytes];
+            CHIP_ERROR err = state->mReceived->Read(messageSizeBuf);
+            if (err == CHIP_ERROR_BUFFER_TOO_SMALL)
+            {
+                // We don't have enough data to read the message size. Wait until there's more.
+                return CHIP_NO_ERROR;
+            }
+            else if (err != CHIP_NO_ERROR)
+            {
+                return err;
+            }
+            messageSize = LittleEndian::Get16(messageSizeBuf);
         }
-        uint16_t messageSize = LittleEndian::Get16(messageSizeBuf);
         if (messageSize >= kMaxMessageSize)
         {
             // This message is too long for upper layers.
@@ -289,13 +375,13 @@ CHIP_ERROR TCPBase::ProcessReceivedBuffer(Inet::TCPEndPoint * endPoint, const Pe
             return CHIP_NO_ERROR;
         }
         state->mReceived.Consume(kPacketSizeBytes);
-        ReturnErrorOnFailure(ProcessSingleMessage(peerAddress, state, messageSize));
+        ReturnErrorOnFailure(ProcessSingleMessage(state, messageSize));
     }
 
     return CHIP_NO_ERROR;
 }
 
-CHIP_ERROR TCPBase::ProcessSingleMessage(const PeerAddress & peerAddress, ActiveConnectionState * state, uint16_t messageSize)
+CHIP_ERROR TCPBase::ProcessSingleMessage(ActiveConnectionState * state, uint16_t messageSize)
 {
     // We enter with `state->mReceived` containing at least one full message, perhaps in a chain.
     // `state->mReceived->Start()` currently points to the message data.
@@ -319,28 +405,30 @@ CHIP_ERROR TCPBase::ProcessSingleMessage(const PeerAddress & peerAddress, Active
         {
             return CHIP_ERROR_NO_MEMORY;
         }
-        CHIP_ERROR err = state->mReceived->Read(message->Start(), messageSize);
-        state->mReceived.Consume(messageSize);
-        ReturnErrorOnFailure(err);
+        if (state->mReceived->DataLength() > messageSize)
+        {
+            // Several messages share the head buffer: copy this one out of it in place, leaving the rest for the next pass.
+            memcpy(message->Start(), state->mReceived->Start(), messageSize);
+            state->mReceived->ConsumeHead(messageSize);
+        }
+        else
+        {
+            CHIP_ERROR err = state->mReceived->Read(message->Start(), messageSize);
+            state->mReceived.Consume(messageSize);
+            ReturnErrorOnFailure(err);
+        }
         message->SetDataLength(messageSize);
     }
 
-    HandleMessageReceived(peerAddress, std::move(message));
+    HandleMessageReceived(state->mPeerAddress, std::move(message));
     return CHIP_NO_ERROR;
 }
 
 CHIP_ERROR TCPBase::OnTcpReceive(Inet::TCPEndPoint * endPoint, System::PacketBufferHandle && buffer)
 {
-    Inet::IPAddress ipAddress;
-    uint16_t port;
-    Inet::InterfaceId interfaceId;
-
-    endPoint->GetPeerInfo(&ipAddress, &port);
-    endPoint->GetInterfaceId(&interfaceId);
-    PeerAddress peerAddress = PeerAddress::TCP(ipAddress, port, interfaceId);
-
+    // The peer address was recorded when the connection was set up, so it is not queried from the endpoint per packet.
     TCPBase * tcp  = reinterpret_cast<TCPBase *>(endPoint->mAppState);
-    CHIP_ERROR err = tcp->ProcessReceivedBuffer(endPoint, peerAddress, std::move(buffer));
+    CHIP_ERROR err = tcp->ProcessReceivedBuffer(endPoint, std::move(buffer));
 
     if (err != CHIP_NO_ERROR)
     {
@@ -400,26 +488,13 @@ void TCPBase::OnConnectionComplete(Inet::TCPEndPoint * endPoint, CHIP_ERROR inet
         endPoint->Free();
         tcp->mUsedEndPointCount--;
     }
-    else
+    else if (tcp->AddActiveConnection(endPoint, addr) == nullptr)
     {
-        bool connectionStored = false;
-        for (size_t i = 0; i < tcp->mActiveConnectionsSize; i++)
-        {
-            if (!tcp->mActiveConnections[i].InUse())
-            {
-                tcp->mActiveConnections[i].Init(endPoint);
-                connectionStored = true;
-                break;
-            }
-        }
-
         // since we track end points counts, we always expect to store the
         // connection.
-        if (!connectionStored)
-        {
-            endPoint->Free();
-            ChipLogError(Inet, "Internal logic error: insufficient space to store active connection");
-        }
+        endPoint->Free();
+        tcp->mUsedEndPointCount--;
+        ChipLogError(Inet, "Internal logic error: insufficient space to store active connection");
     }
 }
 
@@ -427,16 +502,20 @@ void TCPBase::OnConnectionClosed(Inet::TCPEndPoint * endPoint, CHIP_ERROR err)
 {
     TCPBase * tcp = reinterpret_cast<TCPBase *>(endPoint->mAppState);
 
-    ChipLogProgress(Inet, "Connection closed.");
+    if (err == INET_ERROR_IDLE_TIMEOUT)
+    {
+        ChipLogProgress(Inet, "Connection closed: idle timeout.");
+    }
+    else
+    {
+        ChipLogProgress(Inet, "Connection closed.");
+    }
 
-    for (size_t i = 0; i < tcp->mActiveConnectionsSize; i++)
+    ActiveConnectionState * state = tcp->FindActiveConnection(endPoint);
+    if (state != nullptr)
     {
-        if (tcp->mActiveConnections[i].mEndPoint == endPoint)
-        {
-            ChipLogProgress(Inet, "Freeing closed connection.");
-            tcp->mActiveConnections[i].Free();
-            tcp->mUsedEndPointCount--;
-        }
+        ChipLogProgress(Inet, "Freeing closed connection.");
+        tcp->ReleaseActiveConnection(state);
     }
 }
 
@@ -445,17 +524,14 @@ void TCPBase::OnConnectionReceived(Inet::TCPEndPoint * listenEndPoint, Inet::TCP
 {
     TCPBase * tcp = reinterpret_cast<TCPBase *>(listenEndPoint->mAppState);
 
-    if (tcp->mUsedEndPointCount < tcp->mActiveConnectionsSize)
+    Inet::InterfaceId interfaceId;
+    endPoint->GetInterfaceId(&interfaceId);
+
+    // have space to use one more (even if considering pending connections)
+    if (tcp->mUsedEndPointCount < tcp->mActiveConnectionsSize &&
+        tcp->AddActiveConnection(endPoint, PeerAddress::TCP(peerAddress, peerPort, interfaceId)) != nullptr)
     {
-        // have space to use one more (even if considering pending connections)
-        for (size_t i = 0; i < tcp->mActiveConnectionsSize; i++)
-        {
-            if (!tcp->mActiveConnections[i].InUse())
-            {
-                tcp->mActiveConnections[i].Init(endPoint);
-                break;
-            }
-        }
+        tcp->mUsedEndPointCount++;
 
         endPoint->mAppState            = listenEndPoint->mAppState;
         endPoint->OnDataReceived       = OnTcpReceive;
@@ -480,25 +556,18 @@ void TCPBase::OnAcceptError(Inet::TCPEndPoint * endPoint, CHIP_ERROR err)
 void TCPBase::Disconnect(const PeerAddress & address)
 {
     // Closes an existing connection
-    for (size_t i = 0; i < mActiveConnectionsSize; i++)
+    ActiveConnectionState * state = PeerBucket(address).mByPeer;
+    while (state != nullptr)
     {
-        if (mActiveConnections[i].InUse())
+        ActiveConnectionState * next = state->mNextByPeer;
+        if (state->mPeerAddress == address)
         {
-            Inet::IPAddress ipAddress;
-            uint16_t port;
-            Inet::InterfaceId interfaceId;
-
-            mActiveConnections[i].mEndPoint->GetPeerInfo(&ipAddress, &port);
-            mActiveConnections[i].mEndPoint->GetInterfaceId(&interfaceId);
-            if (address == PeerAddress::TCP(ipAddress, port, interfaceId))
-            {
-                // NOTE: this leaves the socket in TIME_WAIT.
-                // Calling Abort() would clean it since SO_LINGER would be set to 0,
-                // however this seems not to be useful.
-                mActiveConnections[i].Free();
-                mUsedEndPointCount--;
-            }
+            // NOTE: this leaves the socket in TIME_WAIT.
+            // Calling Abort() would clean it since SO_LINGER would be set to 0,
+            // however this seems not to be useful.
+            ReleaseActiveConnection(state);
         }
+        state = next;
     }
 }
 
@@ -506,28 +575,17 @@ void TCPBase::OnPeerClosed(Inet::TCPEndPoint * endPoint)
 {
     TCPBase * tcp = reinterpret_cast<TCPBase *>(endPoint->mAppState);
 
-    for (size_t i = 0; i < tcp->mActiveConnectionsSize; i++)
+    ActiveConnectionState * state = tcp->FindActiveConnection(endPoint);
+    if (state != nullptr)
     {
-        if (tcp->mActiveConnections[i].mEndPoint == endPoint)
-        {
-            ChipLogProgress(Inet, "Freeing connection: connection closed by peer");
-            tcp->mActiveConnections[i].Free();
-            tcp->mUsedEndPointCount--;
-        }
+        ChipLogProgress(Inet, "Freeing connection: connection closed by peer");
+        tcp->ReleaseActiveConnection(state);
     }
 }
 
 bool TCPBase::HasActiveConnections() const
 {
-    for (size_t i = 0; i < mActiveConnectionsSize; i++)
-    {
-        if (mActiveConnections[i].InUse())
-        {
-            return true;
-        }
-    }
-
-    return false;
+    return mActiveConnections.ForEachActiveObject([](const ActiveConnectionState *) { return Loop::Break; }) == Loop::Break;
 }
 
 } // namespace Transport
@@ -34,6 +34,7 @@
 #include <lib/core/CHIPCore.h>
 #include <lib/support/CodeUtils.h>
 #include <lib/support/PoolWrapper.h>
+#include <system/SystemClock.h>
 #include <transport/raw/Base.h>
 
 namespace chip {
@@ -73,11 +74,21 @@ public:
         return *this;
     }
 
+    System::Clock::Milliseconds32 GetIdleTimeout() const { return mIdleTimeout; }
+    TcpListenParameters & SetIdleTimeout(System::Clock::Milliseconds32 timeout)
+    {
+        mIdleTimeout = timeout;
+
+        return *this;
+    }
+
 private:
     Inet::EndPointManager<Inet::TCPEndPoint> * mEndPointManager;   ///< Associated endpoint factory
     Inet::IPAddressType mAddressType = Inet::IPAddressType::kIPv6; ///< type of listening socket
     uint16_t mListenPort             = CHIP_PORT;                  ///< TCP listen port
     Inet::InterfaceId mInterfaceId   = Inet::InterfaceId::Null();  ///< Interface to listen on
+    System::Clock::Milliseconds32 mIdleTimeout =
+        System::Clock::Milliseconds32(CHIP_CONFIG_TCP_CONNECTION_IDLE_TIMEOUT_MS); ///< Idle connection timeout, 0 to disable
 };
 
 /**
@@ -111,11 +122,9 @@ protected:
      */
     struct ActiveConnectionState
     {
-        void Init(Inet::TCPEndPoint * endPoint)
-        {
-            mEndPoint = endPoint;
-            mReceived = nullptr;
-        }
+        ActiveConnectionState(Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress) :
+            mEndPoint(endPoint), mPeerAddress(peerAddress)
+        {}
 
         void Free()
         {
@@ -128,17 +137,43 @@ protected:
         // Associated endpoint.
         Inet::TCPEndPoint * mEndPoint;
 
+        // Address of the peer, cached at connection time so lookups do not need to query the endpoint.
+        PeerAddress mPeerAddress;
+
         // Buffers received but not yet consumed.
         System::PacketBufferHandle mReceived;
+
+        // Next connection in the same peer address and endpoint index buckets.
+        ActiveConnectionState * mNextByPeer     = nullptr;
+        ActiveConnectionState * mNextByEndPoint = nullptr;
     };
 
-public:
-    using PendingPacketPoolType = PoolInterface<PendingPacket, const PeerAddress &, System::PacketBufferHandle &&>;
-    TCPBase(ActiveConnectionState * activeConnectionsBuffer, size_t bufferSize, PendingPacketPoolType & packetBuffers) :
-        mActiveConnections(activeConnectionsBuffer), mActiveConnectionsSize(bufferSize), mPendingPackets(packetBuffers)
+    /**
+     *  Heads of the connection index chains for one hash bucket.
+     */
+    struct ConnectionIndexBucket
     {
-        // activeConnectionsBuffer must be initialized by the caller.
-    }
+        ActiveConnectionState * mByPeer     = nullptr;
+        ActiveConnectionState * mByEndPoint = nullptr;
+    };
+
+public:
+    using ActiveConnectionPoolType = PoolInterface<ActiveConnectionState, Inet::TCPEndPoint *, const PeerAddress &>;
+    using PendingPacketPoolType    = PoolInterface<PendingPacket, const PeerAddress &, System::PacketBufferHandle &&>;
+
+    /**
+     * @param activeConnections     pool the active connection states are allocated from
+     * @param maxActiveConnections  maximum number of active and pending connections
+     * @param indexBuckets          hash buckets used to look up connections by peer address and endpoint
+     * @param indexBucketCount      number of entries in indexBuckets; must be non-zero
+     * @param packetBuffers         pool of packets waiting for a connection to be established
+     */
+    TCPBase(ActiveConnectionPoolType & activeConnections, size_t maxActiveConnections, ConnectionIndexBucket * indexBuckets,
+            size_t indexBucketCount, PendingPacketPoolType & packetBuffers) :
+        mActiveConnections(activeConnections),
+        mActiveConnectionsSize(maxActiveConnections), mIndexBuckets(indexBuckets), mIndexBucketCount(indexBucketCount),
+        mPendingPackets(packetBuffers)
+    {}
     ~TCPBase() override;
 
     /**
@@ -190,6 +225,20 @@ private:
     ActiveConnectionState * FindActiveConnection(const PeerAddress & addr);
     ActiveConnectionState * FindActiveConnection(const Inet::TCPEndPoint * endPoint);
 
+    /**
+     * Allocate the state for a newly established connection and add it to the lookup index.
+     * Applies the configured idle timeout to the endpoint.
+     */
+    ActiveConnectionState * AddActiveConnection(Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress);
+
+    /**
+     * Remove a connection from the lookup index, free its endpoint and release its state.
+     */
+    void ReleaseActiveConnection(ActiveConnectionState * state);
+
+    ConnectionIndexBucket & PeerBucket(const PeerAddress & address) const;
+    ConnectionIndexBucket & EndPointBucket(const Inet::TCPEndPoint * endPoint) const;
+
     /**
      * Sends the specified message once a connection has been established.
      *
@@ -204,26 +253,24 @@ private:
     /**
      * Process a single received buffer from the specified peer address.
      *
-     * @param endPoint the source end point from which the data comes from
-     * @param peerAddress the peer the data is coming from
+     * @param endPoint the source end point from which the data comes from; messages are reported as coming from the
+     *                 peer address recorded for its connection
      * @param buffer the actual data
      *
      * Ownership of buffer is taken over and will be freed (or re-enqueued to the endPoint receive queue)
      * as needed during processing.
      */
-    CHIP_ERROR ProcessReceivedBuffer(Inet::TCPEndPoint * endPoint, const PeerAddress & peerAddress,
-                                     System::PacketBufferHandle && buffer);
+    CHIP_ERROR ProcessReceivedBuffer(Inet::TCPEndPoint * endPoint, System::PacketBufferHandle && buffer);
 
     /**
      * Process a single message of the specified size from a buffer.
      *
-     * @param[in]     peerAddress   The peer the data is coming from.
      * @param[in,out] state         The connection state, which contains the message. On entry, the payload points to the message
      *                              body (after the length). On exit, it points after the message (or the queue is null, if there
      *                              is no other data).
      * @param[in]     messageSize   Size of the single message.
      */
-    CHIP_ERROR ProcessSingleMessage(const PeerAddress & peerAddress, ActiveConnectionState * state, uint16_t messageSize);
+    CHIP_ERROR ProcessSingleMessage(ActiveConnectionState * state, uint16_t messageSize);
 
     // Callback handler for TCPEndPoint. TCP message receive handler.
     // @see TCPEndpoint::OnDataReceivedFunct
@@ -254,12 +301,16 @@ private:
     Inet::IPAddressType mEndpointType = Inet::IPAddressType::kUnknown; ///< Socket listening type
     State mState                      = State::kNotReady;              ///< State of the TCP transport
 
+    System::Clock::Milliseconds32 mIdleTimeout = System::Clock::kZero; ///< Idle timeout applied to new connections
+
     // Number of active and 'pending connection' endpoints
     size_t mUsedEndPointCount = 0;
 
-    // Currently active connections
-    ActiveConnectionState * mActiveConnections;
+    // Currently active connections, indexed by peer address and by endpoint
+    ActiveConnectionPoolType & mActiveConnections;
     const size_t mActiveConnectionsSize;
+    ConnectionIndexBucket * mIndexBuckets;
+    const size_t mIndexBucketCount;
 
     // Data to be sent when connections succeed
     PendingPacketPoolType & mPendingPackets;
@@ -269,18 +320,22 @@ template <size_t kActiveConnectionsSize, size_t kPendingPacketSize>
 class TCP : public TCPBase
 {
 public:
-    TCP() : TCPBase(mConnectionsBuffer, kActiveConnectionsSize, mPendingPackets)
+    TCP() : TCPBase(mConnections, kActiveConnectionsSize, mIndexBuckets, kIndexBucketCount, mPendingPackets) {}
+    ~TCP()
     {
-        for (size_t i = 0; i < kActiveConnectionsSize; ++i)
-        {
-            mConnectionsBuffer[i].Init(nullptr);
-        }
+        CloseActiveConnections();
+        mPendingPackets.ReleaseAll();
     }
-    ~TCP() { mPendingPackets.ReleaseAll(); }
 
 private:
     friend class TCPTest;
-    TCPBase::ActiveConnectionState mConnectionsBuffer[kActiveConnectionsSize];
+
+    // One bucket per connection keeps the index chains short without a resize step.
+    static constexpr size_t kIndexBucketCount = (kActiveConnectionsSize > 0) ? kActiveConnectionsSize : 1;
+
+    PoolImpl<ActiveConnectionState, kActiveConnectionsSize, ObjectPoolMem::kDefault, ActiveConnectionPoolType::Interface>
+        mConnections;
+    ConnectionIndexBucket mIndexBuckets[kIndexBucketCount];
     PoolImpl<PendingPacket, kPendingPacketSize, ObjectPoolMem::kInline, PendingPacketPoolType::Interface> mPendingPackets;
 };
 
@@ -26,6 +26,7 @@
 #include <tuple>
 #include <type_traits>
 
+#include <lib/support/CodeUtils.h>
 #include <transport/raw/Base.h>
 
 namespace chip {
@@ -86,6 +87,24 @@ public:
         return SendMessageImpl<0>(address, std::move(msgBuf));
     }
 
+    CHIP_ERROR SendMessages(const PeerAddress * addresses, System::PacketBufferHandle * msgBufs, size_t count,
+                            CHIP_ERROR * errors = nullptr) override
+    {
+        VerifyOrReturnError(count > 0, CHIP_NO_ERROR);
+
+        // A batch is only passed down whole when every message would go through the same transport;
+        // mixed batches are split into individual SendMessage calls.
+        const size_t transportIndex = SelectTransportImpl<0>(addresses[0]);
+        for (size_t i = 1; i < count; i++)
+        {
+            if (SelectTransportImpl<0>(addresses[i]) != transportIndex)
+            {
+                return Base::SendMessages(addresses, msgBufs, count, errors);
+            }
+        }
+        return SendMessagesImpl<0>(transportIndex, addresses, msgBufs, count, errors);
+    }
+
     CHIP_ERROR MulticastGroupJoinLeave(const Transport::PeerAddress & address, bool join) override
     {
         return MulticastGroupJoinLeaveImpl<0>(address, join);
@@ -208,6 +227,53 @@ private:
         return CHIP_ERROR_NO_MESSAGE_HANDLER;
     }
 
+    /**
+     * Recursive transport selection iterating through transport members.
+     *
+     * @return the index of the first transport from index N or above which returns 'CanSendToPeer',
+     *         or sizeof...(TransportTypes) if there is none.
+     */
+    template <size_t N, typename std::enable_if<(N < sizeof...(TransportTypes))>::type * = nullptr>
+    size_t SelectTransportImpl(const PeerAddress & address)
+    {
+        return std::get<N>(mTransports).CanSendToPeer(address) ? N : SelectTransportImpl<N + 1>(address);
+    }
+
+    /**
+     * SelectTransportImpl when N is out of range.
+     */
+    template <size_t N, typename std::enable_if<(N >= sizeof...(TransportTypes))>::type * = nullptr>
+    size_t SelectTransportImpl(const PeerAddress & address)
+    {
+        return sizeof...(TransportTypes);
+    }
+
+    /**
+     * Recursive batched send implementation iterating through transport members.
+     *
+     * The batch is handed to the transport whose index is \c transportIndex.
+     */
+    template <size_t N, typename std::enable_if<(N < sizeof...(TransportTypes))>::type * = nullptr>
+    CHIP_ERROR SendMessagesImpl(size_t transportIndex, const PeerAddress * addresses, System::PacketBufferHandle * msgBufs,
+                                size_t count, CHIP_ERROR * errors)
+    {
+        if (transportIndex == N)
+        {
+            return std::get<N>(mTransports).SendMessages(addresses, msgBufs, count, errors);
+        }
+        return SendMessagesImpl<N + 1>(transportIndex, addresses, msgBufs, count, errors);
+    }
+
+    /**
+     * SendMessagesImpl when N is out of range. Reports an error for each message.
+     */
+    template <size_t N, typename std::enable_if<(N >= sizeof...(TransportTypes))>::type * = nullptr>
+    CHIP_ERROR SendMessagesImpl(size_t transportIndex, const PeerAddress * addresses, System::PacketBufferHandle * msgBufs,
+                                size_t count, CHIP_ERROR * errors)
+    {
+        return Base::SendMessages(addresses, msgBufs, count, errors);
+    }
+
     /**
      * Recursive GroupJoinLeave implementation iterating through transport members.
      *
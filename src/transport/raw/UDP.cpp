@@ -27,6 +27,7 @@
 #include <lib/support/logging/CHIPLogging.h>
 #include <transport/raw/MessageHeader.h>
 
+#include <algorithm>
 #include <inttypes.h>
 
 namespace chip {
@@ -54,6 +55,7 @@ CHIP_ERROR UDP::Init(UdpListenParameters & params)
     err = mUDPEndPoint->Bind(params.GetAddressType(), Inet::IPAddress::Any, params.GetListenPort(), params.GetInterfaceId());
     SuccessOrExit(err);
 
+    mUDPEndPoint->SetBatchReceiveHandler(OnUdpBatchReceive);
     err = mUDPEndPoint->Listen(OnUdpReceive, nullptr /*onReceiveError*/, this);
     SuccessOrExit(err);
 
@@ -111,6 +113,97 @@ CHIP_ERROR UDP::SendMessage(const Transport::PeerAddress & address, System::Pack
     return mUDPEndPoint->SendMsg(&addrInfo, std::move(msgBuf));
 }
 
+CHIP_ERROR UDP::SendMessages(const Transport::PeerAddress * addresses, System::PacketBufferHandle * msgBufs, size_t count,
+                             CHIP_ERROR * errors)
+{
+    CHIP_ERROR stateError = CHIP_NO_ERROR;
+    if (mState != State::kInitialized || mUDPEndPoint == nullptr)
+    {
+        stateError = CHIP_ERROR_INCORRECT_STATE;
+    }
+
+    constexpr size_t kBatchSize = INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE;
+    Inet::IPPacketInfo addrInfos[kBatchSize];
+    System::PacketBufferHandle batch[kBatchSize];
+    CHIP_ERROR batchErrors[kBatchSize];
+    size_t batchIndices[kBatchSize];
+    CHIP_ERROR firstError = CHIP_NO_ERROR;
+
+    for (size_t offset = 0; offset < count; offset += kBatchSize)
+    {
+        const size_t chunkCount = std::min(kBatchSize, count - offset);
+        size_t batchCount       = 0;
+
+        // Messages that cannot be sent get their error and are left out, without holding back the rest of the batch.
+        for (size_t i = offset; i < offset + chunkCount; i++)
+        {
+            const Transport::PeerAddress & address = addresses[i];
+            CHIP_ERROR err                         = stateError;
+            if (err == CHIP_NO_ERROR && address.GetTransportType() != Type::kUdp)
+            {
+                err = CHIP_ERROR_INVALID_ARGUMENT;
+            }
+            if (err != CHIP_NO_ERROR)
+            {
+                if (errors != nullptr)
+                {
+                    errors[i] = err;
+                }
+                if (firstError == CHIP_NO_ERROR)
+                {
+                    firstError = err;
+                }
+                continue;
+            }
+
+            addrInfos[batchCount].Clear();
+            addrInfos[batchCount].DestAddress = address.GetIPAddress();
+            addrInfos[batchCount].DestPort    = address.GetPort();
+            addrInfos[batchCount].Interface   = address.GetInterface();
+            batch[batchCount]                 = std::move(msgBufs[i]);
+            batchErrors[batchCount]           = CHIP_NO_ERROR;
+            batchIndices[batchCount]          = i;
+            batchCount++;
+        }
+
+        if (batchCount == 0)
+        {
+            continue;
+        }
+
+        CHIP_ERROR err = mUDPEndPoint->SendMsgs(addrInfos, batch, batchCount, batchErrors);
+        if (firstError == CHIP_NO_ERROR)
+        {
+            firstError = err;
+        }
+        if (errors != nullptr)
+        {
+            for (size_t i = 0; i < batchCount; i++)
+            {
+                errors[batchIndices[i]] = batchErrors[i];
+            }
+        }
+    }
+
+    return firstError;
+}
+
+void UDP::OnUdpBatchReceive(Inet::UDPEndPoint * endPoint, System::PacketBufferHandle * buffers, const Inet::IPPacketInfo * pktInfos,
+                            size_t count)
+{
+    UDP * udp = reinterpret_cast<UDP *>(endPoint->mAppState);
+    PeerAddress peerAddresses[INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE];
+
+    VerifyOrDie(count <= ArraySize(peerAddresses));
+
+    for (size_t i = 0; i < count; i++)
+    {
+        peerAddresses[i] = PeerAddress::UDP(pktInfos[i].SrcAddress, pktInfos[i].SrcPort, pktInfos[i].Interface);
+    }
+
+    udp->HandleMessageBatchReceived(peerAddresses, buffers, count);
+}
+
 void UDP::OnUdpReceive(Inet::UDPEndPoint * endPoint, System::PacketBufferHandle && buffer, const Inet::IPPacketInfo * pktInfo)
 {
     CHIP_ERROR err          = CHIP_NO_ERROR;
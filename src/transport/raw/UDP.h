@@ -115,6 +115,9 @@ public:
 
     CHIP_ERROR SendMessage(const Transport::PeerAddress & address, System::PacketBufferHandle && msgBuf) override;
 
+    CHIP_ERROR SendMessages(const Transport::PeerAddress * addresses, System::PacketBufferHandle * msgBufs, size_t count,
+                            CHIP_ERROR * errors = nullptr) override;
+
     CHIP_ERROR MulticastGroupJoinLeave(const Transport::PeerAddress & address, bool join) override;
 
     bool CanListenMulticast() override
@@ -133,6 +136,10 @@ private:
     static void OnUdpReceive(Inet::UDPEndPoint * endPoint, System::PacketBufferHandle && buffer,
                              const Inet::IPPacketInfo * pktInfo);
 
+    // UDP batched message receive handler.
+    static void OnUdpBatchReceive(Inet::UDPEndPoint * endPoint, System::PacketBufferHandle * buffers,
+                                  const Inet::IPPacketInfo * pktInfos, size_t count);
+
     Inet::UDPEndPoint * mUDPEndPoint     = nullptr;                       ///< UDP socket used by the transport
     Inet::IPAddressType mUDPEndpointType = Inet::IPAddressType::kUnknown; ///< Socket listening type
     State mState                         = State::kNotReady;              ///< State of the UDP transport
@@ -381,6 +381,7 @@ void chip::Transport::TCPTest::CheckProcessReceivedBuffer(nlTestSuite * inSuite,
     NL_TEST_ASSERT(inSuite, state != nullptr);
     Inet::TCPEndPoint * lEndPoint = state->mEndPoint;
     NL_TEST_ASSERT(inSuite, lEndPoint != nullptr);
+    NL_TEST_ASSERT(inSuite, tcp.FindActiveConnection(lEndPoint) == state);
 
     CHIP_ERROR err = CHIP_NO_ERROR;
     TestData testData[2];
@@ -389,14 +390,14 @@ void chip::Transport::TCPTest::CheckProcessReceivedBuffer(nlTestSuite * inSuite,
     // Test a single packet buffer.
     gMockTransportMgrDelegate.mReceiveHandlerCallCount = 0;
     NL_TEST_ASSERT(inSuite, testData[0].Init((const uint16_t[]){ 111, 0 }));
-    err = tcp.ProcessReceivedBuffer(lEndPoint, lPeerAddress, std::move(testData[0].mHandle));
+    err = tcp.ProcessReceivedBuffer(lEndPoint, std::move(testData[0].mHandle));
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, gMockTransportMgrDelegate.mReceiveHandlerCallCount == 1);
 
     // Test a message in a chain of three packet buffers. The message length is split across buffers.
     gMockTransportMgrDelegate.mReceiveHandlerCallCount = 0;
     NL_TEST_ASSERT(inSuite, testData[0].Init((const uint16_t[]){ 1, 122, 123, 0 }));
-    err = tcp.ProcessReceivedBuffer(lEndPoint, lPeerAddress, std::move(testData[0].mHandle));
+    err = tcp.ProcessReceivedBuffer(lEndPoint, std::move(testData[0].mHandle));
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, gMockTransportMgrDelegate.mReceiveHandlerCallCount == 1);
 
@@ -405,7 +406,24 @@ void chip::Transport::TCPTest::CheckProcessReceivedBuffer(nlTestSuite * inSuite,
     NL_TEST_ASSERT(inSuite, testData[0].Init((const uint16_t[]){ 131, 0 }));
     NL_TEST_ASSERT(inSuite, testData[1].Init((const uint16_t[]){ 132, 0 }));
     testData[0].mHandle->AddToEnd(std::move(testData[1].mHandle));
-    err = tcp.ProcessReceivedBuffer(lEndPoint, lPeerAddress, std::move(testData[0].mHandle));
+    err = tcp.ProcessReceivedBuffer(lEndPoint, std::move(testData[0].mHandle));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, gMockTransportMgrDelegate.mReceiveHandlerCallCount == 2);
+
+    // Test two messages sharing a single packet buffer.
+    gMockTransportMgrDelegate.mReceiveHandlerCallCount = 0;
+    NL_TEST_ASSERT(inSuite, testData[0].Init((const uint16_t[]){ 135, 0 }));
+    NL_TEST_ASSERT(inSuite, testData[1].Init((const uint16_t[]){ 136, 0 }));
+    {
+        const size_t totalLength = testData[0].mTotalLength + testData[1].mTotalLength;
+        System::PacketBufferHandle combined =
+            System::PacketBufferHandle::New(static_cast<uint16_t>(totalLength), 0 /* reserve */);
+        NL_TEST_ASSERT(inSuite, !combined.IsNull());
+        memcpy(combined->Start(), testData[0].mPayload, testData[0].mTotalLength);
+        memcpy(combined->Start() + testData[0].mTotalLength, testData[1].mPayload, testData[1].mTotalLength);
+        combined->SetDataLength(static_cast<uint16_t>(totalLength));
+        err = tcp.ProcessReceivedBuffer(lEndPoint, std::move(combined));
+    }
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, gMockTransportMgrDelegate.mReceiveHandlerCallCount == 2);
 
@@ -414,7 +432,7 @@ void chip::Transport::TCPTest::CheckProcessReceivedBuffer(nlTestSuite * inSuite,
     NL_TEST_ASSERT(inSuite, testData[0].Init((const uint16_t[]){ 141, 142, 0 }));
     NL_TEST_ASSERT(inSuite, testData[1].Init((const uint16_t[]){ 143, 144, 0 }));
     testData[0].mHandle->AddToEnd(std::move(testData[1].mHandle));
-    err = tcp.ProcessReceivedBuffer(lEndPoint, lPeerAddress, std::move(testData[0].mHandle));
+    err = tcp.ProcessReceivedBuffer(lEndPoint, std::move(testData[0].mHandle));
     NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
     NL_TEST_ASSERT(inSuite, gMockTransportMgrDelegate.mReceiveHandlerCallCount == 2);
 
@@ -424,7 +442,7 @@ void chip::Transport::TCPTest::CheckProcessReceivedBuffer(nlTestSuite * inSuite,
     NL_TEST_ASSERT(inSuite, testData[0].Init((const uint16_t[]){ 51, System::PacketBuffer::kMaxSizeWithoutReserve, 0 }));
     // Sending only the first buffer of the long chain. This should be enough to trigger the error.
     System::PacketBufferHandle head = testData[0].mHandle.PopHead();
-    err                             = tcp.ProcessReceivedBuffer(lEndPoint, lPeerAddress, std::move(head));
+    err                             = tcp.ProcessReceivedBuffer(lEndPoint, std::move(head));
     NL_TEST_ASSERT(inSuite, err == CHIP_ERROR_MESSAGE_TOO_LONG);
     NL_TEST_ASSERT(inSuite, gMockTransportMgrDelegate.mReceiveHandlerCallCount == 0);
 
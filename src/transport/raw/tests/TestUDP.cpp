@@ -161,6 +161,70 @@ void CheckMessageTest6(nlTestSuite * inSuite, void * inContext)
     CheckMessageTest(inSuite, inContext, addr);
 }
 
+/////////////////////////// Batched messaging test
+
+void CheckMessageBatchTest(nlTestSuite * inSuite, void * inContext, const IPAddress & addr)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    constexpr size_t kBatchCount = 3;
+
+    CHIP_ERROR err = CHIP_NO_ERROR;
+
+    Transport::UDP udp;
+
+    err = udp.Init(Transport::UdpListenParameters(ctx.GetUDPEndPointManager()).SetAddressType(addr.Type()).SetListenPort(0));
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+
+    MockTransportMgrDelegate gMockTransportMgrDelegate(inSuite);
+    TransportMgrBase gTransportMgrBase;
+    gTransportMgrBase.SetSessionManager(&gMockTransportMgrDelegate);
+    gTransportMgrBase.Init(&udp);
+
+    ReceiveHandlerCallCount = 0;
+
+    PacketHeader header;
+    header.SetSourceNodeId(kSourceNodeId).SetDestinationNodeId(kDestinationNodeId).SetMessageCounter(kMessageCounter);
+
+    Transport::PeerAddress addresses[kBatchCount];
+    chip::System::PacketBufferHandle buffers[kBatchCount];
+    CHIP_ERROR errors[kBatchCount];
+
+    for (size_t i = 0; i < kBatchCount; i++)
+    {
+        buffers[i] = chip::System::PacketBufferHandle::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+        NL_TEST_ASSERT(inSuite, !buffers[i].IsNull());
+        NL_TEST_ASSERT(inSuite, header.EncodeBeforeData(buffers[i]) == CHIP_NO_ERROR);
+        addresses[i] = Transport::PeerAddress::UDP(addr, udp.GetBoundPort());
+    }
+
+    // All messages of the batch should reach the sender itself, whether or not the platform sends them with one call.
+    err = gTransportMgrBase.SendMessages(addresses, buffers, kBatchCount, errors);
+    NL_TEST_ASSERT(inSuite, err == CHIP_NO_ERROR);
+    for (size_t i = 0; i < kBatchCount; i++)
+    {
+        NL_TEST_ASSERT(inSuite, errors[i] == CHIP_NO_ERROR);
+    }
+
+    ctx.DriveIOUntil(chip::System::Clock::Seconds16(1), []() { return static_cast<size_t>(ReceiveHandlerCallCount) == kBatchCount; });
+
+    NL_TEST_ASSERT(inSuite, static_cast<size_t>(ReceiveHandlerCallCount) == kBatchCount);
+}
+
+void CheckMessageBatchTest4(nlTestSuite * inSuite, void * inContext)
+{
+    IPAddress addr;
+    IPAddress::FromString("127.0.0.1", addr);
+    CheckMessageBatchTest(inSuite, inContext, addr);
+}
+
+void CheckMessageBatchTest6(nlTestSuite * inSuite, void * inContext)
+{
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+    CheckMessageBatchTest(inSuite, inContext, addr);
+}
+
 // Test Suite
 
 /**
@@ -172,10 +236,12 @@ static const nlTest sTests[] =
 #if INET_CONFIG_ENABLE_IPV4
     NL_TEST_DEF("Simple Init Test IPV4",   CheckSimpleInitTest4),
     NL_TEST_DEF("Message Self Test IPV4",  CheckMessageTest4),
+    NL_TEST_DEF("Batch Self Test IPV4",    CheckMessageBatchTest4),
 #endif
 
     NL_TEST_DEF("Simple Init Test IPV6",   CheckSimpleInitTest6),
     NL_TEST_DEF("Message Self Test IPV6",  CheckMessageTest6),
+    NL_TEST_DEF("Batch Self Test IPV6",    CheckMessageBatchTest6),
 
     NL_TEST_SENTINEL()
 };
@@ -39,6 +39,7 @@
 #include <nlunit-test.h>
 
 #include <errno.h>
+#include <functional>
 
 #undef CHIP_ENABLE_TEST_ENCRYPTED_BUFFER_API
 
@@ -469,6 +470,258 @@ void StaleConnectionDropTest(nlTestSuite * inSuite, void * inContext)
     sessionManager.Shutdown();
 }
 
+class BatchTestCallback : public SessionMessageDelegate
+{
+public:
+    void OnMessageReceived(const PacketHeader & header, const PayloadHeader & payloadHeader, const SessionHandle & session,
+                           const Transport::PeerAddress & source, DuplicateMessage isDuplicate,
+                           System::PacketBufferHandle && msgBuf) override
+    {
+        if (mReceivedCount < ArraySize(mReceivedPeerNodeIds))
+        {
+            mReceivedPeerNodeIds[mReceivedCount] = session.GetPeerNodeId();
+        }
+        mReceivedCount++;
+
+        if (mReceivedCount == 1 && mOnFirstMessage)
+        {
+            mOnFirstMessage();
+        }
+    }
+
+    std::function<void()> mOnFirstMessage;
+    size_t mReceivedCount = 0;
+    NodeId mReceivedPeerNodeIds[4];
+};
+
+// Encrypts PAYLOAD for the session and returns the raw datagram a transport would have received for it.
+System::PacketBufferHandle PrepareBatchMessage(nlTestSuite * inSuite, SessionManager & sessionManager, const SessionHandle & session)
+{
+    PayloadHeader payloadHeader;
+    payloadHeader.SetExchangeID(0);
+    payloadHeader.SetMessageType(chip::Protocols::Echo::MsgType::EchoRequest);
+    payloadHeader.SetInitiator(true);
+
+    System::PacketBufferHandle buffer = MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD));
+    NL_TEST_ASSERT(inSuite, !buffer.IsNull());
+
+    EncryptedPacketBufferHandle preparedMessage;
+    NL_TEST_ASSERT(inSuite, sessionManager.PrepareMessage(session, payloadHeader, std::move(buffer), preparedMessage) == CHIP_NO_ERROR);
+    return preparedMessage.CastToWritable();
+}
+
+void BatchSessionEstablishedMidBatchTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+    Transport::PeerAddress peerAddress = Transport::PeerAddress::UDP(addr, CHIP_PORT);
+    Optional<Transport::PeerAddress> peer(peerAddress);
+
+    TransportMgr<LoopbackTransport> transportMgr;
+    SessionManager sessionManager;
+    secure_channel::MessageCounterManager gMessageCounterManager;
+    BatchTestCallback callback;
+
+    NL_TEST_ASSERT(inSuite, transportMgr.Init("LOOPBACK") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sessionManager.Init(&ctx.GetSystemLayer(), &transportMgr, &gMessageCounterManager) == CHIP_NO_ERROR);
+    sessionManager.SetMessageDelegate(&callback);
+
+    // Session 3 receives what is sent on session 4; session 1 receives what is sent on session 2.
+    SessionHolder receiver1, sender1, receiver2, sender2;
+    SecurePairingUsingTestSecret pairingReceiver1(4, 3), pairingSender1(3, 4), pairingReceiver2(2, 1), pairingSender2(1, 2);
+    NL_TEST_ASSERT(inSuite,
+                   sessionManager.NewPairing(receiver1, peer, kSourceNodeId, &pairingReceiver1,
+                                             CryptoContext::SessionRole::kInitiator, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   sessionManager.NewPairing(sender1, peer, kDestinationNodeId, &pairingSender1,
+                                             CryptoContext::SessionRole::kResponder, 0) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   sessionManager.NewPairing(sender2, peer, kDestinationNodeId, &pairingSender2,
+                                             CryptoContext::SessionRole::kResponder, 0) == CHIP_NO_ERROR);
+
+    // The session the second message is addressed to only comes into existence while the first one is dispatched.
+    callback.mOnFirstMessage = [&]() {
+        NL_TEST_ASSERT(inSuite,
+                       sessionManager.NewPairing(receiver2, peer, kSourceNodeId, &pairingReceiver2,
+                                                 CryptoContext::SessionRole::kInitiator, 1) == CHIP_NO_ERROR);
+    };
+
+    Transport::PeerAddress addresses[2] = { peerAddress, peerAddress };
+    System::PacketBufferHandle msgs[2]  = { PrepareBatchMessage(inSuite, sessionManager, sender1.Get()),
+                                           PrepareBatchMessage(inSuite, sessionManager, sender2.Get()) };
+
+    sessionManager.OnMessageBatchReceived(addresses, msgs, 2);
+
+    NL_TEST_ASSERT(inSuite, callback.mReceivedCount == 2);
+    NL_TEST_ASSERT(inSuite, receiver2);
+
+    sessionManager.Shutdown();
+}
+
+void BatchSessionReleasedMidBatchTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+    Transport::PeerAddress peerAddress = Transport::PeerAddress::UDP(addr, CHIP_PORT);
+    Optional<Transport::PeerAddress> peer(peerAddress);
+
+    TransportMgr<LoopbackTransport> transportMgr;
+    SessionManager sessionManager;
+    secure_channel::MessageCounterManager gMessageCounterManager;
+    BatchTestCallback callback;
+
+    NL_TEST_ASSERT(inSuite, transportMgr.Init("LOOPBACK") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sessionManager.Init(&ctx.GetSystemLayer(), &transportMgr, &gMessageCounterManager) == CHIP_NO_ERROR);
+    sessionManager.SetMessageDelegate(&callback);
+
+    SessionHolder receiver, sender, replacement;
+    SecurePairingUsingTestSecret pairingReceiver(2, 1), pairingSender(1, 2), pairingReplacement(2, 1);
+    NL_TEST_ASSERT(inSuite,
+                   sessionManager.NewPairing(receiver, peer, kSourceNodeId, &pairingReceiver,
+                                             CryptoContext::SessionRole::kInitiator, 1) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite,
+                   sessionManager.NewPairing(sender, peer, kDestinationNodeId, &pairingSender,
+                                             CryptoContext::SessionRole::kResponder, 0) == CHIP_NO_ERROR);
+
+    // Releasing the session while the first message is dispatched drops the rest of the batch addressed to it.
+    callback.mOnFirstMessage = [&]() { sessionManager.ExpirePairing(receiver.Get()); };
+
+    Transport::PeerAddress addresses[2] = { peerAddress, peerAddress };
+    System::PacketBufferHandle msgs[2]  = { PrepareBatchMessage(inSuite, sessionManager, sender.Get()),
+                                           PrepareBatchMessage(inSuite, sessionManager, sender.Get()) };
+
+    sessionManager.OnMessageBatchReceived(addresses, msgs, 2);
+
+    NL_TEST_ASSERT(inSuite, callback.mReceivedCount == 1);
+    NL_TEST_ASSERT(inSuite, sessionManager.GetSecureSession(receiver.Get()) == nullptr);
+
+    // A session that takes over the local session ID mid-batch receives the later messages itself.
+    NL_TEST_ASSERT(inSuite,
+                   sessionManager.NewPairing(receiver, peer, kSourceNodeId, &pairingReceiver,
+                                             CryptoContext::SessionRole::kInitiator, 1) == CHIP_NO_ERROR);
+    callback.mReceivedCount  = 0;
+    callback.mOnFirstMessage = [&]() {
+        sessionManager.ExpirePairing(receiver.Get());
+        NL_TEST_ASSERT(inSuite,
+                       sessionManager.NewPairing(replacement, peer, kUndefinedNodeId, &pairingReplacement,
+                                                 CryptoContext::SessionRole::kInitiator, 1) == CHIP_NO_ERROR);
+    };
+
+    msgs[0] = PrepareBatchMessage(inSuite, sessionManager, sender.Get());
+    msgs[1] = PrepareBatchMessage(inSuite, sessionManager, sender.Get());
+
+    sessionManager.OnMessageBatchReceived(addresses, msgs, 2);
+
+    NL_TEST_ASSERT(inSuite, callback.mReceivedCount == 2);
+    NL_TEST_ASSERT(inSuite, callback.mReceivedPeerNodeIds[0] == kSourceNodeId);
+    NL_TEST_ASSERT(inSuite, callback.mReceivedPeerNodeIds[1] == kUndefinedNodeId);
+
+    sessionManager.Shutdown();
+}
+
+class BatchErrorRecorder : public SendBatchErrorDelegate
+{
+public:
+    void OnBatchedSendFailed(const System::PacketBufferHandle & message, CHIP_ERROR error) override
+    {
+        mFailureCount++;
+        mLastError = error;
+        mMatched   = (mExpected != nullptr) && mExpected->HoldsBuffer(message);
+    }
+
+    const EncryptedPacketBufferHandle * mExpected = nullptr;
+    size_t mFailureCount                          = 0;
+    CHIP_ERROR mLastError                         = CHIP_NO_ERROR;
+    bool mMatched                                 = false;
+};
+
+void SendBatchErrorTest(nlTestSuite * inSuite, void * inContext)
+{
+    TestContext & ctx = *reinterpret_cast<TestContext *>(inContext);
+
+    IPAddress addr;
+    IPAddress::FromString("::1", addr);
+    Optional<Transport::PeerAddress> peer(Transport::PeerAddress::UDP(addr, CHIP_PORT));
+
+    TransportMgr<LoopbackTransport> transportMgr;
+    SessionManager sessionManager;
+    secure_channel::MessageCounterManager gMessageCounterManager;
+
+    TestSessMgrCallback callback;
+    callback.mSuite = inSuite;
+
+    NL_TEST_ASSERT(inSuite, transportMgr.Init("LOOPBACK") == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sessionManager.Init(&ctx.GetSystemLayer(), &transportMgr, &gMessageCounterManager) == CHIP_NO_ERROR);
+    sessionManager.SetMessageDelegate(&callback);
+
+    SecurePairingUsingTestSecret pairing1(1, 2);
+    NL_TEST_ASSERT(inSuite,
+                   sessionManager.NewPairing(callback.mRemoteToLocalSession, peer, kSourceNodeId, &pairing1,
+                                             CryptoContext::SessionRole::kInitiator, 1) == CHIP_NO_ERROR);
+    SecurePairingUsingTestSecret pairing2(2, 1);
+    NL_TEST_ASSERT(inSuite,
+                   sessionManager.NewPairing(callback.mLocalToRemoteSession, peer, kDestinationNodeId, &pairing2,
+                                             CryptoContext::SessionRole::kResponder, 0) == CHIP_NO_ERROR);
+
+    SessionHandle localToRemoteSession = callback.mLocalToRemoteSession.Get();
+    LoopbackTransport & loopback       = transportMgr.GetTransport().GetImplAtIndex<0>();
+
+    PayloadHeader payloadHeader;
+    payloadHeader.SetExchangeID(0);
+    payloadHeader.SetMessageType(chip::Protocols::Echo::MsgType::EchoRequest);
+    payloadHeader.SetInitiator(true);
+
+    EncryptedPacketBufferHandle preparedMessage;
+    NL_TEST_ASSERT(inSuite,
+                   sessionManager.PrepareMessage(localToRemoteSession, payloadHeader,
+                                                 MessagePacketBuffer::NewWithData(PAYLOAD, sizeof(PAYLOAD)),
+                                                 preparedMessage) == CHIP_NO_ERROR);
+
+    // A batch that goes out cleanly reports success.
+    sessionManager.BeginSendBatch();
+    NL_TEST_ASSERT(inSuite, sessionManager.SendPreparedMessage(localToRemoteSession, preparedMessage) == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, sessionManager.EndSendBatch() == CHIP_NO_ERROR);
+    NL_TEST_ASSERT(inSuite, loopback.mSentMessageCount == 1);
+
+#if INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE > 1
+    // Queued messages are only handed to the transport when the outermost batch ends, which returns the send error
+    // and tells the delegate which message failed.
+    BatchErrorRecorder recorder;
+    recorder.mExpected = &preparedMessage;
+    sessionManager.SetSendBatchErrorDelegate(&recorder);
+    loopback.mMessageSendError = CHIP_ERROR_NO_MEMORY;
+    {
+        ScopedSendBatch outer(&sessionManager);
+        sessionManager.BeginSendBatch();
+        NL_TEST_ASSERT(inSuite, sessionManager.SendPreparedMessage(localToRemoteSession, preparedMessage) == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, sessionManager.EndSendBatch() == CHIP_NO_ERROR);
+        NL_TEST_ASSERT(inSuite, recorder.mFailureCount == 0);
+        NL_TEST_ASSERT(inSuite, outer.End() == CHIP_ERROR_NO_MEMORY);
+        NL_TEST_ASSERT(inSuite, outer.End() == CHIP_NO_ERROR);
+    }
+    NL_TEST_ASSERT(inSuite, recorder.mFailureCount == 1);
+    NL_TEST_ASSERT(inSuite, recorder.mLastError == CHIP_ERROR_NO_MEMORY);
+    NL_TEST_ASSERT(inSuite, recorder.mMatched);
+    sessionManager.SetSendBatchErrorDelegate(nullptr);
+
+    // Errors from a flush forced by a full queue are kept for the end of the batch.
+    sessionManager.BeginSendBatch();
+    for (size_t i = 0; i <= INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE; i++)
+    {
+        NL_TEST_ASSERT(inSuite, sessionManager.SendPreparedMessage(localToRemoteSession, preparedMessage) == CHIP_NO_ERROR);
+    }
+    loopback.mMessageSendError = CHIP_NO_ERROR;
+    NL_TEST_ASSERT(inSuite, sessionManager.EndSendBatch() == CHIP_ERROR_NO_MEMORY);
+    NL_TEST_ASSERT(inSuite, loopback.mSentMessageCount == 2);
+#endif // INET_CONFIG_UDP_SOCKET_MSG_BATCH_SIZE > 1
+
+    sessionManager.Shutdown();
+}
+
 // Test Suite
 
 /**
@@ -482,6 +735,9 @@ const nlTest sTests[] =
     NL_TEST_DEF("Send Encrypted Packet Test",     SendEncryptedPacketTest),
     NL_TEST_DEF("Send Bad Encrypted Packet Test", SendBadEncryptedPacketTest),
     NL_TEST_DEF("Drop stale connection Test",     StaleConnectionDropTest),
+    NL_TEST_DEF("Batch Session Established Test", BatchSessionEstablishedMidBatchTest),
+    NL_TEST_DEF("Batch Session Released Test",    BatchSessionReleasedMidBatchTest),
+    NL_TEST_DEF("Send Batch Error Test",          SendBatchErrorTest),
 
     NL_TEST_SENTINEL()
 };